@@ -32,6 +32,7 @@
 #define UNWIRED_MODULES_LORA_STAR_INCLUDE_LS_H_
 
 #include "lptimer.h"
+#include "bh.h"
 
 #include "ls-frame-fifo.h"
 #include "appdata-fifo.h"
@@ -78,6 +79,14 @@
  */
 #define LS_ED_SLEEP_REQUEST_DELAY 1
 
+/**
+ * @brief Class C devices listen by preamble sniffing.
+ * Downlinks must be sent with a preamble longer than the sniff period of the device.
+ */
+#ifndef LS_ED_CLASS_C_SNIFF
+#define LS_ED_CLASS_C_SNIFF 0
+#endif
+
 // TODO: optimize these values to reduce memory consumption
 #if defined (UNWDS_BUILD_MINIMAL)
     #define LS_UQ_HANDLER_STACKSIZE			(1536)
@@ -160,6 +169,7 @@ typedef struct {
 
 typedef struct {
 	netdev_t *device;		/**< Pointer to the radio PHY structure */
+	bh_t isr_bh;			/**< Bottom half servicing the radio IRQ */
 
     msg_t device_event_queue[16];
 
@@ -37,6 +37,7 @@ extern "C" {
 #include "random.h"
 #include "assert.h"
 #include "thread.h"
+#include "bh.h"
 #include "mutex.h"
 
 #include "periph/adc.h"
@@ -51,14 +52,13 @@ extern "C" {
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-#define SX127X_LORA_MSG_QUEUE   (16U)
-#define SX127X_STACKSIZE        (2*THREAD_STACKSIZE_DEFAULT)
-#define MSG_TYPE_ISR            (0x3456)
-
 #if !defined(UNWDS_MAC_LORAWAN)
 
-static char isr_stack[SX127X_STACKSIZE];
-static kernel_pid_t isr_pid;
+static void _isr_bh_handler(void *arg)
+{
+    netdev_t *dev = arg;
+    dev->driver->isr(dev);
+}
 
 static msg_t msg_rx1;
 static msg_t msg_rx2;
@@ -103,6 +103,10 @@ static void enter_rx(ls_ed_t *ls)
 
     DEBUG("[LoRa] configure SX127X\n");
     configure_sx127x(ls);
+#if LS_ED_CLASS_C_SNIFF
+    netopt_enable_t sniff = (ls->settings.class == LS_ED_CLASS_C) ? NETOPT_ENABLE : NETOPT_DISABLE;
+    ls->_internal.device->driver->set(ls->_internal.device, NETOPT_RX_SNIFF, &sniff, sizeof(sniff));
+#endif
     uint8_t state = NETOPT_STATE_RX;
     ls->_internal.device->driver->set(ls->_internal.device, NETOPT_STATE, &state, sizeof(uint8_t));
     DEBUG("[LoRa] SX127X configured\n");
@@ -530,12 +534,7 @@ static bool frame_recv(ls_ed_t *ls, ls_frame_t *frame)
 static void sx127x_handler(netdev_t *dev, netdev_event_t event)
 {
     if (event == NETDEV_EVENT_ISR) {
-        msg_t msg;
-        msg.type = MSG_TYPE_ISR;
-        msg.content.ptr = dev;
-        if (msg_send(&msg, isr_pid) <= 0) {
-            puts("gnrc_netdev: possibly lost interrupt.");
-        }
+        bh_schedule(&p_ls->_internal.isr_bh);
         return;
     }
 
@@ -654,26 +653,6 @@ static void sx127x_handler(netdev_t *dev, netdev_event_t event)
     }
 }
 
-void *isr_thread(void *arg)
-{
-    (void)arg;
-    
-    static msg_t _msg_q[SX127X_LORA_MSG_QUEUE];
-    msg_init_queue(_msg_q, SX127X_LORA_MSG_QUEUE);
-
-    while (1) {
-        msg_t msg;
-        msg_receive(&msg);
-        if (msg.type == MSG_TYPE_ISR) {
-            netdev_t *dev = msg.content.ptr;
-            dev->driver->isr(dev);
-        }
-        else {
-            puts("[LoRa] unexpected msg type");
-        }
-    }
-}
-
 #if ENABLE_DEBUG
 static void get_type_str(ls_type_t type, char *str) {
 	switch (type) {
@@ -856,15 +835,6 @@ static bool create_uq_handler_thread(ls_ed_t *ls)
         puts("ls_init: creation of uplink frame queue handler thread failed");
         return false;
     }
-    
-    isr_pid = thread_create(isr_stack, sizeof(isr_stack), THREAD_PRIORITY_MAIN - 1,
-                              THREAD_CREATE_STACKTEST, isr_thread, NULL,
-                              "SX127x handler thread");
-
-    if (isr_pid <= KERNEL_PID_UNDEF) {
-        puts("ls_init: creation of SX127X ISR thread failed");
-        return false;
-    }
 
     ls->_internal.uq_thread_pid = pid_fq;
 
@@ -1054,6 +1024,7 @@ int ls_ed_init(ls_ed_t *ls)
     }
     
     /* Setup event callback and stack state as it's argument */
+    bh_init(&p_ls->_internal.isr_bh, _isr_bh_handler, p_ls->_internal.device);
     p_ls->_internal.device->event_callback = sx127x_handler;
 
     ls_ed_sleep(p_ls);
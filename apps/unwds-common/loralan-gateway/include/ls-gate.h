@@ -33,6 +33,7 @@
 #define UNWIRED_MODULES_LORA_STAR_INCLUDE_LS_H_
 
 #include "mutex.h"
+#include "bh.h"
 
 #include "ls-mac-types.h"
 #include "ls-crypto.h"
@@ -134,6 +135,7 @@ typedef struct {
     mutex_t channel_mutex;              /**< Mutex on the channel */
     ls_frame_fifo_t ul_fifo;            /**< Uplink frame queue */
     xtimer_t    rx_window1;             /**< First receive window timer */
+    bh_t isr_bh;                        /**< Bottom half servicing the transceiver IRQ */
 } ls_channel_internal_t;
 
 typedef enum {
@@ -37,6 +37,7 @@ extern "C" {
 #include "random.h"
 #include "assert.h"
 #include "thread.h"
+#include "bh.h"
 
 #include "periph/rtc.h"
 #include "net/netdev/lora.h"
@@ -49,11 +50,11 @@ extern "C" {
 
 #include <stdint.h>
 
-#define SX127X_LORA_MSG_QUEUE   (16U)
-#define SX127X_STACKSIZE        (2*THREAD_STACKSIZE_DEFAULT)
-#define MSG_TYPE_ISR            (0x3456)
-static char isr_stack[SX127X_STACKSIZE];
-static kernel_pid_t isr_pid;
+static void _isr_bh_handler(void *arg)
+{
+    netdev_t *dev = arg;
+    dev->driver->isr(dev);
+}
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -523,12 +524,8 @@ static bool frame_recv(ls_gate_t *ls, ls_gate_channel_t *ch, ls_frame_t *frame)
 static void sx127x_handler(netdev_t *dev, netdev_event_t event)
 {
     if (event == NETDEV_EVENT_ISR) {
-        msg_t msg;
-        msg.type = MSG_TYPE_ISR;
-        msg.content.ptr = dev;
-        if (msg_send(&msg, isr_pid) <= 0) {
-            puts("gnrc_netdev: possibly lost interrupt.");
-        }
+        ls_gate_channel_t *ch = dev->event_callback_arg;
+        bh_schedule(&ch->_internal.isr_bh);
         return;
     }
     
@@ -615,26 +612,6 @@ static void sx127x_handler(netdev_t *dev, netdev_event_t event)
     }
 }
 
-void *isr_thread(void *arg)
-{
-    (void)arg;
-    
-    static msg_t _msg_q[SX127X_LORA_MSG_QUEUE];
-    msg_init_queue(_msg_q, SX127X_LORA_MSG_QUEUE);
-
-    while (1) {
-        msg_t msg;
-        msg_receive(&msg);
-        if (msg.type == MSG_TYPE_ISR) {
-            netdev_t *dev = msg.content.ptr;
-            dev->driver->isr(dev);
-        }
-        else {
-            puts("[LoRa] isr_thread: unexpected msg type");
-        }
-    }
-}
-
 /**
  * Uplink frame queue handler thread body.
  */
@@ -776,15 +753,6 @@ static bool create_tim_handler_thread(ls_gate_t *ls)
         puts("ls-gate: creation of timer handler thread failed");
         return false;
     }
-    
-    isr_pid = thread_create(isr_stack, sizeof(isr_stack), THREAD_PRIORITY_MAIN - 1,
-                              THREAD_CREATE_STACKTEST, isr_thread, NULL,
-                              "SX127x handler thread");
-
-    if (isr_pid <= KERNEL_PID_UNDEF) {
-        puts("ls_init: creation of SX127X ISR thread failed");
-        return false;
-    }
 
     ls->_internal.tim_thread_pid = pid_tim;
 
@@ -827,7 +795,8 @@ static bool open_channel(ls_gate_channel_t *ch)
         return false;
     }
 
-    /* Setup callbacks */
+    /* Setup callbacks, each transceiver has its own IRQ bottom half */
+    bh_init(&ch->_internal.isr_bh, _isr_bh_handler, ch->_internal.device);
     ch->_internal.device->event_callback = sx127x_handler;
     ch->_internal.device->event_callback_arg = ch;
     
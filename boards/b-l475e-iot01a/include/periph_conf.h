@@ -235,6 +235,7 @@ static const i2c_conf_t i2c_config[] = {
         .bus            = APB1,
         .rcc_mask       = RCC_APB1ENR1_I2C1EN,
         .irqn           = I2C1_ER_IRQn,
+        .ev_irqn        = I2C1_EV_IRQn,
     },
     {
         .dev            = I2C2,
@@ -246,11 +247,14 @@ static const i2c_conf_t i2c_config[] = {
         .bus            = APB1,
         .rcc_mask       = RCC_APB1ENR1_I2C2EN,
         .irqn           = I2C2_ER_IRQn,
+        .ev_irqn        = I2C2_EV_IRQn,
     },
 };
 
 #define I2C_0_ISR           isr_i2c1_er
 #define I2C_1_ISR           isr_i2c2_er
+#define I2C_0_EV_ISR        isr_i2c1_ev
+#define I2C_1_EV_ISR        isr_i2c2_ev
 
 #define I2C_NUMOF           (sizeof(i2c_config) / sizeof(i2c_config[0]))
 /** @} */
@@ -47,6 +47,7 @@ static const i2c_conf_t i2c_config[] = {
         .rcc_mask       = RCC_APB1ENR_I2C1EN,
         .clk            = CLOCK_APB1,
         .irqn           = I2C1_EV_IRQn,
+        .er_irqn        = I2C1_ER_IRQn,
 #elif CPU_FAM_STM32L4
         .rcc_mask       = RCC_APB1ENR1_I2C1EN,
         .irqn           = I2C1_ER_IRQn,
@@ -63,6 +64,7 @@ static const i2c_conf_t i2c_config[] = {
 
 #if CPU_FAM_STM32F4 || CPU_FAM_STM32F2
 #define I2C_0_ISR           isr_i2c1_ev
+#define I2C_0_ER_ISR        isr_i2c1_er
 #elif CPU_FAM_STM32L4 || CPU_FAM_STM32F7
 #define I2C_0_ISR           isr_i2c1_er
 #elif CPU_FAM_STM32F0
@@ -256,7 +256,8 @@ static const i2c_conf_t i2c_config[] = {
         .bus            = APB1,
         .rcc_mask       = RCC_APB1ENR_I2C1EN,
         .clk            = CLOCK_APB1,
-        .irqn           = I2C1_EV_IRQn
+        .irqn           = I2C1_EV_IRQn,
+        .er_irqn        = I2C1_ER_IRQn
     },
     {
         .dev            = I2C2,
@@ -268,12 +269,15 @@ static const i2c_conf_t i2c_config[] = {
         .bus            = APB1,
         .rcc_mask       = RCC_APB1ENR_I2C2EN,
         .clk            = CLOCK_APB1,
-        .irqn           = I2C2_EV_IRQn
+        .irqn           = I2C2_EV_IRQn,
+        .er_irqn        = I2C2_ER_IRQn
     }
 };
 
 #define I2C_0_ISR           isr_i2c1_ev
 #define I2C_1_ISR           isr_i2c2_ev
+#define I2C_0_ER_ISR        isr_i2c1_er
+#define I2C_1_ER_ISR        isr_i2c2_er
 
 #define I2C_NUMOF           (sizeof(i2c_config) / sizeof(i2c_config[0]))
 /** @} */
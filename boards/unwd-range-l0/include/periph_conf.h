@@ -230,8 +230,8 @@ static const i2c_conf_t i2c_config[] = {
     },
 };
 
-#define I2C_0_ISR           isr_i2c2_er
-#define I2C_1_ISR           isr_i2c1_er
+#define I2C_0_ISR           isr_i2c2
+#define I2C_1_ISR           isr_i2c1
 
 #define I2C_NUMOF           (sizeof(i2c_config) / sizeof(i2c_config[0]))
 /** @} */
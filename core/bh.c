@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_bh
+ * @{
+ *
+ * @file
+ * @brief       Bottom-half work queue implementation
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "bh.h"
+#include "irq.h"
+#include "sched.h"
+#include "thread.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static char _bh_stack[BH_STACKSIZE];
+static clist_node_t _pending;
+static kernel_pid_t _bh_pid = KERNEL_PID_UNDEF;
+
+static void *_bh_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        unsigned state = irq_disable();
+        bh_t *bh = (bh_t *)clist_lpop(&_pending);
+
+        if (bh == NULL) {
+            /* same pattern as mutex_lock(): an ISR calling bh_schedule()
+             * between irq_restore() and the yield sets us pending again */
+            DEBUG("bh: queue empty, going to sleep\n");
+            sched_set_status((thread_t *)sched_active_thread, STATUS_SLEEPING);
+            irq_restore(state);
+            thread_yield_higher();
+            continue;
+        }
+
+        /* mark as not pending before running, so the handler or its ISR may
+         * schedule it again */
+        bh->list_node.next = NULL;
+        irq_restore(state);
+
+        DEBUG("bh: running %p\n", (void *)bh);
+        bh->handler(bh->arg);
+    }
+
+    return NULL;
+}
+
+void bh_thread_init(void)
+{
+    _bh_pid = thread_create(_bh_stack, sizeof(_bh_stack), BH_PRIO,
+                            THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                            _bh_thread, NULL, "bh");
+}
+
+void bh_schedule(bh_t *bh)
+{
+    assert(bh && bh->handler);
+
+    unsigned state = irq_disable();
+    if (!bh->list_node.next) {
+        clist_rpush(&_pending, &bh->list_node);
+    }
+
+    thread_t *worker = (thread_t *)thread_get(_bh_pid);
+    if (worker && (worker->status == STATUS_SLEEPING)) {
+        sched_set_status(worker, STATUS_RUNNING);
+        irq_restore(state);
+        sched_switch(worker->priority);
+        return;
+    }
+    irq_restore(state);
+}
+
+void bh_cancel(bh_t *bh)
+{
+    assert(bh);
+
+    unsigned state = irq_disable();
+    clist_remove(&_pending, &bh->list_node);
+    bh->list_node.next = NULL;
+    irq_restore(state);
+}
+
+kernel_pid_t bh_pid(void)
+{
+    return _bh_pid;
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_bh Deferred interrupt handling
+ * @ingroup     core
+ * @brief       Kernel bottom-half work queue for interrupt handlers
+ *
+ * Many drivers (e.g. netdev radios) must not do their interrupt processing in
+ * ISR context. Instead of every user spawning its own thread that only calls
+ * `dev->driver->isr(dev)`, an ISR can schedule a bottom half (a callback and
+ * its argument) that is run by a single, high priority kernel thread. All
+ * deferred handlers share one stack and one context switch path.
+ *
+ * Bottom halves are "sender allocated" and are linked into the pending queue
+ * intrusively, so bh_schedule() never blocks and never fails. Scheduling an
+ * already pending bottom half is a no-op, i.e. interrupts that fire again
+ * before their handler ran are coalesced into one invocation.
+ *
+ * The worker thread is created by the kernel on startup if the module
+ * `core_bh` is used. Its priority and stack size can be configured using
+ * @ref BH_PRIO and @ref BH_STACKSIZE.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void _isr_bh(void *arg)
+ * {
+ *     netdev_t *dev = arg;
+ *     dev->driver->isr(dev);
+ * }
+ *
+ * static bh_t _bh = BH_INIT(_isr_bh, &my_dev);
+ *
+ * static void _event_cb(netdev_t *dev, netdev_event_t event)
+ * {
+ *     if (event == NETDEV_EVENT_ISR) {
+ *         bh_schedule(&_bh);
+ *     }
+ *     [...]
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Bottom-half API
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef BH_H
+#define BH_H
+
+#include <stdint.h>
+
+#include "clist.h"
+#include "kernel_types.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Priority of the bottom-half worker thread
+ *
+ * Defaults to the highest priority below the reserved level 0, so deferred
+ * interrupt handlers preempt all regular threads.
+ */
+#ifndef BH_PRIO
+#define BH_PRIO             (1)
+#endif
+
+/**
+ * @brief   Stack size of the bottom-half worker thread
+ *
+ * All bottom halves run on this stack, so it must fit the deepest handler.
+ */
+#ifndef BH_STACKSIZE
+#define BH_STACKSIZE        (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Bottom-half handler type definition
+ */
+typedef void (*bh_handler_t)(void *arg);
+
+/**
+ * @brief   Bottom-half structure
+ */
+typedef struct {
+    clist_node_t list_node;     /**< pending queue list entry       */
+    bh_handler_t handler;       /**< handler to run in thread context */
+    void *arg;                  /**< argument passed to the handler */
+} bh_t;
+
+/**
+ * @brief   Static initializer for bottom-half objects
+ *
+ * @param[in] h     handler function
+ * @param[in] a     argument passed to @p h
+ */
+#define BH_INIT(h, a)       { { NULL }, (h), (a) }
+
+/**
+ * @brief   Initialize a bottom-half object
+ *
+ * @param[out] bh       bottom half to initialize
+ * @param[in]  handler  handler function
+ * @param[in]  arg      argument passed to @p handler
+ */
+static inline void bh_init(bh_t *bh, bh_handler_t handler, void *arg)
+{
+    bh->list_node.next = NULL;
+    bh->handler = handler;
+    bh->arg = arg;
+}
+
+/**
+ * @brief   Create the bottom-half worker thread
+ *
+ * @internal
+ *
+ * Called by kernel_init() before the scheduler is started.
+ */
+void bh_thread_init(void);
+
+/**
+ * @brief   Queue a bottom half for execution by the worker thread
+ *
+ * May be called from ISR and thread context. If @p bh is already pending, this
+ * function does nothing.
+ *
+ * @param[in] bh    bottom half to schedule
+ */
+void bh_schedule(bh_t *bh);
+
+/**
+ * @brief   Remove a pending bottom half from the queue
+ *
+ * @param[in] bh    bottom half to cancel
+ */
+void bh_cancel(bh_t *bh);
+
+/**
+ * @brief   Get the PID of the bottom-half worker thread
+ *
+ * @return  PID of the worker, KERNEL_PID_UNDEF if it was not started yet
+ */
+kernel_pid_t bh_pid(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BH_H */
+/** @} */
@@ -95,6 +95,22 @@ int _mbox_put(mbox_t *mbox, msg_t *msg, int blocking);
  */
 int _mbox_get(mbox_t *mbox, msg_t *msg, int blocking);
 
+/**
+ * @brief Get up to @p max messages from mailbox
+ *
+ * If the mailbox is empty, this function will return right away.
+ *
+ * @internal
+ *
+ * @param[in] mbox      ptr to mailbox to operate on
+ * @param[in] msgs      ptr to storage for at least @p max messages
+ * @param[in] max       maximum number of messages to retrieve, must be > 0
+ * @param[in] blocking  block if 1, don't block if 0
+ *
+ * @return  number of messages retrieved
+ */
+unsigned _mbox_get_bulk(mbox_t *mbox, msg_t *msgs, unsigned max, int blocking);
+
 /**
  * @brief Add message to mailbox
  *
@@ -155,6 +171,41 @@ static inline int mbox_try_get(mbox_t *mbox, msg_t *msg)
     return _mbox_get(mbox, msg, NON_BLOCKING);
 }
 
+/**
+ * @brief Get up to @p max messages from mailbox at once
+ *
+ * If the mailbox is empty, this function will block until a message becomes
+ * available. Otherwise all queued messages up to @p max are taken in one
+ * critical section, and the writers blocked on the full mailbox are switched
+ * to only once.
+ *
+ * @param[in] mbox  ptr to mailbox to operate on
+ * @param[in] msgs  ptr to storage for at least @p max messages
+ * @param[in] max   maximum number of messages to retrieve, must be > 0
+ *
+ * @return  number of messages retrieved, at least 1
+ */
+static inline unsigned mbox_get_bulk(mbox_t *mbox, msg_t *msgs, unsigned max)
+{
+    return _mbox_get_bulk(mbox, msgs, max, BLOCKING);
+}
+
+/**
+ * @brief Get up to @p max messages from mailbox at once
+ *
+ * If the mailbox is empty, this function will return right away.
+ *
+ * @param[in] mbox  ptr to mailbox to operate on
+ * @param[in] msgs  ptr to storage for at least @p max messages
+ * @param[in] max   maximum number of messages to retrieve, must be > 0
+ *
+ * @return  number of messages retrieved
+ */
+static inline unsigned mbox_try_get_bulk(mbox_t *mbox, msg_t *msgs, unsigned max)
+{
+    return _mbox_get_bulk(mbox, msgs, max, NON_BLOCKING);
+}
+
 #ifdef __cplusplus
 }
 #endif
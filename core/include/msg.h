@@ -272,6 +272,27 @@ int msg_send_to_self(msg_t *m);
  */
 int msg_send_int(msg_t *m, kernel_pid_t target_pid);
 
+/**
+ * @brief Send a burst of messages, waking the receiver only once.
+ *
+ * If the target is blocked in msg_receive(), the first message is handed over
+ * directly, the following ones are put into the target's message queue, all
+ * in one critical section. The caller yields once afterwards. Messages that
+ * do not fit into the queue anymore are sent one by one like msg_send().
+ *
+ * The message order is preserved. Must not be called from an ISR or with the
+ * own PID as target.
+ *
+ * @param[in] m             Array of @p num messages, the ``sender_pid``
+ *                          fields are overwritten.
+ * @param[in] num           Number of messages in @p m.
+ * @param[in] target_pid    PID of target thread.
+ *
+ * @return Number of messages sent, @p num unless the target went away
+ * @return -1, on error (invalid PID)
+ */
+int msg_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid);
+
 /**
  * @brief Test if the message was sent inside an ISR.
  * @see msg_send_int()
@@ -296,6 +317,22 @@ static inline int msg_sent_by_int(const msg_t *m)
  */
 int msg_receive(msg_t *m);
 
+/**
+ * @brief Receive up to @p max messages at once.
+ *
+ * Blocks until at least one message is available, like msg_receive(). Then
+ * drains the message queue and the blocked senders in one critical section,
+ * in the order msg_receive() would have returned them. Senders still blocked
+ * afterwards are moved into the freed queue slots. Senders unblocked by this
+ * are only switched to once.
+ *
+ * @param[out] m    Array of at least @p max ``msg_t``, must not be NULL.
+ * @param[in] max   Maximum number of messages to receive, must be > 0.
+ *
+ * @return  Number of messages received, at least 1.
+ */
+int msg_receive_bulk(msg_t *m, unsigned max);
+
 /**
  * @brief Try to receive a message.
  *
@@ -40,6 +40,10 @@
 #include <auto_init.h>
 #endif
 
+#ifdef MODULE_CORE_BH
+#include "bh.h"
+#endif
+
 extern int main(void);
 static void *main_trampoline(void *arg)
 {
@@ -93,5 +97,9 @@ void kernel_init(void)
             THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
             main_trampoline, NULL, main_name);
 
+#ifdef MODULE_CORE_BH
+    bh_thread_init();
+#endif
+
     cpu_switch_context_exit();
 }
@@ -18,6 +18,7 @@
  * @}
  */
 
+#include <assert.h>
 #include <string.h>
 
 #include "mbox.h"
@@ -120,3 +121,45 @@ int _mbox_get(mbox_t *mbox, msg_t *msg, int blocking)
         return 0;
     }
 }
+
+unsigned _mbox_get_bulk(mbox_t *mbox, msg_t *msgs, unsigned max, int blocking)
+{
+    assert(max > 0);
+
+    unsigned irqstate = irq_disable();
+    unsigned n = 0;
+
+    while ((n < max) && cib_avail(&mbox->cib)) {
+        msgs[n++] = mbox->msg_array[cib_get_unsafe(&mbox->cib)];
+    }
+
+    if (n) {
+        DEBUG("mbox: Thread %"PRIkernel_pid" mbox 0x%08x: _get_bulk(): "
+                "got %u queued messages.\n", sched_active_pid, (unsigned)mbox, n);
+        /* one writer per freed slot, but only one context switch */
+        uint16_t prio = THREAD_PRIORITY_IDLE;
+        list_node_t *next;
+        for (unsigned i = 0; (i < n) && (next = list_remove_head(&mbox->writers)); i++) {
+            thread_t *thread = container_of((clist_node_t*)next, thread_t, rq_entry);
+            sched_set_status(thread, STATUS_PENDING);
+            if (thread->priority < prio) {
+                prio = thread->priority;
+            }
+        }
+        irq_restore(irqstate);
+        if (prio < THREAD_PRIORITY_IDLE) {
+            sched_switch(prio);
+        }
+        return n;
+    }
+    else if (blocking) {
+        sched_active_thread->wait_data = (void*)msgs;
+        _wait(&mbox->readers, irqstate);
+        /* sender has copied message */
+        return 1;
+    }
+    else {
+        irq_restore(irqstate);
+        return 0;
+    }
+}
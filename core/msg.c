@@ -171,6 +171,53 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
     return 1;
 }
 
+int msg_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid)
+{
+    assert(!irq_is_in() && (sched_active_pid != target_pid));
+
+    if (!pid_is_valid(target_pid)) {
+        DEBUG("msg_send_bulk(): target_pid is invalid\n");
+        return -1;
+    }
+
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t *) sched_threads[target_pid];
+    unsigned i = 0;
+
+    if (target == NULL) {
+        DEBUG("msg_send_bulk(): target thread does not exist\n");
+        irq_restore(state);
+        return -1;
+    }
+
+    if (num && (target->status == STATUS_RECEIVE_BLOCKED)) {
+        DEBUG("msg_send_bulk: Direct msg copy of first message.\n");
+        m[0].sender_pid = sched_active_pid;
+        *((msg_t *) target->wait_data) = m[0];
+        sched_set_status(target, STATUS_PENDING);
+        i++;
+    }
+
+    for (; i < num; i++) {
+        m[i].sender_pid = sched_active_pid;
+        if (!queue_msg(target, &m[i])) {
+            break;
+        }
+    }
+
+    irq_restore(state);
+    thread_yield_higher();
+
+    /* queue is full, let the remaining messages go the usual way */
+    for (; i < num; i++) {
+        if (msg_send(&m[i], target_pid) < 0) {
+            return i;
+        }
+    }
+
+    return num;
+}
+
 int msg_send_to_self(msg_t *m)
 {
     unsigned state = irq_disable();
@@ -373,6 +420,84 @@ static int _msg_receive(msg_t *m, int block)
     DEBUG("This should have never been reached!\n");
 }
 
+/* takes the message of the first blocked sender and unblocks the sender,
+ * unless it waits for a reply. Returns the priority to switch to. */
+static uint16_t _take_waiter(thread_t *me, msg_t *m, uint16_t prio)
+{
+    list_node_t *next = list_remove_head(&me->msg_waiters);
+    thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
+
+    *m = *((msg_t *) sender->wait_data);
+
+    if (sender->status != STATUS_REPLY_BLOCKED) {
+        sender->wait_data = NULL;
+        sched_set_status(sender, STATUS_PENDING);
+        if (sender->priority < prio) {
+            prio = sender->priority;
+        }
+    }
+    return prio;
+}
+
+int msg_receive_bulk(msg_t *m, unsigned max)
+{
+    assert(max > 0);
+
+    unsigned state = irq_disable();
+    thread_t *me = (thread_t*) sched_threads[sched_active_pid];
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    unsigned n = 0;
+
+    while (n < max) {
+        /* queued messages are older than those of blocked senders */
+        int queue_index = -1;
+        if (thread_has_msg_queue(me)) {
+            queue_index = cib_get(&(me->msg_queue));
+        }
+        if (queue_index >= 0) {
+            m[n++] = me->msg_array[queue_index];
+            continue;
+        }
+
+        if (me->msg_waiters.next == NULL) {
+            break;
+        }
+        sender_prio = _take_waiter(me, &m[n++], sender_prio);
+    }
+
+    /* move blocked senders into the freed queue slots, like msg_receive()
+     * does, so newer messages cannot overtake them */
+    while (thread_has_msg_queue(me) && (me->msg_waiters.next != NULL)
+           && !cib_full(&me->msg_queue)) {
+        int queue_index = cib_put(&me->msg_queue);
+        sender_prio = _take_waiter(me, &me->msg_array[queue_index],
+                                   sender_prio);
+    }
+
+    if (n == 0) {
+        DEBUG("msg_receive_bulk(): %" PRIkernel_pid ": No msg. Going blocked.\n",
+              sched_active_thread->pid);
+        me->wait_data = (void *) m;
+        sched_set_status(me, STATUS_RECEIVE_BLOCKED);
+
+        irq_restore(state);
+        thread_yield_higher();
+
+        /* sender copied message */
+        assert(sched_active_thread->status != STATUS_RECEIVE_BLOCKED);
+        return 1;
+    }
+
+    DEBUG("msg_receive_bulk(): %" PRIkernel_pid ": got %u messages.\n",
+          sched_active_thread->pid, n);
+    irq_restore(state);
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+
+    return n;
+}
+
 int msg_avail(void)
 {
     DEBUG("msg_available: %" PRIkernel_pid ": msg_available.\n",
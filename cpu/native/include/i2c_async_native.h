@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_periph_i2c_async
+ * @defgroup    drivers_periph_i2c_async_native Native I2C stand-in
+ * @{
+ * @brief       Simulated I2C devices for testing asynchronous transactions on
+ *              native
+ *
+ * A device is a register map attached to a bus address, the register address
+ * increments after every byte. Transactions to addresses without a device
+ * fail with -ENXIO. Transactions complete synchronously, the queue itself is
+ * tested by the unittests of @ref drivers_periph_async_queue.
+ *
+ * @file
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef I2C_ASYNC_NATIVE_H
+#define I2C_ASYNC_NATIVE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "periph/i2c_async.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of simulated devices on all buses
+ */
+#ifndef I2C_ASYNC_NATIVE_DEVS
+#define I2C_ASYNC_NATIVE_DEVS   (4U)
+#endif
+
+/**
+ * @brief   Attach a simulated device to a bus
+ *
+ * @param[in] dev       I2C device
+ * @param[in] addr      7-bit device address
+ * @param[in] regs      register map, must stay valid
+ * @param[in] size      size of @p regs
+ *
+ * @return  0 on success
+ * @return  -ENOMEM if all device slots are used
+ */
+int i2c_async_native_add(i2c_t dev, uint16_t addr, uint8_t *regs, size_t size);
+
+/**
+ * @brief   Detach all simulated devices
+ */
+void i2c_async_native_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I2C_ASYNC_NATIVE_H */
+/** @} */
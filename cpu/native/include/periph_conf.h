@@ -41,6 +41,14 @@
 #define RTC_NUMOF (1)
 /** @} */
 
+/**
+ * @name Real Time Timer configuration
+ * @{
+ */
+#define RTT_FREQUENCY       (1024U)
+#define RTT_MAX_VALUE       (0xffffffffUL)
+/** @} */
+
 /**
  * @name Timer peripheral configuration
  * @{
@@ -79,6 +87,26 @@
 #define QDEC_NUMOF (8U)
 #endif
 
+/**
+ * @brief SPI configuration
+ *
+ * Native has no SPI, the buses only exist as loopback stand-ins for
+ * asynchronous transfers, see @ref drivers_periph_spi_async_native.
+ */
+#if defined(MODULE_PERIPH_SPI_ASYNC) && !defined(SPI_NUMOF)
+#define SPI_NUMOF (2U)
+#endif
+
+/**
+ * @brief I2C configuration
+ *
+ * Native has no I2C, the buses only exist as stand-ins with simulated
+ * register maps, see @ref drivers_periph_i2c_async_native.
+ */
+#if defined(MODULE_PERIPH_I2C_ASYNC) && !defined(I2C_NUMOF)
+#define I2C_NUMOF (2U)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
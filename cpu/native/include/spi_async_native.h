@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_periph_spi_async
+ * @defgroup    drivers_periph_spi_async_native Native SPI stand-in
+ * @{
+ * @brief       Loopback SPI buses for testing asynchronous transfers on native
+ *
+ * Every bus echoes the sent bytes, or zeros if nothing is sent. Transfers
+ * complete synchronously, unless the bus is held with
+ * spi_async_native_hold(). Then each transfer stays pending until
+ * spi_async_native_complete() simulates its completion interrupt.
+ *
+ * @file
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef SPI_ASYNC_NATIVE_H
+#define SPI_ASYNC_NATIVE_H
+
+#include <stdbool.h>
+
+#include "periph/spi_async.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Keep transfers on a bus pending until they are completed manually
+ *
+ * @param[in] bus   SPI device
+ * @param[in] hold  true to keep transfers pending
+ */
+void spi_async_native_hold(spi_t bus, bool hold);
+
+/**
+ * @brief   Complete the pending transfer on a bus
+ *
+ * @param[in] bus   SPI device
+ *
+ * @return  true, if a transfer was pending
+ */
+bool spi_async_native_complete(spi_t bus);
+
+/**
+ * @brief   Get the transfer pending on a bus
+ *
+ * @param[in] bus   SPI device
+ *
+ * @return  the pending transfer, NULL if there is none
+ */
+const spi_async_xfer_t *spi_async_native_pending(spi_t bus);
+
+/**
+ * @brief   Check whether a device is selected on a bus
+ *
+ * @param[in] bus   SPI device
+ *
+ * @return  true, if a chip select is asserted
+ */
+bool spi_async_native_selected(spi_t bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPI_ASYNC_NATIVE_H */
+/** @} */
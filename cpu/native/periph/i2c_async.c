@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_periph_i2c_async_native
+ * @{
+ *
+ * @file
+ * @brief       Simulated I2C devices for asynchronous transactions on native
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "assert.h"
+#include "mutex.h"
+#include "i2c_async_native.h"
+
+typedef struct {
+    uint8_t *regs;
+    size_t size;
+    i2c_t bus;
+    uint16_t addr;
+} _dev_t;
+
+static mutex_t _locks[I2C_NUMOF];
+static _dev_t _devs[I2C_ASYNC_NATIVE_DEVS];
+
+int i2c_acquire(i2c_t dev)
+{
+    assert(dev < I2C_NUMOF);
+
+    mutex_lock(&_locks[dev]);
+    return 0;
+}
+
+int i2c_release(i2c_t dev)
+{
+    assert(dev < I2C_NUMOF);
+
+    mutex_unlock(&_locks[dev]);
+    return 0;
+}
+
+static void _transfer(i2c_t bus, i2c_async_xfer_t *xfer)
+{
+    _dev_t *d = NULL;
+
+    for (unsigned i = 0; i < I2C_ASYNC_NATIVE_DEVS; i++) {
+        if ((_devs[i].regs != NULL) && (_devs[i].bus == bus) &&
+            (_devs[i].addr == xfer->addr)) {
+            d = &_devs[i];
+            break;
+        }
+    }
+    if (d == NULL) {
+        xfer->res = -ENXIO;
+        return;
+    }
+
+    size_t reg = (xfer->flags & I2C_ASYNC_NOREG) ? 0 : xfer->reg;
+    if (reg + xfer->len > d->size) {
+        /* the device does not acknowledge beyond its registers */
+        xfer->res = -EIO;
+        return;
+    }
+    if (xfer->read) {
+        memcpy(xfer->data, &d->regs[reg], xfer->len);
+    }
+    else {
+        memcpy(&d->regs[reg], xfer->data, xfer->len);
+    }
+    xfer->res = 0;
+}
+
+void i2c_async_hw_begin(i2c_t dev)
+{
+    (void)dev;
+}
+
+int i2c_async_hw_start(i2c_t dev, i2c_async_xfer_t *xfer)
+{
+    _transfer(dev, xfer);
+    return 1;
+}
+
+void i2c_async_hw_end(i2c_t dev)
+{
+    (void)dev;
+}
+
+int i2c_async_native_add(i2c_t dev, uint16_t addr, uint8_t *regs, size_t size)
+{
+    assert((dev < I2C_NUMOF) && (regs != NULL));
+
+    for (unsigned i = 0; i < I2C_ASYNC_NATIVE_DEVS; i++) {
+        if (_devs[i].regs == NULL) {
+            _devs[i].regs = regs;
+            _devs[i].size = size;
+            _devs[i].bus = dev;
+            _devs[i].addr = addr;
+            return 0;
+        }
+    }
+    return -ENOMEM;
+}
+
+void i2c_async_native_clear(void)
+{
+    memset(_devs, 0, sizeof(_devs));
+}
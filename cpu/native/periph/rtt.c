@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @ingroup     drivers_periph_rtt
+ * @{
+ *
+ * @file
+ * @brief       Native CPU periph/rtt.h implementation
+ *
+ * The counter is derived from the monotonic clock of the host, the alarm is
+ * a POSIX timer signalling @ref NATIVE_RTT_SIGNAL. The overflow callback is
+ * not supported, the counter overflows after 48 days.
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <err.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cpu.h"
+#include "periph/rtt.h"
+#include "periph_conf.h"
+
+#include "native_internal.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#ifndef NATIVE_RTT_SIGNAL
+/**
+ * @brief   Signal of the alarm timer
+ */
+#define NATIVE_RTT_SIGNAL   (SIGRTMIN + 1)
+#endif
+
+#define NS_PER_TICK         (1000000000ull / RTT_FREQUENCY)
+
+static timer_t _timer;
+static uint64_t _offset;
+static uint32_t _alarm;
+static rtt_cb_t _alarm_cb;
+static void *_alarm_arg;
+
+static uint64_t _now(void)
+{
+    struct timespec t;
+
+    _native_syscall_enter();
+    if (real_clock_gettime(CLOCK_MONOTONIC, &t) == -1) {
+        err(EXIT_FAILURE, "rtt: clock_gettime");
+    }
+    _native_syscall_leave();
+
+    return ((uint64_t)t.tv_sec * 1000000000ull + t.tv_nsec) / NS_PER_TICK;
+}
+
+static void _arm(uint64_t ticks)
+{
+    struct itimerspec its;
+
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = (ticks * NS_PER_TICK) / 1000000000ull;
+    its.it_value.tv_nsec = (ticks * NS_PER_TICK) % 1000000000ull;
+
+    _native_syscall_enter();
+    if (timer_settime(_timer, 0, &its, NULL) == -1) {
+        err(EXIT_FAILURE, "rtt: timer_settime");
+    }
+    _native_syscall_leave();
+}
+
+static void _isr(void)
+{
+    rtt_cb_t cb = _alarm_cb;
+
+    DEBUG("%s\n", __func__);
+
+    _alarm_cb = NULL;
+    if (cb) {
+        cb(_alarm_arg);
+    }
+}
+
+void rtt_init(void)
+{
+    struct sigevent sev;
+
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_SIGNAL;
+    sev.sigev_signo = NATIVE_RTT_SIGNAL;
+
+    _native_syscall_enter();
+    if (timer_create(CLOCK_MONOTONIC, &sev, &_timer) == -1) {
+        err(EXIT_FAILURE, "rtt_init: timer_create");
+    }
+    _native_syscall_leave();
+
+    if (register_interrupt(NATIVE_RTT_SIGNAL, _isr) != 0) {
+        DEBUG("rtt_init: register_interrupt failed\n");
+    }
+    _offset = _now();
+}
+
+void rtt_set_overflow_cb(rtt_cb_t cb, void *arg)
+{
+    (void)cb;
+    (void)arg;
+}
+
+void rtt_clear_overflow_cb(void)
+{
+}
+
+uint32_t rtt_get_counter(void)
+{
+    return (uint32_t)((_now() - _offset) & RTT_MAX_VALUE);
+}
+
+void rtt_set_counter(uint32_t counter)
+{
+    _offset = _now() - counter;
+}
+
+void rtt_set_alarm(uint32_t alarm, rtt_cb_t cb, void *arg)
+{
+    uint32_t offset = (alarm - rtt_get_counter()) & RTT_MAX_VALUE;
+
+    _alarm = alarm;
+    _alarm_cb = cb;
+    _alarm_arg = arg;
+    /* an alarm of now fires after a full period */
+    _arm((offset == 0) ? (uint64_t)RTT_MAX_VALUE + 1 : offset);
+}
+
+uint32_t rtt_get_alarm(void)
+{
+    return _alarm;
+}
+
+void rtt_clear_alarm(void)
+{
+    _alarm_cb = NULL;
+    _arm(0);
+}
+
+void rtt_poweron(void)
+{
+}
+
+void rtt_poweroff(void)
+{
+    rtt_clear_alarm();
+}
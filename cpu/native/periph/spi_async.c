@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_periph_spi_async_native
+ * @{
+ *
+ * @file
+ * @brief       Loopback SPI stand-in for asynchronous transfers on native
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "assert.h"
+#include "mutex.h"
+#include "spi_async_native.h"
+
+typedef struct {
+    mutex_t lock;
+    const spi_async_xfer_t *pending;
+    bool hold;
+    bool selected;
+} _bus_t;
+
+static _bus_t _buses[SPI_NUMOF];
+
+int spi_acquire(spi_t bus, spi_cs_t cs, spi_mode_t mode, spi_clk_t clk)
+{
+    (void)cs;
+    (void)mode;
+    (void)clk;
+    assert(bus < SPI_NUMOF);
+
+    mutex_lock(&_buses[bus].lock);
+    return SPI_OK;
+}
+
+void spi_release(spi_t bus)
+{
+    assert(bus < SPI_NUMOF);
+
+    mutex_unlock(&_buses[bus].lock);
+}
+
+static void _transfer(_bus_t *b, const spi_async_xfer_t *xfer)
+{
+    if (xfer->in) {
+        if (xfer->out) {
+            memmove(xfer->in, xfer->out, xfer->len);
+        }
+        else {
+            memset(xfer->in, 0, xfer->len);
+        }
+    }
+    if (!xfer->cont) {
+        b->selected = false;
+    }
+}
+
+void spi_async_hw_begin(spi_t bus)
+{
+    (void)bus;
+}
+
+int spi_async_hw_start(spi_t bus, const spi_async_xfer_t *xfer, bool cs_active)
+{
+    _bus_t *b = &_buses[bus];
+
+    if (!cs_active) {
+        b->selected = (xfer->cs != SPI_CS_UNDEF);
+    }
+    if (b->hold) {
+        b->pending = xfer;
+        return 0;
+    }
+    _transfer(b, xfer);
+    return 1;
+}
+
+void spi_async_hw_end(spi_t bus)
+{
+    (void)bus;
+}
+
+void spi_async_native_hold(spi_t bus, bool hold)
+{
+    assert(bus < SPI_NUMOF);
+
+    _buses[bus].hold = hold;
+}
+
+bool spi_async_native_complete(spi_t bus)
+{
+    assert(bus < SPI_NUMOF);
+
+    _bus_t *b = &_buses[bus];
+    const spi_async_xfer_t *xfer = b->pending;
+
+    if (xfer == NULL) {
+        return false;
+    }
+    b->pending = NULL;
+    _transfer(b, xfer);
+    spi_async_isr_done(bus);
+    return true;
+}
+
+const spi_async_xfer_t *spi_async_native_pending(spi_t bus)
+{
+    assert(bus < SPI_NUMOF);
+
+    return _buses[bus].pending;
+}
+
+bool spi_async_native_selected(spi_t bus)
+{
+    assert(bus < SPI_NUMOF);
+
+    return _buses[bus].selected;
+}
@@ -81,6 +81,26 @@ extern "C" {
 #define PM_NUM_MODES    (4U)
 /** @} */
 
+#ifndef PM_GOVERNOR_PARAMS
+/**
+ * @brief   Mode costs for the idle governor, see @ref sys_pm_governor
+ *
+ * The general purpose timer behind xtimer halts in STOP (PM_SLEEP), the RTC
+ * behind lptimer keeps running and wakes the MCU up, so STOP is entered as
+ * long as only lptimer timers are armed. STANDBY (PM_POWERDOWN) and
+ * SHUTDOWN (PM_OFF) end in a reset, so no armed timer of either kind would
+ * fire. Leaving STOP includes restarting the system clock with
+ * stmclk_init_sysclk(), the values are conservative for HSE/PLL clocked
+ * boards.
+ */
+#define PM_GOVERNOR_PARAMS { \
+    { 0,    0,    PM_GOVERNOR_STOPS_ALL },      /* PM_OFF */        \
+    { 0,    0,    PM_GOVERNOR_STOPS_ALL },      /* PM_POWERDOWN */  \
+    { 2000, 3000, PM_GOVERNOR_STOPS_XTIMER },   /* PM_SLEEP */      \
+    { 0,    0,    0 },                          /* PM_IDLE */       \
+}
+#endif
+
 /**
  * @brief   Available peripheral buses
  */
@@ -283,6 +303,11 @@ typedef enum {
 #define DMA_INC_BOTH_ADDR (DMA_INC_SRC_ADDR | DMA_INC_DST_ADDR)
 /** @} */
 
+/**
+ * @brief   DMA transfer complete callback, called in interrupt context
+ */
+typedef void (*dma_cb_t)(void *arg);
+
 /**
  * @name    DMA data width
  * @{
@@ -463,6 +488,15 @@ typedef struct {
     uint32_t clk;           /**< bus frequency as defined in board config */
 #endif
     uint8_t irqn;           /**< I2C event interrupt number */
+#if defined(CPU_FAM_STM32F1) || defined(CPU_FAM_STM32F2) || \
+    defined(CPU_FAM_STM32F4) || defined(CPU_FAM_STM32L1)
+    uint8_t er_irqn;        /**< I2C error interrupt number, used by
+                             *   periph_i2c_async if I2C_x_ER_ISR is defined */
+#elif defined(CPU_FAM_STM32F3) || defined(CPU_FAM_STM32F7) || \
+    defined(CPU_FAM_STM32L4)
+    uint8_t ev_irqn;        /**< I2C event interrupt number, used by
+                             *   periph_i2c_async if I2C_x_EV_ISR is defined */
+#endif
 } i2c_conf_t;
 
 #if defined(CPU_FAM_STM32F0) || defined(CPU_FAM_STM32F3) || \
@@ -639,6 +673,18 @@ void dma_stop(dma_t dma);
  */
 void dma_wait(dma_t dma);
 
+/**
+ * @brief   Set a callback for the end of transfers on a stream
+ *
+ * While a callback is set, the end of a transfer is signaled through it
+ * instead of @ref dma_wait. Set @p cb to NULL to restore the default.
+ *
+ * @param[in] dma     logical DMA stream
+ * @param[in] cb      callback, called in interrupt context
+ * @param[in] arg     argument passed to @p cb
+ */
+void dma_set_cb(dma_t dma, dma_cb_t cb, void *arg);
+
 /**
  * @brief   Configure a DMA stream for a new transfer
  *
@@ -22,6 +22,7 @@
 
 #include "periph_cpu.h"
 #include "periph_conf.h"
+#include "irq.h"
 #include "mutex.h"
 #include "assert.h"
 #include "pm_layered.h"
@@ -98,6 +99,8 @@ struct dma_ctx {
     mutex_t conf_lock;
     mutex_t sync_lock;
     uint16_t len;
+    dma_cb_t cb;
+    void *arg;
 };
 
 static struct dma_ctx dma_ctx[DMA_NUMOF];
@@ -477,11 +480,31 @@ void dma_wait(dma_t dma)
     mutex_lock(&dma_ctx[dma].sync_lock);
 }
 
+void dma_set_cb(dma_t dma, dma_cb_t cb, void *arg)
+{
+    assert(dma < DMA_NUMOF);
+
+    unsigned state = irq_disable();
+    dma_ctx[dma].cb = cb;
+    dma_ctx[dma].arg = arg;
+    irq_restore(state);
+}
+
+static inline void dma_done(dma_t dma)
+{
+    if (dma_ctx[dma].cb) {
+        dma_ctx[dma].cb(dma_ctx[dma].arg);
+    }
+    else {
+        mutex_unlock(&dma_ctx[dma].sync_lock);
+    }
+}
+
 void dma_isr_handler(dma_t dma)
 {
     dma_clear_all_flags(dma);
 
-    mutex_unlock(&dma_ctx[dma].sync_lock);
+    dma_done(dma);
 
     cortexm_isr_end();
 }
@@ -580,7 +603,7 @@ static void shared_isr(uint8_t *streams, size_t nb)
         dma_t dma = streams[i];
         if (dma_is_isr(dma)) {
             dma_clear_all_flags(dma);
-            mutex_unlock(&dma_ctx[dma].sync_lock);
+            dma_done(dma);
         }
     }
 
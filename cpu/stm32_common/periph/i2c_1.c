@@ -18,8 +18,13 @@
  * @brief       Low-level I2C driver implementation
  *
  * This driver supports the STM32 F0, F3, F7, L0 and L4 families.
- * @note This implementation only implements the 7-bit addressing polling mode
- * (for now interrupt mode is not available)
+ * @note This implementation only implements the 7-bit addressing polling mode.
+ * Asynchronous transactions (`periph_i2c_async`) are interrupt driven on the
+ * L0 and F0 families, whose single I2C interrupt (e.g. I2C_0_ISR) carries
+ * the transfer events. On the other families the board configures the error
+ * interrupt; the transactions of a device are interrupt driven if the board
+ * names both interrupt routines, e.g. I2C_0_ISR and I2C_0_EV_ISR, and sets
+ * i2c_conf_t::ev_irqn. The transactions of the other devices are polled.
  *
  * @author      Peter Kietzmann <peter.kietzmann@haw-hamburg.de>
  * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
@@ -42,6 +47,7 @@
 #include "cpu_conf_stm32_common.h"
 
 #include "periph/i2c.h"
+#include "periph/i2c_async.h"
 #include "periph/gpio.h"
 #include "periph_conf.h"
 
@@ -71,6 +77,47 @@ static inline int _wait_for_bus(I2C_TypeDef *i2c);
  */
 static mutex_t locks[I2C_NUMOF];
 
+#if defined(CPU_FAM_STM32L0) || defined(CPU_FAM_STM32F0)
+/* the single interrupt of each device carries the transfer events */
+#define ASYNC_SINGLE_IRQ    (1)
+#endif
+
+#if defined(I2C_0_ISR) && \
+    (defined(ASYNC_SINGLE_IRQ) || defined(I2C_0_EV_ISR))
+#define ASYNC_IRQ_DEV_0     (1U << 0)
+#else
+#define ASYNC_IRQ_DEV_0     (0U)
+#endif
+#if defined(I2C_1_ISR) && \
+    (defined(ASYNC_SINGLE_IRQ) || defined(I2C_1_EV_ISR))
+#define ASYNC_IRQ_DEV_1     (1U << 1)
+#else
+#define ASYNC_IRQ_DEV_1     (0U)
+#endif
+
+#if defined(MODULE_PERIPH_I2C_ASYNC) && (ASYNC_IRQ_DEV_0 || ASYNC_IRQ_DEV_1)
+#define ASYNC_IRQ       (1)
+
+/* whether the asynchronous transactions of a device are interrupt driven */
+#define ASYNC_IRQ_DEV(dev)  ((ASYNC_IRQ_DEV_0 | ASYNC_IRQ_DEV_1) & (1U << (dev)))
+
+#define ASYNC_IRQ_MASK  (I2C_CR1_TXIE | I2C_CR1_RXIE | I2C_CR1_TCIE | \
+                         I2C_CR1_STOPIE | I2C_CR1_NACKIE | I2C_CR1_ERRIE)
+
+/**
+ * @brief State of the running asynchronous transaction of each I2C device
+ */
+typedef struct {
+    i2c_async_xfer_t *xfer;     /**< running transaction, NULL if none */
+    uint8_t reg[2];             /**< register address in bus order */
+    uint8_t reg_len;            /**< length of the register address */
+    uint8_t pos;                /**< bytes transferred in the current phase */
+    int res;                    /**< result reported on STOP */
+} _async_t;
+
+static _async_t _async[I2C_NUMOF];
+#endif
+
 void i2c_init(i2c_t dev)
 {
     assert(dev < I2C_NUMOF);
@@ -84,6 +131,12 @@ void i2c_init(i2c_t dev)
 
     NVIC_SetPriority(i2c_config[dev].irqn, I2C_IRQ_PRIO);
     NVIC_EnableIRQ(i2c_config[dev].irqn);
+#if defined(ASYNC_IRQ) && !defined(ASYNC_SINGLE_IRQ)
+    if (ASYNC_IRQ_DEV(dev)) {
+        NVIC_SetPriority(i2c_config[dev].ev_irqn, I2C_IRQ_PRIO);
+        NVIC_EnableIRQ(i2c_config[dev].ev_irqn);
+    }
+#endif
 
 #if defined(CPU_FAM_STM32F0) || defined(CPU_FAM_STM32F3)
     /* Set I2CSW bits to enable I2C clock source */
@@ -401,12 +454,154 @@ static inline int _wait_for_bus(I2C_TypeDef *i2c)
     return 0;
 }
 
+#ifdef MODULE_PERIPH_I2C_ASYNC
+#ifdef ASYNC_IRQ
+void i2c_async_hw_begin(i2c_t dev)
+{
+    if (!ASYNC_IRQ_DEV(dev)) {
+        return;
+    }
+
+    I2C_TypeDef *i2c = i2c_config[dev].dev;
+
+    i2c->ICR |= CLEAR_FLAG | I2C_ICR_STOPCF;
+    i2c->CR1 |= ASYNC_IRQ_MASK;
+}
+
+int i2c_async_hw_start(i2c_t dev, i2c_async_xfer_t *xfer)
+{
+    if (!ASYNC_IRQ_DEV(dev)) {
+        i2c_async_poll(dev, xfer);
+        return 1;
+    }
+
+    I2C_TypeDef *i2c = i2c_config[dev].dev;
+    _async_t *a = &_async[dev];
+    uint32_t cr2 = (xfer->addr << 1) | I2C_CR2_START;
+
+    assert(!xfer->read || (xfer->len > 0));
+
+    a->reg_len = 0;
+    if (!(xfer->flags & I2C_ASYNC_NOREG)) {
+        if (xfer->flags & I2C_REG16) {
+            a->reg[a->reg_len++] = xfer->reg >> 8;
+        }
+        a->reg[a->reg_len++] = xfer->reg & 0xff;
+    }
+    a->pos = 0;
+    a->res = 0;
+    a->xfer = xfer;
+
+    if (!xfer->read) {
+        /* register address and data in one frame */
+        cr2 |= ((a->reg_len + xfer->len) << I2C_CR2_NBYTES_Pos) | I2C_CR2_AUTOEND;
+    }
+    else if (a->reg_len) {
+        /* register address, the read follows with a repeated start on TC */
+        cr2 |= a->reg_len << I2C_CR2_NBYTES_Pos;
+    }
+    else {
+        cr2 |= (xfer->len << I2C_CR2_NBYTES_Pos) | I2C_FLAG_READ | I2C_CR2_AUTOEND;
+    }
+    DEBUG("[i2c] async: start CR2=0x%08lX\n", (unsigned long)cr2);
+    i2c->CR2 = cr2;
+    return 0;
+}
+
+void i2c_async_hw_end(i2c_t dev)
+{
+    if (!ASYNC_IRQ_DEV(dev)) {
+        return;
+    }
+
+    i2c_config[dev].dev->CR1 &= ~ASYNC_IRQ_MASK;
+}
+
+static void _async_irq(i2c_t dev)
+{
+    I2C_TypeDef *i2c = i2c_config[dev].dev;
+    _async_t *a = &_async[dev];
+    i2c_async_xfer_t *xfer = a->xfer;
+    uint32_t isr = i2c->ISR;
+
+    if (isr & (I2C_ISR_ARLO | I2C_ISR_BERR)) {
+        DEBUG("[i2c] async: arbitration lost or bus error\n");
+        /* no STOP follows, reset the peripheral to leave the transfer */
+        i2c->ICR |= CLEAR_FLAG;
+        i2c->CR1 &= ~(I2C_CR1_PE);
+        i2c->CR1 |= I2C_CR1_PE;
+        xfer->res = -EAGAIN;
+        a->xfer = NULL;
+        i2c_async_isr_done(dev);
+        return;
+    }
+    if (isr & I2C_ISR_NACKF) {
+        DEBUG("[i2c] async: NACK received\n");
+        i2c->ICR |= I2C_ICR_NACKCF;
+        /* drop a byte left in TXDR, it would be sent with the next frame */
+        i2c->ISR |= I2C_ISR_TXE;
+        /* nothing accepted means the address was not acknowledged */
+        a->res = (a->pos == 0) ? -ENXIO : -EIO;
+        if (!(i2c->CR2 & I2C_CR2_AUTOEND)) {
+            i2c->CR2 |= I2C_CR2_STOP;
+        }
+        return;
+    }
+    if (isr & I2C_ISR_TXIS) {
+        i2c->TXDR = (a->pos < a->reg_len)
+                    ? a->reg[a->pos]
+                    : ((uint8_t *)xfer->data)[a->pos - a->reg_len];
+        a->pos++;
+    }
+    if (isr & I2C_ISR_RXNE) {
+        ((uint8_t *)xfer->data)[a->pos++] = i2c->RXDR;
+    }
+    if (isr & I2C_ISR_TC) {
+        /* register address sent, read with a repeated start */
+        a->pos = 0;
+        i2c->CR2 = (xfer->addr << 1) | (xfer->len << I2C_CR2_NBYTES_Pos) |
+                   I2C_FLAG_READ | I2C_CR2_START | I2C_CR2_AUTOEND;
+    }
+    if (isr & I2C_ISR_STOPF) {
+        i2c->ICR |= I2C_ICR_STOPCF;
+        xfer->res = a->res;
+        a->xfer = NULL;
+        i2c_async_isr_done(dev);
+    }
+}
+#else /* ASYNC_IRQ */
+void i2c_async_hw_begin(i2c_t dev)
+{
+    (void)dev;
+}
+
+int i2c_async_hw_start(i2c_t dev, i2c_async_xfer_t *xfer)
+{
+    i2c_async_poll(dev, xfer);
+    return 1;
+}
+
+void i2c_async_hw_end(i2c_t dev)
+{
+    (void)dev;
+}
+#endif /* ASYNC_IRQ */
+#endif /* MODULE_PERIPH_I2C_ASYNC */
+
 static inline void irq_handler(i2c_t dev)
 {
     assert(dev < I2C_NUMOF);
 
     I2C_TypeDef *i2c = i2c_config[dev].dev;
 
+#ifdef ASYNC_IRQ
+    if (_async[dev].xfer != NULL) {
+        _async_irq(dev);
+        cortexm_isr_end();
+        return;
+    }
+#endif
+
     unsigned state = i2c->ISR;
     DEBUG("\n\n### I2C ERROR OCCURED ###\n");
     DEBUG("status: %08x\n", state);
@@ -447,3 +642,17 @@ void I2C_1_ISR(void)
     irq_handler(I2C_DEV(1));
 }
 #endif /* I2C_1_ISR */
+
+#if defined(ASYNC_IRQ) && defined(I2C_0_EV_ISR) && ASYNC_IRQ_DEV_0
+void I2C_0_EV_ISR(void)
+{
+    irq_handler(I2C_DEV(0));
+}
+#endif /* I2C_0_EV_ISR */
+
+#if defined(ASYNC_IRQ) && defined(I2C_1_EV_ISR) && ASYNC_IRQ_DEV_1
+void I2C_1_EV_ISR(void)
+{
+    irq_handler(I2C_DEV(1));
+}
+#endif /* I2C_1_EV_ISR */
@@ -20,6 +20,10 @@
  * This driver supports the STM32 F1, F2, L1, and F4 families.
  *
  * @note This implementation only implements the 7-bit addressing polling mode.
+ * Asynchronous transactions (`periph_i2c_async`) of a device are driven by
+ * its event and error interrupts if the board names both interrupt routines,
+ * e.g. I2C_0_ISR and I2C_0_ER_ISR, and sets i2c_conf_t::er_irqn. The
+ * transactions of the other devices are polled.
  *
  * @author      Peter Kietzmann <peter.kietzmann@haw-hamburg.de>
  * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
@@ -43,6 +47,7 @@
 #include "pm_layered.h"
 
 #include "periph/i2c.h"
+#include "periph/i2c_async.h"
 #include "periph/gpio.h"
 #include "periph_conf.h"
 
@@ -71,6 +76,45 @@ static inline int _wait_for_bus(I2C_TypeDef *i2c);
  */
 static mutex_t locks[I2C_NUMOF];
 
+#if defined(I2C_0_ISR) && defined(I2C_0_ER_ISR)
+#define ASYNC_IRQ_DEV_0     (1U << 0)
+#else
+#define ASYNC_IRQ_DEV_0     (0U)
+#endif
+#if defined(I2C_1_ISR) && defined(I2C_1_ER_ISR)
+#define ASYNC_IRQ_DEV_1     (1U << 1)
+#else
+#define ASYNC_IRQ_DEV_1     (0U)
+#endif
+
+#if defined(MODULE_PERIPH_I2C_ASYNC) && (ASYNC_IRQ_DEV_0 || ASYNC_IRQ_DEV_1)
+#define ASYNC_IRQ       (1)
+
+/* whether the asynchronous transactions of a device are interrupt driven */
+#define ASYNC_IRQ_DEV(dev)  ((ASYNC_IRQ_DEV_0 | ASYNC_IRQ_DEV_1) & (1U << (dev)))
+
+/**
+ * @brief Phases of an asynchronous transaction
+ */
+enum {
+    ASYNC_WRITE,        /**< register address and data are written */
+    ASYNC_READ,         /**< data is read */
+};
+
+/**
+ * @brief State of the running asynchronous transaction of each I2C device
+ */
+typedef struct {
+    i2c_async_xfer_t *xfer;     /**< running transaction, NULL if none */
+    uint8_t reg[2];             /**< register address in bus order */
+    uint8_t reg_len;            /**< length of the register address */
+    uint8_t pos;                /**< bytes transferred in the current phase */
+    uint8_t phase;              /**< ASYNC_WRITE or ASYNC_READ */
+} _async_t;
+
+static _async_t _async[I2C_NUMOF];
+#endif
+
 void i2c_init(i2c_t dev)
 {
     assert(dev < I2C_NUMOF);
@@ -106,6 +150,13 @@ void i2c_init(i2c_t dev)
     periph_clk_en(i2c_config[dev].bus, i2c_config[dev].rcc_mask);
     NVIC_SetPriority(i2c_config[dev].irqn, I2C_IRQ_PRIO);
     NVIC_EnableIRQ(i2c_config[dev].irqn);
+#ifdef ASYNC_IRQ
+    /* enabled while asynchronous transactions run only, the polled
+     * functions handle the error flags themselves */
+    if (ASYNC_IRQ_DEV(dev)) {
+        NVIC_SetPriority(i2c_config[dev].er_irqn, I2C_IRQ_PRIO);
+    }
+#endif
 
     /* configure pins */
     DEBUG("[i2c] init: configuring pins\n");
@@ -410,7 +461,186 @@ static inline int _wait_for_bus(I2C_TypeDef *i2c)
     return 0;
 }
 
-#if I2C_0_ISR || I2C_1_ISR
+#ifdef MODULE_PERIPH_I2C_ASYNC
+#ifdef ASYNC_IRQ
+void i2c_async_hw_begin(i2c_t dev)
+{
+    if (!ASYNC_IRQ_DEV(dev)) {
+        return;
+    }
+
+    I2C_TypeDef *i2c = i2c_config[dev].dev;
+
+    i2c->SR1 &= ~ERROR_FLAG;
+    NVIC_ClearPendingIRQ(i2c_config[dev].er_irqn);
+    NVIC_EnableIRQ(i2c_config[dev].er_irqn);
+    i2c->CR2 |= I2C_CR2_ITEVTEN;
+}
+
+int i2c_async_hw_start(i2c_t dev, i2c_async_xfer_t *xfer)
+{
+    if (!ASYNC_IRQ_DEV(dev)) {
+        i2c_async_poll(dev, xfer);
+        return 1;
+    }
+
+    I2C_TypeDef *i2c = i2c_config[dev].dev;
+    _async_t *a = &_async[dev];
+
+    assert(!xfer->read || (xfer->len > 0));
+
+    a->reg_len = 0;
+    if (!(xfer->flags & I2C_ASYNC_NOREG)) {
+        if (xfer->flags & I2C_REG16) {
+            a->reg[a->reg_len++] = xfer->reg >> 8;
+        }
+        a->reg[a->reg_len++] = xfer->reg & 0xff;
+    }
+    a->pos = 0;
+    a->phase = (xfer->read && !a->reg_len) ? ASYNC_READ : ASYNC_WRITE;
+    a->xfer = xfer;
+
+    /* the STOP of the previous transaction must be out */
+    if (_wait_for_bus(i2c) < 0) {
+        a->xfer = NULL;
+        xfer->res = -ETIMEDOUT;
+        return 1;
+    }
+    DEBUG("[i2c] async: start\n");
+    i2c->SR1 &= ~ERROR_FLAG;
+    i2c->CR1 |= I2C_CR1_START | I2C_CR1_ACK;
+    return 0;
+}
+
+void i2c_async_hw_end(i2c_t dev)
+{
+    if (!ASYNC_IRQ_DEV(dev)) {
+        return;
+    }
+
+    i2c_config[dev].dev->CR2 &= ~(I2C_CR2_ITEVTEN | I2C_CR2_ITBUFEN);
+    NVIC_DisableIRQ(i2c_config[dev].er_irqn);
+}
+
+static void _async_done(i2c_t dev, int res)
+{
+    I2C_TypeDef *i2c = i2c_config[dev].dev;
+    i2c_async_xfer_t *xfer = _async[dev].xfer;
+
+    i2c->CR2 &= ~I2C_CR2_ITBUFEN;
+    if (_wait_for_bus(i2c) < 0) {
+        res = -ETIMEDOUT;
+    }
+    xfer->res = res;
+    _async[dev].xfer = NULL;
+    i2c_async_isr_done(dev);
+}
+
+static void _async_irq(i2c_t dev)
+{
+    I2C_TypeDef *i2c = i2c_config[dev].dev;
+    _async_t *a = &_async[dev];
+    i2c_async_xfer_t *xfer = a->xfer;
+    uint32_t sr1 = i2c->SR1;
+    size_t tx_len = a->reg_len + (xfer->read ? 0 : xfer->len);
+
+    if (sr1 & (I2C_SR1_ARLO | I2C_SR1_BERR)) {
+        DEBUG("[i2c] async: arbitration lost or bus error\n");
+        i2c->SR1 &= ~ERROR_FLAG;
+        _stop(i2c);
+        _async_done(dev, -EAGAIN);
+        return;
+    }
+    if (sr1 & I2C_SR1_AF) {
+        DEBUG("[i2c] async: NACK received\n");
+        i2c->SR1 &= ~I2C_SR1_AF;
+        _stop(i2c);
+        /* nothing accepted means the address was not acknowledged */
+        _async_done(dev, (a->pos == 0) ? -ENXIO : -EIO);
+        return;
+    }
+    if (sr1 & I2C_SR1_SB) {
+        /* reading SR1 and writing DR clears SB */
+        i2c->DR = (xfer->addr << 1) |
+                  ((a->phase == ASYNC_READ) ? I2C_FLAG_READ : I2C_FLAG_WRITE);
+        return;
+    }
+    if (sr1 & I2C_SR1_ADDR) {
+        if ((a->phase == ASYNC_READ) && (xfer->len == 1)) {
+            /* NACK and STOP must be set around clearing ADDR */
+            i2c->CR1 &= ~I2C_CR1_ACK;
+            i2c->SR2;
+            i2c->CR1 |= I2C_CR1_STOP;
+        }
+        else {
+            i2c->SR2;
+        }
+        if ((a->phase == ASYNC_WRITE) && (tx_len == 0)) {
+            _stop(i2c);
+            _async_done(dev, 0);
+            return;
+        }
+        i2c->CR2 |= I2C_CR2_ITBUFEN;
+        return;
+    }
+    if (a->phase == ASYNC_READ) {
+        if (sr1 & I2C_SR1_RXNE) {
+            ((uint8_t *)xfer->data)[a->pos++] = i2c->DR;
+            if (a->pos == xfer->len) {
+                _async_done(dev, 0);
+            }
+            else if (a->pos == xfer->len - 1) {
+                /* NACK the last byte and STOP after it */
+                i2c->CR1 &= ~I2C_CR1_ACK;
+                i2c->CR1 |= I2C_CR1_STOP;
+            }
+        }
+        return;
+    }
+    if ((sr1 & I2C_SR1_TXE) && (a->pos < tx_len)) {
+        i2c->DR = (a->pos < a->reg_len)
+                  ? a->reg[a->pos]
+                  : ((uint8_t *)xfer->data)[a->pos - a->reg_len];
+        if (++a->pos == tx_len) {
+            /* continue on BTF of the last byte */
+            i2c->CR2 &= ~I2C_CR2_ITBUFEN;
+        }
+        return;
+    }
+    if (sr1 & I2C_SR1_BTF) {
+        if (xfer->read) {
+            /* register address sent, read with a repeated start, SB
+             * clears BTF */
+            a->phase = ASYNC_READ;
+            a->pos = 0;
+            i2c->CR1 |= I2C_CR1_START | I2C_CR1_ACK;
+        }
+        else {
+            _stop(i2c);
+            _async_done(dev, 0);
+        }
+    }
+}
+#else /* ASYNC_IRQ */
+void i2c_async_hw_begin(i2c_t dev)
+{
+    (void)dev;
+}
+
+int i2c_async_hw_start(i2c_t dev, i2c_async_xfer_t *xfer)
+{
+    i2c_async_poll(dev, xfer);
+    return 1;
+}
+
+void i2c_async_hw_end(i2c_t dev)
+{
+    (void)dev;
+}
+#endif /* ASYNC_IRQ */
+#endif /* MODULE_PERIPH_I2C_ASYNC */
+
+#if defined(I2C_0_ISR) || defined(I2C_1_ISR)
 static inline void irq_handler(i2c_t dev)
 {
     assert(dev < I2C_NUMOF);
@@ -419,6 +649,14 @@ static inline void irq_handler(i2c_t dev)
 
     assert(i2c != NULL);
 
+#ifdef ASYNC_IRQ
+    if (_async[dev].xfer != NULL) {
+        _async_irq(dev);
+        cortexm_isr_end();
+        return;
+    }
+#endif
+
     unsigned state = i2c->SR1;
     DEBUG("\n\n### I2C ERROR OCCURED ###\n");
     DEBUG("status: %08x\n", state);
@@ -449,16 +687,30 @@ static inline void irq_handler(i2c_t dev)
 }
 #endif
 
-#if I2C_0_ISR
+#ifdef I2C_0_ISR
 void I2C_0_ISR(void)
 {
     irq_handler(I2C_DEV(0));
 }
 #endif /* I2C_0_ISR */
 
-#if I2C_1_ISR
+#ifdef I2C_1_ISR
 void I2C_1_ISR(void)
 {
     irq_handler(I2C_DEV(1));
 }
 #endif /* I2C_1_ISR */
+
+#if defined(ASYNC_IRQ) && ASYNC_IRQ_DEV_0
+void I2C_0_ER_ISR(void)
+{
+    irq_handler(I2C_DEV(0));
+}
+#endif /* I2C_0_ER_ISR */
+
+#if defined(ASYNC_IRQ) && ASYNC_IRQ_DEV_1
+void I2C_1_ER_ISR(void)
+{
+    irq_handler(I2C_DEV(1));
+}
+#endif /* I2C_1_ER_ISR */
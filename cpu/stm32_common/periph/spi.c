@@ -30,6 +30,9 @@
 #include "mutex.h"
 #include "assert.h"
 #include "periph/spi.h"
+#ifdef MODULE_PERIPH_SPI_ASYNC
+#include "periph/spi_async.h"
+#endif
 #include "pm_layered.h"
 
 /**
@@ -117,6 +120,18 @@ int spi_init_cs(spi_t bus, spi_cs_t cs)
     return SPI_OK;
 }
 
+static void _configure(spi_t bus, spi_cs_t cs, spi_mode_t mode, spi_clk_t clk)
+{
+    uint8_t br = spi_divtable[spi_config[bus].apbbus][clk];
+    dev(bus)->CR1 = ((br << BR_SHIFT) | mode | SPI_CR1_MSTR);
+    if (cs != SPI_HWCS_MASK) {
+        dev(bus)->CR1 |= (SPI_CR1_SSM | SPI_CR1_SSI);
+    }
+    else {
+        dev(bus)->CR2 |= (SPI_CR2_SSOE);
+    }
+}
+
 int spi_acquire(spi_t bus, spi_cs_t cs, spi_mode_t mode, spi_clk_t clk)
 {
     /* lock bus */
@@ -128,14 +143,7 @@ int spi_acquire(spi_t bus, spi_cs_t cs, spi_mode_t mode, spi_clk_t clk)
     /* enable SPI device clock */
     periph_clk_en(spi_config[bus].apbbus, spi_config[bus].rccmask);
     /* enable device */
-    uint8_t br = spi_divtable[spi_config[bus].apbbus][clk];
-    dev(bus)->CR1 = ((br << BR_SHIFT) | mode | SPI_CR1_MSTR);
-    if (cs != SPI_HWCS_MASK) {
-        dev(bus)->CR1 |= (SPI_CR1_SSM | SPI_CR1_SSI);
-    }
-    else {
-        dev(bus)->CR2 |= (SPI_CR2_SSOE);
-    }
+    _configure(bus, cs, mode, clk);
 
     return SPI_OK;
 }
@@ -278,3 +286,116 @@ void spi_transfer_bytes(spi_t bus, spi_cs_t cs, bool cont,
         }
     }
 }
+
+#ifdef MODULE_PERIPH_SPI_ASYNC
+/**
+ * @brief   Transfer currently running on each bus
+ */
+static const spi_async_xfer_t *_async_xfer[SPI_NUMOF];
+
+/**
+ * @brief   Source and sink of DMA transfers without buffer
+ */
+static const uint8_t _async_zero;
+static uint8_t _async_sink[SPI_NUMOF];
+
+static inline bool _has_dma(spi_t bus)
+{
+    return (spi_config[bus].tx_dma != DMA_STREAM_UNDEF)
+           && (spi_config[bus].rx_dma != DMA_STREAM_UNDEF);
+}
+
+static void _async_tx_done(void *arg)
+{
+    /* the end of the transfer is signaled by the RX stream */
+    (void)arg;
+}
+
+static void _async_rx_done(void *arg)
+{
+    spi_t bus = (spi_t)(uintptr_t)arg;
+    const spi_async_xfer_t *xfer = _async_xfer[bus];
+
+    dev(bus)->CR2 &= ~(SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+    dma_stop(spi_config[bus].tx_dma);
+    dma_stop(spi_config[bus].rx_dma);
+    _wait_for_end(bus);
+
+    /* the request may be the last one of the queue, so the peripheral must
+     * not be left enabled, even if the chip select is handled by the user */
+    if (!xfer->cont) {
+        dev(bus)->CR1 &= ~(SPI_CR1_SPE);
+        if ((xfer->cs != SPI_HWCS_MASK) && (xfer->cs != SPI_CS_UNDEF)) {
+            gpio_set((gpio_t)xfer->cs);
+        }
+    }
+    spi_async_isr_done(bus);
+}
+
+void spi_async_hw_begin(spi_t bus)
+{
+    if (_has_dma(bus)) {
+        dma_acquire(spi_config[bus].tx_dma);
+        dma_acquire(spi_config[bus].rx_dma);
+        dma_set_cb(spi_config[bus].tx_dma, _async_tx_done, NULL);
+        dma_set_cb(spi_config[bus].rx_dma, _async_rx_done,
+                   (void *)(uintptr_t)bus);
+    }
+}
+
+int spi_async_hw_start(spi_t bus, const spi_async_xfer_t *xfer, bool cs_active)
+{
+    if (!cs_active) {
+        _configure(bus, xfer->cs, xfer->mode, xfer->clk);
+    }
+    if (!_has_dma(bus)) {
+        spi_transfer_bytes(bus, xfer->cs, xfer->cont, xfer->out, xfer->in,
+                           xfer->len);
+        return 1;
+    }
+
+    _async_xfer[bus] = xfer;
+
+    dev(bus)->CR1 |= (SPI_CR1_SPE);
+    if ((xfer->cs != SPI_HWCS_MASK) && (xfer->cs != SPI_CS_UNDEF)) {
+        gpio_clear((gpio_t)xfer->cs);
+    }
+
+    if (!xfer->out) {
+        dma_configure(spi_config[bus].tx_dma, spi_config[bus].tx_dma_chan,
+                      &_async_zero, &(dev(bus)->DR), xfer->len,
+                      DMA_MEM_TO_PERIPH, 0);
+    }
+    else {
+        dma_configure(spi_config[bus].tx_dma, spi_config[bus].tx_dma_chan,
+                      xfer->out, &(dev(bus)->DR), xfer->len,
+                      DMA_MEM_TO_PERIPH, DMA_INC_SRC_ADDR);
+    }
+    if (!xfer->in) {
+        dma_configure(spi_config[bus].rx_dma, spi_config[bus].rx_dma_chan,
+                      &(dev(bus)->DR), &_async_sink[bus], xfer->len,
+                      DMA_PERIPH_TO_MEM, 0);
+    }
+    else {
+        dma_configure(spi_config[bus].rx_dma, spi_config[bus].rx_dma_chan,
+                      &(dev(bus)->DR), xfer->in, xfer->len,
+                      DMA_PERIPH_TO_MEM, DMA_INC_DST_ADDR);
+    }
+    dev(bus)->CR2 |= SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN;
+
+    dma_start(spi_config[bus].rx_dma);
+    dma_start(spi_config[bus].tx_dma);
+
+    return 0;
+}
+
+void spi_async_hw_end(spi_t bus)
+{
+    if (_has_dma(bus)) {
+        dma_set_cb(spi_config[bus].tx_dma, NULL, NULL);
+        dma_set_cb(spi_config[bus].rx_dma, NULL, NULL);
+        dma_release(spi_config[bus].tx_dma);
+        dma_release(spi_config[bus].rx_dma);
+    }
+}
+#endif /* MODULE_PERIPH_SPI_ASYNC */
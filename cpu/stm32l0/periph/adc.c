@@ -246,6 +246,29 @@ int adc_sample(adc_t line,  adc_res_t res)
 
 static adc_cb_t adc_dma_callback;
 
+/* sets up DMA channel 1 to move the conversion results into buf */
+static void _dma_setup(uint16_t *buf, uint16_t wsize)
+{
+    /* setup DMA channel 1 */
+    DMA1_Channel1->CCR = 0;
+    /* high priority */
+    DMA1_Channel1->CCR |= DMA_CCR_PL_1;
+    /* 16-bit memory size */
+    DMA1_Channel1->CCR |= DMA_CCR_MSIZE_0;
+    /* 16-bit peripheral size */
+    DMA1_Channel1->CCR |= DMA_CCR_PSIZE_0;
+    /* memory increment mode */
+    DMA1_Channel1->CCR |= DMA_CCR_MINC;
+    /* transfer completed IRQ */
+    DMA1_Channel1->CCR |= DMA_CCR_TCIE;
+    /* number of data */
+    DMA1_Channel1->CNDTR = wsize;
+    /* peripheral address */
+    DMA1_Channel1->CPAR = (uint32_t)(&ADC1->DR);
+    /* memory address */
+    DMA1_Channel1->CMAR = (uint32_t)buf;
+}
+
 int adc_sampling_start(adc_t line, adc_res_t res, uint16_t *buf, uint16_t wsize, adc_cb_t adc_cb, adc_conconv_mode_t mode)
 {
     /* check if resolution is applicable */
@@ -290,24 +313,7 @@ int adc_sampling_start(adc_t line, adc_res_t res, uint16_t *buf, uint16_t wsize,
     /* enable DMA */
     ADC1->CFGR1 |= ADC_CFGR1_DMAEN;
     
-    /* setup DMA channel 1 */
-    DMA1_Channel1->CCR = 0;
-    /* high priority */
-    DMA1_Channel1->CCR |= DMA_CCR_PL_1;
-    /* 16-bit memory size */
-    DMA1_Channel1->CCR |= DMA_CCR_MSIZE_0;
-    /* 16-bit peripheral size */
-    DMA1_Channel1->CCR |= DMA_CCR_PSIZE_0;
-    /* memory increment mode */
-    DMA1_Channel1->CCR |= DMA_CCR_MINC;
-    /* transfer completed IRQ */
-    DMA1_Channel1->CCR |= DMA_CCR_TCIE;
-    /* number of data */
-    DMA1_Channel1->CNDTR = wsize;
-    /* peripheral address */
-    DMA1_Channel1->CPAR = (uint32_t)(&ADC1->DR);
-    /* memory address */
-    DMA1_Channel1->CMAR = (uint32_t)buf;
+    _dma_setup(buf, wsize);
     
     /* disable interrupt */
     ADC1->IER &= ~ADC_IER_EOCIE;
@@ -335,6 +341,113 @@ int adc_sampling_start(adc_t line, adc_res_t res, uint16_t *buf, uint16_t wsize,
     return 0;
 }
 
+int adc_scan_start(uint32_t lines, adc_res_t res, unsigned oversampling,
+                   bool triggered, uint16_t *buf, uint16_t wsize,
+                   adc_cb_t adc_cb)
+{
+    uint32_t chselr = 0;
+    unsigned numof = 0;
+    int first = -1;
+    int last_chan = -1;
+
+    /* check if resolution is applicable */
+    if ( (res != ADC_RES_6BIT) &&
+         (res != ADC_RES_8BIT) &&
+         (res != ADC_RES_10BIT) &&
+         (res != ADC_RES_12BIT)) {
+        return -1;
+    }
+
+    /* 2x to 256x */
+    if ((oversampling > 8) || (!buf) || (!adc_cb)) {
+        return -1;
+    }
+
+    for (unsigned line = 0; line < ADC_NUMOF; line++) {
+        if (!(lines & (1UL << line))) {
+            continue;
+        }
+        /* the hardware converts the selected channels in ascending order */
+        if (adc_config[line].chan <= last_chan) {
+            return -1;
+        }
+        if (first < 0) {
+            first = line;
+        }
+        last_chan = adc_config[line].chan;
+        chselr |= (1UL << last_chan);
+        numof++;
+    }
+
+    /* each buffer half holds complete scans */
+    if ((numof == 0) || (wsize % (2 * numof))) {
+        return -1;
+    }
+
+    /* block STOP mode */
+    pm_block(PM_SLEEP);
+
+    adc_dma_callback = adc_cb;
+
+    /* lock and power on the ADC device  */
+    prep();
+
+    /* oversampling can only be configured while the ADC is disabled,
+     * the result is shifted back to the selected resolution */
+    ADC1->CFGR2 &= ~(ADC_CFGR2_OVSS | ADC_CFGR2_OVSR | ADC_CFGR2_OVSE);
+    if (oversampling) {
+        ADC1->CFGR2 |= ((oversampling - 1) << ADC_CFGR2_OVSR_Pos) |
+                       (oversampling << ADC_CFGR2_OVSS_Pos) |
+                       ADC_CFGR2_OVSE;
+    }
+
+    _enable_adc();
+
+    if (chselr & ((1UL << ADC_VREF_CHANNEL) | (1UL << ADC_TEMPERATURE_CHANNEL))) {
+        ADC->CCR |= (ADC_CCR_VREFEN | ADC_CCR_TSEN);
+        while ((PWR->CSR & PWR_CSR_VREFINTRDYF) == 0) {}
+    }
+
+    /* enable DMA clock */
+    periph_clk_en(AHB, RCC_AHBENR_DMA1EN);
+    /* disable DMA channel */
+    DMA1_Channel1->CCR &= ~DMA_CCR_EN;
+
+    /* set resolution, upward scan, circular DMA */
+    ADC1->CFGR1 &= ~(ADC_CFGR1_RES | ADC_CFGR1_SCANDIR | ADC_CFGR1_EXTSEL |
+                     ADC_CFGR1_EXTEN | ADC_CFGR1_CONT | ADC_CFGR1_DISCEN);
+    ADC1->CFGR1 |= (res & ADC_CFGR1_RES) | ADC_CFGR1_DMAEN | ADC_CFGR1_DMACFG;
+
+    if (triggered) {
+        /* hardware trigger rising edge starts a scan */
+        ADC1->CFGR1 |= ((uint32_t)adc_config[first].trigger << 6);
+        ADC1->CFGR1 |= ADC_CFGR1_EXTEN_0;
+    }
+    else {
+        ADC1->CFGR1 |= ADC_CFGR1_CONT;
+    }
+
+    ADC1->CHSELR = chselr;
+
+    _dma_setup(buf, wsize);
+    DMA1_Channel1->CCR |= DMA_CCR_CIRC;
+    DMA1_Channel1->CCR |= DMA_CCR_HTIE;
+
+    /* disable interrupt */
+    ADC1->IER &= ~ADC_IER_EOCIE;
+
+    /* enable DMA IRQ */
+    NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
+    /* Enable DMA channel */
+    DMA1_Channel1->CCR |= DMA_CCR_EN;
+
+    /* start ADC */
+    ADC1->CR |= ADC_CR_ADSTART;
+
+    return 0;
+}
+
 int adc_sampling_stop(void) {
     /* disable DMA */
     ADC1->CFGR1 &= ~ADC_CFGR1_DMAEN;
@@ -347,6 +460,12 @@ int adc_sampling_stop(void) {
     
     /* power off and unlock ADC */
     _disable_adc();
+
+    /* leave the single conversion setup for adc_sample() */
+    ADC1->CFGR1 &= ~(ADC_CFGR1_CONT | ADC_CFGR1_EXTEN | ADC_CFGR1_DMACFG);
+    ADC1->CFGR2 &= ~(ADC_CFGR2_OVSS | ADC_CFGR2_OVSR | ADC_CFGR2_OVSE);
+    ADC->CCR &= ~(ADC_CCR_VREFEN | ADC_CCR_TSEN);
+
     done();
     
     /* unblock STOP mode */
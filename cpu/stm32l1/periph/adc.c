@@ -309,6 +309,29 @@ int adc_sample(adc_t line,  adc_res_t res)
 
 static adc_cb_t adc_dma_callback;
 
+/* sets up DMA channel 1 to move the conversion results into buf */
+static void _dma_setup(uint16_t *buf, uint16_t wsize)
+{
+    /* setup DMA channel 1 */
+    DMA1_Channel1->CCR = 0;
+    /* high priority */
+    DMA1_Channel1->CCR |= DMA_CCR_PL_1;
+    /* 16-bit memory size */
+    DMA1_Channel1->CCR |= DMA_CCR_MSIZE_0;
+    /* 16-bit peripheral size */
+    DMA1_Channel1->CCR |= DMA_CCR_PSIZE_0;
+    /* memory increment mode */
+    DMA1_Channel1->CCR |= DMA_CCR_MINC;
+    /* transfer completed IRQ */
+    DMA1_Channel1->CCR |= DMA_CCR_TCIE;
+    /* number of data */
+    DMA1_Channel1->CNDTR = wsize;
+    /* peripheral address */
+    DMA1_Channel1->CPAR = (uint32_t)(&ADC1->DR);
+    /* memory address */
+    DMA1_Channel1->CMAR = (uint32_t)buf;
+}
+
 int adc_sampling_start(adc_t line, adc_res_t res, uint16_t *buf, uint16_t wsize, adc_cb_t adc_cb, adc_conconv_mode_t mode)
 {
     /* check if resolution is applicable */
@@ -348,24 +371,7 @@ int adc_sampling_start(adc_t line, adc_res_t res, uint16_t *buf, uint16_t wsize,
     /* enable DMA */
     ADC1->CR2 |= ADC_CR2_DMA;
     
-    /* setup DMA channel 1 */
-    DMA1_Channel1->CCR = 0;
-    /* high priority */
-    DMA1_Channel1->CCR |= DMA_CCR_PL_1;
-    /* 16-bit memory size */
-    DMA1_Channel1->CCR |= DMA_CCR_MSIZE_0;
-    /* 16-bit peripheral size */
-    DMA1_Channel1->CCR |= DMA_CCR_PSIZE_0;
-    /* memory increment mode */
-    DMA1_Channel1->CCR |= DMA_CCR_MINC;
-    /* transfer completed IRQ */
-    DMA1_Channel1->CCR |= DMA_CCR_TCIE;
-    /* number of data */
-    DMA1_Channel1->CNDTR = wsize;
-    /* peripheral address */
-    DMA1_Channel1->CPAR = (uint32_t)(&ADC1->DR);
-    /* memory address */
-    DMA1_Channel1->CMAR = (uint32_t)buf;
+    _dma_setup(buf, wsize);
     
     /* disable interrupt */
     ADC1->CR1 &= ~ADC_CR1_EOCIE;
@@ -398,6 +404,121 @@ int adc_sampling_start(adc_t line, adc_res_t res, uint16_t *buf, uint16_t wsize,
     return 0;
 }
 
+int adc_scan_start(uint32_t lines, adc_res_t res, unsigned oversampling,
+                   bool triggered, uint16_t *buf, uint16_t wsize,
+                   adc_cb_t adc_cb)
+{
+    /* regular sequence registers, SQR5 holds the first conversions */
+    uint32_t sqr[5] = { 0 };
+    unsigned numof = 0;
+    int first = -1;
+    bool internal = false;
+
+    /* check if resolution is applicable */
+    if ( (res != ADC_RES_6BIT) &&
+         (res != ADC_RES_8BIT) &&
+         (res != ADC_RES_10BIT) &&
+         (res != ADC_RES_12BIT)) {
+        return -1;
+    }
+
+    /* no hardware oversampling on STM32L1 */
+    if ((oversampling != 0) || (!buf) || (!adc_cb)) {
+        return -1;
+    }
+
+    for (unsigned line = 0; line < ADC_NUMOF; line++) {
+        if (!(lines & (1UL << line))) {
+            continue;
+        }
+        if (first < 0) {
+            first = line;
+        }
+        if ((adc_config[line].chan == ADC_TEMPERATURE_CHANNEL) ||
+            (adc_config[line].chan == ADC_VREF_CHANNEL)) {
+            internal = true;
+        }
+        sqr[numof / 6] |= (uint32_t)adc_config[line].chan << ((numof % 6) * 5);
+        numof++;
+    }
+
+    /* each buffer half holds complete scans */
+    if ((numof == 0) || (numof > 27) || (wsize % (2 * numof))) {
+        return -1;
+    }
+
+    adc_dma_callback = adc_cb;
+
+    /* lock and power on the ADC device  */
+    prep();
+
+    /* reset DMA bit */
+    ADC1->CR2 &= ~ADC_CR2_DMA;
+
+    /* enable DMA clock */
+    periph_clk_en(AHB, RCC_AHBENR_DMA1EN);
+    /* disable DMA channel */
+    DMA1_Channel1->CCR &= ~DMA_CCR_EN;
+
+    /* internal channels need at least 4 us of sampling time */
+    adc_set_sample_time(internal ? ADC_SAMPLE_TIME_96C : ADC_SAMPLE_TIME_16C);
+    if (internal) {
+        ADC->CCR |= ADC_CCR_TSVREFE;
+        while ((PWR->CSR & PWR_CSR_VREFINTRDYF) == 0) {}
+    }
+
+    /* set resolution and scan mode */
+    ADC1->CR1 &= ~ADC_CR1_RES;
+    ADC1->CR1 |= (res & ADC_CR1_RES) | ADC_CR1_SCAN;
+
+    ADC1->CR2 &= ~(ADC_CR2_EXTSEL | ADC_CR2_EXTEN | ADC_CR2_CONT);
+    if (triggered) {
+        /* hardware trigger rising edge starts a scan */
+        ADC1->CR2 |= ((uint32_t)adc_config[first].trigger << 24);
+        ADC1->CR2 |= ADC_CR2_EXTEN_0;
+    }
+    else {
+        ADC1->CR2 |= ADC_CR2_CONT;
+    }
+
+    /* enable circular DMA */
+    ADC1->CR2 |= ADC_CR2_DMA | ADC_CR2_DDS;
+
+    _dma_setup(buf, wsize);
+    DMA1_Channel1->CCR |= DMA_CCR_CIRC;
+    DMA1_Channel1->CCR |= DMA_CCR_HTIE;
+
+    /* disable interrupt */
+    ADC1->CR1 &= ~ADC_CR1_EOCIE;
+
+    /* set the sequence */
+    ADC1->SQR5 = sqr[0];
+    ADC1->SQR4 = sqr[1];
+    ADC1->SQR3 = sqr[2];
+    ADC1->SQR2 = sqr[3];
+    ADC1->SQR1 = sqr[4] | ((numof - 1) << ADC_SQR1_L_Pos);
+
+    /* wait for regular channel to be ready*/
+    while (ADC1->SR & ADC_SR_RCNR) {}
+
+    /* enable DMA IRQ */
+    NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
+    /* Enable DMA channel */
+    DMA1_Channel1->CCR |= DMA_CCR_EN;
+
+    start();
+
+    if (!triggered) {
+        ADC1->CR2 |= ADC_CR2_SWSTART;
+    }
+
+    /* block STOP mode */
+    pm_block(PM_SLEEP);
+
+    return 0;
+}
+
 int adc_sampling_stop(void) {
     /* reset DMA bit */
     ADC1->CR2 &= ~ADC_CR2_DMA;
@@ -407,6 +528,11 @@ int adc_sampling_stop(void) {
     
     /* disable IRQ */
     NVIC_DisableIRQ(DMA1_Channel1_IRQn);
+
+    /* leave the single conversion setup for adc_sample() */
+    ADC1->CR1 &= ~ADC_CR1_SCAN;
+    ADC1->CR2 &= ~(ADC_CR2_EXTEN | ADC_CR2_CONT | ADC_CR2_DDS);
+    ADC->CCR &= ~ADC_CCR_TSVREFE;
     
     /* power off and unlock ADC */
     done();
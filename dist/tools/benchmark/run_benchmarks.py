@@ -0,0 +1,193 @@
+#! /usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""
+Build and run the `tests/bench_*` applications on native with JSON benchmark
+output, and compare the results against a stored baseline.
+
+Each JSON line printed by the `benchmark` module is one result. Results with
+a `median` are compared by median, otherwise by `mean` or `value`. Units ending
+in `/s` are throughputs (higher is better), all others are durations (lower is
+better). Lines that are not JSON are ignored, so tests without benchmark
+output are simply reported as empty.
+
+Example
+-------
+
+Record a baseline, then compare a later tree against it:
+
+    ./run_benchmarks.py --baseline baseline.json --update-baseline
+    ./run_benchmarks.py --baseline baseline.json --threshold 10
+
+The exit code is 1 if any result regressed by more than the threshold.
+"""
+
+import argparse
+import glob
+import json
+import os
+import select
+import subprocess
+import sys
+import time
+
+RIOTBASE = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..', '..'))
+BENCH_CFLAGS = '-DBENCHMARK_FORMAT=BENCHMARK_FORMAT_JSON'
+
+
+def list_tests(riotbase, names):
+    if names:
+        return [os.path.join(riotbase, 'tests', n) for n in names]
+    return sorted(d for d in glob.glob(os.path.join(riotbase, 'tests', 'bench_*'))
+                  if os.path.isfile(os.path.join(d, 'Makefile')))
+
+
+def make(testdir, targets, env, **kwargs):
+    cmd = ['make', '--no-print-directory', '-C', testdir, 'BOARD=native'] + targets
+    return subprocess.Popen(cmd, env=env, **kwargs)
+
+
+def build(testdir, env):
+    proc = make(testdir, ['clean', 'all'], env,
+                stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+    _, err = proc.communicate()
+    if proc.returncode:
+        sys.stderr.write(err.decode(errors='replace'))
+    return proc.returncode == 0
+
+
+def run(testdir, env, timeout, idle):
+    """Run a test until it is silent for `idle` seconds or `timeout` passed"""
+    proc = make(testdir, ['term'], env, stdin=subprocess.DEVNULL,
+                stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    results = {}
+    buf = b''
+    start = last = time.monotonic()
+
+    try:
+        while True:
+            now = time.monotonic()
+            if now - start > timeout or now - last > idle:
+                break
+            ready, _, _ = select.select([proc.stdout], [], [], 0.1)
+            if not ready:
+                continue
+            data = os.read(proc.stdout.fileno(), 4096)
+            if not data:
+                break
+            last = time.monotonic()
+            buf += data
+            *lines, buf = buf.split(b'\n')
+            for line in lines:
+                line = line.decode(errors='replace').strip()
+                if not line.startswith('{'):
+                    continue
+                try:
+                    res = json.loads(line)
+                except ValueError:
+                    continue
+                if 'name' in res:
+                    results[res['name']] = res
+    finally:
+        proc.terminate()
+        try:
+            proc.wait(5)
+        except subprocess.TimeoutExpired:
+            proc.kill()
+
+    return results
+
+
+def metric(res):
+    for key in ('median', 'mean', 'value'):
+        if key in res:
+            return key, res[key]
+    return None, None
+
+
+def compare(results, baseline, threshold):
+    regressions = 0
+
+    for test in sorted(results):
+        for name, res in sorted(results[test].items()):
+            key, value = metric(res)
+            unit = res.get('unit', '')
+            line = '{:32} {:32} {:>12} {:8}'.format(test, name, value, unit)
+
+            base = baseline.get(test, {}).get(name)
+            if base is None or metric(base)[1] in (None, 0):
+                print(line + '  (no baseline)')
+                continue
+
+            ref = metric(base)[1]
+            change = 100.0 * (value - ref) / ref
+            worse = -change if unit.endswith('/s') else change
+            flag = ''
+            if worse > threshold:
+                flag = '  REGRESSION'
+                regressions += 1
+            print(line + ' {:>12} {:+7.1f}%{}'.format(ref, change, flag))
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__.split('\n\n')[0],
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('tests', nargs='*',
+                        help='tests to run, default all tests/bench_*')
+    parser.add_argument('--riotbase', default=RIOTBASE,
+                        help='RIOT directory, default %(default)s')
+    parser.add_argument('--baseline', help='baseline JSON file')
+    parser.add_argument('--update-baseline', action='store_true',
+                        help='store the results as new baseline')
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help='allowed regression in percent, default %(default)s')
+    parser.add_argument('--timeout', type=float, default=120,
+                        help='maximum run time per test in s, default %(default)s')
+    parser.add_argument('--idle', type=float, default=10,
+                        help='stop a test after that many s without output, '
+                             'default %(default)s')
+    args = parser.parse_args()
+
+    env = dict(os.environ)
+    env['CFLAGS'] = (env.get('CFLAGS', '') + ' ' + BENCH_CFLAGS).strip()
+
+    results = {}
+    failed = []
+    for testdir in list_tests(args.riotbase, args.tests):
+        test = os.path.basename(os.path.normpath(testdir))
+        print('running {}'.format(test), file=sys.stderr)
+        if not build(testdir, env):
+            failed.append(test)
+            continue
+        results[test] = run(testdir, env, args.timeout, args.idle)
+
+    baseline = {}
+    if args.baseline and os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    regressions = compare(results, baseline, args.threshold)
+
+    if args.baseline and args.update_baseline:
+        baseline.update(results)
+        with open(args.baseline, 'w') as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+            f.write('\n')
+        regressions = 0
+
+    for test in failed:
+        print('{}: build failed'.format(test), file=sys.stderr)
+
+    return 1 if (regressions or failed) else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -8,12 +8,18 @@
 
 #include <errno.h>
 #include <string.h>
+#ifdef MODULE_AT_ASYNC
+#include <strings.h>
+#endif
 
 #include "at.h"
 #include "fmt.h"
 #include "isrpipe.h"
 #include "periph/uart.h"
 #include "xtimer.h"
+#ifdef MODULE_AT_ASYNC
+#include "thread_flags.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -26,21 +32,47 @@
     #define TX_BUF_LEN  (32)
 #endif
 
+#ifdef MODULE_AT_ASYNC
+#define AT_FLAG_RX      (1u << 0)   /**< input available */
+#define AT_FLAG_CMD     (1u << 1)   /**< command queued or released */
+
+static inline bool _async(at_dev_t *dev)
+{
+    /* the owner of the input and output uses the raw functions */
+    return (dev->pid != KERNEL_PID_UNDEF) && (dev->raw_owner != thread_getpid());
+}
+#endif
+
 static uint8_t tx_buf[TX_BUF_LEN];
 
-static void _isrpipe_write_one_wrapper(void *_isrpipe, uint8_t data)
+static void _isrpipe_write_one_wrapper(void *arg, uint8_t data)
 {
-    isrpipe_write_one(_isrpipe, (char)data);
+    at_dev_t *dev = arg;
+
+    isrpipe_write_one(&dev->isrpipe, (char)data);
+#ifdef MODULE_AT_ASYNC
+    if (dev->pid != KERNEL_PID_UNDEF) {
+        thread_flags_set((thread_t *)thread_get(dev->pid), AT_FLAG_RX);
+    }
+#endif
 }
 
 int at_dev_init(at_dev_t *dev, uart_t uart, uint32_t baudrate, char *buf, size_t bufsize)
 {
     dev->uart = uart;
+#ifdef MODULE_AT_ASYNC
+    dev->pid = KERNEL_PID_UNDEF;
+    dev->raw_owner = KERNEL_PID_UNDEF;
+    mutex_init(&dev->lock);
+    dev->queue.next = NULL;
+    dev->cur = NULL;
+    dev->line_len = 0;
+#endif
     isrpipe_init(&dev->isrpipe, buf, bufsize);
     uart_init(uart, 
               baudrate, 
               _isrpipe_write_one_wrapper, 
-              &dev->isrpipe);
+              dev);
 
     return 0;
 }
@@ -155,11 +187,45 @@ void at_drain(at_dev_t *dev)
     } while (res > 0);
 }
 
+#ifdef MODULE_AT_ASYNC
+static ssize_t _async_get_resp(at_dev_t *dev, const char *command,
+                               char *resp_buf, size_t len, uint32_t timeout)
+{
+    at_cmd_t cmd = { .cmd = command, .resp = resp_buf, .resp_len = len,
+                     .timeout = timeout };
+
+    int res = at_cmd_run(dev, &cmd);
+    if (res == -ETIMEDOUT) {
+        *resp_buf = '\0';
+        return res;
+    }
+    if (cmd.resp_pos == 0) {
+        /* no intermediate response, return the final result code */
+        strncpy(resp_buf, AT_RECV_OK, len - 1);
+        resp_buf[len - 1] = '\0';
+        return strlen(resp_buf);
+    }
+
+    /* the first line only */
+    char *eol = strchr(resp_buf, AT_RECV_EOL_2[0]);
+    if (eol) {
+        *eol = '\0';
+    }
+    return strlen(resp_buf);
+}
+#endif
+
 ssize_t at_send_cmd_get_resp(at_dev_t *dev, const char *command,
                              char *resp_buf, size_t len, uint32_t timeout)
 {
     ssize_t res;
 
+#ifdef MODULE_AT_ASYNC
+    if (_async(dev)) {
+        return _async_get_resp(dev, command, resp_buf, len, timeout);
+    }
+#endif
+
     at_drain(dev);
 
     res = at_send_cmd(dev, command, timeout);
@@ -187,6 +253,15 @@ ssize_t at_send_cmd_get_lines(at_dev_t *dev, const char *command,
     size_t bytes_left = len - 1;
     char *pos = resp_buf;
 
+#ifdef MODULE_AT_ASYNC
+    if (_async(dev)) {
+        at_cmd_t cmd = { .cmd = command, .resp = resp_buf, .resp_len = len,
+                         .timeout = timeout,
+                         .flags = keep_eol ? AT_CMD_F_KEEP_EOL : 0 };
+        return at_cmd_run(dev, &cmd);
+    }
+#endif
+
     at_drain(dev);
 
     res = at_send_cmd(dev, command, timeout);
@@ -277,6 +352,15 @@ int at_send_cmd_wait_ok(at_dev_t *dev, const char *command, uint32_t timeout)
     int res;
     char resp_buf[64];
 
+#ifdef MODULE_AT_ASYNC
+    if (_async(dev)) {
+        /* intermediate response lines are ignored */
+        at_cmd_t cmd = { .cmd = command, .timeout = timeout };
+        res = at_cmd_run(dev, &cmd);
+        return (res < 0) ? res : 0;
+    }
+#endif
+
     res = at_send_cmd_get_resp(dev, command, resp_buf, sizeof(resp_buf), timeout);
 
     if (res > 0) {
@@ -336,6 +420,19 @@ out:
 }
 
 #ifdef MODULE_AT_URC
+static clist_node_t *_urc_bucket(at_dev_t *dev, const char *code)
+{
+    unsigned hash = 0;
+
+    for (unsigned i = 0; i < AT_URC_HASH_LEN; i++) {
+        if (code[i] == '\0') {
+            return &dev->urc_list[AT_URC_HASH_SIZE];
+        }
+        hash = (hash * 31) + (uint8_t)code[i];
+    }
+    return &dev->urc_list[hash % AT_URC_HASH_SIZE];
+}
+
 void at_add_urc(at_dev_t *dev, at_urc_t *urc)
 {
     assert(urc);
@@ -343,27 +440,51 @@ void at_add_urc(at_dev_t *dev, at_urc_t *urc)
     assert(strlen(urc->code) != 0);
     assert(urc->cb);
 
-    clist_rpush(&dev->urc_list, &urc->list_node);
+#ifdef MODULE_AT_ASYNC
+    mutex_lock(&dev->lock);
+#endif
+    clist_rpush(_urc_bucket(dev, urc->code), &urc->list_node);
+#ifdef MODULE_AT_ASYNC
+    mutex_unlock(&dev->lock);
+#endif
 }
 
 void at_remove_urc(at_dev_t *dev, at_urc_t *urc)
 {
-    clist_remove(&dev->urc_list, &urc->list_node);
+#ifdef MODULE_AT_ASYNC
+    mutex_lock(&dev->lock);
+#endif
+    clist_remove(_urc_bucket(dev, urc->code), &urc->list_node);
+#ifdef MODULE_AT_ASYNC
+    mutex_unlock(&dev->lock);
+#endif
 }
 
-static int _check_urc(clist_node_t *node, void *arg)
+static int _match_urc(clist_node_t *node, void *arg)
 {
     const char *buf = arg;
     at_urc_t *urc = container_of(node, at_urc_t, list_node);
 
     DEBUG("Trying to match with %s\n", urc->code);
 
-    if (strncmp(buf, urc->code, strlen(urc->code)) == 0) {
-        urc->cb(urc->arg, buf);
-        return 1;
-    }
+    return (strncmp(buf, urc->code, strlen(urc->code)) == 0);
+}
 
-    return 0;
+/* finds the urc matching a line, a line shorter than the hashed prefix can
+ * only match a short urc */
+static at_urc_t *_find_urc(at_dev_t *dev, const char *buf)
+{
+    clist_node_t *node = NULL;
+    clist_node_t *bucket = _urc_bucket(dev, buf);
+
+    if (bucket != &dev->urc_list[AT_URC_HASH_SIZE]) {
+        node = clist_foreach(bucket, _match_urc, (void *)buf);
+    }
+    if (node == NULL) {
+        node = clist_foreach(&dev->urc_list[AT_URC_HASH_SIZE], _match_urc,
+                             (void *)buf);
+    }
+    return node ? container_of(node, at_urc_t, list_node) : NULL;
 }
 
 void at_process_urc(at_dev_t *dev, uint32_t timeout)
@@ -380,7 +501,283 @@ void at_process_urc(at_dev_t *dev, uint32_t timeout)
             return;
         }
     }
-    clist_foreach(&dev->urc_list, _check_urc, buf);
+    at_urc_t *urc = _find_urc(dev, buf);
+    if (urc) {
+        urc->cb(urc->arg, buf);
+    }
+}
+#endif
+
+#ifdef MODULE_AT_ASYNC
+typedef struct {
+    mutex_t done;
+    int res;
+} _run_t;
+
+static void _run_cb(void *arg, int res)
+{
+    _run_t *run = arg;
+
+    run->res = res;
+    mutex_unlock(&run->done);
+}
+
+static void _append(at_cmd_t *cmd, const char *line, size_t len)
+{
+    size_t keep_cr = ((cmd->flags & AT_CMD_F_KEEP_EOL) &&
+                      (sizeof(AT_RECV_EOL_1) > 1)) ? 1 : 0;
+
+    if (cmd->resp == NULL) {
+        return;
+    }
+    /* room for the end of line and the terminating zero */
+    size_t room = cmd->resp_len - cmd->resp_pos;
+    if (room < 2 + keep_cr) {
+        return;
+    }
+    if (len > room - 2 - keep_cr) {
+        DEBUG("at: response truncated\n");
+        len = room - 2 - keep_cr;
+    }
+    memcpy(&cmd->resp[cmd->resp_pos], line, len);
+    cmd->resp_pos += len;
+    if (keep_cr) {
+        cmd->resp[cmd->resp_pos++] = AT_RECV_EOL_1[0];
+    }
+    cmd->resp[cmd->resp_pos++] = AT_RECV_EOL_2[0];
+    cmd->resp[cmd->resp_pos] = '\0';
+}
+
+/* completes the current command, the callback runs without the lock held */
+static void _complete(at_dev_t *dev, int res)
+{
+    at_cmd_t *cmd = dev->cur;
+
+    DEBUG("at: \"%s\" completed: %d\n", cmd->cmd ? cmd->cmd : "", res);
+    dev->cur = NULL;
+    xtimer_remove(&dev->timer);
+    if (cmd->cb) {
+        mutex_unlock(&dev->lock);
+        cmd->cb(cmd->arg, res);
+        mutex_lock(&dev->lock);
+    }
+}
+
+/* "AT+CREG?" is answered with "+CREG: ...", such lines are no urc's */
+static bool _is_response(const at_cmd_t *cmd, const char *line)
+{
+    const char *name = cmd->cmd;
+
+    if (cmd->resp_prefix &&
+        (strncmp(line, cmd->resp_prefix, strlen(cmd->resp_prefix)) == 0)) {
+        return true;
+    }
+    if ((name == NULL) || (strncasecmp(name, "AT", 2) != 0)) {
+        return false;
+    }
+    name += 2;
+    size_t len = strcspn(name, "=?");
+    return (len > 1) && (strncmp(line, name, len) == 0) && (line[len] == ':');
+}
+
+static bool _is_error(const char *line)
+{
+    return ((sizeof(AT_RECV_ERROR) > 1) && (strcmp(line, AT_RECV_ERROR) == 0)) ||
+           (strncmp(line, "+CME ERROR:", 11) == 0) ||
+           (strncmp(line, "+CMS ERROR:", 11) == 0);
+}
+
+static void _dispatch(at_dev_t *dev, const char *line, size_t len)
+{
+    at_cmd_t *cmd = dev->cur;
+
+    if (len == 0) {
+        return;
+    }
+    if (AT_SEND_ECHO && cmd && cmd->cmd && !(cmd->flags & AT_CMD_F_NOSEND) &&
+        (strcmp(line, cmd->cmd) == 0)) {
+        return;
+    }
+    if (!(cmd && _is_response(cmd, line))) {
+        at_urc_t *urc = _find_urc(dev, line);
+        if (urc) {
+            mutex_unlock(&dev->lock);
+            urc->cb(urc->arg, line);
+            mutex_lock(&dev->lock);
+            return;
+        }
+    }
+    if (cmd == NULL) {
+        DEBUG("at: unhandled line \"%s\"\n", line);
+        return;
+    }
+
+    if (cmd->flags & AT_CMD_F_LINE) {
+        _append(cmd, line, len);
+        _complete(dev, cmd->resp_pos);
+    }
+    else if ((sizeof(AT_RECV_OK) > 1) && (strcmp(line, AT_RECV_OK) == 0)) {
+        _complete(dev, cmd->resp_pos);
+    }
+    else if (_is_error(line)) {
+        _append(cmd, line, len);
+        _complete(dev, -1);
+    }
+    else {
+        _append(cmd, line, len);
+    }
+}
+
+static void _parse(at_dev_t *dev, char c)
+{
+    if ((sizeof(AT_RECV_EOL_1) > 1) && (c == AT_RECV_EOL_1[0])) {
+        return;
+    }
+    if (c == AT_RECV_EOL_2[0]) {
+        dev->line[dev->line_len] = '\0';
+        size_t len = dev->line_len;
+        dev->line_len = 0;
+        _dispatch(dev, dev->line, len);
+    }
+    else if (dev->line_len < sizeof(dev->line) - 1) {
+        dev->line[dev->line_len++] = c;
+    }
+}
+
+/* sends queued commands until one waits for its response */
+static void _send_next(at_dev_t *dev)
+{
+    while ((dev->cur == NULL) && (dev->raw_owner == KERNEL_PID_UNDEF)) {
+        clist_node_t *node = clist_lpop(&dev->queue);
+        if (node == NULL) {
+            return;
+        }
+
+        at_cmd_t *cmd = container_of(node, at_cmd_t, list_node);
+        if ((cmd->cmd == NULL) && !(cmd->flags & AT_CMD_F_NOSEND)) {
+            /* barrier of at_acquire(): no input is parsed until release, the
+             * engine holds the device until the caller took it */
+            dev->raw_owner = dev->pid;
+            dev->line_len = 0;
+            mutex_unlock(&dev->lock);
+            cmd->cb(cmd->arg, 0);
+            mutex_lock(&dev->lock);
+            return;
+        }
+
+        dev->cur = cmd;
+        cmd->resp_pos = 0;
+        if (cmd->resp && cmd->resp_len) {
+            cmd->resp[0] = '\0';
+        }
+        if (!(cmd->flags & AT_CMD_F_NOSEND)) {
+            DEBUG("at: send \"%s\"\n", cmd->cmd);
+            uart_write(dev->uart, (const uint8_t *)cmd->cmd, strlen(cmd->cmd));
+            if (cmd->flags & AT_CMD_F_CRLF) {
+                uart_write(dev->uart, (const uint8_t *)"\r\n", 2);
+            }
+            else {
+                uart_write(dev->uart, (const uint8_t *)AT_SEND_EOL, AT_SEND_EOL_LEN);
+            }
+        }
+        thread_flags_clear(THREAD_FLAG_TIMEOUT);
+        dev->deadline = xtimer_now_usec() + cmd->timeout;
+        xtimer_set_timeout_flag(&dev->timer, cmd->timeout);
+    }
+}
+
+static void *_at_thread(void *arg)
+{
+    at_dev_t *dev = arg;
+
+    while (1) {
+        thread_flags_t flags = thread_flags_wait_any(AT_FLAG_RX | AT_FLAG_CMD |
+                                                     THREAD_FLAG_TIMEOUT);
+
+        mutex_lock(&dev->lock);
+        if (dev->raw_owner == KERNEL_PID_UNDEF) {
+            int c;
+            while ((c = tsrb_get_one(&dev->isrpipe.tsrb)) >= 0) {
+                if (AT_PRINT_INCOMING) {
+                    char ch = c;
+                    print(&ch, 1);
+                }
+                _parse(dev, (char)c);
+            }
+            if ((flags & THREAD_FLAG_TIMEOUT) && dev->cur &&
+                ((int32_t)(xtimer_now_usec() - dev->deadline) >= 0)) {
+                _complete(dev, -ETIMEDOUT);
+            }
+            _send_next(dev);
+        }
+        mutex_unlock(&dev->lock);
+    }
+
+    return NULL;
+}
+
+kernel_pid_t at_async_start(at_dev_t *dev)
+{
+    kernel_pid_t pid = thread_create(dev->stack, sizeof(dev->stack),
+                                     AT_ASYNC_PRIO, THREAD_CREATE_STACKTEST,
+                                     _at_thread, dev, "at");
+    if (pid > KERNEL_PID_UNDEF) {
+        dev->pid = pid;
+        /* parse what was received before */
+        thread_flags_set((thread_t *)thread_get(pid), AT_FLAG_RX);
+    }
+    return pid;
+}
+
+void at_cmd_submit(at_dev_t *dev, at_cmd_t *cmd)
+{
+    assert(dev->pid != KERNEL_PID_UNDEF);
+
+    mutex_lock(&dev->lock);
+    clist_rpush(&dev->queue, &cmd->list_node);
+    mutex_unlock(&dev->lock);
+    thread_flags_set((thread_t *)thread_get(dev->pid), AT_FLAG_CMD);
+}
+
+int at_cmd_run(at_dev_t *dev, at_cmd_t *cmd)
+{
+    _run_t run = { .done = MUTEX_INIT_LOCKED };
+
+    /* the engine would wait for itself, e.g. when called by a callback */
+    assert(thread_getpid() != dev->pid);
+
+    cmd->cb = _run_cb;
+    cmd->arg = &run;
+    at_cmd_submit(dev, cmd);
+    mutex_lock(&run.done);
+
+    return run.res;
+}
+
+void at_acquire(at_dev_t *dev)
+{
+    if ((dev->pid == KERNEL_PID_UNDEF) || (dev->raw_owner == thread_getpid())) {
+        return;
+    }
+
+    at_cmd_t barrier = { .cmd = NULL };
+    at_cmd_run(dev, &barrier);
+
+    mutex_lock(&dev->lock);
+    dev->raw_owner = thread_getpid();
+    mutex_unlock(&dev->lock);
+}
+
+void at_release(at_dev_t *dev)
+{
+    if (dev->pid == KERNEL_PID_UNDEF) {
+        return;
+    }
+
+    mutex_lock(&dev->lock);
+    dev->raw_owner = KERNEL_PID_UNDEF;
+    mutex_unlock(&dev->lock);
+    thread_flags_set((thread_t *)thread_get(dev->pid), AT_FLAG_RX | AT_FLAG_CMD);
 }
 #endif
 
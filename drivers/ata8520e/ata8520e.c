@@ -363,7 +363,7 @@ static bool _wait_event(ata8520e_t *dev, uint8_t timeout)
 {
     dev->event_received = 0;
     xtimer_ticks64_t start_time = xtimer_now64();
-    xtimer_t event_timer;
+    xtimer_t event_timer = { 0 };
     event_timer.callback = isr_event_timeout;
     event_timer.arg = dev;
     xtimer_set(&event_timer, (uint32_t)timeout * US_PER_SEC);
@@ -22,6 +22,22 @@
  *
  * As a debugging aid, when compiled with "-DAT_PRINT_INCOMING=1", every input
  * byte gets printed.
+ *
+ * With the module `at_async`, at_async_start() starts an engine thread that
+ * parses all input lines as they arrive. Unsolicited result codes are matched
+ * through a hash of their first @ref AT_URC_HASH_LEN characters and dispatched
+ * immediately, without at_process_urc() being called. Commands are queued with
+ * at_cmd_submit(): the engine sends the next one as soon as the final result
+ * code of the previous one was received, and signals the completion through a
+ * callback. at_send_cmd_wait_ok(), at_send_cmd_get_resp() and
+ * at_send_cmd_get_lines() then use the queue as well. All other functions read
+ * the input directly and must be enclosed by at_acquire() and at_release().
+ *
+ * The URC and command callbacks run on the engine thread. They may queue
+ * commands with at_cmd_submit(), but must not call at_send_cmd_wait_ok(),
+ * at_send_cmd_get_resp(), at_send_cmd_get_lines(), at_cmd_run() or
+ * at_acquire(): these wait for the engine, which would deadlock. This is
+ * caught by an assertion.
  * @{
  *
  * @file
@@ -40,6 +56,11 @@
 #include "isrpipe.h"
 #include "periph/uart.h"
 #include "clist.h"
+#ifdef MODULE_AT_ASYNC
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -87,6 +108,9 @@ extern "C" {
 /**
  * @brief   Unsolicited result code callback
  *
+ * With `at_async`, called from the engine thread, which must not be blocked
+ * by waiting for a command.
+ *
  * @param[in]   arg     optional argument
  * @param[in]   code    urc string received from the device
  */
@@ -102,8 +126,83 @@ typedef struct {
     void *arg;              /**< optional argument */
 } at_urc_t;
 
+#ifndef AT_URC_HASH_SIZE
+/** Number of hash buckets of the registered URCs */
+#define AT_URC_HASH_SIZE    (8U)
+#endif
+
+#ifndef AT_URC_HASH_LEN
+/**
+ * @brief   Number of leading characters of a URC that are hashed
+ *
+ * Shorter URCs are compared with every received line.
+ */
+#define AT_URC_HASH_LEN     (3U)
+#endif
+
 #endif /* MODULE_AT_URC */
 
+#if defined(MODULE_AT_ASYNC) || defined(DOXYGEN)
+#ifndef AT_ASYNC_STACKSIZE
+/** Stack size of the engine thread */
+#define AT_ASYNC_STACKSIZE  (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+#ifndef AT_ASYNC_PRIO
+/** Priority of the engine thread */
+#define AT_ASYNC_PRIO       (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/**
+ * @name    Command flags
+ * @{
+ */
+#define AT_CMD_F_LINE       (0x01)  /**< the first response line completes the
+                                     *   command, for devices without final
+                                     *   result codes */
+#define AT_CMD_F_NOSEND     (0x02)  /**< the command was written by the caller
+                                     *   between at_acquire() and at_release(),
+                                     *   only the response is parsed */
+#define AT_CMD_F_CRLF       (0x04)  /**< terminate the command with CR LF
+                                     *   instead of @ref AT_SEND_EOL */
+#define AT_CMD_F_KEEP_EOL   (0x08)  /**< keep the CR character of the response
+                                     *   lines */
+/** @} */
+
+/**
+ * @brief   Command completion callback
+ *
+ * Called from the engine thread, so it must not wait for the completion of
+ * another command.
+ *
+ * @param[in]   arg     optional argument
+ * @param[in]   res     length of the response on success, -1 if the device
+ *                      answered with an error, -ETIMEDOUT on timeout
+ */
+typedef void (*at_cmd_cb_t)(void *arg, int res);
+
+/**
+ * @brief   Queued AT command
+ *
+ * Commands are allocated by the caller and must stay valid until they
+ * completed.
+ */
+typedef struct {
+    clist_node_t list_node; /**< queue entry */
+    const char *cmd;        /**< command to send, without end of line */
+    const char *resp_prefix; /**< lines starting with this prefix are responses
+                              *   even if they match a URC, may be NULL */
+    char *resp;             /**< buffer for the response lines, each line
+                             *   followed by LF, may be NULL */
+    size_t resp_len;        /**< size of @p resp */
+    size_t resp_pos;        /**< length of the received response */
+    uint32_t timeout;       /**< response timeout (in usec) */
+    at_cmd_cb_t cb;         /**< completion callback, may be NULL */
+    void *arg;              /**< argument of @p cb */
+    uint8_t flags;          /**< command flags */
+} at_cmd_t;
+#endif /* MODULE_AT_ASYNC */
+
 /**
  * @brief AT device structure
  */
@@ -111,7 +210,21 @@ typedef struct {
     isrpipe_t isrpipe;      /**< isrpipe used for getting data from uart */
     uart_t uart;            /**< UART device where the AT device is attached */
 #ifdef MODULE_AT_URC
-    clist_node_t urc_list;  /**< list to keep track of all registered urc's */
+    /** registered urc's, hashed by their first characters, the last list
+     *  holds the ones too short for hashing */
+    clist_node_t urc_list[AT_URC_HASH_SIZE + 1];
+#endif
+#ifdef MODULE_AT_ASYNC
+    kernel_pid_t pid;       /**< engine thread, KERNEL_PID_UNDEF if not started */
+    kernel_pid_t raw_owner; /**< thread between at_acquire() and at_release() */
+    mutex_t lock;           /**< protects the queue and the urc lists */
+    clist_node_t queue;     /**< commands not sent yet */
+    at_cmd_t *cur;          /**< command waiting for its response */
+    xtimer_t timer;         /**< response timeout of @p cur */
+    uint32_t deadline;      /**< time at which @p cur times out */
+    size_t line_len;        /**< length of the line being received */
+    char line[AT_BUF_SIZE]; /**< line being received */
+    char stack[AT_ASYNC_STACKSIZE]; /**< stack of the engine thread */
 #endif
 } at_dev_t;
 
@@ -308,6 +421,61 @@ void at_remove_urc(at_dev_t *dev, at_urc_t *urc);
 void at_process_urc(at_dev_t *dev, uint32_t timeout);
 #endif
 
+#if defined(MODULE_AT_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Start the engine thread of a device
+ *
+ * @param[in]   dev     device to operate on, initialized by at_dev_init()
+ *
+ * @returns     PID of the engine thread on success
+ * @returns     <0 otherwise
+ */
+kernel_pid_t at_async_start(at_dev_t *dev);
+
+/**
+ * @brief   Queue a command
+ *
+ * The command is sent after all commands queued before completed.
+ *
+ * @param[in]   dev     device to operate on
+ * @param[in]   cmd     command to queue
+ */
+void at_cmd_submit(at_dev_t *dev, at_cmd_t *cmd);
+
+/**
+ * @brief   Queue a command and wait for its completion
+ *
+ * Must not be called from the engine thread, i.e. from a callback.
+ *
+ * @param[in]   dev     device to operate on
+ * @param[in]   cmd     command to run, its callback is overwritten
+ *
+ * @returns     length of the response on success
+ * @returns     -1 if the device answered with an error
+ * @returns     -ETIMEDOUT on timeout
+ */
+int at_cmd_run(at_dev_t *dev, at_cmd_t *cmd);
+
+/**
+ * @brief   Get exclusive access to the device input and output
+ *
+ * Waits until all commands queued before completed. Until at_release() is
+ * called, the engine does not parse any input, so the raw functions of this
+ * module can be used by the calling thread. Does nothing if the calling
+ * thread has the access already. Must not be called from the engine thread.
+ *
+ * @param[in]   dev     device to operate on
+ */
+void at_acquire(at_dev_t *dev);
+
+/**
+ * @brief   Give the device input and output back to the engine
+ *
+ * @param[in]   dev     device to operate on
+ */
+void at_release(at_dev_t *dev);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,6 +19,9 @@
 #define LM75_H_
 
 #include "periph/i2c.h"
+#ifdef MODULE_PERIPH_I2C_ASYNC
+#include "periph/i2c_async.h"
+#endif
 
 #include <stdlib.h>
 
@@ -82,6 +85,27 @@ int lm75_init(lm75_t *dev);
  */
 int lm75_get_ambient_temperature(lm75_t *dev);
 
+/**
+ * @brief Converts the raw temperature register to millicelsius
+ *
+ * @param[in] raw temperature register in bus order
+ */
+int lm75_raw_temperature(const uint8_t *raw);
+
+#ifdef MODULE_PERIPH_I2C_ASYNC
+/**
+ * @brief Prepares a transaction reading the temperature register
+ *
+ * The transaction can be batched with other ones on the same bus with
+ * i2c_async_submit(), its data is converted with lm75_raw_temperature().
+ *
+ * @param[in] dev pointer to the initialized LM75 device
+ * @param[out] xfer transaction to prepare
+ * @param[out] raw buffer of 2 bytes for the temperature register
+ */
+void lm75_async_read(const lm75_t *dev, i2c_async_xfer_t *xfer, uint8_t *raw);
+#endif
+
 int lm75_get_shutdown_temp(lm75_t *dev);
 void lm75_set_shutdown_temp(lm75_t *dev, int8_t temp);
 int lm75_get_hysteresis_temp(lm75_t *dev);
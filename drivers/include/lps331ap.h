@@ -32,6 +32,9 @@ extern "C" {
 
 #include <stdint.h>
 #include "periph/i2c.h"
+#ifdef MODULE_PERIPH_I2C_ASYNC
+#include "periph/i2c_async.h"
+#endif
 
  /**
   * @brief   The sensors default I2C address
@@ -93,6 +96,45 @@ int lps331ap_read_temp(const lps331ap_t *dev);
  */
 int lps331ap_read_pres(const lps331ap_t *dev);
 
+#if defined(MODULE_PERIPH_I2C_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Length of the raw data read by lps331ap_async_read()
+ */
+#define LPS331AP_RAW_LEN    (5U)
+
+/**
+ * @brief   Prepare a transaction reading pressure and temperature in one burst
+ *
+ * The transaction can be batched with other ones on the same bus with
+ * i2c_async_submit(), its data is converted with lps331ap_raw_temp() and
+ * lps331ap_raw_pres().
+ *
+ * @param[in]  dev      device descriptor of sensor to read from
+ * @param[out] xfer     transaction to prepare
+ * @param[out] raw      buffer of @ref LPS331AP_RAW_LEN bytes
+ */
+void lps331ap_async_read(const lps331ap_t *dev, i2c_async_xfer_t *xfer,
+                         uint8_t *raw);
+
+/**
+ * @brief   Convert raw data read by lps331ap_async_read() to m°C
+ *
+ * @param[in] raw       raw data
+ *
+ * @return              temperature value in m°C
+ */
+int lps331ap_raw_temp(const uint8_t *raw);
+
+/**
+ * @brief   Convert raw data read by lps331ap_async_read() to mbar
+ *
+ * @param[in] raw       raw data
+ *
+ * @return              pressure value in mbar
+ */
+int lps331ap_raw_pres(const uint8_t *raw);
+#endif
+
 /**
  * @brief   Enable the given sensor
  *
@@ -146,6 +146,18 @@ struct mtd_desc {
      * @return < 0 value on error
      */
     int (*power)(mtd_dev_t *dev, enum mtd_power_state power);
+
+    /**
+     * @brief   Write back data buffered by the Memory Technology Device (MTD)
+     *
+     * Only needed by devices that defer writes, may be NULL otherwise.
+     *
+     * @param[in] dev       Pointer to the selected driver
+     *
+     * @return 0 on success
+     * @return < 0 value on error
+     */
+    int (*flush)(mtd_dev_t *dev);
 };
 
 /**
@@ -229,6 +241,21 @@ int mtd_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t count);
  */
 int mtd_power(mtd_dev_t *mtd, enum mtd_power_state power);
 
+/**
+ * @brief   mtd_flush Write back buffered data of a MTD device
+ *
+ * Data written with mtd_write() is persistent once this function returned
+ * successfully. For devices that do not defer writes this does nothing.
+ *
+ * @param      mtd   the device to flush
+ *
+ * @return 0 if all buffered data was written
+ * @return < 0 if an error occured
+ * @return -ENODEV if @p mtd is not a valid device
+ * @return -EIO if I/O error occured
+ */
+int mtd_flush(mtd_dev_t *mtd);
+
 #if defined(MODULE_VFS) || defined(DOXYGEN)
 /**
  * @brief   MTD driver for VFS
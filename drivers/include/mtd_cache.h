@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_cache mtd page cache
+ * @ingroup     drivers_storage
+ * @brief       Write-back page cache stacked on top of another mtd device
+ *
+ * The cache keeps the @ref MTD_CACHE_PAGES most recently used pages of the
+ * underlying device in RAM. Reads of cached pages are served without accessing
+ * the device, writes only modify the cached page. Modified pages are programmed
+ * to the device when they are evicted, on mtd_flush() and before the device is
+ * powered down. All writes to a page in between are merged into one program
+ * operation of the modified range.
+ *
+ * The cache assumes that programmed ranges were erased before, as file
+ * systems on flash devices do: a page written back programs the cached data,
+ * clearing bits of programmed bytes again is not emulated.
+ *
+ * Usage:
+ *
+ * @code
+ * static uint8_t cache_buf[MTD_CACHE_PAGES * MTD_PAGE_SIZE];
+ * static mtd_cache_t cache;
+ *
+ * mtd_cache_setup(&cache, MTD_0, cache_buf);
+ * mtd_init(&cache.base);
+ * @endcode
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for the mtd_cache driver
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef MTD_CACHE_H
+#define MTD_CACHE_H
+
+#include <stdint.h>
+
+#include "mtd.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief   Number of pages held by a cache
+ */
+#ifndef MTD_CACHE_PAGES
+#define MTD_CACHE_PAGES (4U)
+#endif
+
+/**
+ * @brief   Cached page
+ */
+typedef struct {
+    uint32_t page;          /**< page number on the device, UINT32_MAX if unused */
+    uint32_t last_use;      /**< use counter value of the last access */
+    uint32_t dirty_start;   /**< first modified byte of the page */
+    uint32_t dirty_end;     /**< end of the modified range, 0 if unmodified */
+} mtd_cache_page_t;
+
+/**
+ * @brief   Cache statistics
+ */
+typedef struct {
+    uint32_t hits;          /**< page accesses served from the cache */
+    uint32_t misses;        /**< page accesses that read the device */
+    uint32_t writebacks;    /**< program operations issued to the device */
+} mtd_cache_stats_t;
+
+/**
+ * @brief   Device descriptor for mtd_cache device
+ *
+ * This is an extension of the @c mtd_dev_t struct
+ */
+typedef struct {
+    mtd_dev_t base;                             /**< inherit from mtd_dev_t object */
+    mtd_dev_t *dev;                             /**< cached device */
+    uint8_t *buf;                               /**< page buffers, @ref MTD_CACHE_PAGES
+                                                 *   times the page size of @p dev */
+    mutex_t lock;                               /**< protects the cache */
+    uint32_t use_ctr;                           /**< access counter for LRU eviction */
+    mtd_cache_page_t pages[MTD_CACHE_PAGES];    /**< cached pages */
+    mtd_cache_stats_t stats;                    /**< cache statistics */
+} mtd_cache_t;
+
+/**
+ * @brief   mtd_cache device operations table for mtd
+ */
+extern const mtd_desc_t mtd_cache_driver;
+
+/**
+ * @brief   Set up a cache for a device
+ *
+ * The cache starts empty. mtd_init() on the cache initializes @p dev and
+ * copies its geometry, pages modified before are written back.
+ *
+ * @param[out] cache    cache descriptor
+ * @param[in]  dev      device to cache
+ * @param[in]  buf      buffer of @ref MTD_CACHE_PAGES times the page size of
+ *                      @p dev
+ */
+void mtd_cache_setup(mtd_cache_t *cache, mtd_dev_t *dev, uint8_t *buf);
+
+/**
+ * @brief   Reset the statistics of a cache
+ *
+ * @param[in] cache     cache descriptor
+ */
+void mtd_cache_stats_reset(mtd_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_CACHE_H */
+/** @} */
@@ -49,6 +49,8 @@ typedef struct {
  *          write to the card without erasing the sector first.
  *          Attention: an erase call will therefore NOT touch the content,
  *                     so disable this feature to ensure overriding the data.
+ *                     Erase calls are then passed to the card, which lets
+ *                     discarded blocks be written faster afterwards.
  */
 #ifndef MTD_SDCARD_SKIP_ERASE
 #define MTD_SDCARD_SKIP_ERASE (1)
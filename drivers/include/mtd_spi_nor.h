@@ -12,6 +12,23 @@
  * @ingroup     drivers_storage
  * @brief       Driver for serial NOR flash memory technology devices attached via SPI
  *
+ * Erasing a sector takes tens to hundreds of milliseconds. With the module
+ * `mtd_spi_nor_async`, erases can be started in the background with
+ * mtd_spi_nor_erase_async(). The status of the chip is then polled by a timer
+ * and the following erase commands are issued by a thread of the driver, so
+ * neither the calling thread nor the SPI bus are blocked meanwhile. Its stack
+ * size and priority are set by `MTD_SPI_NOR_ASYNC_STACKSIZE` and
+ * `MTD_SPI_NOR_ASYNC_PRIO`.
+ *
+ * Regular mtd operations wait until the erase command in progress completed.
+ * Reads do not wait on chips having the @ref SPI_NOR_F_SUSPEND flag set:
+ * the erase is suspended for the duration of the read and resumed afterwards.
+ *
+ * Free sectors can also be queued for erasing with mtd_spi_nor_pre_erase().
+ * They are erased in the background when the device is idle, a later
+ * mtd_erase() of such a sector returns immediately. The littlefs package does
+ * this for the next free block its allocator will hand out.
+ *
  * @{
  *
  * @file
@@ -24,12 +41,21 @@
 #ifndef MTD_SPI_NOR_H
 #define MTD_SPI_NOR_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "periph_conf.h"
 #include "periph/spi.h"
 #include "periph/gpio.h"
 #include "mtd.h"
+#ifdef MODULE_PERIPH_SPI_ASYNC
+#include "periph/spi_async.h"
+#endif
+#ifdef MODULE_MTD_SPI_NOR_ASYNC
+#include "event/callback.h"
+#include "mutex.h"
+#include "xtimer.h"
+#endif
 
 #ifdef __cplusplus
 extern "C"
@@ -53,6 +79,8 @@ typedef struct {
     uint8_t chip_erase;      /**< Chip erase */
     uint8_t sleep;           /**< Deep power down */
     uint8_t wake;            /**< Release from deep power down */
+    uint8_t suspend;         /**< Program/erase suspend */
+    uint8_t resume;          /**< Program/erase resume */
     /* TODO: enter 4 byte address mode for large memories */
 } mtd_spi_nor_opcode_t;
 
@@ -82,6 +110,39 @@ typedef struct __attribute__((packed)) {
  * @brief   Flag to set when the device support 32KiB block erase (block_erase_32k opcode)
  */
 #define SPI_NOR_F_SECT_32K  (2)
+/**
+ * @brief   Flag to set when the device supports erase suspend and resume
+ *          (suspend and resume opcodes)
+ */
+#define SPI_NOR_F_SUSPEND   (4)
+
+/**
+ * @brief   Number of sectors that can be queued with mtd_spi_nor_pre_erase()
+ */
+#ifndef MTD_SPI_NOR_PRE_ERASE_NUMOF
+#define MTD_SPI_NOR_PRE_ERASE_NUMOF (4U)
+#endif
+
+/**
+ * @brief   Completion callback of mtd_spi_nor_erase_async() and
+ *          mtd_spi_nor_read_async()
+ *
+ * Called from the erase thread of the driver for erases, and in interrupt
+ * context for reads. The callback must not access the device, the erase
+ * thread is needed to complete its operations.
+ *
+ * @param[in] arg   argument given to mtd_spi_nor_erase_async()
+ */
+typedef void (*mtd_spi_nor_cb_t)(void *arg);
+
+/**
+ * @brief   Entry of the background pre-erase queue
+ */
+typedef struct {
+    uint32_t sector;         /**< sector number */
+    uint8_t state;           /**< unused, queued or erased */
+    uint8_t age;             /**< pre-erases completed since this one */
+} mtd_spi_nor_pre_erase_t;
 
 /**
  * @brief   Device descriptor for serial flash memory devices
@@ -122,6 +183,43 @@ typedef struct {
      * Computed by mtd_spi_nor_init, no need to touch outside the driver.
      */
     uint8_t sec_addr_shift;
+#if defined(MODULE_MTD_SPI_NOR_ASYNC) || defined(DOXYGEN)
+    /**
+     * @name    Background erase state
+     *
+     * Set up by mtd_spi_nor_init, no need to touch outside the driver.
+     * @{
+     */
+    mutex_t lock;            /**< serializes the accesses to the chip */
+    xtimer_t timer;          /**< status polling timer */
+    event_callback_t event;  /**< polls the status in the erase thread */
+    mtd_spi_nor_cb_t cb;     /**< completion callback of the async erase */
+    void *cb_arg;            /**< argument of @p cb */
+    uint32_t erase_addr;     /**< next address of the async erase */
+    uint32_t erase_left;     /**< bytes of the async erase not issued yet */
+    bool erase_req;          /**< an async erase is requested */
+    uint8_t busy;            /**< erase command in progress */
+    uint8_t pre_erase_cur;   /**< queue entry being erased */
+    uint32_t resume_time;    /**< time of the last erase resume command */
+    uint8_t waiters;         /**< threads waiting for the chip */
+    /** pre-erase queue */
+    mtd_spi_nor_pre_erase_t pre_erase[MTD_SPI_NOR_PRE_ERASE_NUMOF];
+    /** @} */
+#endif
+#if defined(MODULE_PERIPH_SPI_ASYNC) || defined(DOXYGEN)
+    /**
+     * @name    Queued read state
+     *
+     * Used by mtd_spi_nor_read_async(), no need to touch outside the driver.
+     * @{
+     */
+    spi_async_xfer_t read_xfer[2]; /**< command and data transfers */
+    uint8_t read_cmd[5];     /**< opcode and address of the read */
+    mtd_spi_nor_cb_t read_cb; /**< completion callback of the read */
+    void *read_cb_arg;       /**< argument of @p read_cb */
+    volatile bool read_busy; /**< a queued read is in progress */
+    /** @} */
+#endif
 } mtd_spi_nor_t;
 
 /**
@@ -147,6 +245,73 @@ extern const mtd_spi_nor_opcode_t mtd_spi_nor_opcode_default;
  */
 extern const mtd_spi_nor_opcode_t mtd_spi_nor_opcode_default_4bytes;
 
+#if defined(MODULE_MTD_SPI_NOR_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Start erasing a range in the background
+ *
+ * Returns after the first erase command was issued. The remaining commands are
+ * issued as the chip becomes ready, @p cb is called when the whole range is
+ * erased. The device must have been initialized with mtd_init().
+ *
+ * @param[in] dev       device descriptor
+ * @param[in] addr      start address, aligned to a sector
+ * @param[in] size      number of bytes, a multiple of the sector size
+ * @param[in] cb        completion callback, may be NULL
+ * @param[in] arg       argument passed to @p cb
+ *
+ * @return  0 on success
+ * @return  -EOVERFLOW if the range is empty, not aligned or out of bounds
+ * @return  -EBUSY if an async erase is already in progress
+ */
+int mtd_spi_nor_erase_async(mtd_spi_nor_t *dev, uint32_t addr, uint32_t size,
+                            mtd_spi_nor_cb_t cb, void *arg);
+
+/**
+ * @brief   Queue a free sector for erasing in the background
+ *
+ * Queued sectors are erased one after the other when no other operation uses
+ * the chip. mtd_erase() of a sector that was pre-erased and not written since
+ * returns immediately. When the queue is full, the entry of the sector
+ * that was erased first is reused.
+ *
+ * @param[in] dev       device descriptor
+ * @param[in] addr      address of the sector
+ *
+ * @return  0 on success, or if the sector is already queued
+ * @return  -EOVERFLOW if @p addr is not aligned or out of bounds
+ * @return  -ENOMEM if all entries are queued and not erased yet
+ */
+int mtd_spi_nor_pre_erase(mtd_spi_nor_t *dev, uint32_t addr);
+#endif
+
+#if defined(MODULE_PERIPH_SPI_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Queue a read on the SPI bus and return
+ *
+ * The command and the data are moved by the SPI queue of the bus, see
+ * @ref drivers_periph_spi_async, while the caller continues. @p cb is called
+ * once @p dest is filled, in interrupt context if the bus uses DMA. Unlike
+ * mtd_read(), the read may cross page boundaries. Only one queued read per
+ * device may be in progress. With `mtd_spi_nor_async`, the read is refused
+ * while a background erase command is in progress, it does not suspend the
+ * erase, and no erase command is issued until the read is done.
+ *
+ * @param[in]  dev      device descriptor, initialized with mtd_init()
+ * @param[out] dest     buffer to read into, must stay valid until @p cb
+ * @param[in]  addr     start address
+ * @param[in]  size     number of bytes to read
+ * @param[in]  cb       completion callback, may be NULL
+ * @param[in]  arg      argument passed to @p cb
+ *
+ * @return  0 on success
+ * @return  -EOVERFLOW if the range is empty or out of bounds
+ * @return  -EBUSY if a queued read or an erase command is in progress
+ * @return  -EAGAIN if called from interrupt context while the bus is idle
+ */
+int mtd_spi_nor_read_async(mtd_spi_nor_t *dev, void *dest, uint32_t addr,
+                           uint32_t size, mtd_spi_nor_cb_t cb, void *arg);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -44,6 +44,7 @@
 #define PERIPH_ADC_H
 
 #include <limits.h>
+#include <stdbool.h>
 
 #include "periph_cpu.h"
 #include "periph_conf.h"
@@ -156,6 +157,43 @@ typedef void (*adc_cb_t)(adc_dma_event_t event);
  */
 int adc_sampling_start(adc_t line, adc_res_t res, uint16_t *buf, uint16_t wsize, adc_cb_t adc_cb, adc_conconv_mode_t mode);
 
+/**
+ * @brief   Starts continuous sampling of several lines
+ *
+ * The lines in @p lines are converted as one scan sequence, in ascending
+ * line order, and the samples of each scan are stored one after the other in
+ * the circular buffer @p buf. @p adc_cb is called from the DMA interrupt with
+ * ADC_DMA_CALLBACK_HALF when the first half of @p buf is filled and with
+ * ADC_DMA_CALLBACK_COMPLETED for the second half, so each half can be
+ * processed while the other is being filled. The lines must be initialized
+ * with adc_init() before.
+ *
+ * With @p triggered set, each scan is started by the external trigger of the
+ * first line, which must be running. Otherwise the scans run back to back,
+ * paced by the sampling time and oversampling. Sampling is stopped with
+ * adc_sampling_stop(). The ADC is locked until then, so adc_sample() blocks.
+ *
+ * @note    Hardware oversampling is only available on STM32 L0. The
+ *          oversampled results are averaged, i.e. keep the resolution given
+ *          in @p res. On STM32 L0, the lines must be configured in ascending
+ *          channel order.
+ *
+ * @param[in] lines         bit mask of the lines to sample
+ * @param[in] res           resolution to use for conversion
+ * @param[in] oversampling  log2 of the oversampling ratio, 0 to disable
+ * @param[in] triggered     start scans on the external trigger
+ * @param[in] buf           pointer to buffer to store data
+ * @param[in] wsize         buffer size in 16-bit words, a multiple of two
+ *                          scans
+ * @param[in] adc_cb        callback function
+ *
+ * @return                  0 on success
+ * @return                  -1 if a parameter is not applicable
+ */
+int adc_scan_start(uint32_t lines, adc_res_t res, unsigned oversampling,
+                   bool triggered, uint16_t *buf, uint16_t wsize,
+                   adc_cb_t adc_cb);
+
 /**
  * @brief   Stops continuous sampling
  *
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_periph_async_queue Asynchronous bus queue
+ * @ingroup     drivers_periph
+ * @brief       Descriptor queue of the asynchronous bus interfaces
+ *
+ * Shared by @ref drivers_periph_spi_async and @ref drivers_periph_i2c_async.
+ * The descriptors of a bus embed an @ref async_queue_node_t and are queued
+ * per bus. The first submission to an idle queue acquires the bus, then the
+ * descriptors are started one after the other, and the bus is released when
+ * the queue ran empty. Submissions while the queue is active are appended,
+ * also from interrupt context, e.g. from a completion callback.
+ *
+ * The bus specific parts are given as @ref async_queue_ops_t. They get the
+ * queue, the bus interface finds the bus from its position in its array of
+ * queues.
+ *
+ * This module is pulled in by the asynchronous bus features.
+ *
+ * @{
+ * @file
+ * @brief       Asynchronous bus queue interface definition
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef PERIPH_ASYNC_QUEUE_H
+#define PERIPH_ASYNC_QUEUE_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Queue entry, embedded in the descriptors of a bus
+ */
+typedef struct async_queue_node {
+    struct async_queue_node *next;  /**< next queued descriptor */
+} async_queue_node_t;
+
+/**
+ * @brief   Queue of one bus
+ *
+ * Zero-initialized queues are empty.
+ */
+typedef struct {
+    async_queue_node_t *head;       /**< descriptor in progress */
+    async_queue_node_t *tail;       /**< last queued descriptor */
+    bool active;                    /**< the bus is held by the queue */
+} async_queue_t;
+
+/**
+ * @brief   Bus specific operations of a queue
+ */
+typedef struct {
+    /**
+     * @brief   Acquire the bus and prepare it for a run of descriptors
+     *
+     * Called in thread context, may block until the bus is free.
+     *
+     * @param[in] q     queue of the bus
+     * @param[in] first first descriptor of the run
+     */
+    void (*begin)(async_queue_t *q, async_queue_node_t *first);
+    /**
+     * @brief   Start a descriptor
+     *
+     * @param[in] q     queue of the bus
+     * @param[in] node  descriptor to start
+     *
+     * @return  0 if the descriptor is completed later, by
+     *          async_queue_isr_done()
+     * @return  1 if it was completed synchronously
+     */
+    int (*start)(async_queue_t *q, async_queue_node_t *node);
+    /**
+     * @brief   Notify the owner of a completed descriptor
+     *
+     * The descriptor was removed from the queue, so it may be reused and
+     * new descriptors may be submitted.
+     *
+     * @param[in] q     queue of the bus
+     * @param[in] node  completed descriptor
+     */
+    void (*done)(async_queue_t *q, async_queue_node_t *node);
+    /**
+     * @brief   Stop the bus and release it, the queue ran empty
+     *
+     * @param[in] q     queue of the bus
+     */
+    void (*end)(async_queue_t *q);
+} async_queue_ops_t;
+
+/**
+ * @brief   Queue linked descriptors
+ *
+ * The descriptors from @p first to @p last must be linked already, they are
+ * started back to back. If the queue is idle, the bus is acquired and the
+ * first descriptor is started before this function returns.
+ *
+ * @param[in] q         queue of the bus
+ * @param[in] ops       operations of the bus
+ * @param[in] first     first descriptor to queue
+ * @param[in] last      last descriptor to queue
+ *
+ * @return  0 on success
+ * @return  -EAGAIN if called from interrupt context while the queue is idle
+ */
+int async_queue_submit(async_queue_t *q, const async_queue_ops_t *ops,
+                       async_queue_node_t *first, async_queue_node_t *last);
+
+/**
+ * @brief   Check whether the queue holds the bus
+ *
+ * @param[in] q         queue of the bus
+ *
+ * @return  true, if descriptors are queued
+ */
+static inline bool async_queue_busy(const async_queue_t *q)
+{
+    return q->active;
+}
+
+/**
+ * @brief   Complete the descriptor in progress and start the next one
+ *
+ * To be called by the bus driver, usually in interrupt context, when a
+ * descriptor for which async_queue_ops_t::start returned 0 is done.
+ *
+ * @param[in] q         queue of the bus
+ * @param[in] ops       operations of the bus
+ */
+void async_queue_isr_done(async_queue_t *q, const async_queue_ops_t *ops);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIPH_ASYNC_QUEUE_H */
+/** @} */
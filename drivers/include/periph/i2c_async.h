@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_periph_i2c_async I2C asynchronous transactions
+ * @ingroup     drivers_periph_i2c
+ * @brief       Queued, non-blocking I2C register transactions with completion
+ *              callbacks
+ *
+ * A transaction is described by an @ref i2c_async_xfer_t: the register
+ * address is written to the device, followed by a repeated start and a read,
+ * or directly by the data to write. Transactions are appended to a queue per
+ * bus with i2c_async_submit(), the ones of one submission run back to back,
+ * even when they address different devices. This way the registers of all
+ * sensors on a bus are read as one batch, while the submitter continues or
+ * sleeps.
+ *
+ * A failing transaction does not stop the batch, its result is reported in
+ * i2c_async_xfer_t::res.
+ *
+ * While the queue is not empty it holds the bus as if i2c_acquire() was
+ * called, so synchronous users of the same bus wait until it is drained, and
+ * vice versa. On STM32 the transactions are driven by the I2C interrupts,
+ * where the board configures both the event and the error interrupt, other
+ * buses fall back to polled transfers.
+ *
+ * This module is enabled with the `periph_i2c_async` feature.
+ *
+ * @{
+ * @file
+ * @brief       Asynchronous I2C transaction interface definition
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef PERIPH_I2C_ASYNC_H
+#define PERIPH_I2C_ASYNC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "periph/async_queue.h"
+#include "periph/i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Transaction without register address, the data is read or
+ *          written directly
+ */
+#define I2C_ASYNC_NOREG     (0x80)
+
+/**
+ * @brief   Forward declaration of the transaction descriptor
+ */
+typedef struct i2c_async_xfer i2c_async_xfer_t;
+
+/**
+ * @brief   Transaction complete callback
+ *
+ * Called in interrupt context, unless the transaction completed
+ * synchronously. The callback may submit new transactions.
+ *
+ * @param[in] xfer  the completed transaction
+ * @param[in] arg   argument given in the descriptor
+ */
+typedef void (*i2c_async_cb_t)(i2c_async_xfer_t *xfer, void *arg);
+
+/**
+ * @brief   I2C transaction descriptor
+ *
+ * The descriptor must stay valid until its transaction is completed.
+ */
+struct i2c_async_xfer {
+    async_queue_node_t node;    /**< queue entry, set internally */
+    uint16_t addr;              /**< 7-bit device address */
+    uint16_t reg;               /**< register address */
+    uint8_t flags;              /**< @ref I2C_REG16 and @ref I2C_ASYNC_NOREG */
+    bool read;                  /**< read into @p data, write it otherwise */
+    void *data;                 /**< data buffer */
+    size_t len;                 /**< number of data bytes, less than 255 */
+    int res;                    /**< 0 on success, a negative errno value as
+                                 *   returned by i2c_read_regs() otherwise,
+                                 *   set before @p cb is called */
+    i2c_async_cb_t cb;          /**< completion callback, may be NULL */
+    void *arg;                  /**< argument passed to i2c_async_xfer_t::cb */
+};
+
+/**
+ * @brief   Queue transactions on the given bus
+ *
+ * The @p numof descriptors in @p xfer are queued as one request, in order.
+ *
+ * If the queue of @p dev is empty, this function blocks until the bus is
+ * acquired and the first transaction is started. When called from interrupt
+ * context, this only succeeds if the queue is not empty, e.g. from a
+ * completion callback.
+ *
+ * @pre     `(xfer != NULL) && (numof > 0)`
+ *
+ * @param[in] dev       I2C device to use
+ * @param[in] xfer      array of transaction descriptors
+ * @param[in] numof     number of descriptors in @p xfer
+ *
+ * @return  0 on success
+ * @return  -EAGAIN if called from interrupt context while the queue is empty
+ */
+int i2c_async_submit(i2c_t dev, i2c_async_xfer_t *xfer, unsigned numof);
+
+/**
+ * @brief   Queue transactions on the given bus and wait until they are done
+ *
+ * The callback of the last descriptor in @p xfer is overwritten.
+ *
+ * @pre     Must not be called from interrupt context, nor with @p dev
+ *          acquired by the caller.
+ *
+ * @param[in] dev       I2C device to use
+ * @param[in] xfer      array of transaction descriptors
+ * @param[in] numof     number of descriptors in @p xfer
+ *
+ * @return  0 if all transactions succeeded
+ * @return  the result of the first failed transaction otherwise
+ */
+int i2c_async_transfer(i2c_t dev, i2c_async_xfer_t *xfer, unsigned numof);
+
+/**
+ * @brief   Check whether transactions are queued on the given bus
+ *
+ * @param[in] dev       I2C device to check
+ *
+ * @return  true, if the queue of @p dev is not empty
+ */
+bool i2c_async_busy(i2c_t dev);
+
+/**
+ * @brief   Run a transaction with the blocking I2C functions
+ *
+ * Fallback for buses without interrupt driven transactions, sets
+ * i2c_async_xfer_t::res.
+ *
+ * @pre     @p dev is acquired
+ *
+ * @param[in] dev       I2C device to use
+ * @param[in] xfer      transaction to run
+ */
+void i2c_async_poll(i2c_t dev, i2c_async_xfer_t *xfer);
+
+/**
+ * @name    Low-level interface
+ *
+ * Implemented by the CPU, used by the queue in
+ * `drivers/periph_common/i2c_async.c`.
+ * @{
+ */
+
+/**
+ * @brief   Prepare the bus for a run of asynchronous transactions
+ *
+ * Called in thread context after the bus was acquired.
+ *
+ * @param[in] dev       I2C device to use
+ */
+void i2c_async_hw_begin(i2c_t dev);
+
+/**
+ * @brief   Start a transaction
+ *
+ * @param[in] dev       I2C device to use
+ * @param[in] xfer      transaction to start
+ *
+ * @return  0, if the transaction was started. i2c_async_isr_done() is called
+ *          once it is done.
+ * @return  1, if the transaction completed synchronously, its result is set.
+ */
+int i2c_async_hw_start(i2c_t dev, i2c_async_xfer_t *xfer);
+
+/**
+ * @brief   End a run of asynchronous transactions
+ *
+ * Called before the bus is released, possibly in interrupt context.
+ *
+ * @param[in] dev       I2C device to use
+ */
+void i2c_async_hw_end(i2c_t dev);
+
+/**
+ * @brief   Signal the end of a transaction started by i2c_async_hw_start()
+ *
+ * i2c_async_xfer_t::res must be set before.
+ *
+ * @param[in] dev       I2C device the transaction was done on
+ */
+void i2c_async_isr_done(i2c_t dev);
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIPH_I2C_ASYNC_H */
+/** @} */
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_periph_spi_async SPI asynchronous transfers
+ * @ingroup     drivers_periph_spi
+ * @brief       Queued, non-blocking SPI transfers with completion callbacks
+ *
+ * Transfers are described by @ref spi_async_xfer_t descriptors and appended
+ * to a queue per bus with spi_async_submit(). The descriptors of one
+ * submission are transferred back to back: a descriptor with `cont` set keeps
+ * the chip select asserted for the next one, so a command, its address and its
+ * payload can be sent as one request without another user of the bus getting
+ * in between. The submitter continues while the transfers run, and is
+ * notified by the callback of a descriptor once it is done.
+ *
+ * While the queue is not empty it holds the bus as if spi_acquire() was called,
+ * so synchronous users of the same bus wait until it is drained, and vice
+ * versa. On buses with DMA the transfers are chained from the DMA interrupt,
+ * other buses fall back to polled transfers.
+ *
+ * This module is enabled with the `periph_spi_async` feature.
+ *
+ * @{
+ * @file
+ * @brief       Asynchronous SPI transfer interface definition
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef PERIPH_SPI_ASYNC_H
+#define PERIPH_SPI_ASYNC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "periph/async_queue.h"
+#include "periph/spi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Forward declaration of the transfer descriptor
+ */
+typedef struct spi_async_xfer spi_async_xfer_t;
+
+/**
+ * @brief   Transfer complete callback
+ *
+ * Called in interrupt context, unless the transfer completed synchronously.
+ * The callback may submit new transfers.
+ *
+ * @param[in] xfer  the completed transfer
+ * @param[in] arg   argument given in the descriptor
+ */
+typedef void (*spi_async_cb_t)(spi_async_xfer_t *xfer, void *arg);
+
+/**
+ * @brief   SPI transfer descriptor
+ *
+ * The descriptor must stay valid until its transfer is completed.
+ */
+struct spi_async_xfer {
+    async_queue_node_t node;    /**< queue entry, set internally */
+    spi_cs_t cs;                /**< chip select pin/line to use */
+    spi_mode_t mode;            /**< mode to use for the transfer */
+    spi_clk_t clk;              /**< bus clock speed to use */
+    bool cont;                  /**< keep device selected for the next
+                                 *   descriptor of the same submission */
+    const void *out;            /**< buffer to send, NULL if only receiving */
+    void *in;                   /**< buffer to read into, NULL if only
+                                 *   sending */
+    size_t len;                 /**< number of bytes to transfer */
+    spi_async_cb_t cb;          /**< completion callback, may be NULL */
+    void *arg;                  /**< argument passed to spi_async_xfer_t::cb */
+};
+
+/**
+ * @brief   Queue transfers on the given bus
+ *
+ * The @p numof descriptors in @p xfer are queued as one request, in order.
+ * A descriptor with spi_async_xfer_t::cont set keeps the device selected for
+ * the next one, which then uses the same chip select, mode and clock. A
+ * descriptor without it ends the chip select cycle, so one request may hold
+ * several commands.
+ *
+ * If the queue of @p bus is empty, this function blocks until the bus is
+ * acquired and the first transfer is started. When called from interrupt
+ * context, this only succeeds if the queue is not empty, e.g. from a
+ * completion callback.
+ *
+ * @pre     `(xfer != NULL) && (numof > 0) && !xfer[numof - 1].cont`
+ *
+ * @param[in] bus       SPI device to use
+ * @param[in] xfer      array of transfer descriptors
+ * @param[in] numof     number of descriptors in @p xfer
+ *
+ * @return  0 on success
+ * @return  -EAGAIN if called from interrupt context while the queue is empty
+ */
+int spi_async_submit(spi_t bus, spi_async_xfer_t *xfer, unsigned numof);
+
+/**
+ * @brief   Queue transfers on the given bus and wait until they are done
+ *
+ * The callback of the last descriptor in @p xfer is overwritten.
+ *
+ * @pre     Must not be called from interrupt context.
+ *
+ * @param[in] bus       SPI device to use
+ * @param[in] xfer      array of transfer descriptors
+ * @param[in] numof     number of descriptors in @p xfer
+ */
+void spi_async_transfer(spi_t bus, spi_async_xfer_t *xfer, unsigned numof);
+
+/**
+ * @brief   Check whether transfers are queued on the given bus
+ *
+ * @param[in] bus       SPI device to check
+ *
+ * @return  true, if the queue of @p bus is not empty
+ */
+bool spi_async_busy(spi_t bus);
+
+/**
+ * @name    Low-level interface
+ *
+ * Implemented by the CPU, used by the queue in
+ * `drivers/periph_common/spi_async.c`.
+ * @{
+ */
+
+/**
+ * @brief   Prepare the bus for a run of asynchronous transfers
+ *
+ * Called in thread context after the bus was acquired.
+ *
+ * @param[in] bus       SPI device to use
+ */
+void spi_async_hw_begin(spi_t bus);
+
+/**
+ * @brief   Start a transfer
+ *
+ * If @p cs_active is false, the bus is configured for the mode and clock of
+ * @p xfer and its chip select is asserted. After the transfer the chip select
+ * is released if spi_async_xfer_t::cont is not set.
+ *
+ * @param[in] bus       SPI device to use
+ * @param[in] xfer      transfer to start
+ * @param[in] cs_active true, if the device is still selected by the previous
+ *                      transfer
+ *
+ * @return  0, if the transfer was started. spi_async_isr_done() is called
+ *          once it is done.
+ * @return  1, if the transfer completed synchronously.
+ */
+int spi_async_hw_start(spi_t bus, const spi_async_xfer_t *xfer, bool cs_active);
+
+/**
+ * @brief   End a run of asynchronous transfers
+ *
+ * Called before the bus is released, possibly in interrupt context.
+ *
+ * @param[in] bus       SPI device to use
+ */
+void spi_async_hw_end(spi_t bus);
+
+/**
+ * @brief   Signal the end of a transfer started by spi_async_hw_start()
+ *
+ * @param[in] bus       SPI device the transfer was done on
+ */
+void spi_async_isr_done(spi_t bus);
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIPH_SPI_ASYNC_H */
+/** @} */
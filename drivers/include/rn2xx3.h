@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 
+#include "at.h"
 #include "xtimer.h"
 #include "periph/uart.h"
 #include "periph/gpio.h"
@@ -46,6 +47,24 @@ extern "C" {
  */
 #define RN2XX3_RX_MAX_BUF               (250U)
 
+/**
+ * @brief   Size of the UART input buffer, must be a power of two
+ */
+#ifndef RN2XX3_UART_BUF_SIZE
+#define RN2XX3_UART_BUF_SIZE            (128U)
+#endif
+
+/**
+ * @brief   Number of asynchronous replies dispatched as URCs
+ */
+#define RN2XX3_URC_NUMOF                (5U)
+
+/**
+ * @brief   Number of second replies to mac tx that are only dispatched as URCs
+ *          while the reply is pending
+ */
+#define RN2XX3_TX_URC_NUMOF             (1U)
+
 /**
  * @brief   Maximum delay in second to receive a reply from server.
  */
@@ -145,6 +164,12 @@ typedef struct {
     rn2xx3_params_t p;                 /**< configuration parameters */
     loramac_settings_t loramac;        /**< loramac communication settings */
 
+    /* AT engine parsing the device output */
+    at_dev_t at_dev;                   /**< AT device of the UART */
+    char uart_buf[RN2XX3_UART_BUF_SIZE]; /**< UART input buffer */
+    at_urc_t urc[RN2XX3_URC_NUMOF];    /**< asynchronous replies */
+    at_urc_t tx_urc[RN2XX3_TX_URC_NUMOF]; /**< mac tx only replies */
+
     /* values for the UART TX state machine  */
     char cmd_buf[RN2XX3_MAX_BUF];      /**< command to send data buffer */
     mutex_t cmd_lock;                  /**< mutex to allow only one
@@ -155,15 +180,11 @@ typedef struct {
     mutex_t resp_lock;                 /**< mutex for waiting for command
                                         *   response */
     char resp_buf[RN2XX3_MAX_BUF];     /**< command response data buffer */
-    uint16_t resp_size;                /**< counter for received char in response */
     uint8_t resp_done;                 /**< check if response has completed */
 
     /* buffer for RX messages */
-    char rx_tmp_buf[2];                /**< Temporary RX buffer used to convert
-                                        *   2 hex characters in one byte on the
-                                        *   fly. */
     uint8_t rx_buf[RN2XX3_RX_MAX_BUF]; /**< RX data buffer */
-    uint16_t rx_size;                  /**< counter for received char in RX */
+    uint16_t rx_size;                  /**< number of bytes in RX */
 
     /* timers */
     xtimer_t sleep_timer;              /**< Timer used to count module sleep time */
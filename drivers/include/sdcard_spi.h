@@ -193,6 +193,7 @@ typedef struct {
     int csd_structure;              /**< version of the CSD register structure */
     cid_t cid;                      /**< CID register */
     csd_t csd;                      /**< CSD register */
+    uint8_t stream_cmd;             /**< command of the open block stream, 0 if none */
 } sdcard_spi_t;
 
 /**
@@ -255,6 +256,106 @@ int sdcard_spi_read_blocks(sdcard_spi_t *card, int blockaddr, uint8_t *data, int
 int sdcard_spi_write_blocks(sdcard_spi_t *card, int blockaddr, const uint8_t *data, int blocksize,
                             int nblocks, sd_rw_response_t *state);
 
+/**
+ * @brief                 Erases a contiguous range of blocks (CMD32, CMD33 and CMD38).
+ *
+ *                        Blocks that are erased before they are written are written
+ *                        faster. Depending on the card erased blocks read as all 0 or
+ *                        all 1 bits.
+ *
+ * @param[in] card        Initialized sd-card struct
+ * @param[in] blockaddr   First block to erase, given as block address
+ * @param[in] nblocks     Number of blocks to erase
+ * @param[out] state      Contains information about the error state if something went wrong
+ *
+ * @return                number of erased blocks (0 if the range was not erased).
+ */
+int sdcard_spi_erase_blocks(sdcard_spi_t *card, int blockaddr, int nblocks,
+                            sd_rw_response_t *state);
+
+/**
+ * @brief                 Starts a multi-block read (CMD18) that is continued block by block.
+ *
+ *                        The card stays selected and the SPI bus stays acquired until
+ *                        sdcard_spi_read_stream_stop() is called, so the caller can process
+ *                        each block before the next one is read without issuing a new read
+ *                        command per block.
+ *
+ * @param[in] card        Initialized sd-card struct without an open stream
+ * @param[in] blockaddr   First block to read, given as block address
+ *
+ * @return                SD_RW_OK if the stream was started
+ * @return                error state otherwise, no stream is open then
+ */
+sd_rw_response_t sdcard_spi_read_stream_start(sdcard_spi_t *card, int blockaddr);
+
+/**
+ * @brief                 Reads the next 512 byte block of a stream started with
+ *                        sdcard_spi_read_stream_start().
+ *
+ *                        If the block could not be read, the stream is stopped.
+ *
+ * @param[in] card        sd-card struct with an open read stream
+ * @param[out] data       Buffer of SD_HC_BLOCK_SIZE bytes to store the block in
+ *
+ * @return                SD_RW_OK if the block was read
+ * @return                error state otherwise
+ */
+sd_rw_response_t sdcard_spi_read_stream_block(sdcard_spi_t *card, uint8_t *data);
+
+/**
+ * @brief                 Stops a read stream (CMD12) and releases the card.
+ *
+ * @param[in] card        sd-card struct
+ *
+ * @return                SD_RW_OK if the stream was stopped or no read stream was open
+ * @return                error state otherwise
+ */
+sd_rw_response_t sdcard_spi_read_stream_stop(sdcard_spi_t *card);
+
+/**
+ * @brief                 Starts a multi-block write (CMD25) that is continued block by block.
+ *
+ *                        If @p nblocks is not 0, the card is told the number of blocks that
+ *                        are going to be written with ACMD23, so it can erase them in
+ *                        advance. More or fewer blocks may be written anyway.
+ *                        The card stays selected and the SPI bus stays acquired until
+ *                        sdcard_spi_write_stream_stop() is called.
+ *
+ * @param[in] card        Initialized sd-card struct without an open stream
+ * @param[in] blockaddr   First block to write, given as block address
+ * @param[in] nblocks     Expected number of blocks to write, 0 if unknown
+ *
+ * @return                SD_RW_OK if the stream was started
+ * @return                error state otherwise, no stream is open then
+ */
+sd_rw_response_t sdcard_spi_write_stream_start(sdcard_spi_t *card, int blockaddr, int nblocks);
+
+/**
+ * @brief                 Writes the next 512 byte block of a stream started with
+ *                        sdcard_spi_write_stream_start().
+ *
+ *                        If the block could not be written, the stream is stopped.
+ *
+ * @param[in] card        sd-card struct with an open write stream
+ * @param[in] data        Buffer of SD_HC_BLOCK_SIZE bytes to write
+ *
+ * @return                SD_RW_OK if the block was written
+ * @return                error state otherwise
+ */
+sd_rw_response_t sdcard_spi_write_stream_block(sdcard_spi_t *card, const uint8_t *data);
+
+/**
+ * @brief                 Stops a write stream, waits until the card finished programming and
+ *                        releases the card.
+ *
+ * @param[in] card        sd-card struct
+ *
+ * @return                SD_RW_OK if the stream was stopped or no write stream was open
+ * @return                error state otherwise
+ */
+sd_rw_response_t sdcard_spi_write_stream_stop(sdcard_spi_t *card);
+
 /**
  * @brief                 Gets the capacity of the card.
  *
@@ -38,6 +38,7 @@ extern "C" {
 #define SIMCOM_MAX_TIMEOUT         (1000000)   /**< Maximum time waiting for a response */ 
 #define SIMCOM_TIME_ON             (500)       /**< The time of active low level impulse of PWRKEY pin to power on module. Min: 50ms, typ: 100ms */
 #define SIMCOM_TIME_ON_UART        (3000)      /**< The time from power-on issue to UART port ready. Min: 3s, max: 5s */
+#define SIMCOM_PING_TIMEOUT        (10000000)  /**< Maximum time waiting for the first ping reply */
 
 #if !defined(RECEIVE_MAX_LEN)
     #define RECEIVE_MAX_LEN         (1460)      /**< Max requested number of data bytes (1-1460 bytes) to be read */
@@ -866,6 +867,24 @@ int simcom_init(simcom_dev_t *simcom_dev,
                  char          *at_dev_resp, 
                  uint16_t       at_dev_resp_size);
 
+#if defined(MODULE_SIMCOM_SOCK) || DOXYGEN
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief       Prepare SIMCOM device for the sock API
+ *
+ * @param[in]   simcom_dev         Device to operate on
+ *
+ * Switches the modem to pushed receive data and quick send mode and
+ * registers the connection URCs. Call after simcom_init() and before any
+ * connection is opened.
+ *
+ * @returns     SIMCOM_OK              - OK
+ * @returns     SIMCOM_DEV_ERROR       - ERROR: simcom_dev == NULL
+ * @returns     SEND_CMD_WAIT_OK_ERROR - ERROR: at_send_cmd_wait_ok() != 0
+ */
+int simcom_sock_init(simcom_dev_t *simcom_dev);
+#endif /* MODULE_SIMCOM_SOCK */
+
 /*---------------------------------------------------------------------------*/
 /*------------------------- END HIGH LEVEL FUNCTION -------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -64,6 +64,9 @@
 #include "net/netdev.h"
 #include "periph/gpio.h"
 #include "periph/spi.h"
+#ifdef MODULE_PERIPH_SPI_ASYNC
+#include "periph/spi_async.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -95,6 +98,18 @@ extern "C" {
 #ifndef SX127X_DIO_PULL_MODE
 #define SX127X_DIO_PULL_MODE             (GPIO_IN_PD) /**< pull down DIOx */
 #endif
+
+/**
+ * @brief   Preamble symbols not covered by the sniff period
+ *
+ * A CAD takes up to two symbols, the receiver needs about four more
+ * preamble symbols to lock.
+ */
+#ifndef SX127X_SNIFF_GUARD_SYMBOLS
+#define SX127X_SNIFF_GUARD_SYMBOLS       (6U)
+#endif
+
+#define SX127X_SYMBOL_TIMEOUT_MAX        (0x3FFU)               /**< Largest LoRa RX symbol timeout, 10 bits */
 /** @} */
 
 /**
@@ -168,6 +183,7 @@ enum {
 #define SX127X_CHANNEL_HOPPING_FLAG             (1 << 3)
 #define SX127X_IQ_INVERTED_FLAG                 (1 << 4)
 #define SX127X_RX_CONTINUOUS_FLAG               (1 << 5)
+#define SX127X_RX_SNIFF_FLAG                    (1 << 6)
 /** @} */
 
 /**
@@ -207,9 +223,19 @@ typedef struct {
     /* Data that will be passed to events handler in application */
     lptimer_t tx_timeout_timer;        /**< TX operation timeout timer */
     lptimer_t rx_timeout_timer;        /**< RX operation timeout timer */
+    lptimer_t sniff_timer;             /**< Sniff mode wake-up timer */
     uint32_t last_channel;                      /**< Last channel in frequency hopping sequence */
     sx127x_modem_chip_t modem_chip;             /**< Modem model */
     bool is_last_cad_success;                 /**< Sign of success of last CAD operation (activity detected) */
+    bool is_sniffing;                         /**< Listening in sniff mode */
+    volatile bool sniff_wakeup;               /**< Sniff timer expired, CAD is due */
+    uint16_t symbol_timeout;                  /**< Symbol timeout restored when sniffing stops */
+#if defined(MODULE_PERIPH_SPI_ASYNC) || defined(DOXYGEN)
+    spi_async_xfer_t rx_xfer[2];              /**< FIFO read of the received packet */
+    uint8_t rx_fifo_addr;                     /**< FIFO register address, sent first */
+    volatile uint8_t rx_fetch;                /**< State of the FIFO read */
+    uint8_t rx_buf[SX127X_RX_BUFFER_SIZE];    /**< Packet read from the FIFO */
+#endif
 } sx127x_internal_t;
 
 /**
@@ -523,6 +549,48 @@ bool sx127x_get_rx_single(const sx127x_t *dev);
  */
 void sx127x_set_rx_single(sx127x_t *dev, bool single);
 
+/**
+ * @brief   Checks if the SX127X LoRa RX sniff mode is enabled/disabled
+ *
+ * @param[in] dev                      The sx127x device descriptor
+ *
+ * @return the LoRa RX sniff mode
+ */
+bool sx127x_get_rx_sniff(const sx127x_t *dev);
+
+/**
+ * @brief   Enable/disable the SX127X LoRa RX sniff mode
+ *
+ * When enabled, continuous reception without timeout is replaced by a cycle
+ * of sleep and channel activity detection. The radio only enters reception
+ * when a preamble is detected, so the senders must use a preamble longer
+ * than @ref SX127X_SNIFF_GUARD_SYMBOLS plus the sniff period.
+ *
+ * After a detected preamble, the radio waits for the sync word for up to the
+ * configured preamble length in symbols. The symbol timeout register has 10
+ * bits, so this wait is capped at @ref SX127X_SYMBOL_TIMEOUT_MAX (1023)
+ * symbols. Longer preambles may end the reception before the sync word.
+ *
+ * Takes effect with the next reception.
+ *
+ * @param[in] dev                      The sx127x device descriptor
+ * @param[in] sniff                    The LoRa RX sniff mode
+ */
+void sx127x_set_rx_sniff(sx127x_t *dev, bool sniff);
+
+/**
+ * @brief   Computes the sleep time between two CADs in sniff mode
+ *
+ * The period is derived from the preamble length and the datarate, so that
+ * a preamble is always caught early enough to be received.
+ *
+ * @param[in] dev                      The sx127x device descriptor
+ *
+ * @return sniff period in milliseconds, 0 if the preamble is too short to
+ *         sleep at all
+ */
+uint32_t sx127x_get_sniff_period(const sx127x_t *dev);
+
 /**
  * @brief   Checks if the SX127X CRC verification mode is enabled
  *
@@ -625,6 +693,15 @@ uint16_t sx127x_get_preamble_length(const sx127x_t *dev);
  */
 void sx127x_set_preamble_length(sx127x_t *dev, uint16_t preamble);
 
+/**
+ * @brief   Gets the SX127X LoRa symbol timeout
+ *
+ * @param[in] dev                      The sx127x device descriptor
+ *
+ * @return the LoRa symbol timeout
+ */
+uint16_t sx127x_get_symbol_timeout(const sx127x_t *dev);
+
 /**
  * @brief   Sets the SX127X LoRa symbol timeout
  *
@@ -18,6 +18,9 @@
  */
 
 #include "lis2hh12.h"
+#ifdef MODULE_PERIPH_I2C_ASYNC
+#include "periph/i2c_async.h"
+#endif
 #include "include/lis2hh12_internal.h"
 
 #define ENABLE_DEBUG        (0)
@@ -83,8 +86,9 @@ int lis2hh12_init(lis2hh12_t *dev, const lis2hh12_params_t *params)
     if (i2c_write_reg(DEV_I2C, DEV_ADDR, LIS2HH12_CTRL3, 0x00, 0) < 0)
         return LIS2HH12_NOBUS;
 
-    /* Set Full-scale configuration */
-    tmp = (dev->params.scale);
+    /* Set Full-scale configuration, keep register address auto increment
+     * for burst reads */
+    tmp = (LIS2HH12_MASK_IF_ADD_INC_EN | dev->params.scale);
     if (i2c_write_reg(DEV_I2C, DEV_ADDR, LIS2HH12_CTRL4, tmp, 0) < 0)
         return LIS2HH12_NOBUS;
 
@@ -93,9 +97,32 @@ int lis2hh12_init(lis2hh12_t *dev, const lis2hh12_params_t *params)
     return LIS2HH12_OK;
 }
 
+/**
+ * @brief Reads consecutive registers in one burst, the bus must not be acquired
+ */
+static int _read_regs(const lis2hh12_t *dev, uint8_t reg, uint8_t *buf, size_t len)
+{
+#ifdef MODULE_PERIPH_I2C_ASYNC
+    /* the calling thread sleeps while the transaction runs */
+    i2c_async_xfer_t xfer = {
+        .addr = DEV_ADDR,
+        .reg = reg,
+        .read = true,
+        .data = buf,
+        .len = len,
+    };
+    return i2c_async_transfer(DEV_I2C, &xfer, 1);
+#else
+    i2c_acquire(DEV_I2C);
+    int res = i2c_read_regs(DEV_I2C, DEV_ADDR, reg, buf, len, 0);
+    i2c_release(DEV_I2C);
+    return res;
+#endif
+}
+
 int lis2hh12_read_xyz(const lis2hh12_t *dev, lis2hh12_data_t *data)
 {
-    uint8_t tmp[2] = {0, 0};
+    uint8_t tmp[6];
 
     i2c_acquire(DEV_I2C);
     
@@ -106,17 +133,11 @@ int lis2hh12_read_xyz(const lis2hh12_t *dev, lis2hh12_data_t *data)
             return LIS2HH12_NOBUS;
         }
     } while (!(status & LIS2HH12_MASK_ZYXDA));
-    
-    if (i2c_read_reg(DEV_I2C, DEV_ADDR, LIS2HH12_STATUS, &status, 0) < 0) {
-        
-    }
 
-    if (i2c_read_reg(DEV_I2C, DEV_ADDR, LIS2HH12_OUT_X_L, &tmp[0], 0) < 0) {
-        i2c_release(DEV_I2C);
-        return LIS2HH12_NOBUS;
-    }
-    if (i2c_read_reg(DEV_I2C, DEV_ADDR, LIS2HH12_OUT_X_H, &tmp[1], 0) < 0) {
-        i2c_release(DEV_I2C);
+    i2c_release(DEV_I2C);
+
+    /* OUT_X_L to OUT_Z_H in one burst */
+    if (_read_regs(dev, LIS2HH12_OUT_X_L, tmp, sizeof(tmp)) < 0) {
         return LIS2HH12_NOBUS;
     }
     DEBUG("LIS2HH12: LIS2HH12_OUT_X %02X %02X\n", tmp[1], tmp[0]);
@@ -125,30 +146,11 @@ int lis2hh12_read_xyz(const lis2hh12_t *dev, lis2hh12_data_t *data)
     DEBUG("LIS2HH12: LIS2HH12_OUT_X %d\n", x);
     x = _twos_complement(x);
 
-    if (i2c_read_reg(DEV_I2C, DEV_ADDR, LIS2HH12_OUT_Y_L, &tmp[0], 0) < 0) {
-        i2c_release(DEV_I2C);
-        return LIS2HH12_NOBUS;
-    }
-    if (i2c_read_reg(DEV_I2C, DEV_ADDR, LIS2HH12_OUT_Y_H, &tmp[1], 0) < 0) {
-        i2c_release(DEV_I2C);
-        return LIS2HH12_NOBUS;
-    }
-
-    int16_t y = ((tmp[1] << 8) | tmp[0]);
+    int16_t y = ((tmp[3] << 8) | tmp[2]);
     DEBUG("LIS2HH12: LIS2HH12_OUT_Y %d\n", y);
     y = _twos_complement(y);
 
-
-    if (i2c_read_reg(DEV_I2C, DEV_ADDR, LIS2HH12_OUT_Z_L, &tmp[0], 0) < 0) {
-        i2c_release(DEV_I2C);
-        return LIS2HH12_NOBUS;
-    }
-    if (i2c_read_reg(DEV_I2C, DEV_ADDR, LIS2HH12_OUT_Z_H, &tmp[1], 0) < 0) {
-        i2c_release(DEV_I2C);
-        return LIS2HH12_NOBUS;
-    }
-
-    int16_t z = ((tmp[1] << 8) | tmp[0]);
+    int16_t z = ((tmp[5] << 8) | tmp[4]);
     DEBUG("LIS2HH12: LIS2HH12_OUT_Z %d\n", z);
     z = _twos_complement(z);
 
@@ -172,8 +174,6 @@ int lis2hh12_read_xyz(const lis2hh12_t *dev, lis2hh12_data_t *data)
     data->y_axis = ((int32_t)y * scale);
     data->z_axis = ((int32_t)z * scale);
 
-    i2c_release(DEV_I2C);
-
     return LIS2HH12_OK;
 }
 
@@ -181,14 +181,7 @@ int lis2hh12_read_temp(const lis2hh12_t *dev, int16_t *value)
 {
     uint8_t tmp[2] = {0, 0};
 
-    i2c_acquire(DEV_I2C);
-    
-    if (i2c_read_reg(DEV_I2C, DEV_ADDR, LIS2HH12_TEMP_L, &tmp[0], 0) < 0) {
-        i2c_release(DEV_I2C);
-        return LIS2HH12_NOBUS;
-    }
-    if (i2c_read_reg(DEV_I2C, DEV_ADDR, LIS2HH12_TEMP_H, &tmp[1], 0) < 0) {
-        i2c_release(DEV_I2C);
+    if (_read_regs(dev, LIS2HH12_TEMP_L, tmp, sizeof(tmp)) < 0) {
         return LIS2HH12_NOBUS;
     }
 
@@ -203,7 +196,6 @@ int lis2hh12_read_temp(const lis2hh12_t *dev, int16_t *value)
     *value = *value / 8 + 25;
     DEBUG("LIS2HH12: LIS2HH12_TEMP %d(0x%04X)\n", *value, *value);
 
-    i2c_release(DEV_I2C);
     return LIS2HH12_OK;
 }
 
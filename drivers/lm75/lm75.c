@@ -161,14 +161,18 @@ int lm75_get_ambient_temperature(lm75_t *dev)
     i2c_acquire(dev->params.i2c);
     
     /* Read two bytes from the sensor: MSB & LSB of temperature value */
-    int16_t temp = 0;
-    i2c_read_regs(dev->params.i2c, LM75_ADDRESS, LM75_REG_ADDR_TEMP, (uint8_t *)&temp, 2, 0);
+    uint8_t raw[2] = { 0, 0 };
+    i2c_read_regs(dev->params.i2c, LM75_ADDRESS, LM75_REG_ADDR_TEMP, raw, 2, 0);
 
     /* Release the I2C bus */
     i2c_release(dev->params.i2c);
 
-    /* Swap bytes */
-    temp = ((temp >> 8) & 0xff) | ((temp & 0xff) << 8);
+    return lm75_raw_temperature(raw);
+}
+
+int lm75_raw_temperature(const uint8_t *raw)
+{
+    int16_t temp = (raw[0] << 8) | raw[1];
 
     /* Shift bits while preserving the sign */
     temp = (temp & 0x8000) | ((temp >> 5) & 0x3ff);
@@ -177,6 +181,21 @@ int lm75_get_ambient_temperature(lm75_t *dev)
     return (int)temp * 125;
 }
 
+#ifdef MODULE_PERIPH_I2C_ASYNC
+void lm75_async_read(const lm75_t *dev, i2c_async_xfer_t *xfer, uint8_t *raw)
+{
+    assert(dev != NULL);
+    (void)dev;
+
+    memset(xfer, 0, sizeof(*xfer));
+    xfer->addr = LM75_ADDRESS;
+    xfer->reg = LM75_REG_ADDR_TEMP;
+    xfer->read = true;
+    xfer->data = raw;
+    xfer->len = 2;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
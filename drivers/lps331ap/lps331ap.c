@@ -24,6 +24,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "periph/i2c.h"
 #include "byteorder.h"
@@ -98,6 +99,34 @@ int lps331ap_read_pres(const lps331ap_t *dev)
     return val / PRES_DIVIDER;
 }
 
+#ifdef MODULE_PERIPH_I2C_ASYNC
+void lps331ap_async_read(const lps331ap_t *dev, i2c_async_xfer_t *xfer,
+                         uint8_t *raw)
+{
+    memset(xfer, 0, sizeof(*xfer));
+    xfer->addr = DEV_ADDR;
+    /* PRESS_OUT_XL to TEMP_OUT_H */
+    xfer->reg = LPS331AP_REG_PRESS_OUT_XL | LPS331AP_AUTO_INC;
+    xfer->read = true;
+    xfer->data = raw;
+    xfer->len = LPS331AP_RAW_LEN;
+}
+
+int lps331ap_raw_temp(const uint8_t *raw)
+{
+    int16_t val = (int16_t)((raw[4] << 8) | raw[3]);
+
+    /* return temperature in mC */
+    return TEMP_BASE + (1000*(int)val)/TEMP_DIVIDER;
+}
+
+int lps331ap_raw_pres(const uint8_t *raw)
+{
+    int32_t val = raw[0] | ((uint32_t)raw[1] << 8) | ((uint32_t)raw[2] << 16);
+
+    return val / PRES_DIVIDER;
+}
+#endif
 
 int lps331ap_enable(const lps331ap_t *dev)
 {
@@ -0,0 +1,370 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_cache
+ * @{
+ *
+ * @file
+ * @brief       Write-back page cache for mtd devices
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "mtd.h"
+#include "mtd_cache.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define PAGE_NONE   (UINT32_MAX)
+
+static uint8_t *_data(mtd_cache_t *cache, mtd_cache_page_t *entry)
+{
+    return &cache->buf[(entry - cache->pages) * cache->base.page_size];
+}
+
+static mtd_cache_page_t *_find(mtd_cache_t *cache, uint32_t page)
+{
+    for (unsigned i = 0; i < MTD_CACHE_PAGES; i++) {
+        if (cache->pages[i].page == page) {
+            return &cache->pages[i];
+        }
+    }
+    return NULL;
+}
+
+static void _touch(mtd_cache_t *cache, mtd_cache_page_t *entry)
+{
+    entry->last_use = ++cache->use_ctr;
+}
+
+static int _writeback(mtd_cache_t *cache, mtd_cache_page_t *entry)
+{
+    if (entry->dirty_end == 0) {
+        return 0;
+    }
+
+    uint32_t len = entry->dirty_end - entry->dirty_start;
+    DEBUG("mtd_cache: write back page %" PRIu32 " [%" PRIu32 ", %" PRIu32 ")\n",
+          entry->page, entry->dirty_start, entry->dirty_end);
+
+    int res = mtd_write(cache->dev, _data(cache, entry) + entry->dirty_start,
+                        entry->page * cache->base.page_size + entry->dirty_start,
+                        len);
+    if (res < 0) {
+        return res;
+    }
+    if ((uint32_t)res != len) {
+        return -EIO;
+    }
+    cache->stats.writebacks++;
+    entry->dirty_start = 0;
+    entry->dirty_end = 0;
+    return 0;
+}
+
+/* takes an unused or the least recently used page, writing it back if needed */
+static int _evict(mtd_cache_t *cache, mtd_cache_page_t **entry)
+{
+    mtd_cache_page_t *lru = &cache->pages[0];
+
+    for (unsigned i = 0; i < MTD_CACHE_PAGES; i++) {
+        if (cache->pages[i].page == PAGE_NONE) {
+            lru = &cache->pages[i];
+            break;
+        }
+        if ((int32_t)(cache->pages[i].last_use - lru->last_use) < 0) {
+            lru = &cache->pages[i];
+        }
+    }
+
+    int res = _writeback(cache, lru);
+    if (res < 0) {
+        return res;
+    }
+    lru->page = PAGE_NONE;
+    *entry = lru;
+    return 0;
+}
+
+/* gets a page into the cache, its content is only read if @p fill is set */
+static int _load(mtd_cache_t *cache, uint32_t page, bool fill,
+                 mtd_cache_page_t **entry)
+{
+    int res = _evict(cache, entry);
+    if (res < 0) {
+        return res;
+    }
+
+    cache->stats.misses++;
+    if (fill) {
+        res = mtd_read(cache->dev, _data(cache, *entry),
+                       page * cache->base.page_size, cache->base.page_size);
+        if (res < 0) {
+            return res;
+        }
+        if ((uint32_t)res != cache->base.page_size) {
+            return -EIO;
+        }
+    }
+    (*entry)->page = page;
+    return 0;
+}
+
+static int _flush(mtd_cache_t *cache)
+{
+    /* write back in ascending page order, devices handle sequential
+     * programs best */
+    while (1) {
+        mtd_cache_page_t *next = NULL;
+
+        for (unsigned i = 0; i < MTD_CACHE_PAGES; i++) {
+            mtd_cache_page_t *entry = &cache->pages[i];
+            if ((entry->dirty_end != 0) &&
+                ((next == NULL) || (entry->page < next->page))) {
+                next = entry;
+            }
+        }
+        if (next == NULL) {
+            return 0;
+        }
+
+        int res = _writeback(cache, next);
+        if (res < 0) {
+            return res;
+        }
+    }
+}
+
+static int mtd_cache_init(mtd_dev_t *dev)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+
+    int res = mtd_init(cache->dev);
+    if (res < 0) {
+        return res;
+    }
+
+    mutex_lock(&cache->lock);
+    /* file systems initialize the device on every mount, the cached pages
+     * stay valid then */
+    res = _flush(cache);
+    dev->sector_count = cache->dev->sector_count;
+    dev->pages_per_sector = cache->dev->pages_per_sector;
+    dev->page_size = cache->dev->page_size;
+    mutex_unlock(&cache->lock);
+
+    return res;
+}
+
+static int mtd_cache_read(mtd_dev_t *dev, void *buff, uint32_t addr,
+                          uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t page_size = dev->page_size;
+    uint8_t *dest = buff;
+    int res = 0;
+
+    DEBUG("mtd_cache_read: addr:%" PRIu32 " size:%" PRIu32 "\n", addr, size);
+
+    if ((uint64_t)addr + size >
+        (uint64_t)dev->sector_count * dev->pages_per_sector * page_size) {
+        return -EOVERFLOW;
+    }
+
+    mutex_lock(&cache->lock);
+    uint32_t left = size;
+    while (left > 0) {
+        uint32_t page = addr / page_size;
+        uint32_t off = addr % page_size;
+        uint32_t len = (left < (page_size - off)) ? left : (page_size - off);
+        mtd_cache_page_t *entry = _find(cache, page);
+
+        if (entry != NULL) {
+            cache->stats.hits++;
+            _touch(cache, entry);
+            memcpy(dest, _data(cache, entry) + off, len);
+        }
+        else if (len == page_size) {
+            /* read a run of whole uncached pages directly, so large reads
+             * do not displace the cached pages */
+            uint32_t pages = 1;
+            while ((left >= (pages + 1) * page_size) &&
+                   (_find(cache, page + pages) == NULL)) {
+                pages++;
+            }
+            len = pages * page_size;
+            cache->stats.misses += pages;
+            res = mtd_read(cache->dev, dest, addr, len);
+            if (res < 0) {
+                break;
+            }
+            if ((uint32_t)res != len) {
+                res = -EIO;
+                break;
+            }
+        }
+        else {
+            res = _load(cache, page, true, &entry);
+            if (res < 0) {
+                break;
+            }
+            _touch(cache, entry);
+            memcpy(dest, _data(cache, entry) + off, len);
+        }
+
+        dest += len;
+        addr += len;
+        left -= len;
+    }
+    mutex_unlock(&cache->lock);
+
+    return (res < 0) ? res : (int)size;
+}
+
+static int mtd_cache_write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                           uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t page_size = dev->page_size;
+    uint32_t page = addr / page_size;
+    uint32_t off = addr % page_size;
+
+    DEBUG("mtd_cache_write: addr:%" PRIu32 " size:%" PRIu32 "\n", addr, size);
+
+    if ((page >= dev->sector_count * dev->pages_per_sector) ||
+        ((off + size) > page_size)) {
+        return -EOVERFLOW;
+    }
+    if (size == 0) {
+        return 0;
+    }
+
+    mutex_lock(&cache->lock);
+    mtd_cache_page_t *entry = _find(cache, page);
+    if (entry != NULL) {
+        cache->stats.hits++;
+    }
+    else {
+        /* a page that is written completely does not need to be read */
+        int res = _load(cache, page, size != page_size, &entry);
+        if (res < 0) {
+            mutex_unlock(&cache->lock);
+            return res;
+        }
+    }
+    _touch(cache, entry);
+    memcpy(_data(cache, entry) + off, buff, size);
+
+    if (entry->dirty_end == 0) {
+        entry->dirty_start = off;
+        entry->dirty_end = off + size;
+    }
+    else {
+        if (off < entry->dirty_start) {
+            entry->dirty_start = off;
+        }
+        if ((off + size) > entry->dirty_end) {
+            entry->dirty_end = off + size;
+        }
+    }
+    mutex_unlock(&cache->lock);
+
+    return size;
+}
+
+static int mtd_cache_erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+
+    DEBUG("mtd_cache_erase: addr:%" PRIu32 " size:%" PRIu32 "\n", addr, size);
+
+    mutex_lock(&cache->lock);
+    int res = mtd_erase(cache->dev, addr, size);
+    if (res == 0) {
+        /* erased data does not need to be written back */
+        uint32_t first = addr / dev->page_size;
+        uint32_t last = first + (size / dev->page_size);
+        for (unsigned i = 0; i < MTD_CACHE_PAGES; i++) {
+            mtd_cache_page_t *entry = &cache->pages[i];
+            if ((entry->page >= first) && (entry->page < last)) {
+                entry->page = PAGE_NONE;
+                entry->dirty_start = 0;
+                entry->dirty_end = 0;
+            }
+        }
+    }
+    mutex_unlock(&cache->lock);
+
+    return res;
+}
+
+static int mtd_cache_power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+
+    if (power == MTD_POWER_DOWN) {
+        mutex_lock(&cache->lock);
+        int res = _flush(cache);
+        mutex_unlock(&cache->lock);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return mtd_power(cache->dev, power);
+}
+
+static int mtd_cache_flush(mtd_dev_t *dev)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+
+    mutex_lock(&cache->lock);
+    int res = _flush(cache);
+    mutex_unlock(&cache->lock);
+    if (res < 0) {
+        return res;
+    }
+    return mtd_flush(cache->dev);
+}
+
+const mtd_desc_t mtd_cache_driver = {
+    .init = mtd_cache_init,
+    .read = mtd_cache_read,
+    .write = mtd_cache_write,
+    .erase = mtd_cache_erase,
+    .power = mtd_cache_power,
+    .flush = mtd_cache_flush,
+};
+
+void mtd_cache_setup(mtd_cache_t *cache, mtd_dev_t *dev, uint8_t *buf)
+{
+    cache->base.driver = &mtd_cache_driver;
+    cache->dev = dev;
+    cache->buf = buf;
+    mutex_init(&cache->lock);
+    cache->use_ctr = 0;
+    for (unsigned i = 0; i < MTD_CACHE_PAGES; i++) {
+        cache->pages[i].page = PAGE_NONE;
+        cache->pages[i].dirty_start = 0;
+        cache->pages[i].dirty_end = 0;
+    }
+    mtd_cache_stats_reset(cache);
+}
+
+void mtd_cache_stats_reset(mtd_cache_t *cache)
+{
+    memset(&cache->stats, 0, sizeof(cache->stats));
+}
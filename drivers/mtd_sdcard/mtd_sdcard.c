@@ -99,14 +99,25 @@ static int mtd_sdcard_erase(mtd_dev_t *dev,
                             uint32_t size)
 {
     DEBUG("mtd_sdcard_erase: addr:%" PRIu32 " size:%" PRIu32 "\n", addr, size);
+
+#if MTD_SDCARD_SKIP_ERASE == 1
     (void)dev;
     (void)addr;
     (void)size;
-
-#if MTD_SDCARD_SKIP_ERASE == 1
     return 0;
 #else
-    return -ENOTSUP; /* explicit erase currently not supported */
+    mtd_sdcard_t *mtd_sd = (mtd_sdcard_t*)dev;
+    sd_rw_response_t err;
+
+    if ((addr % SD_HC_BLOCK_SIZE) || (size % SD_HC_BLOCK_SIZE)) {
+        return -EINVAL;
+    }
+    sdcard_spi_erase_blocks(mtd_sd->sd_card, addr / SD_HC_BLOCK_SIZE,
+                            size / SD_HC_BLOCK_SIZE, &err);
+    if (err == SD_RW_OK) {
+        return 0;
+    }
+    return -EIO;
 #endif
 }
 
@@ -21,6 +21,7 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdint.h>
 #include <errno.h>
 
@@ -33,6 +34,14 @@
 #endif
 #include "byteorder.h"
 #include "mtd_spi_nor.h"
+#ifdef MODULE_MTD_SPI_NOR_ASYNC
+#include "thread.h"
+#endif
+#ifdef MODULE_PERIPH_SPI_ASYNC
+#include <string.h>
+#include "irq.h"
+#include "kernel_defines.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -53,6 +62,47 @@
 #define MTD_4K              (4096ul)
 #define MTD_4K_ADDR_MASK    (0xFFF)
 
+#define SPI_NOR_STATUS_WIP  (0x01)
+
+#ifdef MODULE_MTD_SPI_NOR_ASYNC
+#ifndef MTD_SPI_NOR_ERASE_POLL_US
+#define MTD_SPI_NOR_ERASE_POLL_US (10 * US_PER_MS)
+#endif
+
+/* the erase thread waits for the chip and the bus, so this must not be done
+ * by the shared bottom-half worker */
+#ifndef MTD_SPI_NOR_ASYNC_STACKSIZE
+#define MTD_SPI_NOR_ASYNC_STACKSIZE (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+#ifndef MTD_SPI_NOR_ASYNC_PRIO
+#define MTD_SPI_NOR_ASYNC_PRIO (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/* suspend latency (tSUS), also the minimum time from a resume to the next
+ * suspend command */
+#ifndef MTD_SPI_NOR_SUSPEND_US
+#define MTD_SPI_NOR_SUSPEND_US (30U)
+#endif
+
+/* give up suspending and wait for the erase when the chip is not ready by then */
+#ifndef MTD_SPI_NOR_SUSPEND_TIMEOUT_US
+#define MTD_SPI_NOR_SUSPEND_TIMEOUT_US (10 * MTD_SPI_NOR_SUSPEND_US)
+#endif
+
+enum {
+    BUSY_NONE,          /**< no erase command in progress */
+    BUSY_ERASE,         /**< erase command of mtd_spi_nor_erase_async() */
+    BUSY_PRE_ERASE,     /**< erase command of a pre-erase queue entry */
+};
+
+enum {
+    PRE_ERASE_UNUSED,
+    PRE_ERASE_QUEUED,
+    PRE_ERASE_DONE,
+};
+#endif
+
 static int mtd_spi_nor_init(mtd_dev_t *mtd);
 static int mtd_spi_nor_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t size);
 static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uint32_t size);
@@ -141,6 +191,43 @@ static void mtd_spi_cmd_addr_write(const mtd_spi_nor_t *dev, uint8_t opcode,
     } while (0);
 }
 
+#ifdef MODULE_PERIPH_SPI_ASYNC
+/**
+ * @internal
+ * @brief Queue command opcode followed by address and data transfer
+ *
+ * Fills two transfer descriptors.
+ *
+ * @param[in]  dev    pointer to device descriptor
+ * @param[out] xfer   transfer descriptors to fill
+ * @param[out] cmd    buffer for opcode and address, at least 5 bytes
+ * @param[in]  opcode command opcode
+ * @param[in]  addr   address (big endian)
+ * @param[in]  src    write buffer, NULL if reading
+ * @param[out] dest   read buffer, NULL if writing
+ * @param[in]  count  number of bytes to transfer after the address
+ */
+static void mtd_spi_async_cmd_addr(const mtd_spi_nor_t *dev,
+                                   spi_async_xfer_t *xfer, uint8_t *cmd,
+                                   uint8_t opcode, be_uint32_t addr,
+                                   const void *src, void *dest, uint32_t count)
+{
+    cmd[0] = opcode;
+    memcpy(&cmd[1], &addr.u8[4 - dev->addr_width], dev->addr_width);
+
+    for (unsigned i = 0; i < 2; i++) {
+        xfer[i] = (spi_async_xfer_t){ .cs = dev->cs, .mode = dev->mode,
+                                      .clk = dev->clk };
+    }
+    xfer[0].cont = true;
+    xfer[0].out = cmd;
+    xfer[0].len = 1 + dev->addr_width;
+    xfer[1].out = src;
+    xfer[1].in = dest;
+    xfer[1].len = count;
+}
+#endif
+
 /**
  * @internal
  * @brief Send command opcode followed by a read to buffer
@@ -256,14 +343,21 @@ static int mtd_spi_read_jedec_id(const mtd_spi_nor_t *dev, mtd_jedec_id_t *out)
     return status;
 }
 
+static inline uint8_t mtd_spi_read_status(const mtd_spi_nor_t *dev)
+{
+    uint8_t status;
+
+    mtd_spi_cmd_read(dev, dev->opcode->rdsr, &status, sizeof(status));
+    return status;
+}
+
 static inline void wait_for_write_complete(const mtd_spi_nor_t *dev)
 {
     do {
-        uint8_t status;
-        mtd_spi_cmd_read(dev, dev->opcode->rdsr, &status, sizeof(status));
+        uint8_t status = mtd_spi_read_status(dev);
 
         TRACE("mtd_spi_nor: wait device status = 0x%02x\n", (unsigned int)status);
-        if ((status & 1) == 0) { /* TODO magic number */
+        if ((status & SPI_NOR_STATUS_WIP) == 0) {
             break;
         }
 #if MODULE_XTIMER
@@ -274,6 +368,320 @@ static inline void wait_for_write_complete(const mtd_spi_nor_t *dev)
     } while (1);
 }
 
+/**
+ * @internal
+ * @brief Issue the largest erase command fitting the range
+ *
+ * @return number of bytes erased by the command
+ */
+static uint32_t mtd_spi_erase_cmd(const mtd_spi_nor_t *dev, uint32_t addr, uint32_t size)
+{
+    const mtd_dev_t *mtd = &dev->base;
+    uint32_t sector_size = mtd->page_size * mtd->pages_per_sector;
+    uint32_t total_size = sector_size * mtd->sector_count;
+    be_uint32_t addr_be = byteorder_htonl(addr);
+
+    /* write enable */
+    mtd_spi_cmd(dev, dev->opcode->wren);
+
+    if (size == total_size) {
+        mtd_spi_cmd(dev, dev->opcode->chip_erase);
+        return total_size;
+    }
+    else if ((dev->flag & SPI_NOR_F_SECT_32K) && (size >= MTD_32K) &&
+             ((addr & MTD_32K_ADDR_MASK) == 0)) {
+        /* 32 KiB blocks can be erased with block erase command */
+        mtd_spi_cmd_addr_write(dev, dev->opcode->block_erase_32k, addr_be, NULL, 0);
+        return MTD_32K;
+    }
+    else if ((dev->flag & SPI_NOR_F_SECT_4K) && (size >= MTD_4K) &&
+             ((addr & MTD_4K_ADDR_MASK) == 0)) {
+        /* 4 KiB sectors can be erased with sector erase command */
+        mtd_spi_cmd_addr_write(dev, dev->opcode->sector_erase, addr_be, NULL, 0);
+        return MTD_4K;
+    }
+    else {
+        mtd_spi_cmd_addr_write(dev, dev->opcode->block_erase, addr_be, NULL, 0);
+        return sector_size;
+    }
+}
+
+static int mtd_spi_check_erase(const mtd_dev_t *mtd, uint32_t addr, uint32_t size)
+{
+    const mtd_spi_nor_t *dev = (const mtd_spi_nor_t *)mtd;
+    uint32_t sector_size = mtd->page_size * mtd->pages_per_sector;
+    uint32_t total_size = sector_size * mtd->sector_count;
+
+    if (dev->sec_addr_mask &&
+        ((addr & ~dev->sec_addr_mask) != 0)) {
+        /* This is not a requirement in hardware, but it helps in catching
+         * software bugs (the erase-all-your-files kind) */
+        DEBUG("addr = %" PRIx32 " ~dev->erase_addr_mask = %" PRIx32 "", addr, ~dev->sec_addr_mask);
+        DEBUG("mtd_spi_nor_erase: ERR: erase addr not aligned on %" PRIu32 " byte boundary.\n",
+              sector_size);
+        return -EOVERFLOW;
+    }
+    if (addr + size > total_size) {
+        return -EOVERFLOW;
+    }
+    if (size % sector_size != 0) {
+        return -EOVERFLOW;
+    }
+    return 0;
+}
+
+#ifdef MODULE_MTD_SPI_NOR_ASYNC
+static char _stack[MTD_SPI_NOR_ASYNC_STACKSIZE];
+static event_queue_t _queue;
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+
+static void *_erase_thread(void *arg)
+{
+    (void)arg;
+
+    event_queue_init(&_queue);
+    event_loop(&_queue);
+    return NULL;
+}
+
+static void _timer_cb(void *arg)
+{
+    mtd_spi_nor_t *dev = arg;
+
+    event_post(&_queue, &dev->event.super);
+}
+
+/* issues the next background erase command, the lock must be held */
+static void _start_next(mtd_spi_nor_t *dev)
+{
+    const mtd_dev_t *mtd = &dev->base;
+    uint32_t sector_size = mtd->page_size * mtd->pages_per_sector;
+
+    /* threads waiting for the chip go first */
+    if ((dev->busy != BUSY_NONE) || (dev->waiters > 0)) {
+        return;
+    }
+
+    if (dev->erase_req && (dev->erase_left > 0)) {
+        spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
+        uint32_t len = mtd_spi_erase_cmd(dev, dev->erase_addr, dev->erase_left);
+        spi_release(dev->spi);
+        dev->erase_addr += len;
+        dev->erase_left -= len;
+        dev->busy = BUSY_ERASE;
+    }
+    else {
+        unsigned i;
+        for (i = 0; i < MTD_SPI_NOR_PRE_ERASE_NUMOF; i++) {
+            if (dev->pre_erase[i].state == PRE_ERASE_QUEUED) {
+                break;
+            }
+        }
+        if (i == MTD_SPI_NOR_PRE_ERASE_NUMOF) {
+            return;
+        }
+        DEBUG("mtd_spi_nor: pre-erase sector %" PRIu32 "\n", dev->pre_erase[i].sector);
+        spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
+        mtd_spi_erase_cmd(dev, dev->pre_erase[i].sector * sector_size, sector_size);
+        spi_release(dev->spi);
+        dev->pre_erase_cur = i;
+        dev->busy = BUSY_PRE_ERASE;
+    }
+    xtimer_set(&dev->timer, MTD_SPI_NOR_ERASE_POLL_US);
+}
+
+static void _erase_poll(void *arg)
+{
+    mtd_spi_nor_t *dev = arg;
+    mtd_spi_nor_cb_t cb = NULL;
+    void *cb_arg = NULL;
+    bool done = false;
+
+    mutex_lock(&dev->lock);
+    if (dev->busy == BUSY_NONE) {
+        /* woken up after a queued read, pending pre-erases may start */
+        _start_next(dev);
+        mutex_unlock(&dev->lock);
+        return;
+    }
+
+    spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
+    uint8_t status = mtd_spi_read_status(dev);
+    spi_release(dev->spi);
+
+    TRACE("mtd_spi_nor: erase status = 0x%02x\n", (unsigned int)status);
+    if (status & SPI_NOR_STATUS_WIP) {
+        xtimer_set(&dev->timer, MTD_SPI_NOR_ERASE_POLL_US);
+        mutex_unlock(&dev->lock);
+        return;
+    }
+
+    if (dev->busy == BUSY_PRE_ERASE) {
+        for (unsigned i = 0; i < MTD_SPI_NOR_PRE_ERASE_NUMOF; i++) {
+            mtd_spi_nor_pre_erase_t *entry = &dev->pre_erase[i];
+            if ((entry->state == PRE_ERASE_DONE) && (entry->age < UINT8_MAX)) {
+                entry->age++;
+            }
+        }
+        dev->pre_erase[dev->pre_erase_cur].state = PRE_ERASE_DONE;
+        dev->pre_erase[dev->pre_erase_cur].age = 0;
+    }
+    else if (dev->erase_left == 0) {
+        dev->erase_req = false;
+        cb = dev->cb;
+        cb_arg = dev->cb_arg;
+        done = true;
+    }
+    dev->busy = BUSY_NONE;
+    _start_next(dev);
+    mutex_unlock(&dev->lock);
+
+    if (done && cb) {
+        cb(cb_arg);
+    }
+}
+
+/* true if all sectors of the range are pre-erased, queued ones are dropped */
+static bool _pre_erased(mtd_spi_nor_t *dev, uint32_t addr, uint32_t size)
+{
+    const mtd_dev_t *mtd = &dev->base;
+    uint32_t sector_size = mtd->page_size * mtd->pages_per_sector;
+    uint32_t first = addr / sector_size;
+    uint32_t last = first + (size / sector_size);
+    uint32_t erased = 0;
+
+    for (unsigned i = 0; i < MTD_SPI_NOR_PRE_ERASE_NUMOF; i++) {
+        mtd_spi_nor_pre_erase_t *entry = &dev->pre_erase[i];
+        if ((entry->state == PRE_ERASE_UNUSED) ||
+            (entry->sector < first) || (entry->sector >= last)) {
+            continue;
+        }
+        if (entry->state == PRE_ERASE_DONE) {
+            erased++;
+        }
+        else {
+            /* erased by the caller anyway */
+            entry->state = PRE_ERASE_UNUSED;
+        }
+    }
+    return (size > 0) && (erased == last - first);
+}
+
+/* a written sector is no longer erased */
+static void _pre_erase_drop(mtd_spi_nor_t *dev, uint32_t addr)
+{
+    const mtd_dev_t *mtd = &dev->base;
+    uint32_t sector = addr / (mtd->page_size * mtd->pages_per_sector);
+
+    for (unsigned i = 0; i < MTD_SPI_NOR_PRE_ERASE_NUMOF; i++) {
+        if (dev->pre_erase[i].sector == sector) {
+            dev->pre_erase[i].state = PRE_ERASE_UNUSED;
+        }
+    }
+}
+
+/* waits until no background erase command is in progress, the lock must be
+ * held */
+static void _wait_idle(mtd_spi_nor_t *dev)
+{
+    dev->waiters++;
+    while (dev->busy != BUSY_NONE) {
+        mutex_unlock(&dev->lock);
+        xtimer_usleep(MTD_SPI_NOR_ERASE_POLL_US);
+        mutex_lock(&dev->lock);
+    }
+    dev->waiters--;
+}
+
+/* locks the device and waits until no background erase command is in progress,
+ * returns true instead if it may be suspended */
+static bool _lock(mtd_spi_nor_t *dev, bool suspend)
+{
+    mutex_lock(&dev->lock);
+    if (suspend && (dev->busy != BUSY_NONE) && (dev->flag & SPI_NOR_F_SUSPEND)) {
+        return true;
+    }
+    _wait_idle(dev);
+    return false;
+}
+
+static void _resume(mtd_spi_nor_t *dev)
+{
+    mtd_spi_cmd(dev, dev->opcode->resume);
+    dev->resume_time = xtimer_now_usec();
+}
+
+/* suspends the erase in progress, the bus must be acquired. Returns false if
+ * the chip did not get ready in time, the erase is resumed then. */
+static bool _suspend(mtd_spi_nor_t *dev)
+{
+    /* a suspend right after the resume would stall the erase */
+    uint32_t since = xtimer_now_usec() - dev->resume_time;
+    if (since < MTD_SPI_NOR_SUSPEND_US) {
+        xtimer_usleep(MTD_SPI_NOR_SUSPEND_US - since);
+    }
+
+    mtd_spi_cmd(dev, dev->opcode->suspend);
+    uint32_t start = xtimer_now_usec();
+    while (mtd_spi_read_status(dev) & SPI_NOR_STATUS_WIP) {
+        if ((xtimer_now_usec() - start) > MTD_SPI_NOR_SUSPEND_TIMEOUT_US) {
+            DEBUG("mtd_spi_nor: suspend timed out\n");
+            _resume(dev);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _unlock(mtd_spi_nor_t *dev)
+{
+    _start_next(dev);
+    mutex_unlock(&dev->lock);
+}
+#else
+static inline bool _lock(mtd_spi_nor_t *dev, bool suspend)
+{
+    (void)dev;
+    (void)suspend;
+    return false;
+}
+
+static inline void _unlock(mtd_spi_nor_t *dev)
+{
+    (void)dev;
+}
+
+static inline void _wait_idle(mtd_spi_nor_t *dev)
+{
+    (void)dev;
+}
+
+static inline bool _suspend(mtd_spi_nor_t *dev)
+{
+    (void)dev;
+    return false;
+}
+
+static inline void _resume(mtd_spi_nor_t *dev)
+{
+    (void)dev;
+}
+
+static inline bool _pre_erased(mtd_spi_nor_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+    (void)addr;
+    (void)size;
+    return false;
+}
+
+static inline void _pre_erase_drop(mtd_spi_nor_t *dev, uint32_t addr)
+{
+    (void)dev;
+    (void)addr;
+}
+#endif
+
 static int mtd_spi_nor_init(mtd_dev_t *mtd)
 {
     DEBUG("mtd_spi_nor_init: %p\n", (void *)mtd);
@@ -296,22 +704,40 @@ static int mtd_spi_nor_init(mtd_dev_t *mtd)
         return -EINVAL;
     }
 
+#ifdef MODULE_MTD_SPI_NOR_ASYNC
+    if (_pid == KERNEL_PID_UNDEF) {
+        _pid = thread_create(_stack, sizeof(_stack), MTD_SPI_NOR_ASYNC_PRIO,
+                             THREAD_CREATE_STACKTEST, _erase_thread, NULL,
+                             "mtd_spi_nor");
+        assert(_pid > KERNEL_PID_UNDEF);
+    }
+    if (dev->event.callback == NULL) {
+        /* mtd_init() is called again on every mount, a background erase in
+         * progress is kept then */
+        event_callback_init(&dev->event, _erase_poll, dev);
+        dev->timer.callback = _timer_cb;
+        dev->timer.arg = dev;
+    }
+#endif
+
     /* CS */
     DEBUG("mtd_spi_nor_init: CS init\n");
     spi_init_cs(dev->spi, dev->cs);
 
+    _lock(dev, false);
     spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
     int res = mtd_spi_read_jedec_id(dev, &dev->jedec_id);
     if (res < 0) {
         spi_release(dev->spi);
+        _unlock(dev);
         return -EIO;
     }
     DEBUG("mtd_spi_nor_init: Found chip with ID: (%d, 0x%02x, 0x%02x, 0x%02x)\n",
           dev->jedec_id.bank, dev->jedec_id.manuf, dev->jedec_id.device[0], dev->jedec_id.device[1]);
 
-    uint8_t status;
-    mtd_spi_cmd_read(dev, dev->opcode->rdsr, &status, sizeof(status));
+    uint8_t status = mtd_spi_read_status(dev);
     spi_release(dev->spi);
+    _unlock(dev);
 
     DEBUG("mtd_spi_nor_init: device status = 0x%02x\n", (unsigned int)status);
 
@@ -354,7 +780,7 @@ static int mtd_spi_nor_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t
 {
     DEBUG("mtd_spi_nor_read: %p, %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
           (void *)mtd, dest, addr, size);
-    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
     size_t chipsize = mtd->page_size * mtd->pages_per_sector * mtd->sector_count;
     if (addr > chipsize) {
         return -EOVERFLOW;
@@ -375,9 +801,21 @@ static int mtd_spi_nor_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t
     }
     be_uint32_t addr_be = byteorder_htonl(addr);
 
+    bool suspended = _lock(dev, true);
     spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
+    /* suspend the background erase for the read */
+    if (suspended && !_suspend(dev)) {
+        spi_release(dev->spi);
+        _wait_idle(dev);
+        spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
+        suspended = false;
+    }
     mtd_spi_cmd_addr_read(dev, dev->opcode->read, addr_be, dest, size);
+    if (suspended) {
+        _resume(dev);
+    }
     spi_release(dev->spi);
+    _unlock(dev);
 
     return size;
 }
@@ -391,7 +829,7 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
     if (size == 0) {
         return 0;
     }
-    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
     if (size > mtd->page_size) {
         DEBUG("mtd_spi_nor_write: ERR: page program >1 page (%" PRIu32 ")!\n", mtd->page_size);
         return -EOVERFLOW;
@@ -406,6 +844,9 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
     }
     be_uint32_t addr_be = byteorder_htonl(addr);
 
+    _lock(dev, false);
+    _pre_erase_drop(dev, addr);
+
     spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
     /* write enable */
     mtd_spi_cmd(dev, dev->opcode->wren);
@@ -417,6 +858,7 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
     wait_for_write_complete(dev);
 
     spi_release(dev->spi);
+    _unlock(dev);
     return size;
 }
 
@@ -425,59 +867,30 @@ static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
     DEBUG("mtd_spi_nor_erase: %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
           (void *)mtd, addr, size);
     mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
-    uint32_t sector_size = mtd->page_size * mtd->pages_per_sector;
-    uint32_t total_size = sector_size * mtd->sector_count;
 
-    if (dev->sec_addr_mask &&
-        ((addr & ~dev->sec_addr_mask) != 0)) {
-        /* This is not a requirement in hardware, but it helps in catching
-         * software bugs (the erase-all-your-files kind) */
-        DEBUG("addr = %" PRIx32 " ~dev->erase_addr_mask = %" PRIx32 "", addr, ~dev->sec_addr_mask);
-        DEBUG("mtd_spi_nor_erase: ERR: erase addr not aligned on %" PRIu32 " byte boundary.\n",
-              sector_size);
-        return -EOVERFLOW;
-    }
-    if (addr + size > total_size) {
-        return -EOVERFLOW;
+    int res = mtd_spi_check_erase(mtd, addr, size);
+    if (res < 0) {
+        return res;
     }
-    if (size % sector_size != 0) {
-        return -EOVERFLOW;
+
+    _lock(dev, false);
+    if (_pre_erased(dev, addr, size)) {
+        DEBUG("mtd_spi_nor_erase: pre-erased\n");
+        _unlock(dev);
+        return 0;
     }
 
     spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
     while (size) {
-        be_uint32_t addr_be = byteorder_htonl(addr);
-        /* write enable */
-        mtd_spi_cmd(dev, dev->opcode->wren);
-
-        if (size == total_size) {
-            mtd_spi_cmd(dev, dev->opcode->chip_erase);
-            size -= total_size;
-        }
-        else if ((dev->flag & SPI_NOR_F_SECT_32K) && (size >= MTD_32K) &&
-                 ((addr & MTD_32K_ADDR_MASK) == 0)) {
-            /* 32 KiB blocks can be erased with block erase command */
-            mtd_spi_cmd_addr_write(dev, dev->opcode->block_erase_32k, addr_be, NULL, 0);
-            addr += MTD_32K;
-            size -= MTD_32K;
-        }
-        else if ((dev->flag & SPI_NOR_F_SECT_4K) && (size >= MTD_4K) &&
-                 ((addr & MTD_4K_ADDR_MASK) == 0)) {
-            /* 4 KiB sectors can be erased with sector erase command */
-            mtd_spi_cmd_addr_write(dev, dev->opcode->sector_erase, addr_be, NULL, 0);
-            addr += MTD_4K;
-            size -= MTD_4K;
-        }
-        else {
-            mtd_spi_cmd_addr_write(dev, dev->opcode->block_erase, addr_be, NULL, 0);
-            addr += sector_size;
-            size -= sector_size;
-        }
+        uint32_t len = mtd_spi_erase_cmd(dev, addr, size);
+        addr += len;
+        size -= len;
 
         /* waiting for the command to complete before continuing */
         wait_for_write_complete(dev);
     }
     spi_release(dev->spi);
+    _unlock(dev);
 
     return 0;
 }
@@ -486,6 +899,7 @@ static int mtd_spi_nor_power(mtd_dev_t *mtd, enum mtd_power_state power)
 {
     mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
 
+    _lock(dev, false);
     spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
     switch (power) {
         case MTD_POWER_UP:
@@ -496,6 +910,155 @@ static int mtd_spi_nor_power(mtd_dev_t *mtd, enum mtd_power_state power)
             break;
     }
     spi_release(dev->spi);
+    _unlock(dev);
+
+    return 0;
+}
+
+#ifdef MODULE_MTD_SPI_NOR_ASYNC
+int mtd_spi_nor_erase_async(mtd_spi_nor_t *dev, uint32_t addr, uint32_t size,
+                            mtd_spi_nor_cb_t cb, void *arg)
+{
+    DEBUG("mtd_spi_nor_erase_async: %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
+          (void *)dev, addr, size);
+
+    int res = mtd_spi_check_erase(&dev->base, addr, size);
+    if (res < 0) {
+        return res;
+    }
+    if (size == 0) {
+        return -EOVERFLOW;
+    }
+
+    mutex_lock(&dev->lock);
+    if (dev->erase_req) {
+        mutex_unlock(&dev->lock);
+        return -EBUSY;
+    }
+    dev->erase_req = true;
+    dev->erase_addr = addr;
+    dev->erase_left = size;
+    dev->cb = cb;
+    dev->cb_arg = arg;
+    /* a pre-erase in progress completes first */
+    _start_next(dev);
+    mutex_unlock(&dev->lock);
 
     return 0;
 }
+
+int mtd_spi_nor_pre_erase(mtd_spi_nor_t *dev, uint32_t addr)
+{
+    const mtd_dev_t *mtd = &dev->base;
+    uint32_t sector_size = mtd->page_size * mtd->pages_per_sector;
+    uint32_t sector = addr / sector_size;
+    mtd_spi_nor_pre_erase_t *entry = NULL;
+
+    if ((addr % sector_size) || (sector >= mtd->sector_count)) {
+        return -EOVERFLOW;
+    }
+
+    mutex_lock(&dev->lock);
+    for (unsigned i = 0; i < MTD_SPI_NOR_PRE_ERASE_NUMOF; i++) {
+        mtd_spi_nor_pre_erase_t *cur = &dev->pre_erase[i];
+        if (cur->state == PRE_ERASE_UNUSED) {
+            if ((entry == NULL) || (entry->state != PRE_ERASE_UNUSED)) {
+                entry = cur;
+            }
+        }
+        else if (cur->sector == sector) {
+            mutex_unlock(&dev->lock);
+            return 0;
+        }
+        /* with no unused entry left, the oldest erased sector is given up */
+        else if ((cur->state == PRE_ERASE_DONE) &&
+                 ((entry == NULL) || ((entry->state == PRE_ERASE_DONE) &&
+                                      (cur->age > entry->age)))) {
+            entry = cur;
+        }
+    }
+    if (entry == NULL) {
+        mutex_unlock(&dev->lock);
+        return -ENOMEM;
+    }
+    entry->sector = sector;
+    entry->state = PRE_ERASE_QUEUED;
+    _start_next(dev);
+    mutex_unlock(&dev->lock);
+
+    return 0;
+}
+#endif
+
+#ifdef MODULE_PERIPH_SPI_ASYNC
+static void _read_async_done(spi_async_xfer_t *xfer, void *arg)
+{
+    mtd_spi_nor_t *dev = arg;
+    mtd_spi_nor_cb_t cb = dev->read_cb;
+    void *cb_arg = dev->read_cb_arg;
+    (void)xfer;
+
+#ifdef MODULE_MTD_SPI_NOR_ASYNC
+    /* erase commands were held back during the read */
+    mutex_unlock(&dev->lock);
+    event_post(&_queue, &dev->event.super);
+#endif
+    dev->read_busy = false;
+    if (cb) {
+        cb(cb_arg);
+    }
+}
+
+int mtd_spi_nor_read_async(mtd_spi_nor_t *dev, void *dest, uint32_t addr,
+                           uint32_t size, mtd_spi_nor_cb_t cb, void *arg)
+{
+    const mtd_dev_t *mtd = &dev->base;
+    uint32_t chipsize = mtd->page_size * mtd->pages_per_sector * mtd->sector_count;
+
+    DEBUG("mtd_spi_nor_read_async: %p, %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
+          (void *)dev, dest, addr, size);
+
+    if ((size == 0) || (addr >= chipsize) || (size > chipsize - addr)) {
+        return -EOVERFLOW;
+    }
+
+    unsigned state = irq_disable();
+    if (dev->read_busy) {
+        irq_restore(state);
+        return -EBUSY;
+    }
+    dev->read_busy = true;
+    irq_restore(state);
+
+#ifdef MODULE_MTD_SPI_NOR_ASYNC
+    /* held until the read is done, so no erase command gets in between */
+    if (!mutex_trylock(&dev->lock)) {
+        dev->read_busy = false;
+        return -EBUSY;
+    }
+    if (dev->busy != BUSY_NONE) {
+        mutex_unlock(&dev->lock);
+        dev->read_busy = false;
+        return -EBUSY;
+    }
+#endif
+
+    dev->read_cb = cb;
+    dev->read_cb_arg = arg;
+    mtd_spi_async_cmd_addr(dev, dev->read_xfer, dev->read_cmd,
+                           dev->opcode->read, byteorder_htonl(addr),
+                           NULL, dest, size);
+    dev->read_xfer[1].cb = _read_async_done;
+    dev->read_xfer[1].arg = dev;
+
+    int res = spi_async_submit(dev->spi, dev->read_xfer,
+                               ARRAY_SIZE(dev->read_xfer));
+    if (res < 0) {
+#ifdef MODULE_MTD_SPI_NOR_ASYNC
+        mutex_unlock(&dev->lock);
+#endif
+        dev->read_busy = false;
+    }
+    return res;
+}
+#endif
@@ -40,6 +40,8 @@ const mtd_spi_nor_opcode_t mtd_spi_nor_opcode_default = {
     .chip_erase      = 0xc7,
     .sleep           = 0xb9,
     .wake            = 0xab,
+    .suspend         = 0x75,
+    .resume          = 0x7a,
 };
 
 const mtd_spi_nor_opcode_t mtd_spi_nor_opcode_default_4bytes = {
@@ -56,6 +58,8 @@ const mtd_spi_nor_opcode_t mtd_spi_nor_opcode_default_4bytes = {
     .chip_erase      = 0xc7,
     .sleep           = 0xb9,
     .wake            = 0xab,
+    .suspend         = 0x75,
+    .resume          = 0x7a,
 };
 
 /** @} */
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_periph_async_queue
+ * @{
+ *
+ * @file
+ * @brief       Descriptor queue of the asynchronous bus interfaces
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "assert.h"
+#include "irq.h"
+#include "periph/async_queue.h"
+
+#ifdef MODULE_PERIPH_ASYNC_QUEUE
+
+/* must be called with interrupts disabled */
+static void _append(async_queue_t *q, async_queue_node_t *first,
+                    async_queue_node_t *last)
+{
+    if (q->head == NULL) {
+        q->head = first;
+    }
+    else {
+        q->tail->next = first;
+    }
+    q->tail = last;
+}
+
+/* removes the head of the queue and notifies its owner, returns true if
+ * there is another descriptor to start */
+static bool _complete(async_queue_t *q, const async_queue_ops_t *ops)
+{
+    unsigned state = irq_disable();
+    async_queue_node_t *node = q->head;
+    q->head = node->next;
+    if (q->head == NULL) {
+        q->tail = NULL;
+    }
+    irq_restore(state);
+
+    ops->done(q, node);
+
+    state = irq_disable();
+    if (q->head != NULL) {
+        irq_restore(state);
+        return true;
+    }
+    /* submitters now wait in ops->begin() until the bus is released */
+    q->active = false;
+    irq_restore(state);
+
+    ops->end(q);
+    return false;
+}
+
+static void _run(async_queue_t *q, const async_queue_ops_t *ops)
+{
+    do {
+        if (ops->start(q, q->head) == 0) {
+            /* continued by async_queue_isr_done() */
+            return;
+        }
+    } while (_complete(q, ops));
+}
+
+int async_queue_submit(async_queue_t *q, const async_queue_ops_t *ops,
+                       async_queue_node_t *first, async_queue_node_t *last)
+{
+    assert((q != NULL) && (ops != NULL) && (first != NULL) && (last != NULL));
+
+    last->next = NULL;
+
+    unsigned state = irq_disable();
+    if (q->active) {
+        _append(q, first, last);
+        irq_restore(state);
+        return 0;
+    }
+    if (irq_is_in()) {
+        irq_restore(state);
+        return -EAGAIN;
+    }
+    q->active = true;
+    _append(q, first, last);
+    irq_restore(state);
+
+    ops->begin(q, first);
+    _run(q, ops);
+    return 0;
+}
+
+void async_queue_isr_done(async_queue_t *q, const async_queue_ops_t *ops)
+{
+    if (_complete(q, ops)) {
+        _run(q, ops);
+    }
+}
+
+#endif /* MODULE_PERIPH_ASYNC_QUEUE */
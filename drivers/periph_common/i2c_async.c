@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_periph_i2c_async
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous I2C transactions on top of the bus queue
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include "assert.h"
+#include "irq.h"
+#include "kernel_defines.h"
+#include "mutex.h"
+#include "periph/i2c_async.h"
+
+#ifdef MODULE_PERIPH_I2C_ASYNC
+
+static async_queue_t _queues[I2C_NUMOF];
+
+static inline i2c_t _dev(async_queue_t *q)
+{
+    return (i2c_t)(q - _queues);
+}
+
+static inline i2c_async_xfer_t *_xfer(async_queue_node_t *node)
+{
+    return container_of(node, i2c_async_xfer_t, node);
+}
+
+static void _begin(async_queue_t *q, async_queue_node_t *first)
+{
+    i2c_t dev = _dev(q);
+
+    (void)first;
+    i2c_acquire(dev);
+    i2c_async_hw_begin(dev);
+}
+
+static int _start(async_queue_t *q, async_queue_node_t *node)
+{
+    return i2c_async_hw_start(_dev(q), _xfer(node));
+}
+
+static void _done(async_queue_t *q, async_queue_node_t *node)
+{
+    i2c_async_xfer_t *xfer = _xfer(node);
+
+    (void)q;
+    if (xfer->cb) {
+        xfer->cb(xfer, xfer->arg);
+    }
+}
+
+static void _end(async_queue_t *q)
+{
+    i2c_t dev = _dev(q);
+
+    i2c_async_hw_end(dev);
+    i2c_release(dev);
+}
+
+static const async_queue_ops_t _ops = {
+    .begin = _begin,
+    .start = _start,
+    .done = _done,
+    .end = _end,
+};
+
+int i2c_async_submit(i2c_t dev, i2c_async_xfer_t *xfer, unsigned numof)
+{
+    assert((dev < I2C_NUMOF) && (xfer != NULL) && (numof > 0));
+
+    for (unsigned i = 0; i < numof; i++) {
+        assert(xfer[i].len < 255);
+        xfer[i].node.next = &xfer[i + 1].node;
+        xfer[i].res = 0;
+    }
+    return async_queue_submit(&_queues[dev], &_ops, &xfer->node,
+                              &xfer[numof - 1].node);
+}
+
+static void _unlock(i2c_async_xfer_t *xfer, void *arg)
+{
+    (void)xfer;
+    mutex_unlock(arg);
+}
+
+int i2c_async_transfer(i2c_t dev, i2c_async_xfer_t *xfer, unsigned numof)
+{
+    mutex_t done = MUTEX_INIT_LOCKED;
+
+    assert(!irq_is_in());
+
+    xfer[numof - 1].cb = _unlock;
+    xfer[numof - 1].arg = &done;
+    i2c_async_submit(dev, xfer, numof);
+    mutex_lock(&done);
+
+    for (unsigned i = 0; i < numof; i++) {
+        if (xfer[i].res < 0) {
+            return xfer[i].res;
+        }
+    }
+    return 0;
+}
+
+bool i2c_async_busy(i2c_t dev)
+{
+    assert(dev < I2C_NUMOF);
+
+    return async_queue_busy(&_queues[dev]);
+}
+
+void i2c_async_isr_done(i2c_t dev)
+{
+    async_queue_isr_done(&_queues[dev], &_ops);
+}
+
+#ifdef MODULE_PERIPH_I2C
+void i2c_async_poll(i2c_t dev, i2c_async_xfer_t *xfer)
+{
+    uint8_t flags = xfer->flags & I2C_REG16;
+
+    if (xfer->flags & I2C_ASYNC_NOREG) {
+        xfer->res = xfer->read
+                    ? i2c_read_bytes(dev, xfer->addr, xfer->data, xfer->len, 0)
+                    : i2c_write_bytes(dev, xfer->addr, xfer->data, xfer->len, 0);
+    }
+    else {
+        xfer->res = xfer->read
+                    ? i2c_read_regs(dev, xfer->addr, xfer->reg, xfer->data,
+                                    xfer->len, flags)
+                    : i2c_write_regs(dev, xfer->addr, xfer->reg, xfer->data,
+                                     xfer->len, flags);
+    }
+}
+#endif /* MODULE_PERIPH_I2C */
+
+#endif /* MODULE_PERIPH_I2C_ASYNC */
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_periph_spi_async
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous SPI transfers on top of the bus queue
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include "assert.h"
+#include "irq.h"
+#include "kernel_defines.h"
+#include "mutex.h"
+#include "periph/spi_async.h"
+
+#ifdef MODULE_PERIPH_SPI_ASYNC
+
+static async_queue_t _queues[SPI_NUMOF];
+/* the previous transfer kept the device selected */
+static bool _cs_active[SPI_NUMOF];
+
+static inline spi_t _bus(async_queue_t *q)
+{
+    return (spi_t)(q - _queues);
+}
+
+static inline spi_async_xfer_t *_xfer(async_queue_node_t *node)
+{
+    return container_of(node, spi_async_xfer_t, node);
+}
+
+static void _begin(async_queue_t *q, async_queue_node_t *first)
+{
+    spi_t bus = _bus(q);
+    spi_async_xfer_t *xfer = _xfer(first);
+
+    _cs_active[bus] = false;
+    spi_acquire(bus, xfer->cs, xfer->mode, xfer->clk);
+    spi_async_hw_begin(bus);
+}
+
+static int _start(async_queue_t *q, async_queue_node_t *node)
+{
+    spi_t bus = _bus(q);
+
+    return spi_async_hw_start(bus, _xfer(node), _cs_active[bus]);
+}
+
+static void _done(async_queue_t *q, async_queue_node_t *node)
+{
+    spi_async_xfer_t *xfer = _xfer(node);
+
+    _cs_active[_bus(q)] = xfer->cont;
+    if (xfer->cb) {
+        xfer->cb(xfer, xfer->arg);
+    }
+}
+
+static void _end(async_queue_t *q)
+{
+    spi_t bus = _bus(q);
+
+    spi_async_hw_end(bus);
+    spi_release(bus);
+}
+
+static const async_queue_ops_t _ops = {
+    .begin = _begin,
+    .start = _start,
+    .done = _done,
+    .end = _end,
+};
+
+int spi_async_submit(spi_t bus, spi_async_xfer_t *xfer, unsigned numof)
+{
+    assert((bus < SPI_NUMOF) && (xfer != NULL) && (numof > 0));
+    assert(!xfer[numof - 1].cont);
+
+    for (unsigned i = 0; i < (numof - 1); i++) {
+        xfer[i].node.next = &xfer[i + 1].node;
+    }
+    return async_queue_submit(&_queues[bus], &_ops, &xfer->node,
+                              &xfer[numof - 1].node);
+}
+
+static void _unlock(spi_async_xfer_t *xfer, void *arg)
+{
+    (void)xfer;
+    mutex_unlock(arg);
+}
+
+void spi_async_transfer(spi_t bus, spi_async_xfer_t *xfer, unsigned numof)
+{
+    mutex_t done = MUTEX_INIT_LOCKED;
+
+    assert(!irq_is_in());
+
+    xfer[numof - 1].cb = _unlock;
+    xfer[numof - 1].arg = &done;
+    spi_async_submit(bus, xfer, numof);
+    mutex_lock(&done);
+}
+
+bool spi_async_busy(spi_t bus)
+{
+    assert(bus < SPI_NUMOF);
+
+    return async_queue_busy(&_queues[bus]);
+}
+
+void spi_async_isr_done(spi_t bus)
+{
+    async_queue_isr_done(&_queues[bus], &_ops);
+}
+
+#endif /* MODULE_PERIPH_SPI_ASYNC */
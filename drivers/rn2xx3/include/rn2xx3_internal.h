@@ -82,6 +82,9 @@ int rn2xx3_cmd_finalize(rn2xx3_t *dev);
 /**
  * @brief   Finalize the TX command
  *
+ * On success, the second replies that are only expected after the TX command
+ * are dispatched until rn2xx3_mac_tx_reply_done() is called.
+ *
  * @param[in] dev          The device descriptor
  *
  * @return                 RN2XX3_OK if the command succeeded
@@ -89,6 +92,13 @@ int rn2xx3_cmd_finalize(rn2xx3_t *dev);
  */
 int rn2xx3_mac_tx_finalize(rn2xx3_t *dev);
 
+/**
+ * @brief   Stop dispatching the second replies of the TX command
+ *
+ * @param[in] dev          The device descriptor
+ */
+void rn2xx3_mac_tx_reply_done(rn2xx3_t *dev);
+
 /**
  * @brief   Process a command immediate response
  *
@@ -40,90 +40,55 @@
  */
 #define RESET_DELAY                 (10UL * US_PER_MS)
 
+static const char *_replies[RN2XX3_URC_NUMOF] = {
+    "mac_rx", "mac_tx_ok", "mac_err", "accepted", "denied",
+};
+
+/* also immediate responses of other commands */
+static const char *_tx_replies[RN2XX3_TX_URC_NUMOF] = {
+    "invalid_data_len",
+};
+
 /*
- * Interrupt callbacks
+ * AT engine callbacks
  */
-static void _rx_cb(void *arg, uint8_t c)
+static void _reply_cb(void *arg, const char *code)
 {
     rn2xx3_t *dev = (rn2xx3_t *)arg;
     netdev_t *netdev = (netdev_t *)dev;
-
-    /* Avoid overflow of module response buffer */
-    if (dev->resp_size >= RN2XX3_MAX_BUF) {
-        return;
-    }
-
-    /* The device closes the response with \r\n when done */
-    if (c == '\r') {
-        return;
-    }
-    else if (c == '\n') { /* response end delimiter */
-        dev->resp_buf[dev->resp_size++] = '\0';
-        if (dev->int_state == RN2XX3_INT_STATE_MAC_RX_MESSAGE) {
-            /* RX state: closing RX buffer */
-            dev->rx_buf[(dev->rx_size + 1) / 2] = 0;
-            if (netdev->event_callback) {
-                netdev->event_callback(netdev, NETDEV_EVENT_ISR);
+    size_t len = strlen(code);
+
+    dev->rx_size = 0;
+    if (strncmp(code, "mac_rx ", 7) == 0) {
+        /* "mac_rx <port> <data>": keep port in the response, convert the
+         * data received in hex chars */
+        const char *data = strchr(code + 7, ' ');
+        if (data) {
+            data++;
+            len = data - code;
+            size_t data_len = strlen(data);
+            if ((data_len % 2) || (data_len / 2 >= RN2XX3_RX_MAX_BUF)) {
+                DEBUG("[rn2xx3] invalid RX data\n");
             }
-        }
-        else if (dev->int_state == RN2XX3_INT_STATE_MAC_TX) {
-            /* still in TX state: transmission complete but no data received */
-            if (netdev->event_callback) {
-                netdev->event_callback(netdev, NETDEV_EVENT_ISR);
+            else {
+                rn2xx3_hex_to_bytes(data, dev->rx_buf);
+                dev->rx_size = data_len / 2;
             }
         }
-        dev->resp_size = 0;
-        dev->rx_size = 0;
-        dev->resp_done = 1;
-        mutex_unlock(&(dev->resp_lock));
     }
-    else {
-        switch (dev->int_state) {
-            /* A successful mac TX command expects 2 kinds of replies:
-                 * - mac_tx_ok: transmission done, no data received
-                 * - mac_rx <port> <data>: transmission done, some data
-                 *                         received on port <port>. */
-            case RN2XX3_INT_STATE_MAC_TX:
-                /* some data are available */
-                dev->resp_buf[dev->resp_size++] = c;
-                /* if module response ends with 'rx ' after 8 received chars,
-                   the module starts receiving data */
-                if (dev->resp_size == 8 && dev->resp_buf[4] == 'r'
-                    && dev->resp_buf[5] == 'x' && dev->resp_buf[6] == ' ') {
-                    /* next received chars correspond to the port number */
-                    dev->int_state = RN2XX3_INT_STATE_MAC_RX_PORT;
-                }
-                break;
-
-            case RN2XX3_INT_STATE_MAC_RX_PORT:
-                dev->resp_buf[dev->resp_size++] = c;
-                if (c == ' ') {
-                    dev->int_state = RN2XX3_INT_STATE_MAC_RX_MESSAGE;
-                }
-                break;
-
-            case RN2XX3_INT_STATE_MAC_RX_MESSAGE:
-                /* read and convert RX data (received in hex chars) */
-                if (c == ' ') {
-                    dev->resp_buf[dev->resp_size++] = c;
-                    break;
-                }
-                dev->rx_tmp_buf[dev->rx_size % 2] = c;
-
-                /* We convert pairs of hex character to bytes on the fly to
-                   save space in memory */
-                if (dev->rx_size != 0 && dev->rx_size % 2) {
-                    rn2xx3_hex_to_bytes(dev->rx_tmp_buf,
-                                        &dev->rx_buf[(dev->rx_size - 1) / 2]);
-                }
-                dev->rx_size++;
-                break;
-
-            default:
-                dev->resp_buf[dev->resp_size++] = c;
-                break;
-        }
+    dev->rx_buf[dev->rx_size] = 0;
+
+    if (len >= sizeof(dev->resp_buf)) {
+        len = sizeof(dev->resp_buf) - 1;
+    }
+    memcpy(dev->resp_buf, code, len);
+    dev->resp_buf[len] = '\0';
+
+    if ((dev->int_state == RN2XX3_INT_STATE_MAC_TX) && netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV_EVENT_ISR);
     }
+    dev->resp_done = 1;
+    mutex_unlock(&(dev->resp_lock));
 }
 
 static void _sleep_timer_cb(void *arg)
@@ -156,13 +121,32 @@ int rn2xx3_init(rn2xx3_t *dev)
     rn2xx3_set_internal_state(dev, RN2XX3_INT_STATE_RESET);
 
     /* initialize buffers and locks*/
-    dev->resp_size = 0;
     dev->cmd_buf[0] = 0;
 
-    /* initialize UART and GPIO pins */
-    if (uart_init(dev->p.uart, dev->p.baudrate, _rx_cb, dev) != UART_OK) {
-        DEBUG("[rn2xx3] init: error initializing UART\n");
-        return -ENXIO;
+    /* initialize UART and the AT engine, which keeps running over
+     * re-initializations */
+    if (dev->at_dev.pid == KERNEL_PID_UNDEF) {
+        if (at_dev_init(&dev->at_dev, dev->p.uart, dev->p.baudrate,
+                        dev->uart_buf, sizeof(dev->uart_buf)) != UART_OK) {
+            DEBUG("[rn2xx3] init: error initializing UART\n");
+            return -ENXIO;
+        }
+        for (unsigned i = 0; i < RN2XX3_URC_NUMOF; i++) {
+            dev->urc[i].cb = _reply_cb;
+            dev->urc[i].code = _replies[i];
+            dev->urc[i].arg = dev;
+            at_add_urc(&dev->at_dev, &dev->urc[i]);
+        }
+        /* registered by rn2xx3_mac_tx_finalize() */
+        for (unsigned i = 0; i < RN2XX3_TX_URC_NUMOF; i++) {
+            dev->tx_urc[i].cb = _reply_cb;
+            dev->tx_urc[i].code = _tx_replies[i];
+            dev->tx_urc[i].arg = dev;
+        }
+        if (at_async_start(&dev->at_dev) < 0) {
+            DEBUG("[rn2xx3] init: error starting AT engine\n");
+            return -ENOMEM;
+        }
     }
 
     /* if reset pin is connected, do a hardware reset */
@@ -272,6 +256,7 @@ int rn2xx3_mac_tx(rn2xx3_t *dev, uint8_t *payload, uint8_t payload_len)
     }
 
     ret = rn2xx3_wait_reply(dev, RN2XX3_REPLY_DELAY_TIMEOUT);
+    rn2xx3_mac_tx_reply_done(dev);
     rn2xx3_set_internal_state(dev, RN2XX3_INT_STATE_IDLE);
 
     return ret;
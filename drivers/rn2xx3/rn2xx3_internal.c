@@ -31,6 +31,11 @@
 
 static const char *closing_seq = "\r\n";
 
+typedef struct {
+    mutex_t lock;
+    int res;
+} _cmd_done_t;
+
 static void _uart_write_str(rn2xx3_t *dev, const char *str)
 {
     size_t len = strlen(str);
@@ -39,6 +44,49 @@ static void _uart_write_str(rn2xx3_t *dev, const char *str)
     }
 }
 
+static void _cmd_done(void *arg, int res)
+{
+    _cmd_done_t *done = (_cmd_done_t *)arg;
+    done->res = res;
+    mutex_unlock(&done->lock);
+}
+
+/* queues a command answered by one line, a command written by the caller
+ * between at_acquire() and at_release() is flagged with AT_CMD_F_NOSEND */
+static int _run_cmd(rn2xx3_t *dev, uint8_t flags)
+{
+    _cmd_done_t done = { .lock = MUTEX_INIT_LOCKED };
+    at_cmd_t cmd = {
+        .cmd = dev->cmd_buf,
+        .resp = dev->resp_buf,
+        .resp_len = sizeof(dev->resp_buf),
+        .timeout = RESP_TIMEOUT_SEC * US_PER_SEC,
+        .cb = _cmd_done,
+        .arg = &done,
+        .flags = AT_CMD_F_LINE | AT_CMD_F_CRLF | flags,
+    };
+
+    dev->resp_buf[0] = 0;
+    at_cmd_submit(&dev->at_dev, &cmd);
+    if (flags & AT_CMD_F_NOSEND) {
+        at_release(&dev->at_dev);
+    }
+    mutex_lock(&done.lock);
+
+    if (done.res < 0) {
+        DEBUG("[rn2xx3] response timeout\n");
+        return RN2XX3_TIMEOUT;
+    }
+    /* strip the end of line */
+    if (done.res > 0) {
+        dev->resp_buf[done.res - 1] = 0;
+    }
+
+    DEBUG("[rn2xx3] RESP: %s\n", dev->resp_buf);
+
+    return RN2XX3_OK;
+}
+
 static void isr_resp_timeout(void *arg)
 {
     rn2xx3_t *dev = (rn2xx3_t *)arg;
@@ -48,12 +96,11 @@ static void isr_resp_timeout(void *arg)
 static bool _wait_reply(rn2xx3_t *dev, uint8_t timeout)
 {
     dev->resp_done = 0;
-    dev->resp_size = 0;
     dev->resp_buf[0] = 0;
 
     xtimer_ticks64_t sent_time = xtimer_now64();
 
-    xtimer_t resp_timer;
+    xtimer_t resp_timer = { 0 };
     resp_timer.callback = isr_resp_timeout;
     resp_timer.arg = dev;
 
@@ -157,10 +204,7 @@ int rn2xx3_write_cmd(rn2xx3_t *dev)
     rn2xx3_set_internal_state(dev, RN2XX3_INT_STATE_CMD);
 
     mutex_lock(&(dev->cmd_lock));
-    _uart_write_str(dev, dev->cmd_buf);
-    _uart_write_str(dev, closing_seq);
-
-    ret = rn2xx3_wait_response(dev);
+    ret = _run_cmd(dev, 0);
     if (ret == RN2XX3_TIMEOUT) {
         mutex_unlock(&(dev->cmd_lock));
         return RN2XX3_TIMEOUT;
@@ -186,8 +230,12 @@ int rn2xx3_write_cmd_no_wait(rn2xx3_t *dev)
     }
 
     mutex_lock(&(dev->cmd_lock));
+    /* the response is sent by the device later, it is dropped by the AT
+     * engine */
+    at_acquire(&dev->at_dev);
     _uart_write_str(dev, dev->cmd_buf);
     _uart_write_str(dev, closing_seq);
+    at_release(&dev->at_dev);
 
     DEBUG("[rn2xx3] RET: %s\n", dev->resp_buf);
 
@@ -198,13 +246,9 @@ int rn2xx3_write_cmd_no_wait(rn2xx3_t *dev)
 
 int rn2xx3_wait_response(rn2xx3_t *dev)
 {
-    if (_wait_reply(dev, RESP_TIMEOUT_SEC)) {
-        return RN2XX3_TIMEOUT;
-    }
-
-    DEBUG("[rn2xx3] RESP: %s\n", dev->resp_buf);
-
-    return RN2XX3_OK;
+    /* the AT engine takes the next line as response */
+    at_acquire(&dev->at_dev);
+    return _run_cmd(dev, AT_CMD_F_NOSEND);
 }
 
 int rn2xx3_wait_reply(rn2xx3_t *dev, uint8_t timeout)
@@ -223,6 +267,7 @@ void rn2xx3_cmd_start(rn2xx3_t *dev)
     rn2xx3_set_internal_state(dev, RN2XX3_INT_STATE_CMD);
     DEBUG("[rn2xx3] CMD: %s", dev->cmd_buf);
     mutex_lock(&(dev->cmd_lock));
+    at_acquire(&dev->at_dev);
     _uart_write_str(dev, dev->cmd_buf);
 }
 
@@ -265,7 +310,22 @@ int rn2xx3_mac_tx_finalize(rn2xx3_t *dev)
 
     rn2xx3_set_internal_state(dev, RN2XX3_INT_STATE_MAC_TX);
 
-    return rn2xx3_process_response(dev);
+    int ret = rn2xx3_process_response(dev);
+    if (ret == RN2XX3_OK) {
+        /* no command is pending until the second reply, so these are not
+         * taken for the response of a command */
+        for (unsigned i = 0; i < RN2XX3_TX_URC_NUMOF; i++) {
+            at_add_urc(&dev->at_dev, &dev->tx_urc[i]);
+        }
+    }
+    return ret;
+}
+
+void rn2xx3_mac_tx_reply_done(rn2xx3_t *dev)
+{
+    for (unsigned i = 0; i < RN2XX3_TX_URC_NUMOF; i++) {
+        at_remove_urc(&dev->at_dev, &dev->tx_urc[i]);
+    }
 }
 
 int rn2xx3_process_response(rn2xx3_t *dev)
@@ -97,8 +97,13 @@ extern "C" {
 #define SD_CMD_17 17 /* Reads a block of the size selected by the SET_BLOCKLEN command */
 #define SD_CMD_18 18 /* Continuously transfers data blocks from card to host
                         until interrupted by a STOP_TRANSMISSION command */
+#define SD_CMD_23 23 /* Sent as ACMD23 sets the number of blocks to be pre-erased before
+                        writing */
 #define SD_CMD_24 24 /* Writes a block of the size selected by the SET_BLOCKLEN command */
 #define SD_CMD_25 25 /* Continuously writes blocks of data until 'Stop Tran'token is sent */
+#define SD_CMD_32 32 /* Sets the address of the first block to be erased */
+#define SD_CMD_33 33 /* Sets the address of the last block of the range to be erased */
+#define SD_CMD_38 38 /* Erases all previously selected blocks */
 #define SD_CMD_41 41 /* Reserved (used for ACMD41) */
 #define SD_CMD_55 55 /* Defines to the card that the next commmand is an application specific
                         command rather than a standard command */
@@ -111,6 +116,7 @@ extern "C" {
 #define SD_ACMD_41_ARG_HC 0x40000000
 #define SD_CMD_59_ARG_EN  0x00000001
 #define SD_CMD_59_ARG_DIS 0x00000000
+#define SD_ACMD_23_MAX_BLOCKS 0x007FFFFF /* ACMD23 block count has 23 bits */
 
 /* see sd spec. 7.3.3 Control Tokens */
 #define SD_DATA_TOKEN_CMD_17_18_24 0xFE
@@ -135,6 +141,7 @@ extern "C" {
 #define SD_WAIT_FOR_NOT_BUSY_CNT   1000000 /* use -1 for full blocking till the card isn't busy */
 #define SD_BLOCK_READ_CMD_RETRIES  10     /* only affects sending of cmd not whole transaction! */
 #define SD_BLOCK_WRITE_CMD_RETRIES 10    /* only affects sending of cmd not whole transaction! */
+#define SD_ERASE_WAIT_FOR_NOT_BUSY_CNT -1 /* erasing large ranges may take seconds */
 
 /* memory capacity in bytes = (C_SIZE+1) * SD_CSD_V2_C_SIZE_BLOCK_MULT * BLOCK_LEN */
 #define SD_CSD_V2_C_SIZE_BLOCK_MULT 1024
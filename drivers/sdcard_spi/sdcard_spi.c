@@ -18,6 +18,7 @@
  * @}
  */
 #define ENABLE_DEBUG (0)
+#include "assert.h"
 #include "debug.h"
 #include "sdcard_spi_internal.h"
 #include "sdcard_spi.h"
@@ -64,6 +65,7 @@ int sdcard_spi_init(sdcard_spi_t *card, const sdcard_spi_params_t *params)
     sd_init_fsm_state_t state = SD_INIT_START;
     card->params = *params;
     card->spi_clk = SD_CARD_SPI_SPEED_PREINIT;
+    card->stream_cmd = 0;
 
     do {
         state = _init_sd_fsm_step(card, state);
@@ -567,6 +569,17 @@ static inline int _transfer_bytes(sdcard_spi_t *card, const uint8_t *out, uint8_
     unsigned trans_bytes = 0;
     uint8_t in_temp;
 
+    if ((_dyn_spi_rxtx_byte == &_hw_spi_rxtx_byte) && ((out != NULL) || (in != NULL))) {
+        /* transfer the whole buffer at once, the card expects dummy bytes
+           while it sends, so they are sent from the receive buffer */
+        if (out == NULL) {
+            memset(in, SD_CARD_DUMMY_BYTE, length);
+            out = in;
+        }
+        spi_transfer_bytes(card->params.spi_dev, GPIO_UNDEF, true, out, in, length);
+        return length;
+    }
+
     for (trans_bytes = 0; trans_bytes < length; trans_bytes++) {
         if (out != NULL) {
             trans_ret = _dyn_spi_rxtx_byte(card, out[trans_bytes], &in_temp);
@@ -626,53 +639,65 @@ static sd_rw_response_t _read_data_packet(sdcard_spi_t *card, uint8_t token, uin
     return SD_RW_RX_TX_ERROR;
 }
 
+static sd_rw_response_t _send_rw_cmd(sdcard_spi_t *card, uint8_t cmd_idx, int bladdr,
+                                     int32_t max_retry)
+{
+    uint32_t addr = card->use_block_addr ? bladdr : (bladdr * SD_HC_BLOCK_SIZE);
+    uint8_t cmd_r1_resu = sdcard_spi_send_cmd(card, cmd_idx, addr, max_retry);
+
+    if (R1_VALID(cmd_r1_resu) && !R1_ERROR(cmd_r1_resu)) {
+        DEBUG("_send_rw_cmd: send CMD%d: [OK]\n", cmd_idx);
+        return SD_RW_OK;
+    }
+
+    DEBUG("_send_rw_cmd: send CMD%d: [RX_TX_ERROR]\n", cmd_idx);
+    return SD_RW_RX_TX_ERROR;
+}
+
+static sd_rw_response_t _read_stream_stop(sdcard_spi_t *card)
+{
+    uint8_t cmd_r1_resu = sdcard_spi_send_cmd(card, SD_CMD_12, 0, 1);
+
+    if (R1_VALID(cmd_r1_resu) && !R1_ERROR(cmd_r1_resu)) {
+        return SD_RW_OK;
+    }
+
+    DEBUG("_read_stream_stop: send CMD12: [RX_TX_ERROR]\n");
+    return SD_RW_RX_TX_ERROR;
+}
+
 static inline int _read_blocks(sdcard_spi_t *card, int cmd_idx, int bladdr, uint8_t *data, int blsz,
                                int nbl, sd_rw_response_t *state)
 {
     _select_card_spi(card);
     int reads = 0;
 
-    uint32_t addr = card->use_block_addr ? bladdr : (bladdr * SD_HC_BLOCK_SIZE);
-    uint8_t cmd_r1_resu = sdcard_spi_send_cmd(card, cmd_idx, addr, SD_BLOCK_READ_CMD_RETRIES);
-
-    if (R1_VALID(cmd_r1_resu) && !R1_ERROR(cmd_r1_resu)) {
-        DEBUG("_read_blocks: send CMD%d: [OK]\n", cmd_idx);
+    *state = _send_rw_cmd(card, cmd_idx, bladdr, SD_BLOCK_READ_CMD_RETRIES);
 
+    if (*state == SD_RW_OK) {
         for (int i = 0; i < nbl; i++) {
             *state = _read_data_packet(card, SD_DATA_TOKEN_CMD_17_18_24, &(data[i * blsz]), blsz);
 
             if (*state != SD_RW_OK) {
                 DEBUG("_read_blocks: _read_data_packet: [FAILED]\n");
-                _unselect_card_spi(card);
-                return reads;
-            }
-            else {
-                reads++;
+                break;
             }
+            reads++;
         }
 
-        /* if this was a multi-block read */
+        /* if this was a multi-block read the card keeps sending until it is
+           stopped, also after a failed block */
         if (cmd_idx == SD_CMD_18) {
-            cmd_r1_resu = sdcard_spi_send_cmd(card, SD_CMD_12, 0, 1);
-
-            if (R1_VALID(cmd_r1_resu) && !R1_ERROR(cmd_r1_resu)) {
-                DEBUG("_read_blocks: read multi (%d) blocks [OK]\n", nbl);
-                *state = SD_RW_OK;
-            }
-            else {
-                DEBUG("_read_blocks: send CMD12: [RX_TX_ERROR]\n");
-                *state =  SD_RW_RX_TX_ERROR;
+            sd_rw_response_t stop_resu = _read_stream_stop(card);
+            if (*state == SD_RW_OK) {
+                *state = stop_resu;
             }
+            DEBUG("_read_blocks: read multi (%d/%d) blocks\n", reads, nbl);
         }
         else {
-            DEBUG("_read_blocks: read single block [OK]\n");
-            *state = SD_RW_OK;
+            DEBUG("_read_blocks: read single block\n");
         }
     }
-    else {
-        DEBUG("_read_blocks: send CMD%d: [RX_TX_ERROR]\n", cmd_idx);
-        *state = SD_RW_RX_TX_ERROR;
-    }
 
     _unselect_card_spi(card);
     return reads;
@@ -689,6 +714,46 @@ int sdcard_spi_read_blocks(sdcard_spi_t *card, int blockaddr, uint8_t *data, int
     }
 }
 
+sd_rw_response_t sdcard_spi_read_stream_start(sdcard_spi_t *card, int blockaddr)
+{
+    assert(card->stream_cmd == 0);
+
+    _select_card_spi(card);
+    sd_rw_response_t state = _send_rw_cmd(card, SD_CMD_18, blockaddr,
+                                          SD_BLOCK_READ_CMD_RETRIES);
+    if (state != SD_RW_OK) {
+        _unselect_card_spi(card);
+        return state;
+    }
+
+    card->stream_cmd = SD_CMD_18;
+    return SD_RW_OK;
+}
+
+sd_rw_response_t sdcard_spi_read_stream_block(sdcard_spi_t *card, uint8_t *data)
+{
+    assert(card->stream_cmd == SD_CMD_18);
+
+    sd_rw_response_t state = _read_data_packet(card, SD_DATA_TOKEN_CMD_17_18_24, data,
+                                               SD_HC_BLOCK_SIZE);
+    if (state != SD_RW_OK) {
+        sdcard_spi_read_stream_stop(card);
+    }
+    return state;
+}
+
+sd_rw_response_t sdcard_spi_read_stream_stop(sdcard_spi_t *card)
+{
+    if (card->stream_cmd != SD_CMD_18) {
+        return SD_RW_OK;
+    }
+
+    sd_rw_response_t state = _read_stream_stop(card);
+    _unselect_card_spi(card);
+    card->stream_cmd = 0;
+    return state;
+}
+
 static sd_rw_response_t _write_data_packet(sdcard_spi_t *card, uint8_t token, const uint8_t *data, int size)
 {
 
@@ -742,72 +807,95 @@ static sd_rw_response_t _write_data_packet(sdcard_spi_t *card, uint8_t token, co
     }
 }
 
+static sd_rw_response_t _write_block(sdcard_spi_t *card, uint8_t token, const uint8_t *data,
+                                     int blsz)
+{
+    sd_rw_response_t write_resu = _write_data_packet(card, token, data, blsz);
+
+    if (write_resu != SD_RW_OK) {
+        DEBUG("_write_block: _write_data_packet: [FAILED]\n");
+        return write_resu;
+    }
+    if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
+        DEBUG("_write_block: _wait_for_not_busy: [FAILED]\n");
+        return SD_RW_TIMEOUT;
+    }
+    return SD_RW_OK;
+}
+
+static sd_rw_response_t _write_stream_start(sdcard_spi_t *card, int bladdr, int nbl)
+{
+    if (nbl > 0) {
+        /* ACMD23 lets the card erase the blocks to be written in advance.
+           It is only a hint, so the write is started even if it fails */
+        if (nbl > SD_ACMD_23_MAX_BLOCKS) {
+            nbl = SD_ACMD_23_MAX_BLOCKS;
+        }
+        uint8_t r1_resu = sdcard_spi_send_acmd(card, SD_CMD_23, nbl, 0);
+        if (!R1_VALID(r1_resu) || R1_ERROR(r1_resu)) {
+            DEBUG("_write_stream_start: send ACMD23: [FAILED]\n");
+        }
+    }
+
+    return _send_rw_cmd(card, SD_CMD_25, bladdr, SD_BLOCK_WRITE_CMD_RETRIES);
+}
+
+static sd_rw_response_t _write_stream_stop(sdcard_spi_t *card)
+{
+    spi_transfer_byte(card->params.spi_dev, GPIO_UNDEF, true,
+                      SD_DATA_TOKEN_CMD_25_STOP);
+
+    /* sd card needs dummy byte before we can wait for not-busy
+       state */
+    _send_dummy_byte(card);
+    if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
+        DEBUG("_write_stream_stop: _wait_for_not_busy: [FAILED]\n");
+        return SD_RW_TIMEOUT;
+    }
+    return SD_RW_OK;
+}
+
 static inline int _write_blocks(sdcard_spi_t *card, uint8_t cmd_idx, int bladdr, const uint8_t *data, int blsz,
                                 int nbl, sd_rw_response_t *state)
 {
     _select_card_spi(card);
     int written = 0;
+    int token;
 
-    uint32_t addr = card->use_block_addr ? bladdr : (bladdr * SD_HC_BLOCK_SIZE);
-    uint8_t cmd_r1_resu = sdcard_spi_send_cmd(card, cmd_idx, addr, SD_BLOCK_WRITE_CMD_RETRIES);
-
-    if (R1_VALID(cmd_r1_resu) && !R1_ERROR(cmd_r1_resu)) {
-        DEBUG("_write_blocks: send CMD%d: [OK]\n", cmd_idx);
-
-        int token;
-        if (cmd_idx == SD_CMD_25) {
-            token = SD_DATA_TOKEN_CMD_25;
-        }
-        else {
-            token = SD_DATA_TOKEN_CMD_17_18_24;
-        }
+    if (cmd_idx == SD_CMD_25) {
+        *state = _write_stream_start(card, bladdr, nbl);
+        token = SD_DATA_TOKEN_CMD_25;
+    }
+    else {
+        *state = _send_rw_cmd(card, cmd_idx, bladdr, SD_BLOCK_WRITE_CMD_RETRIES);
+        token = SD_DATA_TOKEN_CMD_17_18_24;
+    }
 
+    if (*state == SD_RW_OK) {
         for (int i = 0; i < nbl; i++) {
-            sd_rw_response_t write_resu = _write_data_packet(card, token, &(data[i * blsz]), blsz);
-            if (write_resu != SD_RW_OK) {
-                DEBUG("_write_blocks: _write_data_packet: [FAILED]\n");
-                _unselect_card_spi(card);
-                *state = write_resu;
-                return written;
-            }
-            if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
-                DEBUG("_write_blocks: _wait_for_not_busy: [FAILED]\n");
-                _unselect_card_spi(card);
-                *state = SD_RW_TIMEOUT;
-                return written;
+            *state = _write_block(card, token, &(data[i * blsz]), blsz);
+            if (*state != SD_RW_OK) {
+                break;
             }
             written++;
         }
 
         /* if this is a multi-block write it is needed to issue a stop
-           command */
+           command, also after a failed block */
         if (cmd_idx == SD_CMD_25) {
-            spi_transfer_byte(card->params.spi_dev, GPIO_UNDEF, true,
-                              SD_DATA_TOKEN_CMD_25_STOP);
-            DEBUG("_write_blocks: write multi (%d) blocks: [OK]\n", nbl);
-
-            /* sd card needs dummy byte before we can wait for not-busy
-               state */
-            _send_dummy_byte(card);
-            if (!_wait_for_not_busy(card, SD_WAIT_FOR_NOT_BUSY_CNT)) {
-                _unselect_card_spi(card);
-                *state = SD_RW_TIMEOUT;
+            sd_rw_response_t stop_resu = _write_stream_stop(card);
+            if (*state == SD_RW_OK) {
+                *state = stop_resu;
             }
+            DEBUG("_write_blocks: write multi (%d/%d) blocks\n", written, nbl);
         }
         else {
-            DEBUG("_write_blocks: write single block: [OK]\n");
-            *state = SD_RW_OK;
+            DEBUG("_write_blocks: write single block\n");
         }
-
-        _unselect_card_spi(card);
-        return written;
-    }
-    else {
-        DEBUG("_write_blocks: sdcard_spi_send_cmd: SD_CMD_ERROR_NO_RESP\n");
-        _unselect_card_spi(card);
-        *state = SD_RW_RX_TX_ERROR;
-        return written;
     }
+
+    _unselect_card_spi(card);
+    return written;
 }
 
 int sdcard_spi_write_blocks(sdcard_spi_t *card, int blockaddr, const uint8_t *data, int blocksize,
@@ -821,6 +909,74 @@ int sdcard_spi_write_blocks(sdcard_spi_t *card, int blockaddr, const uint8_t *da
     }
 }
 
+sd_rw_response_t sdcard_spi_write_stream_start(sdcard_spi_t *card, int blockaddr, int nblocks)
+{
+    assert(card->stream_cmd == 0);
+
+    _select_card_spi(card);
+    sd_rw_response_t state = _write_stream_start(card, blockaddr, nblocks);
+    if (state != SD_RW_OK) {
+        _unselect_card_spi(card);
+        return state;
+    }
+
+    card->stream_cmd = SD_CMD_25;
+    return SD_RW_OK;
+}
+
+sd_rw_response_t sdcard_spi_write_stream_block(sdcard_spi_t *card, const uint8_t *data)
+{
+    assert(card->stream_cmd == SD_CMD_25);
+
+    sd_rw_response_t state = _write_block(card, SD_DATA_TOKEN_CMD_25, data, SD_HC_BLOCK_SIZE);
+    if (state != SD_RW_OK) {
+        sdcard_spi_write_stream_stop(card);
+    }
+    return state;
+}
+
+sd_rw_response_t sdcard_spi_write_stream_stop(sdcard_spi_t *card)
+{
+    if (card->stream_cmd != SD_CMD_25) {
+        return SD_RW_OK;
+    }
+
+    sd_rw_response_t state = _write_stream_stop(card);
+    _unselect_card_spi(card);
+    card->stream_cmd = 0;
+    return state;
+}
+
+int sdcard_spi_erase_blocks(sdcard_spi_t *card, int blockaddr, int nblocks,
+                            sd_rw_response_t *state)
+{
+    if (nblocks <= 0) {
+        *state = SD_RW_OK;
+        return 0;
+    }
+
+    _select_card_spi(card);
+    *state = _send_rw_cmd(card, SD_CMD_32, blockaddr, SD_BLOCK_WRITE_CMD_RETRIES);
+    if (*state == SD_RW_OK) {
+        *state = _send_rw_cmd(card, SD_CMD_33, blockaddr + nblocks - 1,
+                              SD_BLOCK_WRITE_CMD_RETRIES);
+    }
+    if (*state == SD_RW_OK) {
+        *state = _send_rw_cmd(card, SD_CMD_38, 0, 0);
+    }
+    if (*state == SD_RW_OK) {
+        /* the card signals busy until the erase is done */
+        _send_dummy_byte(card);
+        if (!_wait_for_not_busy(card, SD_ERASE_WAIT_FOR_NOT_BUSY_CNT)) {
+            DEBUG("sdcard_spi_erase_blocks: _wait_for_not_busy: [FAILED]\n");
+            *state = SD_RW_TIMEOUT;
+        }
+    }
+    _unselect_card_spi(card);
+
+    return (*state == SD_RW_OK) ? nblocks : 0;
+}
+
 sd_rw_response_t _read_cid(sdcard_spi_t *card)
 {
     uint8_t cid_raw_data[SD_SIZE_OF_CID_AND_CSD_REG];
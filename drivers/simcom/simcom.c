@@ -1058,8 +1058,10 @@ int simcom_get_local_ip_address(simcom_dev_t        *simcom_dev,
         return ARGUMENT_NULL_ERROR;
     }
 
-    /* Get local IP address */
-    int res = at_send_cmd_get_resp(&simcom_dev->at_dev, "AT+CIFSR", simcom_dev->at_dev_resp, simcom_dev->at_dev_resp_size, SIMCOM_MAX_TIMEOUT); 
+    /* Get local IP address, the address is not followed by OK */
+    at_cmd_t cmd = { .cmd = "AT+CIFSR", .resp = simcom_dev->at_dev_resp, .resp_len = simcom_dev->at_dev_resp_size,
+                     .timeout = SIMCOM_MAX_TIMEOUT, .flags = AT_CMD_F_LINE };
+    int res = at_cmd_run(&simcom_dev->at_dev, &cmd);
     if (res <= SIMCOM_OK) {
         puts("[SIMCOM] AT+CIFSR ERROR");
 
@@ -1390,9 +1392,9 @@ int simcom_start_up_multi_ip_connection(simcom_dev_t *simcom_dev,
  * @returns     SEND_CMD_ERROR         - ERROR: at_send_cmd() != 0
  * @returns     UNKNOWN_RESP           - ERROR: Unknown response
  */
-int simcom_close_up_multi_ip_connection(simcom_dev_t *simcom_dev, 
-                                         uint8_t        id,  
-                                         uint8_t        n) {
+static int _simcom_close_up_multi_ip_connection(simcom_dev_t *simcom_dev, 
+                                                 uint8_t        id,  
+                                                 uint8_t        n) {
     /* Test NULL device */
     if (simcom_dev == NULL) {
         puts("simcom_dev = NULL");
@@ -1446,15 +1448,33 @@ int simcom_close_up_multi_ip_connection(simcom_dev_t *simcom_dev,
     return SIMCOM_OK;
 }
 
+int simcom_close_up_multi_ip_connection(simcom_dev_t *simcom_dev, 
+                                         uint8_t        id,  
+                                         uint8_t        n) {
+    /* Test NULL device */
+    if (simcom_dev == NULL) {
+        puts("simcom_dev = NULL");
+
+        return SIMCOM_DEV_ERROR;
+    }
+
+    /* The response is read directly, not by the AT engine */
+    at_acquire(&simcom_dev->at_dev);
+    int res = _simcom_close_up_multi_ip_connection(simcom_dev, id, n);
+    at_release(&simcom_dev->at_dev);
+
+    return res;
+}
+
 /*---------------------------------------------------------------------------*/
 /* AT+CIPPING PING request */
-int simcom_ping_request(simcom_dev_t          *simcom_dev,
-                         simcom_cipping_resp_t  simcom_cipping_resp[],
-                         char                   *address,
-                         char                   *retr_num,
-                         char                   *datalen, 
-                         char                   *timeout,
-                         char                   *ttl) {
+static int _simcom_ping_request(simcom_dev_t          *simcom_dev,
+                                 simcom_cipping_resp_t  simcom_cipping_resp[],
+                                 char                   *address,
+                                 char                   *retr_num,
+                                 char                   *datalen, 
+                                 char                   *timeout,
+                                 char                   *ttl) {
     /* Test NULL device */
     if (simcom_dev == NULL) {
         puts("simcom_dev = NULL");
@@ -1526,8 +1546,9 @@ int simcom_ping_request(simcom_dev_t          *simcom_dev,
         return SEND_CMD_ERROR;
     }
 
-    /* Sleep on 10000 ms */
-    lptimer_usleep(10000);
+    /* The replies come when the ping finished, wait for the first one as
+     * long as the default ping takes */
+    uint32_t line_timeout = SIMCOM_PING_TIMEOUT;
 
     int reply_id_scan;
     int reply_time_scan; 
@@ -1539,8 +1560,9 @@ int simcom_ping_request(simcom_dev_t          *simcom_dev,
     DEBUG("format: %s\n", format);
     do {
         /* Read string */
-        res = at_readline(&simcom_dev->at_dev, simcom_dev->at_dev_resp, simcom_dev->at_dev_resp_size, false, SIMCOM_MAX_TIMEOUT);
+        res = at_readline(&simcom_dev->at_dev, simcom_dev->at_dev_resp, simcom_dev->at_dev_resp_size, false, line_timeout);
         DEBUG("res = %i, data: %s\n", res, simcom_dev->at_dev_resp);
+        line_timeout = SIMCOM_MAX_TIMEOUT;
 
         /* Check read len string */
         if (res < SIMCOM_OK) {
@@ -1572,6 +1594,28 @@ int simcom_ping_request(simcom_dev_t          *simcom_dev,
     return SIMCOM_OK;
 }
 
+int simcom_ping_request(simcom_dev_t          *simcom_dev,
+                         simcom_cipping_resp_t  simcom_cipping_resp[],
+                         char                   *address,
+                         char                   *retr_num,
+                         char                   *datalen, 
+                         char                   *timeout,
+                         char                   *ttl) {
+    /* Test NULL device */
+    if (simcom_dev == NULL) {
+        puts("simcom_dev = NULL");
+
+        return SIMCOM_DEV_ERROR;
+    }
+
+    /* The response is read directly, not by the AT engine */
+    at_acquire(&simcom_dev->at_dev);
+    int res = _simcom_ping_request(simcom_dev, simcom_cipping_resp, address, retr_num, datalen, timeout, ttl);
+    at_release(&simcom_dev->at_dev);
+
+    return res;
+}
+
 /*---------------------------------------------------------------------------*/
 /**
  * @brief       Start up multi-IP TCP or UDP connection
@@ -1594,11 +1638,11 @@ int simcom_ping_request(simcom_dev_t          *simcom_dev,
  * @returns     UNKNOWN_RESP           - ERROR: Unknown response
  * @returns     TIMEOUT_EXPIRED        - ERROR: Timeout expired
  */
-int simcom_start_up_multi_ip_up_connection(simcom_dev_t *simcom_dev,
-                                            uint8_t        n,
-                                            char          *mode,
-                                            char          *address,
-                                            char          *port) {
+static int _simcom_start_up_multi_ip_up_connection(simcom_dev_t *simcom_dev,
+                                                    uint8_t        n,
+                                                    char          *mode,
+                                                    char          *address,
+                                                    char          *port) {
     /* Test NULL device */
     if (simcom_dev == NULL) {
         puts("simcom_dev = NULL");
@@ -1707,6 +1751,26 @@ int simcom_start_up_multi_ip_up_connection(simcom_dev_t *simcom_dev,
     return SIMCOM_OK;
 }
 
+int simcom_start_up_multi_ip_up_connection(simcom_dev_t *simcom_dev,
+                                            uint8_t        n,
+                                            char          *mode,
+                                            char          *address,
+                                            char          *port) {
+    /* Test NULL device */
+    if (simcom_dev == NULL) {
+        puts("simcom_dev = NULL");
+
+        return SIMCOM_DEV_ERROR;
+    }
+
+    /* The response is read directly, not by the AT engine */
+    at_acquire(&simcom_dev->at_dev);
+    int res = _simcom_start_up_multi_ip_up_connection(simcom_dev, n, mode, address, port);
+    at_release(&simcom_dev->at_dev);
+
+    return res;
+}
+
 /*---------------------------------------------------------------------------*/
 /**
  * @brief       Start up multi-IP TCP or UDP connection
@@ -1735,11 +1799,11 @@ int simcom_start_up_multi_ip_up_connection(simcom_dev_t *simcom_dev,
  * @returns     UNDEFINED_ERROR        - ERROR: Undefined error 
  */
 
-int simcom_receive_data_through_multi_ip_connection(simcom_dev_t *simcom_dev,
-                                                     uint8_t        mode,
-                                                     uint8_t        n,
-                                                     uint8_t       *data_for_receive,
-                                                     size_t         data_size) {
+static int _simcom_receive_data_through_multi_ip_connection(simcom_dev_t *simcom_dev,
+                                                             uint8_t        mode,
+                                                             uint8_t        n,
+                                                             uint8_t       *data_for_receive,
+                                                             size_t         data_size) {
     /* Test NULL device */
     if (simcom_dev == NULL) {
         puts("simcom_dev = NULL");
@@ -1895,6 +1959,26 @@ int simcom_receive_data_through_multi_ip_connection(simcom_dev_t *simcom_dev,
     }
 }
 
+int simcom_receive_data_through_multi_ip_connection(simcom_dev_t *simcom_dev,
+                                                     uint8_t        mode,
+                                                     uint8_t        n,
+                                                     uint8_t       *data_for_receive,
+                                                     size_t         data_size) {
+    /* Test NULL device */
+    if (simcom_dev == NULL) {
+        puts("simcom_dev = NULL");
+
+        return SIMCOM_DEV_ERROR;
+    }
+
+    /* The response is read directly, not by the AT engine */
+    at_acquire(&simcom_dev->at_dev);
+    int res = _simcom_receive_data_through_multi_ip_connection(simcom_dev, mode, n, data_for_receive, data_size);
+    at_release(&simcom_dev->at_dev);
+
+    return res;
+}
+
 /*---------------------------------------------------------------------------*/
 /**
  * @brief       Send data through TCP or UDP multi IP connection
@@ -1916,10 +2000,10 @@ int simcom_receive_data_through_multi_ip_connection(simcom_dev_t *simcom_dev,
  * @returns     UNKNOWN_RESP           - ERROR: Unknown response
  * @returns     TIMEOUT_EXPIRED        - ERROR: Timeout expired
  */
-int simcom_send_data_through_multi_ip_connection(simcom_dev_t *simcom_dev,
-                                                  uint8_t        n,
-                                                  uint8_t       *data_for_send, 
-                                                  size_t         data_size) {
+static int _simcom_send_data_through_multi_ip_connection(simcom_dev_t *simcom_dev,
+                                                          uint8_t        n,
+                                                          uint8_t       *data_for_send, 
+                                                          size_t         data_size) {
     /* Test NULL device */
     if (simcom_dev == NULL) {
         puts("simcom_dev = NULL");
@@ -1956,24 +2040,38 @@ int simcom_send_data_through_multi_ip_connection(simcom_dev_t *simcom_dev,
         return SEND_CMD_ERROR;
     } 
 
-    /* Sleep on 30 ms */
-    lptimer_usleep(30);
+    /* Wait for the prompt */
+    if (at_expect_bytes(&simcom_dev->at_dev, "> ", SIMCOM_MAX_TIMEOUT) != 0) {
+        puts("[SIMCOM] No prompt for data");
+
+        return INVALID_DATA;
+    }
 
     /* Send data */
     at_send_bytes(&simcom_dev->at_dev, (char*)data_for_send, data_size);
 
     /* Check on valid data */
-    res = at_recv_bytes(&simcom_dev->at_dev, simcom_dev->at_dev_resp, data_size + 4, 3000000);
-    if ((!(memcmp(simcom_dev->at_dev_resp, "> ", 2)                                  == 0)) && 
-        (!(memcmp((uint8_t*)(simcom_dev->at_dev_resp) + 2, data_for_send, data_size) == 0))) {
-        puts("[SIMCOM] Data for send don't valid");
+    for (size_t pos = 0; pos < data_size; pos += res) {
+        size_t len = data_size - pos;
+        if (len > simcom_dev->at_dev_resp_size) {
+            len = simcom_dev->at_dev_resp_size;
+        }
+        res = at_recv_bytes(&simcom_dev->at_dev, simcom_dev->at_dev_resp, len, 3000000);
+        if ((res != (int)len) ||
+            (memcmp(simcom_dev->at_dev_resp, data_for_send + pos, len) != 0)) {
+            puts("[SIMCOM] Data for send don't valid");
 
-        return INVALID_DATA;
-    } 
+            return INVALID_DATA;
+        }
+    }
 
-    /* Create string with resp */
+    /* Create strings with resp, in the quick send mode set by
+     * simcom_sock_init() the modem answers DATA ACCEPT instead */
     char resp_on_CIPSEND[11];
     snprintf(resp_on_CIPSEND, 11, "%i, SEND OK", n);
+    char resp_on_CIPQSEND[sizeof("DATA ACCEPT:0,65535")];
+    snprintf(resp_on_CIPQSEND, sizeof(resp_on_CIPQSEND), "DATA ACCEPT:%i,%u",
+             n, (unsigned)data_size);
 
     /* Get time now */
     uint32_t timeout = lptimer_now_msec();
@@ -1987,14 +2085,17 @@ int simcom_send_data_through_multi_ip_connection(simcom_dev_t *simcom_dev,
         DEBUG("res = %i, data: %s\n", res, simcom_dev->at_dev_resp);
 
         /* Check read len string */
-        if (res != 10) {
-            lptimer_usleep(10);
+        if (res <= 0) {
             continue;
         }
 
         /* Compare recv */
-        if (memcmp(simcom_dev->at_dev_resp, resp_on_CIPSEND, 10) != 0) {
-            return UNKNOWN_RESP;
+        if ((strcmp(simcom_dev->at_dev_resp, resp_on_CIPSEND) != 0) &&
+            (strcmp(simcom_dev->at_dev_resp, resp_on_CIPQSEND) != 0)) {
+            if (res == 10) {
+                return UNKNOWN_RESP;
+            }
+            continue;
         }
 
 #if ENABLE_DEBUG_DATA == 1
@@ -2009,6 +2110,25 @@ int simcom_send_data_through_multi_ip_connection(simcom_dev_t *simcom_dev,
     return TIMEOUT_EXPIRED; 
 }
 
+int simcom_send_data_through_multi_ip_connection(simcom_dev_t *simcom_dev,
+                                                  uint8_t        n,
+                                                  uint8_t       *data_for_send, 
+                                                  size_t         data_size) {
+    /* Test NULL device */
+    if (simcom_dev == NULL) {
+        puts("simcom_dev = NULL");
+
+        return SIMCOM_DEV_ERROR;
+    }
+
+    /* The response is read directly, not by the AT engine */
+    at_acquire(&simcom_dev->at_dev);
+    int res = _simcom_send_data_through_multi_ip_connection(simcom_dev, n, data_for_send, data_size);
+    at_release(&simcom_dev->at_dev);
+
+    return res;
+}
+
 /*---------------------------------------------------------------------------*/
 /*------------------------- END LOW LEVEL FUNCTION --------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -2879,14 +2999,22 @@ int simcom_init(simcom_dev_t *simcom_dev,
         simcom_dev->socketfd[i]  = false;
     }
 
-    /* Initialization of UART */
-    res = at_dev_init(&simcom_dev->at_dev, uart, baudrate, buf, bufsize);
-    if (res != SIMCOM_OK) {
-        DEBUG("[SIMCOM] at_dev_init() ERROR: %i\n", res);
+    /* Initialization of UART, the AT engine keeps running over re-initializations */
+    if (simcom_dev->at_dev.pid == KERNEL_PID_UNDEF) {
+        res = at_dev_init(&simcom_dev->at_dev, uart, baudrate, buf, bufsize);
+        if (res != SIMCOM_OK) {
+            DEBUG("[SIMCOM] at_dev_init() ERROR: %i\n", res);
 
-        return res;
+            return res;
+        }
+
+        /* Start the AT engine */
+        if (at_async_start(&simcom_dev->at_dev) < 0) {
+            DEBUG("[SIMCOM] at_async_start() ERROR\n");
+
+            return UNDEFINED_ERROR;
+        }
     }
-    
 
 
     /* SIMCOM connection */
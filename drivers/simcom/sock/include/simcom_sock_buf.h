@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_simcom_sock
+ * @{
+ *
+ * @file
+ * @brief       Receive buffer of the SIMCOM socks
+ *
+ * Received data is kept as chunks of a 2 byte length header followed by the
+ * data. A chunk is never split, a chunk that does not fit at the end of the
+ * buffer starts at its beginning, the unused end is marked with
+ * @ref SIMCOM_SOCK_BUF_WRAP.
+ *
+ * The functions do not lock, the caller holds simcom_sock_t::lock.
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef SIMCOM_SOCK_BUF_H
+#define SIMCOM_SOCK_BUF_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sock_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of the header of a buffered chunk
+ */
+#define SIMCOM_SOCK_BUF_HDR_LEN (2U)
+
+/**
+ * @brief   Header marking the unused end of the buffer
+ */
+#define SIMCOM_SOCK_BUF_WRAP    (0xffff)
+
+/**
+ * @brief   Read the chunk header at @p pos
+ */
+static inline uint16_t simcom_sock_buf_hdr(const simcom_sock_t *sock,
+                                           unsigned pos)
+{
+    uint16_t len;
+
+    memcpy(&len, &sock->buf[pos], sizeof(len));
+    return len;
+}
+
+/**
+ * @brief   Find a contiguous part of the buffer for a chunk
+ *
+ * @param[in] sock      sock to store the chunk in
+ * @param[in] len       length of the chunk data
+ *
+ * @return  position of the chunk, its data starts
+ *          @ref SIMCOM_SOCK_BUF_HDR_LEN bytes later
+ * @return  -1 if the chunk does not fit
+ */
+static inline int simcom_sock_buf_reserve(simcom_sock_t *sock, size_t len)
+{
+    size_t total = SIMCOM_SOCK_BUF_HDR_LEN + len;
+
+    if (sock->used == 0) {
+        sock->head = 0;
+        sock->tail = 0;
+    }
+    else if (sock->head == sock->tail) {
+        return -1;
+    }
+
+    if (sock->head >= sock->tail) {
+        if (total <= (SIMCOM_SOCK_BUF_SIZE - sock->head)) {
+            return sock->head;
+        }
+        if (total <= sock->tail) {
+            return 0;
+        }
+        return -1;
+    }
+    if (total <= (size_t)(sock->tail - sock->head)) {
+        return sock->head;
+    }
+    return -1;
+}
+
+/**
+ * @brief   Add a chunk whose data was written at the reserved position
+ *
+ * @param[in] sock      sock to store the chunk in
+ * @param[in] pos       position returned by simcom_sock_buf_reserve()
+ * @param[in] len       length of the chunk data
+ */
+static inline void simcom_sock_buf_commit(simcom_sock_t *sock, unsigned pos,
+                                          uint16_t len)
+{
+    if (pos != sock->head) {
+        /* the chunk did not fit at the end of the buffer */
+        size_t left = SIMCOM_SOCK_BUF_SIZE - sock->head;
+        if (left >= SIMCOM_SOCK_BUF_HDR_LEN) {
+            uint16_t wrap = SIMCOM_SOCK_BUF_WRAP;
+            memcpy(&sock->buf[sock->head], &wrap, sizeof(wrap));
+        }
+        sock->used += left;
+    }
+    memcpy(&sock->buf[pos], &len, sizeof(len));
+    sock->head = pos + SIMCOM_SOCK_BUF_HDR_LEN + len;
+    if (sock->head == SIMCOM_SOCK_BUF_SIZE) {
+        sock->head = 0;
+    }
+    sock->used += SIMCOM_SOCK_BUF_HDR_LEN + len;
+}
+
+/**
+ * @brief   Move the read position past the unused end of the buffer
+ */
+static inline void simcom_sock_buf_skip_wrap(simcom_sock_t *sock)
+{
+    size_t left = SIMCOM_SOCK_BUF_SIZE - sock->tail;
+
+    if ((left < SIMCOM_SOCK_BUF_HDR_LEN) ||
+        (simcom_sock_buf_hdr(sock, sock->tail) == SIMCOM_SOCK_BUF_WRAP)) {
+        sock->used -= left;
+        sock->tail = 0;
+    }
+}
+
+/**
+ * @brief   Get the oldest chunk
+ *
+ * @param[in] sock      sock to read from
+ * @param[out] data     data of the chunk
+ *
+ * @return  length of @p data, 0 if the buffer is empty
+ */
+static inline size_t simcom_sock_buf_peek(simcom_sock_t *sock, uint8_t **data)
+{
+    if (sock->used == 0) {
+        return 0;
+    }
+    simcom_sock_buf_skip_wrap(sock);
+    *data = &sock->buf[sock->tail + SIMCOM_SOCK_BUF_HDR_LEN];
+    return simcom_sock_buf_hdr(sock, sock->tail);
+}
+
+/**
+ * @brief   Drop the oldest chunk
+ *
+ * @param[in] sock      sock to read from
+ */
+static inline void simcom_sock_buf_release(simcom_sock_t *sock)
+{
+    if (sock->used == 0) {
+        return;
+    }
+    simcom_sock_buf_skip_wrap(sock);
+    size_t total = SIMCOM_SOCK_BUF_HDR_LEN + simcom_sock_buf_hdr(sock, sock->tail);
+    sock->tail += total;
+    if (sock->tail == SIMCOM_SOCK_BUF_SIZE) {
+        sock->tail = 0;
+    }
+    sock->used -= total;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMCOM_SOCK_BUF_H */
+/** @} */
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_simcom_sock
+ * @{
+ *
+ * @file
+ * @brief       Connection handling shared by the SIMCOM sock implementations
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef SIMCOM_SOCK_INTERNAL_H
+#define SIMCOM_SOCK_INTERNAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "iolist.h"
+#include "timex.h"
+#include "net/sock.h"
+#include "sock_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum length of one send
+ */
+#ifndef SIMCOM_SOCK_MTU
+#define SIMCOM_SOCK_MTU             (1460U)
+#endif
+
+/**
+ * @brief   Timeout of connection attempts (in usec)
+ */
+#ifndef SIMCOM_SOCK_CONNECT_TIMEOUT
+#define SIMCOM_SOCK_CONNECT_TIMEOUT (75U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Timeout of commands (in usec)
+ */
+#ifndef SIMCOM_SOCK_CMD_TIMEOUT
+#define SIMCOM_SOCK_CMD_TIMEOUT     (5U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Connection states
+ */
+enum {
+    SIMCOM_SOCK_CLOSED,             /**< no connection */
+    SIMCOM_SOCK_CONNECTING,         /**< waiting for the connection result */
+    SIMCOM_SOCK_CONNECTED,          /**< connection established */
+    SIMCOM_SOCK_FAILED,             /**< connection attempt failed */
+    SIMCOM_SOCK_RESET,              /**< connection closed by the remote */
+};
+
+/**
+ * @brief   Initialize the common part of a sock
+ *
+ * @param[out] sock     sock to initialize
+ */
+void simcom_sock_setup(simcom_sock_t *sock);
+
+/**
+ * @brief   Open a connection
+ *
+ * @param[in] sock      sock to connect
+ * @param[in] remote    remote end point
+ * @param[in] tcp       open a TCP connection, UDP otherwise
+ *
+ * @return  0 on success
+ * @return  -EAFNOSUPPORT, if @p remote is no IPv4 end point
+ * @return  -ENOMEM, if all connections are in use
+ * @return  -ECONNREFUSED, if the modem reported a failure
+ * @return  -EHOSTUNREACH, if the modem did not accept the command
+ * @return  -ETIMEDOUT, if the connection attempt timed out
+ */
+int simcom_sock_connect(simcom_sock_t *sock, const struct _sock_tl_ep *remote,
+                        bool tcp);
+
+/**
+ * @brief   Close the connection of a sock, if there is one
+ *
+ * Received data stays available.
+ *
+ * @param[in] sock      sock to disconnect
+ */
+void simcom_sock_disconnect(simcom_sock_t *sock);
+
+/**
+ * @brief   Send data through the connection of a sock
+ *
+ * Waits until the modem accepted the previous send of this sock, but not for
+ * sends on other connections.
+ *
+ * @param[in] sock      connected sock
+ * @param[in] snips     data to send, at most @ref SIMCOM_SOCK_MTU bytes
+ *
+ * @return  number of bytes sent on success
+ * @return  -ENOTCONN, if @p sock is not connected
+ * @return  -ENOMEM, if @p snips is too long
+ * @return  -EHOSTUNREACH, if the modem did not accept the data
+ */
+ssize_t simcom_sock_sendv(simcom_sock_t *sock, const iolist_t *snips);
+
+/**
+ * @brief   Wait for received data
+ *
+ * @param[in] sock      sock to wait on
+ * @param[in] timeout   timeout in usec, 0 to return immediately, or
+ *                      @ref SOCK_NO_TIMEOUT
+ *
+ * @return  0, if data is available
+ * @return  -EAGAIN, if @p timeout is 0 and no data is available
+ * @return  -ETIMEDOUT, if @p timeout expired
+ * @return  -ECONNRESET, if no data is available and the remote closed the
+ *          connection
+ */
+int simcom_sock_wait(simcom_sock_t *sock, uint32_t timeout);
+
+/**
+ * @brief   Get the oldest chunk of received data
+ *
+ * The data stays valid until simcom_sock_release() is called.
+ *
+ * @param[in] sock      sock to read from
+ * @param[out] data     received data
+ *
+ * @return  length of @p data, 0 if no data is available
+ */
+size_t simcom_sock_peek(simcom_sock_t *sock, uint8_t **data);
+
+/**
+ * @brief   Release the chunk returned by simcom_sock_peek()
+ *
+ * @param[in] sock      sock to read from
+ */
+void simcom_sock_release(simcom_sock_t *sock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMCOM_SOCK_INTERNAL_H */
+/** @} */
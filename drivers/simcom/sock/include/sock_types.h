@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_simcom_sock  sock API over SIMCOM multi-IP connections
+ * @ingroup     SimCom
+ * @brief       sock_udp and sock_tcp implemented by the TCP/IP stack of the
+ *              modem
+ *
+ * Every connected sock uses one of the 8 multi-IP connections of the modem.
+ * A UDP sock is connected to a remote end point on its first send, or by
+ * sock_udp_create(), and reconnected when sending to another one. Received
+ * data is pushed by the modem and stored by the AT engine in a ring buffer
+ * of the sock. Sends on different connections do not wait for each other.
+ *
+ * Only IPv4 is supported, listening TCP socks are not.
+ *
+ * @{
+ *
+ * @file
+ * @brief       SIMCOM sock type definitions
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef SOCK_TYPES_H
+#define SOCK_TYPES_H
+
+#include <stdint.h>
+
+#include "mutex.h"
+#include "net/sock.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the receive buffer of a sock
+ */
+#ifndef SIMCOM_SOCK_BUF_SIZE
+#define SIMCOM_SOCK_BUF_SIZE    (512U)
+#endif
+
+/**
+ * @brief   Common part of SIMCOM socks
+ * @internal
+ */
+typedef struct {
+    mutex_t lock;               /**< protects the receive buffer */
+    mutex_t rx_sig;             /**< unlocked when data was received */
+    mutex_t state_sig;          /**< unlocked on connection events */
+    int8_t conn;                /**< connection number, -1 if none */
+    volatile uint8_t state;     /**< connection state */
+    volatile uint8_t sending;   /**< a send was not accepted yet */
+    uint16_t head;              /**< write position in @p buf */
+    uint16_t tail;              /**< read position in @p buf */
+    uint16_t used;              /**< bytes of @p buf in use */
+    uint8_t buf[SIMCOM_SOCK_BUF_SIZE];  /**< received data */
+} simcom_sock_t;
+
+/**
+ * @brief   UDP sock type
+ * @internal
+ */
+struct sock_udp {
+    simcom_sock_t base;         /**< common part */
+    struct _sock_tl_ep local;   /**< local end point */
+    struct _sock_tl_ep remote;  /**< remote end point of the connection */
+    uint16_t flags;             /**< sock flags */
+};
+
+/**
+ * @brief   TCP sock type
+ * @internal
+ */
+struct sock_tcp {
+    simcom_sock_t base;         /**< common part */
+    struct _sock_tl_ep remote;  /**< remote end point */
+    uint16_t local_port;        /**< local port */
+    uint16_t rd_off;            /**< bytes read from the current chunk */
+};
+
+/**
+ * @brief   TCP queue type, listening is not supported
+ */
+struct sock_tcp_queue {
+    uint8_t unused;             /**< placeholder */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SOCK_TYPES_H */
+/** @} */
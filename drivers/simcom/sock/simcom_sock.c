@@ -0,0 +1,405 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_simcom_sock
+ * @{
+ *
+ * @file
+ * @brief       Connection handling shared by the SIMCOM sock implementations
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fmt.h"
+#include "mutex.h"
+#include "net/af.h"
+#include "simcom.h"
+#include "xtimer.h"
+
+#include "simcom_sock_buf.h"
+#include "simcom_sock_internal.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define CONN_NUMOF      (8U)
+#define DISCARD_LEN     (16U)
+
+static simcom_dev_t *_dev;
+static simcom_sock_t *_socks[CONN_NUMOF];
+/* protects _socks and the connection status of _dev */
+static mutex_t _lock = MUTEX_INIT;
+
+static char _conn_codes[CONN_NUMOF][sizeof("0, ")];
+static at_urc_t _conn_urcs[CONN_NUMOF];
+static at_urc_t _recv_urc;
+static at_urc_t _accept_urc;
+
+static void _discard(size_t len)
+{
+    char tmp[DISCARD_LEN];
+
+    while (len > 0) {
+        size_t n = (len < sizeof(tmp)) ? len : sizeof(tmp);
+        if (at_recv_bytes(&_dev->at_dev, tmp, n, SIMCOM_SOCK_CMD_TIMEOUT) != (ssize_t)n) {
+            return;
+        }
+        len -= n;
+    }
+}
+
+/* "<n>, CONNECT OK", "<n>, CLOSED", "<n>, SEND OK", ... */
+static void _conn_cb(void *arg, const char *code)
+{
+    const char *event = code + sizeof("0, ") - 1;
+
+    mutex_lock(&_lock);
+    simcom_sock_t *sock = _socks[(uintptr_t)arg];
+    if (sock == NULL) {
+        mutex_unlock(&_lock);
+        return;
+    }
+
+    if ((strcmp(event, "CONNECT OK") == 0) ||
+        (strcmp(event, "ALREADY CONNECT") == 0)) {
+        sock->state = SIMCOM_SOCK_CONNECTED;
+    }
+    else if (strcmp(event, "CONNECT FAIL") == 0) {
+        sock->state = SIMCOM_SOCK_FAILED;
+    }
+    else if (strcmp(event, "CLOSED") == 0) {
+        sock->state = SIMCOM_SOCK_RESET;
+        mutex_unlock(&sock->rx_sig);
+    }
+    else if (strncmp(event, "SEND ", sizeof("SEND ") - 1) == 0) {
+        sock->sending = 0;
+    }
+    mutex_unlock(&sock->state_sig);
+    mutex_unlock(&_lock);
+}
+
+/* "DATA ACCEPT:<n>,<length>" */
+static void _accept_cb(void *arg, const char *code)
+{
+    (void)arg;
+    unsigned conn = code[sizeof("DATA ACCEPT:") - 1] - '0';
+
+    mutex_lock(&_lock);
+    if ((conn < CONN_NUMOF) && (_socks[conn] != NULL)) {
+        _socks[conn]->sending = 0;
+        mutex_unlock(&_socks[conn]->state_sig);
+    }
+    mutex_unlock(&_lock);
+}
+
+/* "+RECEIVE,<n>,<length>:", followed by the data */
+static void _recv_cb(void *arg, const char *code)
+{
+    (void)arg;
+    char *end;
+    unsigned conn = strtoul(code + sizeof("+RECEIVE,") - 1, &end, 10);
+    if (*end != ',') {
+        return;
+    }
+    size_t len = strtoul(end + 1, NULL, 10);
+
+    mutex_lock(&_lock);
+    simcom_sock_t *sock = (conn < CONN_NUMOF) ? _socks[conn] : NULL;
+    int pos = -1;
+    if ((sock != NULL) && (len > 0)) {
+        mutex_lock(&sock->lock);
+        pos = simcom_sock_buf_reserve(sock, len);
+        if (pos < 0) {
+            mutex_unlock(&sock->lock);
+        }
+    }
+
+    if (pos >= 0) {
+        /* the data is read directly into the buffer of the sock */
+        char *data = (char *)&sock->buf[pos + SIMCOM_SOCK_BUF_HDR_LEN];
+        if (at_recv_bytes(&_dev->at_dev, data, len, SIMCOM_SOCK_CMD_TIMEOUT) == (ssize_t)len) {
+            simcom_sock_buf_commit(sock, pos, len);
+        }
+        mutex_unlock(&sock->lock);
+        mutex_unlock(&sock->rx_sig);
+    }
+    else {
+        DEBUG("simcom_sock: dropped %u bytes on connection %u\n",
+              (unsigned)len, conn);
+        _discard(len);
+    }
+    mutex_unlock(&_lock);
+}
+
+static void _free(simcom_sock_t *sock)
+{
+    mutex_lock(&_lock);
+    _socks[sock->conn] = NULL;
+    _dev->socketfd[sock->conn] = false;
+    mutex_unlock(&_lock);
+    sock->conn = -1;
+    sock->state = SIMCOM_SOCK_CLOSED;
+    sock->sending = 0;
+}
+
+int simcom_sock_init(simcom_dev_t *simcom_dev)
+{
+    if (simcom_dev == NULL) {
+        puts("simcom_dev = NULL");
+        return SIMCOM_DEV_ERROR;
+    }
+
+    at_dev_t *at = &simcom_dev->at_dev;
+    /* received data is pushed with a "+RECEIVE,<n>,<length>:" header, sends
+     * are confirmed as soon as the modem took the data */
+    if ((at_send_cmd_wait_ok(at, "AT+CIPRXGET=0", SIMCOM_MAX_TIMEOUT) != 0) ||
+        (at_send_cmd_wait_ok(at, "AT+CIPQSEND=1", SIMCOM_MAX_TIMEOUT) != 0)) {
+        return SEND_CMD_WAIT_OK_ERROR;
+    }
+
+    if (_dev == NULL) {
+        for (unsigned i = 0; i < CONN_NUMOF; i++) {
+            memcpy(_conn_codes[i], "0, ", sizeof("0, "));
+            _conn_codes[i][0] += i;
+            _conn_urcs[i].code = _conn_codes[i];
+            _conn_urcs[i].cb = _conn_cb;
+            _conn_urcs[i].arg = (void *)(uintptr_t)i;
+            at_add_urc(at, &_conn_urcs[i]);
+        }
+        _recv_urc.code = "+RECEIVE,";
+        _recv_urc.cb = _recv_cb;
+        at_add_urc(at, &_recv_urc);
+        _accept_urc.code = "DATA ACCEPT:";
+        _accept_urc.cb = _accept_cb;
+        at_add_urc(at, &_accept_urc);
+    }
+    _dev = simcom_dev;
+
+    return SIMCOM_OK;
+}
+
+void simcom_sock_setup(simcom_sock_t *sock)
+{
+    mutex_init(&sock->lock);
+    sock->rx_sig = (mutex_t)MUTEX_INIT_LOCKED;
+    sock->state_sig = (mutex_t)MUTEX_INIT_LOCKED;
+    sock->conn = -1;
+    sock->state = SIMCOM_SOCK_CLOSED;
+    sock->sending = 0;
+    sock->head = 0;
+    sock->tail = 0;
+    sock->used = 0;
+}
+
+int simcom_sock_connect(simcom_sock_t *sock, const struct _sock_tl_ep *remote,
+                        bool tcp)
+{
+    char cmd[sizeof("AT+CIPSTART=0,\"TCP\",\"255.255.255.255\",\"65535\"")];
+
+    if ((remote->family != AF_INET) && (remote->family != AF_UNSPEC)) {
+        return -EAFNOSUPPORT;
+    }
+    if (_dev == NULL) {
+        return -EHOSTUNREACH;
+    }
+
+    int conn = -1;
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < CONN_NUMOF; i++) {
+        if (!_dev->socketfd[i]) {
+            conn = i;
+            break;
+        }
+    }
+    if (conn < 0) {
+        mutex_unlock(&_lock);
+        return -ENOMEM;
+    }
+    _dev->socketfd[conn] = true;
+    _socks[conn] = sock;
+    sock->conn = conn;
+    sock->state = SIMCOM_SOCK_CONNECTING;
+    sock->sending = 0;
+    mutex_unlock(&_lock);
+
+    const uint8_t *addr = remote->addr.ipv4;
+    snprintf(cmd, sizeof(cmd), "AT+CIPSTART=%d,\"%s\",\"%u.%u.%u.%u\",\"%u\"",
+             conn, tcp ? "TCP" : "UDP", addr[0], addr[1], addr[2], addr[3],
+             remote->port);
+    if (at_send_cmd_wait_ok(&_dev->at_dev, cmd, SIMCOM_SOCK_CMD_TIMEOUT) != 0) {
+        _free(sock);
+        return -EHOSTUNREACH;
+    }
+
+    /* the result is reported after the OK */
+    uint32_t start = xtimer_now_usec();
+    while (sock->state == SIMCOM_SOCK_CONNECTING) {
+        uint32_t elapsed = xtimer_now_usec() - start;
+        if ((elapsed >= SIMCOM_SOCK_CONNECT_TIMEOUT) ||
+            (xtimer_mutex_lock_timeout(&sock->state_sig,
+                                       SIMCOM_SOCK_CONNECT_TIMEOUT - elapsed) < 0)) {
+            simcom_sock_disconnect(sock);
+            return -ETIMEDOUT;
+        }
+    }
+    if (sock->state != SIMCOM_SOCK_CONNECTED) {
+        _free(sock);
+        return -ECONNREFUSED;
+    }
+
+    DEBUG("simcom_sock: connection %d to %s\n", conn, cmd);
+    return 0;
+}
+
+void simcom_sock_disconnect(simcom_sock_t *sock)
+{
+    int conn = sock->conn;
+
+    if (conn < 0) {
+        return;
+    }
+
+    /* drop data and events of the connection from now on */
+    mutex_lock(&_lock);
+    _socks[conn] = NULL;
+    mutex_unlock(&_lock);
+
+    if (sock->state != SIMCOM_SOCK_RESET) {
+        char cmd[] = "AT+CIPCLOSE=0,1";
+        char prefix[] = "0, CLOSE";
+        cmd[sizeof("AT+CIPCLOSE=") - 1] += conn;
+        prefix[0] += conn;
+
+        at_cmd_t close = {
+            .cmd = cmd,
+            .resp_prefix = prefix,
+            .timeout = SIMCOM_SOCK_CMD_TIMEOUT,
+            .flags = AT_CMD_F_LINE,
+        };
+        at_cmd_run(&_dev->at_dev, &close);
+    }
+
+    _free(sock);
+}
+
+ssize_t simcom_sock_sendv(simcom_sock_t *sock, const iolist_t *snips)
+{
+    char cmd[sizeof("AT+CIPSEND=0,65535")];
+    size_t len = iolist_size(snips);
+
+    if ((sock->conn < 0) || (sock->state != SIMCOM_SOCK_CONNECTED)) {
+        return -ENOTCONN;
+    }
+    if (len > SIMCOM_SOCK_MTU) {
+        return -ENOMEM;
+    }
+    if (len == 0) {
+        return 0;
+    }
+
+    /* the modem takes one send per connection at a time, a lost
+     * notification only delays the next send */
+    uint32_t start = xtimer_now_usec();
+    while (sock->sending) {
+        uint32_t elapsed = xtimer_now_usec() - start;
+        if ((elapsed >= SIMCOM_SOCK_CMD_TIMEOUT) ||
+            (xtimer_mutex_lock_timeout(&sock->state_sig,
+                                       SIMCOM_SOCK_CMD_TIMEOUT - elapsed) < 0)) {
+            break;
+        }
+    }
+
+    size_t pos = sizeof("AT+CIPSEND=") - 1;
+    memcpy(cmd, "AT+CIPSEND=", pos);
+    cmd[pos++] = '0' + sock->conn;
+    cmd[pos++] = ',';
+    pos += fmt_u16_dec(&cmd[pos], len);
+    cmd[pos] = '\0';
+
+    at_dev_t *at = &_dev->at_dev;
+    at_acquire(at);
+    int res = at_send_cmd(at, cmd, SIMCOM_SOCK_CMD_TIMEOUT);
+    if (res == 0) {
+        res = at_expect_bytes(at, "> ", SIMCOM_SOCK_CMD_TIMEOUT);
+    }
+    if (res == 0) {
+        sock->sending = 1;
+        for (const iolist_t *snip = snips; snip != NULL; snip = snip->iol_next) {
+            at_send_bytes(at, snip->iol_base, snip->iol_len);
+        }
+        if (AT_SEND_ECHO) {
+            char tmp[DISCARD_LEN];
+            for (size_t left = len; left > 0;) {
+                size_t n = (left < sizeof(tmp)) ? left : sizeof(tmp);
+                if (at_recv_bytes(at, tmp, n, SIMCOM_SOCK_CMD_TIMEOUT) != (ssize_t)n) {
+                    res = -1;
+                    break;
+                }
+                left -= n;
+            }
+        }
+    }
+    at_release(at);
+
+    return (res == 0) ? (ssize_t)len : -EHOSTUNREACH;
+}
+
+int simcom_sock_wait(simcom_sock_t *sock, uint32_t timeout)
+{
+    uint32_t start = xtimer_now_usec();
+
+    while (1) {
+        mutex_lock(&sock->lock);
+        bool avail = (sock->used > 0);
+        mutex_unlock(&sock->lock);
+
+        if (avail) {
+            return 0;
+        }
+        if (sock->state == SIMCOM_SOCK_RESET) {
+            return -ECONNRESET;
+        }
+        if (timeout == 0) {
+            return -EAGAIN;
+        }
+        if (timeout == SOCK_NO_TIMEOUT) {
+            mutex_lock(&sock->rx_sig);
+            continue;
+        }
+
+        uint32_t elapsed = xtimer_now_usec() - start;
+        if ((elapsed >= timeout) ||
+            (xtimer_mutex_lock_timeout(&sock->rx_sig, timeout - elapsed) < 0)) {
+            return -ETIMEDOUT;
+        }
+    }
+}
+
+size_t simcom_sock_peek(simcom_sock_t *sock, uint8_t **data)
+{
+    mutex_lock(&sock->lock);
+    size_t len = simcom_sock_buf_peek(sock, data);
+    mutex_unlock(&sock->lock);
+
+    return len;
+}
+
+void simcom_sock_release(simcom_sock_t *sock)
+{
+    mutex_lock(&sock->lock);
+    simcom_sock_buf_release(sock);
+    mutex_unlock(&sock->lock);
+}
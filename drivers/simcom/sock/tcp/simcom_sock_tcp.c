@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_simcom_sock
+ * @{
+ *
+ * @file
+ * @brief       sock_tcp implementation over SIMCOM multi-IP connections
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "net/af.h"
+#include "net/sock/tcp.h"
+
+#include "simcom_sock_internal.h"
+
+int sock_tcp_connect(sock_tcp_t *sock, const sock_tcp_ep_t *remote,
+                     uint16_t local_port, uint16_t flags)
+{
+    assert((sock != NULL) && (remote != NULL) && (remote->port != 0));
+    (void)flags;
+
+    simcom_sock_setup(&sock->base);
+    sock->remote = *remote;
+    sock->local_port = local_port;
+    sock->rd_off = 0;
+
+    int res = simcom_sock_connect(&sock->base, remote, true);
+    return (res == -EHOSTUNREACH) ? -ENETUNREACH : res;
+}
+
+int sock_tcp_listen(sock_tcp_queue_t *queue, const sock_tcp_ep_t *local,
+                    sock_tcp_t *queue_array, unsigned queue_len,
+                    uint16_t flags)
+{
+    (void)queue;
+    (void)local;
+    (void)queue_array;
+    (void)queue_len;
+    (void)flags;
+    return -EOPNOTSUPP;
+}
+
+void sock_tcp_disconnect(sock_tcp_t *sock)
+{
+    assert(sock != NULL);
+    simcom_sock_disconnect(&sock->base);
+}
+
+void sock_tcp_stop_listen(sock_tcp_queue_t *queue)
+{
+    (void)queue;
+}
+
+int sock_tcp_get_local(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+    if (sock->base.conn < 0) {
+        return -EADDRNOTAVAIL;
+    }
+    /* the address is chosen by the modem */
+    memset(ep, 0, sizeof(*ep));
+    ep->family = AF_INET;
+    ep->port = sock->local_port;
+    return 0;
+}
+
+int sock_tcp_get_remote(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+    if (sock->base.conn < 0) {
+        return -ENOTCONN;
+    }
+    *ep = sock->remote;
+    return 0;
+}
+
+int sock_tcp_queue_get_local(sock_tcp_queue_t *queue, sock_tcp_ep_t *ep)
+{
+    (void)queue;
+    (void)ep;
+    return -EADDRNOTAVAIL;
+}
+
+int sock_tcp_accept(sock_tcp_queue_t *queue, sock_tcp_t **sock,
+                    uint32_t timeout)
+{
+    (void)queue;
+    (void)sock;
+    (void)timeout;
+    return -EINVAL;
+}
+
+ssize_t sock_tcp_read(sock_tcp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout)
+{
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+
+    if (sock->base.conn < 0) {
+        return -ENOTCONN;
+    }
+    int res = simcom_sock_wait(&sock->base, timeout);
+    if (res < 0) {
+        return res;
+    }
+
+    /* chunks are consumed partially if the caller reads less */
+    uint8_t *chunk;
+    size_t len = simcom_sock_peek(&sock->base, &chunk) - sock->rd_off;
+    if (len > max_len) {
+        memcpy(data, chunk + sock->rd_off, max_len);
+        sock->rd_off += max_len;
+        return max_len;
+    }
+    memcpy(data, chunk + sock->rd_off, len);
+    sock->rd_off = 0;
+    simcom_sock_release(&sock->base);
+    return len;
+}
+
+ssize_t sock_tcp_write(sock_tcp_t *sock, const void *data, size_t len)
+{
+    assert(sock != NULL);
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+
+    if (sock->base.conn < 0) {
+        return -ENOTCONN;
+    }
+
+    const uint8_t *pos = data;
+    size_t written = 0;
+    while (written < len) {
+        if (sock->base.state == SIMCOM_SOCK_RESET) {
+            return -ECONNRESET;
+        }
+
+        iolist_t snip = {
+            .iol_next = NULL,
+            .iol_base = (void *)(pos + written),
+            .iol_len = ((len - written) < SIMCOM_SOCK_MTU) ? (len - written)
+                                                           : SIMCOM_SOCK_MTU,
+        };
+        ssize_t res = simcom_sock_sendv(&sock->base, &snip);
+        if (res < 0) {
+            if (written > 0) {
+                break;
+            }
+            return (res == -EHOSTUNREACH) ? -ECONNABORTED : res;
+        }
+        written += res;
+    }
+    return written;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_simcom_sock
+ * @{
+ *
+ * @file
+ * @brief       sock_udp implementation over SIMCOM multi-IP connections
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/af.h"
+#include "net/sock/udp.h"
+
+#include "simcom_sock_internal.h"
+
+/* used for sends without a sock */
+static sock_udp_t _tmp_sock;
+static mutex_t _tmp_lock = MUTEX_INIT;
+
+static bool _same_remote(const sock_udp_t *sock, const sock_udp_ep_t *remote)
+{
+    return (sock->remote.port == remote->port) &&
+           (memcmp(sock->remote.addr.ipv4, remote->addr.ipv4,
+                   sizeof(remote->addr.ipv4)) == 0);
+}
+
+int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
+                    const sock_udp_ep_t *remote, uint16_t flags)
+{
+    assert(sock != NULL);
+    assert(remote == NULL || remote->port != 0);
+
+    simcom_sock_setup(&sock->base);
+    memset(&sock->local, 0, sizeof(sock->local));
+    memset(&sock->remote, 0, sizeof(sock->remote));
+    sock->flags = flags;
+
+    /* the modem chooses the local address, only the port is kept */
+    if (local != NULL) {
+        sock->local = *local;
+    }
+    else {
+        sock->local.family = AF_UNSPEC;
+    }
+    if (remote != NULL) {
+        sock->remote = *remote;
+        return simcom_sock_connect(&sock->base, remote, false);
+    }
+    return 0;
+}
+
+void sock_udp_close(sock_udp_t *sock)
+{
+    assert(sock != NULL);
+    simcom_sock_disconnect(&sock->base);
+}
+
+int sock_udp_get_local(sock_udp_t *sock, sock_udp_ep_t *ep)
+{
+    assert(sock != NULL);
+    if (sock->local.family == AF_UNSPEC) {
+        return -EADDRNOTAVAIL;
+    }
+    *ep = sock->local;
+    return 0;
+}
+
+int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep)
+{
+    assert(sock != NULL);
+    if (sock->base.conn < 0) {
+        return -ENOTCONN;
+    }
+    *ep = sock->remote;
+    return 0;
+}
+
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+
+    if (*buf_ctx != NULL) {
+        simcom_sock_release(&sock->base);
+        *data = NULL;
+        *buf_ctx = NULL;
+        return 0;
+    }
+
+    int res = simcom_sock_wait(&sock->base, timeout);
+    if (res == -ECONNRESET) {
+        /* the modem dropped the connection, data of a new one may come */
+        simcom_sock_disconnect(&sock->base);
+        res = simcom_sock_wait(&sock->base, timeout);
+    }
+    if (res < 0) {
+        return res;
+    }
+
+    uint8_t *chunk;
+    size_t len = simcom_sock_peek(&sock->base, &chunk);
+    if (remote != NULL) {
+        *remote = sock->remote;
+    }
+    *data = chunk;
+    *buf_ctx = sock;
+    return len;
+}
+
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+
+    void *chunk, *ctx = NULL;
+    ssize_t res = sock_udp_recv_buf(sock, &chunk, &ctx, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    if ((size_t)res > max_len) {
+        res = -ENOBUFS;
+    }
+    else {
+        memcpy(data, chunk, res);
+    }
+    sock_udp_recv_buf(sock, &chunk, &ctx, 0, NULL);
+    return res;
+}
+
+static ssize_t _sendv(sock_udp_t *sock, const iolist_t *snips,
+                      const sock_udp_ep_t *remote)
+{
+    if (remote == NULL) {
+        if (sock->base.conn < 0) {
+            return -ENOTCONN;
+        }
+    }
+    else if ((remote->family != AF_INET) && (remote->family != AF_UNSPEC)) {
+        return -EAFNOSUPPORT;
+    }
+    else if ((sock->base.conn < 0) || !_same_remote(sock, remote) ||
+             (sock->base.state != SIMCOM_SOCK_CONNECTED)) {
+        simcom_sock_disconnect(&sock->base);
+        sock->remote = *remote;
+        int res = simcom_sock_connect(&sock->base, remote, false);
+        if (res < 0) {
+            return (res == -ENOMEM) ? -ENOMEM : -EHOSTUNREACH;
+        }
+    }
+    return simcom_sock_sendv(&sock->base, snips);
+}
+
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote)
+{
+    assert((sock != NULL) || (remote != NULL));
+
+    if ((remote != NULL) && (remote->port == 0)) {
+        return -EINVAL;
+    }
+    if (sock != NULL) {
+        return _sendv(sock, snips, remote);
+    }
+
+    mutex_lock(&_tmp_lock);
+    sock_udp_create(&_tmp_sock, NULL, NULL, 0);
+    ssize_t res = _sendv(&_tmp_sock, snips, remote);
+    sock_udp_close(&_tmp_sock);
+    mutex_unlock(&_tmp_lock);
+    return res;
+}
+
+ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
+                      const sock_udp_ep_t *remote)
+{
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+
+    iolist_t snip = {
+        .iol_next = NULL,
+        .iol_base = (void *)data,
+        .iol_len = len,
+    };
+    return sock_udp_sendv(sock, &snip, remote);
+}
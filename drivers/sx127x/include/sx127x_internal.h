@@ -109,6 +109,33 @@ void sx127x_write_fifo(const sx127x_t *dev, uint8_t *buffer, uint8_t size);
  */
 void sx127x_read_fifo(const sx127x_t *dev, uint8_t *buffer, uint8_t size);
 
+#if defined(MODULE_PERIPH_SPI_ASYNC) || defined(DOXYGEN)
+/**
+ * @name    States of the asynchronous FIFO read
+ * @{
+ */
+#define SX127X_RX_FETCH_NONE    (0)     /**< no packet read */
+#define SX127X_RX_FETCH_BUSY    (1)     /**< FIFO read in progress */
+#define SX127X_RX_FETCH_DONE    (2)     /**< packet is in the RX buffer */
+/** @} */
+
+/**
+ * @brief   Queues a read of the SX1276 FIFO into the RX buffer of the device
+ *
+ * The FIFO address pointer must be set before. The caller continues while the
+ * packet is moved by the SPI queue. Once it is done, the read state becomes
+ * SX127X_RX_FETCH_DONE and, if it completed in interrupt context, the netdev
+ * ISR event is signalled again.
+ *
+ * @param[in] dev                      The sx127x device structure pointer
+ * @param[in] size                     Number of bytes to be read from the FIFO
+ *
+ * @return  0 if the read was queued
+ * @return  <0 if it could not be queued, the read state is unchanged then
+ */
+int sx127x_read_fifo_async(sx127x_t *dev, uint8_t size);
+#endif
+
 /**
  * @brief   Reads the current RSSI value.
  *
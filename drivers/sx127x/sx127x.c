@@ -291,6 +291,15 @@ static void _on_rx_timeout(void *arg)
     dev->event_callback(dev, NETDEV_EVENT_RX_TIMEOUT);
 }
 
+static void _on_sniff_timer(void *arg)
+{
+    sx127x_t *dev = (sx127x_t *) arg;
+
+    /* the CAD is started from the netdev thread */
+    dev->_internal.sniff_wakeup = true;
+    sx127x_isr((netdev_t *)dev);
+}
+
 static void _init_timers(sx127x_t *dev)
 {
     dev->_internal.tx_timeout_timer.arg = dev;
@@ -298,6 +307,9 @@ static void _init_timers(sx127x_t *dev)
 
     dev->_internal.rx_timeout_timer.arg = dev;
     dev->_internal.rx_timeout_timer.callback = _on_rx_timeout;
+
+    dev->_internal.sniff_timer.arg = dev;
+    dev->_internal.sniff_timer.callback = _on_sniff_timer;
 }
 
 static int _init_spi(sx127x_t *dev)
@@ -228,6 +228,13 @@ void sx127x_set_rx(sx127x_t *dev)
 {
     DEBUG("[sx127x] Set RX\n");
 
+#ifdef MODULE_PERIPH_SPI_ASYNC
+    /* a packet that was never received by the upper layer is stale now */
+    if (dev->_internal.rx_fetch == SX127X_RX_FETCH_DONE) {
+        dev->_internal.rx_fetch = SX127X_RX_FETCH_NONE;
+    }
+#endif
+
     switch (dev->settings.modem) {
         case SX127X_MODEM_FSK:
             /* todo */
@@ -695,6 +702,34 @@ void sx127x_set_rx_single(sx127x_t *dev, bool single)
     _set_flag(dev, SX127X_RX_CONTINUOUS_FLAG, !single);
 }
 
+bool sx127x_get_rx_sniff(const sx127x_t *dev)
+{
+    return dev->settings.lora.flags & SX127X_RX_SNIFF_FLAG;
+}
+
+void sx127x_set_rx_sniff(sx127x_t *dev, bool sniff)
+{
+    DEBUG("[sx127x] Set RX sniff: %d\n", sniff);
+    _set_flag(dev, SX127X_RX_SNIFF_FLAG, sniff);
+}
+
+uint32_t sx127x_get_sniff_period(const sx127x_t *dev)
+{
+    uint16_t preamble_len = dev->settings.lora.preamble_len;
+
+    if (preamble_len <= SX127X_SNIFF_GUARD_SYMBOLS) {
+        return 0;
+    }
+
+    /* symbol time: 2^SF / BW, bandwidths are 125 kHz << LORA_BW_* */
+    uint32_t symbol_us = ((1UL << dev->settings.lora.datarate) * 1000UL) /
+                         (125UL << dev->settings.lora.bandwidth);
+    uint32_t period = ((preamble_len - SX127X_SNIFF_GUARD_SYMBOLS) * symbol_us) / 1000;
+
+    /* the radio needs time to wake up for the CAD */
+    return (period > SX127X_RADIO_WAKEUP_TIME) ? (period - SX127X_RADIO_WAKEUP_TIME) : 0;
+}
+
 bool sx127x_get_crc(const sx127x_t *dev)
 {
     if (dev->_internal.modem_chip == SX127X_MODEM_SX1272) {
@@ -902,6 +937,14 @@ void sx127x_set_tx_timeout(sx127x_t *dev, uint32_t timeout)
     dev->settings.lora.tx_timeout = timeout;
 }
 
+uint16_t sx127x_get_symbol_timeout(const sx127x_t *dev)
+{
+    uint8_t msb = sx127x_reg_read(dev, SX127X_REG_LR_MODEMCONFIG2) &
+                  ~SX127X_RF_LORA_MODEMCONFIG2_SYMBTIMEOUTMSB_MASK;
+
+    return (msb << 8) | sx127x_reg_read(dev, SX127X_REG_LR_SYMBTIMEOUTLSB);
+}
+
 void sx127x_set_symbol_timeout(sx127x_t *dev, uint16_t timeout)
 {
     DEBUG("[sx127x] Set symbol timeout: %d\n", timeout);
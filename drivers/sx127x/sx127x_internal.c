@@ -34,6 +34,12 @@
 
 #include "xtimer.h"
 
+#ifdef MODULE_PERIPH_SPI_ASYNC
+#include <errno.h>
+#include "irq.h"
+#include "kernel_defines.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -111,6 +117,50 @@ void sx127x_read_fifo(const sx127x_t *dev, uint8_t *buffer, uint8_t size)
     sx127x_reg_read_burst(dev, 0, buffer, size);
 }
 
+#ifdef MODULE_PERIPH_SPI_ASYNC
+static void _read_fifo_done(spi_async_xfer_t *xfer, void *arg)
+{
+    sx127x_t *dev = (sx127x_t *) arg;
+    (void)xfer;
+
+    dev->_internal.rx_fetch = SX127X_RX_FETCH_DONE;
+    /* the packet is handed on by the netdev thread */
+    if (irq_is_in() && dev->netdev.event_callback) {
+        dev->netdev.event_callback(&dev->netdev, NETDEV_EVENT_ISR);
+    }
+}
+
+int sx127x_read_fifo_async(sx127x_t *dev, uint8_t size)
+{
+    spi_async_xfer_t *xfer = dev->_internal.rx_xfer;
+
+    if (size == 0) {
+        return -EINVAL;
+    }
+
+    /* address and data are queued as one request, the FIFO is moved by DMA */
+    dev->_internal.rx_fifo_addr = SX127X_REG_FIFO & 0x7F;
+    xfer[0] = (spi_async_xfer_t){ .cs = dev->params.nss_pin,
+                                  .mode = SX127X_SPI_MODE,
+                                  .clk = SX127X_SPI_SPEED, .cont = true,
+                                  .out = &dev->_internal.rx_fifo_addr,
+                                  .len = 1 };
+    xfer[1] = (spi_async_xfer_t){ .cs = dev->params.nss_pin,
+                                  .mode = SX127X_SPI_MODE,
+                                  .clk = SX127X_SPI_SPEED,
+                                  .in = dev->_internal.rx_buf, .len = size,
+                                  .cb = _read_fifo_done, .arg = dev };
+
+    dev->_internal.rx_fetch = SX127X_RX_FETCH_BUSY;
+    int res = spi_async_submit(dev->params.spi, xfer,
+                               ARRAY_SIZE(dev->_internal.rx_xfer));
+    if (res < 0) {
+        dev->_internal.rx_fetch = SX127X_RX_FETCH_NONE;
+    }
+    return res;
+}
+#endif
+
 void sx1276_rx_chain_calibration(sx127x_t *dev)
 {
     uint8_t reg_pa_config_init_val;
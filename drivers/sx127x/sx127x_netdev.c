@@ -41,6 +41,9 @@ static void _on_dio0_irq(void *arg);
 static void _on_dio1_irq(void *arg);
 static void _on_dio2_irq(void *arg);
 static void _on_dio3_irq(void *arg);
+static void _sniff_start(sx127x_t *dev);
+static void _sniff_stop(sx127x_t *dev);
+static void _sniff_sleep(sx127x_t *dev);
 
 static int _send(netdev_t *netdev, const iolist_t *iolist)
 {
@@ -52,6 +55,8 @@ static int _send(netdev_t *netdev, const iolist_t *iolist)
         return -ENOTSUP;
     }
 
+    _sniff_stop(dev);
+
     uint8_t size = iolist_size(iolist);
 
     /* Ignore send if packet size is 0 */
@@ -116,12 +121,18 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
                 /* Clear IRQ */
                 sx127x_reg_write(dev, SX127X_REG_LR_IRQFLAGS,
                                  SX127X_RF_LORA_IRQFLAGS_PAYLOADCRCERROR);
+#ifdef MODULE_PERIPH_SPI_ASYNC
+                dev->_internal.rx_fetch = SX127X_RX_FETCH_NONE;
+#endif
 
                 if (!(dev->settings.lora.flags & SX127X_RX_CONTINUOUS_FLAG)) {
                     sx127x_set_state(dev, SX127X_RF_IDLE);
                 }
 
                 lptimer_remove(&dev->_internal.rx_timeout_timer);
+                if (dev->_internal.is_sniffing) {
+                    _sniff_sleep(dev);
+                }
                 netdev->event_callback(netdev, NETDEV_EVENT_CRC_ERROR);
                 return -EBADMSG;
             }
@@ -174,10 +185,25 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 
             lptimer_remove(&dev->_internal.rx_timeout_timer);
 
-            /* Read the last packet from FIFO */
-            uint8_t last_rx_addr = sx127x_reg_read(dev, SX127X_REG_LR_FIFORXCURRENTADDR);
-            sx127x_reg_write(dev, SX127X_REG_LR_FIFOADDRPTR, last_rx_addr);
-            sx127x_read_fifo(dev, (uint8_t*)buf, size);
+#ifdef MODULE_PERIPH_SPI_ASYNC
+            if (dev->_internal.rx_fetch == SX127X_RX_FETCH_DONE) {
+                /* already read by _on_dio0_irq() */
+                memcpy(buf, dev->_internal.rx_buf, size);
+                dev->_internal.rx_fetch = SX127X_RX_FETCH_NONE;
+            }
+            else
+#endif
+            {
+                /* Read the last packet from FIFO */
+                uint8_t last_rx_addr = sx127x_reg_read(dev, SX127X_REG_LR_FIFORXCURRENTADDR);
+                sx127x_reg_write(dev, SX127X_REG_LR_FIFOADDRPTR, last_rx_addr);
+                sx127x_read_fifo(dev, (uint8_t*)buf, size);
+            }
+
+            if (dev->_internal.is_sniffing) {
+                /* back to sniffing until the next preamble */
+                _sniff_sleep(dev);
+            }
             break;
         default:
             break;
@@ -196,6 +222,12 @@ static int _init(netdev_t *netdev)
     settings.state = SX127X_RF_IDLE;
 
     sx127x->settings = settings;
+    lptimer_remove(&sx127x->_internal.sniff_timer);
+    sx127x->_internal.is_sniffing = false;
+    sx127x->_internal.sniff_wakeup = false;
+#ifdef MODULE_PERIPH_SPI_ASYNC
+    sx127x->_internal.rx_fetch = SX127X_RX_FETCH_NONE;
+#endif
 
     /* Launch initialization of driver and device */
     DEBUG("[sx127x] netdev: initializing driver...\n");
@@ -217,6 +249,13 @@ static void _isr(netdev_t *netdev)
 {
     sx127x_t *dev = (sx127x_t *)netdev;
 
+    if (dev->_internal.sniff_wakeup) {
+        dev->_internal.sniff_wakeup = false;
+        if (dev->_internal.is_sniffing) {
+            sx127x_start_cad(dev);
+        }
+    }
+
     uint8_t interruptReg = sx127x_reg_read(dev, SX127X_REG_LR_IRQFLAGS);
 
     if (interruptReg & (SX127X_RF_LORA_IRQFLAGS_TXDONE |
@@ -313,6 +352,11 @@ static int _get(netdev_t *netdev, netopt_t opt, void *val, size_t max_len)
             *((netopt_enable_t*) val) = sx127x_get_iq_invert(dev) ? NETOPT_ENABLE : NETOPT_DISABLE;
             return sizeof(netopt_enable_t);
 
+        case NETOPT_RX_SNIFF:
+            assert(max_len >= sizeof(netopt_enable_t));
+            *((netopt_enable_t*) val) = sx127x_get_rx_sniff(dev) ? NETOPT_ENABLE : NETOPT_DISABLE;
+            return sizeof(netopt_enable_t);
+
         default:
             break;
     }
@@ -442,6 +486,23 @@ static int _set(netdev_t *netdev, netopt_t opt, const void *val, size_t len)
             sx127x_set_iq_invert(dev, *((const netopt_enable_t*) val) ? true : false);
             return sizeof(bool);
 
+        case NETOPT_RX_SNIFF:
+            assert(len <= sizeof(netopt_enable_t));
+            sx127x_set_rx_sniff(dev, *((const netopt_enable_t*) val) ? true : false);
+            /* switch a running listening period over */
+            if (dev->_internal.is_sniffing && !sx127x_get_rx_sniff(dev)) {
+                _sniff_stop(dev);
+                sx127x_set_rx(dev);
+            }
+            else if (!dev->_internal.is_sniffing && sx127x_get_rx_sniff(dev) &&
+                     (sx127x_get_state(dev) == SX127X_RF_RX_RUNNING) &&
+                     (dev->settings.lora.rx_timeout == 0) &&
+                     !(sx127x_reg_read(dev, SX127X_REG_LR_MODEMSTAT) &
+                       SX127X_RF_LORA_MODEMSTAT_MODEM_STATUS_SIGNAL_DETECTED)) {
+                _sniff_start(dev);
+            }
+            return sizeof(netopt_enable_t);
+
         default:
             break;
     }
@@ -451,6 +512,8 @@ static int _set(netdev_t *netdev, netopt_t opt, const void *val, size_t len)
 
 static int _set_state(sx127x_t *dev, netopt_state_t state)
 {
+    _sniff_stop(dev);
+
     switch (state) {
         case NETOPT_STATE_SLEEP:
             sx127x_set_sleep(dev);
@@ -463,10 +526,19 @@ static int _set_state(sx127x_t *dev, netopt_state_t state)
         case NETOPT_STATE_IDLE:
             /* set permanent listening */
             sx127x_set_rx_timeout(dev, 0);
+            if (sx127x_get_rx_sniff(dev)) {
+                _sniff_start(dev);
+                break;
+            }
             sx127x_set_rx(dev);
             break;
 
         case NETOPT_STATE_RX:
+            /* only listening without timeout is done by sniffing */
+            if (sx127x_get_rx_sniff(dev) && (dev->settings.lora.rx_timeout == 0)) {
+                _sniff_start(dev);
+                break;
+            }
             sx127x_set_rx(dev);
             break;
 
@@ -493,6 +565,15 @@ static int _get_state(sx127x_t *dev, void *val)
     uint8_t op_mode;
     op_mode = sx127x_get_op_mode(dev);
     netopt_state_t state = NETOPT_STATE_OFF;
+
+    /* sleeping between CADs is still listening */
+    if (dev->_internal.is_sniffing &&
+        (sx127x_get_state(dev) != SX127X_RF_RX_RUNNING)) {
+        state = NETOPT_STATE_IDLE;
+        memcpy(val, &state, sizeof(netopt_state_t));
+        return sizeof(netopt_state_t);
+    }
+
     switch(op_mode) {
         case SX127X_RF_OPMODE_SLEEP:
             state = NETOPT_STATE_SLEEP;
@@ -526,6 +607,21 @@ static int _get_state(sx127x_t *dev, void *val)
     return sizeof(netopt_state_t);
 }
 
+#ifdef MODULE_PERIPH_SPI_ASYNC
+static void _fetch_packet(sx127x_t *dev)
+{
+    if (dev->settings.modem != SX127X_MODEM_LORA) {
+        return;
+    }
+
+    uint8_t size = sx127x_reg_read(dev, SX127X_REG_LR_RXNBBYTES);
+    uint8_t last_rx_addr = sx127x_reg_read(dev, SX127X_REG_LR_FIFORXCURRENTADDR);
+    sx127x_reg_write(dev, SX127X_REG_LR_FIFOADDRPTR, last_rx_addr);
+    /* on failure _recv() reads the FIFO itself */
+    sx127x_read_fifo_async(dev, size);
+}
+#endif
+
 static void _on_dio0_irq(void *arg)
 {
     sx127x_t *dev = (sx127x_t *) arg;
@@ -533,6 +629,16 @@ static void _on_dio0_irq(void *arg)
 
     switch (dev->settings.state) {
         case SX127X_RF_RX_RUNNING:
+#ifdef MODULE_PERIPH_SPI_ASYNC
+            /* the thread continues while the packet is read, the event
+             * follows when the read is done */
+            if (dev->_internal.rx_fetch == SX127X_RX_FETCH_NONE) {
+                _fetch_packet(dev);
+            }
+            if (dev->_internal.rx_fetch == SX127X_RX_FETCH_BUSY) {
+                break;
+            }
+#endif
             DEBUG("sx127x_on_dio0: NETDEV_EVENT_RX_COMPLETE\n");
             netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
             break;
@@ -580,6 +686,12 @@ static void _on_dio1_irq(void *arg)
                     /*  Clear Irq */
                     DEBUG("sx127x_on_dio1: clear IRQ\n");
                     sx127x_reg_write(dev, SX127X_REG_LR_IRQFLAGS, SX127X_RF_LORA_IRQFLAGS_RXTIMEOUT);
+                    if (dev->_internal.is_sniffing) {
+                        /* no frame followed the detected activity */
+                        DEBUG("sx127x_on_dio1: sniff false alarm\n");
+                        _sniff_sleep(dev);
+                        break;
+                    }
                     sx127x_set_state(dev, SX127X_RF_IDLE);
                     netdev->event_callback(netdev, NETDEV_EVENT_RX_TIMEOUT);
                     DEBUG("sx127x_on_dio1: NETDEV_EVENT_RX_TIMEOUT\n");
@@ -681,6 +793,28 @@ static void _on_dio3_irq(void *arg)
                 dev->_internal.is_last_cad_success = ((sx127x_reg_read(dev, SX127X_REG_LR_IRQFLAGS) &
                                                        SX127X_RF_LORA_IRQFLAGS_CADDETECTED) ==
                                                        SX127X_RF_LORA_IRQFLAGS_CADDETECTED);
+
+                if (dev->_internal.is_sniffing) {
+                    /* sniff CADs are not reported */
+                    if (cad_success) {
+                        DEBUG("sx127x_on_dio3: preamble sniffed\n");
+                        /* wait for the sync word for the rest of the preamble,
+                         * the timeout register has 10 bits */
+                        uint16_t timeout = dev->settings.lora.preamble_len;
+                        if (timeout > SX127X_SYMBOL_TIMEOUT_MAX) {
+                            timeout = SX127X_SYMBOL_TIMEOUT_MAX;
+                        }
+                        uint8_t flags = dev->settings.lora.flags;
+                        dev->settings.lora.flags &= ~SX127X_RX_CONTINUOUS_FLAG;
+                        sx127x_set_symbol_timeout(dev, timeout);
+                        sx127x_set_rx(dev);
+                        dev->settings.lora.flags = flags;
+                    }
+                    else {
+                        _sniff_sleep(dev);
+                    }
+                    break;
+                }
                 
                 if (cad_success) {
                     netdev->event_callback(netdev, NETDEV_EVENT_CAD_DETECTED);
@@ -695,6 +829,43 @@ static void _on_dio3_irq(void *arg)
     }
 }
 
+static void _sniff_sleep(sx127x_t *dev)
+{
+    uint32_t period = sx127x_get_sniff_period(dev);
+
+    if (period == 0) {
+        /* preamble too short to sleep, sniff right away */
+        sx127x_start_cad(dev);
+        return;
+    }
+    sx127x_set_op_mode(dev, SX127X_RF_OPMODE_SLEEP);
+    sx127x_set_state(dev, SX127X_RF_IDLE);
+    lptimer_set(&dev->_internal.sniff_timer, period);
+}
+
+static void _sniff_start(sx127x_t *dev)
+{
+    DEBUG("[sx127x] sniff start, period %lu ms\n",
+          (unsigned long)sx127x_get_sniff_period(dev));
+    /* sniffing changes the symbol timeout for the receptions */
+    dev->_internal.symbol_timeout = sx127x_get_symbol_timeout(dev);
+    dev->_internal.is_sniffing = true;
+    dev->_internal.sniff_wakeup = false;
+    sx127x_start_cad(dev);
+}
+
+static void _sniff_stop(sx127x_t *dev)
+{
+    if (!dev->_internal.is_sniffing) {
+        return;
+    }
+    DEBUG("[sx127x] sniff stop\n");
+    lptimer_remove(&dev->_internal.sniff_timer);
+    dev->_internal.is_sniffing = false;
+    dev->_internal.sniff_wakeup = false;
+    sx127x_set_symbol_timeout(dev, dev->_internal.symbol_timeout);
+}
+
 const netdev_driver_t sx127x_driver = {
     .send = _send,
     .recv = _recv,
@@ -1,3 +1,4 @@
+PSEUDOMODULES += at_async
 PSEUDOMODULES += at_urc
 PSEUDOMODULES += auto_init_gnrc_rpl
 PSEUDOMODULES += can_mbox
@@ -11,6 +12,7 @@ PSEUDOMODULES += core_%
 PSEUDOMODULES += cortexm_fpu
 PSEUDOMODULES += ecc_%
 PSEUDOMODULES += emb6_router
+PSEUDOMODULES += emcute_pub_async
 PSEUDOMODULES += event_%
 PSEUDOMODULES += gnrc_ipv6_default
 PSEUDOMODULES += gnrc_ipv6_router
@@ -43,6 +45,7 @@ PSEUDOMODULES += log
 PSEUDOMODULES += log_printfnoformat
 PSEUDOMODULES += lora
 PSEUDOMODULES += mpu_stack_guard
+PSEUDOMODULES += mtd_spi_nor_async
 PSEUDOMODULES += nanocoap_%
 PSEUDOMODULES += netdev_default
 PSEUDOMODULES += netif
@@ -67,6 +70,7 @@ PSEUDOMODULES += saul_gpio
 PSEUDOMODULES += schedstatistics
 PSEUDOMODULES += shell_password
 PSEUDOMODULES += sock
+PSEUDOMODULES += sock_dns_cache
 PSEUDOMODULES += sock_ip
 PSEUDOMODULES += sock_tcp
 PSEUDOMODULES += sock_udp
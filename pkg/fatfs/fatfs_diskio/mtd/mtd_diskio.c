@@ -190,8 +190,24 @@ DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
 #endif
 
 #if (FF_USE_TRIM == 1)
-        case CTRL_TRIM:
-            return RES_OK;
+        case CTRL_TRIM: {
+            /* buff holds the first and the last sector of the range that
+               is no longer used, only whole erase sectors are erased */
+            mtd_dev_t *mtd = fatfs_mtd_devs[pdrv];
+            DWORD start = ((DWORD *)buff)[0];
+            DWORD end = ((DWORD *)buff)[1] + 1;
+
+            start = ((start + mtd->pages_per_sector - 1) / mtd->pages_per_sector) *
+                    mtd->pages_per_sector;
+            end = (end / mtd->pages_per_sector) * mtd->pages_per_sector;
+            if (start >= end) {
+                return RES_OK;
+            }
+
+            int res = mtd_erase(mtd, start * mtd->page_size,
+                                (end - start) * mtd->page_size);
+            return (res == 0) ? RES_OK : RES_ERROR;
+        }
 #endif
     }
 
@@ -27,6 +27,9 @@
 #include "fs/littlefs_fs.h"
 
 #include "kernel_defines.h"
+#ifdef MODULE_MTD_SPI_NOR_ASYNC
+#include "mtd_spi_nor.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include <debug.h>
@@ -105,6 +108,35 @@ static int _dev_write(const struct lfs_config *c, lfs_block_t block,
     return 0;
 }
 
+#ifdef MODULE_MTD_SPI_NOR_ASYNC
+/* the lookahead allocator hands out the free blocks in order, so the next one
+ * is queued to be erased in the background while this one is used */
+static void _pre_erase_next(littlefs_desc_t *fs)
+{
+    const lfs_free_t *la = &fs->fs.free;
+    lfs_block_t i = la->i;
+
+    if (fs->dev->driver != &mtd_spi_nor_driver) {
+        return;
+    }
+    while ((i < la->size) && (la->buffer[i / 32] & (1U << (i % 32)))) {
+        i++;
+    }
+    if (i >= la->size) {
+        return;
+    }
+
+    lfs_block_t block = (la->off + i) % fs->config.block_count;
+    uint32_t sector_size = fs->dev->page_size * fs->dev->pages_per_sector;
+    uint32_t addr = (fs->base_addr + block) * fs->config.block_size;
+    for (uint32_t off = 0; off < fs->config.block_size; off += sector_size) {
+        if (mtd_spi_nor_pre_erase((mtd_spi_nor_t *)fs->dev, addr + off) < 0) {
+            break;
+        }
+    }
+}
+#endif
+
 static int _dev_erase(const struct lfs_config *c, lfs_block_t block)
 {
     littlefs_desc_t *fs = c->context;
@@ -114,6 +146,9 @@ static int _dev_erase(const struct lfs_config *c, lfs_block_t block)
 
     int ret = mtd_erase(mtd, ((fs->base_addr + block) * c->block_size), c->block_size);
     if (ret >= 0) {
+#ifdef MODULE_MTD_SPI_NOR_ASYNC
+        _pre_erase_next(fs);
+#endif
         return 0;
     }
 
@@ -122,9 +157,11 @@ static int _dev_erase(const struct lfs_config *c, lfs_block_t block)
 
 static int _dev_sync(const struct lfs_config *c)
 {
-    (void)c;
+    littlefs_desc_t *fs = c->context;
 
-    return 0;
+    DEBUG("lfs_sync: c=%p\n", (void *)c);
+
+    return mtd_flush(fs->dev);
 }
 
 static int prepare(littlefs_desc_t *fs)
@@ -211,10 +248,13 @@ static int _umount(vfs_mount_t *mountp)
 
     DEBUG("littlefs: umount: mountp=%p\n", (void *)mountp);
 
-    int ret = lfs_unmount(&fs->fs);
+    int ret = littlefs_err_to_errno(lfs_unmount(&fs->fs));
+    if (ret == 0) {
+        ret = mtd_flush(fs->dev);
+    }
     mutex_unlock(&fs->lock);
 
-    return littlefs_err_to_errno(ret);
+    return ret;
 }
 
 static int _unlink(vfs_mount_t *mountp, const char *name)
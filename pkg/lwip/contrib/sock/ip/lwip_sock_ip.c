@@ -104,7 +104,7 @@ static uint16_t _ip6_addr_to_netif(const ip6_addr_p_t *_addr)
 }
 #endif
 
-static int _parse_iphdr(const struct netbuf *buf, void *data, size_t max_len,
+static int _parse_iphdr(const struct netbuf *buf, void **data,
                         sock_ip_ep_t *remote)
 {
     uint8_t *data_ptr = buf->p->payload;
@@ -115,9 +115,6 @@ static int _parse_iphdr(const struct netbuf *buf, void *data, size_t max_len,
     switch (data_ptr[0] >> 4) {
 #if LWIP_IPV4
         case 4:
-            if ((data_len - sizeof(struct ip_hdr)) > max_len) {
-                return -ENOBUFS;
-            }
             if (remote != NULL) {
                 struct ip_hdr *iphdr = (struct ip_hdr *)data_ptr;
 
@@ -132,9 +129,6 @@ static int _parse_iphdr(const struct netbuf *buf, void *data, size_t max_len,
 #endif
 #if LWIP_IPV6
         case 6:
-            if ((data_len - sizeof(struct ip6_hdr)) > max_len) {
-                return -ENOBUFS;
-            }
             if (remote != NULL) {
                 struct ip6_hdr *iphdr = (struct ip6_hdr *)data_ptr;
 
@@ -150,7 +144,7 @@ static int _parse_iphdr(const struct netbuf *buf, void *data, size_t max_len,
         default:
             return -EPROTO;
     }
-    memcpy(data, data_ptr, data_len);
+    *data = data_ptr;
     return (ssize_t)data_len;
 }
 
@@ -158,17 +152,50 @@ ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
                      uint32_t timeout, sock_ip_ep_t *remote)
 {
     struct netbuf *buf;
+    void *data_ptr;
     int res;
 
     assert((sock != NULL) && (data != NULL) && (max_len > 0));
     if ((res = lwip_sock_recv(sock->conn, timeout, &buf)) < 0) {
         return res;
     }
-    res = _parse_iphdr(buf, data, max_len, remote);
+    res = _parse_iphdr(buf, &data_ptr, remote);
+    if ((res > 0) && ((size_t)res > max_len)) {
+        res = -ENOBUFS;
+    }
+    else if (res > 0) {
+        memcpy(data, data_ptr, res);
+    }
     netbuf_delete(buf);
     return res;
 }
 
+ssize_t sock_ip_recv_buf(sock_ip_t *sock, void **data, void **buf_ctx,
+                         uint32_t timeout, sock_ip_ep_t *remote)
+{
+    struct netbuf *buf;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        /* _parse_iphdr() only handles messages in one pbuf */
+        *data = NULL;
+        netbuf_delete(*buf_ctx);
+        *buf_ctx = NULL;
+        return 0;
+    }
+    if ((res = lwip_sock_recv(sock->conn, timeout, &buf)) < 0) {
+        return res;
+    }
+    res = _parse_iphdr(buf, data, remote);
+    if (res <= 0) {
+        netbuf_delete(buf);
+        return res;
+    }
+    *buf_ctx = buf;
+    return res;
+}
+
 ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
                      uint8_t proto, const sock_ip_ep_t *remote)
 {
@@ -178,4 +205,12 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
                           (struct _sock_tl_ep *)remote, NETCONN_RAW);
 }
 
+ssize_t sock_ip_sendv(sock_ip_t *sock, const iolist_t *snips, uint8_t proto,
+                      const sock_ip_ep_t *remote)
+{
+    assert((sock != NULL) || (remote != NULL));
+    return lwip_sock_sendv(&sock->conn, snips, proto,
+                           (struct _sock_tl_ep *)remote, NETCONN_RAW);
+}
+
 /** @} */
@@ -211,13 +211,23 @@ static int _mount(vfs_mount_t *mountp)
     return spiffs_err_to_errno(ret);
 }
 
+static int _flush(spiffs_desc_t *fs_desc)
+{
+#if SPIFFS_HAL_CALLBACK_EXTRA == 1
+    return mtd_flush(fs_desc->dev);
+#else
+    (void)fs_desc;
+    return mtd_flush(SPIFFS_MTD_DEV);
+#endif
+}
+
 static int _umount(vfs_mount_t *mountp)
 {
     spiffs_desc_t *fs_desc = mountp->private_data;
 
     SPIFFS_unmount(&fs_desc->fs);
 
-    return 0;
+    return _flush(fs_desc);
 }
 
 static int _unlink(vfs_mount_t *mountp, const char *name)
@@ -311,7 +321,11 @@ static int _close(vfs_file_t *filp)
 {
     spiffs_desc_t *fs_desc = filp->mp->private_data;
 
-    return spiffs_err_to_errno(SPIFFS_close(&fs_desc->fs, filp->private_data.value));
+    int ret = spiffs_err_to_errno(SPIFFS_close(&fs_desc->fs, filp->private_data.value));
+    if (ret < 0) {
+        return ret;
+    }
+    return _flush(fs_desc);
 }
 
 static ssize_t _write(vfs_file_t *filp, const void *src, size_t nbytes)
@@ -32,6 +32,10 @@
 #include "lptimer.h"
 #endif
 
+#ifdef MODULE_SAUL_SAMPLER
+#include "saul_sampler.h"
+#endif
+
 #ifdef MODULE_GNRC_SIXLOWPAN
 #include "net/gnrc/sixlowpan.h"
 #endif
@@ -505,6 +509,11 @@ void auto_init(void)
 
 #endif /* MODULE_AUTO_INIT_SAUL */
 
+#ifdef MODULE_SAUL_SAMPLER
+    DEBUG("Auto init SAUL sampler\n");
+    saul_sampler_init();
+#endif
+
 #ifdef MODULE_AUTO_INIT_GNRC_RPL
 
 #ifdef MODULE_GNRC_RPL
@@ -19,11 +19,41 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "benchmark.h"
+#include "matstat.h"
+
+#ifdef BOARD_NATIVE
+#include <time.h>
+#include "native_internal.h"
+#endif
+
+void benchmark_cycles_init(void)
+{
+#ifdef BENCHMARK_HAS_DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+#ifndef BENCHMARK_HAS_DWT
+uint32_t benchmark_cycles_now(void)
+{
+#ifdef BOARD_NATIVE
+    struct timespec t;
+
+    real_clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint32_t)((uint64_t)t.tv_sec * US_PER_SEC * NS_PER_US + t.tv_nsec);
+#else
+    return xtimer_now().ticks32;
+#endif
+}
+#endif
 
 void benchmark_print_time(uint32_t time, unsigned long runs, const char *name)
 {
+#if BENCHMARK_FORMAT == BENCHMARK_FORMAT_TEXT
     uint32_t full = (time / runs);
     uint32_t div  = (time - (full * runs)) / (runs / 1000);
 
@@ -33,4 +63,67 @@ void benchmark_print_time(uint32_t time, unsigned long runs, const char *name)
            "  ---  %2" PRIu32 ".%03" PRIu32 "us per call"
            "  ---  %9" PRIu32 " calls per sec\n",
            name, time, full, div, per_sec);
+#else
+    uint32_t ns = (uint32_t)(((uint64_t)time * NS_PER_US) / runs);
+#if BENCHMARK_FORMAT == BENCHMARK_FORMAT_CSV
+    printf("%s,ns,%lu,,,,,%" PRIu32 ",\n", name, runs, ns);
+#else
+    printf("{\"name\":\"%s\",\"unit\":\"ns\",\"runs\":%lu,\"mean\":%" PRIu32 "}\n",
+           name, runs, ns);
+#endif
+#endif
+}
+
+static int _cmp(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+void benchmark_print_samples(const char *name, uint32_t *samples,
+                             unsigned long count)
+{
+    matstat_state_t stat = MATSTAT_STATE_INIT;
+
+    if (!count) {
+        return;
+    }
+
+    qsort(samples, count, sizeof(samples[0]), _cmp);
+    for (unsigned long i = 0; i < count; i++) {
+        matstat_add(&stat, (int32_t)samples[i]);
+    }
+
+    uint32_t median = samples[(count - 1) / 2];
+    uint32_t p99 = samples[((count - 1) * 99) / 100];
+    int32_t mean = matstat_mean(&stat);
+
+#if BENCHMARK_FORMAT == BENCHMARK_FORMAT_TEXT
+    printf("%25s: min %6" PRIu32 "  median %6" PRIu32 "  p99 %6" PRIu32
+           "  max %6" PRIu32 "  mean %6" PRId32 " " BENCHMARK_CYCLES_UNIT "\n",
+           name, samples[0], median, p99, samples[count - 1], mean);
+#elif BENCHMARK_FORMAT == BENCHMARK_FORMAT_CSV
+    printf("%s," BENCHMARK_CYCLES_UNIT ",%lu,%" PRIu32 ",%" PRIu32 ",%" PRIu32
+           ",%" PRIu32 ",%" PRId32 ",\n",
+           name, count, samples[0], median, p99, samples[count - 1], mean);
+#else
+    printf("{\"name\":\"%s\",\"unit\":\"" BENCHMARK_CYCLES_UNIT "\",\"runs\":%lu,"
+           "\"min\":%" PRIu32 ",\"median\":%" PRIu32 ",\"p99\":%" PRIu32 ","
+           "\"max\":%" PRIu32 ",\"mean\":%" PRId32 "}\n",
+           name, count, samples[0], median, p99, samples[count - 1], mean);
+#endif
+}
+
+void benchmark_print_value(const char *name, uint32_t value, const char *unit)
+{
+#if BENCHMARK_FORMAT == BENCHMARK_FORMAT_TEXT
+    printf("%25s: %9" PRIu32 " %s\n", name, value, unit);
+#elif BENCHMARK_FORMAT == BENCHMARK_FORMAT_CSV
+    printf("%s,%s,,,,,,,%" PRIu32 "\n", name, unit, value);
+#else
+    printf("{\"name\":\"%s\",\"unit\":\"%s\",\"value\":%" PRIu32 "}\n",
+           name, unit, value);
+#endif
 }
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     sys_dsp
+ * @{
+ *
+ * @file
+ * @brief       Fixed-point decimation and block statistics
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include "dsp/int_math/int_sqrt.h"
+#include "dsp/int_stats/int_stats.h"
+
+void int_stats_reset(int_stats_t *stats)
+{
+    stats->count = 0;
+    stats->min = UINT16_MAX;
+    stats->max = 0;
+    stats->sum = 0;
+    stats->sum_sq = 0;
+}
+
+void int_stats_add(int_stats_t *stats, uint16_t value)
+{
+    stats->count++;
+    if (value < stats->min) {
+        stats->min = value;
+    }
+    if (value > stats->max) {
+        stats->max = value;
+    }
+    stats->sum += value;
+    stats->sum_sq += (uint32_t)value * value;
+}
+
+uint16_t int_stats_mean(const int_stats_t *stats)
+{
+    if (stats->count == 0) {
+        return 0;
+    }
+    return (stats->sum + stats->count / 2) / stats->count;
+}
+
+uint16_t int_stats_rms(const int_stats_t *stats)
+{
+    if (stats->count == 0) {
+        return 0;
+    }
+    /* the mean square of 16 bit samples fits into 32 bit */
+    return int_sqrt_32(stats->sum_sq / stats->count);
+}
+
+void int_decim_init(int_decim_t *decim, uint16_t factor)
+{
+    decim->acc = 0;
+    decim->count = 0;
+    decim->factor = (factor > 0) ? factor : 1;
+}
+
+void int_decim_process(int_decim_t *decim, int_stats_t *stats,
+                       const uint16_t *samples, size_t numof, size_t stride)
+{
+    for (size_t i = 0; i < numof; i++, samples += stride) {
+        decim->acc += *samples;
+        if (++decim->count == decim->factor) {
+            int_stats_add(stats, (decim->acc + decim->factor / 2) / decim->factor);
+            decim->acc = 0;
+            decim->count = 0;
+        }
+    }
+}
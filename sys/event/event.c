@@ -119,7 +119,7 @@ event_t *event_wait_timeout(event_queue_t *queue, uint32_t timeout)
 {
     assert(queue);
     event_t *result;
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     thread_flags_t flags = 0;
 
     xtimer_set_timeout_flag(&timer, timeout);
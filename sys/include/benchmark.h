@@ -10,6 +10,17 @@
  * @defgroup    sys_benchmark Benchmark
  * @ingroup     sys
  * @brief       Framework for running simple runtime benchmarks
+ *
+ * Besides timing a whole loop with @ref BENCHMARK_FUNC, single runs can be
+ * timed with the CPU's cycle counter where available (DWT CYCCNT on
+ * Cortex-M3 and up, the monotonic host clock in ns on native, xtimer ticks
+ * elsewhere) using @ref BENCHMARK_SAMPLES. The samples are reported as
+ * min/median/p99/max and mean, the mean being computed with @ref sys_matstat.
+ *
+ * Results are printed in the format selected by @ref BENCHMARK_FORMAT: human
+ * readable text, CSV or JSON lines. dist/tools/benchmark/run_benchmarks.py
+ * runs the bench_* tests on native with JSON output and compares them
+ * against a stored baseline.
  * @{
  *
  * @file
@@ -25,11 +36,70 @@
 
 #include "irq.h"
 #include "xtimer.h"
+#if defined(CPU_ARCH_CORTEX_M3) || defined(CPU_ARCH_CORTEX_M4) || \
+    defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)
+#include "cpu.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @name    Output formats
+ * @{
+ */
+#define BENCHMARK_FORMAT_TEXT   (0)     /**< human readable */
+#define BENCHMARK_FORMAT_CSV    (1)     /**< comma separated values, columns
+                                             name,unit,runs,min,median,p99,
+                                             max,mean,value */
+#define BENCHMARK_FORMAT_JSON   (2)     /**< one JSON object per line */
+/** @} */
+
+#ifndef BENCHMARK_FORMAT
+/**
+ * @brief   Output format of all benchmark_print_*() functions
+ */
+#define BENCHMARK_FORMAT        BENCHMARK_FORMAT_TEXT
+#endif
+
+#if defined(CPU_ARCH_CORTEX_M3) || defined(CPU_ARCH_CORTEX_M4) || \
+    defined(CPU_ARCH_CORTEX_M4F) || defined(CPU_ARCH_CORTEX_M7)
+/**
+ * @brief   Unit of the values returned by benchmark_cycles_now()
+ */
+#define BENCHMARK_CYCLES_UNIT   "cycles"
+/**
+ * @brief   The DWT cycle counter can be read inline
+ */
+#define BENCHMARK_HAS_DWT       (1)
+#elif defined(BOARD_NATIVE)
+#define BENCHMARK_CYCLES_UNIT   "ns"
+#else
+#define BENCHMARK_CYCLES_UNIT   "ticks"
+#endif
+
+/**
+ * @brief   Enable the cycle counter
+ *
+ * Called by @ref BENCHMARK_SAMPLES, calling it more than once is harmless.
+ */
+void benchmark_cycles_init(void);
+
+/**
+ * @brief   Read the cycle counter
+ *
+ * @return  current counter value in @ref BENCHMARK_CYCLES_UNIT, wraps around
+ */
+#ifdef BENCHMARK_HAS_DWT
+static inline uint32_t benchmark_cycles_now(void)
+{
+    return DWT->CYCCNT;
+}
+#else
+uint32_t benchmark_cycles_now(void);
+#endif
+
 /**
  * @brief   Measure the runtime of a given function call
  *
@@ -53,6 +123,31 @@ extern "C" {
         benchmark_print_time(_benchmark_time, runs, name);      \
     }
 
+/**
+ * @brief   Measure each run of a given function call with the cycle counter
+ *
+ * Interrupts are disabled during each run only, so the samples show the
+ * spread of the function itself rather than of the system.
+ *
+ * @param[in] name      name for labeling the output
+ * @param[out] samples  uint32_t array of at least @p runs entries, sorted
+ *                      on return
+ * @param[in] runs      number of times to run @p func
+ * @param[in] func      function call to benchmark
+ */
+#define BENCHMARK_SAMPLES(name, samples, runs, func)                        \
+    {                                                                       \
+        benchmark_cycles_init();                                            \
+        for (unsigned long i = 0; i < runs; i++) {                          \
+            unsigned _benchmark_irqstate = irq_disable();                   \
+            uint32_t _benchmark_start = benchmark_cycles_now();             \
+            func;                                                           \
+            samples[i] = benchmark_cycles_now() - _benchmark_start;         \
+            irq_restore(_benchmark_irqstate);                               \
+        }                                                                   \
+        benchmark_print_samples(name, samples, runs);                       \
+    }
+
 /**
  * @brief   Output the given time as well as the time per run on STDIO
  *
@@ -62,6 +157,30 @@ extern "C" {
  */
 void benchmark_print_time(uint32_t time, unsigned long runs, const char *name);
 
+/**
+ * @brief   Sort the given samples and output their statistics on STDIO
+ *
+ * Prints min, median, 99th percentile, max and mean in
+ * @ref BENCHMARK_CYCLES_UNIT.
+ *
+ * @param[in] name      name to label the output
+ * @param[in,out] samples   samples, sorted on return
+ * @param[in] count     number of samples
+ */
+void benchmark_print_samples(const char *name, uint32_t *samples,
+                             unsigned long count);
+
+/**
+ * @brief   Output a single result value on STDIO
+ *
+ * For benchmarks reporting a throughput rather than a duration.
+ *
+ * @param[in] name      name to label the output
+ * @param[in] value     result
+ * @param[in] unit      unit of @p value, e.g. "ops/s"
+ */
+void benchmark_print_value(const char *name, uint32_t value, const char *unit);
+
 #ifdef __cplusplus
 }
 #endif
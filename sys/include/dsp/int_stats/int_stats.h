@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     sys_dsp
+ * @{
+ *
+ * @file
+ * @brief       Fixed-point decimation and block statistics
+ * @details     Samples are averaged in blocks of a decimation factor (boxcar
+ *              filter), the averages are collected into minimum, mean,
+ *              maximum and RMS over a period. This suits sample buffers filled
+ *              by DMA: a buffer half is processed at once, with the channels
+ *              of a scan interleaved at a stride.
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+#ifndef INT_STATS_H
+#define INT_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Statistics over a period
+ */
+typedef struct {
+    uint32_t count;                 /**< number of samples                  */
+    uint16_t min;                   /**< smallest sample                    */
+    uint16_t max;                   /**< largest sample                     */
+    uint64_t sum;                   /**< sum of the samples                 */
+    uint64_t sum_sq;                /**< sum of the squared samples         */
+} int_stats_t;
+
+/**
+ * @brief Boxcar decimation state
+ */
+typedef struct {
+    uint32_t acc;                   /**< sum of the current block           */
+    uint16_t count;                 /**< samples in the current block       */
+    uint16_t factor;                /**< samples per output                 */
+} int_decim_t;
+
+/**
+ * @brief Starts a new period
+ *
+ * @param[out] stats    statistics to reset
+ */
+void int_stats_reset(int_stats_t *stats);
+
+/**
+ * @brief Adds a sample to the statistics
+ *
+ * @param[in/out] stats statistics
+ * @param[in]     value sample
+ */
+void int_stats_add(int_stats_t *stats, uint16_t value);
+
+/**
+ * @brief Computes the rounded mean of the period
+ *
+ * @param[in] stats     statistics
+ * @return    mean of the samples, 0 if there are none
+ */
+uint16_t int_stats_mean(const int_stats_t *stats);
+
+/**
+ * @brief Computes the root mean square of the period
+ *
+ * @param[in] stats     statistics
+ * @return    RMS of the samples, including their mean, 0 if there are none
+ */
+uint16_t int_stats_rms(const int_stats_t *stats);
+
+/**
+ * @brief Initializes the decimation state
+ *
+ * @param[out] decim    decimation state
+ * @param[in]  factor   number of samples averaged into one output, 1 passes
+ *                      the samples through
+ */
+void int_decim_init(int_decim_t *decim, uint16_t factor);
+
+/**
+ * @brief Decimates samples into statistics
+ *
+ * Blocks that are not complete at the end of @p samples are continued by the
+ * next call.
+ *
+ * @param[in/out] decim   decimation state
+ * @param[in/out] stats   statistics the averages are added to
+ * @param[in]     samples first sample
+ * @param[in]     numof   number of samples to process
+ * @param[in]     stride  distance between consecutive samples, in samples
+ */
+void int_decim_process(int_decim_t *decim, int_stats_t *stats,
+                       const uint16_t *samples, size_t numof, size_t stride);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INT_STATS_H */
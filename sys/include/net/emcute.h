@@ -59,6 +59,8 @@
  * - updating will message
  * - sending out periodic PINGREQ messages
  * - handling re-transmits
+ * - publishing without waiting for the PUBACK of the previous message
+ *   (see @ref net_emcute_pub_async)
  *
  * The following features are however still missing (but planned):
  * @todo        Gateway discovery (so far there is no support for handling
@@ -75,6 +77,17 @@
  * @todo        react only to incoming ping requests that are actually send by
  *              the gateway we are connected to
  *
+ * # Asynchronous publishing {#net_emcute_pub_async}
+ * emcute_pub() blocks until the PUBACK of a QoS 1 message arrives, so at most
+ * one message is sent per round trip to the gateway. With the
+ * `emcute_pub_async` module, emcute_pub_async() returns as soon as the message
+ * was sent. Up to @ref EMCUTE_PUB_WINDOW QoS 1 messages are in flight at the
+ * same time. The emCute thread retransmits them after @ref EMCUTE_T_RETRY
+ * seconds with the DUP flag set and reports the PUBACK, a rejection, or a
+ * timeout to the callback given with the message. Each message in flight keeps
+ * a copy of its packet, so the module needs @ref EMCUTE_PUB_WINDOW times
+ * @ref EMCUTE_BUFSIZE bytes of additional RAM.
+ *
  * @{
  * @file
  * @brief       emCute MQTT-SN interface definition
@@ -164,6 +177,14 @@ extern "C" {
 #define EMCUTE_N_RETRY          (3U)
 #endif
 
+#ifndef EMCUTE_PUB_WINDOW
+/**
+ * @brief   Number of QoS 1 messages that can be in flight at the same time
+ *          with emcute_pub_async()
+ */
+#define EMCUTE_PUB_WINDOW       (4U)
+#endif
+
 /**
  * @brief   MQTT-SN flags
  *
@@ -293,6 +314,61 @@ int emcute_reg(emcute_topic_t *topic);
 int emcute_pub(emcute_topic_t *topic, const void *buf, size_t len,
                unsigned flags);
 
+#if defined(MODULE_EMCUTE_PUB_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Signature for callbacks fired when an asynchronous publish is
+ *          completed
+ *
+ * @param[in] topic     topic the data was published on
+ * @param[in] res       EMCUTE_OK if the message was acknowledged (or sent, for
+ *                      QoS 0), EMCUTE_REJECT if it was rejected,
+ *                      EMCUTE_TIMEOUT if no PUBACK arrived after
+ *                      @ref EMCUTE_N_RETRY retransmissions, and EMCUTE_NOGW if
+ *                      the connection was closed before
+ * @param[in] arg       argument given to emcute_pub_async()
+ */
+typedef void(*emcute_pub_cb_t)(const emcute_topic_t *topic, int res,
+                               void *arg);
+
+/**
+ * @brief   Publish data on the given topic without waiting for the PUBACK
+ *
+ * Blocks while @ref EMCUTE_PUB_WINDOW QoS 1 messages are in flight. The
+ * callback of a QoS 1 message is called from the emCute thread, the callback
+ * of a QoS 0 message is called from the calling thread before this function
+ * returns.
+ *
+ * @note    Only available with module `emcute_pub_async`
+ *
+ * @param[in] topic     topic to send data to, topic **must** be registered
+ *                      (topic.id **must** populated) and stay valid until
+ *                      @p cb was called
+ * @param[in] buf       data to publish, copied by this function
+ * @param[in] len       length of @p data in bytes
+ * @param[in] flags     flags used for publication, allowed are QoS and retain
+ * @param[in] cb        function called when the publish is completed, may be
+ *                      NULL
+ * @param[in] arg       argument for @p cb
+ *
+ * @return  EMCUTE_OK if the message was sent
+ * @return  EMCUTE_NOGW if not connected to a gateway
+ * @return  EMCUTE_OVERFLOW if length of data exceeds @ref EMCUTE_BUFSIZE
+ * @return  EMCUTE_NOTSUP on unsupported flag values
+ */
+int emcute_pub_async(emcute_topic_t *topic, const void *buf, size_t len,
+                     unsigned flags, emcute_pub_cb_t cb, void *arg);
+
+/**
+ * @brief   Get the number of QoS 1 messages in flight
+ *
+ * @note    Only available with module `emcute_pub_async`
+ *
+ * @return  number of messages sent with emcute_pub_async() whose callback was
+ *          not called yet
+ */
+unsigned emcute_pub_inflight(void);
+#endif
+
 /**
  * @brief   Subscribe to the given topic
  *
@@ -35,6 +35,27 @@ extern "C" {
  */
 #define FIB_MAX_REGISTERED_RP (5)
 
+/**
+ * @brief Node of the longest prefix match trie of a FIB table
+ *
+ * The key of an entry is the address size byte followed by the first prefix
+ * length bits of the address, so entries of different address types never
+ * share a path. Entry nodes are embedded in their entry, branch nodes are
+ * taken from the spare nodes of the table entries.
+ */
+typedef struct fib_trie_node {
+    /** subtrees for key bit 0 and 1 at position `len` */
+    struct fib_trie_node *child[2];
+    /** parent node, or the previous entry node with the same key */
+    struct fib_trie_node *parent;
+    /** next entry node with the same key */
+    struct fib_trie_node *dup;
+    /** key length in bits */
+    uint16_t len;
+    /** internal state of the node */
+    uint8_t flags;
+} fib_trie_node_t;
+
 /**
  * @brief Container descriptor for a FIB entry
  */
@@ -51,6 +72,10 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+    /** Node of this entry in the prefix trie */
+    fib_trie_node_t trie;
+    /** Spare branch node for the prefix trie, not tied to this entry */
+    fib_trie_node_t trie_branch;
 } fib_entry_t;
 
 /**
@@ -133,6 +158,8 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+    /** root of the longest prefix match trie over the single hop entries */
+    fib_trie_node_t *trie;
 } fib_table_t;
 
 #ifdef __cplusplus
@@ -51,7 +51,16 @@
  * wrapped in a gcoap_listener_t.
  *
  * gcoap itself defines a resource for `/.well-known/core` discovery, which
- * lists all of the registered paths.
+ * lists all of the registered paths. The list is sent in a single response if
+ * it fits into a PDU buffer. Otherwise, or if the client asks for a block with
+ * the Block2 option, it is sent block-wise.
+ *
+ * gcoap keeps the registered resources in an index sorted by path, so a
+ * request is matched with a binary search instead of a walk over all
+ * listeners. The index holds up to GCOAP_RESOURCE_INDEX_SIZE resources. If
+ * more are registered, gcoap falls back to searching the listeners in order.
+ * If several listeners register the same path, the listener registered first
+ * is asked first.
  *
  * ### Creating a response ###
  *
@@ -81,6 +90,34 @@
  * described above. In fact, the gcoap_response() function is inline, and uses
  * those two functions.
  *
+ * ### Block-wise transfers ###
+ *
+ * A handler may transfer a payload larger than the PDU buffer with the
+ * Block-wise extension (RFC 7959), using the block helpers of nanocoap.
+ *
+ * To send a large response (Block2):
+ *
+ * -# Call coap_block2_init() on the request to initialize a
+ *    coap_block_slicer_t for the block the client asked for.
+ * -# Call gcoap_resp_init() to initialize the response.
+ * -# Add the options with the coap_opt_add_xxx() functions in ascending
+ *    order. Add the Content-Format option with coap_opt_add_uint() and the
+ *    Block2 option with coap_opt_add_block2(), with _more_ set.
+ * -# Call coap_opt_finish() with COAP_OPT_FINISH_PAYLOAD.
+ * -# Write the whole payload with coap_blockwise_put_bytes() and
+ *    coap_blockwise_put_char(). Only the part within the requested block is
+ *    written to the buffer.
+ * -# Call coap_block2_finish() to update the _more_ flag, and return the
+ *    length of the options plus the length written for the block.
+ *
+ * To receive a large request (Block1), read the Block1 option with
+ * coap_get_block1() and store the payload at its _offset_. Reply with
+ * COAP_CODE_CONTINUE as long as its _more_ attribute is set, and add the
+ * option returned by coap_opt_add_block1_control() to acknowledge the block.
+ *
+ * The size of a block is limited by NANOCOAP_BLOCK_SIZE_EXP_MAX, and
+ * GCOAP_PDU_BUF_SIZE must leave room for a block after the options.
+ *
  * ## Client Operation ##
  *
  * Client operation includes two phases:  creating and sending a request, and
@@ -453,6 +490,17 @@ extern "C" {
 #define GCOAP_RESEND_BUFS_MAX      (1)
 #endif
 
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Count of resources in the sorted resource index
+ *
+ * Includes `/.well-known/core`. Resources beyond this count are still served,
+ * but are found by searching the listeners in order.
+ */
+#ifndef GCOAP_RESOURCE_INDEX_SIZE
+#define GCOAP_RESOURCE_INDEX_SIZE  (16)
+#endif
+
 /**
  * @brief   A modular collection of resources for a server
  */
@@ -622,6 +670,9 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len, const ipv6_addr_t *addr,
  * @brief   Initializes a CoAP response packet on a buffer
  *
  * Initializes payload location within the buffer based on packet setup.
+ * If the request in @p pdu was parsed outside of @p buf, its header and token
+ * are copied to @p buf first. Options and payload of the request must be read
+ * before this call.
  *
  * @param[out] pdu      Response metadata
  * @param[in] buf       Buffer containing the PDU
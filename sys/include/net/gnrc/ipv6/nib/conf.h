@@ -266,6 +266,44 @@ extern "C" {
 #define GNRC_IPV6_NIB_OFFL_NUMOF            (8)
 #endif
 
+/**
+ * @brief   Number of hash buckets indexing the on-link entries
+ *
+ * Neighbor lookups only visit the entries in one bucket, so
+ * @ref GNRC_IPV6_NIB_NUMOF can grow into the hundreds without slowing down
+ * every packet. Must be a power of two.
+ */
+#ifndef GNRC_IPV6_NIB_ONL_BUCKETS
+#if GNRC_IPV6_NIB_NUMOF <= 4
+#define GNRC_IPV6_NIB_ONL_BUCKETS           (4)
+#elif GNRC_IPV6_NIB_NUMOF <= 16
+#define GNRC_IPV6_NIB_ONL_BUCKETS           (16)
+#elif GNRC_IPV6_NIB_NUMOF <= 64
+#define GNRC_IPV6_NIB_ONL_BUCKETS           (64)
+#else
+#define GNRC_IPV6_NIB_ONL_BUCKETS           (256)
+#endif
+#endif
+
+/**
+ * @brief   Number of hash buckets indexing the off-link entries
+ *
+ * The buckets are keyed on prefix and prefix length, so a route lookup
+ * costs one bucket per prefix length in use, independent of
+ * @ref GNRC_IPV6_NIB_OFFL_NUMOF. Must be a power of two.
+ */
+#ifndef GNRC_IPV6_NIB_OFFL_BUCKETS
+#if GNRC_IPV6_NIB_OFFL_NUMOF <= 8
+#define GNRC_IPV6_NIB_OFFL_BUCKETS          (8)
+#elif GNRC_IPV6_NIB_OFFL_NUMOF <= 32
+#define GNRC_IPV6_NIB_OFFL_BUCKETS          (32)
+#elif GNRC_IPV6_NIB_OFFL_NUMOF <= 128
+#define GNRC_IPV6_NIB_OFFL_BUCKETS          (128)
+#else
+#define GNRC_IPV6_NIB_OFFL_BUCKETS          (256)
+#endif
+#endif
+
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C || defined(DOXYGEN)
 /**
  * @brief   Number of authoritative border router entries in NIB
@@ -118,6 +118,13 @@ enum {
  */
 #define GNRC_NETIF_FLAGS_6LO_BACKBONE              (0x00000800U)
 
+/**
+ * @brief   Interface sends fragmented datagrams as recoverable fragments
+ *
+ * @see @ref net_gnrc_sixlowpan_frag_sfr
+ */
+#define GNRC_NETIF_FLAGS_6LO_SFR                   (0x00001000U)
+
 /**
  * @brief   Network interface is configured in raw mode
  */
@@ -72,6 +72,19 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+/**
+ * @brief   Number of hash buckets of the registry
+ *
+ * Entries are hashed by their type and
+ * @ref gnrc_netreg_entry_t::demux_ctx "demux context", so a lookup only walks
+ * the entries in one bucket.
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef GNRC_NETREG_BUCKETS
+#define GNRC_NETREG_BUCKETS         (16U)
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -96,9 +109,11 @@ typedef enum {
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
-                                                      { pid } }
+                                                      { pid }, \
+                                                      GNRC_NETTYPE_UNDEF }
 #else
-#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } }
+#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid }, \
+                                                      GNRC_NETTYPE_UNDEF }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
@@ -115,7 +130,8 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_MBOX(demux_ctx, _mbox) { NULL, demux_ctx, \
                                                        GNRC_NETREG_TYPE_MBOX, \
-                                                       { .mbox = _mbox } }
+                                                       { .mbox = _mbox }, \
+                                                       GNRC_NETTYPE_UNDEF }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
@@ -132,7 +148,8 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, _cbd)   { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_CB, \
-                                                      { .cbd = _cbd } }
+                                                      { .cbd = _cbd }, \
+                                                      GNRC_NETTYPE_UNDEF }
 /** @} */
 
 /**
@@ -210,6 +227,15 @@ typedef struct gnrc_netreg_entry {
         gnrc_netreg_entry_cbd_t *cbd;
 #endif
     } target;                   /**< Target for the registry entry */
+
+    /**
+     * @brief   Type of the protocol the entry is registered for
+     *
+     * @internal
+     *
+     * Set by gnrc_netreg_register().
+     */
+    gnrc_nettype_t nettype;
 } gnrc_netreg_entry_t;
 
 /**
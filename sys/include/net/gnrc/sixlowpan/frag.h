@@ -93,6 +93,7 @@ typedef struct {
     uint16_t offset;        /**< Offset of the Nth fragment from the beginning of the
                              *   payload datagram */
     kernel_pid_t pid;       /**< PID of the interface */
+    uint16_t tag;           /**< Datagram tag of the fragments */
 } gnrc_sixlowpan_msg_frag_t;
 
 /**
@@ -103,6 +104,13 @@ typedef struct {
  */
 gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void);
 
+/**
+ * @brief   Generates a new datagram tag for sending
+ *
+ * @return  A new datagram tag.
+ */
+uint16_t gnrc_sixlowpan_frag_next_tag(void);
+
 /**
  * @brief   Sends a packet fragmented
  *
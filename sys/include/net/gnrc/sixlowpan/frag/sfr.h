@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_sfr Selective fragment recovery
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       Recoverable 6LoWPAN fragments with per-fragment
+ *              acknowledgments
+ *
+ * With this module datagrams are sent as recoverable fragments (RFRAG) over
+ * interfaces with @ref GNRC_NETIF_FLAGS_6LO_SFR set (see
+ * @ref NETOPT_6LO_SFR). Every fragment carries a sequence number and the
+ * receiver acknowledges the received fragments with a bitmap, so only the
+ * fragments that were lost are sent again instead of the whole datagram.
+ *
+ * The sender paces its fragments by
+ * @ref GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAME_GAP and requests an acknowledgment
+ * every @ref GNRC_SIXLOWPAN_FRAG_SFR_WIN_SIZE fragments and with the last
+ * fragment. It then waits for the acknowledgment before it continues. If
+ * none arrives within @ref GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT the fragment
+ * that requested it (or the first fragment, if no fragment was acknowledged
+ * yet) is sent again, up to @ref GNRC_SIXLOWPAN_FRAG_SFR_RETRIES times.
+ *
+ * Received RFRAGs are translated to RFC 4944 fragments and reassembled by the
+ * existing reassembly buffer. For this the fragment offsets and the datagram
+ * size refer to the uncompressed datagram, like RFC 4944 fragments do, and not
+ * to the compressed one as in the draft. Fragments that arrive before the
+ * first fragment of their datagram are not acknowledged and sent again by
+ * the sender.
+ *
+ * Datagrams that need more than 32 fragments and datagrams sent while all
+ * @ref GNRC_SIXLOWPAN_FRAG_SFR_TX_NUMOF send slots are busy are fragmented
+ * according to RFC 4944.
+ *
+ * @see [draft-ietf-6lo-fragment-recovery](https://tools.ietf.org/html/draft-ietf-6lo-fragment-recovery-02)
+ * @{
+ *
+ * @file
+ * @brief   Selective fragment recovery definitions
+ *
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+#define NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+
+#include <stddef.h>
+
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pkt.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Message types
+ * @{
+ */
+/**
+ * @brief   Message type for sending the next recoverable fragment
+ */
+#define GNRC_SIXLOWPAN_FRAG_SFR_MSG_SND         (0x0227)
+
+/**
+ * @brief   Message type for a timed out RFRAG acknowledgment
+ */
+#define GNRC_SIXLOWPAN_FRAG_SFR_MSG_ARQ_TIMEOUT (0x0228)
+/** @} */
+
+/**
+ * @brief   Number of fragments sent before an acknowledgment is requested
+ *
+ * @note    Must not be greater than 32.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_WIN_SIZE
+#define GNRC_SIXLOWPAN_FRAG_SFR_WIN_SIZE        (16U)
+#endif
+
+/**
+ * @brief   Gap between two fragments of a datagram in microseconds
+ *
+ * Gives the next hop time to forward a fragment before the next one arrives.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAME_GAP
+#define GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAME_GAP (100U)
+#endif
+
+/**
+ * @brief   Time to wait for a requested acknowledgment in microseconds
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT
+#define GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT     (700U * US_PER_MS)
+#endif
+
+/**
+ * @brief   Number of times an acknowledgment is requested again before the
+ *          datagram is dropped
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_RETRIES
+#define GNRC_SIXLOWPAN_FRAG_SFR_RETRIES         (2U)
+#endif
+
+/**
+ * @brief   Number of datagrams that can be sent at the same time
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_TX_NUMOF
+#define GNRC_SIXLOWPAN_FRAG_SFR_TX_NUMOF        (1U)
+#endif
+
+/**
+ * @brief   Number of datagrams that can be received at the same time
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_RX_NUMOF
+#define GNRC_SIXLOWPAN_FRAG_SFR_RX_NUMOF        (4U)
+#endif
+
+/**
+ * @brief   Time in microseconds after which the reception state of a
+ *          datagram is dropped
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_SFR_RX_TIMEOUT
+#define GNRC_SIXLOWPAN_FRAG_SFR_RX_TIMEOUT      (3U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Starts sending a datagram as recoverable fragments
+ *
+ * @pre `(pkt != NULL) && (netif != NULL)`
+ *
+ * @param[in] pkt           The compressed datagram, starting with its
+ *                          @ref gnrc_netif_hdr_t.
+ * @param[in] netif         Interface to send over.
+ * @param[in] datagram_size Size of the uncompressed datagram.
+ *
+ * @return  0, if the datagram is sent. @p pkt is released when done.
+ * @return  -ENOBUFS, if no send slot is free. @p pkt is not released.
+ * @return  -EMSGSIZE, if the datagram needs more than 32 fragments. @p pkt is
+ *          not released.
+ */
+int gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt, gnrc_netif_t *netif,
+                                 size_t datagram_size);
+
+/**
+ * @brief   Sends the next fragment of a datagram
+ *
+ * Handler for @ref GNRC_SIXLOWPAN_FRAG_SFR_MSG_SND.
+ *
+ * @param[in] ctx   Content of the message.
+ */
+void gnrc_sixlowpan_frag_sfr_send_next(void *ctx);
+
+/**
+ * @brief   Handles a timed out acknowledgment
+ *
+ * Handler for @ref GNRC_SIXLOWPAN_FRAG_SFR_MSG_ARQ_TIMEOUT.
+ *
+ * @param[in] ctx   Content of the message.
+ */
+void gnrc_sixlowpan_frag_sfr_arq_timeout(void *ctx);
+
+/**
+ * @brief   Handles a recoverable fragment
+ *
+ * @param[in] pkt   The fragment, starting with the RFRAG header and followed
+ *                  by its @ref gnrc_netif_hdr_t.
+ * @param[in] ctx   Context for the packet. May be NULL.
+ * @param[in] page  Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+
+/**
+ * @brief   Handles an RFRAG acknowledgment
+ *
+ * @param[in] pkt   The acknowledgment, followed by its
+ *                  @ref gnrc_netif_hdr_t.
+ * @param[in] ctx   Context for the packet. May be NULL.
+ * @param[in] page  Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_recv_ack(gnrc_pktsnip_t *pkt, void *ctx,
+                                      unsigned page);
+
+/**
+ * @brief   Drops timed out reception states
+ */
+void gnrc_sixlowpan_frag_sfr_gc(void);
+
+#if defined(TEST_SUITES) || defined(DOXYGEN)
+/**
+ * @brief   Drops all send and reception states
+ *
+ * @note    Only available when @ref TEST_SUITES is defined
+ */
+void gnrc_sixlowpan_frag_sfr_reset(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_SFR_H */
+/** @} */
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_vrb Virtual reassembly buffer
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       Fragment forwarding without reassembly on 6LoWPAN routers
+ *
+ * With this module a router does not reassemble fragmented datagrams it only
+ * forwards. The header of the first fragment is still decompressed into the
+ * reassembly buffer to look up the next hop in the NIB. If the datagram is
+ * not for this node, an entry in the virtual reassembly buffer (VRB) maps the
+ * incoming (source, datagram size, tag) tuple to the outgoing interface,
+ * next hop and a new datagram tag, the first fragment is sent out again and
+ * the reassembly buffer entry is dropped. All following fragments of the
+ * datagram are relayed as they come in, only with the tag and link-layer
+ * header rewritten.
+ *
+ * This cuts the per-hop latency from the reception of all fragments to the
+ * reception of one fragment and a router only has to buffer one fragment at
+ * a time.
+ *
+ * Datagrams with fragments received before the first one, with a hop limit
+ * that would expire, or that do not fit the fragment size of the outgoing
+ * interface are still reassembled.
+ *
+ * @see [draft-ietf-lwig-6lowpan-virtual-reassembly](https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-01)
+ * @{
+ *
+ * @file
+ * @brief   Virtual reassembly buffer definitions
+ *
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_VRB_H
+#define NET_GNRC_SIXLOWPAN_FRAG_VRB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bitfield.h"
+#include "kernel_types.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/ieee802154.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of entries in the virtual reassembly buffer
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_SIZE
+#define GNRC_SIXLOWPAN_FRAG_VRB_SIZE        (16U)
+#endif
+
+/**
+ * @brief   Timeout for a virtual reassembly buffer entry in microseconds
+ *
+ * The timeout restarts with every forwarded fragment.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT
+#define GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT     (3U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Virtual reassembly buffer entry
+ */
+typedef struct {
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];       /**< source address */
+    uint8_t out_dst[IEEE802154_LONG_ADDRESS_LEN];   /**< next hop address */
+    uint8_t src_len;                    /**< length of gnrc_sixlowpan_frag_vrb_t::src */
+    uint8_t out_dst_len;                /**< length of gnrc_sixlowpan_frag_vrb_t::out_dst,
+                                         *   0 if the entry is empty */
+    uint16_t tag;                       /**< incoming datagram tag */
+    uint16_t out_tag;                   /**< outgoing datagram tag */
+    uint16_t datagram_size;             /**< datagram size */
+    uint16_t forwarded;                 /**< datagram bytes forwarded so far,
+                                         *   duplicates not counted */
+    BITFIELD(offsets, 256);             /**< offsets in units of 8 bytes of
+                                         *   the fragments forwarded so far */
+    gnrc_netif_t *out_netif;            /**< outgoing interface */
+    uint32_t arrival;                   /**< time in microseconds of the last
+                                         *   fragment */
+    bool first_sent;                    /**< first fragment was forwarded */
+} gnrc_sixlowpan_frag_vrb_t;
+
+/**
+ * @brief   Adds an entry to the virtual reassembly buffer
+ *
+ * A new outgoing datagram tag is taken from
+ * gnrc_sixlowpan_frag_next_tag(). If the buffer is full, the oldest entry is
+ * replaced.
+ *
+ * @pre `(src != NULL) && (out_netif != NULL) && (out_dst != NULL)`
+ * @pre `(out_dst_len > 0)`
+ *
+ * @param[in] src           Link-layer source address of the fragments.
+ * @param[in] src_len       Length of @p src.
+ * @param[in] tag           Datagram tag of the incoming fragments.
+ * @param[in] datagram_size Datagram size of the incoming fragments.
+ * @param[in] out_netif     Interface to forward the fragments over.
+ * @param[in] out_dst       Link-layer address of the next hop.
+ * @param[in] out_dst_len   Length of @p out_dst.
+ *
+ * @return  The new entry.
+ * @return  NULL, if an address is too long.
+ */
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(const uint8_t *src,
+                                                       size_t src_len,
+                                                       uint16_t tag,
+                                                       uint16_t datagram_size,
+                                                       gnrc_netif_t *out_netif,
+                                                       const uint8_t *out_dst,
+                                                       size_t out_dst_len);
+
+/**
+ * @brief   Looks up the entry of an incoming fragment
+ *
+ * @param[in] src           Link-layer source address of the fragment.
+ * @param[in] src_len       Length of @p src.
+ * @param[in] datagram_size Datagram size of the fragment.
+ * @param[in] tag           Datagram tag of the fragment.
+ *
+ * @return  The entry for the fragment's datagram.
+ * @return  NULL, if there is none.
+ */
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(const uint8_t *src,
+                                                       size_t src_len,
+                                                       uint16_t datagram_size,
+                                                       uint16_t tag);
+
+/**
+ * @brief   Creates an entry from the route to the destination of a datagram
+ *
+ * Looks up the next hop of the decompressed IPv6 header at the start of
+ * @p rbuf in the NIB. Without @ref net_gnrc_ipv6_nib this always fails.
+ *
+ * @pre `(rbuf != NULL) && (rbuf->pkt != NULL)`
+ *
+ * @param[in] rbuf      Reassembly buffer entry holding the first fragment.
+ * @param[in] if_pid    Interface the first fragment was received on.
+ *
+ * @return  The new entry.
+ * @return  NULL, if the datagram is not to be forwarded (e.g. it is for this
+ *          node, its hop limit expires or there is no route).
+ */
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_from_route(const gnrc_sixlowpan_rbuf_t *rbuf,
+                                                              kernel_pid_t if_pid);
+
+/**
+ * @brief   Forwards the first fragment of a datagram
+ *
+ * The IPv6 header is taken from @p rbuf with its hop limit decremented and
+ * compressed for the next hop, so the new first fragment covers the same
+ * bytes of the datagram as the received one.
+ *
+ * @pre `(vrb != NULL) && (rbuf != NULL) && (rbuf->pkt != NULL)`
+ *
+ * @param[in] vrb   Entry of the datagram.
+ * @param[in] rbuf  Reassembly buffer entry holding only the first fragment.
+ *
+ * @return  0 on success.
+ * @return  -EINVAL, if the hop limit of the datagram would expire.
+ * @return  -ENOMEM, if the packet buffer is full.
+ * @return  -EMSGSIZE, if the fragment does not fit the outgoing interface.
+ */
+int gnrc_sixlowpan_frag_vrb_forward_first(gnrc_sixlowpan_frag_vrb_t *vrb,
+                                          const gnrc_sixlowpan_rbuf_t *rbuf);
+
+/**
+ * @brief   Forwards a subsequent fragment of a datagram
+ *
+ * The entry is removed once the whole datagram was forwarded or the fragment
+ * can not be forwarded. Duplicates of already forwarded fragments are dropped.
+ *
+ * @pre `(vrb != NULL) && (pkt != NULL)`
+ *
+ * @param[in] vrb   Entry of the datagram.
+ * @param[in] pkt   The fragment, starting with the FRAGN header and followed
+ *                  by its @ref gnrc_netif_hdr_t. Will be released or sent.
+ */
+void gnrc_sixlowpan_frag_vrb_forward(gnrc_sixlowpan_frag_vrb_t *vrb,
+                                     gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Removes an entry
+ *
+ * @pre `vrb != NULL`
+ *
+ * @param[in] vrb   An entry.
+ */
+static inline void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrb)
+{
+    vrb->out_dst_len = 0;
+}
+
+/**
+ * @brief   Removes timed out entries
+ */
+void gnrc_sixlowpan_frag_vrb_gc(void);
+
+#if defined(TEST_SUITES) || defined(DOXYGEN)
+/**
+ * @brief   Removes all entries
+ *
+ * @note    Only available when @ref TEST_SUITES is defined
+ */
+void gnrc_sixlowpan_frag_vrb_reset(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_VRB_H */
+/** @} */
@@ -57,6 +57,20 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
  */
 void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
 
+/**
+ * @brief   Compresses the IPv6 header of a packet without sending it
+ *
+ * @pre (pkt != NULL)
+ *
+ * @param[in] pkt   A packet starting with a @ref gnrc_netif_hdr_t, followed
+ *                  by an uncompressed IPv6 header.
+ *
+ * @return  @p pkt with the IPv6 header (and UDP header, if compressible)
+ *          replaced by the IPHC dispatch.
+ * @return  NULL on error.
+ */
+gnrc_pktsnip_t *gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,7 @@
 #ifndef NET_GNRC_TCP_H
 #define NET_GNRC_TCP_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "net/gnrc/pkt.h"
 #include "net/gnrc/tcp/tcb.h"
@@ -109,11 +110,85 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  uint8_t address_family,
  *                    or @p target_addr is invalid.
  *            -EISCONN if TCB is already in use.
  *            -ENOMEM if the receive buffer for the TCB could not be allocated.
- *            Hint: Increase "GNRC_TCP_RCV_BUFFERS".
+ *            Hint: Increase "GNRC_TCP_RCV_BUF_POOL_SIZE".
  */
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
                           const char *local_addr, uint16_t local_port);
 
+/**
+ * @brief Starts listening for incomming connections with a backlog of TCBs.
+ *
+ * Every TCB in @p tcbs waits for a connection request to @p local_port.
+ * Connections are established in the background, so up to @p tcbs_numof
+ * connection requests are handled without a thread waiting for each of them.
+ * Established connections are taken over with gnrc_tcp_accept().
+ *
+ * Receive buffers are taken from the shared pool (see
+ * @ref GNRC_TCP_RCV_BUF_POOL_SIZE) when a connection request arrives. If the
+ * pool is exhausted the request is ignored and the peer retries it.
+ *
+ * @pre @p listener must not be NULL.
+ * @pre @p tcbs must not be NULL and @p tcbs_numof must not be zero.
+ * @pre if local_addr is not NULL, local_addr must be assigned to a network interface.
+ * @pre @p local_port must not be zero.
+ *
+ * @param[out]    listener         Listener to initialize.
+ * @param[in,out] tcbs             TCBs forming the backlog. They are initialized by this
+ *                                 function and owned by @p listener.
+ * @param[in]     tcbs_numof       Number of TCBs in @p tcbs.
+ * @param[in]     address_family   Address family of @p local_addr.
+ *                                 If local_addr == NULL, address_family is ignored.
+ * @param[in]     local_addr       If not NULL connections are bound to @p local_addr.
+ *                                 If NULL a connection request to all local ip
+ *                                 addresses is valied.
+ * @param[in]     local_port       Port number to listen on.
+ *
+ * @returns   Zero on success.
+ *            -EAFNOSUPPORT if local_addr != NULL and @p address_family is not supported.
+ *            -EINVAL if @p local_addr is invalid.
+ */
+int gnrc_tcp_listen(gnrc_tcp_listener_t *listener, gnrc_tcp_tcb_t *tcbs, size_t tcbs_numof,
+                    uint8_t address_family, const char *local_addr, uint16_t local_port);
+
+/**
+ * @brief Takes over an established connection from a listener.
+ *
+ * The returned TCB is used with gnrc_tcp_send(), gnrc_tcp_recv() and
+ * gnrc_tcp_close() or gnrc_tcp_abort(). Closing it returns the TCB into the
+ * backlog of @p listener.
+ *
+ * @pre gnrc_tcp_listen() must have been successfully called on @p listener.
+ * @pre @p tcb must not be NULL.
+ *
+ * @param[in,out] listener                   Listener to accept a connection from.
+ * @param[out]    tcb                        TCB of the accepted connection.
+ * @param[in]     user_timeout_duration_us   Timeout for accept in microseconds.
+ *                                           If zero and no connection is established, the
+ *                                           function returns immediately. If not zero the
+ *                                           function blocks until a connection is
+ *                                           established or @p user_timeout_duration_us
+ *                                           microseconds passed.
+ *
+ * @returns   Zero on success.
+ *            -EAGAIN if user_timeout_duration_us is zero and no connection is established.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ */
+int gnrc_tcp_accept(gnrc_tcp_listener_t *listener, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us);
+
+/**
+ * @brief Stops listening and releases the backlog of a listener.
+ *
+ * Connections that were not accepted yet are aborted. Accepted connections
+ * stay open and must still be closed, their TCBs are not returned into the
+ * backlog anymore.
+ *
+ * @pre gnrc_tcp_listen() must have been successfully called on @p listener.
+ *
+ * @param[in,out] listener   Listener to stop.
+ */
+void gnrc_tcp_stop_listen(gnrc_tcp_listener_t *listener);
+
 /**
  * @brief Transmit data to connected peer.
  *
@@ -68,7 +68,8 @@ extern "C" {
 #endif
 
 /**
- * @brief Number of preallocated receive buffers
+ * @brief Number of full-sized receive buffers the receive buffer pool is
+ *        sized for by default
  */
 #ifndef GNRC_TCP_RCV_BUFFERS
 #define GNRC_TCP_RCV_BUFFERS (1U)
@@ -81,6 +82,32 @@ extern "C" {
 #define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Size of the memory pool shared by all receive buffers
+ *
+ * Every connection takes up to @ref GNRC_TCP_RCV_BUF_SIZE bytes from the pool.
+ * If less is available, the connection gets the largest free part of at least
+ * @ref GNRC_TCP_RCV_BUF_BLOCK_SIZE bytes and announces a smaller window.
+ */
+#ifndef GNRC_TCP_RCV_BUF_POOL_SIZE
+#define GNRC_TCP_RCV_BUF_POOL_SIZE (GNRC_TCP_RCV_BUFFERS * GNRC_TCP_RCV_BUF_SIZE)
+#endif
+
+/**
+ * @brief Allocation granularity of the receive buffer pool
+ */
+#ifndef GNRC_TCP_RCV_BUF_BLOCK_SIZE
+#define GNRC_TCP_RCV_BUF_BLOCK_SIZE (GNRC_TCP_MSS)
+#endif
+
+/**
+ * @brief Number of SYN+ACK retransmissions before a half-open connection
+ *        of a listener is dropped and its TCB returns into the backlog
+ */
+#ifndef GNRC_TCP_SYN_RCVD_RETRIES
+#define GNRC_TCP_SYN_RCVD_RETRIES (3U)
+#endif
+
 /**
  * @brief Lower bound for RTO = 1 sec (see RFC 6298)
  */
@@ -22,6 +22,7 @@
 #ifndef NET_GNRC_TCP_TCB_H
 #define NET_GNRC_TCP_TCB_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "kernel_types.h"
 #include "ringbuffer.h"
@@ -83,9 +84,24 @@ typedef struct _transmission_control_block {
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
+    struct gnrc_tcp_listener *listener;         /**< Listener owning this TCB or NULL */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
 } gnrc_tcp_tcb_t;
 
+/**
+ * @brief Listener of GNRC TCP, accepting connections on a local port.
+ *
+ * Every TCB of the listener waits for a connection request. Connections are
+ * established in the background and handed over by gnrc_tcp_accept().
+ */
+typedef struct gnrc_tcp_listener {
+    gnrc_tcp_tcb_t *tcbs;                     /**< TCBs forming the backlog */
+    size_t tcbs_numof;                        /**< Number of TCBs in tcbs */
+    msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
+    mbox_t mbox;                              /**< Listener mbox for synchronization */
+    mutex_t function_lock;                    /**< Mutex for function call synchronization */
+} gnrc_tcp_listener_t;
+
 #ifdef __cplusplus
 }
 #endif
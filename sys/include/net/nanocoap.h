@@ -640,6 +640,38 @@ ssize_t coap_opt_add_string(coap_pkt_t *pkt, uint16_t optnum, const char *string
  */
 ssize_t coap_opt_add_uint(coap_pkt_t *pkt, uint16_t optnum, uint32_t value);
 
+/**
+ * @brief   Encode the block2 option for a slicer into pkt
+ *
+ * Remembers the position of the option in @p slicer, so coap_block2_finish()
+ * can update its more flag after the payload was written. Like for
+ * coap_opt_put_block2(), @p more must be set when initializing the option.
+ *
+ * @post pkt.payload advanced to first byte after option
+ * @post pkt.payload_len reduced by option length
+ *
+ * @param[in,out] pkt         pkt referencing target buffer
+ * @param[in,out] slicer      coap blockwise slicer helper struct
+ * @param[in]     more        more flag
+ *
+ * @return        number of bytes written to buffer
+ */
+ssize_t coap_opt_add_block2(coap_pkt_t *pkt, coap_block_slicer_t *slicer,
+                            bool more);
+
+/**
+ * @brief   Encode the block1 option to acknowledge a received block into pkt
+ *
+ * @post pkt.payload advanced to first byte after option
+ * @post pkt.payload_len reduced by option length
+ *
+ * @param[in,out] pkt         pkt referencing target buffer
+ * @param[in]     block1      ptr to block1 struct (created by coap_get_block1())
+ *
+ * @return        number of bytes written to buffer
+ */
+ssize_t coap_opt_add_block1_control(coap_pkt_t *pkt, coap_block1_t *block1);
+
 /**
  * @brief   Finalizes options as required and prepares for payload
  *
@@ -788,7 +820,8 @@ static inline ssize_t coap_get_location_query(const coap_pkt_t *pkt,
  * @brief Initialize a block2 slicer struct for writing the payload
  *
  * This function determines the size of the response payload based on the
- * size requested by the client in @p pkt.
+ * size requested by the client in @p pkt. If the client didn't request a
+ * size, the maximum size given by @ref NANOCOAP_BLOCK_SIZE_EXP_MAX is used.
  *
  * @param[in]   pkt         packet to work on
  * @param[out]  slicer      Preallocated slicer struct to fill
@@ -803,6 +836,7 @@ void coap_block2_init(coap_pkt_t *pkt, coap_block_slicer_t *slicer);
  * Checks whether the `more` bit should be set in the block2 option and
  * sets/clears it if required.  Doesn't return the number of bytes as this
  * overwrites bytes in the packet, it doesn't add new bytes to the packet.
+ * The option must have been written with the `more` bit set.
  *
  * @param[inout]  slicer      Preallocated slicer struct to use
  */
@@ -39,7 +39,7 @@ extern "C" {
  * receiving of UDP packets fails.
  *
  * @param[in]   local   local UDP endpoint to bind to
- * @param[in]   buf     input buffer to use
+ * @param[in]   buf     buffer to write responses to
  * @param[in]   bufsize size of @p buf
  *
  * @returns     -1 on error
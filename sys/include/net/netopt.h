@@ -566,6 +566,26 @@ typedef enum {
      */
     NETOPT_PHY_BUSY,
 
+    /**
+     * @brief   (@ref netopt_enable_t) selective fragment recovery
+     *
+     * When enabled, fragmented datagrams are sent as recoverable fragments.
+     *
+     * @see [draft-ietf-6lo-fragment-recovery](https://tools.ietf.org/html/draft-ietf-6lo-fragment-recovery-02)
+     */
+    NETOPT_6LO_SFR,
+
+    /**
+     * @brief   (@ref netopt_enable_t) low-power listening by preamble
+     *          sniffing
+     *
+     * When enabled, the device does not stay in reception while idle, but
+     * sleeps and periodically checks the channel for a preamble. Reception
+     * only starts when one is detected, so the senders must use preambles
+     * longer than the sniff period.
+     */
+    NETOPT_RX_SNIFF,
+
     /* add more options if needed */
 
     /**
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sixlowpan_sfr   6LoWPAN selective fragment recovery
+ * @ingroup     net_sixlowpan
+ * @brief       Header definitions for 6LoWPAN selective fragment recovery
+ *              (SFR)
+ * @see         [draft-ietf-6lo-fragment-recovery](https://tools.ietf.org/html/draft-ietf-6lo-fragment-recovery-02)
+ * @{
+ *
+ * @file
+ * @brief   6LoWPAN selective fragment recovery header definitions
+ *
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+#ifndef NET_SIXLOWPAN_SFR_H
+#define NET_SIXLOWPAN_SFR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "byteorder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Selective fragment recovery dispatches
+ * @{
+ */
+#define SIXLOWPAN_SFR_DISP_MASK     (0xfe)  /**< mask for SFR dispatches */
+#define SIXLOWPAN_SFR_RFRAG_DISP    (0xe8)  /**< recoverable fragment */
+#define SIXLOWPAN_SFR_ACK_DISP      (0xea)  /**< RFRAG acknowledgment */
+#define SIXLOWPAN_SFR_ECN           (0x01)  /**< explicit congestion
+                                             *   notification flag */
+/** @} */
+
+/**
+ * @name    Recoverable fragment header field definitions
+ * @{
+ */
+#define SIXLOWPAN_SFR_ACK_REQ       (0x80U)     /**< acknowledgment request
+                                                 *   flag (in first byte of
+                                                 *   sixlowpan_sfr_rfrag_t::ar_seq_size) */
+#define SIXLOWPAN_SFR_SEQ_MASK      (0x7cU)     /**< sequence number mask (in
+                                                 *   first byte of
+                                                 *   sixlowpan_sfr_rfrag_t::ar_seq_size) */
+#define SIXLOWPAN_SFR_SEQ_POS       (2U)        /**< position of the sequence
+                                                 *   number */
+#define SIXLOWPAN_SFR_SEQ_MAX       (31U)       /**< maximum sequence number */
+#define SIXLOWPAN_SFR_FRAG_SIZE_MASK    (0x03ffU)   /**< fragment size mask */
+#define SIXLOWPAN_SFR_FRAG_SIZE_MAX     (0x03ffU)   /**< maximum fragment size */
+/** @} */
+
+/**
+ * @brief   Bitmap of an RFRAG acknowledgment that signals the abort of the
+ *          datagram
+ */
+#define SIXLOWPAN_SFR_ACK_BITMAP_NULL   (0x00000000UL)
+
+/**
+ * @brief   Bitmap of an RFRAG acknowledgment that signals the complete
+ *          reception of the datagram
+ */
+#define SIXLOWPAN_SFR_ACK_BITMAP_FULL   (0xffffffffUL)
+
+/**
+ * @brief   Recoverable fragment (RFRAG) header
+ *
+ * For the first fragment (sequence number 0)
+ * sixlowpan_sfr_rfrag_t::offset carries the datagram size.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t disp_ecn;               /**< dispatch and ECN flag */
+    uint8_t tag;                    /**< datagram tag */
+    /**
+     * @brief   Acknowledgment request flag (1 bit), sequence number (5 bits)
+     *          and fragment size (10 bits)
+     */
+    network_uint16_t ar_seq_size;
+    network_uint16_t offset;        /**< fragment offset or datagram size */
+} sixlowpan_sfr_rfrag_t;
+
+/**
+ * @brief   RFRAG acknowledgment header
+ *
+ * Bit `31 - n` of sixlowpan_sfr_ack_t::bitmap is set, when the fragment with
+ * sequence number `n` was received.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t disp_ecn;               /**< dispatch and ECN flag */
+    uint8_t tag;                    /**< datagram tag */
+    network_uint32_t bitmap;        /**< acknowledgment bitmap */
+} sixlowpan_sfr_ack_t;
+
+/**
+ * @brief   Checks if a dispatch belongs to a recoverable fragment
+ *
+ * @param[in] disp  The first byte of a frame.
+ *
+ * @return  true, if @p disp is the dispatch of an RFRAG.
+ * @return  false, otherwise.
+ */
+static inline bool sixlowpan_sfr_rfrag_is(uint8_t disp)
+{
+    return ((disp & SIXLOWPAN_SFR_DISP_MASK) == SIXLOWPAN_SFR_RFRAG_DISP);
+}
+
+/**
+ * @brief   Checks if a dispatch belongs to an RFRAG acknowledgment
+ *
+ * @param[in] disp  The first byte of a frame.
+ *
+ * @return  true, if @p disp is the dispatch of an RFRAG acknowledgment.
+ * @return  false, otherwise.
+ */
+static inline bool sixlowpan_sfr_ack_is(uint8_t disp)
+{
+    return ((disp & SIXLOWPAN_SFR_DISP_MASK) == SIXLOWPAN_SFR_ACK_DISP);
+}
+
+/**
+ * @brief   Initializes the first fields of an RFRAG header
+ *
+ * @param[out] hdr      An RFRAG header.
+ * @param[in] tag       Datagram tag.
+ * @param[in] ack_req   Request an acknowledgment for this fragment.
+ * @param[in] seq       Sequence number of the fragment.
+ * @param[in] size      Size of the fragment payload.
+ */
+static inline void sixlowpan_sfr_rfrag_set(sixlowpan_sfr_rfrag_t *hdr,
+                                           uint8_t tag, bool ack_req,
+                                           uint8_t seq, uint16_t size)
+{
+    hdr->disp_ecn = SIXLOWPAN_SFR_RFRAG_DISP;
+    hdr->tag = tag;
+    hdr->ar_seq_size = byteorder_htons(size & SIXLOWPAN_SFR_FRAG_SIZE_MASK);
+    hdr->ar_seq_size.u8[0] |= (seq << SIXLOWPAN_SFR_SEQ_POS) &
+                              SIXLOWPAN_SFR_SEQ_MASK;
+    if (ack_req) {
+        hdr->ar_seq_size.u8[0] |= SIXLOWPAN_SFR_ACK_REQ;
+    }
+}
+
+/**
+ * @brief   Checks if an RFRAG requests an acknowledgment
+ *
+ * @param[in] hdr   An RFRAG header.
+ *
+ * @return  true, if an acknowledgment was requested.
+ * @return  false, otherwise.
+ */
+static inline bool sixlowpan_sfr_rfrag_ack_req(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return (hdr->ar_seq_size.u8[0] & SIXLOWPAN_SFR_ACK_REQ);
+}
+
+/**
+ * @brief   Gets the sequence number of an RFRAG
+ *
+ * @param[in] hdr   An RFRAG header.
+ *
+ * @return  The sequence number of the fragment.
+ */
+static inline uint8_t sixlowpan_sfr_rfrag_seq(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return (hdr->ar_seq_size.u8[0] & SIXLOWPAN_SFR_SEQ_MASK) >>
+           SIXLOWPAN_SFR_SEQ_POS;
+}
+
+/**
+ * @brief   Gets the fragment size of an RFRAG
+ *
+ * @param[in] hdr   An RFRAG header.
+ *
+ * @return  The size of the fragment payload.
+ */
+static inline uint16_t sixlowpan_sfr_rfrag_size(const sixlowpan_sfr_rfrag_t *hdr)
+{
+    return byteorder_ntohs(hdr->ar_seq_size) & SIXLOWPAN_SFR_FRAG_SIZE_MASK;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SIXLOWPAN_SFR_H */
+/** @} */
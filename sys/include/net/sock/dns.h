@@ -12,6 +12,13 @@
  *
  * @brief       Sock DNS client
  *
+ * With the `sock_dns_cache` module, results of sock_dns_query() are kept in
+ * a small LRU cache for the TTL of the answer record, so repeated lookups of
+ * the same name do not cost a DNS round trip. Names without a record of the
+ * requested family (NXDOMAIN or an empty answer) are cached as well, for the
+ * negative caching TTL of the SOA record in the reply (see
+ * [RFC 2308](https://tools.ietf.org/html/rfc2308)).
+ *
  * @{
  *
  * @file
@@ -51,6 +58,7 @@ typedef struct {
  * @{
  */
 #define DNS_TYPE_A              (1)
+#define DNS_TYPE_SOA            (6)
 #define DNS_TYPE_AAAA           (28)
 #define DNS_CLASS_IN            (1)
 
@@ -61,6 +69,21 @@ typedef struct {
 #define SOCK_DNS_QUERYBUF_LEN   (sizeof(sock_dns_hdr_t) + 4 + SOCK_DNS_MAX_NAME_LEN)
 /** @} */
 
+/**
+ * @brief   Number of names kept in the DNS cache
+ */
+#ifndef SOCK_DNS_CACHE_SIZE
+#define SOCK_DNS_CACHE_SIZE     (4U)
+#endif
+
+/**
+ * @brief   Upper bound for the time an answer is kept in the DNS cache in
+ *          seconds
+ */
+#ifndef SOCK_DNS_CACHE_MAX_TTL
+#define SOCK_DNS_CACHE_MAX_TTL  (24U * 60U * 60U)
+#endif
+
 /**
  * @brief Get IP address for DNS name
  *
@@ -80,11 +103,87 @@ typedef struct {
  * @param[out]  addr_out        buffer to write result into
  * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
  *
- * @return      0 on success
- * @return      !=0 otherwise
+ * @return      the length of the address written to @p addr_out on success
+ * @return      -EHOSTUNREACH, if @p domain_name has no record of @p family
+ * @return      <0 otherwise
  */
 int sock_dns_query(const char *domain_name, void *addr_out, int family);
 
+/**
+ * @brief   Parses a DNS reply
+ *
+ * Used by sock_dns_query(). Compression pointers are only skipped, never
+ * followed, and must point to an earlier position in the reply.
+ *
+ * @internal
+ *
+ * @param[in]   buf             the reply
+ * @param[in]   len             length of @p buf
+ * @param[out]  addr_out        buffer to write the first matching address
+ *                              into (4byte when family==AF_INET, 16byte
+ *                              otherwise)
+ * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
+ * @param[out]  ttl             time to live of the address, or the negative
+ *                              TTL for -EHOSTUNREACH. 0 if not cacheable.
+ *
+ * @return      the length of the address written to @p addr_out on success
+ * @return      -EHOSTUNREACH, if the reply has no record of @p family
+ * @return      -EBADMSG, if the reply is malformed or truncated, or reports
+ *              an error
+ */
+int sock_dns_parse_reply(uint8_t *buf, size_t len, void *addr_out, int family,
+                         uint32_t *ttl);
+
+#if defined(MODULE_SOCK_DNS_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Looks up a name in the DNS cache
+ *
+ * @note    Only available with the `sock_dns_cache` module.
+ *
+ * @param[in]   domain_name     DNS name to look up
+ * @param[out]  addr_out        buffer to write the address into
+ * @param[in]   family          Either AF_INET, AF_INET6 or AF_UNSPEC
+ *
+ * @return      the length of the address written to @p addr_out on a hit
+ * @return      -EHOSTUNREACH, on a hit of a negative entry
+ * @return      0, if @p domain_name is not cached or its entry expired
+ */
+int sock_dns_cache_get(const char *domain_name, void *addr_out, int family);
+
+/**
+ * @brief   Adds an answer to the DNS cache
+ *
+ * The least recently used entry is replaced if the cache is full.
+ *
+ * @note    Only available with the `sock_dns_cache` module.
+ *
+ * @param[in]   domain_name     DNS name the answer is for
+ * @param[in]   addr            address of the answer, NULL for a negative entry
+ * @param[in]   addrlen         length of @p addr, 0 for a negative entry
+ * @param[in]   family          family that was queried
+ * @param[in]   ttl             time to live of the answer in seconds. Answers
+ *                              with a TTL of 0 are not cached.
+ */
+void sock_dns_cache_add(const char *domain_name, const void *addr,
+                        size_t addrlen, int family, uint32_t ttl);
+
+/**
+ * @brief   Removes entries from the DNS cache
+ *
+ * @note    Only available with the `sock_dns_cache` module.
+ *
+ * @param[in]   domain_name     DNS name to remove, NULL to remove all
+ */
+void sock_dns_cache_flush(const char *domain_name);
+
+/**
+ * @brief   Prints the entries of the DNS cache
+ *
+ * @note    Only available with the `sock_dns_cache` module.
+ */
+void sock_dns_cache_print(void);
+#endif
+
 /**
  * @brief global DNS server endpoint
  */
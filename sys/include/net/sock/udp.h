@@ -273,6 +273,7 @@
 #include <stdlib.h>
 #include <sys/types.h>
 
+#include "iolist.h"
 #include "net/sock.h"
 
 #ifdef __cplusplus
@@ -402,6 +403,47 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep);
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote);
 
+/**
+ * @brief   Receives a UDP message without copying it out of the stack's
+ *          buffers
+ *
+ * @pre `(sock != NULL) && (data != NULL) && (buf_ctx != NULL)`
+ *
+ * The data stays valid until the function is called again with the returned
+ * @p buf_ctx. That call releases the buffer, sets `*buf_ctx` to `NULL` and
+ * returns 0, or, if the stack holds the UDP message in several chunks,
+ * provides the next chunk.
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[out] data     Pointer to the stack-internal buffer space holding the
+ *                      received data.
+ * @param[in,out] buf_ctx   Stack-internal buffer context. Must point to
+ *                      `NULL` for the first call and is kept between calls
+ *                      for the same UDP message.
+ * @param[in] timeout   Timeout for receive in microseconds.
+ *                      If 0 and no data is available, the function returns
+ *                      immediately.
+ *                      May be @ref SOCK_NO_TIMEOUT for no timeout (wait until
+ *                      data is available).
+ * @param[out] remote   Remote end point of the received data.
+ *                      May be `NULL`, if it is not required by the application.
+ *
+ * @note    Function blocks if no packet is currently waiting.
+ *
+ * @return  The number of bytes at @p data on success.
+ * @return  0, if no more data is available and @p buf_ctx was released.
+ * @return  -EADDRNOTAVAIL, if local of @p sock is not given.
+ * @return  -EAGAIN, if @p timeout is `0` and no data is available.
+ * @return  -EINVAL, if @p remote is invalid or @p sock is not properly
+ *          initialized (or closed while sock_udp_recv_buf() blocks).
+ * @return  -ENOMEM, if no memory was available to receive @p data.
+ * @return  -EPROTO, if source address of received packet did not equal
+ *          the remote of @p sock.
+ * @return  -ETIMEDOUT, if @p timeout expired.
+ */
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote);
+
 /**
  * @brief   Sends a UDP message to remote end point
  *
@@ -438,6 +480,30 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+/**
+ * @brief   Sends a UDP message gathered from several buffers to remote end
+ *          point
+ *
+ * @pre `(sock != NULL) || (remote != NULL)`
+ *
+ * Same as sock_udp_send(), but the payload is given as an I/O list, so e.g.
+ * a protocol header and a payload do not need to be merged by the caller
+ * first.
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`.
+ *                      A sensible local end point should be selected by the
+ *                      implementation in that case.
+ * @param[in] snips     List of buffers forming the payload. May be `NULL` for
+ *                      an empty payload.
+ * @param[in] remote    Remote end point for the sent data.
+ *                      May be `NULL`, if @p sock has a remote end point.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  The same errors as sock_udp_send().
+ */
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote);
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_pm_governor Deadline-aware idle governor
+ * @ingroup     sys_pm_layered
+ * @brief       Selects the pm_layered mode from the next timer expiry
+ *
+ * Plain @ref sys_pm_layered always enters the lowest unblocked mode. With this
+ * module, pm_set_lowest() asks xtimer and lptimer for their next deadline and
+ * only enters a mode if the time left covers its entry/exit latency plus its
+ * minimum residency. Modes that halt the counter of a timer with armed timers
+ * are skipped as well, as those timers would fire late.
+ *
+ * When a mode with non-zero latency is entered, a wakeup timer is armed
+ * @ref pm_governor_params_t::latency before the deadline on a timer that
+ * keeps running in that mode, so the MCU is back in time for the real
+ * expiry.
+ *
+ * The per-mode costs are taken from @ref PM_GOVERNOR_PARAMS, an initializer
+ * for an array of PM_NUM_MODES @ref pm_governor_params_t entries indexed by
+ * mode, usually provided by the CPU or the board. Without it, all modes are
+ * considered free, which gives the plain pm_layered behaviour plus
+ * statistics.
+ *
+ * @note    On STM32, any armed xtimer keeps the MCU out of STOP, as its
+ *          counter would halt there, while timers armed on lptimer, which
+ *          runs from the RTC, do not. Applications that rely on STOP for
+ *          their power budget, like the LoRaLAN end device, should arm
+ *          their long-lived timers on lptimer.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Deadline-aware idle governor interface
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef PM_GOVERNOR_H
+#define PM_GOVERNOR_H
+
+#include <stdint.h>
+
+#include "periph_cpu.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Mode flags
+ * @{
+ */
+#define PM_GOVERNOR_STOPS_XTIMER    (0x01)  /**< xtimer's counter halts */
+#define PM_GOVERNOR_STOPS_LPTIMER   (0x02)  /**< lptimer's counter halts */
+#define PM_GOVERNOR_STOPS_ALL       (0x03)  /**< no armed timer survives,
+                                                 e.g. the mode ends in a
+                                                 reset */
+/** @} */
+
+/**
+ * @brief   Cost of a power mode
+ */
+typedef struct {
+    uint32_t latency;       /**< entry plus exit latency in us */
+    uint32_t residency;     /**< minimum time in the mode to break even, in us */
+    uint8_t flags;          /**< PM_GOVERNOR_STOPS_* flags */
+} pm_governor_params_t;
+
+/**
+ * @brief   Per-mode statistics
+ */
+typedef struct {
+    uint32_t entries;       /**< times the mode was entered */
+    uint32_t demoted;       /**< times the mode was the lowest unblocked one,
+                                 but a lighter one was chosen */
+    uint32_t prearmed;      /**< wakeups by the pre-armed timer */
+    uint64_t residency;     /**< total time spent in the mode, in us */
+} pm_governor_stats_t;
+
+#ifndef PM_GOVERNOR_PARAMS
+/**
+ * @brief   Mode cost table, indexed by mode
+ */
+#define PM_GOVERNOR_PARAMS          { { 0, 0, 0 } }
+#endif
+
+/**
+ * @brief   Choose the mode to enter
+ *
+ * Called by pm_set_lowest() with interrupts disabled, arms the wakeup timer
+ * if needed.
+ *
+ * @param[in] mode  lowest unblocked mode
+ *
+ * @return  mode to enter, @p mode or a lighter one
+ */
+unsigned pm_governor_select(unsigned mode);
+
+/**
+ * @brief   Account the time spent in a mode
+ *
+ * Called by pm_set_lowest() after pm_set() returned, with interrupts still
+ * disabled.
+ *
+ * @param[in] mode  mode returned by pm_governor_select()
+ */
+void pm_governor_exit(unsigned mode);
+
+/**
+ * @brief   Get the statistics of a mode
+ *
+ * @param[in]  mode     mode, 0..PM_NUM_MODES (the latter being idle)
+ * @param[out] stats    statistics
+ */
+void pm_governor_get_stats(unsigned mode, pm_governor_stats_t *stats);
+
+/**
+ * @brief   Reset the statistics of all modes
+ */
+void pm_governor_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PM_GOVERNOR_H */
+/** @} */
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_saul_sampler SAUL sampler
+ * @ingroup     sys_saul_reg
+ * @brief       Shared periodic sampling of SAUL devices
+ *
+ * Instead of every application polling the sensors on its own timer,
+ * consumers subscribe to a SAUL device with the period they need. A single
+ * thread reads each subscribed device with the shortest period of its
+ * subscribers and stores the timestamped results in a ring buffer per
+ * device. The latest sample or a window of samples can then be taken from
+ * the buffer without touching the bus again, so the shell, CoAP resources
+ * and the application share one read.
+ *
+ * Reads that are due within @ref SAUL_SAMPLER_GROUP_MS are done in one
+ * batch, and devices with equal periods are kept in phase, so the sampler
+ * wakes up once per batch instead of once per device.
+ *
+ * Timestamps and periods are in milliseconds of lptimer_now_msec().
+ *
+ * @{
+ * @file
+ * @brief       SAUL sampler interface definition
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef SAUL_SAMPLER_H
+#define SAUL_SAMPLER_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "phydat.h"
+#include "saul_reg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of devices that can be sampled at the same time
+ */
+#ifndef SAUL_SAMPLER_NUMOF
+#define SAUL_SAMPLER_NUMOF          (4U)
+#endif
+
+/**
+ * @brief   Number of samples kept per device
+ */
+#ifndef SAUL_SAMPLER_BUFSIZE
+#define SAUL_SAMPLER_BUFSIZE        (8U)
+#endif
+
+/**
+ * @brief   Reads due within this many milliseconds are done together
+ */
+#ifndef SAUL_SAMPLER_GROUP_MS
+#define SAUL_SAMPLER_GROUP_MS       (50U)
+#endif
+
+/**
+ * @brief   Priority of the sampler thread
+ */
+#ifndef SAUL_SAMPLER_PRIO
+#define SAUL_SAMPLER_PRIO           (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/**
+ * @brief   Stack size of the sampler thread
+ */
+#ifndef SAUL_SAMPLER_STACKSIZE
+#define SAUL_SAMPLER_STACKSIZE      (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Type of the messages sent to subscribers on new samples
+ *
+ * msg_t::content::ptr points to the sampled @ref saul_reg_t.
+ */
+#ifndef SAUL_SAMPLER_MSG_TYPE
+#define SAUL_SAMPLER_MSG_TYPE       (0x5A50)
+#endif
+
+/**
+ * @brief   Maximum age in ms of a sample that is used instead of reading the
+ *          device, for the shell
+ */
+#ifndef SAUL_SAMPLER_MAX_AGE
+#define SAUL_SAMPLER_MAX_AGE        (1000U)
+#endif
+
+/**
+ * @brief   Timestamped result of a device read
+ */
+typedef struct {
+    phydat_t data;          /**< the values read */
+    uint32_t time;          /**< time of the read in ms */
+    int16_t dim;            /**< number of values in @p data, or the negative
+                             *   error returned by saul_reg_read() */
+} saul_sample_t;
+
+/**
+ * @brief   Subscription to a sampled device
+ *
+ * The structure must stay valid until saul_sampler_unsubscribe() is called.
+ */
+typedef struct saul_sampler_sub {
+    struct saul_sampler_sub *next;  /**< next subscriber of the device,
+                                     *   set internally */
+    saul_reg_t *dev;                /**< sampled device */
+    uint32_t period;                /**< sampling period in ms */
+    uint32_t last;                  /**< time of the last notification,
+                                     *   set internally */
+    kernel_pid_t pid;               /**< thread notified on new samples with
+                                     *   @ref SAUL_SAMPLER_MSG_TYPE, at most
+                                     *   once per @p period, or
+                                     *   KERNEL_PID_UNDEF */
+} saul_sampler_sub_t;
+
+/**
+ * @brief   Start the sampler thread
+ *
+ * Called by auto_init.
+ */
+void saul_sampler_init(void);
+
+/**
+ * @brief   Subscribe to periodic samples of a device
+ *
+ * The device is read at the shortest period of its subscribers, the first
+ * read is done right away.
+ *
+ * @param[out] sub      subscription to set up
+ * @param[in] dev       device to sample
+ * @param[in] period    sampling period in ms
+ * @param[in] pid       thread to notify on new samples, or KERNEL_PID_UNDEF
+ *
+ * @return  0 on success
+ * @return  -EALREADY if @p sub is subscribed, unsubscribe it first
+ * @return  -EINVAL if @p period is 0
+ * @return  -ENODEV if @p dev is NULL
+ * @return  -ENOMEM if @ref SAUL_SAMPLER_NUMOF devices are already sampled
+ */
+int saul_sampler_subscribe(saul_sampler_sub_t *sub, saul_reg_t *dev,
+                           uint32_t period, kernel_pid_t pid);
+
+/**
+ * @brief   Cancel a subscription
+ *
+ * The device is no longer sampled and its samples are dropped when its last
+ * subscriber is gone.
+ *
+ * @param[in] sub       subscription to cancel
+ */
+void saul_sampler_unsubscribe(saul_sampler_sub_t *sub);
+
+/**
+ * @brief   Get the latest sample of a device
+ *
+ * @param[in] dev       sampled device
+ * @param[out] sample   the latest sample
+ *
+ * @return  0 on success
+ * @return  -ENODEV if @p dev is not sampled
+ * @return  -ENODATA if no sample was taken yet
+ */
+int saul_sampler_latest(const saul_reg_t *dev, saul_sample_t *sample);
+
+/**
+ * @brief   Get the recent samples of a device
+ *
+ * Up to @p numof of the newest samples are copied, oldest first.
+ *
+ * @param[in] dev       sampled device
+ * @param[out] samples  buffer for the samples
+ * @param[in] numof     size of @p samples
+ * @param[in] max_age   maximum age of a sample in ms, UINT32_MAX for all
+ *
+ * @return  number of samples copied
+ * @return  -ENODEV if @p dev is not sampled
+ */
+int saul_sampler_window(const saul_reg_t *dev, saul_sample_t *samples,
+                        unsigned numof, uint32_t max_age);
+
+/**
+ * @brief   Read a device, using the latest sample if it is recent enough
+ *
+ * Drop-in for saul_reg_read() for consumers that accept values of a given
+ * age. Devices that are not sampled are read directly.
+ *
+ * @param[in] dev       device to read from
+ * @param[out] res      location to store the results in
+ * @param[in] max_age   maximum age of a sample in ms
+ *
+ * @return  the number of data elements read to @p res [1-3]
+ * @return  a negative error as returned by saul_reg_read()
+ */
+int saul_sampler_read(saul_reg_t *dev, phydat_t *res, uint32_t max_age);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SAUL_SAMPLER_H */
+/** @} */
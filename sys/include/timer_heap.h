@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_timer_heap Timer heap
+ * @ingroup     sys
+ * @brief       Pairing heap used as timer queue by xtimer and lptimer
+ *
+ * The timer multiplexers keep their armed timers in intrusive pairing heaps.
+ * Compared to the sorted lists used before, arming a timer is O(1), and both
+ * removing the earliest timer and cancelling an arbitrary timer are
+ * O(log n) amortized, which bounds the time spent with interrupts disabled
+ * when hundreds of timers are armed.
+ *
+ * The heap only manages the links, the ordering is defined by the user via
+ * a comparison function, so the same engine can be used for timers counting
+ * periph_timer ticks (xtimer) and RTT ticks (lptimer).
+ *
+ * None of the functions disable interrupts, the caller is responsible for
+ * locking.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Timer heap API
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#ifndef TIMER_HEAP_H
+#define TIMER_HEAP_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Timer heap node, to be embedded into the timer structure
+ */
+typedef struct timer_heap_node {
+    struct timer_heap_node *child;  /**< leftmost child                     */
+    struct timer_heap_node *next;   /**< right sibling                      */
+    struct timer_heap_node *prev;   /**< left sibling, or parent if leftmost */
+    struct timer_heap *heap;        /**< heap the node is in, NULL if none  */
+} timer_heap_node_t;
+
+/**
+ * @brief   Comparison function type
+ *
+ * @return  non-zero if @p a expires strictly before @p b
+ */
+typedef int (*timer_heap_before_t)(const timer_heap_node_t *a,
+                                   const timer_heap_node_t *b);
+
+/**
+ * @brief   Timer heap structure
+ */
+typedef struct timer_heap {
+    timer_heap_node_t *root;        /**< earliest timer, NULL if empty      */
+    timer_heap_before_t before;     /**< ordering of the heap               */
+} timer_heap_t;
+
+/**
+ * @brief   Static initializer for timer heaps
+ *
+ * @param[in] cmp   comparison function
+ */
+#define TIMER_HEAP_INIT(cmp)    { NULL, (cmp) }
+
+/**
+ * @brief   Get the earliest node of a heap
+ *
+ * @param[in] heap  heap to operate on
+ *
+ * @return  earliest node, NULL if @p heap is empty
+ */
+static inline timer_heap_node_t *timer_heap_peek(const timer_heap_t *heap)
+{
+    return heap->root;
+}
+
+/**
+ * @brief   Add a node to a heap
+ *
+ * O(1), the node's links are overwritten.
+ *
+ * @param[in] heap  heap to operate on
+ * @param[in] node  node to add, must not be part of any heap
+ */
+void timer_heap_insert(timer_heap_t *heap, timer_heap_node_t *node);
+
+/**
+ * @brief   Remove and return the earliest node of a heap
+ *
+ * @param[in] heap  heap to operate on
+ *
+ * @return  earliest node, NULL if @p heap is empty
+ */
+timer_heap_node_t *timer_heap_pop(timer_heap_t *heap);
+
+/**
+ * @brief   Remove a node from the heap it is in
+ *
+ * The node's subtree is merged and put in its place, so no search is needed.
+ *
+ * @pre     @p node is part of the heap pointed to by `node->heap`. Callers
+ *          that may see uninitialized nodes must validate `node->heap`
+ *          against their own heaps before calling this.
+ *
+ * @param[in] node  node to remove
+ */
+void timer_heap_remove(timer_heap_node_t *node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIMER_HEAP_H */
+/** @} */
@@ -16,9 +16,9 @@
  *
  * The implementation takes one low-level timer and multiplexes it.
  *
- * Insertion and removal of timers has O(n) complexity with (n) being the
- * number of active timers.  The reason for this is that multiplexing is
- * realized by next-first singly linked lists.
+ * Armed timers are kept in pairing heaps (see @ref sys_timer_heap), so
+ * insertion of a timer is O(1) and removal is O(log n) amortized, with (n)
+ * being the number of active timers.
  *
  * @{
  * @file
@@ -33,6 +33,7 @@
 #include "timex.h"
 #include "msg.h"
 #include "mutex.h"
+#include "timer_heap.h"
 
 #include "board.h"
 #include "periph_conf.h"
@@ -66,9 +67,14 @@ typedef void (*xtimer_callback_t)(void*);
 
 /**
  * @brief xtimer timer structure
+ *
+ * Timers must be zero-initialized before they are first passed to any
+ * xtimer function, e.g. `xtimer_t timer = { 0 };` for timers on the stack.
+ * xtimer tracks whether a timer is armed in the structure itself, so stale
+ * memory can make an unused timer look armed.
  */
 typedef struct xtimer {
-    struct xtimer *next;         /**< reference to next timer in timer lists */
+    timer_heap_node_t node;      /**< timer heap entry */
     uint32_t target;             /**< lower 32bit absolute target time */
     uint32_t long_target;        /**< upper 32bit absolute target time */
     xtimer_callback_t callback;  /**< callback function to call when timer
@@ -315,12 +321,27 @@ static inline void xtimer_set64(xtimer_t *timer, uint64_t offset_us);
 /**
  * @brief remove a timer
  *
- * @note this function runs in O(n) with n being the number of active timers
+ * @note this function runs in O(log n) amortized with n being the number of
+ *       active timers
  *
  * @param[in] timer ptr to timer structure that will be removed
  */
 void xtimer_remove(xtimer_t *timer);
 
+/**
+ * @brief Get the time until the next armed timer expires
+ *
+ * Meant for the idle governor (see @ref sys_pm_governor), which uses it to
+ * decide how deep the MCU may sleep.
+ *
+ * @param[out] ticks    xtimer ticks until the next expiry, 0 if it is
+ *                      already due
+ *
+ * @return  1 if at least one timer is armed
+ * @return  0 if no timer is armed, @p ticks is not touched
+ */
+int xtimer_next_deadline(xtimer_ticks32_t *ticks);
+
 /**
  * @brief receive a message blocking but with timeout
  *
@@ -60,7 +60,7 @@ void _lptimer_tsleep(uint32_t offset, uint32_t long_offset)
         return;
     }
 
-    lptimer_t timer;
+    lptimer_t timer = { 0 };
     mutex_t mutex = MUTEX_INIT;
 
     timer.callback = _callback_unlock_mutex;
@@ -73,7 +73,7 @@ void _lptimer_tsleep(uint32_t offset, uint32_t long_offset)
 }
 
 void _lptimer_periodic_wakeup(uint32_t *last_wakeup, uint32_t period) {
-    lptimer_t timer;
+    lptimer_t timer = { 0 };
     mutex_t mutex = MUTEX_INIT;
 
     timer.callback = _callback_unlock_mutex;
@@ -220,7 +220,7 @@ static int _msg_wait(msg_t *m, msg_t *tmsg, lptimer_t *t)
 
 int _lptimer_msg_receive_timeout64(msg_t *m, uint64_t timeout_ticks) {
     msg_t tmsg;
-    lptimer_t t;
+    lptimer_t t = { 0 };
     _setup_timer_msg(&tmsg, &t);
     _lptimer_set_msg64(&t, timeout_ticks, &tmsg, sched_active_pid);
     return _msg_wait(m, &tmsg, &t);
@@ -229,7 +229,7 @@ int _lptimer_msg_receive_timeout64(msg_t *m, uint64_t timeout_ticks) {
 int _lptimer_msg_receive_timeout(msg_t *msg, uint32_t timeout_ticks)
 {
     msg_t tmsg;
-    lptimer_t t;
+    lptimer_t t = { 0 };
     _setup_timer_msg(&tmsg, &t);
     _lptimer_set_msg(&t, timeout_ticks, &tmsg, sched_active_pid);
     return _msg_wait(msg, &tmsg, &t);
@@ -251,7 +251,7 @@ static void _mutex_timeout(void *arg)
 
 int lptimer_mutex_lock_timeout(mutex_t *mutex, uint64_t timeout)
 {
-    lptimer_t t;
+    lptimer_t t = { 0 };
     mutex_thread_t mt = { mutex, (thread_t *)sched_active_thread, 0 };
 
     if (timeout != 0) {
@@ -22,6 +22,7 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdint.h>
 #include <string.h>
 #include "board.h"
@@ -30,6 +31,7 @@
 
 #include "lptimer.h"
 #include "irq.h"
+#include "timer_heap.h"
 
 /* WARNING! enabling this will have side effects and can lead to timer underflows. */
 #define ENABLE_DEBUG    (0)
@@ -44,12 +46,21 @@ volatile uint32_t _lptimer_high_cnt = 0;
 
 static inline void lptimer_spin_until(uint32_t value);
 
-static lptimer_t *timer_list_head = NULL;
-static lptimer_t *overflow_list_head = NULL;
-static lptimer_t *long_list_head = NULL;
+static int _before(const timer_heap_node_t *a, const timer_heap_node_t *b);
+static int _before_long(const timer_heap_node_t *a, const timer_heap_node_t *b);
+
+/* timers of the current and of the next short timer period. The two heaps
+ * swap roles on each period, so nodes never need to be re-tagged */
+static timer_heap_t _period_heaps[2] = {
+    TIMER_HEAP_INIT(_before),
+    TIMER_HEAP_INIT(_before),
+};
+static timer_heap_t *timer_heap = &_period_heaps[0];
+static timer_heap_t *overflow_heap = &_period_heaps[1];
+static timer_heap_t long_heap = TIMER_HEAP_INIT(_before_long);
+/* timers that were still due when their period ended */
+static timer_heap_t late_heap = TIMER_HEAP_INIT(_before);
 
-static void _add_timer_to_list(lptimer_t **list_head, lptimer_t *timer);
-static void _add_timer_to_long_list(lptimer_t **list_head, lptimer_t *timer);
 static void _shoot(lptimer_t *timer);
 static void _remove(lptimer_t *timer);
 static inline void _lltimer_set(uint32_t target);
@@ -62,7 +73,37 @@ static inline int _this_high_period(uint32_t target);
 
 static inline int _is_set(lptimer_t *timer)
 {
-    return (timer->target || timer->long_target);
+    /* zeroed, fired and removed timers are in no heap. Membership is read
+     * from the caller's timer, which is why timers must be zero-initialized
+     * before their first use: stale stack contents could name a heap here. */
+    timer_heap_t *heap = timer->node.heap;
+    int set = (heap == &_period_heaps[0]) || (heap == &_period_heaps[1])
+              || (heap == &long_heap) || (heap == &late_heap);
+
+    /* every node in a heap is either its root or linked to a neighbour */
+    assert(!set || (heap->root == &timer->node) || timer->node.prev);
+    return set;
+}
+
+static inline lptimer_t *_first(timer_heap_t *heap)
+{
+    timer_heap_node_t *node = timer_heap_peek(heap);
+    return node ? container_of(node, lptimer_t, node) : NULL;
+}
+
+static int _before(const timer_heap_node_t *a, const timer_heap_node_t *b)
+{
+    return container_of(a, lptimer_t, node)->target
+           < container_of(b, lptimer_t, node)->target;
+}
+
+static int _before_long(const timer_heap_node_t *a, const timer_heap_node_t *b)
+{
+    const lptimer_t *ta = container_of(a, lptimer_t, node);
+    const lptimer_t *tb = container_of(b, lptimer_t, node);
+
+    return (ta->long_target < tb->long_target)
+           || ((ta->long_target == tb->long_target) && (ta->target < tb->target));
 }
 
 static inline void lptimer_spin_until(uint32_t target)
@@ -128,7 +169,7 @@ void _lptimer_set64(lptimer_t *timer, uint32_t offset, uint32_t long_offset)
             timer->long_target++;
         }
 
-        _add_timer_to_long_list(&long_list_head, timer);
+        timer_heap_insert(&long_heap, &timer->node);
         irq_restore(state);
         DEBUG("lptimer_set64(): added longterm timer (long_target=%" PRIu32 " target=%" PRIu32 ")\n",
               timer->long_target, timer->target);
@@ -183,8 +224,6 @@ int _lptimer_set_absolute(lptimer_t *timer, uint32_t target)
     uint32_t now = _lptimer_now();
     int res = 0;
 
-    timer->next = NULL;
-
     /* Ensure that offset is bigger than 'LPTIMER_BACKOFF',
      * 'target - now' will allways be the offset no matter if target < or > now.
      *
@@ -232,19 +271,19 @@ int _lptimer_set_absolute(lptimer_t *timer, uint32_t target)
 
     if ((timer->long_target > _long_cnt) || !_this_high_period(target)) {
         DEBUG("lptimer_set_absolute(): the timer doesn't fit into the low-level timer's mask.\n");
-        _add_timer_to_long_list(&long_list_head, timer);
+        timer_heap_insert(&long_heap, &timer->node);
     }
     else {
         if (_lptimer_lltimer_mask(now) >= target) {
             DEBUG("lptimer_set_absolute(): the timer will expire in the next timer period\n");
-            _add_timer_to_list(&overflow_list_head, timer);
+            timer_heap_insert(overflow_heap, &timer->node);
         }
         else {
             DEBUG("timer_set_absolute(): timer will expire in this timer period.\n");
-            _add_timer_to_list(&timer_list_head, timer);
+            timer_heap_insert(timer_heap, &timer->node);
 
-            if (timer_list_head == timer) {
-                DEBUG("timer_set_absolute(): timer is new list head. updating lltimer.\n");
+            if (_first(timer_heap) == timer) {
+                DEBUG("timer_set_absolute(): timer is new heap root. updating lltimer.\n");
                 _lltimer_set(target);
             }
         }
@@ -255,49 +294,14 @@ int _lptimer_set_absolute(lptimer_t *timer, uint32_t target)
     return res;
 }
 
-static void _add_timer_to_list(lptimer_t **list_head, lptimer_t *timer)
-{
-    while (*list_head && (*list_head)->target <= timer->target) {
-        list_head = &((*list_head)->next);
-    }
-
-    timer->next = *list_head;
-    *list_head = timer;
-}
-
-static void _add_timer_to_long_list(lptimer_t **list_head, lptimer_t *timer)
-{
-    while (*list_head
-           && (((*list_head)->long_target < timer->long_target)
-           || (((*list_head)->long_target == timer->long_target) && ((*list_head)->target <= timer->target)))) {
-        list_head = &((*list_head)->next);
-    }
-
-    timer->next = *list_head;
-    *list_head = timer;
-}
-
-static int _remove_timer_from_list(lptimer_t **list_head, lptimer_t *timer)
-{
-    while (*list_head) {
-        if (*list_head == timer) {
-            *list_head = timer->next;
-            return 1;
-        }
-        list_head = &((*list_head)->next);
-    }
-
-    return 0;
-}
-
 static void _remove(lptimer_t *timer)
 {
-    if (timer_list_head == timer) {
+    if (_first(timer_heap) == timer) {
         uint32_t next;
-        timer_list_head = timer->next;
-        if (timer_list_head) {
+        timer_heap_pop(timer_heap);
+        if (_first(timer_heap)) {
             /* schedule callback on next timer target time */
-            next = timer_list_head->target;
+            next = _first(timer_heap)->target;
         }
         else {
             next = _lptimer_lltimer_mask(0xFFFFFFFF);
@@ -305,11 +309,7 @@ static void _remove(lptimer_t *timer)
         _lltimer_set(next);
     }
     else {
-        if (!_remove_timer_from_list(&timer_list_head, timer)) {
-            if (!_remove_timer_from_list(&overflow_list_head, timer)) {
-                _remove_timer_from_list(&long_list_head, timer);
-            }
-        }
+        timer_heap_remove(&timer->node);
     }
 }
 
@@ -323,6 +323,29 @@ void lptimer_remove(lptimer_t *timer)
     irq_restore(state);
 }
 
+int lptimer_next_deadline(lptimer_ticks32_t *ticks)
+{
+    int res = 1;
+    unsigned state = irq_disable();
+    lptimer_t *first = _first(timer_heap);
+
+    if (first) {
+        int32_t left = (int32_t)(first->target - _lptimer_now());
+        ticks->ticks32 = (left > 0) ? (uint32_t)left : 0;
+    }
+    else if (timer_heap_peek(overflow_heap) || timer_heap_peek(&long_heap)) {
+        /* nothing due in this period, the next event is the period end */
+        ticks->ticks32 = _lptimer_lltimer_mask(0xFFFFFFFF) - _lptimer_lltimer_now();
+    }
+    else {
+        res = 0;
+    }
+
+    irq_restore(state);
+
+    return res;
+}
+
 static uint32_t _time_left(uint32_t target, uint32_t reference)
 {
     uint32_t now = _lptimer_lltimer_now();
@@ -350,92 +373,18 @@ static inline int _this_high_period(uint32_t target)
 }
 
 /**
- * @brief compare two timers' target values, return the one with lower value.
- *
- * if either is NULL, return the other.
- * if both are NULL, return NULL.
- */
-static inline lptimer_t *_compare(lptimer_t *a, lptimer_t *b)
-{
-    if (a && b) {
-        return ((a->target <= b->target) ? a : b);
-    }
-    else {
-        return (a ? a : b);
-    }
-}
-
-/**
- * @brief merge two timer lists, return head of new list
- */
-static lptimer_t *_merge_lists(lptimer_t *head_a, lptimer_t *head_b)
-{
-    lptimer_t *result_head = _compare(head_a, head_b);
-    lptimer_t *pos = result_head;
-
-    while (1) {
-        head_a = head_a->next;
-        head_b = head_b->next;
-        if (!head_a) {
-            pos->next = head_b;
-            break;
-        }
-        if (!head_b) {
-            pos->next = head_a;
-            break;
-        }
-
-        pos->next = _compare(head_a, head_b);
-        pos = pos->next;
-    }
-
-    return result_head;
-}
-
-/**
- * @brief parse long timers list and copy those that will expire in the current
- *        short timer period
+ * @brief move the long timers that will expire in the current short timer
+ *        period to the current timer heap
  */
 static void _select_long_timers(void)
 {
-    lptimer_t *select_list_start = long_list_head;
-    lptimer_t *select_list_last = NULL;
-
-    /* advance long_list head so it points to the first timer of the next (not
-     * just started) "long timer period" */
-    while (long_list_head) {
-        if ((long_list_head->long_target <= _long_cnt) && _this_high_period(long_list_head->target)) {
-            select_list_last = long_list_head;
-            long_list_head = long_list_head->next;
-        }
-        else {
-            /* remaining long_list timers belong to later long periods */
-            break;
-        }
-    }
+    lptimer_t *timer;
 
-    /* cut the "selected long timer list" at the end */
-    if (select_list_last) {
-        select_list_last->next = NULL;
-    }
-
-    /* merge "current timer list" and "selected long timer list" */
-    if (timer_list_head) {
-        if (select_list_last) {
-            /* both lists are non-empty. merge. */
-            timer_list_head = _merge_lists(timer_list_head, select_list_start);
-        }
-        else {
-            /* "selected long timer list" is empty, nothing to do */
-        }
-    }
-    else { /* current timer list is empty */
-        if (select_list_last) {
-            /* there's no current timer list, but a non-empty "selected long
-             * timer list".  So just use that list as the new current timer
-             * list.*/
-            timer_list_head = select_list_start;
-        }
+    while ((timer = _first(&long_heap))
+           && (timer->long_target <= _long_cnt)
+           && _this_high_period(timer->target)) {
+        timer_heap_pop(&long_heap);
+        timer_heap_insert(timer_heap, &timer->node);
     }
 }
 
@@ -444,6 +393,16 @@ static void _select_long_timers(void)
  */
 static void _next_period(void)
 {
+    lptimer_t *timer;
+
+    /* timers left in the ending period are late. Take them out before the
+     * heap becomes the next period's overflow heap, where they would only
+     * fire a full period later */
+    while ((timer = _first(timer_heap))) {
+        timer_heap_pop(timer_heap);
+        timer_heap_insert(&late_heap, &timer->node);
+    }
+
 #if LPTIMER_MASK
     /* advance <32bit mask register */
     _lptimer_high_cnt += ~LPTIMER_MASK + 1;
@@ -456,11 +415,21 @@ static void _next_period(void)
     _long_cnt++;
 #endif
 
-    /* swap overflow list to current timer list */
-    timer_list_head = overflow_list_head;
-    overflow_list_head = NULL;
+    /* the current heap becomes the next period's overflow heap */
+    timer_heap_t *tmp = timer_heap;
+    timer_heap = overflow_heap;
+    overflow_heap = tmp;
 
     _select_long_timers();
+
+    /* fire the late timers only now, so timers set by their callbacks go to
+     * the heaps of the new period */
+    while ((timer = _first(&late_heap))) {
+        timer_heap_pop(&late_heap);
+        timer->target = 0;
+        timer->long_target = 0;
+        _shoot(timer);
+    }
 }
 
 /**
@@ -477,7 +446,7 @@ static void _timer_callback(void)
           lptimer_now().ticks32, _lptimer_lltimer_mask(lptimer_now().ticks32),
           _lptimer_lltimer_mask(0xffffffff - lptimer_now().ticks32));
 
-    if (!timer_list_head) {
+    if (!_first(timer_heap)) {
         DEBUG("_timer_callback(): tick\n");
         /* there's no timer for this timer period,
          * so this was a timer overflow callback.
@@ -495,15 +464,13 @@ static void _timer_callback(void)
 
 overflow:
     /* check if next timers are close to expiring */
-    while (timer_list_head && (_time_left(_lptimer_lltimer_mask(timer_list_head->target), reference) < LPTIMER_ISR_BACKOFF)) {
+    while (_first(timer_heap) && (_time_left(_lptimer_lltimer_mask(_first(timer_heap)->target), reference) < LPTIMER_ISR_BACKOFF)) {
         /* make sure we don't fire too early */
-        while (_time_left(_lptimer_lltimer_mask(timer_list_head->target), reference)) {}
+        while (_time_left(_lptimer_lltimer_mask(_first(timer_heap)->target), reference)) {}
 
-        /* pick first timer in list */
-        lptimer_t *timer = timer_list_head;
-
-        /* advance list */
-        timer_list_head = timer->next;
+        /* pick first timer in heap */
+        lptimer_t *timer = _first(timer_heap);
+        timer_heap_pop(timer_heap);
 
         /* make sure timer is recognized as being already fired */
         timer->target = 0;
@@ -521,7 +488,7 @@ overflow:
     uint32_t now = _lptimer_lltimer_now() + LPTIMER_ISR_BACKOFF;
     if (now < reference) {
         DEBUG("_timer_callback: overflowed while executing callbacks. %i\n",
-              timer_list_head != NULL);
+              _first(timer_heap) != NULL);
         _next_period();
         /* wait till overflow */
         while( reference < _lptimer_lltimer_now()){}
@@ -529,9 +496,9 @@ overflow:
         goto overflow;
     }
 
-    if (timer_list_head) {
+    if (_first(timer_heap)) {
         /* schedule callback on next timer target time */
-        next_target = timer_list_head->target;
+        next_target = _first(timer_heap)->target;
 
         /* make sure we're not setting a time in the past */
         if (next_target < (_lptimer_now() + LPTIMER_ISR_BACKOFF)) {
@@ -570,15 +537,13 @@ overflow:
 
 void lptimer_remove_all(void)
 {
-    while (timer_list_head) {
-        timer_list_head = timer_list_head->next;
-    }
-    
-    while (overflow_list_head) {
-        overflow_list_head = overflow_list_head->next;
-    }
-    
-    while (long_list_head) {
-        long_list_head = long_list_head->next;
-    }
-}
\ No newline at end of file
+    unsigned state = irq_disable();
+
+    /* pop one by one, so removed timers are not considered set any more */
+    while (timer_heap_pop(timer_heap)) {}
+    while (timer_heap_pop(overflow_heap)) {}
+    while (timer_heap_pop(&long_heap)) {}
+    while (timer_heap_pop(&late_heap)) {}
+
+    irq_restore(state);
+}
@@ -30,6 +30,11 @@
 /* min domain name length is 1, so minimum record length is 7 */
 #define DNS_MIN_REPLY_LEN   (unsigned)(sizeof(sock_dns_hdr_t ) + 7)
 
+/* response codes in the flags of the DNS header */
+#define DNS_RCODE_MASK      (0x000f)
+#define DNS_RCODE_NOERROR   (0)
+#define DNS_RCODE_NXDOMAIN  (3)
+
 /* global DNS server UDP endpoint */
 sock_udp_ep_t sock_dns_server;
 
@@ -75,6 +80,13 @@ static unsigned _get_short(uint8_t *buf)
     return _tmp;
 }
 
+static uint32_t _get_long(uint8_t *buf)
+{
+    uint32_t _tmp;
+    memcpy(&_tmp, buf, 4);
+    return _tmp;
+}
+
 static ssize_t _skip_hostname(const uint8_t *buf, size_t len, uint8_t *bufpos)
 {
     const uint8_t *buflim = buf + len;
@@ -84,15 +96,25 @@ static ssize_t _skip_hostname(const uint8_t *buf, size_t len, uint8_t *bufpos)
         /* out-of-bound */
         return -EBADMSG;
     }
-    /* handle DNS Message Compression */
-    if (*bufpos >= 192) {
-        if ((bufpos + 2) >= buflim) {
-            return -EBADMSG;
-        }
-        return 2;
-    }
 
     while (bufpos[res]) {
+        /* handle DNS Message Compression: name ends with a pointer */
+        if (bufpos[res] >= 192) {
+            if ((&bufpos[res + 2]) >= buflim) {
+                return -EBADMSG;
+            }
+            /* a pointer must point to a prior occurrence of the name, so a
+             * reply can not contain a loop of pointers */
+            unsigned ptr = ((bufpos[res] & 0x3f) << 8) | bufpos[res + 1];
+            if (ptr >= (unsigned)(&bufpos[res] - buf)) {
+                return -EBADMSG;
+            }
+            return res + 2;
+        }
+        /* label types 0x40 and 0x80 are reserved */
+        if (bufpos[res] >= 64) {
+            return -EBADMSG;
+        }
         res += bufpos[res] + 1;
         if ((&bufpos[res]) >= buflim) {
             /* out-of-bound */
@@ -102,12 +124,59 @@ static ssize_t _skip_hostname(const uint8_t *buf, size_t len, uint8_t *bufpos)
     return res + 1;
 }
 
-static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family)
+static uint32_t _get_negative_ttl(uint8_t *buf, size_t len, uint8_t *bufpos,
+                                  unsigned nscount)
+{
+    /* RFC 2308, section 5: the negative TTL is the minimum of the SOA
+     * record's TTL and its MINIMUM field (the last field of its RDATA) */
+    const uint8_t *buflim = buf + len;
+
+    for (unsigned n = 0; n < nscount; n++) {
+        ssize_t tmp = _skip_hostname(buf, len, bufpos);
+        if (tmp < 0) {
+            break;
+        }
+        bufpos += tmp;
+        if ((bufpos + RR_TYPE_LENGTH + RR_CLASS_LENGTH + RR_TTL_LENGTH +
+             RR_RDLENGTH_LENGTH) >= buflim) {
+            break;
+        }
+        uint16_t _type = ntohs(_get_short(bufpos));
+        bufpos += RR_TYPE_LENGTH + RR_CLASS_LENGTH;
+        uint32_t ttl = ntohl(_get_long(bufpos));
+        bufpos += RR_TTL_LENGTH;
+        unsigned rdlen = ntohs(_get_short(bufpos));
+        bufpos += RR_RDLENGTH_LENGTH;
+        if ((rdlen > len) || ((bufpos + rdlen) > buflim)) {
+            break;
+        }
+        if ((_type == DNS_TYPE_SOA) && (rdlen >= RR_TTL_LENGTH)) {
+            uint32_t minimum = ntohl(_get_long(bufpos + rdlen - RR_TTL_LENGTH));
+            return (ttl < minimum) ? ttl : minimum;
+        }
+        bufpos += rdlen;
+    }
+    /* not cacheable without SOA record */
+    return 0;
+}
+
+int sock_dns_parse_reply(uint8_t *buf, size_t len, void *addr_out, int family,
+                         uint32_t *ttl)
 {
     const uint8_t *buflim = buf + len;
     sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
     uint8_t *bufpos = buf + sizeof(*hdr);
 
+    *ttl = 0;
+    if (len < sizeof(*hdr)) {
+        return -EBADMSG;
+    }
+
+    unsigned rcode = ntohs(hdr->flags) & DNS_RCODE_MASK;
+    if ((rcode != DNS_RCODE_NOERROR) && (rcode != DNS_RCODE_NXDOMAIN)) {
+        return -EBADMSG;
+    }
+
     /* skip all queries that are part of the reply */
     for (unsigned n = 0; n < ntohs(hdr->qdcount); n++) {
         ssize_t tmp = _skip_hostname(buf, len, bufpos);
@@ -117,6 +186,9 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
         bufpos += tmp;
         /* skip type and class of query */
         bufpos += (RR_TYPE_LENGTH + RR_CLASS_LENGTH);
+        if (bufpos > buflim) {
+            return -EBADMSG;
+        }
     }
 
     for (unsigned n = 0; n < ntohs(hdr->ancount); n++) {
@@ -125,14 +197,16 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
             return tmp;
         }
         bufpos += tmp;
-        if ((bufpos + RR_TYPE_LENGTH + RR_CLASS_LENGTH + RR_TTL_LENGTH) >= buflim) {
+        if ((bufpos + RR_TYPE_LENGTH + RR_CLASS_LENGTH + RR_TTL_LENGTH +
+             RR_RDLENGTH_LENGTH) > buflim) {
             return -EBADMSG;
         }
         uint16_t _type = ntohs(_get_short(bufpos));
         bufpos += RR_TYPE_LENGTH;
         uint16_t class = ntohs(_get_short(bufpos));
         bufpos += RR_CLASS_LENGTH;
-        bufpos += RR_TTL_LENGTH; /* skip ttl */
+        uint32_t _ttl = ntohl(_get_long(bufpos));
+        bufpos += RR_TTL_LENGTH;
 
         unsigned addrlen = ntohs(_get_short(bufpos));
         /* skip unwanted answers */
@@ -145,7 +219,7 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
                 /* buffer wraps around memory space */
                 return -EBADMSG;
             }
-            bufpos += addrlen;
+            bufpos += RR_RDLENGTH_LENGTH + addrlen;
             /* other out-of-bound is checked in `_skip_hostname()` at start of
              * loop */
             continue;
@@ -157,15 +231,18 @@ static int _parse_dns_reply(uint8_t *buf, size_t len, void* addr_out, int family
             return -EBADMSG;
         }
         bufpos += RR_RDLENGTH_LENGTH;
-        if ((bufpos + addrlen) >= buflim) {
+        if ((bufpos + addrlen) > buflim) {
             return -EBADMSG;
         }
 
         memcpy(addr_out, bufpos, addrlen);
+        *ttl = _ttl;
         return addrlen;
     }
 
-    return -1;
+    /* NXDOMAIN or no record of the requested family */
+    *ttl = _get_negative_ttl(buf, len, bufpos, ntohs(hdr->nscount));
+    return -EHOSTUNREACH;
 }
 
 int sock_dns_query(const char *domain_name, void *addr_out, int family)
@@ -181,6 +258,13 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
         return -ENOSPC;
     }
 
+#ifdef MODULE_SOCK_DNS_CACHE
+    int cached = sock_dns_cache_get(domain_name, addr_out, family);
+    if (cached != 0) {
+        return cached;
+    }
+#endif
+
     sock_dns_hdr_t *hdr = (sock_dns_hdr_t*) buf;
     memset(hdr, 0, sizeof(*hdr));
     hdr->id = 0; /* random? */
@@ -223,8 +307,14 @@ int sock_dns_query(const char *domain_name, void *addr_out, int family)
         res = sock_udp_recv(&sock_dns, reply_buf, sizeof(reply_buf), 1000000LU, NULL);
         if (res > 0) {
             if (res > (int)DNS_MIN_REPLY_LEN) {
-                if ((res = _parse_dns_reply(reply_buf, res, addr_out,
-                                            family)) > 0) {
+                uint32_t ttl;
+                res = sock_dns_parse_reply(reply_buf, res, addr_out, family, &ttl);
+                if ((res > 0) || (res == -EHOSTUNREACH)) {
+#ifdef MODULE_SOCK_DNS_CACHE
+                    sock_dns_cache_add(domain_name, addr_out,
+                                       (res > 0) ? (size_t)res : 0, family,
+                                       ttl);
+#endif
                     goto out;
                 }
             }
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_sock_dns
+ * @{
+ * @file
+ * @brief   sock DNS client cache implementation
+ * @author  Unwired Devices LLC <info@unwds.com>
+ * @}
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#include "mutex.h"
+#include "net/sock/dns.h"
+#include "xtimer.h"
+
+typedef struct {
+    char name[SOCK_DNS_MAX_NAME_LEN + 1];
+    uint8_t addr[IN6ADDRSZ];
+    uint8_t addrlen;    /* 0 for negative entries */
+    int8_t family;
+    uint32_t expires;   /* in seconds, 0 for unused entries */
+    uint32_t last_use;
+} _cache_entry_t;
+
+static _cache_entry_t _cache[SOCK_DNS_CACHE_SIZE];
+static mutex_t _cache_lock = MUTEX_INIT;
+static uint32_t _use_ctr;
+
+static uint32_t _now(void)
+{
+    /* shifted by one, so 0 is never a valid expiry time */
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC) + 1;
+}
+
+static bool _is_valid(const _cache_entry_t *entry, uint32_t now)
+{
+    return (entry->expires != 0) && ((int32_t)(entry->expires - now) > 0);
+}
+
+static _cache_entry_t *_find(const char *domain_name, int family)
+{
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        if ((_cache[i].expires != 0) && (_cache[i].family == family) &&
+            (strcasecmp(_cache[i].name, domain_name) == 0)) {
+            return &_cache[i];
+        }
+    }
+    return NULL;
+}
+
+int sock_dns_cache_get(const char *domain_name, void *addr_out, int family)
+{
+    int res = 0;
+
+    mutex_lock(&_cache_lock);
+    _cache_entry_t *entry = _find(domain_name, family);
+    if (entry != NULL) {
+        if (!_is_valid(entry, _now())) {
+            entry->expires = 0;
+        }
+        else if (entry->addrlen == 0) {
+            entry->last_use = ++_use_ctr;
+            res = -EHOSTUNREACH;
+        }
+        else {
+            entry->last_use = ++_use_ctr;
+            memcpy(addr_out, entry->addr, entry->addrlen);
+            res = entry->addrlen;
+        }
+    }
+    mutex_unlock(&_cache_lock);
+    return res;
+}
+
+void sock_dns_cache_add(const char *domain_name, const void *addr,
+                        size_t addrlen, int family, uint32_t ttl)
+{
+    if ((ttl == 0) || (addrlen > IN6ADDRSZ) ||
+        (strlen(domain_name) > SOCK_DNS_MAX_NAME_LEN)) {
+        return;
+    }
+    if (ttl > SOCK_DNS_CACHE_MAX_TTL) {
+        ttl = SOCK_DNS_CACHE_MAX_TTL;
+    }
+
+    mutex_lock(&_cache_lock);
+    uint32_t now = _now();
+    _cache_entry_t *entry = _find(domain_name, family);
+    if (entry == NULL) {
+        /* take an expired entry or the least recently used one */
+        entry = &_cache[0];
+        for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+            if (!_is_valid(&_cache[i], now)) {
+                entry = &_cache[i];
+                break;
+            }
+            if ((int32_t)(_cache[i].last_use - entry->last_use) < 0) {
+                entry = &_cache[i];
+            }
+        }
+        strcpy(entry->name, domain_name);
+        entry->family = family;
+    }
+    if (addrlen > 0) {
+        memcpy(entry->addr, addr, addrlen);
+    }
+    entry->addrlen = addrlen;
+    entry->expires = now + ttl;
+    entry->last_use = ++_use_ctr;
+    mutex_unlock(&_cache_lock);
+}
+
+void sock_dns_cache_flush(const char *domain_name)
+{
+    mutex_lock(&_cache_lock);
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        if ((domain_name == NULL) ||
+            (strcasecmp(_cache[i].name, domain_name) == 0)) {
+            _cache[i].expires = 0;
+        }
+    }
+    mutex_unlock(&_cache_lock);
+}
+
+void sock_dns_cache_print(void)
+{
+    char addr_str[INET6_ADDRSTRLEN];
+
+    mutex_lock(&_cache_lock);
+    uint32_t now = _now();
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        _cache_entry_t *entry = &_cache[i];
+
+        if (!_is_valid(entry, now)) {
+            continue;
+        }
+        if (entry->addrlen == 0) {
+            strcpy(addr_str, "-");
+        }
+        else {
+            inet_ntop((entry->addrlen == INADDRSZ) ? AF_INET : AF_INET6,
+                      entry->addr, addr_str, sizeof(addr_str));
+        }
+        printf("%-24s %-5s %s TTL %lu s\n", entry->name,
+               (entry->family == AF_INET) ? "A" :
+               (entry->family == AF_INET6) ? "AAAA" : "any",
+               addr_str, (unsigned long)(entry->expires - now));
+    }
+    mutex_unlock(&_cache_lock);
+}
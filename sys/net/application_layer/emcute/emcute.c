@@ -20,12 +20,16 @@
 
 #include <string.h>
 
+#include "irq.h"
 #include "log.h"
 #include "mutex.h"
 #include "sched.h"
 #include "xtimer.h"
 #include "byteorder.h"
 #include "thread_flags.h"
+#ifdef MODULE_EMCUTE_PUB_ASYNC
+#include "sema.h"
+#endif
 
 #include "net/emcute.h"
 #include "emcute_internal.h"
@@ -60,6 +64,27 @@ static volatile uint8_t waiton = 0xff;
 static volatile uint16_t waitonid = 0;
 static volatile int result;
 
+#ifdef MODULE_EMCUTE_PUB_ASYNC
+/**
+ * @brief   QoS 1 message published with emcute_pub_async()
+ */
+typedef struct {
+    emcute_topic_t *topic;          /**< topic of the message */
+    emcute_pub_cb_t cb;             /**< completion callback */
+    void *arg;                      /**< argument for cb */
+    uint32_t deadline;              /**< time of next retransmission [in us] */
+    uint16_t id;                    /**< message ID */
+    uint16_t len;                   /**< packet length, 0 if slot is unused */
+    uint8_t retries;                /**< retransmissions so far */
+    uint8_t flags_pos;              /**< position of the flags in buf */
+    uint8_t buf[EMCUTE_BUFSIZE];    /**< packet, kept for retransmissions */
+} inflight_t;
+
+static inflight_t inflight[EMCUTE_PUB_WINDOW];
+static mutex_t inflight_lock = MUTEX_INIT;
+static sema_t inflight_free = SEMA_CREATE(EMCUTE_PUB_WINDOW);
+#endif
+
 static size_t set_len(uint8_t *buf, size_t len)
 {
     if (len < (0xff - 7)) {
@@ -68,7 +93,7 @@ static size_t set_len(uint8_t *buf, size_t len)
     }
     else {
         buf[0] = 0x01;
-        byteorder_htobebufs(&tbuf[1], (uint16_t)(len + 3));
+        byteorder_htobebufs(&buf[1], (uint16_t)(len + 3));
         return 3;
     }
 }
@@ -85,6 +110,30 @@ static size_t get_len(uint8_t *buf, uint16_t *len)
     }
 }
 
+static uint16_t new_id(void)
+{
+    /* message IDs are taken by user threads holding different locks */
+    unsigned state = irq_disable();
+    uint16_t id = id_next++;
+    irq_restore(state);
+    return id;
+}
+
+static size_t build_publish(uint8_t *buf, const emcute_topic_t *topic,
+                            const void *data, size_t len, unsigned flags,
+                            uint16_t id)
+{
+    size_t pos = set_len(buf, (len + 6));
+    buf[pos++] = PUBLISH;
+    buf[pos++] = flags;
+    byteorder_htobebufs(&buf[pos], topic->id);
+    pos += 2;
+    byteorder_htobebufs(&buf[pos], id);
+    pos += 2;
+    memcpy(&buf[pos], data, len);
+    return (pos + len);
+}
+
 static void time_evt(void *arg)
 {
     thread_flags_set((thread_t *)arg, TFLAGS_TIMEOUT);
@@ -147,6 +196,102 @@ static void on_ack(uint8_t type, int id_pos, int ret_pos, int res_pos)
     }
 }
 
+#ifdef MODULE_EMCUTE_PUB_ASYNC
+/* must be called with inflight_lock held, which is released before the
+ * callback of the message is called */
+static void inflight_finish(inflight_t *msg, int res)
+{
+    emcute_topic_t *topic = msg->topic;
+    emcute_pub_cb_t cb = msg->cb;
+    void *arg = msg->arg;
+
+    msg->len = 0;
+    mutex_unlock(&inflight_lock);
+    sema_post(&inflight_free);
+
+    DEBUG("[emcute] pub async: message %u done [%i]\n", msg->id, res);
+    if (cb) {
+        cb(topic, res, arg);
+    }
+}
+
+static bool inflight_ack(void)
+{
+    uint16_t id = byteorder_bebuftohs(&rbuf[4]);
+
+    mutex_lock(&inflight_lock);
+    for (unsigned i = 0; i < EMCUTE_PUB_WINDOW; i++) {
+        if (inflight[i].len && (inflight[i].id == id)) {
+            inflight_finish(&inflight[i],
+                            (rbuf[6] == ACCEPT) ? EMCUTE_OK : EMCUTE_REJECT);
+            return true;
+        }
+    }
+    mutex_unlock(&inflight_lock);
+    return false;
+}
+
+static void inflight_flush(int res)
+{
+    mutex_lock(&inflight_lock);
+    for (unsigned i = 0; i < EMCUTE_PUB_WINDOW; i++) {
+        if (inflight[i].len) {
+            inflight_finish(&inflight[i], res);
+            mutex_lock(&inflight_lock);
+        }
+    }
+    mutex_unlock(&inflight_lock);
+}
+
+/* retransmits and times out messages in flight, returns the time until the
+ * next retransmission is due [in us] */
+static uint32_t inflight_service(void)
+{
+    uint32_t next = (EMCUTE_T_RETRY * US_PER_SEC);
+
+    mutex_lock(&inflight_lock);
+    for (unsigned i = 0; i < EMCUTE_PUB_WINDOW; i++) {
+        inflight_t *msg = &inflight[i];
+        if (msg->len == 0) {
+            continue;
+        }
+
+        uint32_t now = xtimer_now_usec();
+        int32_t left = (int32_t)(msg->deadline - now);
+        if (left > 0) {
+            if ((uint32_t)left < next) {
+                next = (uint32_t)left;
+            }
+            continue;
+        }
+        if (msg->retries == EMCUTE_N_RETRY) {
+            inflight_finish(msg, EMCUTE_TIMEOUT);
+            mutex_lock(&inflight_lock);
+            continue;
+        }
+
+        DEBUG("[emcute] pub async: resending message %u\n", msg->id);
+        msg->retries++;
+        msg->buf[msg->flags_pos] |= EMCUTE_DUP;
+        msg->deadline = now + (EMCUTE_T_RETRY * US_PER_SEC);
+        sock_udp_send(&sock, msg->buf, msg->len, &gateway);
+    }
+    mutex_unlock(&inflight_lock);
+
+    return next;
+}
+#endif
+
+static void on_puback(void)
+{
+#ifdef MODULE_EMCUTE_PUB_ASYNC
+    if (inflight_ack()) {
+        return;
+    }
+#endif
+    on_ack(PUBACK, 4, 6, 0);
+}
+
 static void on_publish(size_t len, size_t pos)
 {
     /* make sure packet length is valid - if not, drop packet silently */
@@ -293,7 +438,13 @@ int emcute_discon(void)
     tbuf[0] = 2;
     tbuf[1] = DISCONNECT;
 
-    return syncsend(DISCONNECT, 2, true);
+    int res = syncsend(DISCONNECT, 2, true);
+#ifdef MODULE_EMCUTE_PUB_ASYNC
+    if (res == EMCUTE_OK) {
+        inflight_flush(EMCUTE_NOGW);
+    }
+#endif
+    return res;
 }
 
 int emcute_reg(emcute_topic_t *topic)
@@ -312,8 +463,8 @@ int emcute_reg(emcute_topic_t *topic)
     tbuf[0] = (strlen(topic->name) + 6);
     tbuf[1] = REGISTER;
     byteorder_htobebufs(&tbuf[2], 0);
-    byteorder_htobebufs(&tbuf[4], id_next);
-    waitonid = id_next++;
+    waitonid = new_id();
+    byteorder_htobebufs(&tbuf[4], waitonid);
     memcpy(&tbuf[6], topic->name, strlen(topic->name));
 
     int res = syncsend(REGACK, (size_t)tbuf[0], true);
@@ -343,16 +494,8 @@ int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
 
     mutex_lock(&txlock);
 
-    size_t pos = set_len(tbuf, (len + 6));
-    len += (pos + 6);
-    tbuf[pos++] = PUBLISH;
-    tbuf[pos++] = flags;
-    byteorder_htobebufs(&tbuf[pos], topic->id);
-    pos += 2;
-    byteorder_htobebufs(&tbuf[pos], id_next);
-    waitonid = id_next++;
-    pos += 2;
-    memcpy(&tbuf[pos], data, len);
+    waitonid = new_id();
+    len = build_publish(tbuf, topic, data, len, flags, waitonid);
 
     if (flags & EMCUTE_QOS_1) {
         res = syncsend(PUBACK, len, true);
@@ -365,6 +508,81 @@ int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
     return res;
 }
 
+#ifdef MODULE_EMCUTE_PUB_ASYNC
+int emcute_pub_async(emcute_topic_t *topic, const void *data, size_t len,
+                     unsigned flags, emcute_pub_cb_t cb, void *arg)
+{
+    assert((topic->id != 0) && data && (len > 0) && !(flags & ~PUB_FLAGS));
+
+    if (!(flags & EMCUTE_QOS_MASK)) {
+        /* nothing to wait for */
+        int res = emcute_pub(topic, data, len, flags);
+        if ((res == EMCUTE_OK) && cb) {
+            cb(topic, res, arg);
+        }
+        return res;
+    }
+
+    if (gateway.port == 0) {
+        return EMCUTE_NOGW;
+    }
+    if (len >= (EMCUTE_BUFSIZE - 9)) {
+        return EMCUTE_OVERFLOW;
+    }
+    if (flags & EMCUTE_QOS_2) {
+        return EMCUTE_NOTSUP;
+    }
+
+    sema_wait(&inflight_free);
+    mutex_lock(&inflight_lock);
+
+    /* the connection may have been closed while waiting for a free slot */
+    if (gateway.port == 0) {
+        mutex_unlock(&inflight_lock);
+        sema_post(&inflight_free);
+        return EMCUTE_NOGW;
+    }
+
+    inflight_t *msg = NULL;
+    for (unsigned i = 0; i < EMCUTE_PUB_WINDOW; i++) {
+        if (inflight[i].len == 0) {
+            msg = &inflight[i];
+            break;
+        }
+    }
+    assert(msg);
+
+    msg->topic = topic;
+    msg->cb = cb;
+    msg->arg = arg;
+    msg->id = new_id();
+    msg->len = build_publish(msg->buf, topic, data, len, flags, msg->id);
+    msg->flags_pos = (msg->buf[0] == 0x01) ? 4 : 2;
+    msg->retries = 0;
+    msg->deadline = xtimer_now_usec() + (EMCUTE_T_RETRY * US_PER_SEC);
+
+    DEBUG("[emcute] pub async: sending message %u\n", msg->id);
+    sock_udp_send(&sock, msg->buf, msg->len, &gateway);
+
+    mutex_unlock(&inflight_lock);
+    return EMCUTE_OK;
+}
+
+unsigned emcute_pub_inflight(void)
+{
+    unsigned count = 0;
+
+    mutex_lock(&inflight_lock);
+    for (unsigned i = 0; i < EMCUTE_PUB_WINDOW; i++) {
+        if (inflight[i].len) {
+            count++;
+        }
+    }
+    mutex_unlock(&inflight_lock);
+    return count;
+}
+#endif
+
 int emcute_sub(emcute_sub_t *sub, unsigned flags)
 {
     assert(sub && (sub->cb) && (sub->topic.name) && !(flags & ~SUB_FLAGS));
@@ -381,8 +599,8 @@ int emcute_sub(emcute_sub_t *sub, unsigned flags)
     tbuf[0] = (strlen(sub->topic.name) + 5);
     tbuf[1] = SUBSCRIBE;
     tbuf[2] = flags;
-    byteorder_htobebufs(&tbuf[3], id_next);
-    waitonid = id_next++;
+    waitonid = new_id();
+    byteorder_htobebufs(&tbuf[3], waitonid);
     memcpy(&tbuf[5], sub->topic.name, strlen(sub->topic.name));
 
     int res = syncsend(SUBACK, (size_t)tbuf[0], false);
@@ -417,8 +635,8 @@ int emcute_unsub(emcute_sub_t *sub)
     tbuf[0] = (strlen(sub->topic.name) + 5);
     tbuf[1] = UNSUBSCRIBE;
     tbuf[2] = 0;
-    byteorder_htobebufs(&tbuf[3], id_next);
-    waitonid = id_next++;
+    waitonid = new_id();
+    byteorder_htobebufs(&tbuf[3], waitonid);
     memcpy(&tbuf[5], sub->topic.name, strlen(sub->topic.name));
 
     int res = syncsend(UNSUBACK, (size_t)tbuf[0], false);
@@ -538,7 +756,7 @@ void emcute_run(uint16_t port, const char *id)
                 case WILLMSGREQ:    on_ack(type, 0, 0, 0);              break;
                 case REGACK:        on_ack(type, 4, 6, 2);              break;
                 case PUBLISH:       on_publish((size_t)pkt_len, pos);   break;
-                case PUBACK:        on_ack(type, 4, 6, 0);              break;
+                case PUBACK:        on_puback();                        break;
                 case SUBACK:        on_ack(type, 5, 7, 3);              break;
                 case UNSUBACK:      on_ack(type, 2, 0, 0);              break;
                 case PINGREQ:       on_pingreq(&remote);                break;
@@ -561,5 +779,13 @@ void emcute_run(uint16_t port, const char *id)
         else {
             t_out = (EMCUTE_KEEPALIVE * US_PER_SEC) - (now - start);
         }
+#ifdef MODULE_EMCUTE_PUB_ASYNC
+        /* wake up at least every EMCUTE_T_RETRY, so messages published while
+         * waiting for a packet are retransmitted in time */
+        uint32_t t_retry = inflight_service();
+        if (t_retry < t_out) {
+            t_out = t_retry;
+        }
+#endif
     }
 }
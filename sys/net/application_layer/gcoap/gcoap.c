@@ -42,13 +42,18 @@
 static void *_event_loop(void *arg);
 static void _listen(sock_udp_t *sock);
 static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len, void *ctx);
+static size_t _get_resource_list(coap_block_slicer_t *slicer, uint8_t *buf);
 static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                                                          sock_udp_ep_t *remote);
 static void _expire_request(gcoap_request_memo_t *memo);
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                            const sock_udp_ep_t *remote);
-static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
-                                            gcoap_listener_t **listener_ptr);
+int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
+                                     gcoap_listener_t **listener_ptr);
+static int _find_resource_in_listeners(const char *uri, unsigned method_flag,
+                                       const coap_resource_t **resource_ptr,
+                                       gcoap_listener_t **listener_ptr);
+static size_t _index_lower_bound(const char *path);
 static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote);
 static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
                                                        coap_pkt_t *pdu);
@@ -67,10 +72,22 @@ static gcoap_listener_t _default_listener = {
     NULL
 };
 
+/* Entry of the resource index */
+typedef struct {
+    const coap_resource_t *resource;    /* Indexed resource */
+    gcoap_listener_t *listener;         /* Listener of the resource */
+} gcoap_index_entry_t;
+
 /* Container for the state of gcoap itself */
 typedef struct {
     mutex_t lock;                       /* Shares state attributes safely */
     gcoap_listener_t *listeners;        /* List of registered listeners */
+    gcoap_index_entry_t index[GCOAP_RESOURCE_INDEX_SIZE];
+                                        /* Resources of all listeners, sorted
+                                           by path */
+    unsigned index_len;                 /* Count of entries in index */
+    bool index_overflow;                /* Some resources didn't fit into
+                                           index; search listeners instead */
     gcoap_request_memo_t open_reqs[GCOAP_REQ_WAITING_MAX];
                                         /* Storage for open requests; if first
                                            byte of an entry is zero, the entry
@@ -89,6 +106,10 @@ typedef struct {
 
 static gcoap_state_t _coap_state = {
     .listeners   = &_default_listener,
+    .index       = {
+        { &_default_resources[0], &_default_listener },
+    },
+    .index_len   = 1,
 };
 
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
@@ -171,15 +192,19 @@ static void _listen(sock_udp_t *sock)
     sock_udp_ep_t remote;
     gcoap_request_memo_t *memo = NULL;
     uint8_t open_reqs = gcoap_op_state();
+    void *msg, *msg_ctx = NULL;
 
     /* We expect a -EINTR response here when unlimited waiting (SOCK_NO_TIMEOUT)
      * is interrupted when sending a message in gcoap_req_send2(). While a
-     * request is outstanding, sock_udp_recv() is called here with limited
+     * request is outstanding, sock_udp_recv_buf() is called here with limited
      * waiting so the request's timeout can be handled in a timely manner in
-     * _event_loop(). */
-    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf),
-                                open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT,
-                                &remote);
+     * _event_loop().
+     *
+     * The message is parsed where the stack received it, so buf is only
+     * needed to write a response. */
+    ssize_t res = sock_udp_recv_buf(sock, &msg, &msg_ctx,
+                                    open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT,
+                                    &remote);
     if (res <= 0) {
 #if ENABLE_DEBUG
         if (res < 0 && res != -ETIMEDOUT) {
@@ -189,16 +214,16 @@ static void _listen(sock_udp_t *sock)
         return;
     }
 
-    res = coap_parse(&pdu, buf, res);
+    res = coap_parse(&pdu, msg, res);
     if (res < 0) {
         DEBUG("gcoap: parse failure: %d\n", (int)res);
         /* If a response, can't clear memo, but it will timeout later. */
-        return;
+        goto out;
     }
 
     if (pdu.hdr->code == COAP_CODE_EMPTY) {
         DEBUG("gcoap: empty messages not handled yet\n");
-        return;
+        goto out;
     }
 
     /* validate class and type for incoming */
@@ -255,6 +280,13 @@ static void _listen(sock_udp_t *sock)
     default:
         DEBUG("gcoap: illegal code class: %u\n", coap_get_code_class(&pdu));
     }
+
+out:
+    /* a CoAP message fits into the first buffer of the stack, drop the rest
+     * and release the message */
+    while (sock_udp_recv_buf(sock, &msg, &msg_ctx, 0, NULL) > 0) {
+        DEBUG("gcoap: dropped trailing data of message\n");
+    }
 }
 
 /*
@@ -378,21 +410,68 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
  *        `GCOAP_RESOURCE_WRONG_METHOD` if a resource was found but the method
  *        code didn't match and `GCOAP_RESOURCE_NO_PATH` if no matching
  *        resource was found.
+ *
+ * Not static, so the unittests can check the resource index.
  */
-static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
-                                            gcoap_listener_t **listener_ptr)
+int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
+                                     gcoap_listener_t **listener_ptr)
 {
     int ret = GCOAP_RESOURCE_NO_PATH;
     unsigned method_flag = coap_method2flag(coap_get_code_detail(pdu));
 
-    /* Find path for CoAP msg among listener resources and execute callback. */
-    gcoap_listener_t *listener = _coap_state.listeners;
-
     uint8_t uri[NANOCOAP_URI_MAX];
     if (coap_get_uri_path(pdu, uri) <= 0) {
         return GCOAP_RESOURCE_NO_PATH;
     }
 
+    /* protect the index from a concurrent gcoap_register_listener() */
+    mutex_lock(&_coap_state.lock);
+    if (_coap_state.index_overflow) {
+        ret = _find_resource_in_listeners((char *)uri, method_flag,
+                                          resource_ptr, listener_ptr);
+        mutex_unlock(&_coap_state.lock);
+        return ret;
+    }
+
+    /* Equal paths are indexed in the order of their listeners, so the first
+     * one with a matching method wins, like in the listener walk. */
+    for (size_t i = _index_lower_bound((char *)uri);
+         i < _coap_state.index_len; i++) {
+        const gcoap_index_entry_t *entry = &_coap_state.index[i];
+
+        if (strcmp((char *)uri, entry->resource->path) != 0) {
+            break;
+        }
+        if (!(entry->resource->methods & method_flag)) {
+            ret = GCOAP_RESOURCE_WRONG_METHOD;
+            continue;
+        }
+
+        *resource_ptr = entry->resource;
+        *listener_ptr = entry->listener;
+        ret = GCOAP_RESOURCE_FOUND;
+        break;
+    }
+    mutex_unlock(&_coap_state.lock);
+
+    return ret;
+}
+
+/*
+ * Searches listener registrations in order for the resource matching a path.
+ * Used when not all resources fit into the resource index.
+ *
+ * Parameters and return values are the same as for _find_resource().
+ */
+static int _find_resource_in_listeners(const char *uri, unsigned method_flag,
+                                       const coap_resource_t **resource_ptr,
+                                       gcoap_listener_t **listener_ptr)
+{
+    int ret = GCOAP_RESOURCE_NO_PATH;
+
+    /* Find path for CoAP msg among listener resources and execute callback. */
+    gcoap_listener_t *listener = _coap_state.listeners;
+
     while (listener) {
         const coap_resource_t *resource = listener->resources;
         for (size_t i = 0; i < listener->resources_len; i++) {
@@ -400,7 +479,7 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
                 resource++;
             }
 
-            int res = strcmp((char *)&uri[0], resource->path);
+            int res = strcmp(uri, resource->path);
             if (res > 0) {
                 continue;
             }
@@ -425,6 +504,30 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
     return ret;
 }
 
+/*
+ * Finds the position of the first entry in the resource index with a path
+ * not less than the given one.
+ *
+ * return index_len if all paths are less than path
+ */
+static size_t _index_lower_bound(const char *path)
+{
+    size_t lo = 0;
+    size_t hi = _coap_state.index_len;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (strcmp(_coap_state.index[mid].resource->path, path) < 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
 /*
  * Finds the memo for an outstanding request within the _coap_state.open_reqs
  * array. Matches on remote endpoint and token.
@@ -496,16 +599,86 @@ static void _expire_request(gcoap_request_memo_t *memo)
 /*
  * Handler for /.well-known/core. Lists registered handlers, except for
  * /.well-known/core itself.
+ *
+ * The list is sent in a single response if it fits into the PDU buffer and
+ * the client did not ask for a block. Otherwise it is sent block-wise.
  */
 static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len, void *ctx)
 {
     (void)ctx;
-   /* write header */
+    coap_block_slicer_t slicer;
+    coap_block1_t block2;
+
+    /* read the requested block before the request is overwritten */
+    bool blockwise = coap_get_block2(pdu, &block2);
+    coap_block2_init(pdu, &slicer);
+
+    /* write header */
     gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
-    int plen = gcoap_get_resource_list(pdu->payload, (size_t)pdu->payload_len,
-                                      COAP_FORMAT_LINK);
+    coap_opt_add_uint(pdu, COAP_OPT_CONTENT_FORMAT, COAP_FORMAT_LINK);
+
+    size_t list_len = gcoap_get_resource_list(NULL, 0, COAP_FORMAT_LINK);
+    if (!blockwise && (list_len < pdu->payload_len)) {
+        /* whole list fits after the payload marker */
+        ssize_t plen = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+        return plen + gcoap_get_resource_list(pdu->payload, pdu->payload_len,
+                                              COAP_FORMAT_LINK);
+    }
+
+    coap_opt_add_block2(pdu, &slicer, true);
+    ssize_t plen = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+
+    if ((slicer.end - slicer.start) > pdu->payload_len) {
+        DEBUG("gcoap: block size exceeds PDU buffer\n");
+        return -1;
+    }
+
     /* response content */
-    return gcoap_finish(pdu, (size_t)plen, COAP_FORMAT_LINK);
+    size_t blen = _get_resource_list(&slicer, pdu->payload);
+
+    if (slicer.start && (slicer.cur <= slicer.start)) {
+        /* requested block beyond the end of the list */
+        return gcoap_response(pdu, buf, len, COAP_CODE_BAD_OPTION);
+    }
+    coap_block2_finish(&slicer);
+
+    return plen + blen;
+}
+
+/*
+ * Writes the resource list in CoRE Link Format, except for /.well-known/core.
+ * Only the part of the list within the window of the slicer is written.
+ *
+ * slicer[inout] -- Window to write; cur is advanced by the length of the list
+ * buf[out] -- Buffer for the window
+ *
+ * return Count of bytes written to buf
+ */
+static size_t _get_resource_list(coap_block_slicer_t *slicer, uint8_t *buf)
+{
+    uint8_t *bufpos = buf;
+
+    /* skip the first listener, gcoap itself (we skip /.well-known/core) */
+    gcoap_listener_t *listener = _coap_state.listeners->next;
+
+    while (listener) {
+        const coap_resource_t *resource = listener->resources;
+
+        for (unsigned i = 0; i < listener->resources_len; i++) {
+            if (slicer->cur) {
+                bufpos += coap_blockwise_put_char(slicer, bufpos, ',');
+            }
+            bufpos += coap_blockwise_put_char(slicer, bufpos, '<');
+            bufpos += coap_blockwise_put_bytes(slicer, bufpos,
+                                               (uint8_t *)resource->path,
+                                               strlen(resource->path));
+            bufpos += coap_blockwise_put_char(slicer, bufpos, '>');
+            ++resource;
+        }
+        listener = listener->next;
+    }
+
+    return bufpos - buf;
 }
 
 /*
@@ -624,6 +797,8 @@ kernel_pid_t gcoap_init(void)
 
 void gcoap_register_listener(gcoap_listener_t *listener)
 {
+    mutex_lock(&_coap_state.lock);
+
     /* Add the listener to the end of the linked list. */
     gcoap_listener_t *_last = _coap_state.listeners;
     while (_last->next) {
@@ -632,6 +807,31 @@ void gcoap_register_listener(gcoap_listener_t *listener)
 
     listener->next = NULL;
     _last->next = listener;
+
+    /* Add its resources to the index, after resources with the same path */
+    if ((_coap_state.index_len + listener->resources_len)
+            > GCOAP_RESOURCE_INDEX_SIZE) {
+        DEBUG("gcoap: resource index full, searching listeners instead\n");
+        _coap_state.index_overflow = true;
+    }
+    for (size_t i = 0; !_coap_state.index_overflow &&
+                       (i < listener->resources_len); i++) {
+        const coap_resource_t *resource = &listener->resources[i];
+        size_t pos = _index_lower_bound(resource->path);
+
+        while ((pos < _coap_state.index_len) &&
+               (strcmp(_coap_state.index[pos].resource->path,
+                       resource->path) == 0)) {
+            pos++;
+        }
+        memmove(&_coap_state.index[pos + 1], &_coap_state.index[pos],
+                (_coap_state.index_len - pos) * sizeof(gcoap_index_entry_t));
+        _coap_state.index[pos].resource = resource;
+        _coap_state.index[pos].listener = listener;
+        _coap_state.index_len++;
+    }
+
+    mutex_unlock(&_coap_state.lock);
 }
 
 int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
@@ -837,13 +1037,22 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
 
 int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
 {
+    unsigned header_len  = coap_get_total_hdr_len(pdu);
+
+    if ((uint8_t *)pdu->hdr != buf) {
+        /* the request was parsed in the receive buffer of the stack, so the
+         * response starts with a copy of its header and token in buf */
+        memcpy(buf, pdu->hdr, header_len);
+        pdu->hdr = (coap_hdr_t *)buf;
+        if (pdu->token != NULL) {
+            pdu->token = buf + sizeof(coap_hdr_t);
+        }
+    }
     if (coap_get_type(pdu) == COAP_TYPE_CON) {
         coap_hdr_set_type(pdu->hdr, COAP_TYPE_ACK);
     }
     coap_hdr_set_code(pdu->hdr, code);
 
-    unsigned header_len  = coap_get_total_hdr_len(pdu);
-
     pdu->options_len = 0;
     pdu->payload     = buf + header_len;
     pdu->payload_len = len - header_len - GCOAP_RESP_OPTIONS_BUF;
@@ -921,39 +1130,19 @@ int gcoap_get_resource_list(void *buf, size_t maxlen, uint8_t cf)
     (void)cf; /* only used in the assert below. */
     assert(cf == COAP_FORMAT_LINK);
 
-    /* skip the first listener, gcoap itself (we skip /.well-known/core) */
-    gcoap_listener_t *listener = _coap_state.listeners->next;
-
+    /* without a buffer the window is empty, so the list is only measured */
+    coap_block_slicer_t slicer = { .end = (buf) ? maxlen : 0 };
     char *out = (char *)buf;
-    size_t pos = 0;
+    size_t pos = _get_resource_list(&slicer, buf);
 
-    /* write payload */
-    while (listener) {
-        const coap_resource_t *resource = listener->resources;
-
-        for (unsigned i = 0; i < listener->resources_len; i++) {
-            size_t path_len = strlen(resource->path);
-            if (out) {
-                /* only add new resources if there is space in the buffer */
-                if ((pos + path_len + 3) > maxlen) {
-                    break;
-                }
-                if (pos) {
-                    out[pos++] = ',';
-                }
-                out[pos++] = '<';
-                memcpy(&out[pos], resource->path, path_len);
-                pos += path_len;
-                out[pos++] = '>';
-            }
-            else {
-                pos += (pos) ? 3 : 2;
-                pos += path_len;
-            }
-            ++resource;
+    if (!out) {
+        return (int)slicer.cur;
+    }
+    if (slicer.cur > maxlen) {
+        /* only keep the resources that fit into the buffer */
+        while (pos && (out[pos - 1] != '>')) {
+            pos--;
         }
-
-        listener = listener->next;
     }
 
     return (int)pos;
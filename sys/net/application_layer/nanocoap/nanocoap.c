@@ -790,6 +790,25 @@ ssize_t coap_opt_add_uint(coap_pkt_t *pkt, uint16_t optnum, uint32_t value)
     return _add_opt_pkt(pkt, optnum, (uint8_t *)&tmp, tmp_len);
 }
 
+ssize_t coap_opt_add_block2(coap_pkt_t *pkt, coap_block_slicer_t *slicer,
+                            bool more)
+{
+    uint32_t blkopt = (_slicer_blknum(slicer) << 4)
+                      | _size2szx(slicer->end - slicer->start)
+                      | (more ? 0x8 : 0);
+
+    slicer->opt = pkt->payload;
+    return coap_opt_add_uint(pkt, COAP_OPT_BLOCK2, blkopt);
+}
+
+ssize_t coap_opt_add_block1_control(coap_pkt_t *pkt, coap_block1_t *block1)
+{
+    uint32_t blkopt = (block1->blknum << 4) | block1->szx
+                      | (block1->more ? 0x8 : 0);
+
+    return coap_opt_add_uint(pkt, COAP_OPT_BLOCK1, blkopt);
+}
+
 ssize_t coap_opt_finish(coap_pkt_t *pkt, uint16_t flags)
 {
     if (flags & COAP_OPT_FINISH_PAYLOAD) {
@@ -818,6 +837,10 @@ void coap_block2_init(coap_pkt_t *pkt, coap_block_slicer_t *slicer)
             szx = NANOCOAP_BLOCK_SIZE_EXP_MAX - 4;
         }
     }
+    else {
+        /* The client didn't ask for a block size, so use our own maximum */
+        szx = NANOCOAP_BLOCK_SIZE_EXP_MAX - 4;
+    }
     slicer->start = blknum * coap_szx2size(szx);
     slicer->end = slicer->start + coap_szx2size(szx);
     slicer->cur = 0;
@@ -831,10 +854,19 @@ void coap_block2_finish(coap_block_slicer_t *slicer)
      * We don't know this position, but we know we can read the option because
      * it's already in the buffer. So just point past the option. */
     uint8_t *pos = slicer->opt + 1;
-    uint16_t delta = _decode_value(*slicer->opt >> 4, &pos, slicer->opt + 3);
-    int more = (slicer->cur > slicer->end) ? 1 : 0;
+    _decode_value(*slicer->opt >> 4, &pos, slicer->opt + 3);
+    unsigned len = *slicer->opt & 0xf;
 
-    coap_opt_put_block2(slicer->opt, COAP_OPT_BLOCK2 - delta, slicer, more);
+    /* The option was written with the more flag set, so its value is not
+     * empty. Only the flag in its last byte changes, which keeps the length
+     * of the option and the position of anything written after it. */
+    assert(len > 0);
+    if (slicer->cur > slicer->end) {
+        pos[len - 1] |= 0x8;
+    }
+    else {
+        pos[len - 1] &= ~0x8;
+    }
 }
 
 ssize_t coap_block2_build_reply(coap_pkt_t *pkt, unsigned code,
@@ -133,23 +133,30 @@ int nanocoap_server(sock_udp_ep_t *local, uint8_t *buf, size_t bufsize)
     }
 
     while (1) {
-        res = sock_udp_recv(&sock, buf, bufsize, -1, &remote);
+        void *req, *req_ctx = NULL;
+
+        /* the request is parsed where the stack received it, buf only takes
+         * the response */
+        res = sock_udp_recv_buf(&sock, &req, &req_ctx, SOCK_NO_TIMEOUT,
+                                &remote);
         if (res < 0) {
             DEBUG("error receiving UDP packet\n");
             return -1;
         }
         else if (res > 0) {
             coap_pkt_t pkt;
-            if (coap_parse(&pkt, (uint8_t *)buf, res) < 0) {
+            if (coap_parse(&pkt, req, res) < 0) {
                 DEBUG("error parsing packet\n");
-                continue;
             }
-            if ((res = coap_handle_req(&pkt, buf, bufsize)) > 0) {
+            else if ((res = coap_handle_req(&pkt, buf, bufsize)) > 0) {
                 res = sock_udp_send(&sock, buf, res, &remote);
             }
             else {
                 DEBUG("error handling request %d\n", (int)res);
             }
+            /* drop what does not fit into the first buffer and release the
+             * request */
+            while (sock_udp_recv_buf(&sock, &req, &req_ctx, 0, NULL) > 0) {}
         }
     }
 
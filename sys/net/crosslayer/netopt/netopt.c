@@ -93,6 +93,8 @@ static const char *_netopt_strmap[] = {
     [NETOPT_BLE_CTX]               = "NETOPT_BLE_CTX",
     [NETOPT_CHECKSUM]              = "NETOPT_CHECKSUM",
     [NETOPT_PHY_BUSY]              = "NETOPT_PHY_BUSY",
+    [NETOPT_6LO_SFR]               = "NETOPT_6LO_SFR",
+    [NETOPT_RX_SNIFF]              = "NETOPT_RX_SNIFF",
     [NETOPT_NUMOF]                 = "NETOPT_NUMOF",
 };
 
@@ -154,6 +154,9 @@ void gnrc_netif_ipv6_init_mtu(gnrc_netif_t *netif)
         case NETDEV_TYPE_NRFMIN:
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
             netif->flags |= GNRC_NETIF_FLAGS_6LO_HC;
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+            netif->flags |= GNRC_NETIF_FLAGS_6LO_SFR;
 #endif
             /* intentionally falls through */
         case NETDEV_TYPE_ESP_NOW:
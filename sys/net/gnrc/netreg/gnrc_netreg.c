@@ -28,13 +28,26 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#if (GNRC_NETREG_BUCKETS & (GNRC_NETREG_BUCKETS - 1)) != 0
+#error "GNRC_NETREG_BUCKETS must be a power of 2"
+#endif
+
+/* The registry as hash table by gnrc_nettype_t and demux context */
+static gnrc_netreg_entry_t *netreg[GNRC_NETREG_BUCKETS];
+
+static inline unsigned _bucket(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    /* multiplicative hashing, the upper half of the product mixes all bits
+     * of the key */
+    uint32_t key = demux_ctx ^ ((uint32_t)type << 24);
+
+    return ((key * 2654435769UL) >> 16) & (GNRC_NETREG_BUCKETS - 1);
+}
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -59,7 +72,8 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    entry->nettype = type;
+    LL_PREPEND(netreg[_bucket(type, entry->demux_ctx)], entry);
 
     return 0;
 }
@@ -70,7 +84,12 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    gnrc_netreg_entry_t **head = &netreg[_bucket(type, entry->demux_ctx)];
+
+    /* the bucket may be empty when the entry was never registered */
+    if (*head != NULL) {
+        LL_DELETE(*head, entry);
+    }
 }
 
 /**
@@ -89,11 +108,22 @@ static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
                                            gnrc_nettype_t type,
                                            uint32_t demux_ctx)
 {
-    gnrc_netreg_entry_t *res = NULL;
+    gnrc_netreg_entry_t *res;
 
-    if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
-        LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
+    if (from) {
+        res = from->next;
+        type = from->nettype;
+    }
+    else if (!_INVALID_TYPE(type)) {
+        res = netreg[_bucket(type, demux_ctx)];
+    }
+    else {
+        return NULL;
+    }
+    /* other types and demux contexts may share the bucket */
+    while ((res != NULL) &&
+           ((res->demux_ctx != demux_ctx) || (res->nettype != type))) {
+        res = res->next;
     }
 
     return res;
@@ -43,6 +43,13 @@ static _nib_dr_entry_t _def_routers[GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 static _nib_abr_entry_t _abrs[GNRC_IPV6_NIB_ABR_NUMOF];
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 
+/* on-link entries hashed by address, each bucket sorted like _nodes */
+static _nib_onl_entry_t *_onl_buckets[GNRC_IPV6_NIB_ONL_BUCKETS];
+/* off-link entries hashed by prefix and prefix length, sorted like _dsts */
+static _nib_offl_entry_t *_offl_buckets[GNRC_IPV6_NIB_OFFL_BUCKETS];
+/* prefix lengths used by off-link entries */
+static BITFIELD(_offl_lens, IPV6_ADDR_BIT_LEN + 1);
+
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 mutex_t _nib_mutex = MUTEX_INIT;
@@ -51,6 +58,27 @@ evtimer_msg_t _nib_evtimer;
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node);
 static inline bool _node_unreachable(_nib_onl_entry_t *node);
+static void _onl_index(_nib_onl_entry_t *node);
+static _nib_onl_entry_t *_onl_match(const ipv6_addr_t *addr, unsigned iface);
+static void _offl_index(_nib_offl_entry_t *dst);
+static void _offl_unindex(_nib_offl_entry_t *dst);
+static _nib_offl_entry_t *_offl_bucket_first(const ipv6_addr_t *pfx,
+                                             unsigned pfx_len);
+
+static unsigned _hash(const ipv6_addr_t *addr, unsigned len, unsigned buckets)
+{
+    uint32_t h = len;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(addr->u32); i++) {
+        h = (h ^ addr->u32[i].u32) * 0x9e3779b1;
+    }
+    return (h ^ (h >> 16)) & (buckets - 1);
+}
+
+static inline unsigned _onl_bucket(const ipv6_addr_t *addr)
+{
+    return _hash(addr, 0, GNRC_IPV6_NIB_ONL_BUCKETS);
+}
 
 void _nib_init(void)
 {
@@ -60,6 +88,9 @@ void _nib_init(void)
     memset(_nodes, 0, sizeof(_nodes));
     memset(_def_routers, 0, sizeof(_def_routers));
     memset(_dsts, 0, sizeof(_dsts));
+    memset(_onl_buckets, 0, sizeof(_onl_buckets));
+    memset(_offl_buckets, 0, sizeof(_offl_buckets));
+    memset(_offl_lens, 0, sizeof(_offl_lens));
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
@@ -82,18 +113,22 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
     DEBUG("nib: Allocating on-link node entry (addr = %s, iface = %u)\n",
           (addr == NULL) ? "NULL" : ipv6_addr_to_str(addr_str, addr,
                                                      sizeof(addr_str)), iface);
-    for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+    if (addr != NULL) {
+        node = _onl_match(addr, iface);
+    }
+    for (unsigned i = 0; (node == NULL) && (i < GNRC_IPV6_NIB_NUMOF); i++) {
         _nib_onl_entry_t *tmp = &_nodes[i];
 
-        if ((_nib_onl_get_if(tmp) == iface) && _addr_equals(addr, tmp)) {
-            /* exact match */
+        /* without address any entry on the interface will do */
+        if ((addr == NULL) && (_nib_onl_get_if(tmp) == iface)) {
             DEBUG("  %p is an exact match\n", (void *)tmp);
             node = tmp;
-            break;
         }
-        if ((node == NULL) && (tmp->mode == _EMPTY)) {
+    }
+    for (unsigned i = 0; (node == NULL) && (i < GNRC_IPV6_NIB_NUMOF); i++) {
+        if (_nodes[i].mode == _EMPTY) {
+            node = &_nodes[i];
             DEBUG("  using %p\n", (void *)node);
-            node = tmp;
         }
     }
     if (node != NULL) {
@@ -209,9 +244,8 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
-    for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
-        _nib_onl_entry_t *node = &_nodes[i];
-
+    for (_nib_onl_entry_t *node = _onl_buckets[_onl_bucket(addr)];
+         node != NULL; node = node->hash_next) {
         if ((node->mode != _EMPTY) &&
             /* either requested or current interface undefined or
              * interfaces equal */
@@ -469,8 +503,8 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
           iface);
     DEBUG("pfx = %s/%u)\n", ipv6_addr_to_str(addr_str, pfx,
                                              sizeof(addr_str)), pfx_len);
-    for (unsigned i = 0; i < GNRC_IPV6_NIB_OFFL_NUMOF; i++) {
-        _nib_offl_entry_t *tmp = &_dsts[i];
+    for (_nib_offl_entry_t *tmp = _offl_bucket_first(pfx, pfx_len);
+         tmp != NULL; tmp = tmp->hash_next) {
         _nib_onl_entry_t *tmp_node = tmp->next_hop;
 
         if ((tmp->pfx_len == pfx_len) &&                /* prefix length matches and */
@@ -481,13 +515,17 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             /* exact match (or next hop address was previously unset) */
             DEBUG("  %p is an exact match\n", (void *)tmp);
             if (next_hop != NULL) {
+                _nib_onl_unindex(tmp_node);
                 memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
+                _onl_index(tmp_node);
             }
             tmp->next_hop->mode |= _DST;
             return tmp;
         }
-        if ((dst == NULL) && (tmp_node == NULL)) {
-            dst = tmp;
+    }
+    for (unsigned i = 0; (dst == NULL) && (i < GNRC_IPV6_NIB_OFFL_NUMOF); i++) {
+        if (_dsts[i].next_hop == NULL) {
+            dst = &_dsts[i];
         }
     }
     if (dst != NULL) {
@@ -502,6 +540,7 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+        _offl_index(dst);
     }
     return dst;
 }
@@ -533,6 +572,7 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+        _offl_unindex(dst);
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -558,31 +598,38 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
 
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
-    _nib_offl_entry_t *res = NULL;
-    uint8_t best_match = 0;
-
     DEBUG("nib: get match for destination %s from NIB\n",
           ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
-    for (_nib_offl_entry_t *entry = _dsts; _in_dsts(entry); entry++) {
-        if (entry->mode != _EMPTY) {
-            uint8_t match = ipv6_addr_match_prefix(&entry->pfx, dst);
-
-            DEBUG("nib: %s/%u => ",
-                  ipv6_addr_to_str(addr_str, &entry->pfx, sizeof(addr_str)),
-                  entry->pfx_len);
-            DEBUG("%s%%%u matches with %u bits\n",
-                  (entry->mode == _PL) ? "(nil)" :
-                  ipv6_addr_to_str(addr_str, &entry->next_hop->ipv6,
-                                   sizeof(addr_str)),
-                  _nib_onl_get_if(entry->next_hop), match);
-            if ((match > best_match) && (match >= entry->pfx_len)) {
-                DEBUG("nib: best match (%u bits)\n", match);
-                res = entry;
-                best_match = match;
+    /* try the prefix lengths in use from the longest down, the first entry
+     * found is the longest match */
+    for (int pfx_len = IPV6_ADDR_BIT_LEN; pfx_len > 0; pfx_len--) {
+        if (_offl_lens[pfx_len / 8] == 0) {
+            pfx_len &= ~0x7;
+            continue;
+        }
+        if (!bf_isset(_offl_lens, pfx_len)) {
+            continue;
+        }
+        ipv6_addr_t pfx = IPV6_ADDR_UNSPECIFIED;
+
+        ipv6_addr_init_prefix(&pfx, dst, pfx_len);
+        for (_nib_offl_entry_t *entry = _offl_bucket_first(&pfx, pfx_len);
+             entry != NULL; entry = entry->hash_next) {
+            if ((entry->mode != _EMPTY) && (entry->pfx_len == pfx_len) &&
+                ipv6_addr_equal(&entry->pfx, &pfx)) {
+                DEBUG("nib: best match %s/%u => ",
+                      ipv6_addr_to_str(addr_str, &entry->pfx,
+                                       sizeof(addr_str)), entry->pfx_len);
+                DEBUG("%s%%%u\n",
+                      (entry->mode == _PL) ? "(nil)" :
+                      ipv6_addr_to_str(addr_str, &entry->next_hop->ipv6,
+                                       sizeof(addr_str)),
+                      _nib_onl_get_if(entry->next_hop));
+                return entry;
             }
         }
     }
-    return res;
+    return NULL;
 }
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
@@ -808,11 +855,115 @@ _nib_offl_entry_t *_nib_pl_add(unsigned iface,
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node)
 {
+    _nib_onl_unindex(node);
     _nib_onl_clear(node);
     if (addr != NULL) {
         memcpy(&node->ipv6, addr, sizeof(node->ipv6));
     }
     _nib_onl_set_if(node, iface);
+    _onl_index(node);
+}
+
+static void _onl_index(_nib_onl_entry_t *node)
+{
+    _nib_onl_entry_t **ptr = &_onl_buckets[_onl_bucket(&node->ipv6)];
+
+    /* keep the chain in array order so lookups find what a linear search
+     * over _nodes would find first */
+    while ((*ptr != NULL) && (*ptr < node)) {
+        ptr = &(*ptr)->hash_next;
+    }
+    node->hash_next = *ptr;
+    *ptr = node;
+}
+
+void _nib_onl_unindex(_nib_onl_entry_t *node)
+{
+    for (_nib_onl_entry_t **ptr = &_onl_buckets[_onl_bucket(&node->ipv6)];
+         *ptr != NULL; ptr = &(*ptr)->hash_next) {
+        if (*ptr == node) {
+            *ptr = node->hash_next;
+            node->hash_next = NULL;
+            return;
+        }
+    }
+}
+
+static _nib_onl_entry_t *_onl_match_bucket(const ipv6_addr_t *addr,
+                                           unsigned iface)
+{
+    for (_nib_onl_entry_t *node = _onl_buckets[_onl_bucket(addr)];
+         node != NULL; node = node->hash_next) {
+        if ((_nib_onl_get_if(node) == iface) && _addr_equals(addr, node)) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+static _nib_onl_entry_t *_onl_match(const ipv6_addr_t *addr, unsigned iface)
+{
+    /* entries without address yet match any address, see _addr_equals() */
+    _nib_onl_entry_t *node = _onl_match_bucket(addr, iface);
+    _nib_onl_entry_t *unspec = _onl_match_bucket(&ipv6_addr_unspecified,
+                                                 iface);
+
+    if ((node == NULL) || ((unspec != NULL) && (unspec < node))) {
+        node = unspec;
+    }
+#if ENABLE_DEBUG
+    if (node != NULL) {
+        DEBUG("  %p is an exact match\n", (void *)node);
+    }
+#endif  /* ENABLE_DEBUG */
+    return node;
+}
+
+static _nib_offl_entry_t *_offl_bucket_first(const ipv6_addr_t *pfx,
+                                             unsigned pfx_len)
+{
+    ipv6_addr_t key = IPV6_ADDR_UNSPECIFIED;
+
+    ipv6_addr_init_prefix(&key, pfx, pfx_len);
+    return _offl_buckets[_hash(&key, pfx_len, GNRC_IPV6_NIB_OFFL_BUCKETS)];
+}
+
+static _nib_offl_entry_t **_offl_bucket(const _nib_offl_entry_t *dst)
+{
+    /* prefix is stored masked */
+    return &_offl_buckets[_hash(&dst->pfx, dst->pfx_len,
+                                GNRC_IPV6_NIB_OFFL_BUCKETS)];
+}
+
+static void _offl_index(_nib_offl_entry_t *dst)
+{
+    _nib_offl_entry_t **ptr = _offl_bucket(dst);
+
+    while ((*ptr != NULL) && (*ptr < dst)) {
+        ptr = &(*ptr)->hash_next;
+    }
+    dst->hash_next = *ptr;
+    *ptr = dst;
+    bf_set(_offl_lens, dst->pfx_len);
+}
+
+static void _offl_unindex(_nib_offl_entry_t *dst)
+{
+    for (_nib_offl_entry_t **ptr = _offl_bucket(dst); *ptr != NULL;
+         ptr = &(*ptr)->hash_next) {
+        if (*ptr == dst) {
+            *ptr = dst->hash_next;
+            dst->hash_next = NULL;
+            break;
+        }
+    }
+    for (_nib_offl_entry_t *ptr = _dsts; _in_dsts(ptr); ptr++) {
+        if ((ptr != dst) && (ptr->next_hop != NULL) &&
+            (ptr->pfx_len == dst->pfx_len)) {
+            return;
+        }
+    }
+    bf_unset(_offl_lens, dst->pfx_len);
 }
 
 static inline bool _node_unreachable(_nib_onl_entry_t *node)
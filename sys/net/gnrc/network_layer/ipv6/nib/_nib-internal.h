@@ -91,6 +91,7 @@ extern "C" {
  */
 typedef struct _nib_onl_entry {
     struct _nib_onl_entry *next;        /**< next removable entry */
+    struct _nib_onl_entry *hash_next;   /**< next entry in the same hash bucket */
 #if GNRC_IPV6_NIB_CONF_QUEUE_PKT || defined(DOXYGEN)
     /**
      * @brief   queue for packets currently in address resolution
@@ -194,8 +195,9 @@ typedef struct {
 /**
  * @brief   Off-link NIB entry
  */
-typedef struct {
+typedef struct _nib_offl_entry {
     _nib_onl_entry_t *next_hop; /**< next hop to destination */
+    struct _nib_offl_entry *hash_next;  /**< next entry in the same hash bucket */
     ipv6_addr_t pfx;            /**< prefix to the destination */
     /**
      * @brief   Event for @ref GNRC_IPV6_NIB_PFX_TIMEOUT
@@ -304,6 +306,13 @@ static inline void _nib_onl_set_if(_nib_onl_entry_t *node, unsigned iface)
  */
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 
+/**
+ * @brief   Removes an on-link entry from the address index
+ *
+ * @param[in,out] node  An entry. Nothing happens if it is not indexed.
+ */
+void _nib_onl_unindex(_nib_onl_entry_t *node);
+
 /**
  * @brief   Clears out a NIB entry (on-link version)
  *
@@ -315,6 +324,7 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 static inline bool _nib_onl_clear(_nib_onl_entry_t *node)
 {
     if (node->mode == _EMPTY) {
+        _nib_onl_unindex(node);
         memset(node, 0, sizeof(_nib_onl_entry_t));
         return true;
     }
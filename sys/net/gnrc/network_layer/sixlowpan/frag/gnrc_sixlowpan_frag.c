@@ -32,7 +32,7 @@
 #include "debug.h"
 
 static gnrc_sixlowpan_msg_frag_t _fragment_msg = {
-        NULL, 0, 0, KERNEL_PID_UNDEF
+        NULL, 0, 0, KERNEL_PID_UNDEF, 0
     };
 
 #if ENABLE_DEBUG
@@ -87,7 +87,8 @@ static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
 }
 
 static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
-                                   size_t payload_len, size_t datagram_size)
+                                   size_t payload_len, size_t datagram_size,
+                                   uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     uint16_t local_offset = 0;
@@ -115,7 +116,7 @@ static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
 
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
 
     /* Tell the link layer that we will send more fragments */
     gnrc_netif_hdr_t *netif_hdr = frag->data;
@@ -138,14 +139,14 @@ static uint16_t _send_1st_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
 
     DEBUG("6lo frag: send first fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, local_offset);
+          (unsigned int)datagram_size, tag, local_offset);
     gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
     return local_offset;
 }
 
 static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
                                    size_t payload_len, size_t datagram_size,
-                                   uint16_t offset)
+                                   uint16_t offset, uint16_t tag)
 {
     gnrc_pktsnip_t *frag;
     /* since dispatches aren't supposed to go into subsequent fragments, we need not account
@@ -171,7 +172,7 @@ static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
     /* XXX: truncation of datagram_size > 4095 may happen here */
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
     hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
-    hdr->tag = byteorder_htons(_tag);
+    hdr->tag = byteorder_htons(tag);
     /* don't mention payload diff in offset */
     hdr->offset = (uint8_t)((offset + (datagram_size - payload_len)) >> 3);
     pkt = pkt->next;    /* don't copy netif header */
@@ -223,12 +224,17 @@ static uint16_t _send_nth_fragment(gnrc_netif_t *iface, gnrc_pktsnip_t *pkt,
     DEBUG("6lo frag: send subsequent fragment (datagram size: %u, "
           "datagram tag: %" PRIu16 ", offset: %" PRIu8 " (%u bytes), "
           "fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, hdr->offset, hdr->offset << 3,
+          (unsigned int)datagram_size, tag, hdr->offset, hdr->offset << 3,
           local_offset);
     gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
     return local_offset;
 }
 
+uint16_t gnrc_sixlowpan_frag_next_tag(void)
+{
+    return _tag++;
+}
+
 gnrc_sixlowpan_msg_frag_t *gnrc_sixlowpan_msg_frag_get(void)
 {
     return (_fragment_msg.pkt == NULL) ? &_fragment_msg : NULL;
@@ -261,10 +267,11 @@ void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
 
     /* Check whether to send the first or an Nth fragment */
     if (fragment_msg->offset == 0) {
-        /* increment tag for successive, fragmented datagrams */
-        _tag++;
+        /* new tag for successive, fragmented datagrams */
+        fragment_msg->tag = gnrc_sixlowpan_frag_next_tag();
         if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len,
-                                      fragment_msg->datagram_size)) == 0) {
+                                      fragment_msg->datagram_size,
+                                      fragment_msg->tag)) == 0) {
             /* error sending first fragment */
             DEBUG("6lo frag: error sending 1st fragment\n");
             goto error;
@@ -274,7 +281,8 @@ void gnrc_sixlowpan_frag_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     else if (fragment_msg->offset < payload_len) {
         if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len,
                                       fragment_msg->datagram_size,
-                                      fragment_msg->offset)) == 0) {
+                                      fragment_msg->offset,
+                                      fragment_msg->tag)) == 0) {
             /* error sending subsequent fragment */
             DEBUG("6lo frag: error sending subsequent fragment"
                   "(offset = %u)\n", fragment_msg->offset);
@@ -21,6 +21,12 @@
 #include "net/gnrc.h"
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif
 #include "net/sixlowpan.h"
 #include "thread.h"
 #include "xtimer.h"
@@ -64,6 +70,11 @@ static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag, unsigned page);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+/* forwards the first fragment in entry instead of reassembling */
+static bool _rbuf_forward(rbuf_t *entry, kernel_pid_t if_pid,
+                          gnrc_sixlowpan_frag_vrb_t *vrb);
+#endif
 /* internal add to repeat add when fragments overlapped */
 static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                      size_t offset, unsigned page);
@@ -91,6 +102,12 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     rbuf_int_t *ptr;
     uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
     size_t frag_size;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_t *vrb;
+    bool first;
+    /* netif_hdr is part of pkt, so it is gone when pkt is released */
+    kernel_pid_t if_pid = netif_hdr->if_pid;
+#endif
 
     /* check if provided offset is the same as in fragment */
     assert(((((frag->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) ==
@@ -98,6 +115,24 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
            ((((frag->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) ==
                 SIXLOWPAN_FRAG_N_DISP)) && (offset == (frag->offset * 8U))));
     rbuf_gc();
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    vrb = gnrc_sixlowpan_frag_vrb_get(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                      netif_hdr->src_l2addr_len,
+                                      byteorder_ntohs(frag->disp_size) &
+                                      SIXLOWPAN_FRAG_SIZE_MASK,
+                                      byteorder_ntohs(frag->tag));
+    if (vrb != NULL) {
+        if (offset != 0) {
+            gnrc_sixlowpan_frag_vrb_forward(vrb, pkt);
+            return RBUF_ADD_SUCCESS;
+        }
+        if (vrb->first_sent) {
+            DEBUG("6lo rbuf: first fragment already forwarded\n");
+            gnrc_pktbuf_release(pkt);
+            return RBUF_ADD_SUCCESS;
+        }
+    }
+#endif
     entry = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
                       gnrc_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len,
                       byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK,
@@ -110,6 +145,9 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     }
 
     ptr = entry->ints;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    first = (ptr == NULL);
+#endif
 
     /* dispatches in the first fragment are ignored */
     if (offset == 0) {
@@ -169,6 +207,12 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                     return RBUF_ADD_ERROR;
                 }
                 gnrc_sixlowpan_iphc_recv(pkt, &entry->super, 0);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+                /* entry is empty if the datagram was complete or invalid */
+                if (first && !rbuf_entry_empty(entry)) {
+                    _rbuf_forward(entry, if_pid, vrb);
+                }
+#endif
                 return RBUF_ADD_SUCCESS;
             }
             else
@@ -179,6 +223,14 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         }
         memcpy(((uint8_t *)entry->super.pkt->data) + offset, data,
                frag_size);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+        if (first && (offset == 0) &&
+            (entry->super.current_size < entry->super.pkt->size) &&
+            _rbuf_forward(entry, if_pid, vrb)) {
+            gnrc_pktbuf_release(pkt);
+            return RBUF_ADD_SUCCESS;
+        }
+#endif
     }
     gnrc_sixlowpan_frag_rbuf_dispatch_when_complete(&entry->super, netif_hdr);
     gnrc_pktbuf_release(pkt);
@@ -251,6 +303,13 @@ void rbuf_gc(void)
     uint32_t now_usec = xtimer_now_usec();
     unsigned int i;
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    gnrc_sixlowpan_frag_sfr_gc();
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_gc();
+#endif
+
     for (i = 0; i < RBUF_SIZE; i++) {
         /* since pkt occupies pktbuf, aggressivly collect garbage */
         if ((rbuf[i].super.pkt != NULL) &&
@@ -271,6 +330,32 @@ void rbuf_gc(void)
     }
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+static bool _rbuf_forward(rbuf_t *entry, kernel_pid_t if_pid,
+                          gnrc_sixlowpan_frag_vrb_t *vrb)
+{
+    if ((entry->super.current_size < sizeof(ipv6_hdr_t)) ||
+        !ipv6_hdr_is(entry->super.pkt->data)) {
+        /* no complete IPv6 header to route by */
+        return false;
+    }
+    if (vrb == NULL) {
+        vrb = gnrc_sixlowpan_frag_vrb_from_route(&entry->super, if_pid);
+    }
+    if (vrb == NULL) {
+        return false;
+    }
+    if (gnrc_sixlowpan_frag_vrb_forward_first(vrb, &entry->super) < 0) {
+        DEBUG("6lo rbuf: unable to forward first fragment, reassembling\n");
+        gnrc_sixlowpan_frag_vrb_rm(vrb);
+        return false;
+    }
+    gnrc_pktbuf_release(entry->super.pkt);
+    rbuf_rm(entry);
+    return true;
+}
+#endif
+
 static inline void _set_rbuf_timeout(void)
 {
     xtimer_set_msg(&_gc_timer, RBUF_TIMEOUT, &_gc_timer_msg, sched_active_pid);
@@ -0,0 +1,602 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#include "net/ieee802154.h"
+#include "net/sixlowpan.h"
+#include "net/sixlowpan/sfr.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if GNRC_SIXLOWPAN_FRAG_SFR_WIN_SIZE > 32
+#error "GNRC_SIXLOWPAN_FRAG_SFR_WIN_SIZE must not be greater than 32"
+#endif
+
+/* maximum number of fragments, limited by the acknowledgment bitmap */
+#define SFR_FRAGS_MAX   (32U)
+
+/* datagram sizes are carried in 11 bits by RFC 4944 fragments */
+#define SFR_DATAGRAM_SIZE_MAX   (0x07ffU)
+
+/**
+ * @brief   Send state of a datagram
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;        /**< the datagram, NULL if the slot is free */
+    xtimer_t timer;             /**< pacing and acknowledgment timer */
+    msg_t msg;                  /**< message sent by timer */
+    kernel_pid_t pid;           /**< 6LoWPAN thread */
+    uint32_t sent;              /**< fragments sent at least once */
+    uint32_t acked;             /**< fragments acknowledged */
+    uint32_t resend;            /**< fragments to send again */
+    uint16_t datagram_size;     /**< size of the uncompressed datagram */
+    uint16_t payload_len;       /**< size of the compressed datagram */
+    uint16_t first_size;        /**< payload size of the first fragment */
+    uint16_t nth_size;          /**< payload size of subsequent fragments */
+    uint8_t tag;                /**< datagram tag */
+    uint8_t frags;              /**< number of fragments */
+    uint8_t next;               /**< next fragment not sent yet */
+    uint8_t win_sent;           /**< fragments sent since the last
+                                 *   acknowledgment request */
+    uint8_t retries;            /**< acknowledgment requests repeated */
+    uint8_t last_req;           /**< fragment that requested the pending
+                                 *   acknowledgment */
+    bool wait_ack;              /**< an acknowledgment is pending */
+} _sfr_tx_t;
+
+/**
+ * @brief   Reception state of a datagram
+ */
+typedef struct {
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];   /**< source address */
+    uint8_t src_len;            /**< length of src, 0 if the entry is empty */
+    uint8_t tag;                /**< datagram tag */
+    int8_t last;                /**< sequence number of the last fragment,
+                                 *   -1 while unknown */
+    bool complete;              /**< all fragments were received */
+    uint16_t datagram_size;     /**< size of the uncompressed datagram */
+    uint32_t received;          /**< fragments received */
+    uint32_t arrival;           /**< time in microseconds of the last
+                                 *   fragment */
+} _sfr_rx_t;
+
+static _sfr_tx_t _tx[GNRC_SIXLOWPAN_FRAG_SFR_TX_NUMOF];
+static _sfr_rx_t _rx[GNRC_SIXLOWPAN_FRAG_SFR_RX_NUMOF];
+
+static inline uint32_t _bit(unsigned seq)
+{
+    return (1UL << (31U - seq));
+}
+
+/* bits of the sequence numbers 0 to seq (including) */
+static inline uint32_t _bits_upto(unsigned seq)
+{
+    return (seq >= 31U) ? SIXLOWPAN_SFR_ACK_BITMAP_FULL :
+                          ~(SIXLOWPAN_SFR_ACK_BITMAP_FULL >> (seq + 1U));
+}
+
+static inline size_t _min(size_t a, size_t b)
+{
+    return (a < b) ? a : b;
+}
+
+static void _tx_release(_sfr_tx_t *tx)
+{
+    xtimer_remove(&tx->timer);
+    gnrc_pktbuf_release(tx->pkt);
+    tx->pkt = NULL;
+}
+
+static void _tx_schedule(_sfr_tx_t *tx, uint16_t type, uint32_t offset)
+{
+    xtimer_remove(&tx->timer);
+    tx->msg.type = type;
+    tx->msg.content.ptr = tx;
+    if (offset == 0) {
+        if (msg_send_to_self(&tx->msg) == 0) {
+            DEBUG("6lo sfr: message queue full, dropping datagram\n");
+            _tx_release(tx);
+        }
+        return;
+    }
+    xtimer_set_msg(&tx->timer, offset, &tx->msg, tx->pid);
+}
+
+static void _copy_payload(const gnrc_pktsnip_t *pkt, size_t offset,
+                          uint8_t *dst, size_t len)
+{
+    for (; (pkt != NULL) && (len > 0); pkt = pkt->next) {
+        if (offset >= pkt->size) {
+            offset -= pkt->size;
+            continue;
+        }
+        size_t clen = _min(pkt->size - offset, len);
+
+        memcpy(dst, ((uint8_t *)pkt->data) + offset, clen);
+        dst += clen;
+        len -= clen;
+        offset = 0;
+    }
+}
+
+static int _send_frag(_sfr_tx_t *tx, unsigned seq, bool ack_req)
+{
+    gnrc_netif_hdr_t *hdr = tx->pkt->data, *new_hdr;
+    gnrc_pktsnip_t *netif, *frag;
+    sixlowpan_sfr_rfrag_t *rfrag;
+    size_t offset, size;
+
+    if (seq == 0) {
+        offset = 0;
+        size = tx->first_size;
+    }
+    else {
+        offset = tx->first_size + ((seq - 1) * tx->nth_size);
+        size = _min(tx->nth_size, tx->payload_len - offset);
+    }
+    netif = gnrc_netif_hdr_build(gnrc_netif_hdr_get_src_addr(hdr),
+                                 hdr->src_l2addr_len,
+                                 gnrc_netif_hdr_get_dst_addr(hdr),
+                                 hdr->dst_l2addr_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating link-layer header\n");
+        return -ENOMEM;
+    }
+    new_hdr = netif->data;
+    new_hdr->if_pid = hdr->if_pid;
+    new_hdr->flags = hdr->flags;
+    if (!ack_req) {
+        /* Tell the link layer that we will send more fragments */
+        new_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+    frag = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_rfrag_t) + size,
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo sfr: error allocating fragment\n");
+        gnrc_pktbuf_release(netif);
+        return -ENOMEM;
+    }
+    rfrag = frag->data;
+    sixlowpan_sfr_rfrag_set(rfrag, tx->tag, ack_req, seq, size);
+    /* offsets refer to the uncompressed datagram */
+    rfrag->offset = byteorder_htons((seq == 0) ? tx->datagram_size :
+                                    offset + (tx->datagram_size -
+                                              tx->payload_len));
+    _copy_payload(tx->pkt->next, offset, (uint8_t *)(rfrag + 1), size);
+    LL_PREPEND(frag, netif);
+    DEBUG("6lo sfr: send fragment %u of datagram %u (size: %u, ack: %u)\n",
+          seq, tx->tag, (unsigned)size, ack_req);
+    gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
+    return 0;
+}
+
+int gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt, gnrc_netif_t *netif,
+                                 size_t datagram_size)
+{
+    _sfr_tx_t *tx = NULL;
+    size_t payload_len;
+    int diff;
+
+    assert((pkt != NULL) && (netif != NULL));
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_SFR_TX_NUMOF; i++) {
+        if (_tx[i].pkt == NULL) {
+            tx = &_tx[i];
+            break;
+        }
+    }
+    if (tx == NULL) {
+        DEBUG("6lo sfr: no free send slot\n");
+        return -ENOBUFS;
+    }
+    payload_len = gnrc_pkt_len(pkt->next);
+    diff = datagram_size - payload_len;
+    /* virtually add diff to flooring to account for offsets (must be
+     * divisible by 8) in the uncompressed datagram */
+    tx->first_size = (((int)netif->sixlo.max_frag_size + diff -
+                       (int)sizeof(sixlowpan_sfr_rfrag_t)) & ~0x7) - diff;
+    tx->nth_size = (netif->sixlo.max_frag_size -
+                    sizeof(sixlowpan_sfr_rfrag_t)) & ~0x7U;
+    if ((datagram_size > SFR_DATAGRAM_SIZE_MAX) ||
+        (netif->sixlo.max_frag_size <= sizeof(sixlowpan_sfr_rfrag_t)) ||
+        (tx->nth_size == 0) || (tx->first_size == 0) ||
+        (tx->first_size >= payload_len) ||
+        ((payload_len - tx->first_size) >
+         ((SFR_FRAGS_MAX - 1) * tx->nth_size))) {
+        DEBUG("6lo sfr: datagram does not fit %u fragments\n", SFR_FRAGS_MAX);
+        return -EMSGSIZE;
+    }
+    tx->frags = 1 + ((payload_len - tx->first_size + tx->nth_size - 1) /
+                     tx->nth_size);
+    tx->pkt = pkt;
+    tx->pid = thread_getpid();
+    tx->datagram_size = datagram_size;
+    tx->payload_len = payload_len;
+    tx->tag = (uint8_t)gnrc_sixlowpan_frag_next_tag();
+    tx->sent = 0;
+    tx->acked = 0;
+    tx->resend = 0;
+    tx->next = 0;
+    tx->win_sent = 0;
+    tx->retries = 0;
+    tx->wait_ack = false;
+    DEBUG("6lo sfr: send datagram %u in %u fragments\n", tx->tag, tx->frags);
+    gnrc_sixlowpan_frag_sfr_send_next(tx);
+    return 0;
+}
+
+void gnrc_sixlowpan_frag_sfr_send_next(void *ctx)
+{
+    _sfr_tx_t *tx = ctx;
+    unsigned seq;
+    bool ack_req;
+
+    assert(tx != NULL);
+    if ((tx->pkt == NULL) || tx->wait_ack) {
+        /* datagram done or stale event */
+        return;
+    }
+    if (tx->resend != 0) {
+        for (seq = 0; !(tx->resend & _bit(seq)); seq++) {}
+    }
+    else if (tx->next < tx->frags) {
+        seq = tx->next++;
+    }
+    else {
+        /* all fragments were sent, solicit an acknowledgment again */
+        seq = tx->last_req;
+    }
+    tx->resend &= ~_bit(seq);
+    ack_req = (++tx->win_sent >= GNRC_SIXLOWPAN_FRAG_SFR_WIN_SIZE) ||
+              ((tx->resend == 0) && (tx->next >= tx->frags));
+    if (_send_frag(tx, seq, ack_req) < 0) {
+        _tx_release(tx);
+        return;
+    }
+    tx->sent |= _bit(seq);
+    if (ack_req) {
+        tx->wait_ack = true;
+        tx->win_sent = 0;
+        tx->last_req = seq;
+        _tx_schedule(tx, GNRC_SIXLOWPAN_FRAG_SFR_MSG_ARQ_TIMEOUT,
+                     GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT);
+    }
+    else {
+        _tx_schedule(tx, GNRC_SIXLOWPAN_FRAG_SFR_MSG_SND,
+                     GNRC_SIXLOWPAN_FRAG_SFR_INTER_FRAME_GAP);
+    }
+}
+
+void gnrc_sixlowpan_frag_sfr_arq_timeout(void *ctx)
+{
+    _sfr_tx_t *tx = ctx;
+
+    assert(tx != NULL);
+    if ((tx->pkt == NULL) || !tx->wait_ack) {
+        return;
+    }
+    if (++tx->retries > GNRC_SIXLOWPAN_FRAG_SFR_RETRIES) {
+        DEBUG("6lo sfr: no acknowledgment for datagram %u, dropping it\n",
+              tx->tag);
+        _tx_release(tx);
+        return;
+    }
+    DEBUG("6lo sfr: acknowledgment for datagram %u timed out, request it "
+          "again\n", tx->tag);
+    if (tx->acked == 0) {
+        /* the receiver only keeps state once the first fragment arrived */
+        tx->last_req = 0;
+    }
+    if (_send_frag(tx, tx->last_req, true) < 0) {
+        _tx_release(tx);
+        return;
+    }
+    _tx_schedule(tx, GNRC_SIXLOWPAN_FRAG_SFR_MSG_ARQ_TIMEOUT,
+                 GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT);
+}
+
+static _sfr_tx_t *_tx_get(const gnrc_netif_hdr_t *netif_hdr, uint8_t tag)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_SFR_TX_NUMOF; i++) {
+        _sfr_tx_t *tx = &_tx[i];
+        gnrc_netif_hdr_t *hdr;
+
+        if ((tx->pkt == NULL) || (tx->tag != tag)) {
+            continue;
+        }
+        hdr = tx->pkt->data;
+        if ((hdr->dst_l2addr_len == netif_hdr->src_l2addr_len) &&
+            (memcmp(gnrc_netif_hdr_get_dst_addr(hdr),
+                    gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    hdr->dst_l2addr_len) == 0)) {
+            return tx;
+        }
+    }
+    return NULL;
+}
+
+void gnrc_sixlowpan_frag_sfr_recv_ack(gnrc_pktsnip_t *pkt, void *ctx,
+                                      unsigned page)
+{
+    sixlowpan_sfr_ack_t *ack = pkt->data;
+    _sfr_tx_t *tx;
+    uint32_t bitmap;
+
+    (void)ctx;
+    (void)page;
+    if (pkt->size < sizeof(sixlowpan_sfr_ack_t)) {
+        DEBUG("6lo sfr: acknowledgment too short\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    tx = _tx_get(pkt->next->data, ack->tag);
+    bitmap = byteorder_ntohl(ack->bitmap);
+    gnrc_pktbuf_release(pkt);
+    if (tx == NULL) {
+        DEBUG("6lo sfr: acknowledgment for unknown datagram\n");
+        return;
+    }
+    if (bitmap == SIXLOWPAN_SFR_ACK_BITMAP_NULL) {
+        DEBUG("6lo sfr: datagram %u aborted by receiver\n", tx->tag);
+        _tx_release(tx);
+        return;
+    }
+    tx->acked |= bitmap;
+    if ((bitmap == SIXLOWPAN_SFR_ACK_BITMAP_FULL) ||
+        ((tx->acked & _bits_upto(tx->frags - 1)) ==
+         _bits_upto(tx->frags - 1))) {
+        DEBUG("6lo sfr: datagram %u acknowledged\n", tx->tag);
+        _tx_release(tx);
+        return;
+    }
+    tx->resend = tx->sent & ~tx->acked;
+    if (tx->wait_ack) {
+        tx->wait_ack = false;
+        tx->retries = 0;
+        tx->win_sent = 0;
+        _tx_schedule(tx, GNRC_SIXLOWPAN_FRAG_SFR_MSG_SND, 0);
+    }
+    /* otherwise the pacing timer picks up the fragments to send again */
+}
+
+static _sfr_rx_t *_rx_get(const uint8_t *src, size_t src_len, uint8_t tag)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_SFR_RX_NUMOF; i++) {
+        _sfr_rx_t *rx = &_rx[i];
+
+        if ((rx->src_len == src_len) && (rx->tag == tag) &&
+            (memcmp(rx->src, src, src_len) == 0)) {
+            return rx;
+        }
+    }
+    return NULL;
+}
+
+static _sfr_rx_t *_rx_add(const uint8_t *src, size_t src_len, uint8_t tag,
+                          uint16_t datagram_size)
+{
+    _sfr_rx_t *res = NULL, *oldest = NULL;
+
+    if ((src_len == 0) || (src_len > sizeof(res->src))) {
+        return NULL;
+    }
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_SFR_RX_NUMOF; i++) {
+        _sfr_rx_t *rx = &_rx[i];
+
+        if (rx->src_len == 0) {
+            res = rx;
+            break;
+        }
+        if ((oldest == NULL) ||
+            ((int32_t)(rx->arrival - oldest->arrival) < 0)) {
+            oldest = rx;
+        }
+    }
+    if (res == NULL) {
+        DEBUG("6lo sfr: reception states full, replacing oldest\n");
+        res = oldest;
+    }
+    memcpy(res->src, src, src_len);
+    res->src_len = src_len;
+    res->tag = tag;
+    res->last = -1;
+    res->complete = false;
+    res->datagram_size = datagram_size;
+    res->received = 0;
+    return res;
+}
+
+static void _send_ack(kernel_pid_t if_pid, uint8_t *dst, size_t dst_len,
+                      uint8_t tag, uint32_t bitmap)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+    sixlowpan_sfr_ack_t *ack;
+
+    netif = gnrc_netif_hdr_build(NULL, 0, dst, dst_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating link-layer header\n");
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = if_pid;
+    pkt = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_ack_t),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        DEBUG("6lo sfr: error allocating acknowledgment\n");
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    ack = pkt->data;
+    ack->disp_ecn = SIXLOWPAN_SFR_ACK_DISP;
+    ack->tag = tag;
+    ack->bitmap = byteorder_htonl(bitmap);
+    LL_PREPEND(pkt, netif);
+    DEBUG("6lo sfr: acknowledge datagram %u with %08lx\n", tag,
+          (unsigned long)bitmap);
+    gnrc_sixlowpan_dispatch_send(pkt, NULL, 0);
+}
+
+/* replaces the RFRAG header by an RFC 4944 fragment header of the same
+ * datagram, so the reassembly buffer can take the fragment */
+static int _to_frag(gnrc_pktsnip_t *pkt, const _sfr_rx_t *rx, uint16_t offset)
+{
+    size_t frag_hdr_size = (offset == 0) ? sizeof(sixlowpan_frag_t) :
+                                           sizeof(sixlowpan_frag_n_t);
+    gnrc_pktsnip_t *sfr;
+    sixlowpan_frag_t *frag;
+
+    sfr = gnrc_pktbuf_mark(pkt, sizeof(sixlowpan_sfr_rfrag_t) - frag_hdr_size,
+                           GNRC_NETTYPE_UNDEF);
+    if (sfr == NULL) {
+        return -ENOMEM;
+    }
+    gnrc_pktbuf_remove_snip(pkt, sfr);
+    frag = pkt->data;
+    frag->disp_size = byteorder_htons(rx->datagram_size);
+    frag->tag = byteorder_htons(rx->tag);
+    if (offset == 0) {
+        frag->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    }
+    else {
+        frag->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        ((sixlowpan_frag_n_t *)frag)->offset = offset >> 3;
+    }
+    return 0;
+}
+
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->next->data;
+    sixlowpan_sfr_rfrag_t *rfrag = pkt->data;
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];
+    size_t src_len = netif_hdr->src_l2addr_len;
+    kernel_pid_t if_pid = netif_hdr->if_pid;
+    _sfr_rx_t *rx;
+    uint16_t offset, size;
+    uint8_t seq, tag;
+    bool ack_req;
+
+    (void)ctx;
+    if ((pkt->size <= sizeof(sixlowpan_sfr_rfrag_t)) ||
+        (src_len == 0) || (src_len > sizeof(src))) {
+        DEBUG("6lo sfr: invalid fragment\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    memcpy(src, gnrc_netif_hdr_get_src_addr(netif_hdr), src_len);
+    seq = sixlowpan_sfr_rfrag_seq(rfrag);
+    tag = rfrag->tag;
+    ack_req = sixlowpan_sfr_rfrag_ack_req(rfrag);
+    size = _min(sixlowpan_sfr_rfrag_size(rfrag),
+                pkt->size - sizeof(sixlowpan_sfr_rfrag_t));
+    rx = _rx_get(src, src_len, tag);
+    if (seq == 0) {
+        uint16_t datagram_size = byteorder_ntohs(rfrag->offset);
+
+        if (datagram_size > SFR_DATAGRAM_SIZE_MAX) {
+            DEBUG("6lo sfr: datagram too large\n");
+            gnrc_pktbuf_release(pkt);
+            _send_ack(if_pid, src, src_len, tag,
+                      SIXLOWPAN_SFR_ACK_BITMAP_NULL);
+            return;
+        }
+        if (rx == NULL) {
+            rx = _rx_add(src, src_len, tag, datagram_size);
+        }
+        offset = 0;
+    }
+    else if (rx != NULL) {
+        offset = byteorder_ntohs(rfrag->offset);
+        if ((offset & 0x7U) || (offset >= rx->datagram_size)) {
+            DEBUG("6lo sfr: invalid fragment offset %u\n", offset);
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        if ((offset + size) >= rx->datagram_size) {
+            rx->last = seq;
+        }
+    }
+    if (rx == NULL) {
+        /* the first fragment was not received yet; without acknowledgment
+         * this fragment is sent again */
+        DEBUG("6lo sfr: no reception state for fragment %u\n", seq);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    rx->arrival = xtimer_now_usec();
+    if (rx->complete || (rx->received & _bit(seq))) {
+        DEBUG("6lo sfr: duplicate fragment %u of datagram %u\n", seq, tag);
+        gnrc_pktbuf_release(pkt);
+    }
+    else if (_to_frag(pkt, rx, offset) < 0) {
+        DEBUG("6lo sfr: unable to translate fragment\n");
+        gnrc_pktbuf_release(pkt);
+    }
+    else {
+        rx->received |= _bit(seq);
+        /* netif_hdr may be gone after this */
+        gnrc_sixlowpan_frag_recv(pkt, NULL, page);
+    }
+    if (!rx->complete && (rx->last >= 0) &&
+        ((rx->received & _bits_upto(rx->last)) == _bits_upto(rx->last))) {
+        rx->complete = true;
+        _send_ack(if_pid, src, src_len, tag, SIXLOWPAN_SFR_ACK_BITMAP_FULL);
+    }
+    else if (ack_req) {
+        _send_ack(if_pid, src, src_len, tag,
+                  rx->complete ? SIXLOWPAN_SFR_ACK_BITMAP_FULL : rx->received);
+    }
+}
+
+void gnrc_sixlowpan_frag_sfr_gc(void)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_SFR_RX_NUMOF; i++) {
+        _sfr_rx_t *rx = &_rx[i];
+
+        if ((rx->src_len != 0) &&
+            ((now_usec - rx->arrival) > GNRC_SIXLOWPAN_FRAG_SFR_RX_TIMEOUT)) {
+            DEBUG("6lo sfr: reception state of datagram %u timed out\n",
+                  rx->tag);
+            rx->src_len = 0;
+        }
+    }
+}
+
+#ifdef TEST_SUITES
+void gnrc_sixlowpan_frag_sfr_reset(void)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_SFR_TX_NUMOF; i++) {
+        if (_tx[i].pkt != NULL) {
+            _tx_release(&_tx[i]);
+        }
+    }
+    memset(_rx, 0, sizeof(_rx));
+}
+#endif
+
+/** @} */
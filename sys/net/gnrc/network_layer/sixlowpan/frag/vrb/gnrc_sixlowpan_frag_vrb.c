@@ -0,0 +1,333 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#include "net/ipv6/hdr.h"
+#include "net/sixlowpan.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#ifdef MODULE_GNRC_IPV6_NIB
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/internal.h"
+#endif
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+#include "net/gnrc/sixlowpan/iphc.h"
+#endif
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static gnrc_sixlowpan_frag_vrb_t _vrb[GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+
+static inline bool _empty(const gnrc_sixlowpan_frag_vrb_t *vrb)
+{
+    return (vrb->out_dst_len == 0);
+}
+
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(const uint8_t *src,
+                                                       size_t src_len,
+                                                       uint16_t tag,
+                                                       uint16_t datagram_size,
+                                                       gnrc_netif_t *out_netif,
+                                                       const uint8_t *out_dst,
+                                                       size_t out_dst_len)
+{
+    gnrc_sixlowpan_frag_vrb_t *res = NULL, *oldest = NULL;
+
+    assert((src != NULL) && (out_netif != NULL) && (out_dst != NULL));
+    assert(out_dst_len > 0);
+    if ((src_len > sizeof(res->src)) || (out_dst_len > sizeof(res->out_dst))) {
+        return NULL;
+    }
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        gnrc_sixlowpan_frag_vrb_t *vrb = &_vrb[i];
+
+        if (_empty(vrb)) {
+            res = vrb;
+            break;
+        }
+        if ((oldest == NULL) ||
+            ((int32_t)(vrb->arrival - oldest->arrival) < 0)) {
+            oldest = vrb;
+        }
+    }
+    if (res == NULL) {
+        DEBUG("6lo vrb: buffer full, replacing oldest entry\n");
+        res = oldest;
+    }
+    memcpy(res->src, src, src_len);
+    memcpy(res->out_dst, out_dst, out_dst_len);
+    res->src_len = src_len;
+    res->out_dst_len = out_dst_len;
+    res->tag = tag;
+    res->out_tag = gnrc_sixlowpan_frag_next_tag();
+    res->datagram_size = datagram_size;
+    res->forwarded = 0;
+    memset(res->offsets, 0, sizeof(res->offsets));
+    res->out_netif = out_netif;
+    res->arrival = xtimer_now_usec();
+    res->first_sent = false;
+    DEBUG("6lo vrb: tag %u -> %u over interface %u\n", tag, res->out_tag,
+          (unsigned)out_netif->pid);
+    return res;
+}
+
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(const uint8_t *src,
+                                                       size_t src_len,
+                                                       uint16_t datagram_size,
+                                                       uint16_t tag)
+{
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        gnrc_sixlowpan_frag_vrb_t *vrb = &_vrb[i];
+
+        if (!_empty(vrb) && (vrb->tag == tag) &&
+            (vrb->datagram_size == datagram_size) &&
+            (vrb->src_len == src_len) &&
+            (memcmp(vrb->src, src, src_len) == 0)) {
+            return vrb;
+        }
+    }
+    return NULL;
+}
+
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_from_route(const gnrc_sixlowpan_rbuf_t *rbuf,
+                                                              kernel_pid_t if_pid)
+{
+    assert((rbuf != NULL) && (rbuf->pkt != NULL));
+#ifdef MODULE_GNRC_IPV6_NIB
+    gnrc_netif_t *netif = gnrc_netif_get_by_pid(if_pid);
+    ipv6_hdr_t *hdr = rbuf->pkt->data;
+    gnrc_ipv6_nib_nc_t nce;
+
+    if ((netif == NULL) || !gnrc_netif_is_rtr(netif) ||
+        (rbuf->pkt->type != GNRC_NETTYPE_IPV6) ||
+        (rbuf->current_size < sizeof(ipv6_hdr_t)) || !ipv6_hdr_is(hdr) ||
+        (hdr->hl <= 1) || ipv6_addr_is_multicast(&hdr->dst) ||
+        ipv6_addr_is_link_local(&hdr->dst) ||
+        ipv6_addr_is_link_local(&hdr->src) ||
+        (gnrc_netif_get_by_ipv6_addr(&hdr->dst) != NULL)) {
+        return NULL;
+    }
+    if (gnrc_ipv6_nib_get_next_hop_l2addr(&hdr->dst, NULL, NULL, &nce) < 0) {
+        DEBUG("6lo vrb: no route, reassembling\n");
+        return NULL;
+    }
+    netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
+    if ((netif == NULL) || !gnrc_netif_is_6ln(netif) ||
+        (nce.l2addr_len == 0)) {
+        return NULL;
+    }
+    return gnrc_sixlowpan_frag_vrb_add(rbuf->src, rbuf->src_len, rbuf->tag,
+                                       rbuf->pkt->size, netif, nce.l2addr,
+                                       nce.l2addr_len);
+#else
+    (void)rbuf;
+    (void)if_pid;
+    return NULL;
+#endif
+}
+
+static gnrc_pktsnip_t *_netif_hdr_build(gnrc_sixlowpan_frag_vrb_t *vrb)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, vrb->out_dst,
+                                                 vrb->out_dst_len);
+
+    if (netif != NULL) {
+        gnrc_netif_hdr_t *hdr = netif->data;
+
+        hdr->if_pid = vrb->out_netif->pid;
+    }
+    return netif;
+}
+
+static inline bool _fits(const gnrc_sixlowpan_frag_vrb_t *vrb, size_t size)
+{
+    return (vrb->out_netif->sixlo.max_frag_size == 0) ||
+           (size <= vrb->out_netif->sixlo.max_frag_size);
+}
+
+/* builds netif header, IPv6 header and payload of the first fragment */
+static gnrc_pktsnip_t *_first_build(gnrc_sixlowpan_frag_vrb_t *vrb,
+                                    const gnrc_sixlowpan_rbuf_t *rbuf)
+{
+    const uint8_t *data = rbuf->pkt->data;
+    size_t payload_len = rbuf->current_size - sizeof(ipv6_hdr_t);
+    gnrc_pktsnip_t *pkt = NULL, *ipv6;
+
+    if (payload_len > 0) {
+        pkt = gnrc_pktbuf_add(NULL, data + sizeof(ipv6_hdr_t), payload_len,
+                              GNRC_NETTYPE_UNDEF);
+        if (pkt == NULL) {
+            return NULL;
+        }
+    }
+    ipv6 = gnrc_pktbuf_add(pkt, data, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    ((ipv6_hdr_t *)ipv6->data)->hl--;
+    pkt = _netif_hdr_build(vrb);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    pkt->next = ipv6;
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC
+    if (vrb->out_netif->flags & GNRC_NETIF_FLAGS_6LO_HC) {
+        return gnrc_sixlowpan_iphc_encode(pkt);
+    }
+#endif
+    ipv6 = gnrc_pktbuf_add(ipv6, NULL, 1, GNRC_NETTYPE_SIXLOWPAN);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    *((uint8_t *)ipv6->data) = SIXLOWPAN_UNCOMP;
+    pkt->next = ipv6;
+    return pkt;
+}
+
+int gnrc_sixlowpan_frag_vrb_forward_first(gnrc_sixlowpan_frag_vrb_t *vrb,
+                                          const gnrc_sixlowpan_rbuf_t *rbuf)
+{
+    gnrc_pktsnip_t *pkt, *frag;
+    sixlowpan_frag_t *hdr;
+    uint8_t *data;
+    size_t len;
+
+    assert((vrb != NULL) && (rbuf != NULL) && (rbuf->pkt != NULL));
+    assert(rbuf->current_size >= sizeof(ipv6_hdr_t));
+    if (((ipv6_hdr_t *)rbuf->pkt->data)->hl <= 1) {
+        return -EINVAL;
+    }
+    if ((pkt = _first_build(vrb, rbuf)) == NULL) {
+        return -ENOMEM;
+    }
+    len = gnrc_pkt_len(pkt->next);
+    if (!_fits(vrb, sizeof(sixlowpan_frag_t) + len)) {
+        DEBUG("6lo vrb: first fragment too big for interface %u\n",
+              (unsigned)vrb->out_netif->pid);
+        gnrc_pktbuf_release(pkt);
+        return -EMSGSIZE;
+    }
+    frag = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_frag_t) + len,
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return -ENOMEM;
+    }
+    hdr = frag->data;
+    hdr->disp_size = byteorder_htons(vrb->datagram_size);
+    hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    hdr->tag = byteorder_htons(vrb->out_tag);
+    data = (uint8_t *)(hdr + 1);
+    for (gnrc_pktsnip_t *ptr = pkt->next; ptr != NULL; ptr = ptr->next) {
+        memcpy(data, ptr->data, ptr->size);
+        data += ptr->size;
+    }
+    gnrc_pktbuf_release(pkt->next);
+    pkt->next = frag;
+    vrb->first_sent = true;
+    bf_set(vrb->offsets, 0);
+    vrb->forwarded += rbuf->current_size;
+    vrb->arrival = xtimer_now_usec();
+    DEBUG("6lo vrb: forward first fragment (tag %u -> %u)\n", vrb->tag,
+          vrb->out_tag);
+    gnrc_sixlowpan_dispatch_send(pkt, NULL, 0);
+    return 0;
+}
+
+void gnrc_sixlowpan_frag_vrb_forward(gnrc_sixlowpan_frag_vrb_t *vrb,
+                                     gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif;
+    sixlowpan_frag_n_t *hdr;
+    uint8_t offset;
+
+    assert((vrb != NULL) && (pkt != NULL));
+    offset = ((sixlowpan_frag_n_t *)pkt->data)->offset;
+    if (bf_isset(vrb->offsets, offset)) {
+        /* already relayed, counting it again would end the entry early */
+        DEBUG("6lo vrb: duplicate fragment at offset %u, dropping\n",
+              offset * 8U);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (!_fits(vrb, pkt->size)) {
+        DEBUG("6lo vrb: fragment too big for interface %u, dropping datagram\n",
+              (unsigned)vrb->out_netif->pid);
+        goto error;
+    }
+    if ((netif = _netif_hdr_build(vrb)) == NULL) {
+        goto error;
+    }
+    if ((pkt = gnrc_pktbuf_start_write(pkt)) == NULL) {
+        gnrc_pktbuf_release(netif);
+        goto error;
+    }
+    /* replace link-layer header of the previous hop */
+    gnrc_pktsnip_t *prev = pkt->next;
+    if ((prev != NULL) && (prev->type == GNRC_NETTYPE_NETIF)) {
+        pkt = gnrc_pktbuf_remove_snip(pkt, prev);
+    }
+    hdr = pkt->data;
+    hdr->tag = byteorder_htons(vrb->out_tag);
+    bf_set(vrb->offsets, offset);
+    vrb->forwarded += pkt->size - sizeof(sixlowpan_frag_n_t);
+    vrb->arrival = xtimer_now_usec();
+    DEBUG("6lo vrb: forward fragment at offset %u (tag %u -> %u)\n",
+          hdr->offset * 8U, vrb->tag, vrb->out_tag);
+    if (vrb->forwarded >= vrb->datagram_size) {
+        gnrc_sixlowpan_frag_vrb_rm(vrb);
+    }
+    LL_PREPEND(pkt, netif);
+    gnrc_sixlowpan_dispatch_send(pkt, NULL, 0);
+    return;
+
+error:
+    gnrc_pktbuf_release(pkt);
+    gnrc_sixlowpan_frag_vrb_rm(vrb);
+}
+
+void gnrc_sixlowpan_frag_vrb_gc(void)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if (!_empty(&_vrb[i]) &&
+            ((now_usec - _vrb[i].arrival) > GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT)) {
+            DEBUG("6lo vrb: entry (tag %u) timed out\n", _vrb[i].tag);
+            gnrc_sixlowpan_frag_vrb_rm(&_vrb[i]);
+        }
+    }
+}
+
+#ifdef TEST_SUITES
+void gnrc_sixlowpan_frag_vrb_reset(void)
+{
+    memset(_vrb, 0, sizeof(_vrb));
+}
+#endif
+
+/** @} */
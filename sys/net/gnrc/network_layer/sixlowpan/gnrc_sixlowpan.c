@@ -20,6 +20,10 @@
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#include "net/sixlowpan/sfr.h"
+#endif
 #include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/netif.h"
 #include "net/sixlowpan.h"
@@ -122,6 +126,14 @@ void gnrc_sixlowpan_multiplex_by_size(gnrc_pktsnip_t *pkt,
               (unsigned int)datagram_size, netif->sixlo.max_frag_size);
         gnrc_sixlowpan_msg_frag_t *fragment_msg;
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+        if ((netif->flags & GNRC_NETIF_FLAGS_6LO_SFR) &&
+            (gnrc_sixlowpan_frag_sfr_send(pkt, netif,
+                                          orig_datagram_size) == 0)) {
+            return;
+        }
+        /* otherwise fall back to RFC 4944 fragmentation */
+#endif
         fragment_msg = gnrc_sixlowpan_msg_frag_get();
         if (fragment_msg == NULL) {
             DEBUG("6lo: Not enough resources to fragment packet. "
@@ -215,6 +227,18 @@ static void _receive(gnrc_pktsnip_t *pkt)
         return;
     }
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    else if (sixlowpan_sfr_rfrag_is(dispatch[0])) {
+        DEBUG("6lo: received recoverable fragment\n");
+        gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, 0);
+        return;
+    }
+    else if (sixlowpan_sfr_ack_is(dispatch[0])) {
+        DEBUG("6lo: received RFRAG acknowledgment\n");
+        gnrc_sixlowpan_frag_sfr_recv_ack(pkt, NULL, 0);
+        return;
+    }
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
     else if (sixlowpan_iphc_is(dispatch)) {
         DEBUG("6lo: received 6LoWPAN IPHC comressed datagram\n");
@@ -350,6 +374,16 @@ static void *_event_loop(void *args)
                 gnrc_sixlowpan_frag_rbuf_gc();
                 break;
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+            case GNRC_SIXLOWPAN_FRAG_SFR_MSG_SND:
+                DEBUG("6lo: send recoverable fragment event received\n");
+                gnrc_sixlowpan_frag_sfr_send_next(msg.content.ptr);
+                break;
+            case GNRC_SIXLOWPAN_FRAG_SFR_MSG_ARQ_TIMEOUT:
+                DEBUG("6lo: RFRAG acknowledgment timeout event received\n");
+                gnrc_sixlowpan_frag_sfr_arq_timeout(msg.content.ptr);
+                break;
+#endif
 
             default:
                 DEBUG("6lo: operation not supported\n");
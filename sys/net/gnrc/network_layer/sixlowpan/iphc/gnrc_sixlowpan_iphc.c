@@ -654,7 +654,7 @@ static inline bool _compressible(gnrc_pktsnip_t *hdr)
     }
 }
 
-void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
+gnrc_pktsnip_t *gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 {
     assert(pkt != NULL);
     gnrc_netif_hdr_t *netif_hdr = pkt->data;
@@ -665,11 +665,8 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     gnrc_pktsnip_t *dispatch, *ptr = pkt->next;
     bool addr_comp = false;
     size_t dispatch_size = 0;
-    /* datagram size before compression */
-    size_t orig_datagram_size = gnrc_pkt_len(pkt->next);
     uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
 
-    (void)ctx;
     dispatch = NULL;    /* use dispatch as temporary pointer for prev */
     /* determine maximum dispatch size and write protect all headers until
      * then because they will be removed */
@@ -681,7 +678,7 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
             if (addr_comp) {    /* addr_comp was used as release indicator */
                 gnrc_pktbuf_release(pkt);
             }
-            return;
+            return NULL;
         }
         ptr = tmp;
         if (dispatch == NULL) {
@@ -715,7 +712,7 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     if (dispatch == NULL) {
         DEBUG("6lo iphc: error allocating dispatch space\n");
         gnrc_pktbuf_release(pkt);
-        return;
+        return NULL;
     }
 
     iphc_hdr = dispatch->data;
@@ -843,7 +840,7 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
                 DEBUG("6lo iphc: could not get interface's IID\n");
                 gnrc_netif_release(iface);
                 gnrc_pktbuf_release(pkt);
-                return;
+                return NULL;
             }
             gnrc_netif_release(iface);
 
@@ -962,7 +959,7 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
         if (gnrc_netif_hdr_ipv6_iid_from_dst(iface, netif_hdr, &iid) < 0) {
             DEBUG("6lo iphc: could not get destination's IID\n");
             gnrc_pktbuf_release(pkt);
-            return;
+            return NULL;
         }
 
         if ((ipv6_hdr->dst.u64[1].u64 == iid.uint64.u64) ||
@@ -1010,7 +1007,7 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
                 if (udp == NULL) {
                     DEBUG("gnrc_sixlowpan_iphc_encode: unable to mark UDP header\n");
                     gnrc_pktbuf_release(dispatch);
-                    return;
+                    return NULL;
                 }
             }
             gnrc_pktbuf_remove_snip(pkt, udp);
@@ -1032,9 +1029,21 @@ void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
     dispatch->next = pkt->next;
     pkt->next = dispatch;
 
-    gnrc_netif_t *netif = gnrc_netif_hdr_get_netif(netif_hdr);
+    return pkt;
+}
+
+void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page)
+{
+    assert(pkt != NULL);
+    gnrc_netif_t *netif = gnrc_netif_hdr_get_netif(pkt->data);
+    /* datagram size before compression */
+    size_t orig_datagram_size = gnrc_pkt_len(pkt->next);
+
+    (void)ctx;
     assert(netif != NULL);
-    gnrc_sixlowpan_multiplex_by_size(pkt, orig_datagram_size, netif, page);
+    if ((pkt = gnrc_sixlowpan_iphc_encode(pkt)) != NULL) {
+        gnrc_sixlowpan_multiplex_by_size(pkt, orig_datagram_size, netif, page);
+    }
 }
 
 /** @} */
@@ -61,7 +61,7 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
         return -EINVAL;
     }
 #ifdef MODULE_XTIMER
-    xtimer_t timeout_timer;
+    xtimer_t timeout_timer = { 0 };
 
     if ((timeout != SOCK_NO_TIMEOUT) && (timeout != 0)) {
         timeout_timer.callback = _callback_put;
@@ -113,6 +113,24 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
     return 0;
 }
 
+gnrc_pktsnip_t *gnrc_sock_payload_build(const iolist_t *snips)
+{
+    gnrc_pktsnip_t *payload = gnrc_pktbuf_add(NULL, NULL, iolist_size(snips),
+                                              GNRC_NETTYPE_UNDEF);
+
+    if (payload != NULL) {
+        uint8_t *ptr = payload->data;
+
+        for (; snips != NULL; snips = snips->iol_next) {
+            if (snips->iol_len > 0) {
+                memcpy(ptr, snips->iol_base, snips->iol_len);
+                ptr += snips->iol_len;
+            }
+        }
+    }
+    return payload;
+}
+
 ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
                        const sock_ip_ep_t *remote, uint8_t nh)
 {
@@ -25,6 +25,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
+#include "iolist.h"
 #include "mbox.h"
 #include "net/af.h"
 #include "net/gnrc.h"
@@ -66,6 +67,26 @@ extern "C" {
  */
 #define GNRC_SOCK_DYN_PORTRANGE_OFF (17U)
 
+/**
+ * @brief   Number of ports at the start of the dynamic port range that are
+ *          handed out from a bitmap
+ *
+ * Ports of this pool are allocated and released in constant time. Only when
+ * the pool is exhausted the whole dynamic port range is searched.
+ *
+ * @note    Must be a multiple of 32.
+ */
+#ifndef GNRC_SOCK_DYN_PORT_POOL_SIZE
+#define GNRC_SOCK_DYN_PORT_POOL_SIZE    (64U)
+#endif
+
+/**
+ * @brief   Internal sock flag marking a local port taken from the pool of
+ *          dynamic ports
+ * @internal
+ */
+#define GNRC_SOCK_FLAGS_DYN_PORT        (0x8000)
+
 /**
  * @brief   Internal helper functions for GNRC
  * @internal
@@ -135,6 +156,14 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt, uint32_t time
  */
 ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
                        const sock_ip_ep_t *remote, uint8_t nh);
+
+/**
+ * @brief   Copies the buffers of an I/O list into one payload snip
+ * @internal
+ *
+ * @return  The payload snip, NULL if the packet buffer is full.
+ */
+gnrc_pktsnip_t *gnrc_sock_payload_build(const iolist_t *snips);
 /**
  * @}
  */
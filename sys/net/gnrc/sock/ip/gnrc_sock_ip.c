@@ -88,12 +88,41 @@ int sock_ip_get_remote(sock_ip_t *sock, sock_ip_ep_t *remote)
 
 ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
                      uint32_t timeout, sock_ip_ep_t *remote)
+{
+    void *pkt = NULL, *ptr;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = sock_ip_recv_buf(sock, &ptr, &pkt, timeout, remote);
+    if (res <= 0) {
+        return res;
+    }
+    if ((size_t)res > max_len) {
+        res = -ENOBUFS;
+    }
+    else {
+        memcpy(data, ptr, res);
+    }
+    /* release packet */
+    sock_ip_recv_buf(sock, &ptr, &pkt, 0, NULL);
+    return res;
+}
+
+ssize_t sock_ip_recv_buf(sock_ip_t *sock, void **data, void **buf_ctx,
+                         uint32_t timeout, sock_ip_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        /* the payload is always in one snip, so just release it */
+        *data = NULL;
+        gnrc_pktbuf_release(*buf_ctx);
+        *buf_ctx = NULL;
+        return 0;
+    }
     if (sock->local.family == 0) {
         return -EADDRNOTAVAIL;
     }
@@ -102,10 +131,6 @@ ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
     if (res < 0) {
         return res;
     }
-    if (pkt->size > max_len) {
-        gnrc_pktbuf_release(pkt);
-        return -ENOBUFS;
-    }
     if (remote != NULL) {
         /* return remote to possibly block if wrong remote */
         memcpy(remote, &tmp, sizeof(tmp));
@@ -119,14 +144,27 @@ ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
-    memcpy(data, pkt->data, pkt->size);
-    res = (int)pkt->size;
-    gnrc_pktbuf_release(pkt);
-    return res;
+    if (pkt->size == 0) {
+        /* nothing to lend */
+        gnrc_pktbuf_release(pkt);
+        return 0;
+    }
+    *data = pkt->data;
+    *buf_ctx = pkt;
+    return (ssize_t)pkt->size;
 }
 
 ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
                      uint8_t proto, const sock_ip_ep_t *remote)
+{
+    const iolist_t snip = { NULL, (void *)data, len };
+
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+    return sock_ip_sendv(sock, &snip, proto, remote);
+}
+
+ssize_t sock_ip_sendv(sock_ip_t *sock, const iolist_t *snips, uint8_t proto,
+                      const sock_ip_ep_t *remote)
 {
     int res;
     gnrc_pktsnip_t *pkt;
@@ -134,7 +172,6 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
     sock_ip_ep_t rem;
 
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
     if ((remote != NULL) && (sock != NULL) &&
         (sock->local.netif != SOCK_ADDR_ANY_NETIF) &&
         (remote->netif != SOCK_ADDR_ANY_NETIF) &&
@@ -187,7 +224,7 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
          * there was no remote given on create, take from local */
         rem.family = local.family;
     }
-    pkt = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    pkt = gnrc_sock_payload_build(snips);
     if (pkt == NULL) {
         return -ENOMEM;
     }
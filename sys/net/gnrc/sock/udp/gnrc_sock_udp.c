@@ -18,6 +18,7 @@
 #include <errno.h>
 #include <string.h>
 
+#include "bitarithm.h"
 #include "byteorder.h"
 #include "net/af.h"
 #include "net/protnum.h"
@@ -32,45 +33,83 @@
 static sock_udp_t *_udp_socks = NULL;
 #endif
 
+#if (GNRC_SOCK_DYN_PORT_POOL_SIZE % 32) != 0
+#error "GNRC_SOCK_DYN_PORT_POOL_SIZE must be a multiple of 32"
+#endif
+
+#define _POOL_WORD_BITS     (sizeof(unsigned) * 8)
+#define _POOL_WORDS         (GNRC_SOCK_DYN_PORT_POOL_SIZE / _POOL_WORD_BITS)
+
 static uint16_t _dyn_port_next = 0;
+static unsigned _dyn_port_pool[_POOL_WORDS];
+static unsigned _dyn_port_pool_next = 0;
 
 /**
  * @brief   Checks if a given UDP port is already used by another sock
  */
-static bool _dyn_port_used(uint16_t port)
+static inline bool _dyn_port_used(uint16_t port)
 {
-#ifdef MODULE_GNRC_SOCK_CHECK_REUSE
-    for (sock_udp_t *ptr = _udp_socks; ptr != NULL;
-         ptr = (sock_udp_t *)ptr->reg.next) {
-        bool spec_addr = false;
-        for (unsigned i = 0; i < sizeof(ptr->local.addr); i++) {
-            const uint8_t *const p = (uint8_t *)&ptr->local.addr;
-            if (p[i] != 0) {
-                spec_addr = true;
+    return (gnrc_netreg_lookup(GNRC_NETTYPE_UDP, port) != NULL);
+}
+
+/**
+ * @brief   Takes a free port from the pool of dynamic ports
+ */
+static uint16_t _dyn_port_pool_get(void)
+{
+    for (unsigned i = 0; i < _POOL_WORDS; i++) {
+        unsigned word = (_dyn_port_pool_next + i) % _POOL_WORDS;
+        unsigned free = ~_dyn_port_pool[word];
+
+        while (free) {
+            unsigned bit = bitarithm_lsb(free);
+            uint16_t port = GNRC_SOCK_DYN_PORTRANGE_MIN +
+                            (word * _POOL_WORD_BITS) + bit;
+
+            free &= ~(1U << bit);
+            /* the port might have been bound explicitly */
+            if (!_dyn_port_used(port)) {
+                _dyn_port_pool[word] |= (1U << bit);
+                /* continue with the next word to not reuse released ports
+                 * immediately */
+                _dyn_port_pool_next = word + 1;
+                return port;
             }
         }
-        if (spec_addr) {
-            continue;
-        }
-        if (ptr->local.port == port) {
-            /* port already in use by another sock */
-            return true;
-        }
     }
-#else
-    (void) port;
-#endif /* MODULE_GNRC_SOCK_CHECK_REUSE */
-    return false;
+    return GNRC_SOCK_DYN_PORTRANGE_ERR;
+}
+
+/**
+ * @brief   Returns a port to the pool of dynamic ports
+ */
+static void _dyn_port_pool_release(uint16_t port)
+{
+    unsigned idx = port - GNRC_SOCK_DYN_PORTRANGE_MIN;
+
+    assert(idx < GNRC_SOCK_DYN_PORT_POOL_SIZE);
+    _dyn_port_pool[idx / _POOL_WORD_BITS] &= ~(1U << (idx % _POOL_WORD_BITS));
 }
 
 /**
  * @brief   returns a UDP port, and checks for reuse if required
  *
- * complies to RFC 6056, see https://tools.ietf.org/html/rfc6056#section-3.3.3
+ * Ports for socks are taken from the pool of dynamic ports first. If it is
+ * exhausted, the port is chosen according to RFC 6056, see
+ * https://tools.ietf.org/html/rfc6056#section-3.3.3
  */
 static uint16_t _get_dyn_port(sock_udp_t *sock)
 {
     unsigned count = GNRC_SOCK_DYN_PORTRANGE_NUM;
+
+    if ((sock != NULL) && !(sock->flags & SOCK_FLAGS_REUSE_EP)) {
+        uint16_t port = _dyn_port_pool_get();
+
+        if (port != GNRC_SOCK_DYN_PORTRANGE_ERR) {
+            sock->flags |= GNRC_SOCK_FLAGS_DYN_PORT;
+            return port;
+        }
+    }
     do {
         uint16_t port = GNRC_SOCK_DYN_PORTRANGE_MIN +
                (_dyn_port_next * GNRC_SOCK_DYN_PORTRANGE_OFF) % GNRC_SOCK_DYN_PORTRANGE_NUM;
@@ -95,6 +134,16 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
         (local->netif != remote->netif)) {
         return -EINVAL;
     }
+    /* check remote before a dynamic port is taken for local */
+    if (remote != NULL) {
+        if (gnrc_af_not_supported(remote->family)) {
+            return -EAFNOSUPPORT;
+        }
+        if (gnrc_ep_addr_any((const sock_ip_ep_t *)remote)) {
+            return -EINVAL;
+        }
+    }
+    sock->flags = flags;
     memset(&sock->local, 0, sizeof(sock_udp_ep_t));
     if (local != NULL) {
         uint16_t port = local->port;
@@ -126,12 +175,6 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
     }
     memset(&sock->remote, 0, sizeof(sock_udp_ep_t));
     if (remote != NULL) {
-        if (gnrc_af_not_supported(remote->family)) {
-            return -EAFNOSUPPORT;
-        }
-        if (gnrc_ep_addr_any((const sock_ip_ep_t *)remote)) {
-            return -EINVAL;
-        }
         gnrc_ep_set((sock_ip_ep_t *)&sock->remote,
                     (sock_ip_ep_t *)remote, sizeof(sock_udp_ep_t));
     }
@@ -139,7 +182,6 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
         /* listen only with local given */
         gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, sock->local.port);
     }
-    sock->flags = flags;
     return 0;
 }
 
@@ -147,6 +189,10 @@ void sock_udp_close(sock_udp_t *sock)
 {
     assert(sock != NULL);
     gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &sock->reg.entry);
+    if (sock->flags & GNRC_SOCK_FLAGS_DYN_PORT) {
+        _dyn_port_pool_release(sock->local.port);
+        sock->flags &= ~GNRC_SOCK_FLAGS_DYN_PORT;
+    }
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
     if (_udp_socks != NULL) {
         gnrc_sock_reg_t *head = (gnrc_sock_reg_t *)_udp_socks;
@@ -177,13 +223,42 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *remote)
 
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote)
+{
+    void *pkt = NULL, *ptr;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = sock_udp_recv_buf(sock, &ptr, &pkt, timeout, remote);
+    if (res <= 0) {
+        return res;
+    }
+    if ((size_t)res > max_len) {
+        res = -ENOBUFS;
+    }
+    else {
+        memcpy(data, ptr, res);
+    }
+    /* release packet */
+    sock_udp_recv_buf(sock, &ptr, &pkt, 0, NULL);
+    return res;
+}
+
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt, *udp;
     udp_hdr_t *hdr;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        /* the payload is always in one snip, so just release it */
+        *data = NULL;
+        gnrc_pktbuf_release(*buf_ctx);
+        *buf_ctx = NULL;
+        return 0;
+    }
     if (sock->local.family == AF_UNSPEC) {
         return -EADDRNOTAVAIL;
     }
@@ -192,10 +267,6 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     if (res < 0) {
         return res;
     }
-    if (pkt->size > max_len) {
-        gnrc_pktbuf_release(pkt);
-        return -ENOBUFS;
-    }
     udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
     assert(udp);
     hdr = udp->data;
@@ -214,14 +285,27 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
-    memcpy(data, pkt->data, pkt->size);
-    res = (int)pkt->size;
-    gnrc_pktbuf_release(pkt);
-    return res;
+    if (pkt->size == 0) {
+        /* nothing to lend */
+        gnrc_pktbuf_release(pkt);
+        return 0;
+    }
+    *data = pkt->data;
+    *buf_ctx = pkt;
+    return (ssize_t)pkt->size;
 }
 
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote)
+{
+    const iolist_t snip = { NULL, (void *)data, len };
+
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+    return sock_udp_sendv(sock, &snip, remote);
+}
+
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote)
 {
     int res;
     gnrc_pktsnip_t *payload, *pkt;
@@ -231,7 +315,6 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     sock_ip_ep_t *rem;
 
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
 
     if (remote != NULL) {
         if (remote->port == 0) {
@@ -304,7 +387,7 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         return -EINVAL;
     }
     /* generate payload and header snips */
-    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    payload = gnrc_sock_payload_build(snips);
     if (payload == NULL) {
         return -ENOMEM;
     }
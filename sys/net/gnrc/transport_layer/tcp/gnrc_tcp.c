@@ -98,6 +98,25 @@ static void _setup_timeout(xtimer_t *timer, const uint32_t duration, const xtime
     xtimer_set(timer, duration);
 }
 
+/**
+ * @brief Returns a closed TCB of a listener into the listeners backlog.
+ *
+ * @note Must be called with the TCBs function_lock held.
+ *
+ * @param[in,out] tcb   TCB that was closed.
+ */
+static void _listener_rearm(gnrc_tcp_tcb_t *tcb)
+{
+    mutex_lock(&(tcb->fsm_lock));
+    tcb->status &= ~STATUS_ACCEPTED;
+    uint8_t rearm = (tcb->listener != NULL) && (tcb->state == FSM_STATE_CLOSED);
+    mutex_unlock(&(tcb->fsm_lock));
+
+    if (rearm) {
+        _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+    }
+}
+
 /**
  * @brief   Establishes a new TCP connection
  *
@@ -119,7 +138,7 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, char *target_addr, uint16_t targe
                           const char *local_addr, uint16_t local_port, uint8_t passive)
 {
     msg_t msg;
-    xtimer_t connection_timeout;
+    xtimer_t connection_timeout = { 0 };
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
     int8_t ret = 0;
 
@@ -333,6 +352,156 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
     return _gnrc_tcp_open(tcb, NULL, 0, local_addr, local_port, 1);
 }
 
+int gnrc_tcp_listen(gnrc_tcp_listener_t *listener, gnrc_tcp_tcb_t *tcbs, size_t tcbs_numof,
+                    uint8_t address_family, const char *local_addr, uint16_t local_port)
+{
+    assert(listener != NULL);
+    assert(tcbs != NULL);
+    assert(tcbs_numof > 0);
+    assert(local_port != PORT_UNSPEC);
+
+#ifdef MODULE_GNRC_IPV6
+    ipv6_addr_t addr;
+#endif
+
+    /* Check AF-Family support and parse local address if it was supplied */
+    if (local_addr != NULL) {
+#ifdef MODULE_GNRC_IPV6
+        if (address_family != AF_INET6) {
+            return -EAFNOSUPPORT;
+        }
+        if (ipv6_addr_from_str(&addr, local_addr) == NULL) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_listen() : Invalid local addr\n");
+            return -EINVAL;
+        }
+#else
+        return -EAFNOSUPPORT;
+#endif
+    }
+
+    listener->tcbs = tcbs;
+    listener->tcbs_numof = tcbs_numof;
+    mbox_init(&(listener->mbox), listener->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
+    mutex_init(&(listener->function_lock));
+
+    /* Put every TCB into LISTEN. Receive buffers are allocated on incomming SYNs. */
+    for (size_t i = 0; i < tcbs_numof; ++i) {
+        gnrc_tcp_tcb_t *tcb = &(tcbs[i]);
+
+        gnrc_tcp_tcb_init(tcb);
+        tcb->listener = listener;
+        tcb->status |= STATUS_PASSIVE;
+        if (local_addr == NULL) {
+            tcb->status |= STATUS_ALLOW_ANY_ADDR;
+        }
+#ifdef MODULE_GNRC_IPV6
+        else {
+            memcpy(tcb->local_addr, &addr, sizeof(addr));
+        }
+#endif
+        tcb->local_port = local_port;
+        _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+    }
+    return 0;
+}
+
+int gnrc_tcp_accept(gnrc_tcp_listener_t *listener, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us)
+{
+    assert(listener != NULL);
+    assert(tcb != NULL);
+
+    msg_t msg;
+    xtimer_t user_timeout = { 0 };
+    cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(listener->mbox)};
+    int ret = 1;
+
+    /* Lock the listener for this function call */
+    mutex_lock(&(listener->function_lock));
+
+    /* 'Flush' mbox, the backlog is searched anyway */
+    while (mbox_try_get(&(listener->mbox), &msg) != 0) {
+    }
+
+    /* Setup user specified timeout */
+    if (user_timeout_duration_us != 0) {
+        _setup_timeout(&user_timeout, user_timeout_duration_us, _cb_mbox_put_msg,
+                       &user_timeout_arg);
+    }
+
+    *tcb = NULL;
+    while (ret > 0) {
+        /* Hand over the first established connection that was not accepted yet */
+        for (size_t i = 0; (i < listener->tcbs_numof) && (*tcb == NULL); ++i) {
+            gnrc_tcp_tcb_t *iter = &(listener->tcbs[i]);
+
+            mutex_lock(&(iter->fsm_lock));
+            if (!(iter->status & STATUS_ACCEPTED) && (iter->state == FSM_STATE_ESTABLISHED ||
+                                                     iter->state == FSM_STATE_CLOSE_WAIT)) {
+                iter->status |= STATUS_ACCEPTED;
+                *tcb = iter;
+            }
+            mutex_unlock(&(iter->fsm_lock));
+        }
+        if (*tcb != NULL) {
+            ret = 0;
+            break;
+        }
+
+        /* Non-blocking call: Return immediately */
+        if (user_timeout_duration_us == 0) {
+            ret = -EAGAIN;
+            break;
+        }
+
+        /* Wait for a new connection or until the timeout fires */
+        mbox_get(&(listener->mbox), &msg);
+        switch (msg.type) {
+            case MSG_TYPE_USER_SPEC_TIMEOUT:
+                DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : USER_SPEC_TIMEOUT\n");
+                ret = -ETIMEDOUT;
+                break;
+
+            case MSG_TYPE_NOTIFY_USER:
+                DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : NOTIFY_USER\n");
+                break;
+
+            default:
+                DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : other message type\n");
+        }
+    }
+
+    /* Cleanup */
+    if (user_timeout_duration_us != 0) {
+        xtimer_remove(&user_timeout);
+    }
+    mutex_unlock(&(listener->function_lock));
+    return ret;
+}
+
+void gnrc_tcp_stop_listen(gnrc_tcp_listener_t *listener)
+{
+    assert(listener != NULL);
+
+    /* Lock the listener for this function call */
+    mutex_lock(&(listener->function_lock));
+
+    for (size_t i = 0; i < listener->tcbs_numof; ++i) {
+        gnrc_tcp_tcb_t *tcb = &(listener->tcbs[i]);
+
+        /* Detach TCB from the listener, accepted connections stay with the user */
+        mutex_lock(&(tcb->fsm_lock));
+        tcb->listener = NULL;
+        uint8_t accepted = (tcb->status & STATUS_ACCEPTED);
+        mutex_unlock(&(tcb->fsm_lock));
+
+        if (!accepted) {
+            gnrc_tcp_abort(tcb);
+        }
+    }
+    mutex_unlock(&(listener->function_lock));
+}
+
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t timeout_duration_us)
 {
@@ -340,11 +509,11 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     assert(data != NULL);
 
     msg_t msg;
-    xtimer_t connection_timeout;
+    xtimer_t connection_timeout = { 0 };
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
-    xtimer_t user_timeout;
+    xtimer_t user_timeout = { 0 };
     cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(tcb->mbox)};
-    xtimer_t probe_timeout;
+    xtimer_t probe_timeout = { 0 };
     cb_arg_t probe_timeout_arg = {MSG_TYPE_PROBE_TIMEOUT, &(tcb->mbox)};
     uint32_t probe_timeout_duration_us = 0;
     ssize_t ret = 0;
@@ -465,9 +634,9 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     assert(data != NULL);
 
     msg_t msg;
-    xtimer_t connection_timeout;
+    xtimer_t connection_timeout = { 0 };
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
-    xtimer_t user_timeout;
+    xtimer_t user_timeout = { 0 };
     cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(tcb->mbox)};
     ssize_t ret = 0;
 
@@ -555,7 +724,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     assert(tcb != NULL);
 
     msg_t msg;
-    xtimer_t connection_timeout;
+    xtimer_t connection_timeout = { 0 };
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
 
     /* Lock the TCB for this function call */
@@ -563,6 +732,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
 
     /* Return if connection is closed */
     if (tcb->state == FSM_STATE_CLOSED) {
+        _listener_rearm(tcb);
         mutex_unlock(&(tcb->function_lock));
         return;
     }
@@ -602,6 +772,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     /* Cleanup */
     xtimer_remove(&connection_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
+    _listener_rearm(tcb);
     mutex_unlock(&(tcb->function_lock));
 }
 
@@ -615,6 +786,7 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
         /* Call FSM ABORT event */
         _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
     }
+    _listener_rearm(tcb);
     mutex_unlock(&(tcb->function_lock));
 }
 
@@ -174,39 +174,47 @@ static int _receive(gnrc_pktsnip_t *pkt)
 
     /* Find TCB to for this packet */
     mutex_lock(&_list_tcb_lock);
+#ifdef MODULE_GNRC_IPV6
+    /* A connection matching all ports and addresses takes any segment, even a
+     * retransmitted SYN ... */
     tcb = _list_tcb_head;
     while (tcb) {
-#ifdef MODULE_GNRC_IPV6
-        /* Check if current TCB is fitting for the incomming packet */
-        if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
-            /* If SYN is set, a connection is listening on that port ... */
-            ipv6_addr_t *tmp_addr = NULL;
-            if (syn && tcb->local_port == dst && tcb->state == FSM_STATE_LISTEN) {
-                /* ... and local addr is unspec or pre configured */
-                tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, (ipv6_addr_t *) tmp_addr) ||
-                    ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
-                    break;
-                }
+        if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6 &&
+            tcb->state != FSM_STATE_LISTEN &&
+            tcb->local_port == dst && tcb->peer_port == src) {
+            ipv6_hdr_t *ip6 = (ipv6_hdr_t *)ip->data;
+            if (ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, &ip6->src) &&
+                (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, &ip6->dst) ||
+                 ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr))) {
+                break;
             }
+        }
+        tcb = tcb->next;
+    }
 
-            /* If SYN is not set and the ports match ... */
-            if (!syn && tcb->local_port == dst && tcb->peer_port == src) {
-                /* .. and the IPv6 addresses match */
-                tmp_addr = &((ipv6_hdr_t * )ip->data)->src;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, (ipv6_addr_t *) tmp_addr)) {
+    /* ... otherwise a SYN opens a new connection on a listening TCB */
+    if (tcb == NULL && syn) {
+        tcb = _list_tcb_head;
+        while (tcb) {
+            if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6 &&
+                tcb->state == FSM_STATE_LISTEN && tcb->local_port == dst) {
+                /* ... and local addr is unspec or pre configured */
+                ipv6_addr_t *tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
+                if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, tmp_addr) ||
+                    ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
                     break;
                 }
             }
+            tcb = tcb->next;
         }
+    }
 #else
-        /* Supress compiler warnings if TCP is build without network layer */
-        (void) syn;
-        (void) src;
-        (void) dst;
+    /* Supress compiler warnings if TCP is build without network layer */
+    (void) syn;
+    (void) src;
+    (void) dst;
+    tcb = NULL;
 #endif
-        tcb = tcb->next;
-    }
     mutex_unlock(&_list_tcb_lock);
 
     /* Call FSM with event RCVD_PKT if a fitting TCB was found */
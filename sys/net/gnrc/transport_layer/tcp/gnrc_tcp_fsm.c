@@ -126,6 +126,11 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             /* Clear retransmit queue */
             _clear_retransmit(tcb);
 
+            /* Connections of a listener that were not accepted return into the backlog */
+            if ((tcb->listener != NULL) && !(tcb->status & STATUS_ACCEPTED)) {
+                return _transition_to(tcb, FSM_STATE_LISTEN);
+            }
+
             /* Remove connection from active connections */
             mutex_lock(&_list_tcb_lock);
             LL_DELETE(_list_tcb_head, tcb);
@@ -148,8 +153,12 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 #endif
             tcb->peer_port = PORT_UNSPEC;
 
-            /* Allocate receive buffer */
-            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
+            /* Listener TCBs allocate their receive buffer on an incomming SYN. All others
+             * allocate it now. */
+            if (tcb->listener != NULL) {
+                _rcvbuf_release_buffer(tcb);
+            }
+            else if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
                 return -ENOMEM;
             }
 
@@ -192,9 +201,19 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             break;
 
         case FSM_STATE_SYN_RCVD:
+            tcb->status |= STATUS_NOTIFY_USER;
+            break;
+
         case FSM_STATE_ESTABLISHED:
         case FSM_STATE_CLOSE_WAIT:
             tcb->status |= STATUS_NOTIFY_USER;
+
+            /* Notify listener about a connection that can be accepted */
+            if ((tcb->listener != NULL) && !(tcb->status & STATUS_ACCEPTED)) {
+                msg_t msg;
+                msg.type = MSG_TYPE_NOTIFY_USER;
+                mbox_try_put(&(tcb->listener->mbox), &msg);
+            }
             break;
 
         case FSM_STATE_TIME_WAIT:
@@ -473,6 +492,13 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 return 0;
             }
 
+            /* Listener TCBs take their receive buffer from the shared pool now. If the
+             * pool is exhausted the SYN is dropped and the peer retries later. */
+            if ((tcb->listener != NULL) && (_rcvbuf_get_buffer(tcb) == -ENOMEM)) {
+                DEBUG("gnrc_tcp_fsm.c : _fsm_rcvd_pkt() : No receive buffer, SYN dropped\n");
+                return 0;
+            }
+
             /* SYN request is valid, fill TCB with connection information */
 #ifdef MODULE_GNRC_IPV6
             if (snp->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
@@ -771,6 +797,15 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
+
+    /* Half-open connections of a listener are dropped to free their TCB for the backlog */
+    if ((tcb->listener != NULL) && (tcb->state == FSM_STATE_SYN_RCVD) &&
+        (tcb->retries >= GNRC_TCP_SYN_RCVD_RETRIES)) {
+        _clear_retransmit(tcb);
+        _transition_to(tcb, FSM_STATE_LISTEN);
+        return 0;
+    }
+
     if (tcb->pkt_retransmit != NULL) {
         _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
         _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
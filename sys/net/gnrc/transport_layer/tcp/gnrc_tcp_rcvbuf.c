@@ -16,44 +16,72 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <string.h>
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
 /**
- * @brief Internal struct holding receive buffers.
+ * @brief Internal struct holding the receive buffer pool.
  */
 rcvbuf_t _static_buf;
 
 /**
- * @brief Initializes all receive buffers.
+ * @brief Initializes the receive buffer pool.
  */
 void _rcvbuf_init(void)
 {
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_init() : entry\n");
     mutex_init(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        _static_buf.entries[i].used = 0;
-    }
+    memset(_static_buf.blocks, 0, sizeof(_static_buf.blocks));
 }
 
 /**
- * @brief Allocate receive buffer.
+ * @brief Allocate a receive buffer from the pool.
+ *
+ * @param[out] size   Size of the allocated buffer.
  *
- * @returns   Not NULL if a receive buffer was allocated.
- *            NULL if allocation failed.
+ * @returns   Pointer to the allocated buffer.
+ *            NULL if no block was free.
  */
-static void* _rcvbuf_alloc(void)
+static void* _rcvbuf_alloc(size_t *size)
 {
     void *result = NULL;
+    size_t best = 0;
+    size_t best_len = 0;
+    size_t i = 0;
+
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_alloc() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if (_static_buf.entries[i].used == 0) {
-            _static_buf.entries[i].used = 1;
-            result = (void *)(_static_buf.entries[i].buffer);
-            break;
+
+    /* Take the first free run that fits a full buffer, else the longest one */
+    while (i < RCVBUF_BLOCKS_NUMOF && best_len < RCVBUF_BLOCKS_MAX) {
+        if (_static_buf.blocks[i] != 0) {
+            i += 1;
+            continue;
+        }
+        size_t len = 0;
+        while ((i + len) < RCVBUF_BLOCKS_NUMOF && len < RCVBUF_BLOCKS_MAX &&
+               _static_buf.blocks[i + len] == 0) {
+            len += 1;
+        }
+        if (len > best_len) {
+            best = i;
+            best_len = len;
+        }
+        i += len;
+    }
+
+    if (best_len > 0) {
+        _static_buf.blocks[best] = best_len;
+        for (i = 1; i < best_len; ++i) {
+            _static_buf.blocks[best + i] = RCVBUF_BLOCK_CONT;
+        }
+        result = (void *)&(_static_buf.pool[best * GNRC_TCP_RCV_BUF_BLOCK_SIZE]);
+        *size = best_len * GNRC_TCP_RCV_BUF_BLOCK_SIZE;
+        if (*size > GNRC_TCP_RCV_BUF_SIZE) {
+            *size = GNRC_TCP_RCV_BUF_SIZE;
         }
     }
     mutex_unlock(&(_static_buf.lock));
@@ -61,18 +89,19 @@ static void* _rcvbuf_alloc(void)
 }
 
 /**
- * @brief Release allocated receive buffer.
+ * @brief Release a receive buffer back into the pool.
  *
- * @param[in] buf   Pointer to buffer that should be released.
+ * @param[in] buf   Buffer to release.
  */
 static void _rcvbuf_free(void * const buf)
 {
+    size_t first = ((uint8_t *)buf - _static_buf.pool) / GNRC_TCP_RCV_BUF_BLOCK_SIZE;
+
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_free() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if ((_static_buf.entries[i].used == 1) && (buf == _static_buf.entries[i].buffer)) {
-            _static_buf.entries[i].used = 0;
-        }
+    size_t len = _static_buf.blocks[first];
+    for (size_t i = 0; i < len; ++i) {
+        _static_buf.blocks[first + i] = 0;
     }
     mutex_unlock(&(_static_buf.lock));
 }
@@ -80,13 +109,15 @@ static void _rcvbuf_free(void * const buf)
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw == NULL) {
-        tcb->rcv_buf_raw = _rcvbuf_alloc();
+        size_t size = 0;
+        tcb->rcv_buf_raw = _rcvbuf_alloc(&size);
         if (tcb->rcv_buf_raw == NULL) {
             DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_buf_raw\n");
             return -ENOMEM;
         }
         else {
-            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
+            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, size);
+            tcb->rcv_wnd = size;
         }
     }
     return 0;
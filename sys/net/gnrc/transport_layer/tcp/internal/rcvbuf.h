@@ -32,19 +32,29 @@ extern "C" {
 #endif
 
 /**
- * @brief Receive buffer entry.
+ * @brief Number of blocks in the receive buffer pool.
  */
-typedef struct rcvbuf_entry {
-    uint8_t used;                          /**< Flag: Is buffer in use? */
-    uint8_t buffer[GNRC_TCP_RCV_BUF_SIZE]; /**< Receive buffer storage */
-} rcvbuf_entry_t;
+#define RCVBUF_BLOCKS_NUMOF (GNRC_TCP_RCV_BUF_POOL_SIZE / GNRC_TCP_RCV_BUF_BLOCK_SIZE)
 
 /**
- * @brief   Stuct holding receive buffers.
+ * @brief Maximum number of blocks assigned to a single receive buffer.
+ */
+#define RCVBUF_BLOCKS_MAX   ((GNRC_TCP_RCV_BUF_SIZE + GNRC_TCP_RCV_BUF_BLOCK_SIZE - 1) / \
+                             GNRC_TCP_RCV_BUF_BLOCK_SIZE)
+
+/**
+ * @brief Marks a block that continues the receive buffer of a previous block.
+ */
+#define RCVBUF_BLOCK_CONT   (UINT8_MAX)
+
+/**
+ * @brief   Stuct holding the receive buffer pool.
  */
 typedef struct rcvbuf {
-    mutex_t lock;                                 /**< Lock for allocation synchronization */
-    rcvbuf_entry_t entries[GNRC_TCP_RCV_BUFFERS]; /**< Maintained receive buffers */
+    mutex_t lock;                        /**< Lock for allocation synchronization */
+    uint8_t blocks[RCVBUF_BLOCKS_NUMOF]; /**< Per block: zero if free, number of blocks of
+                                              the buffer starting here or RCVBUF_BLOCK_CONT */
+    uint8_t pool[RCVBUF_BLOCKS_NUMOF * GNRC_TCP_RCV_BUF_BLOCK_SIZE]; /**< Buffer storage */
 } rcvbuf_t;
 
 /**
@@ -55,10 +65,14 @@ void _rcvbuf_init(void);
 /**
  * @brief Allocate receive buffer and assign it to TCB.
  *
+ * The buffer spans up to GNRC_TCP_RCV_BUF_SIZE bytes. If the pool is short on
+ * memory, the largest free part is used instead and the receive window of
+ * @p tcb is set to the size of the buffer.
+ *
  * @param[in,out] tcb   TCB that aquires receive buffer.
  *
  * @returns   Zero  on success.
- *            -ENOMEM if all receive buffers are currently used.
+ *            -ENOMEM if no block of the pool is free.
  */
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
 
@@ -19,11 +19,13 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
 #include <errno.h>
+#include "kernel_defines.h"
 #include "thread.h"
 #include "mutex.h"
 #include "msg.h"
@@ -65,9 +67,300 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+/**
+ * @name    Internal state of a trie node
+ * @{
+ */
+#define FIB_TRIE_INDEXED    (0x01)  /**< entry node linked in the trie */
+#define FIB_TRIE_DUP        (0x02)  /**< entry node linked behind one with the same key */
+#define FIB_TRIE_BRANCH     (0x04)  /**< branch node in use */
+/** @} */
+
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+
+/**
+ * @brief returns the byte @p idx of the trie key of an address
+ */
+static inline uint8_t fib_key_byte(const uint8_t *addr, size_t addr_size, unsigned idx)
+{
+    return (idx == 0) ? (uint8_t)addr_size : addr[idx - 1];
+}
+
+/**
+ * @brief returns the bit at position @p pos of the trie key of an address
+ */
+static inline unsigned fib_key_bit(const uint8_t *addr, size_t addr_size, unsigned pos)
+{
+    return (fib_key_byte(addr, addr_size, pos >> 3) >> (7 - (pos & 0x07))) & 0x01;
+}
+
+/**
+ * @brief returns the number of leading key bits two addresses share,
+ *        at most @p max
+ */
+static unsigned fib_key_common(const uint8_t *a, size_t a_size,
+                               const uint8_t *b, size_t b_size, unsigned max)
+{
+    for (unsigned idx = 0; (idx << 3) < max; idx++) {
+        uint8_t diff = fib_key_byte(a, a_size, idx) ^ fib_key_byte(b, b_size, idx);
+
+        if (diff) {
+            unsigned pos = idx << 3;
+            while (!(diff & 0x80)) {
+                diff <<= 1;
+                pos++;
+            }
+            return (pos < max) ? pos : max;
+        }
+    }
+
+    return max;
+}
+
+/**
+ * @brief returns the trie key length of an entry in bits
+ *
+ * Prefix entries use their prefix length, an all-zero address is the default
+ * route and matches with length 0, all others are host routes.
+ */
+static unsigned fib_entry_key_len(fib_entry_t *entry)
+{
+    size_t bits = entry->global->address_size << 3;
+
+    if (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) {
+        size_t prefix = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                        >> FIB_FLAG_NET_PREFIX_SHIFT;
+        if (prefix < bits) {
+            bits = prefix;
+        }
+    }
+    else {
+        size_t i = 0;
+        while ((i < entry->global->address_size) && (entry->global->address[i] == 0)) {
+            i++;
+        }
+        if (i == entry->global->address_size) {
+            bits = 0;
+        }
+    }
+
+    return 8 + bits;
+}
+
+static inline fib_entry_t *fib_trie_entry(fib_trie_node_t *node)
+{
+    return container_of(node, fib_entry_t, trie);
+}
+
+static inline bool fib_expired(fib_entry_t *entry, uint64_t now)
+{
+    return (entry->lifetime != FIB_LIFETIME_NO_EXPIRE) && (entry->lifetime < now);
+}
+
+/**
+ * @brief returns an entry below @p node, its key shares the first
+ *        `node->len` bits with all keys of that subtree
+ */
+static fib_entry_t *fib_trie_any(fib_trie_node_t *node)
+{
+    while (node->flags & FIB_TRIE_BRANCH) {
+        node = node->child[0];
+    }
+    return fib_trie_entry(node);
+}
+
+/**
+ * @brief links @p node where @p old hung below @p parent
+ */
+static void fib_trie_link(fib_table_t *table, fib_trie_node_t *parent,
+                          fib_trie_node_t *old, fib_trie_node_t *node)
+{
+    if (parent == NULL) {
+        table->trie = node;
+    }
+    else {
+        parent->child[parent->child[1] == old] = node;
+    }
+
+    if (node != NULL) {
+        node->parent = parent;
+    }
+}
+
+/**
+ * @brief puts @p node in the place of @p old
+ */
+static void fib_trie_replace(fib_table_t *table, fib_trie_node_t *old,
+                             fib_trie_node_t *node)
+{
+    node->len = old->len;
+    node->child[0] = old->child[0];
+    node->child[1] = old->child[1];
+    fib_trie_link(table, old->parent, old, node);
+
+    for (unsigned i = 0; i < 2; i++) {
+        if (node->child[i] != NULL) {
+            node->child[i]->parent = node;
+        }
+    }
+}
+
+/**
+ * @brief takes an unused branch node from the table entries
+ *
+ * A trie with n entries needs at most n - 1 branch nodes, so there is
+ * always one left.
+ */
+static fib_trie_node_t *fib_trie_branch(fib_table_t *table)
+{
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_trie_node_t *node = &table->data.entries[i].trie_branch;
+        if (!(node->flags & FIB_TRIE_BRANCH)) {
+            memset(node, 0, sizeof(*node));
+            node->flags = FIB_TRIE_BRANCH;
+            return node;
+        }
+    }
+
+    assert(false);
+    return NULL;
+}
+
+/**
+ * @brief adds a new entry to the trie
+ *
+ * @param[in] table  the FIB table
+ * @param[in] entry  the entry, its global address must be set
+ */
+static void fib_trie_insert(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_trie_node_t *new = &entry->trie;
+    const uint8_t *key = entry->global->address;
+    size_t key_size = entry->global->address_size;
+    unsigned len = fib_entry_key_len(entry);
+
+    memset(new, 0, sizeof(*new));
+    new->len = len;
+    new->flags = FIB_TRIE_INDEXED;
+
+    if (table->trie == NULL) {
+        table->trie = new;
+        return;
+    }
+
+    /* follow the key as far as the trie goes */
+    fib_trie_node_t *node = table->trie;
+    while (node->len < len) {
+        fib_trie_node_t *next = node->child[fib_key_bit(key, key_size, node->len)];
+        if (next == NULL) {
+            break;
+        }
+        node = next;
+    }
+
+    /* find where the key leaves the path */
+    fib_entry_t *ref = fib_trie_any(node);
+    unsigned common = fib_key_common(key, key_size, ref->global->address,
+                                     ref->global->address_size,
+                                     (node->len < len) ? node->len : len);
+
+    while ((node->parent != NULL) && (node->parent->len >= common)) {
+        node = node->parent;
+    }
+
+    if (node->len == common) {
+        if (common < len) {
+            /* the key extends the one of node */
+            node->child[fib_key_bit(key, key_size, common)] = new;
+            new->parent = node;
+        }
+        else if (node->flags & FIB_TRIE_BRANCH) {
+            fib_trie_replace(table, node, new);
+            node->flags = 0;
+        }
+        else {
+            /* same key as another entry, keep it behind that one */
+            new->flags = FIB_TRIE_DUP;
+            new->parent = node;
+            new->dup = node->dup;
+            if (node->dup != NULL) {
+                node->dup->parent = new;
+            }
+            node->dup = new;
+        }
+        return;
+    }
+
+    fib_trie_node_t *parent = node->parent;
+    unsigned bit = fib_key_bit(ref->global->address, ref->global->address_size, common);
+
+    if (common == len) {
+        /* the key is a prefix of the one of node */
+        fib_trie_link(table, parent, node, new);
+        new->child[bit] = node;
+        node->parent = new;
+    }
+    else {
+        /* the keys diverge, branch at the first distinct bit */
+        fib_trie_node_t *branch = fib_trie_branch(table);
+        branch->len = common;
+        fib_trie_link(table, parent, node, branch);
+        branch->child[bit] = node;
+        branch->child[!bit] = new;
+        node->parent = branch;
+        new->parent = branch;
+    }
+}
+
+/**
+ * @brief removes an entry from the trie, if it is linked
+ */
+static void fib_trie_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_trie_node_t *node = &entry->trie;
+
+    if (node->flags & FIB_TRIE_DUP) {
+        node->parent->dup = node->dup;
+        if (node->dup != NULL) {
+            node->dup->parent = node->parent;
+        }
+    }
+    else if (node->flags & FIB_TRIE_INDEXED) {
+        fib_trie_node_t *parent = node->parent;
+
+        if (node->dup != NULL) {
+            /* the next entry with the same key takes over */
+            fib_trie_replace(table, node, node->dup);
+            node->dup->flags = FIB_TRIE_INDEXED;
+        }
+        else if ((node->child[0] != NULL) && (node->child[1] != NULL)) {
+            fib_trie_replace(table, node, fib_trie_branch(table));
+        }
+        else {
+            fib_trie_node_t *child = (node->child[0] != NULL) ? node->child[0]
+                                                               : node->child[1];
+            fib_trie_link(table, parent, node, child);
+
+            /* a branch node without both subtrees is useless */
+            if ((child == NULL) && (parent != NULL) && (parent->flags & FIB_TRIE_BRANCH)) {
+                fib_trie_node_t *sibling = (parent->child[0] != NULL) ? parent->child[0]
+                                                                       : parent->child[1];
+                fib_trie_link(table, parent->parent, parent, sibling);
+                parent->flags = 0;
+            }
+        }
+    }
+
+    memset(node, 0, sizeof(*node));
+}
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
+ * Walks the prefix trie along the key of @p dst, so the lookup takes
+ * O(address bits) regardless of the number of entries. Expired entries found
+ * on the way are removed.
+ *
  * @param[in] table                the FIB table to search in
  * @param[in] dst                  the destination address
  * @param[in] dst_size             the destination address size
@@ -82,12 +375,9 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
     uint64_t now = xtimer_now_usec64();
-
-    size_t count = 0;
-    size_t prefix_size = 0;
-    size_t match_size = dst_size << 3;
-    int ret = -EHOSTUNREACH;
-    bool is_all_zeros_addr = true;
+    unsigned len = 8 + (dst_size << 3);
+    fib_trie_node_t *node;
+    fib_trie_node_t *last;
 
 #if ENABLE_DEBUG
     DEBUG("[fib_find_entry] dst =");
@@ -97,86 +387,65 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     DEBUG("\n");
 #endif
 
-    for (size_t i = 0; i < dst_size; ++i) {
-        if (dst[i] != 0) {
-            is_all_zeros_addr = false;
+    *entry_arr_size = 0;
+
+restart:
+    /* follow the key down to the deepest node not longer than it */
+    last = NULL;
+    node = table->trie;
+    while ((node != NULL) && (node->len <= len)) {
+        if (!(node->flags & FIB_TRIE_BRANCH)) {
+            for (fib_trie_node_t *dup = node; dup != NULL; dup = dup->dup) {
+                if (fib_expired(fib_trie_entry(dup), now)) {
+                    /* remove this entry if its lifetime expired */
+                    fib_remove(table, fib_trie_entry(dup));
+                    goto restart;
+                }
+            }
+        }
+        last = node;
+        if (node->len == len) {
             break;
         }
+        node = node->child[fib_key_bit(dst, dst_size, node->len)];
     }
 
-    for (size_t i = 0; i < table->size; ++i) {
-
-        /* autoinvalidate if the entry lifetime is not set to not expire */
-        if (table->data.entries[i].lifetime != FIB_LIFETIME_NO_EXPIRE) {
-
-            /* check if the lifetime expired */
-            if (table->data.entries[i].lifetime < now) {
-                /* remove this entry if its lifetime expired */
-                table->data.entries[i].lifetime = 0;
-                table->data.entries[i].global_flags = 0;
-                table->data.entries[i].next_hop_flags = 0;
-                table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
+    if (last == NULL) {
+        return -EHOSTUNREACH;
+    }
 
-                if (table->data.entries[i].global != NULL) {
-                    universal_address_rem(table->data.entries[i].global);
-                    table->data.entries[i].global = NULL;
-                }
+    /* all nodes on the path up to that many bits match dst */
+    fib_entry_t *ref = fib_trie_any(last);
+    unsigned common = fib_key_common(dst, dst_size, ref->global->address,
+                                     ref->global->address_size, last->len);
 
-                if (table->data.entries[i].next_hop != NULL) {
-                    universal_address_rem(table->data.entries[i].next_hop);
-                    table->data.entries[i].next_hop = NULL;
+    int ret = -EHOSTUNREACH;
+    node = table->trie;
+    while ((node != NULL) && (node->len <= common)) {
+        if (!(node->flags & FIB_TRIE_BRANCH)) {
+            for (fib_trie_node_t *dup = node; dup != NULL; dup = dup->dup) {
+                fib_entry_t *entry = fib_trie_entry(dup);
+                if ((dup->len == len)
+                    || ((entry->global->address_size == dst_size)
+                        && (memcmp(entry->global->address, dst, dst_size) == 0))) {
+                    /* we will not find a better one so we return */
+                    entry_arr[0] = entry;
+                    *entry_arr_size = 1;
+                    return 1;
                 }
             }
+            /* the longest prefix so far */
+            entry_arr[0] = fib_trie_entry(node);
+            ret = 0;
         }
-
-        if ((prefix_size < (dst_size<<3)) && (table->data.entries[i].global != NULL)) {
-
-            int ret_comp = universal_address_compare(table->data.entries[i].global, dst, &match_size);
-            /* If we found an exact match */
-            if ((ret_comp == UNIVERSAL_ADDRESS_EQUAL)
-                || (is_all_zeros_addr && (ret_comp == UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS))) {
-                entry_arr[0] = &(table->data.entries[i]);
-                *entry_arr_size = 1;
-                /* we will not find a better one so we return */
-                return 1;
-            }
-            else {
-                /* we try to find the most fitting prefix */
-                if (ret_comp == UNIVERSAL_ADDRESS_MATCHING_PREFIX) {
-                    if (table->data.entries[i].global_flags & FIB_FLAG_NET_PREFIX_MASK) {
-                        /* we shift the most upper flag byte back to get the number of prefix bits */
-                        size_t global_prefix_len = (table->data.entries[i].global_flags
-                                                    & FIB_FLAG_NET_PREFIX_MASK) >> FIB_FLAG_NET_PREFIX_SHIFT;
-
-                        if ((match_size >= global_prefix_len) &&
-                            ((prefix_size == 0) || (match_size > prefix_size))) {
-                            entry_arr[0] = &(table->data.entries[i]);
-                            /* we could find a better one so we move on */
-                            ret = 0;
-
-                            prefix_size = match_size;
-                            count = 1;
-                        }
-                    }
-                 }
-                 else if (ret_comp == UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS) {
-                    /* we found the default gateway entry, e.g. ::/0 for IPv6
-                     * and we keep it only if there is no better one
-                     */
-                    if (prefix_size == 0) {
-                        entry_arr[0] = &(table->data.entries[i]);
-                        /* we could find a better one so we move on */
-                        ret = 0;
-                        count = 1;
-                    }
-                }
-                match_size = dst_size<<3;
-            }
+        if (node->len == len) {
+            break;
         }
+        node = node->child[fib_key_bit(dst, dst_size, node->len)];
     }
 
 #if ENABLE_DEBUG
-    if (count > 0) {
+    if (ret == 0) {
         DEBUG("[fib_find_entry] found prefix on interface %d:", entry_arr[0]->iface_id);
         for (size_t i = 0; i < entry_arr[0]->global->address_size; i++) {
             DEBUG(" %02x", entry_arr[0]->global->address[i]);
@@ -185,7 +454,9 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     }
 #endif
 
-    *entry_arr_size = count;
+    if (ret == 0) {
+        *entry_arr_size = 1;
+    }
     return ret;
 }
 
@@ -246,7 +517,15 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                             uint8_t *next_hop, size_t next_hop_size, uint32_t
                             next_hop_flags, uint32_t lifetime)
 {
+    uint64_t now = xtimer_now_usec64();
+
     for (size_t i = 0; i < table->size; ++i) {
+        /* reuse the slots of expired entries */
+        if ((table->data.entries[i].lifetime != 0)
+            && fib_expired(&table->data.entries[i], now)) {
+            fib_remove(table, &table->data.entries[i]);
+        }
+
         if (table->data.entries[i].lifetime == 0) {
 
             table->data.entries[i].global = universal_address_add(dst, dst_size);
@@ -268,6 +547,7 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
 
+                fib_trie_insert(table, &table->data.entries[i]);
                 return 0;
             }
         }
@@ -279,12 +559,15 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table holding the entry
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
+    fib_trie_remove(table, entry);
+
     if (entry->global != NULL) {
         universal_address_rem(entry->global);
     }
@@ -457,7 +740,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +760,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -596,6 +879,7 @@ void fib_init(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+        table->trie = NULL;
     }
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
@@ -621,6 +905,7 @@ void fib_deinit(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+        table->trie = NULL;
     }
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
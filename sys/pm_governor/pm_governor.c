@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_pm_governor
+ * @{
+ *
+ * @file
+ * @brief       Deadline-aware idle governor implementation
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "irq.h"
+#include "pm_governor.h"
+
+#ifdef MODULE_XTIMER
+#include "xtimer.h"
+#endif
+#ifdef MODULE_LPTIMER
+#include "lptimer.h"
+#endif
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* modes 0..PM_NUM_MODES-1 plus the implicit idle mode */
+#define MODES_NUMOF     (PM_NUM_MODES + 1)
+
+static const pm_governor_params_t _params[PM_NUM_MODES] = PM_GOVERNOR_PARAMS;
+
+static pm_governor_stats_t _stats[MODES_NUMOF];
+/* residency in ticks of the governor clock, converted when read */
+static uint64_t _residency[MODES_NUMOF];
+static uint64_t _entered_at;
+static volatile unsigned _mode = MODES_NUMOF;
+
+static void _wakeup_cb(void *arg)
+{
+    (void)arg;
+    if (_mode < MODES_NUMOF) {
+        _stats[_mode].prearmed++;
+    }
+}
+
+#ifdef MODULE_XTIMER
+static xtimer_t _xtimer_wakeup = { .callback = _wakeup_cb };
+#endif
+#ifdef MODULE_LPTIMER
+static lptimer_t _lptimer_wakeup = { .callback = _wakeup_cb };
+#endif
+
+/* prefer lptimer as clock, xtimer does not count in the deeper modes */
+static inline uint64_t _now(void)
+{
+#if defined(MODULE_LPTIMER)
+    return lptimer_now64().ticks64;
+#elif defined(MODULE_XTIMER)
+    return xtimer_now64().ticks64;
+#else
+    return 0;
+#endif
+}
+
+static inline uint64_t _usec(uint64_t ticks)
+{
+#if defined(MODULE_LPTIMER)
+    return lptimer_msec_from_ticks64(lptimer_ticks64(ticks)) * US_PER_MS;
+#elif defined(MODULE_XTIMER)
+    return xtimer_usec_from_ticks64(xtimer_ticks64(ticks));
+#else
+    return ticks;
+#endif
+}
+
+static inline uint32_t _sat_add(uint32_t a, uint32_t b)
+{
+    return (a > UINT32_MAX - b) ? UINT32_MAX : a + b;
+}
+
+/**
+ * @brief   arm a wakeup @p us from now on a timer that keeps running in
+ *          @p flags
+ *
+ * @return  0 on success, -1 if no suitable timer or @p us is too short
+ */
+static int _prearm(uint8_t flags, uint32_t us)
+{
+#ifdef MODULE_LPTIMER
+    if (!(flags & PM_GOVERNOR_STOPS_LPTIMER)) {
+        uint32_t ticks = lptimer_ticks_from_msec(us / US_PER_MS).ticks32;
+        if (ticks > LPTIMER_BACKOFF) {
+            _lptimer_set(&_lptimer_wakeup, ticks);
+            return 0;
+        }
+    }
+#endif
+#ifdef MODULE_XTIMER
+    if (!(flags & PM_GOVERNOR_STOPS_XTIMER)) {
+        uint32_t ticks = xtimer_ticks_from_usec(us).ticks32;
+        if (ticks > XTIMER_BACKOFF) {
+            _xtimer_set(&_xtimer_wakeup, ticks);
+            return 0;
+        }
+    }
+#endif
+    (void)flags;
+    (void)us;
+    return -1;
+}
+
+unsigned pm_governor_select(unsigned mode)
+{
+    int xtimer_armed = 0;
+    int lptimer_armed = 0;
+    uint32_t deadline = UINT32_MAX;
+    unsigned lowest = mode;
+
+    /* the last wakeup timer must not count as deadline */
+#ifdef MODULE_XTIMER
+    xtimer_remove(&_xtimer_wakeup);
+    xtimer_ticks32_t xticks;
+    xtimer_armed = xtimer_next_deadline(&xticks);
+    if (xtimer_armed) {
+        deadline = xtimer_usec_from_ticks(xticks);
+    }
+#endif
+#ifdef MODULE_LPTIMER
+    lptimer_remove(&_lptimer_wakeup);
+    lptimer_ticks32_t lticks;
+    lptimer_armed = lptimer_next_deadline(&lticks);
+    if (lptimer_armed) {
+        uint64_t us = (uint64_t)lptimer_msec_from_ticks(lticks) * US_PER_MS;
+        if (us < deadline) {
+            deadline = us;
+        }
+    }
+#endif
+
+    for (; mode < PM_NUM_MODES; mode++) {
+        const pm_governor_params_t *p = &_params[mode];
+
+        if ((xtimer_armed && (p->flags & PM_GOVERNOR_STOPS_XTIMER))
+            || (lptimer_armed && (p->flags & PM_GOVERNOR_STOPS_LPTIMER))) {
+            continue;
+        }
+        if (deadline < _sat_add(p->latency, p->residency)) {
+            continue;
+        }
+        if (p->latency && (deadline != UINT32_MAX)
+            && (_prearm(p->flags, deadline - p->latency) < 0)) {
+            continue;
+        }
+        break;
+    }
+
+    if (mode != lowest) {
+        DEBUG("pm_governor: mode %u -> %u, deadline %" PRIu32 " us\n",
+              lowest, mode, deadline);
+        _stats[lowest].demoted++;
+    }
+
+    _mode = mode;
+    _entered_at = _now();
+
+    return mode;
+}
+
+void pm_governor_exit(unsigned mode)
+{
+    assert(mode < MODES_NUMOF);
+
+    _stats[mode].entries++;
+    _residency[mode] += _now() - _entered_at;
+}
+
+void pm_governor_get_stats(unsigned mode, pm_governor_stats_t *stats)
+{
+    assert(mode < MODES_NUMOF);
+
+    unsigned state = irq_disable();
+    *stats = _stats[mode];
+    stats->residency = _usec(_residency[mode]);
+    irq_restore(state);
+}
+
+void pm_governor_reset_stats(void)
+{
+    unsigned state = irq_disable();
+    memset(_stats, 0, sizeof(_stats));
+    memset(_residency, 0, sizeof(_residency));
+    irq_restore(state);
+}
@@ -22,6 +22,10 @@
 #include "periph/pm.h"
 #include "pm_layered.h"
 
+#ifdef MODULE_PM_GOVERNOR
+#include "pm_governor.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -62,7 +66,14 @@ void pm_set_lowest(void)
     /* set lowest mode if blocker is still the same */
     unsigned state = irq_disable();
     if (blocker.val_u32 == pm_blocker.val_u32) {
+#ifdef MODULE_PM_GOVERNOR
+        /* the governor may pick a lighter mode if a timer is due soon */
+        mode = pm_governor_select(mode);
         pm_set(mode);
+        pm_governor_exit(mode);
+#else
+        pm_set(mode);
+#endif
     }
     
     irq_restore(state);    
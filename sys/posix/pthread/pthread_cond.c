@@ -132,7 +132,7 @@ int pthread_cond_timedwait(pthread_cond_t *cond, mutex_t *mutex, const struct ti
 
     int ret = 0;
     if (then > now) {
-        xtimer_t timer;
+        xtimer_t timer = { 0 };
         priority_queue_node_t n;
 
         _init_cond_wait(cond, &n);
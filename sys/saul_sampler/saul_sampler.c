@@ -0,0 +1,357 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_saul_sampler
+ * @{
+ *
+ * @file
+ * @brief       SAUL sampler implementation
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "lptimer.h"
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "saul_sampler.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define MSG_TYPE_WAKE   (0x5A51)
+
+typedef struct {
+    saul_reg_t *dev;                /* NULL if the slot is unused */
+    saul_sampler_sub_t *subs;
+    uint32_t period;                /* shortest period of the subscribers */
+    uint32_t due;                   /* time of the next read */
+    uint8_t head;                   /* index of the next sample */
+    uint8_t count;
+    saul_sample_t buf[SAUL_SAMPLER_BUFSIZE];
+} _slot_t;
+
+static _slot_t _slots[SAUL_SAMPLER_NUMOF];
+static mutex_t _lock = MUTEX_INIT;
+
+static char _stack[SAUL_SAMPLER_STACKSIZE];
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+static lptimer_t _timer;
+static msg_t _wake = { .type = MSG_TYPE_WAKE };
+
+/* a is before b, also across the wrap around of the ms clock */
+static inline bool _before(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+static _slot_t *_find(const saul_reg_t *dev)
+{
+    for (unsigned i = 0; i < SAUL_SAMPLER_NUMOF; i++) {
+        if (_slots[i].dev == dev) {
+            return &_slots[i];
+        }
+    }
+    return NULL;
+}
+
+/* sub is in the subscriber list of a slot */
+static bool _linked(const saul_sampler_sub_t *sub)
+{
+    for (unsigned i = 0; i < SAUL_SAMPLER_NUMOF; i++) {
+        if (_slots[i].dev == NULL) {
+            continue;
+        }
+        for (saul_sampler_sub_t *tmp = _slots[i].subs; tmp; tmp = tmp->next) {
+            if (tmp == sub) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static const saul_sample_t *_nth(const _slot_t *slot, unsigned age)
+{
+    return &slot->buf[(slot->head + SAUL_SAMPLER_BUFSIZE - 1 - age) %
+                      SAUL_SAMPLER_BUFSIZE];
+}
+
+static void _update_period(_slot_t *slot)
+{
+    slot->period = UINT32_MAX;
+    for (saul_sampler_sub_t *sub = slot->subs; sub; sub = sub->next) {
+        if (sub->period < slot->period) {
+            slot->period = sub->period;
+        }
+    }
+}
+
+static void _store(_slot_t *slot, const phydat_t *data, int dim, uint32_t now)
+{
+    saul_sample_t *sample = &slot->buf[slot->head];
+
+    sample->data = *data;
+    sample->time = now;
+    sample->dim = dim;
+    slot->head = (slot->head + 1) % SAUL_SAMPLER_BUFSIZE;
+    if (slot->count < SAUL_SAMPLER_BUFSIZE) {
+        slot->count++;
+    }
+}
+
+static void _notify(_slot_t *slot, uint32_t now)
+{
+    for (saul_sampler_sub_t *sub = slot->subs; sub; sub = sub->next) {
+        if ((sub->pid == KERNEL_PID_UNDEF) ||
+            _before(now - sub->last + SAUL_SAMPLER_GROUP_MS, sub->period)) {
+            continue;
+        }
+        msg_t msg = {
+            .type = SAUL_SAMPLER_MSG_TYPE,
+            .content.ptr = slot->dev,
+        };
+        /* slow subscribers miss notifications, not samples */
+        msg_try_send(&msg, sub->pid);
+        sub->last = now;
+    }
+}
+
+/* reads everything due, returns the time until the next batch */
+static uint32_t _batch(uint32_t now)
+{
+    uint32_t next = UINT32_MAX;
+
+    for (unsigned i = 0; i < SAUL_SAMPLER_NUMOF; i++) {
+        _slot_t *slot = &_slots[i];
+
+        if ((slot->dev == NULL) ||
+            _before(now + SAUL_SAMPLER_GROUP_MS, slot->due)) {
+            continue;
+        }
+
+        phydat_t data;
+        int dim = saul_reg_read(slot->dev, &data);
+        DEBUG("saul_sampler: read %s: %d\n", slot->dev->name, dim);
+        bool first = (slot->count == 0);
+        _store(slot, &data, dim, now);
+
+        /* keep the phase, unless reads are late */
+        slot->due += slot->period;
+        if (!_before(now, slot->due)) {
+            slot->due = now + slot->period;
+        }
+        if (first) {
+            /* join a device of the same period to share its wake-ups */
+            for (unsigned j = 0; j < SAUL_SAMPLER_NUMOF; j++) {
+                _slot_t *other = &_slots[j];
+                if ((other != slot) && (other->dev != NULL) &&
+                    (other->count > 0) && (other->period == slot->period) &&
+                    _before(now, other->due)) {
+                    slot->due = other->due;
+                    break;
+                }
+            }
+        }
+        _notify(slot, now);
+    }
+
+    for (unsigned i = 0; i < SAUL_SAMPLER_NUMOF; i++) {
+        _slot_t *slot = &_slots[i];
+        if (slot->dev == NULL) {
+            continue;
+        }
+        uint32_t left = _before(now, slot->due) ? (slot->due - now) : 0;
+        if (left < next) {
+            next = left;
+        }
+    }
+    return next;
+}
+
+static void *_thread(void *arg)
+{
+    (void)arg;
+    msg_t msg_queue[4];
+    msg_init_queue(msg_queue, 4);
+
+    while (1) {
+        msg_t msg;
+        msg_receive(&msg);
+        if (msg.type != MSG_TYPE_WAKE) {
+            continue;
+        }
+
+        mutex_lock(&_lock);
+        uint32_t next = _batch(lptimer_now_msec());
+        mutex_unlock(&_lock);
+
+        if (next != UINT32_MAX) {
+            lptimer_set_msg(&_timer, next, &_wake, _pid);
+        }
+        else {
+            lptimer_remove(&_timer);
+        }
+    }
+
+    return NULL;
+}
+
+static void _reschedule(void)
+{
+    if (_pid != KERNEL_PID_UNDEF) {
+        msg_t msg = { .type = MSG_TYPE_WAKE };
+        msg_try_send(&msg, _pid);
+    }
+}
+
+void saul_sampler_init(void)
+{
+    _pid = thread_create(_stack, sizeof(_stack), SAUL_SAMPLER_PRIO,
+                         THREAD_CREATE_STACKTEST, _thread, NULL,
+                         "saul_sampler");
+}
+
+int saul_sampler_subscribe(saul_sampler_sub_t *sub, saul_reg_t *dev,
+                           uint32_t period, kernel_pid_t pid)
+{
+    if (dev == NULL) {
+        return -ENODEV;
+    }
+    if (period == 0) {
+        return -EINVAL;
+    }
+
+    mutex_lock(&_lock);
+    if (_linked(sub)) {
+        mutex_unlock(&_lock);
+        return -EALREADY;
+    }
+    uint32_t now = lptimer_now_msec();
+    _slot_t *slot = _find(dev);
+    if (slot == NULL) {
+        slot = _find(NULL);
+        if (slot == NULL) {
+            mutex_unlock(&_lock);
+            return -ENOMEM;
+        }
+        slot->dev = dev;
+        slot->subs = NULL;
+        slot->head = 0;
+        slot->count = 0;
+        slot->due = now;
+    }
+
+    sub->dev = dev;
+    sub->period = period;
+    sub->pid = pid;
+    sub->last = now - period;
+    sub->next = slot->subs;
+    slot->subs = sub;
+
+    uint32_t old = slot->period;
+    _update_period(slot);
+    if ((slot->count > 0) && (slot->period < old)) {
+        /* a faster subscriber should not wait for the old period */
+        uint32_t due = slot->due - old + slot->period;
+        slot->due = _before(due, now) ? now : due;
+    }
+    mutex_unlock(&_lock);
+
+    _reschedule();
+    return 0;
+}
+
+void saul_sampler_unsubscribe(saul_sampler_sub_t *sub)
+{
+    mutex_lock(&_lock);
+    _slot_t *slot = _find(sub->dev);
+    if (slot == NULL) {
+        mutex_unlock(&_lock);
+        return;
+    }
+
+    for (saul_sampler_sub_t **tmp = &slot->subs; *tmp; tmp = &(*tmp)->next) {
+        if (*tmp == sub) {
+            *tmp = sub->next;
+            break;
+        }
+    }
+    if (slot->subs == NULL) {
+        slot->dev = NULL;
+    }
+    else {
+        _update_period(slot);
+    }
+    mutex_unlock(&_lock);
+
+    _reschedule();
+}
+
+int saul_sampler_latest(const saul_reg_t *dev, saul_sample_t *sample)
+{
+    int res = 0;
+
+    mutex_lock(&_lock);
+    _slot_t *slot = (dev != NULL) ? _find(dev) : NULL;
+    if (slot == NULL) {
+        res = -ENODEV;
+    }
+    else if (slot->count == 0) {
+        res = -ENODATA;
+    }
+    else {
+        *sample = *_nth(slot, 0);
+    }
+    mutex_unlock(&_lock);
+
+    return res;
+}
+
+int saul_sampler_window(const saul_reg_t *dev, saul_sample_t *samples,
+                        unsigned numof, uint32_t max_age)
+{
+    mutex_lock(&_lock);
+    _slot_t *slot = (dev != NULL) ? _find(dev) : NULL;
+    if (slot == NULL) {
+        mutex_unlock(&_lock);
+        return -ENODEV;
+    }
+
+    uint32_t now = lptimer_now_msec();
+    unsigned n = 0;
+    while ((n < numof) && (n < slot->count) &&
+           ((now - _nth(slot, n)->time) <= max_age)) {
+        n++;
+    }
+    for (unsigned i = 0; i < n; i++) {
+        samples[i] = *_nth(slot, n - 1 - i);
+    }
+    mutex_unlock(&_lock);
+
+    return n;
+}
+
+int saul_sampler_read(saul_reg_t *dev, phydat_t *res, uint32_t max_age)
+{
+    saul_sample_t sample;
+
+    if ((saul_sampler_latest(dev, &sample) == 0) &&
+        ((lptimer_now_msec() - sample.time) <= max_age)) {
+        *res = sample.data;
+        return sample.dim;
+    }
+    return saul_reg_read(dev, res);
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command to inspect and flush the DNS cache
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/sock/dns.h"
+
+static void _usage(char *cmd)
+{
+    printf("usage: %s [flush [<name>]]\n", cmd);
+}
+
+int _dns_cache_handler(int argc, char **argv)
+{
+    if (argc < 2) {
+        sock_dns_cache_print();
+        return 0;
+    }
+    if ((strcmp(argv[1], "flush") == 0) && (argc < 4)) {
+        sock_dns_cache_flush((argc == 3) ? argv[2] : NULL);
+        return 0;
+    }
+    _usage(argv[0]);
+    return 1;
+}
@@ -70,6 +70,7 @@ static const struct {
     { "rx_single", NETOPT_SINGLE_RECEIVE },
     { "chan_hop", NETOPT_CHANNEL_HOP },
     { "checksum", NETOPT_CHECKSUM },
+    { "sfr", NETOPT_6LO_SFR },
 };
 
 /* utility functions */
@@ -526,6 +527,10 @@ static void _netif_list(kernel_pid_t iface)
     line_thresh = _netif_list_flag(iface, NETOPT_6LO_IPHC, "IPHC  ",
                                    line_thresh);
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    line_thresh = _netif_list_flag(iface, NETOPT_6LO_SFR, "SFR  ",
+                                   line_thresh);
+#endif
 #endif
     res = gnrc_netapi_get(iface, NETOPT_SRC_LEN, 0, &u16, sizeof(u16));
     if (res >= 0) {
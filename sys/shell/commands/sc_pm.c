@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the idle governor statistics
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "pm_governor.h"
+#include "timex.h"
+
+int _pm_stats_handler(int argc, char **argv)
+{
+    if (argc > 1) {
+        if (strcmp(argv[1], "reset") == 0) {
+            pm_governor_reset_stats();
+            return 0;
+        }
+        printf("usage: %s [reset]\n", argv[0]);
+        return 1;
+    }
+
+    printf("mode   entries   demoted  prearmed  residency [ms]\n");
+    for (unsigned mode = 0; mode <= PM_NUM_MODES; mode++) {
+        pm_governor_stats_t stats;
+
+        pm_governor_get_stats(mode, &stats);
+        printf("%4u %9" PRIu32 " %9" PRIu32 " %9" PRIu32 " %16" PRIu32 "%s\n",
+               mode, stats.entries, stats.demoted, stats.prearmed,
+               (uint32_t)(stats.residency / US_PER_MS),
+               (mode == PM_NUM_MODES) ? " (idle)" : "");
+    }
+
+    return 0;
+}
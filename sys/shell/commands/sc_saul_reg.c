@@ -26,13 +26,22 @@
 
 #include "saul_reg.h"
 
+#ifdef MODULE_SAUL_SAMPLER
+#include "saul_sampler.h"
+#endif
+
 /* this function does not check, if the given device is valid */
 static void probe(int num, saul_reg_t *dev)
 {
     int dim;
     phydat_t res;
 
+#ifdef MODULE_SAUL_SAMPLER
+    /* a recent sample spares the device read */
+    dim = saul_sampler_read(dev, &res, SAUL_SAMPLER_MAX_AGE);
+#else
     dim = saul_reg_read(dev, &res);
+#endif
     if (dim <= 0) {
         printf("error: failed to read from device #%i\n", num);
         return;
@@ -136,6 +145,82 @@ static void write(int argc, char **argv)
     printf("data successfully written to device #%i\n", num);
 }
 
+#ifdef MODULE_SAUL_SAMPLER
+/* subscriptions made from the shell, one per device */
+static saul_sampler_sub_t _subs[SAUL_SAMPLER_NUMOF];
+
+static void dump_samples(int num, saul_reg_t *dev)
+{
+    saul_sample_t samples[SAUL_SAMPLER_BUFSIZE];
+    int n = saul_sampler_window(dev, samples, SAUL_SAMPLER_BUFSIZE,
+                                UINT32_MAX);
+
+    if (n < 0) {
+        printf("error: device #%i is not sampled\n", num);
+        return;
+    }
+    printf("Samples of #%i (%s|%s)\n", num, dev->name,
+           saul_class_to_str(dev->driver->type));
+    for (int i = 0; i < n; i++) {
+        printf("@%lu ms\n", (unsigned long)samples[i].time);
+        if (samples[i].dim <= 0) {
+            puts("error: read failed");
+            continue;
+        }
+        phydat_dump(&samples[i].data, samples[i].dim);
+    }
+}
+
+static void sample(int argc, char **argv)
+{
+    int num;
+    saul_reg_t *dev;
+    saul_sampler_sub_t *sub = NULL;
+
+    if (argc < 3) {
+        printf("usage: %s %s <device id> [<period ms>|0]\n", argv[0], argv[1]);
+        return;
+    }
+    num = atoi(argv[2]);
+    dev = saul_reg_find_nth(num);
+    if (dev == NULL) {
+        puts("error: undefined device id given");
+        return;
+    }
+    if (argc < 4) {
+        dump_samples(num, dev);
+        return;
+    }
+
+    for (unsigned i = 0; i < SAUL_SAMPLER_NUMOF; i++) {
+        if (_subs[i].dev == dev) {
+            sub = &_subs[i];
+            saul_sampler_unsubscribe(sub);
+            sub->dev = NULL;
+            break;
+        }
+        if ((sub == NULL) && (_subs[i].dev == NULL)) {
+            sub = &_subs[i];
+        }
+    }
+
+    uint32_t period = strtoul(argv[3], NULL, 10);
+    if (period == 0) {
+        printf("stopped sampling device #%i\n", num);
+        return;
+    }
+    if ((sub == NULL) ||
+        (saul_sampler_subscribe(sub, dev, period, KERNEL_PID_UNDEF) < 0)) {
+        puts("error: no free sampler slot");
+        if (sub != NULL) {
+            sub->dev = NULL;
+        }
+        return;
+    }
+    printf("sampling device #%i every %lu ms\n", num, (unsigned long)period);
+}
+#endif
+
 int _saul(int argc, char **argv)
 {
     if (argc < 2) {
@@ -148,9 +233,18 @@ int _saul(int argc, char **argv)
         else if (strcmp(argv[1], "write") == 0) {
             write(argc, argv);
         }
+#ifdef MODULE_SAUL_SAMPLER
+        else if (strcmp(argv[1], "sample") == 0) {
+            sample(argc, argv);
+        }
+        else {
+            printf("usage: %s read|write|sample\n", argv[0]);
+        }
+#else
         else {
             printf("usage: %s read|write\n", argv[0]);
         }
+#endif
     }
     return 0;
 }
@@ -37,6 +37,10 @@ extern int _heap_handler(int argc, char **argv);
 extern int _ps_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_PM_GOVERNOR
+extern int _pm_stats_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_SHT1X
 extern int _get_temperature_handler(int argc, char **argv);
 extern int _get_humidity_handler(int argc, char **argv);
@@ -137,6 +141,10 @@ extern int _ccnl_fib(int argc, char **argv);
 extern int _ntpdate(int argc, char **argv);
 #endif
 
+#ifdef MODULE_SOCK_DNS_CACHE
+extern int _dns_cache_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_VFS
 extern int _vfs_handler(int argc, char **argv);
 extern int _ls_handler(int argc, char **argv);
@@ -182,6 +190,9 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_PS
     {"ps", "Prints information about running threads.", _ps_handler},
 #endif
+#ifdef MODULE_PM_GOVERNOR
+    {"pmstat", "Prints or resets per power mode idle statistics.", _pm_stats_handler},
+#endif
 #ifdef MODULE_LTC4150
     {"cur", "Prints current and average power consumption.", _get_current_handler},
     {"rstcur", "Resets coulomb counter.", _reset_current_handler},
@@ -249,6 +260,9 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_SNTP
     { "ntpdate", "synchronizes with a remote time server", _ntpdate },
 #endif
+#ifdef MODULE_SOCK_DNS_CACHE
+    { "dnscache", "shows or flushes the DNS cache", _dns_cache_handler },
+#endif
 #ifdef MODULE_VFS
     {"vfs", "virtual file system operations", _vfs_handler},
     {"ls", "list files", _ls_handler},
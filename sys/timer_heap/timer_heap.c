@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_timer_heap
+ * @{
+ *
+ * @file
+ * @brief       Pairing heap implementation
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "timer_heap.h"
+
+static inline void _detach(timer_heap_node_t *node)
+{
+    node->child = NULL;
+    node->next = NULL;
+    node->prev = NULL;
+    node->heap = NULL;
+}
+
+/**
+ * @brief   link two single trees, the later root becomes the leftmost child
+ *          of the earlier one
+ *
+ * Both @p a and @p b must have no siblings.
+ */
+static timer_heap_node_t *_meld(timer_heap_before_t before,
+                                timer_heap_node_t *a, timer_heap_node_t *b)
+{
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+
+    if (before(b, a)) {
+        timer_heap_node_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+
+    return a;
+}
+
+/**
+ * @brief   standard two-pass merge of a sibling list into a single tree
+ */
+static timer_heap_node_t *_merge_pairs(timer_heap_before_t before,
+                                       timer_heap_node_t *first)
+{
+    timer_heap_node_t *pairs = NULL;
+
+    /* first pass: meld pairs left to right, stack the results */
+    while (first) {
+        timer_heap_node_t *a = first;
+        timer_heap_node_t *b = a->next;
+
+        first = b ? b->next : NULL;
+
+        a->next = a->prev = NULL;
+        if (b) {
+            b->next = b->prev = NULL;
+        }
+
+        a = _meld(before, a, b);
+        a->next = pairs;
+        pairs = a;
+    }
+
+    if (!pairs) {
+        return NULL;
+    }
+
+    /* second pass: meld the stacked trees right to left */
+    timer_heap_node_t *result = pairs;
+    pairs = pairs->next;
+    result->next = NULL;
+
+    while (pairs) {
+        timer_heap_node_t *tree = pairs;
+        pairs = pairs->next;
+        tree->next = NULL;
+        result = _meld(before, result, tree);
+    }
+
+    return result;
+}
+
+void timer_heap_insert(timer_heap_t *heap, timer_heap_node_t *node)
+{
+    assert(heap && node);
+
+    node->child = NULL;
+    node->next = NULL;
+    node->prev = NULL;
+    node->heap = heap;
+
+    heap->root = _meld(heap->before, heap->root, node);
+}
+
+timer_heap_node_t *timer_heap_pop(timer_heap_t *heap)
+{
+    assert(heap);
+
+    timer_heap_node_t *root = heap->root;
+
+    if (root) {
+        heap->root = _merge_pairs(heap->before, root->child);
+        _detach(root);
+    }
+
+    return root;
+}
+
+void timer_heap_remove(timer_heap_node_t *node)
+{
+    assert(node && node->heap);
+
+    timer_heap_t *heap = node->heap;
+
+    if (heap->root == node) {
+        timer_heap_pop(heap);
+        return;
+    }
+
+    timer_heap_node_t *prev = node->prev;
+    timer_heap_node_t *next = node->next;
+
+    /* the merged subtree is not earlier than node, hence not earlier than
+     * node's parent, so it can take node's place without restoring order
+     * anywhere else */
+    timer_heap_node_t *subtree = _merge_pairs(heap->before, node->child);
+
+    if (subtree) {
+        subtree->prev = prev;
+        subtree->next = next;
+        if (next) {
+            next->prev = subtree;
+        }
+    }
+    else {
+        subtree = next;
+        if (next) {
+            next->prev = prev;
+        }
+    }
+
+    if (prev->child == node) {
+        prev->child = subtree;
+    }
+    else {
+        prev->next = subtree;
+    }
+
+    _detach(node);
+}
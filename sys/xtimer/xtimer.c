@@ -58,7 +58,7 @@ void _xtimer_tsleep(uint32_t offset, uint32_t long_offset)
         return;
     }
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     mutex_t mutex = MUTEX_INIT;
 
     timer.callback = _callback_unlock_mutex;
@@ -71,7 +71,7 @@ void _xtimer_tsleep(uint32_t offset, uint32_t long_offset)
 }
 
 void _xtimer_periodic_wakeup(uint32_t *last_wakeup, uint32_t period) {
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     mutex_t mutex = MUTEX_INIT;
 
     timer.callback = _callback_unlock_mutex;
@@ -218,7 +218,7 @@ static int _msg_wait(msg_t *m, msg_t *tmsg, xtimer_t *t)
 
 int _xtimer_msg_receive_timeout64(msg_t *m, uint64_t timeout_ticks) {
     msg_t tmsg;
-    xtimer_t t;
+    xtimer_t t = { 0 };
     _setup_timer_msg(&tmsg, &t);
     _xtimer_set_msg64(&t, timeout_ticks, &tmsg, sched_active_pid);
     return _msg_wait(m, &tmsg, &t);
@@ -227,7 +227,7 @@ int _xtimer_msg_receive_timeout64(msg_t *m, uint64_t timeout_ticks) {
 int _xtimer_msg_receive_timeout(msg_t *msg, uint32_t timeout_ticks)
 {
     msg_t tmsg;
-    xtimer_t t;
+    xtimer_t t = { 0 };
     _setup_timer_msg(&tmsg, &t);
     _xtimer_set_msg(&t, timeout_ticks, &tmsg, sched_active_pid);
     return _msg_wait(msg, &tmsg, &t);
@@ -265,7 +265,7 @@ static void _mutex_timeout(void *arg)
 
 int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t timeout)
 {
-    xtimer_t t;
+    xtimer_t t = { 0 };
     mutex_thread_t mt = { mutex, (thread_t *)sched_active_thread, 0 };
 
     if (timeout != 0) {
@@ -20,6 +20,7 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdint.h>
 #include <string.h>
 #include "board.h"
@@ -28,6 +29,7 @@
 
 #include "xtimer.h"
 #include "irq.h"
+#include "timer_heap.h"
 
 /* WARNING! enabling this will have side effects and can lead to timer underflows. */
 #define ENABLE_DEBUG 0
@@ -42,12 +44,21 @@ volatile uint32_t _xtimer_high_cnt = 0;
 
 static inline void xtimer_spin_until(uint32_t value);
 
-static xtimer_t *timer_list_head = NULL;
-static xtimer_t *overflow_list_head = NULL;
-static xtimer_t *long_list_head = NULL;
+static int _before(const timer_heap_node_t *a, const timer_heap_node_t *b);
+static int _before_long(const timer_heap_node_t *a, const timer_heap_node_t *b);
+
+/* timers of the current and of the next short timer period. The two heaps
+ * swap roles on each period, so nodes never need to be re-tagged */
+static timer_heap_t _period_heaps[2] = {
+    TIMER_HEAP_INIT(_before),
+    TIMER_HEAP_INIT(_before),
+};
+static timer_heap_t *timer_heap = &_period_heaps[0];
+static timer_heap_t *overflow_heap = &_period_heaps[1];
+static timer_heap_t long_heap = TIMER_HEAP_INIT(_before_long);
+/* timers that were still due when their period ended */
+static timer_heap_t late_heap = TIMER_HEAP_INIT(_before);
 
-static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer);
-static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer);
 static void _shoot(xtimer_t *timer);
 static void _remove(xtimer_t *timer);
 static inline void _lltimer_set(uint32_t target);
@@ -60,7 +71,37 @@ static inline int _this_high_period(uint32_t target);
 
 static inline int _is_set(xtimer_t *timer)
 {
-    return (timer->target || timer->long_target);
+    /* zeroed, fired and removed timers are in no heap. Membership is read
+     * from the caller's timer, which is why timers must be zero-initialized
+     * before their first use: stale stack contents could name a heap here. */
+    timer_heap_t *heap = timer->node.heap;
+    int set = (heap == &_period_heaps[0]) || (heap == &_period_heaps[1])
+              || (heap == &long_heap) || (heap == &late_heap);
+
+    /* every node in a heap is either its root or linked to a neighbour */
+    assert(!set || (heap->root == &timer->node) || timer->node.prev);
+    return set;
+}
+
+static inline xtimer_t *_first(timer_heap_t *heap)
+{
+    timer_heap_node_t *node = timer_heap_peek(heap);
+    return node ? container_of(node, xtimer_t, node) : NULL;
+}
+
+static int _before(const timer_heap_node_t *a, const timer_heap_node_t *b)
+{
+    return container_of(a, xtimer_t, node)->target
+           < container_of(b, xtimer_t, node)->target;
+}
+
+static int _before_long(const timer_heap_node_t *a, const timer_heap_node_t *b)
+{
+    const xtimer_t *ta = container_of(a, xtimer_t, node);
+    const xtimer_t *tb = container_of(b, xtimer_t, node);
+
+    return (ta->long_target < tb->long_target)
+           || ((ta->long_target == tb->long_target) && (ta->target < tb->target));
 }
 
 static inline void xtimer_spin_until(uint32_t target)
@@ -126,7 +167,7 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
             timer->long_target++;
         }
 
-        _add_timer_to_long_list(&long_list_head, timer);
+        timer_heap_insert(&long_heap, &timer->node);
         irq_restore(state);
         DEBUG("xtimer_set64(): added longterm timer (long_target=%" PRIu32 " target=%" PRIu32 ")\n",
               timer->long_target, timer->target);
@@ -180,8 +221,6 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
     uint32_t now = _xtimer_now();
     int res = 0;
 
-    timer->next = NULL;
-
     /* Ensure that offset is bigger than 'XTIMER_BACKOFF',
      * 'target - now' will allways be the offset no matter if target < or > now.
      *
@@ -229,19 +268,19 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
 
     if ((timer->long_target > _long_cnt) || !_this_high_period(target)) {
         DEBUG("xtimer_set_absolute(): the timer doesn't fit into the low-level timer's mask.\n");
-        _add_timer_to_long_list(&long_list_head, timer);
+        timer_heap_insert(&long_heap, &timer->node);
     }
     else {
         if (_xtimer_lltimer_mask(now) >= target) {
             DEBUG("xtimer_set_absolute(): the timer will expire in the next timer period\n");
-            _add_timer_to_list(&overflow_list_head, timer);
+            timer_heap_insert(overflow_heap, &timer->node);
         }
         else {
             DEBUG("timer_set_absolute(): timer will expire in this timer period.\n");
-            _add_timer_to_list(&timer_list_head, timer);
+            timer_heap_insert(timer_heap, &timer->node);
 
-            if (timer_list_head == timer) {
-                DEBUG("timer_set_absolute(): timer is new list head. updating lltimer.\n");
+            if (_first(timer_heap) == timer) {
+                DEBUG("timer_set_absolute(): timer is new heap root. updating lltimer.\n");
                 _lltimer_set(target);
             }
         }
@@ -252,49 +291,14 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
     return res;
 }
 
-static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
-{
-    while (*list_head && (*list_head)->target <= timer->target) {
-        list_head = &((*list_head)->next);
-    }
-
-    timer->next = *list_head;
-    *list_head = timer;
-}
-
-static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer)
-{
-    while (*list_head
-           && (((*list_head)->long_target < timer->long_target)
-           || (((*list_head)->long_target == timer->long_target) && ((*list_head)->target <= timer->target)))) {
-        list_head = &((*list_head)->next);
-    }
-
-    timer->next = *list_head;
-    *list_head = timer;
-}
-
-static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
-{
-    while (*list_head) {
-        if (*list_head == timer) {
-            *list_head = timer->next;
-            return 1;
-        }
-        list_head = &((*list_head)->next);
-    }
-
-    return 0;
-}
-
 static void _remove(xtimer_t *timer)
 {
-    if (timer_list_head == timer) {
+    if (_first(timer_heap) == timer) {
         uint32_t next;
-        timer_list_head = timer->next;
-        if (timer_list_head) {
+        timer_heap_pop(timer_heap);
+        if (_first(timer_heap)) {
             /* schedule callback on next timer target time */
-            next = timer_list_head->target - XTIMER_OVERHEAD;
+            next = _first(timer_heap)->target - XTIMER_OVERHEAD;
         }
         else {
             next = _xtimer_lltimer_mask(0xFFFFFFFF);
@@ -302,11 +306,7 @@ static void _remove(xtimer_t *timer)
         _lltimer_set(next);
     }
     else {
-        if (!_remove_timer_from_list(&timer_list_head, timer)) {
-            if (!_remove_timer_from_list(&overflow_list_head, timer)) {
-                _remove_timer_from_list(&long_list_head, timer);
-            }
-        }
+        timer_heap_remove(&timer->node);
     }
 }
 
@@ -320,6 +320,29 @@ void xtimer_remove(xtimer_t *timer)
     irq_restore(state);
 }
 
+int xtimer_next_deadline(xtimer_ticks32_t *ticks)
+{
+    int res = 1;
+    unsigned state = irq_disable();
+    xtimer_t *first = _first(timer_heap);
+
+    if (first) {
+        int32_t left = (int32_t)(first->target - _xtimer_now());
+        ticks->ticks32 = (left > 0) ? (uint32_t)left : 0;
+    }
+    else if (timer_heap_peek(overflow_heap) || timer_heap_peek(&long_heap)) {
+        /* nothing due in this period, the next event is the period end */
+        ticks->ticks32 = _xtimer_lltimer_mask(0xFFFFFFFF) - _xtimer_lltimer_now();
+    }
+    else {
+        res = 0;
+    }
+
+    irq_restore(state);
+
+    return res;
+}
+
 static uint32_t _time_left(uint32_t target, uint32_t reference)
 {
     uint32_t now = _xtimer_lltimer_now();
@@ -347,92 +370,18 @@ static inline int _this_high_period(uint32_t target)
 }
 
 /**
- * @brief compare two timers' target values, return the one with lower value.
- *
- * if either is NULL, return the other.
- * if both are NULL, return NULL.
- */
-static inline xtimer_t *_compare(xtimer_t *a, xtimer_t *b)
-{
-    if (a && b) {
-        return ((a->target <= b->target) ? a : b);
-    }
-    else {
-        return (a ? a : b);
-    }
-}
-
-/**
- * @brief merge two timer lists, return head of new list
- */
-static xtimer_t *_merge_lists(xtimer_t *head_a, xtimer_t *head_b)
-{
-    xtimer_t *result_head = _compare(head_a, head_b);
-    xtimer_t *pos = result_head;
-
-    while (1) {
-        head_a = head_a->next;
-        head_b = head_b->next;
-        if (!head_a) {
-            pos->next = head_b;
-            break;
-        }
-        if (!head_b) {
-            pos->next = head_a;
-            break;
-        }
-
-        pos->next = _compare(head_a, head_b);
-        pos = pos->next;
-    }
-
-    return result_head;
-}
-
-/**
- * @brief parse long timers list and copy those that will expire in the current
- *        short timer period
+ * @brief move the long timers that will expire in the current short timer
+ *        period to the current timer heap
  */
 static void _select_long_timers(void)
 {
-    xtimer_t *select_list_start = long_list_head;
-    xtimer_t *select_list_last = NULL;
-
-    /* advance long_list head so it points to the first timer of the next (not
-     * just started) "long timer period" */
-    while (long_list_head) {
-        if ((long_list_head->long_target <= _long_cnt) && _this_high_period(long_list_head->target)) {
-            select_list_last = long_list_head;
-            long_list_head = long_list_head->next;
-        }
-        else {
-            /* remaining long_list timers belong to later long periods */
-            break;
-        }
-    }
-
-    /* cut the "selected long timer list" at the end */
-    if (select_list_last) {
-        select_list_last->next = NULL;
-    }
+    xtimer_t *timer;
 
-    /* merge "current timer list" and "selected long timer list" */
-    if (timer_list_head) {
-        if (select_list_last) {
-            /* both lists are non-empty. merge. */
-            timer_list_head = _merge_lists(timer_list_head, select_list_start);
-        }
-        else {
-            /* "selected long timer list" is empty, nothing to do */
-        }
-    }
-    else { /* current timer list is empty */
-        if (select_list_last) {
-            /* there's no current timer list, but a non-empty "selected long
-             * timer list".  So just use that list as the new current timer
-             * list.*/
-            timer_list_head = select_list_start;
-        }
+    while ((timer = _first(&long_heap))
+           && (timer->long_target <= _long_cnt)
+           && _this_high_period(timer->target)) {
+        timer_heap_pop(&long_heap);
+        timer_heap_insert(timer_heap, &timer->node);
     }
 }
 
@@ -441,6 +390,16 @@ static void _select_long_timers(void)
  */
 static void _next_period(void)
 {
+    xtimer_t *timer;
+
+    /* timers left in the ending period are late. Take them out before the
+     * heap becomes the next period's overflow heap, where they would only
+     * fire a full period later */
+    while ((timer = _first(timer_heap))) {
+        timer_heap_pop(timer_heap);
+        timer_heap_insert(&late_heap, &timer->node);
+    }
+
 #if XTIMER_MASK
     /* advance <32bit mask register */
     _xtimer_high_cnt += ~XTIMER_MASK + 1;
@@ -453,11 +412,21 @@ static void _next_period(void)
     _long_cnt++;
 #endif
 
-    /* swap overflow list to current timer list */
-    timer_list_head = overflow_list_head;
-    overflow_list_head = NULL;
+    /* the current heap becomes the next period's overflow heap */
+    timer_heap_t *tmp = timer_heap;
+    timer_heap = overflow_heap;
+    overflow_heap = tmp;
 
     _select_long_timers();
+
+    /* fire the late timers only now, so timers set by their callbacks go to
+     * the heaps of the new period */
+    while ((timer = _first(&late_heap))) {
+        timer_heap_pop(&late_heap);
+        timer->target = 0;
+        timer->long_target = 0;
+        _shoot(timer);
+    }
 }
 
 /**
@@ -474,7 +443,7 @@ static void _timer_callback(void)
           xtimer_now().ticks32, _xtimer_lltimer_mask(xtimer_now().ticks32),
           _xtimer_lltimer_mask(0xffffffff - xtimer_now().ticks32));
 
-    if (!timer_list_head) {
+    if (!_first(timer_heap)) {
         DEBUG("_timer_callback(): tick\n");
         /* there's no timer for this timer period,
          * so this was a timer overflow callback.
@@ -499,15 +468,13 @@ static void _timer_callback(void)
 
 overflow:
     /* check if next timers are close to expiring */
-    while (timer_list_head && (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference) < XTIMER_ISR_BACKOFF)) {
+    while (_first(timer_heap) && (_time_left(_xtimer_lltimer_mask(_first(timer_heap)->target), reference) < XTIMER_ISR_BACKOFF)) {
         /* make sure we don't fire too early */
-        while (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference)) {}
-
-        /* pick first timer in list */
-        xtimer_t *timer = timer_list_head;
+        while (_time_left(_xtimer_lltimer_mask(_first(timer_heap)->target), reference)) {}
 
-        /* advance list */
-        timer_list_head = timer->next;
+        /* pick first timer in heap */
+        xtimer_t *timer = _first(timer_heap);
+        timer_heap_pop(timer_heap);
 
         /* make sure timer is recognized as being already fired */
         timer->target = 0;
@@ -525,7 +492,7 @@ overflow:
     uint32_t now = _xtimer_lltimer_now() + XTIMER_ISR_BACKOFF;
     if (now < reference) {
         DEBUG("_timer_callback: overflowed while executing callbacks. %i\n",
-              timer_list_head != NULL);
+              _first(timer_heap) != NULL);
         _next_period();
         /* wait till overflow */
         while( reference < _xtimer_lltimer_now()){}
@@ -533,9 +500,9 @@ overflow:
         goto overflow;
     }
 
-    if (timer_list_head) {
+    if (_first(timer_heap)) {
         /* schedule callback on next timer target time */
-        next_target = timer_list_head->target - XTIMER_OVERHEAD;
+        next_target = _first(timer_heap)->target - XTIMER_OVERHEAD;
 
         /* make sure we're not setting a time in the past */
         if (next_target < (_xtimer_now() + XTIMER_ISR_BACKOFF)) {
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the FIB longest prefix match lookup time
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "net/fib.h"
+#include "xtimer.h"
+
+#ifndef TEST_ROUTES
+#define TEST_ROUTES         (256U)
+#endif
+
+#ifndef TEST_RUNS
+#define TEST_RUNS           (10000UL)
+#endif
+
+static fib_entry_t _entries[TEST_ROUTES + 1];
+static fib_table_t _table = { .data.entries = _entries,
+                              .table_type = FIB_TABLE_TYPE_SH,
+                              .size = TEST_ROUTES + 1,
+                              .mtx_access = MUTEX_INIT,
+                              .notify_rp_pos = 0 };
+
+static unsigned _route;
+
+/* the n-th route is a /40 if n is even and a /48 if odd below 2001:db8::/32,
+ * with @p host set, an address within it is built instead */
+static uint32_t _route_addr(unsigned n, uint8_t *addr, bool host)
+{
+    memset(addr, 0, 16);
+    addr[0] = 0x20;
+    addr[1] = 0x01;
+    addr[2] = 0x0d;
+    addr[3] = 0xb8;
+    addr[4] = (uint8_t)n;
+    addr[5] = (n & 1) ? (uint8_t)(n >> 8) + 1 : 0;
+    if (host) {
+        addr[5] = (n & 1) ? addr[5] : 0x42;
+        addr[15] = 0x01;
+    }
+    return (n & 1) ? 48 : 40;
+}
+
+static int _lookup(void)
+{
+    uint8_t addr_lookup[16];
+    uint8_t addr_nxt[16];
+    size_t addr_nxt_size = sizeof(addr_nxt);
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t flags = 0;
+
+    _route_addr(_route, addr_lookup, true);
+    if (++_route == TEST_ROUTES) {
+        _route = 0;
+    }
+    return fib_get_next_hop(&_table, &iface_id, addr_nxt, &addr_nxt_size,
+                            &flags, addr_lookup, sizeof(addr_lookup), 0);
+}
+
+int main(void)
+{
+    uint8_t addr_dst[16];
+    uint8_t addr_nxt[16];
+
+    puts("fib lpm benchmark");
+
+    fib_init(&_table);
+    memset(addr_nxt, 0, sizeof(addr_nxt));
+    addr_nxt[0] = 0xfe;
+    addr_nxt[1] = 0x80;
+    addr_nxt[15] = 0x01;
+
+    /* the default route, ::/0 */
+    memset(addr_dst, 0, sizeof(addr_dst));
+    if (fib_add_entry(&_table, 42, addr_dst, sizeof(addr_dst), 0x0,
+                      addr_nxt, sizeof(addr_nxt), 0,
+                      (uint32_t)FIB_LIFETIME_NO_EXPIRE) != 0) {
+        puts("[FAILED] adding the default route");
+        return 1;
+    }
+    for (unsigned n = 0; n < TEST_ROUTES; n++) {
+        uint32_t prefix_len = _route_addr(n, addr_dst, false);
+        if (fib_add_entry(&_table, 42, addr_dst, sizeof(addr_dst),
+                          (prefix_len << FIB_FLAG_NET_PREFIX_SHIFT),
+                          addr_nxt, sizeof(addr_nxt), 0,
+                          (uint32_t)FIB_LIFETIME_NO_EXPIRE) != 0) {
+            printf("[FAILED] adding route %u\n", n);
+            return 1;
+        }
+    }
+
+    BENCHMARK_FUNC("fib_get_next_hop", TEST_RUNS, _lookup());
+
+    fib_deinit(&_table);
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,20 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("fib lpm benchmark")
+    child.expect(r"fib_get_next_hop:\s+\d+us\s+---\s+\d+\.\d+us per call")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -23,13 +23,21 @@
 
 #include "msg.h"
 #include "xtimer.h"
+#include "benchmark.h"
 
 #ifndef TEST_DURATION
 #define TEST_DURATION       (1000000U)
 #endif
 
+#ifndef TEST_BURST
+#define TEST_BURST          (8U)
+#endif
+
 volatile unsigned _flag = 0;
 static char _stack[THREAD_STACKSIZE_MAIN];
+static char _burst_stack[THREAD_STACKSIZE_MAIN];
+static char _bulk_stack[THREAD_STACKSIZE_MAIN];
+static msg_t msgs[TEST_BURST];
 
 static void _timer_callback(void*arg)
 {
@@ -50,6 +58,42 @@ static void *_second_thread(void *arg)
     return NULL;
 }
 
+/* receives bursts through a message queue, one message per call */
+static void *_burst_thread(void *arg)
+{
+    (void)arg;
+    msg_t queue[TEST_BURST];
+    msg_t test;
+
+    msg_init_queue(queue, TEST_BURST);
+    while(1) {
+        msg_receive(&test);
+    }
+
+    return NULL;
+}
+
+/* receives bursts through a message queue, draining it at once */
+static void *_bulk_thread(void *arg)
+{
+    (void)arg;
+    msg_t queue[TEST_BURST];
+    msg_t test[TEST_BURST];
+
+    msg_init_queue(queue, TEST_BURST);
+    while(1) {
+        msg_receive_bulk(test, TEST_BURST);
+    }
+
+    return NULL;
+}
+
+static kernel_pid_t _create(char *stack, thread_task_func_t func, const char *name)
+{
+    return thread_create(stack, THREAD_STACKSIZE_MAIN, (THREAD_PRIORITY_MAIN - 1),
+                         THREAD_CREATE_STACKTEST, func, NULL, name);
+}
+
 int main(void)
 {
     printf("main starting\n");
@@ -62,7 +106,7 @@ int main(void)
                                        NULL,
                                        "second_thread");
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     timer.callback = _timer_callback;
 
     msg_t test;
@@ -75,7 +119,41 @@ int main(void)
         n++;
     }
 
-    printf("{ \"result\" : %"PRIu32" }\n", n);
+    benchmark_print_value("msg pingpong",
+                          (uint32_t)(((uint64_t)n * US_PER_SEC) / TEST_DURATION),
+                          "ops/s");
+
+    /* bursts of TEST_BURST messages, sent and received one by one */
+    kernel_pid_t burst = _create(_burst_stack, _burst_thread, "burst_thread");
+
+    n = 0;
+    _flag = 0;
+    xtimer_set(&timer, TEST_DURATION);
+    while(!_flag) {
+        for (unsigned i = 0; i < TEST_BURST; i++) {
+            msg_send(&msgs[i], burst);
+        }
+        n += TEST_BURST;
+    }
+
+    benchmark_print_value("msg burst",
+                          (uint32_t)(((uint64_t)n * US_PER_SEC) / TEST_DURATION),
+                          "ops/s");
+
+    /* the same bursts with msg_send_bulk() and msg_receive_bulk() */
+    kernel_pid_t bulk = _create(_bulk_stack, _bulk_thread, "bulk_thread");
+
+    n = 0;
+    _flag = 0;
+    xtimer_set(&timer, TEST_DURATION);
+    while(!_flag) {
+        msg_send_bulk(msgs, TEST_BURST, bulk);
+        n += TEST_BURST;
+    }
+
+    benchmark_print_value("msg burst bulk",
+                          (uint32_t)(((uint64_t)n * US_PER_SEC) / TEST_DURATION),
+                          "ops/s");
 
     return 0;
 }
@@ -12,7 +12,9 @@ from testrunner import run
 
 
 def testfunc(child):
-    child.expect(r"{ \"result\" : \d+ }")
+    child.expect(r"msg pingpong:\s+\d+ ops/s")
+    child.expect(r"msg burst:\s+\d+ ops/s")
+    child.expect(r"msg burst bulk:\s+\d+ ops/s")
 
 
 if __name__ == "__main__":
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares littlefs on MTD_0 with and without mtd_cache
+ *
+ * The same file system workload runs twice, once directly on MTD_0 and once
+ * through the cache. The operations reaching MTD_0 are counted by a
+ * pass-through mtd device.
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+#include "fs/littlefs_fs.h"
+#include "mtd.h"
+#include "mtd_cache.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#define FILES_NUMOF     (8U)
+#define APPENDS_NUMOF   (16U)
+#define READS_NUMOF     (4U)
+
+typedef struct {
+    mtd_dev_t base;
+    mtd_dev_t *dev;
+    unsigned reads;
+    unsigned writes;
+    unsigned erases;
+} counting_mtd_t;
+
+static int _cnt_init(mtd_dev_t *dev)
+{
+    counting_mtd_t *cnt = (counting_mtd_t *)dev;
+
+    int res = mtd_init(cnt->dev);
+    dev->sector_count = cnt->dev->sector_count;
+    dev->pages_per_sector = cnt->dev->pages_per_sector;
+    dev->page_size = cnt->dev->page_size;
+    return res;
+}
+
+static int _cnt_read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    counting_mtd_t *cnt = (counting_mtd_t *)dev;
+
+    cnt->reads++;
+    return mtd_read(cnt->dev, buff, addr, size);
+}
+
+static int _cnt_write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                      uint32_t size)
+{
+    counting_mtd_t *cnt = (counting_mtd_t *)dev;
+
+    cnt->writes++;
+    return mtd_write(cnt->dev, buff, addr, size);
+}
+
+static int _cnt_erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    counting_mtd_t *cnt = (counting_mtd_t *)dev;
+
+    cnt->erases++;
+    return mtd_erase(cnt->dev, addr, size);
+}
+
+static const mtd_desc_t _cnt_driver = {
+    .init = _cnt_init,
+    .read = _cnt_read,
+    .write = _cnt_write,
+    .erase = _cnt_erase,
+};
+
+static counting_mtd_t _cnt = { .base = { .driver = &_cnt_driver } };
+static uint8_t _cache_buf[MTD_CACHE_PAGES * MTD_PAGE_SIZE];
+static mtd_cache_t _cache;
+
+static littlefs_desc_t _fs_desc;
+static vfs_mount_t _mount = {
+    .fs = &littlefs_file_system,
+    .mount_point = "/bench",
+    .private_data = &_fs_desc,
+};
+
+static int _workload(void)
+{
+    char path[24];
+    char line[32];
+
+    /* small appends, as done by loggers */
+    for (unsigned i = 0; i < APPENDS_NUMOF; i++) {
+        for (unsigned f = 0; f < FILES_NUMOF; f++) {
+            snprintf(path, sizeof(path), "/bench/log%u", f);
+            int fd = vfs_open(path, O_CREAT | O_WRONLY | O_APPEND, 0);
+            if (fd < 0) {
+                return fd;
+            }
+            int len = snprintf(line, sizeof(line), "entry %u of file %u\n", i, f);
+            vfs_write(fd, line, len);
+            vfs_close(fd);
+        }
+    }
+
+    /* repeated lookups of the same metadata */
+    for (unsigned i = 0; i < READS_NUMOF; i++) {
+        for (unsigned f = 0; f < FILES_NUMOF; f++) {
+            struct stat st;
+            snprintf(path, sizeof(path), "/bench/log%u", f);
+            int fd = vfs_open(path, O_RDONLY, 0);
+            if (fd < 0) {
+                return fd;
+            }
+            while (vfs_read(fd, line, sizeof(line)) > 0) {}
+            vfs_close(fd);
+            vfs_stat(path, &st);
+        }
+    }
+    return 0;
+}
+
+static int _run(const char *name, mtd_dev_t *dev)
+{
+    _fs_desc.dev = dev;
+    _cnt.reads = 0;
+    _cnt.writes = 0;
+    _cnt.erases = 0;
+
+    uint32_t start = xtimer_now_usec();
+    int res = vfs_format(&_mount);
+    if (res == 0) {
+        res = vfs_mount(&_mount);
+    }
+    if (res == 0) {
+        res = _workload();
+        int umount_res = vfs_umount(&_mount);
+        if (res == 0) {
+            res = umount_res;
+        }
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+
+    if (res < 0) {
+        printf("%s: failed with %d\n", name, res);
+        return res;
+    }
+    printf("%-8s %8" PRIu32 " us, device reads: %u, writes: %u, erases: %u\n",
+           name, duration, _cnt.reads, _cnt.writes, _cnt.erases);
+    return 0;
+}
+
+int main(void)
+{
+    _cnt.dev = MTD_0;
+    mtd_cache_setup(&_cache, &_cnt.base, _cache_buf);
+
+    if ((_run("direct", &_cnt.base) < 0) ||
+        (_run("cached", &_cache.base) < 0)) {
+        puts("FAILED");
+        return 1;
+    }
+
+    printf("cache hits: %" PRIu32 ", misses: %" PRIu32 ", write backs: %" PRIu32 "\n",
+           _cache.stats.hits, _cache.stats.misses, _cache.stats.writebacks);
+    puts("SUCCESS");
+    return 0;
+}
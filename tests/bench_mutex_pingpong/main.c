@@ -23,6 +23,7 @@
 #include "mutex.h"
 #include "thread.h"
 #include "xtimer.h"
+#include "benchmark.h"
 
 #ifndef TEST_DURATION
 #define TEST_DURATION       (1000000U)
@@ -67,7 +68,7 @@ int main(void)
     mutex_lock(&_mutex);
     thread_yield_higher();
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     timer.callback = _timer_callback;
 
     uint32_t n = 0;
@@ -78,7 +79,9 @@ int main(void)
         n++;
     }
 
-    printf("{ \"result\" : %"PRIu32" }\n", n);
+    benchmark_print_value("mutex pingpong",
+                          (uint32_t)(((uint64_t)n * US_PER_SEC) / TEST_DURATION),
+                          "ops/s");
 
     return 0;
 }
@@ -28,11 +28,15 @@
 #ifndef BENCH_RUNS
 #define BENCH_RUNS          (1000UL * 1000UL)
 #endif
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES       (256U)
+#endif
 
 static mutex_t _lock;
 static thread_t *t;
 static thread_flags_t _flag = 0x0001;
 static msg_t _msg;
+static uint32_t _samples[BENCH_SAMPLES];
 
 static void _mutex_lockunlock(void)
 {
@@ -77,6 +81,10 @@ int main(void)
     puts("");
     BENCHMARK_FUNC("msg_try_receive()", BENCH_RUNS, msg_try_receive(&_msg));
     BENCHMARK_FUNC("msg_avail()", BENCH_RUNS, msg_avail());
+    puts("");
+    BENCHMARK_SAMPLES("mutex lock/unlock", _samples, BENCH_SAMPLES, _mutex_lockunlock());
+    BENCHMARK_SAMPLES("thread flags set/wait any", _samples, BENCH_SAMPLES, _flag_waitany());
+    BENCHMARK_SAMPLES("msg_try_receive()", _samples, BENCH_SAMPLES, msg_try_receive(&_msg));
 
     puts("\n[SUCCESS]");
     return 0;
@@ -13,6 +13,7 @@ from testrunner import run
 # The default timeout is not enough for this test on some of the slower boards
 TIMEOUT = 30
 BENCHMARK_REGEXP = r"\s+{func}:\s+\d+us\s+---\s+\d*\.*\d+us per call\s+---\s+\d+ calls per sec"
+SAMPLES_REGEXP = r"\s+{func}:\s+min\s+\d+\s+median\s+\d+\s+p99\s+\d+\s+max\s+\d+\s+mean\s+\d+ \w+"
 
 
 def testfunc(child):
@@ -26,6 +27,9 @@ def testfunc(child):
     child.expect(BENCHMARK_REGEXP.format(func="thread flags set/wait one"), timeout=TIMEOUT)
     child.expect(BENCHMARK_REGEXP.format(func=r"msg_try_receive\(\)"))
     child.expect(BENCHMARK_REGEXP.format(func=r"msg_avail\(\)"))
+    child.expect(SAMPLES_REGEXP.format(func="mutex lock/unlock"))
+    child.expect(SAMPLES_REGEXP.format(func="thread flags set/wait any"))
+    child.expect(SAMPLES_REGEXP.format(func=r"msg_try_receive\(\)"))
     child.expect_exact('[SUCCESS]')
 
 
@@ -22,6 +22,7 @@
 #include "thread.h"
 
 #include "xtimer.h"
+#include "benchmark.h"
 
 #ifndef TEST_DURATION
 #define TEST_DURATION       (1000000U)
@@ -40,7 +41,7 @@ int main(void)
 {
     printf("main starting\n");
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     timer.callback = _timer_callback;
 
     uint32_t n = 0;
@@ -51,7 +52,9 @@ int main(void)
         n++;
     }
 
-    printf("{ \"result\" : %"PRIu32" }\n", n);
+    benchmark_print_value("sched nop",
+                          (uint32_t)(((uint64_t)n * US_PER_SEC) / TEST_DURATION),
+                          "ops/s");
 
     return 0;
 }
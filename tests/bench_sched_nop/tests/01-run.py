@@ -12,7 +12,7 @@ from testrunner import run
 
 
 def testfunc(child):
-    child.expect(r"{ \"result\" : \d+ }")
+    child.expect(r"sched nop:\s+\d+ ops/s")
 
 
 if __name__ == "__main__":
@@ -23,6 +23,7 @@
 
 #include "thread_flags.h"
 #include "xtimer.h"
+#include "benchmark.h"
 
 #ifndef TEST_DURATION
 #define TEST_DURATION       (1000000U)
@@ -63,7 +64,7 @@ int main(void)
 
     thread_t *tcb = (thread_t *)sched_threads[other];
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     timer.callback = _timer_callback;
 
     uint32_t n = 0;
@@ -74,7 +75,9 @@ int main(void)
         n++;
     }
 
-    printf("{ \"result\" : %"PRIu32" }\n", n);
+    benchmark_print_value("thread_flags pingpong",
+                          (uint32_t)(((uint64_t)n * US_PER_SEC) / TEST_DURATION),
+                          "ops/s");
 
     return 0;
 }
@@ -22,6 +22,7 @@
 
 #include "thread.h"
 #include "xtimer.h"
+#include "benchmark.h"
 
 #ifndef TEST_DURATION
 #define TEST_DURATION       (1000000U)
@@ -60,7 +61,7 @@ int main(void)
                   NULL,
                   "second_thread");
 
-    xtimer_t timer;
+    xtimer_t timer = { 0 };
     timer.callback = _timer_callback;
 
     uint32_t n = 0;
@@ -71,7 +72,9 @@ int main(void)
         n++;
     }
 
-    printf("{ \"result\" : %"PRIu32" }\n", n);
+    benchmark_print_value("thread_yield pingpong",
+                          (uint32_t)(((uint64_t)n * US_PER_SEC) / TEST_DURATION),
+                          "ops/s");
 
     return 0;
 }
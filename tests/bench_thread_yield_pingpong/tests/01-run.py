@@ -12,7 +12,7 @@ from testrunner import run
 
 
 def testfunc(child):
-    child.expect(r"{ \"result\" : \d+ }")
+    child.expect(r"thread_yield pingpong:\s+\d+ ops/s")
 
 
 if __name__ == "__main__":
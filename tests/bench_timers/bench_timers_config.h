@@ -238,6 +238,17 @@ extern "C" {
 #define SPIN_MAX_TARGET 16
 #endif
 
+/* Number of long running background timers kept armed while measuring the
+ * xtimer set/remove cost and ISR latency */
+#ifndef TEST_QUEUE_NUMOF
+#define TEST_QUEUE_NUMOF 256
+#endif
+
+/* Number of ISR latency samples taken with the background timers armed */
+#ifndef TEST_QUEUE_RUNS
+#define TEST_QUEUE_RUNS 64
+#endif
+
 /* estimate_cpu_overhead will loop for this many iterations to get a proper estimate */
 #define ESTIMATE_CPU_ITERATIONS 2048
 
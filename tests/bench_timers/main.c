@@ -447,6 +447,84 @@ static void run_test(test_ctx_t *ctx, uint32_t interval, unsigned int variant)
     xtimer_remove(&xt_parallel);
     xtimer_remove(&xt);
 }
+
+/* Background timers for the queue benchmark */
+static xtimer_t queue_timers[TEST_QUEUE_NUMOF];
+
+static void queue_cb(void *arg)
+{
+    unsigned int now_ref = timer_read(TIM_REF_DEV);
+    test_ctx_t *ctx = arg;
+
+    matstat_add(ctx->ref_state, (int32_t)(now_ref - ctx->target_ref) - overhead_target);
+    mutex_unlock(&mtx_cb);
+}
+
+static void print_queue_stat(const char *label, const matstat_state_t *state)
+{
+    print_str(label);
+    print_str(": min ");
+    print_s32_dec(state->min);
+    print_str(", mean ");
+    print_s32_dec(matstat_mean(state));
+    print_str(", max ");
+    print_s32_dec(state->max);
+    print_str(" (");
+    print_u32_dec(state->count);
+    print_str(" samples)\n");
+}
+
+/**
+ * @brief   Measure the cost of xtimer_set/xtimer_remove and the ISR latency
+ *          while TEST_QUEUE_NUMOF long running timers are armed
+ *
+ * All values are in reference timer ticks.
+ */
+static void bench_queue(void)
+{
+    matstat_state_t set_state = MATSTAT_STATE_INIT;
+    matstat_state_t remove_state = MATSTAT_STATE_INIT;
+    matstat_state_t latency_state = MATSTAT_STATE_INIT;
+    test_ctx_t ctx = { .ref_state = &latency_state };
+    xtimer_t xt = {
+        .callback = queue_cb,
+        .arg = &ctx,
+    };
+
+    print_str("Benchmarking xtimer queue with ");
+    print_u32_dec(TEST_QUEUE_NUMOF);
+    print_str(" armed timers...\n");
+
+    for (unsigned int k = 0; k < TEST_QUEUE_NUMOF; ++k) {
+        /* random targets between 1 and 2 seconds, none of them will fire
+         * during the benchmark */
+        uint32_t offset = TIM_TEST_FREQ + random_uint32_range(0, TIM_TEST_FREQ);
+        queue_timers[k].callback = nop;
+        unsigned int before = timer_read(TIM_REF_DEV);
+        _xtimer_set(&queue_timers[k], offset);
+        matstat_add(&set_state, timer_read(TIM_REF_DEV) - before);
+    }
+
+    for (unsigned int k = 0; k < TEST_QUEUE_RUNS; ++k) {
+        uint32_t interval = TEST_MIN + random_uint32_range(0, TEST_NUM);
+        spin_random_delay();
+        ctx.target_ref = timer_read(TIM_REF_DEV) + TIM_TEST_TO_REF(interval);
+        _xtimer_set(&xt, interval);
+        mutex_lock(&mtx_cb);
+    }
+
+    /* remove in an order unrelated to insertion and expiry order */
+    for (unsigned int k = 0; k < TEST_QUEUE_NUMOF; ++k) {
+        xtimer_t *t = &queue_timers[(k * 61) % TEST_QUEUE_NUMOF];
+        unsigned int before = timer_read(TIM_REF_DEV);
+        xtimer_remove(t);
+        matstat_add(&remove_state, timer_read(TIM_REF_DEV) - before);
+    }
+
+    print_queue_stat("xtimer_set", &set_state);
+    print_queue_stat("xtimer_remove", &remove_state);
+    print_queue_stat("ISR latency", &latency_state);
+}
 #else /* TEST_XTIMER */
 static void run_test(test_ctx_t *ctx, uint32_t interval, unsigned int variant)
 {
@@ -737,6 +815,9 @@ int main(void)
     print_u32_dec(spin_max);
     print("\n", 1);
     estimate_cpu_overhead();
+#if TEST_XTIMER
+    bench_queue();
+#endif
 #ifdef MODULE_PERIPH_RTT
     rtt_begin = rtt_get_counter();
 #endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for the kernel bottom-half work queue
+ *
+ * @author  Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "bh.h"
+#include "mutex.h"
+#include "xtimer.h"
+
+#define RUNS            (100U)
+#define TIMER_DELAY     (1000U)
+
+static unsigned _count;
+static uint32_t _stamp;
+static uint32_t _min = UINT32_MAX;
+static uint32_t _max;
+static mutex_t _done = MUTEX_INIT_LOCKED;
+static mutex_t _gate = MUTEX_INIT_LOCKED;
+
+static void _count_handler(void *arg)
+{
+    (void)arg;
+    _count++;
+}
+
+/* keeps the worker busy until main unlocks the gate */
+static void _block_handler(void *arg)
+{
+    (void)arg;
+    mutex_lock(&_gate);
+    mutex_unlock(&_gate);
+}
+
+static void _latency_handler(void *arg)
+{
+    (void)arg;
+    uint32_t diff = xtimer_now_usec() - _stamp;
+
+    if (diff < _min) {
+        _min = diff;
+    }
+    if (diff > _max) {
+        _max = diff;
+    }
+    mutex_unlock(&_done);
+}
+
+static bh_t _count_bh = BH_INIT(_count_handler, NULL);
+static bh_t _latency_bh = BH_INIT(_latency_handler, NULL);
+static bh_t _block_bh = BH_INIT(_block_handler, NULL);
+
+static void _twice_cb(void *arg)
+{
+    (void)arg;
+    bh_schedule(&_count_bh);
+    bh_schedule(&_count_bh);
+}
+
+static void _latency_cb(void *arg)
+{
+    (void)arg;
+    _stamp = xtimer_now_usec();
+    bh_schedule(&_latency_bh);
+}
+
+int main(void)
+{
+    xtimer_t timer = { 0 };
+
+    puts("START");
+
+    /* pending bottom halves are coalesced */
+    timer.callback = _twice_cb;
+    xtimer_set(&timer, TIMER_DELAY);
+    xtimer_usleep(10 * TIMER_DELAY);
+    printf("bh scheduled twice from ISR: handler ran %u time(s)\n", _count);
+
+    /* cancelled bottom halves do not run, the worker runs first and blocks
+     * on the gate, so the cancel is done while it cannot pick up the
+     * bottom half */
+    _count = 0;
+    bh_schedule(&_block_bh);
+    bh_schedule(&_count_bh);
+    bh_cancel(&_count_bh);
+    mutex_unlock(&_gate);
+    xtimer_usleep(TIMER_DELAY);
+    printf("bh cancelled: handler ran %u time(s)\n", _count);
+
+    timer.callback = _latency_cb;
+    for (unsigned i = 0; i < RUNS; i++) {
+        xtimer_set(&timer, TIMER_DELAY);
+        mutex_lock(&_done);
+    }
+    printf("ISR to handler latency over %u runs: min %" PRIu32 "us max %" PRIu32 "us\n",
+           RUNS, _min, _max);
+
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,16 @@
+#!/usr/bin/env python3
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect("START")
+    child.expect_exact("bh scheduled twice from ISR: handler ran 1 time(s)")
+    child.expect_exact("bh cancelled: handler ran 0 time(s)")
+    child.expect(r"ISR to handler latency over \d+ runs: min \d+us max \d+us")
+    child.expect("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
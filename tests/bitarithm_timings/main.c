@@ -50,7 +50,7 @@ static void run_test(const char *name, unsigned (*test)(unsigned))
     unsigned i = 0;
     unsigned long count = 0;
 
-    xtimer_t xtimer;
+    xtimer_t xtimer = { 0 };
     xtimer.callback = callback;
     xtimer.arg = (void *) &done;
 
@@ -0,0 +1,297 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the AT command engine
+ *
+ * Runs commands of the generic AT engine against tests/at_emu.py, then the
+ * rn2xx3 driver on the same UART.
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "at.h"
+#include "clist.h"
+#include "kernel_defines.h"
+#include "mutex.h"
+#include "rn2xx3.h"
+#include "xtimer.h"
+
+#ifndef AT_UART
+#define AT_UART             (1)
+#endif
+/* default baudrate of the rn2xx3, the generic tests use it as well */
+#define AT_BAUDRATE         (57600U)
+
+#define AT_DEV_BUF_SIZE     (256U)
+#define TIMEOUT             (2U * US_PER_SEC)
+#define SHORT_TIMEOUT       (100U * US_PER_MS)
+#define QUEUED_NUMOF        (4U)
+#define URC_LINES_NUMOF     (5U)
+
+static at_dev_t at_dev;
+static char at_dev_buf[AT_DEV_BUF_SIZE];
+static char resp[64];
+
+static rn2xx3_t rn2xx3_dev;
+
+/* "+CREG:" and "+CRSM:" share a hash bucket, "RI" is too short for hashing */
+static const char *urc_codes[] = { "+CREG:", "+CRSM:", "RI", "+QIURC:" };
+static at_urc_t urcs[ARRAY_SIZE(urc_codes)];
+static const char *urc_names[URC_LINES_NUMOF];
+static char urc_lines[URC_LINES_NUMOF][32];
+static unsigned urc_count;
+static mutex_t urc_done = MUTEX_INIT_LOCKED;
+
+static at_cmd_t queued[QUEUED_NUMOF];
+static char queued_cmd[QUEUED_NUMOF][8];
+static char queued_resp[QUEUED_NUMOF][16];
+static int queued_res[QUEUED_NUMOF];
+static unsigned queued_order[QUEUED_NUMOF];
+static unsigned queued_count;
+static mutex_t queued_done = MUTEX_INIT_LOCKED;
+
+static void _urc_cb(void *arg, const char *code)
+{
+    if (urc_count < URC_LINES_NUMOF) {
+        urc_names[urc_count] = arg;
+        strncpy(urc_lines[urc_count], code, sizeof(urc_lines[0]) - 1);
+        if (++urc_count == URC_LINES_NUMOF) {
+            mutex_unlock(&urc_done);
+        }
+    }
+}
+
+static void _queued_cb(void *arg, int res)
+{
+    unsigned i = (uintptr_t)arg;
+
+    queued_res[i] = res;
+    queued_order[queued_count] = i;
+    if (++queued_count == QUEUED_NUMOF) {
+        mutex_unlock(&queued_done);
+    }
+}
+
+static void _flag_cb(void *arg, int res)
+{
+    *(int *)arg = (res < 0) ? res : 1;
+}
+
+static int _bucket(const at_urc_t *urc)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(at_dev.urc_list); i++) {
+        if (clist_find(&at_dev.urc_list[i], &urc->list_node)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int _test_response(void)
+{
+    /* the response has the prefix of a registered urc */
+    int res = at_send_cmd_get_resp(&at_dev, "AT+CREG?", resp, sizeof(resp),
+                                   TIMEOUT);
+    if ((res < 0) || strcmp(resp, "+CREG: 0,1") || (urc_count != 0)) {
+        printf("FAILED: response %d \"%s\", %u urc's\n", res, resp, urc_count);
+        return -1;
+    }
+    puts("response: OK");
+    return 0;
+}
+
+static int _test_urc(void)
+{
+    if ((_bucket(&urcs[0]) != _bucket(&urcs[1])) ||
+        (_bucket(&urcs[2]) != AT_URC_HASH_SIZE) ||
+        (_bucket(&urcs[3]) < 0)) {
+        puts("FAILED: urc buckets");
+        return -1;
+    }
+    puts("URC buckets: OK");
+
+    /* the emulator sends the urc's after the final result code */
+    int res = at_send_cmd_wait_ok(&at_dev, "AT+URC", TIMEOUT);
+    if ((res < 0) || (xtimer_mutex_lock_timeout(&urc_done, TIMEOUT) < 0)) {
+        printf("FAILED: %d, %u urc's\n", res, urc_count);
+        return -1;
+    }
+    for (unsigned i = 0; i < URC_LINES_NUMOF; i++) {
+        printf("URC [%s] %s\n", urc_names[i], urc_lines[i]);
+    }
+    return 0;
+}
+
+static int _test_queue(void)
+{
+    for (unsigned i = 0; i < QUEUED_NUMOF; i++) {
+        sprintf(queued_cmd[i], "AT+P%u", i);
+        queued[i].cmd = queued_cmd[i];
+        queued[i].resp = queued_resp[i];
+        queued[i].resp_len = sizeof(queued_resp[i]);
+        queued[i].timeout = TIMEOUT;
+        queued[i].cb = _queued_cb;
+        queued[i].arg = (void *)(uintptr_t)i;
+        at_cmd_submit(&at_dev, &queued[i]);
+    }
+    /* the emulator answers after some milliseconds */
+    printf("queued: %u commands, %u done\n", QUEUED_NUMOF, queued_count);
+
+    if (xtimer_mutex_lock_timeout(&queued_done, QUEUED_NUMOF * TIMEOUT) < 0) {
+        printf("FAILED: %u commands done\n", queued_count);
+        return -1;
+    }
+    for (unsigned i = 0; i < QUEUED_NUMOF; i++) {
+        char expected[16];
+        int len = sprintf(expected, "+P%u: %u\n", i, i);
+        if ((queued_order[i] != i) || (queued_res[i] != len) ||
+            strcmp(queued_resp[i], expected)) {
+            printf("FAILED: command %u: %d \"%s\"\n", queued_order[i],
+                   queued_res[i], queued_resp[i]);
+            return -1;
+        }
+    }
+    puts("queue: OK");
+    return 0;
+}
+
+static int _test_results(void)
+{
+    int res_err = at_send_cmd_wait_ok(&at_dev, "AT+ERR", TIMEOUT);
+    int res_cme = at_send_cmd_wait_ok(&at_dev, "AT+CME", TIMEOUT);
+
+    uint32_t start = xtimer_now_usec();
+    int res_timeout = at_send_cmd_wait_ok(&at_dev, "AT+SILENT", SHORT_TIMEOUT);
+    uint32_t waited = xtimer_now_usec() - start;
+
+    /* the queue goes on after the timeout */
+    int res_ok = at_send_cmd_wait_ok(&at_dev, "AT", TIMEOUT);
+
+    if ((res_err != -1) || (res_cme != -1) || (res_timeout != -ETIMEDOUT) ||
+        (waited < SHORT_TIMEOUT) || (res_ok != 0)) {
+        printf("FAILED: results %d %d %d (%u us) %d\n", res_err, res_cme,
+               res_timeout, (unsigned)waited, res_ok);
+        return -1;
+    }
+    puts("results: OK");
+    return 0;
+}
+
+static int _test_line(void)
+{
+    /* the device sends no final result code */
+    at_cmd_t cmd = { .cmd = "AT+LINE", .resp = resp, .resp_len = sizeof(resp),
+                     .timeout = TIMEOUT, .flags = AT_CMD_F_LINE };
+
+    int res = at_cmd_run(&at_dev, &cmd);
+    int res_ok = at_send_cmd_wait_ok(&at_dev, "AT", TIMEOUT);
+    if ((res != (int)strlen("value 42\n")) || strcmp(resp, "value 42\n") ||
+        (res_ok != 0)) {
+        printf("FAILED: line %d \"%s\", %d\n", res, resp, res_ok);
+        return -1;
+    }
+    puts("line: OK");
+    return 0;
+}
+
+static int _test_acquire(void)
+{
+    int done = 0;
+    at_cmd_t cmd = { .cmd = "AT+Q", .timeout = TIMEOUT, .cb = _flag_cb,
+                     .arg = &done };
+
+    /* the barrier waits for the command queued before */
+    at_cmd_submit(&at_dev, &cmd);
+    at_acquire(&at_dev);
+    int barrier_done = done;
+
+    /* the engine does not read the input meanwhile */
+    int res = at_send_cmd_get_resp(&at_dev, "AT+RAW", resp, sizeof(resp),
+                                   TIMEOUT);
+    at_release(&at_dev);
+
+    int res_ok = at_send_cmd_wait_ok(&at_dev, "AT", TIMEOUT);
+    if ((barrier_done != 1) || (res < 0) || strcmp(resp, "+RAW: 1") ||
+        (res_ok != 0)) {
+        printf("FAILED: acquire %d, raw %d \"%s\", %d\n", barrier_done, res,
+               resp, res_ok);
+        return -1;
+    }
+    puts("acquire: OK");
+    return 0;
+}
+
+static int _test_rn2xx3(void)
+{
+    const rn2xx3_params_t params = {
+        .uart = UART_DEV(AT_UART),
+        .baudrate = AT_BAUDRATE,
+        .pin_reset = GPIO_UNDEF,
+    };
+    uint8_t payload[] = { 0xca, 0xfe };
+
+    /* takes the UART over from the generic device */
+    rn2xx3_setup(&rn2xx3_dev, &params);
+    int res = rn2xx3_init(&rn2xx3_dev);
+    if (res != RN2XX3_OK) {
+        printf("FAILED: rn2xx3_init: %d\n", res);
+        return -1;
+    }
+
+    /* the emulator answers with the payload as downlink */
+    res = rn2xx3_mac_tx(&rn2xx3_dev, payload, sizeof(payload));
+    if ((res != RN2XX3_REPLY_TX_MAC_RX) ||
+        (rn2xx3_dev.rx_size != sizeof(payload)) ||
+        memcmp(rn2xx3_dev.rx_buf, payload, sizeof(payload))) {
+        printf("FAILED: rn2xx3_mac_tx: %d, %u bytes received\n", res,
+               (unsigned)rn2xx3_dev.rx_size);
+        return -1;
+    }
+    puts("rn2xx3: OK");
+    return 0;
+}
+
+int main(void)
+{
+    puts("AT engine test");
+
+    at_dev_init(&at_dev, UART_DEV(AT_UART), AT_BAUDRATE,
+                at_dev_buf, sizeof(at_dev_buf));
+    for (unsigned i = 0; i < ARRAY_SIZE(urcs); i++) {
+        urcs[i].cb = _urc_cb;
+        urcs[i].code = urc_codes[i];
+        urcs[i].arg = (void *)urc_codes[i];
+        at_add_urc(&at_dev, &urcs[i]);
+    }
+    if (at_async_start(&at_dev) < 0) {
+        puts("FAILED: at_async_start");
+        return 1;
+    }
+
+    if ((_test_response() < 0) || (_test_urc() < 0) || (_test_queue() < 0) ||
+        (_test_results() < 0) || (_test_line() < 0) ||
+        (_test_acquire() < 0) || (_test_rn2xx3() < 0)) {
+        puts("FAILED");
+        return 1;
+    }
+
+    puts("SUCCESS");
+    return 0;
+}
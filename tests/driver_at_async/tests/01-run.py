@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+from testrunner import run
+
+from at_emu import AtEmu, open_port
+
+QUEUED_NUMOF = 4
+
+
+def testfunc(child):
+    child.expect_exact("AT engine test")
+    child.expect_exact("response: OK")
+    child.expect_exact("URC buckets: OK")
+    # "+CRXX: 1" shares the bucket of "+CREG:" and "+CRSM:" and is dropped,
+    # "RING" is matched by the short urc "RI"
+    child.expect_exact('URC [+QIURC:] +QIURC: "recv",0')
+    child.expect_exact("URC [+CRSM:] +CRSM: 144,0")
+    child.expect_exact("URC [+CREG:] +CREG: 5")
+    child.expect_exact("URC [RI] RING")
+    child.expect_exact("URC [RI] RI")
+    child.expect_exact("queued: %d commands, 0 done" % QUEUED_NUMOF)
+    child.expect_exact("queue: OK")
+    child.expect_exact("results: OK")
+    child.expect_exact("line: OK")
+    child.expect_exact("acquire: OK")
+    child.expect_exact("rn2xx3: OK")
+    child.expect_exact("SUCCESS")
+
+    # the queued commands were sent in order, each one after the final result
+    # code of the previous one
+    queued = [cmd for cmd in emu.log if cmd.startswith(b'AT+P')]
+    assert queued == [b'AT+P%d' % i for i in range(QUEUED_NUMOF)], queued
+    assert emu.early == [], emu.early
+
+    # the barrier was only passed after the command queued before
+    assert emu.log.index(b'AT+Q') < emu.log.index(b'AT+RAW'), emu.log
+    assert any(cmd.upper() == b'MAC TX CNF 2 CAFE' for cmd in emu.log), \
+        emu.log
+
+
+if __name__ == "__main__":
+    # AT_EMU_PORT is the host serial port wired to the device UART, a pty
+    # passed to native otherwise
+    fd, path = open_port(os.environ.get('AT_EMU_PORT'))
+    if 'AT_EMU_PORT' not in os.environ:
+        os.environ['TERMFLAGS'] = "-c %s" % path
+    emu = AtEmu(fd)
+    emu.start()
+    sys.exit(run(testfunc))
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Scripted AT device, answers the commands of tests/driver_at_async.
+
+Commands starting with "AT" are echoed and answered like a modem, all other
+ones like a rn2xx3, without echo. The answers of "AT+P<n>" are delayed, and
+commands that arrived meanwhile are recorded in `early`: the engine must not
+send the next command before the final result code of the previous one.
+"""
+
+import os
+import re
+import select
+import sys
+import termios
+import threading
+import time
+import tty
+
+MAC_TX = re.compile(rb'mac tx (?:cnf|uncnf) (\d+) ([0-9A-Fa-f]*)')
+
+URCS = [b'+QIURC: "recv",0', b'+CRXX: 1', b'+CRSM: 144,0', b'+CREG: 5',
+        b'RING', b'RI']
+
+RESPONSES = {
+    b'AT+CREG?': [b'+CREG: 0,1', b'OK'],
+    b'AT+ERR': [b'ERROR'],
+    b'AT+CME': [b'+CME ERROR: 10'],
+    b'AT+SILENT': [],
+    b'AT+LINE': [b'value 42'],
+    b'AT+RAW': [b'+RAW: 1', b'OK'],
+    b'AT+URC': [b'OK'] + URCS,
+}
+
+
+class AtEmu(threading.Thread):
+    def __init__(self, fd, delay=0.02):
+        super().__init__(daemon=True)
+        self.fd = fd
+        self.rx = b''
+        self.log = []
+        self.early = []
+        self.delay = delay
+        self.lock = threading.Lock()
+
+    def _readcmd(self):
+        while b'\r' not in self.rx:
+            self.rx += os.read(self.fd, 256)
+        cmd, self.rx = self.rx.split(b'\r', 1)
+        return cmd.strip(b'\n')
+
+    def _pending(self):
+        """Whether more than the end of line of the last command arrived."""
+        while select.select([self.fd], [], [], 0)[0]:
+            self.rx += os.read(self.fd, 256)
+        return self.rx.strip(b'\n') != b''
+
+    def _write(self, data):
+        with self.lock:
+            os.write(self.fd, data)
+
+    def _line(self, line):
+        self._write(b'\r\n' + line + b'\r\n')
+
+    def _handle_at(self, cmd):
+        # command echo
+        self._write(cmd + b'\r')
+
+        m = re.match(rb'AT\+P(\d+)$', cmd)
+        if m:
+            time.sleep(self.delay)
+            if self._pending():
+                self.early.append(cmd)
+            self._line(b'+P%s: %s' % (m.group(1), m.group(1)))
+            self._line(b'OK')
+            return
+
+        for line in RESPONSES.get(cmd, [b'OK']):
+            self._line(line)
+
+    def _handle_rn2xx3(self, cmd):
+        if not cmd:
+            self._write(b'invalid_param\r\n')
+            return
+
+        self._write(b'ok\r\n')
+        m = MAC_TX.match(cmd)
+        if m:
+            # the payload comes back as downlink in the receive window
+            reply = b'mac_rx %s %s\r\n' % (m.group(1), m.group(2).upper())
+            threading.Timer(0.1, self._write, [reply]).start()
+
+    def run(self):
+        while True:
+            cmd = self._readcmd()
+            self.log.append(cmd)
+            if cmd[:2].upper() == b'AT':
+                self._handle_at(cmd)
+            else:
+                self._handle_rn2xx3(cmd)
+
+
+def open_port(port=None):
+    """Opens the serial port of the device, or a pty if none is given.
+
+    Returns the file descriptor and the path for the device under test.
+    """
+    if port is None:
+        master, slave = os.openpty()
+        tty.setraw(master)
+        return master, os.ttyname(slave)
+    fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd)
+    attrs = termios.tcgetattr(fd)
+    attrs[4] = attrs[5] = termios.B57600
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd, port
+
+
+if __name__ == "__main__":
+    fd, path = open_port(sys.argv[1] if len(sys.argv) > 1 else None)
+    print("AT emulator on %s" % path)
+    emu = AtEmu(fd)
+    emu.start()
+    emu.join()
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the background erase of mtd_spi_nor
+ *
+ * Uses the last sectors of MTD_0, their content is lost.
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+#include "mtd.h"
+#include "mtd_spi_nor.h"
+#include "mutex.h"
+#include "xtimer.h"
+
+/* longest sector erase of the chips in use */
+#define TEST_SECTOR_ERASE_US    (3U * US_PER_SEC)
+/* mtd_erase() of a pre-erased sector does not access the chip */
+#define TEST_PRE_ERASED_US      (1U * US_PER_MS)
+#define TEST_PATTERN            (0xa5)
+
+static mtd_spi_nor_t *_dev;
+static uint32_t _sector_size;
+static uint8_t _page[256];
+static mutex_t _erased = MUTEX_INIT_LOCKED;
+static mutex_t _read = MUTEX_INIT_LOCKED;
+
+static uint32_t _sector_addr(unsigned n)
+{
+    return (_dev->base.sector_count - 1 - n) * _sector_size;
+}
+
+static void _erase_cb(void *arg)
+{
+    (void)arg;
+    mutex_unlock(&_erased);
+}
+
+static void _read_cb(void *arg)
+{
+    (void)arg;
+    mutex_unlock(&_read);
+}
+
+static bool _page_buf_is(uint8_t val)
+{
+    for (unsigned i = 0; i < _dev->base.page_size; i++) {
+        if (_page[i] != val) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool _page_is(uint32_t addr, uint8_t val)
+{
+    memset(_page, ~val, _dev->base.page_size);
+    if (mtd_read(&_dev->base, _page, addr, _dev->base.page_size) < 0) {
+        return false;
+    }
+    return _page_buf_is(val);
+}
+
+static int _write_page(uint32_t addr)
+{
+    memset(_page, TEST_PATTERN, _dev->base.page_size);
+    return mtd_write(&_dev->base, _page, addr, _dev->base.page_size);
+}
+
+static uint32_t _timed_erase(uint32_t addr)
+{
+    uint32_t start = xtimer_now_usec();
+    mtd_erase(&_dev->base, addr, _sector_size);
+    return xtimer_now_usec() - start;
+}
+
+static int _test_erase_async(void)
+{
+    /* sector 0 holds the data read during the erase of sector 1 */
+    mtd_erase(&_dev->base, _sector_addr(0), _sector_size);
+    _write_page(_sector_addr(0));
+    _write_page(_sector_addr(1));
+
+    if (mtd_spi_nor_erase_async(_dev, _sector_addr(1), _sector_size,
+                                _erase_cb, NULL) < 0) {
+        puts("mtd_spi_nor_erase_async() failed");
+        return -1;
+    }
+    if (mtd_spi_nor_erase_async(_dev, _sector_addr(1), _sector_size,
+                                _erase_cb, NULL) != -EBUSY) {
+        puts("second async erase accepted");
+        return -1;
+    }
+    if (!_page_is(_sector_addr(0), TEST_PATTERN)) {
+        puts("read during async erase: FAILED");
+        return -1;
+    }
+    puts("read during async erase: OK");
+
+    mutex_lock(&_erased);
+    if (!_page_is(_sector_addr(1), 0xff)) {
+        puts("async erase done: FAILED");
+        return -1;
+    }
+    puts("async erase done: OK");
+    return 0;
+}
+
+static int _test_read_async(void)
+{
+#ifdef MODULE_PERIPH_SPI_ASYNC
+    /* sector 0 still holds the page written by _test_erase_async() */
+    memset(_page, ~TEST_PATTERN, _dev->base.page_size);
+    if (mtd_spi_nor_read_async(_dev, _page, _sector_addr(0),
+                               _dev->base.page_size, _read_cb, NULL) < 0) {
+        puts("mtd_spi_nor_read_async() failed");
+        return -1;
+    }
+    mutex_lock(&_read);
+    if (!_page_buf_is(TEST_PATTERN)) {
+        puts("queued read: FAILED");
+        return -1;
+    }
+    puts("queued read: OK");
+#else
+    (void)_read_cb;
+    puts("queued read: skipped");
+#endif
+    return 0;
+}
+
+static int _test_pre_erase(void)
+{
+    /* sectors 1 .. MTD_SPI_NOR_PRE_ERASE_NUMOF + 1 */
+    for (unsigned i = 1; i <= MTD_SPI_NOR_PRE_ERASE_NUMOF; i++) {
+        if (mtd_spi_nor_pre_erase(_dev, _sector_addr(i)) < 0) {
+            puts("mtd_spi_nor_pre_erase() failed");
+            return -1;
+        }
+    }
+    if (mtd_spi_nor_pre_erase(_dev, _sector_addr(1) + 1) != -EOVERFLOW) {
+        puts("unaligned pre-erase accepted");
+        return -1;
+    }
+
+    /* the entry of sector 1 is reused as soon as it is erased */
+    uint32_t start = xtimer_now_usec();
+    int res;
+    while ((res = mtd_spi_nor_pre_erase(_dev, _sector_addr(
+                                 MTD_SPI_NOR_PRE_ERASE_NUMOF + 1))) == -ENOMEM) {
+        if ((xtimer_now_usec() - start) > TEST_SECTOR_ERASE_US) {
+            break;
+        }
+        xtimer_usleep(10U * US_PER_MS);
+    }
+    if (res < 0) {
+        printf("pre-erase queue reuse: FAILED (%d)\n", res);
+        return -1;
+    }
+    puts("pre-erase queue reuse: OK");
+
+    xtimer_usleep(MTD_SPI_NOR_PRE_ERASE_NUMOF * TEST_SECTOR_ERASE_US);
+    for (unsigned i = 2; i <= MTD_SPI_NOR_PRE_ERASE_NUMOF + 1; i++) {
+        uint32_t t = _timed_erase(_sector_addr(i));
+        if (t > TEST_PRE_ERASED_US) {
+            printf("pre-erased sectors kept: FAILED (sector %u: %" PRIu32 " us)\n",
+                   i, t);
+            return -1;
+        }
+    }
+    if (_timed_erase(_sector_addr(1)) <= TEST_PRE_ERASED_US) {
+        puts("pre-erased sectors kept: FAILED (oldest entry not reused)");
+        return -1;
+    }
+    puts("pre-erased sectors kept: OK");
+
+    /* a write makes the pre-erased sector dirty */
+    _write_page(_sector_addr(2));
+    mtd_erase(&_dev->base, _sector_addr(2), _sector_size);
+    if (!_page_is(_sector_addr(2), 0xff)) {
+        puts("written sector erased again: FAILED");
+        return -1;
+    }
+    puts("written sector erased again: OK");
+    return 0;
+}
+
+int main(void)
+{
+    _dev = (mtd_spi_nor_t *)MTD_0;
+    if (TEST_SUSPEND) {
+        _dev->flag |= SPI_NOR_F_SUSPEND;
+    }
+    if (mtd_init(&_dev->base) < 0) {
+        puts("mtd_init() failed");
+        return 1;
+    }
+    _sector_size = _dev->base.page_size * _dev->base.pages_per_sector;
+    if ((_dev->base.page_size > sizeof(_page)) ||
+        (_dev->base.sector_count < MTD_SPI_NOR_PRE_ERASE_NUMOF + 2)) {
+        puts("unsupported geometry");
+        return 1;
+    }
+    printf("erase suspend %s\n", (_dev->flag & SPI_NOR_F_SUSPEND) ? "on" : "off");
+
+    if ((_test_erase_async() < 0) || (_test_read_async() < 0) ||
+        (_test_pre_erase() < 0)) {
+        puts("FAILURE");
+        return 1;
+    }
+    puts("SUCCESS");
+    return 0;
+}
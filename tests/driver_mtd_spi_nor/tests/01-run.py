@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("read during async erase: OK")
+    child.expect_exact("async erase done: OK")
+    child.expect(r"queued read: (OK|skipped)")
+    child.expect_exact("pre-erase queue reuse: OK")
+    child.expect_exact("pre-erased sectors kept: OK")
+    child.expect_exact("written sector erased again: OK")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
@@ -22,6 +22,7 @@
 #include "sdcard_spi_internal.h"
 #include "sdcard_spi_params.h"
 #include "fmt.h"
+#include "xtimer.h"
 #include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
@@ -359,6 +360,113 @@ static int _sector_count(int argc, char **argv)
     return 0;
 }
 
+typedef enum {
+    BENCH_SINGLE,       /* one command per block */
+    BENCH_MULTI,        /* one multi-block command per buffer */
+    BENCH_STREAM,       /* one multi-block command for all blocks */
+} bench_mode_t;
+
+static const char *_bench_mode_names[] = { "single", "multi", "stream" };
+
+static sd_rw_response_t _bench_write(bench_mode_t mode, int bladdr, int cnt)
+{
+    sd_rw_response_t state = SD_RW_OK;
+
+    if (mode == BENCH_STREAM) {
+        state = sdcard_spi_write_stream_start(card, bladdr, cnt);
+        for (int i = 0; (i < cnt) && (state == SD_RW_OK); i++) {
+            state = sdcard_spi_write_stream_block(card, buffer);
+        }
+        if (state == SD_RW_OK) {
+            state = sdcard_spi_write_stream_stop(card);
+        }
+        return state;
+    }
+
+    int chunk = (mode == BENCH_SINGLE) ? 1 : MAX_BLOCKS_IN_BUFFER;
+    for (int i = 0; (i < cnt) && (state == SD_RW_OK); i += chunk) {
+        int n = ((cnt - i) < chunk) ? (cnt - i) : chunk;
+        sdcard_spi_write_blocks(card, bladdr + i, buffer, SD_HC_BLOCK_SIZE, n, &state);
+    }
+    return state;
+}
+
+static sd_rw_response_t _bench_read(bench_mode_t mode, int bladdr, int cnt)
+{
+    sd_rw_response_t state = SD_RW_OK;
+
+    if (mode == BENCH_STREAM) {
+        state = sdcard_spi_read_stream_start(card, bladdr);
+        for (int i = 0; (i < cnt) && (state == SD_RW_OK); i++) {
+            state = sdcard_spi_read_stream_block(card, buffer);
+        }
+        if (state == SD_RW_OK) {
+            state = sdcard_spi_read_stream_stop(card);
+        }
+        return state;
+    }
+
+    int chunk = (mode == BENCH_SINGLE) ? 1 : MAX_BLOCKS_IN_BUFFER;
+    for (int i = 0; (i < cnt) && (state == SD_RW_OK); i += chunk) {
+        int n = ((cnt - i) < chunk) ? (cnt - i) : chunk;
+        sdcard_spi_read_blocks(card, bladdr + i, buffer, SD_HC_BLOCK_SIZE, n, &state);
+    }
+    return state;
+}
+
+static uint32_t _kib_per_sec(int cnt, uint32_t usec)
+{
+    if (usec == 0) {
+        usec = 1;
+    }
+    return ((uint64_t)cnt * SD_HC_BLOCK_SIZE * US_PER_SEC) / (usec * 1024ULL);
+}
+
+static int _bench(int argc, char **argv)
+{
+    if (argc != 3) {
+        printf("usage: %s blockaddr cnt\n", argv[0]);
+        return -1;
+    }
+
+    int bladdr = atoi(argv[1]);
+    int cnt = atoi(argv[2]);
+
+    if (cnt <= 0) {
+        puts("cnt must be positive");
+        return -1;
+    }
+
+    for (unsigned i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = i;
+    }
+
+    for (bench_mode_t mode = BENCH_SINGLE; mode <= BENCH_STREAM; mode++) {
+        uint32_t start = xtimer_now_usec();
+        sd_rw_response_t state = _bench_write(mode, bladdr, cnt);
+        uint32_t wr_usec = xtimer_now_usec() - start;
+
+        if (state != SD_RW_OK) {
+            printf("%s: write error %d\n", _bench_mode_names[mode], state);
+            return -1;
+        }
+
+        start = xtimer_now_usec();
+        state = _bench_read(mode, bladdr, cnt);
+        uint32_t rd_usec = xtimer_now_usec() - start;
+
+        if (state != SD_RW_OK) {
+            printf("%s: read error %d\n", _bench_mode_names[mode], state);
+            return -1;
+        }
+
+        printf("%-6s write: %" PRIu32 " KiB/s, read: %" PRIu32 " KiB/s\n",
+               _bench_mode_names[mode], _kib_per_sec(cnt, wr_usec),
+               _kib_per_sec(cnt, rd_usec));
+    }
+    return 0;
+}
+
 static const shell_command_t shell_commands[] = {
     { "init", "initializes default card", _init },
     { "cid",  "print content of CID (Card IDentification) register", _cid },
@@ -371,6 +479,9 @@ static const shell_command_t shell_commands[] = {
     { "write", "'write n data' writes data to block n. Append -r option to "
                "repeatedly write data to coplete block", _write },
     { "copy", "'copy src dst' copies block src to block dst", _copy },
+    { "bench", "'bench n m' writes and reads m blocks beginning at block address n "
+               "block by block, in multi-block chunks and as one stream and prints "
+               "the throughput", _bench },
     { NULL, NULL, NULL }
 };
 
@@ -381,7 +492,7 @@ int main(void)
     card->init_done = false;
 
     puts("insert SD-card and use 'init' command to set card to spi mode");
-    puts("WARNING: using 'write' or 'copy' commands WILL overwrite data on your sd-card and");
+    puts("WARNING: using 'write', 'copy' or 'bench' commands WILL overwrite data on your sd-card and");
     puts("almost for sure corrupt existing filesystems, partitions and contained data!");
     char line_buf[SHELL_DEFAULT_BUFSIZE];
     shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the sock implementation over SIMCOM
+ *
+ * Talks to UDP and TCP echo servers. Several UDP datagrams are sent before
+ * the first echo is read, so the sends are pipelined.
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/af.h"
+#include "net/sock/tcp.h"
+#include "net/sock/udp.h"
+#include "periph/gpio.h"
+#include "simcom.h"
+#include "xtimer.h"
+
+#ifndef SIMCOM_UART
+#define SIMCOM_UART         (1)
+#endif
+#ifndef SIMCOM_BAUDRATE
+#define SIMCOM_BAUDRATE     (115200U)
+#endif
+#ifndef SIMCOM_POWER_PIN
+#define SIMCOM_POWER_PIN    GPIO_PIN(0, 0)
+#endif
+#ifndef SIMCOM_ENABLE_PIN
+#define SIMCOM_ENABLE_PIN   GPIO_PIN(0, 1)
+#endif
+
+#define AT_DEV_BUF_SIZE     (512U)
+#define AT_DEV_RESP_SIZE    (256U)
+#define DATAGRAMS_NUMOF     (4U)
+#define TIMEOUT             (5U * US_PER_SEC)
+
+static simcom_dev_t simcom_dev;
+static char at_dev_buf[AT_DEV_BUF_SIZE];
+static char at_dev_resp[AT_DEV_RESP_SIZE];
+
+static sock_udp_t udp_sock;
+static sock_tcp_t tcp_sock;
+static char buf[64];
+
+static const sock_udp_ep_t udp_remote = {
+    .family = AF_INET,
+    .addr = { .ipv4 = { 192, 0, 2, 1 } },
+    .port = 7,
+};
+
+static const sock_tcp_ep_t tcp_remote = {
+    .family = AF_INET,
+    .addr = { .ipv4 = { 192, 0, 2, 1 } },
+    .port = 7,
+};
+
+static int _test_udp(void)
+{
+    int res = sock_udp_create(&udp_sock, NULL, &udp_remote, 0);
+    if (res < 0) {
+        printf("sock_udp_create: %d\n", res);
+        return res;
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < DATAGRAMS_NUMOF; i++) {
+        int len = sprintf(buf, "datagram %u", i);
+        res = sock_udp_send(&udp_sock, buf, len, NULL);
+        if (res != len) {
+            printf("sock_udp_send: %d\n", res);
+            return -1;
+        }
+    }
+    for (unsigned i = 0; i < DATAGRAMS_NUMOF; i++) {
+        res = sock_udp_recv(&udp_sock, buf, sizeof(buf) - 1, TIMEOUT, NULL);
+        if (res < 0) {
+            printf("sock_udp_recv: %d\n", res);
+            return res;
+        }
+        buf[res] = '\0';
+        printf("UDP received: %s\n", buf);
+    }
+    printf("UDP: %u datagrams in %u us\n", DATAGRAMS_NUMOF,
+           (unsigned)(xtimer_now_usec() - start));
+
+    sock_udp_close(&udp_sock);
+    return 0;
+}
+
+static int _test_tcp(void)
+{
+    static const char msg[] = "stream data";
+
+    int res = sock_tcp_connect(&tcp_sock, &tcp_remote, 0, 0);
+    if (res < 0) {
+        printf("sock_tcp_connect: %d\n", res);
+        return res;
+    }
+    res = sock_tcp_write(&tcp_sock, msg, sizeof(msg) - 1);
+    if (res != sizeof(msg) - 1) {
+        printf("sock_tcp_write: %d\n", res);
+        return -1;
+    }
+
+    /* read in small parts, the rest of a chunk stays buffered */
+    size_t pos = 0;
+    while (pos < sizeof(msg) - 1) {
+        res = sock_tcp_read(&tcp_sock, &buf[pos], 4, TIMEOUT);
+        if (res < 0) {
+            printf("sock_tcp_read: %d\n", res);
+            return res;
+        }
+        pos += res;
+    }
+    buf[pos] = '\0';
+    printf("TCP received: %s\n", buf);
+
+    sock_tcp_disconnect(&tcp_sock);
+    return 0;
+}
+
+int main(void)
+{
+    puts("SIMCOM sock test");
+
+    simcom_dev.power_en_pin = SIMCOM_POWER_PIN;
+    simcom_dev.power_act_level = 1;
+    simcom_dev.gsm_en_pin = SIMCOM_ENABLE_PIN;
+    simcom_dev.gsm_act_level = 1;
+
+    if ((simcom_init(&simcom_dev, UART_DEV(SIMCOM_UART), SIMCOM_BAUDRATE,
+                     at_dev_buf, sizeof(at_dev_buf),
+                     at_dev_resp, sizeof(at_dev_resp)) != SIMCOM_OK) ||
+        (simcom_sock_init(&simcom_dev) != SIMCOM_OK)) {
+        puts("FAILED: modem init");
+        return 1;
+    }
+
+    if ((_test_udp() < 0) || (_test_tcp() < 0)) {
+        puts("FAILED");
+        return 1;
+    }
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import re
+import sys
+from testrunner import run
+
+from simcom_emu import SimcomEmu, open_port
+
+DATAGRAMS_NUMOF = 4
+
+
+def testfunc(child):
+    child.expect_exact("SIMCOM sock test")
+    for i in range(DATAGRAMS_NUMOF):
+        child.expect_exact("UDP received: datagram %d" % i)
+    child.expect(r"UDP: %d datagrams in \d+ us" % DATAGRAMS_NUMOF)
+    child.expect_exact("TCP received: stream data")
+    child.expect_exact("SUCCESS")
+
+    # the socks use the quick send mode, set before the first connection
+    cmds = [cmd for cmd in emu.log
+            if cmd.startswith((b'AT+CIPQSEND', b'AT+CIPSTART', b'AT+CIPSEND',
+                               b'AT+CIPCLOSE'))]
+    kinds = [re.match(rb'AT\+(\w+)', cmd).group(1) for cmd in cmds]
+    assert kinds == ([b'CIPQSEND', b'CIPSTART'] +
+                     [b'CIPSEND'] * DATAGRAMS_NUMOF +
+                     [b'CIPCLOSE', b'CIPSTART', b'CIPSEND', b'CIPCLOSE']), kinds
+    assert b'"UDP"' in cmds[1] and b'"TCP"' in cmds[DATAGRAMS_NUMOF + 3]
+
+    # the datagrams were sent in order on one connection, before any echo
+    # was released by the emulator, then the stream on a second one
+    udp_conn = emu.sent[0][0]
+    assert emu.sent[:DATAGRAMS_NUMOF] == [
+        (udp_conn, b'datagram %d' % i) for i in range(DATAGRAMS_NUMOF)]
+    assert emu.sent[DATAGRAMS_NUMOF:] == [(emu.sent[-1][0], b'stream data')]
+
+
+if __name__ == "__main__":
+    # SIMCOM_EMU_PORT is the host serial port wired to the modem UART, a pty
+    # passed to native otherwise
+    fd, path = open_port(os.environ.get('SIMCOM_EMU_PORT'))
+    if 'SIMCOM_EMU_PORT' not in os.environ:
+        os.environ['TERMFLAGS'] = "-c %s" % path
+    emu = SimcomEmu(fd, hold=DATAGRAMS_NUMOF)
+    emu.start()
+    sys.exit(run(testfunc))
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Scripted SIMCOM modem, answers the multi-IP commands used by simcom_sock.
+
+Every connection is an echo server: data sent through it is returned as
+"+RECEIVE" push. The echoes are held back until `hold` sends arrived, so a
+device that waits for an echo before sending again gets stuck.
+"""
+
+import os
+import re
+import sys
+import termios
+import threading
+import tty
+
+CIPSTART = re.compile(rb'AT\+CIPSTART=(\d),"(TCP|UDP)","([\d.]+)","(\d+)"')
+CIPSEND = re.compile(rb'AT\+CIPSEND=(\d),(\d+)')
+CIPCLOSE = re.compile(rb'AT\+CIPCLOSE=(\d)')
+
+
+class SimcomEmu(threading.Thread):
+    def __init__(self, fd, hold=0):
+        super().__init__(daemon=True)
+        self.fd = fd
+        self.rx = b''
+        self.log = []
+        self.sent = []
+        self.hold = hold
+        self.held = []
+
+    def _read(self, n):
+        while len(self.rx) < n:
+            self.rx += os.read(self.fd, 256)
+        data, self.rx = self.rx[:n], self.rx[n:]
+        return data
+
+    def _readcmd(self):
+        while b'\r' not in self.rx:
+            self.rx += os.read(self.fd, 256)
+        cmd, self.rx = self.rx.split(b'\r', 1)
+        return cmd.strip(b'\n')
+
+    def _write(self, data):
+        os.write(self.fd, data)
+
+    def _line(self, line):
+        self._write(b'\r\n' + line + b'\r\n')
+
+    def _handle(self, cmd):
+        self.log.append(cmd)
+        # command echo
+        self._write(cmd + b'\r')
+
+        m = CIPSEND.match(cmd)
+        if m:
+            conn, length = m.group(1), int(m.group(2))
+            self._write(b'\r\n> ')
+            data = self._read(length)
+            self._write(data)
+            self._line(b'DATA ACCEPT:%s,%d' % (conn, length))
+            self.sent.append((int(conn), data))
+            self.held.append(b'\r\n+RECEIVE,%s,%d:\r\n' % (conn, length) + data)
+            if len(self.sent) >= self.hold:
+                for echo in self.held:
+                    self._write(echo)
+                self.held = []
+            return
+
+        m = CIPSTART.match(cmd)
+        if m:
+            self._line(b'OK')
+            self._line(m.group(1) + b', CONNECT OK')
+            return
+
+        m = CIPCLOSE.match(cmd)
+        if m:
+            self._line(m.group(1) + b', CLOSE OK')
+            return
+
+        self._line(b'OK')
+
+    def run(self):
+        while True:
+            cmd = self._readcmd()
+            if cmd:
+                self._handle(cmd)
+
+
+def open_port(port=None):
+    """Opens the serial port of the modem, or a pty if none is given.
+
+    Returns the file descriptor and the path for the device under test.
+    """
+    if port is None:
+        master, slave = os.openpty()
+        tty.setraw(master)
+        return master, os.ttyname(slave)
+    fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd)
+    attrs = termios.tcgetattr(fd)
+    attrs[4] = attrs[5] = termios.B115200
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd, port
+
+
+if __name__ == "__main__":
+    fd, path = open_port(sys.argv[1] if len(sys.argv) > 1 else None)
+    print("SIMCOM emulator on %s" % path)
+    emu = SimcomEmu(fd)
+    emu.start()
+    emu.join()
@@ -250,9 +250,6 @@ int send_cmd(int argc, char **argv)
 
 int listen_cmd(int argc, char **argv)
 {
-    (void)argc;
-    (void)argv;
-
     netdev_t *netdev = (netdev_t*) &sx127x;
     /* Switch to continuous listen mode */
     const netopt_enable_t single = false;
@@ -260,6 +257,14 @@ int listen_cmd(int argc, char **argv)
     const uint32_t timeout = 0;
     netdev->driver->set(netdev, NETOPT_RX_TIMEOUT, &timeout, sizeof(timeout));
 
+    /* Sniff for preambles instead of listening all the time */
+    const netopt_enable_t sniff = ((argc > 1) && (strcmp(argv[1], "sniff") == 0));
+    netdev->driver->set(netdev, NETOPT_RX_SNIFF, &sniff, sizeof(sniff));
+    if (sniff) {
+        printf("Sniff period: %u ms\n",
+               (unsigned)sx127x_get_sniff_period(&sx127x));
+    }
+
     /* Switch to RX state */
     uint8_t state = NETOPT_STATE_RX;
     netdev->driver->set(netdev, NETOPT_STATE, &state, sizeof(state));
@@ -307,7 +312,7 @@ static const shell_command_t shell_commands[] = {
     { "channel",  "Get/Set channel frequency (in Hz)",       channel_cmd },
     { "register", "Get/Set value(s) of registers of sx127x", register_cmd },
     { "send",     "Send raw payload string",                 send_cmd },
-    { "listen",   "Start raw payload listener",              listen_cmd },
+    { "listen",   "Start raw payload listener [sniff]",      listen_cmd },
     { NULL, NULL, NULL }
 };
 
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the throughput of synchronous and asynchronous QoS 1
+ *              publishing with emCute
+ *
+ * A minimal MQTT-SN gateway runs on the loopback interface and delays every
+ * PUBACK by a configurable round-trip time.
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "kernel_defines.h"
+#include "mutex.h"
+#include "net/emcute.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define GW_PORT             (10000U)
+#define GW_ACKS_NUMOF       (16U)
+#define TOPIC_ID            (0x0042U)
+#define PUB_NUMOF           (10U)
+
+/* MQTT-SN message types used by the gateway */
+#define MSG_CONNECT         (0x04)
+#define MSG_CONNACK         (0x05)
+#define MSG_REGISTER        (0x0a)
+#define MSG_REGACK          (0x0b)
+#define MSG_PUBLISH         (0x0c)
+#define MSG_PUBACK          (0x0d)
+#define MSG_DISCONNECT      (0x18)
+
+typedef struct {
+    uint32_t due;
+    uint8_t pkt[7];
+} delayed_ack_t;
+
+static const unsigned _rtts_ms[] = { 10, 100, 500 };
+
+static char _gw_stack[THREAD_STACKSIZE_DEFAULT];
+static char _emcute_stack[THREAD_STACKSIZE_DEFAULT];
+
+static sock_udp_t _gw_sock;
+static uint8_t _gw_buf[EMCUTE_BUFSIZE];
+static delayed_ack_t _gw_acks[GW_ACKS_NUMOF];
+static unsigned _gw_acks_head, _gw_acks_len;
+static volatile uint32_t _gw_rtt;
+
+static mutex_t _done = MUTEX_INIT_LOCKED;
+static volatile unsigned _pub_done, _pub_failed;
+
+static void _gw_send(const void *pkt, size_t len, const sock_udp_ep_t *remote)
+{
+    sock_udp_send(&_gw_sock, pkt, len, remote);
+}
+
+static void _gw_handle(size_t len, const sock_udp_ep_t *remote)
+{
+    if ((len < 2) || (_gw_buf[0] != len)) {
+        return;
+    }
+    switch (_gw_buf[1]) {
+        case MSG_CONNECT: {
+            uint8_t pkt[3] = { 3, MSG_CONNACK, 0 };
+            _gw_send(pkt, sizeof(pkt), remote);
+            break;
+        }
+        case MSG_REGISTER: {
+            uint8_t pkt[7] = { 7, MSG_REGACK, 0, 0, 0, 0, 0 };
+            byteorder_htobebufs(&pkt[2], TOPIC_ID);
+            memcpy(&pkt[4], &_gw_buf[4], 2);
+            _gw_send(pkt, sizeof(pkt), remote);
+            break;
+        }
+        case MSG_PUBLISH: {
+            if (!(_gw_buf[2] & EMCUTE_QOS_1) ||
+                (_gw_acks_len == GW_ACKS_NUMOF)) {
+                break;
+            }
+            /* acknowledge after the round-trip time */
+            delayed_ack_t *ack = &_gw_acks[(_gw_acks_head + _gw_acks_len) %
+                                           GW_ACKS_NUMOF];
+            ack->due = xtimer_now_usec() + _gw_rtt;
+            ack->pkt[0] = 7;
+            ack->pkt[1] = MSG_PUBACK;
+            memcpy(&ack->pkt[2], &_gw_buf[3], 4);
+            ack->pkt[6] = 0;
+            _gw_acks_len++;
+            break;
+        }
+        case MSG_DISCONNECT: {
+            uint8_t pkt[2] = { 2, MSG_DISCONNECT };
+            _gw_send(pkt, sizeof(pkt), remote);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void *_gw_thread(void *arg)
+{
+    (void)arg;
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_ep_t remote = SOCK_IPV6_EP_ANY;
+
+    local.port = GW_PORT;
+    sock_udp_create(&_gw_sock, &local, NULL, 0);
+
+    while (1) {
+        uint32_t timeout = SOCK_NO_TIMEOUT;
+
+        if (_gw_acks_len) {
+            int32_t left = (int32_t)(_gw_acks[_gw_acks_head].due -
+                                     xtimer_now_usec());
+            timeout = (left > 0) ? (uint32_t)left : 0;
+        }
+
+        sock_udp_ep_t from;
+        ssize_t res = sock_udp_recv(&_gw_sock, _gw_buf, sizeof(_gw_buf),
+                                    timeout, &from);
+        if (res > 0) {
+            remote = from;
+            _gw_handle(res, &remote);
+        }
+
+        /* PUBACKs are due in the order of their PUBLISH */
+        while (_gw_acks_len &&
+               ((int32_t)(_gw_acks[_gw_acks_head].due -
+                          xtimer_now_usec()) <= 0)) {
+            _gw_send(_gw_acks[_gw_acks_head].pkt, 7, &remote);
+            _gw_acks_head = (_gw_acks_head + 1) % GW_ACKS_NUMOF;
+            _gw_acks_len--;
+        }
+    }
+    return NULL;
+}
+
+static void *_emcute_thread(void *arg)
+{
+    (void)arg;
+    emcute_run(EMCUTE_DEFAULT_PORT, "test");
+    return NULL;
+}
+
+static void _on_pub(const emcute_topic_t *topic, int res, void *arg)
+{
+    (void)topic;
+    (void)arg;
+    if (res != EMCUTE_OK) {
+        _pub_failed++;
+    }
+    if (++_pub_done == PUB_NUMOF) {
+        mutex_unlock(&_done);
+    }
+}
+
+static uint32_t _run_sync(emcute_topic_t *topic)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < PUB_NUMOF; i++) {
+        if (emcute_pub(topic, &i, sizeof(i), EMCUTE_QOS_1) != EMCUTE_OK) {
+            _pub_failed++;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _run_async(emcute_topic_t *topic)
+{
+    uint32_t start = xtimer_now_usec();
+
+    _pub_done = 0;
+    for (unsigned i = 0; i < PUB_NUMOF; i++) {
+        int res = emcute_pub_async(topic, &i, sizeof(i), EMCUTE_QOS_1,
+                                   _on_pub, NULL);
+        if (res != EMCUTE_OK) {
+            _on_pub(topic, res, NULL);
+        }
+    }
+    mutex_lock(&_done);
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    sock_udp_ep_t gw = { .family = AF_INET6, .port = GW_PORT };
+    emcute_topic_t topic = { .name = "test/async" };
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&gw.addr.ipv6);
+
+    thread_create(_gw_stack, sizeof(_gw_stack), THREAD_PRIORITY_MAIN - 2, 0,
+                  _gw_thread, NULL, "gateway");
+    thread_create(_emcute_stack, sizeof(_emcute_stack),
+                  THREAD_PRIORITY_MAIN - 1, 0, _emcute_thread, NULL, "emcute");
+
+    if ((emcute_con(&gw, true, NULL, NULL, 0, 0) != EMCUTE_OK) ||
+        (emcute_reg(&topic) != EMCUTE_OK)) {
+        puts("FAILED: unable to connect to gateway");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_rtts_ms); i++) {
+        _gw_rtt = _rtts_ms[i] * US_PER_MS;
+
+        uint32_t sync = _run_sync(&topic);
+        uint32_t async = _run_async(&topic);
+
+        printf("RTT %u ms: sync %u msg/s, async %u msg/s\n", _rtts_ms[i],
+               (unsigned)((uint64_t)PUB_NUMOF * US_PER_SEC / sync),
+               (unsigned)((uint64_t)PUB_NUMOF * US_PER_SEC / async));
+    }
+
+    if (_pub_failed || emcute_pub_inflight() ||
+        (emcute_discon() != EMCUTE_OK)) {
+        printf("FAILED: %u messages failed\n", _pub_failed);
+        return 1;
+    }
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+RTTS = (10, 100, 500)
+
+
+def testfunc(child):
+    for rtt in RTTS:
+        child.expect(r"RTT {} ms: sync (\d+) msg/s, async (\d+) msg/s"
+                     .format(rtt))
+        sync = int(child.match.group(1))
+        async_ = int(child.match.group(2))
+        if rtt >= 100:
+            assert async_ > sync
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
@@ -19,9 +19,13 @@
  * @}
  */
 
+#include <stdio.h>
+
 #include "embUnit.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netreg.h"
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#include "net/ipv6/hdr.h"
 #include "rbuf.h"
 #include "xtimer.h"
 
@@ -34,6 +38,13 @@
 #define TEST_PAGE               (0)
 #define TEST_RECEIVE_TIMEOUT    (100U)
 #define TEST_GC_TIMEOUT         (RBUF_TIMEOUT + TEST_RECEIVE_TIMEOUT)
+#define TEST_MSG_QUEUE_SIZE     (4U)
+#define TEST_NEXT_HOP           { 0xc2, 0x37, 0x1e, 0x05, \
+                                  0x8a, 0x11, 0x63, 0x90 }
+/* number of forwarding hops in the line topology */
+#define TEST_LINE_HOPS          (4U)
+/* airtime of a full 802.15.4 frame at 250 kbit/s */
+#define TEST_FRAME_AIRTIME      (4256U)
 
 /* test date taken from an experimental run (uncompressed ICMPv6 echo reply with
  * 300 byte payload)*/
@@ -163,7 +174,9 @@ static uint8_t _fragment2[] = TEST_FRAGMENT2;
 static uint8_t _fragment3[] = TEST_FRAGMENT3;
 static uint8_t _fragment4[] = TEST_FRAGMENT4;
 static const uint8_t _datagram[] = TEST_DATAGRAM;
-static msg_t _msg_queue;
+static const uint8_t _test_next_hop[] = TEST_NEXT_HOP;
+static gnrc_netif_t _test_out_netif;
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
 
 static inline void _set_fragment_tag(void *frag, uint16_t tag)
 {
@@ -184,6 +197,10 @@ static inline void _set_fragment_offset(void *frag, uint16_t offset)
 static void _set_up(void)
 {
     rbuf_reset();
+    gnrc_sixlowpan_frag_vrb_reset();
+    /* the test thread acts as outgoing interface */
+    memset(&_test_out_netif, 0, sizeof(_test_out_netif));
+    _test_out_netif.pid = sched_active_pid;
     gnrc_pktbuf_init();
     gnrc_netif_hdr_init(&_test_netif_hdr.hdr,
                         GNRC_NETIF_HDR_L2ADDR_MAX_LEN,
@@ -545,6 +562,286 @@ static void test_rbuf_gc__timed(void)
     _check_pktbuf(NULL);
 }
 
+static gnrc_sixlowpan_frag_vrb_t *_vrb_add(const uint8_t *src, uint16_t tag,
+                                           const uint8_t *out_dst)
+{
+    return gnrc_sixlowpan_frag_vrb_add(src, sizeof(_test_netif_hdr_src), tag,
+                                       TEST_DATAGRAM_SIZE, &_test_out_netif,
+                                       out_dst, sizeof(_test_next_hop));
+}
+
+/* receives a fragment sent to _test_out_netif and strips its netif header */
+static void _recv_forwarded(const uint8_t *exp_dst, gnrc_pktsnip_t **res)
+{
+    msg_t msg = { .type = 0U };
+    gnrc_pktsnip_t *pkt;
+    gnrc_netif_hdr_t *hdr;
+
+    *res = NULL;
+    TEST_ASSERT_MESSAGE(
+            xtimer_msg_receive_timeout(&msg, TEST_RECEIVE_TIMEOUT) >= 0,
+            "Receiving forwarded fragment timed out"
+        );
+    TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_SND, msg.type);
+    pkt = msg.content.ptr;
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_NETIF, pkt->type);
+    hdr = pkt->data;
+    TEST_ASSERT_EQUAL_INT(_test_out_netif.pid, hdr->if_pid);
+    TEST_ASSERT_EQUAL_INT(sizeof(_test_next_hop), hdr->dst_l2addr_len);
+    TEST_ASSERT_MESSAGE(memcmp(gnrc_netif_hdr_get_dst_addr(hdr), exp_dst,
+                               hdr->dst_l2addr_len) == 0,
+                        "Fragment not sent to next hop");
+    pkt = gnrc_pktbuf_remove_snip(pkt, pkt);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NULL(pkt->next);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_SIXLOWPAN, pkt->type);
+    *res = pkt;
+}
+
+static void test_vrb_add__success(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrb = _vrb_add(_test_netif_hdr_src, TEST_TAG,
+                                              _test_next_hop);
+
+    TEST_ASSERT_NOT_NULL(vrb);
+    TEST_ASSERT(vrb == gnrc_sixlowpan_frag_vrb_get(_test_netif_hdr_src,
+                                                   sizeof(_test_netif_hdr_src),
+                                                   TEST_DATAGRAM_SIZE,
+                                                   TEST_TAG));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_netif_hdr_src,
+                                                 sizeof(_test_netif_hdr_src),
+                                                 TEST_DATAGRAM_SIZE,
+                                                 TEST_TAG + 1));
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_next_hop,
+                                                 sizeof(_test_next_hop),
+                                                 TEST_DATAGRAM_SIZE,
+                                                 TEST_TAG));
+    TEST_ASSERT(&_test_out_netif == vrb->out_netif);
+    TEST_ASSERT_EQUAL_INT(0, vrb->forwarded);
+    TEST_ASSERT(!vrb->first_sent);
+}
+
+static void test_vrb_gc__manually(void)
+{
+    gnrc_sixlowpan_frag_vrb_t *vrb = _vrb_add(_test_netif_hdr_src, TEST_TAG,
+                                              _test_next_hop);
+
+    TEST_ASSERT_NOT_NULL(vrb);
+    vrb->arrival -= GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT + 1;
+    gnrc_sixlowpan_frag_vrb_gc();
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_netif_hdr_src,
+                                                 sizeof(_test_netif_hdr_src),
+                                                 TEST_DATAGRAM_SIZE,
+                                                 TEST_TAG));
+}
+
+static void test_rbuf_add__vrb_forward_first_fragment(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _fragment1, sizeof(_fragment1),
+                                          GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_sixlowpan_frag_vrb_t *vrb = _vrb_add(_test_netif_hdr_src, TEST_TAG,
+                                              _test_next_hop);
+    sixlowpan_frag_t *frag;
+    uint8_t *data;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL(vrb);
+    rbuf_add(&_test_netif_hdr.hdr, pkt, TEST_FRAGMENT1_OFFSET, TEST_PAGE);
+    /* first fragment is not kept for reassembly */
+    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    TEST_ASSERT(vrb->first_sent);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT2_OFFSET, vrb->forwarded);
+    _recv_forwarded(_test_next_hop, &pkt);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(sizeof(_fragment1), pkt->size);
+    frag = pkt->data;
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_FRAG_1_DISP,
+                          frag->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK);
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE,
+                          byteorder_ntohs(frag->disp_size) &
+                          SIXLOWPAN_FRAG_SIZE_MASK);
+    TEST_ASSERT_EQUAL_INT(vrb->out_tag, byteorder_ntohs(frag->tag));
+    data = (uint8_t *)(frag + 1);
+    /* uncompressed dispatch and IPv6 header with decremented hop limit */
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_UNCOMP, data[0]);
+    TEST_ASSERT_EQUAL_INT(_datagram[7] - 1,
+                          ((ipv6_hdr_t *)&data[1])->hl);
+    TEST_ASSERT_MESSAGE(memcmp(&data[1], _datagram, 7) == 0,
+                        "Forwarded IPv6 header differs");
+    TEST_ASSERT_MESSAGE(memcmp(&data[1 + 8], &_datagram[8],
+                               TEST_FRAGMENT2_OFFSET - 8) == 0,
+                        "Forwarded first fragment differs");
+    gnrc_pktbuf_release(pkt);
+    _check_pktbuf(NULL);
+}
+
+static void test_rbuf_add__vrb_forward_subsequent_fragment(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _fragment2, sizeof(_fragment2),
+                                          GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_sixlowpan_frag_vrb_t *vrb = _vrb_add(_test_netif_hdr_src, TEST_TAG,
+                                              _test_next_hop);
+    sixlowpan_frag_n_t *frag;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL(vrb);
+    rbuf_add(&_test_netif_hdr.hdr, pkt, TEST_FRAGMENT2_OFFSET, TEST_PAGE);
+    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    TEST_ASSERT_EQUAL_INT(sizeof(_fragment2) - sizeof(sixlowpan_frag_n_t),
+                          vrb->forwarded);
+    _recv_forwarded(_test_next_hop, &pkt);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(sizeof(_fragment2), pkt->size);
+    frag = pkt->data;
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_FRAG_N_DISP,
+                          frag->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK);
+    TEST_ASSERT_EQUAL_INT(vrb->out_tag, byteorder_ntohs(frag->tag));
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT2_OFFSET / 8, frag->offset);
+    TEST_ASSERT_MESSAGE(memcmp(frag + 1, &_fragment2[sizeof(*frag)],
+                               sizeof(_fragment2) - sizeof(*frag)) == 0,
+                        "Forwarded fragment payload differs");
+    gnrc_pktbuf_release(pkt);
+    _check_pktbuf(NULL);
+}
+
+static void test_rbuf_add__vrb_forward_duplicate(void)
+{
+    msg_t msg = { .type = 0U };
+    gnrc_pktsnip_t *pkt;
+    gnrc_sixlowpan_frag_vrb_t *vrb = _vrb_add(_test_netif_hdr_src, TEST_TAG,
+                                              _test_next_hop);
+
+    TEST_ASSERT_NOT_NULL(vrb);
+    for (unsigned i = 0; i < 2; i++) {
+        pkt = gnrc_pktbuf_add(NULL, _fragment2, sizeof(_fragment2),
+                              GNRC_NETTYPE_SIXLOWPAN);
+        TEST_ASSERT_NOT_NULL(pkt);
+        rbuf_add(&_test_netif_hdr.hdr, pkt, TEST_FRAGMENT2_OFFSET, TEST_PAGE);
+    }
+    /* the duplicate is neither counted nor forwarded */
+    TEST_ASSERT_EQUAL_INT(sizeof(_fragment2) - sizeof(sixlowpan_frag_n_t),
+                          vrb->forwarded);
+    TEST_ASSERT(vrb == gnrc_sixlowpan_frag_vrb_get(_test_netif_hdr_src,
+                                                   sizeof(_test_netif_hdr_src),
+                                                   TEST_DATAGRAM_SIZE,
+                                                   TEST_TAG));
+    _recv_forwarded(_test_next_hop, &pkt);
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_MESSAGE(
+            xtimer_msg_receive_timeout(&msg, TEST_RECEIVE_TIMEOUT) < 0,
+            "Duplicate fragment was forwarded"
+        );
+    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    _check_pktbuf(NULL);
+}
+
+static void test_rbuf_add__vrb_forward_complete(void)
+{
+    uint8_t *fragments[] = { _fragment1, _fragment2, _fragment3, _fragment4 };
+    const size_t sizes[] = { sizeof(_fragment1), sizeof(_fragment2),
+                             sizeof(_fragment3), sizeof(_fragment4) };
+    const size_t offsets[] = { TEST_FRAGMENT1_OFFSET, TEST_FRAGMENT2_OFFSET,
+                               TEST_FRAGMENT3_OFFSET, TEST_FRAGMENT4_OFFSET };
+
+    TEST_ASSERT_NOT_NULL(_vrb_add(_test_netif_hdr_src, TEST_TAG,
+                                  _test_next_hop));
+    for (unsigned i = 0; i < ARRAY_SIZE(fragments); i++) {
+        gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, fragments[i], sizes[i],
+                                              GNRC_NETTYPE_SIXLOWPAN);
+
+        TEST_ASSERT_NOT_NULL(pkt);
+        rbuf_add(&_test_netif_hdr.hdr, pkt, offsets[i], TEST_PAGE);
+        _recv_forwarded(_test_next_hop, &pkt);
+        TEST_ASSERT_NOT_NULL(pkt);
+        gnrc_pktbuf_release(pkt);
+    }
+    /* entry is removed once the whole datagram was forwarded */
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_test_netif_hdr_src,
+                                                 sizeof(_test_netif_hdr_src),
+                                                 TEST_DATAGRAM_SIZE,
+                                                 TEST_TAG));
+    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    _check_pktbuf(NULL);
+}
+
+/*
+ * Relays the datagram over a line of TEST_LINE_HOPS routers, all simulated by
+ * this node with one virtual reassembly buffer entry per hop, and compares the
+ * time until the last fragment leaves the last router with the time it takes
+ * when every router reassembles the datagram first. Every frame takes
+ * TEST_FRAME_AIRTIME on the air plus the measured processing time and a
+ * router can only send one frame at a time.
+ */
+static void test_rbuf_add__vrb_line_latency(void)
+{
+    uint8_t *fragments[] = { _fragment1, _fragment2, _fragment3, _fragment4 };
+    const size_t sizes[] = { sizeof(_fragment1), sizeof(_fragment2),
+                             sizeof(_fragment3), sizeof(_fragment4) };
+    const size_t offsets[] = { TEST_FRAGMENT1_OFFSET, TEST_FRAGMENT2_OFFSET,
+                               TEST_FRAGMENT3_OFFSET, TEST_FRAGMENT4_OFFSET };
+    uint8_t addrs[TEST_LINE_HOPS + 2][sizeof(_test_netif_hdr_src)];
+    uint16_t tags[TEST_LINE_HOPS + 1];
+    /* time the current fragment arrived at each hop */
+    uint32_t arrival[TEST_LINE_HOPS + 2] = { 0 };
+    uint32_t vrb_latency, reass_latency;
+
+    /* node 0 is the source, node TEST_LINE_HOPS + 1 the destination */
+    for (unsigned h = 0; h < ARRAY_SIZE(addrs); h++) {
+        memcpy(addrs[h], _test_netif_hdr_src, sizeof(addrs[h]));
+        addrs[h][sizeof(addrs[h]) - 1] = h;
+    }
+    tags[0] = TEST_TAG;
+    for (unsigned h = 1; h <= TEST_LINE_HOPS; h++) {
+        gnrc_sixlowpan_frag_vrb_t *vrb = _vrb_add(addrs[h - 1], tags[h - 1],
+                                                  addrs[h + 1]);
+
+        TEST_ASSERT_NOT_NULL(vrb);
+        tags[h] = vrb->out_tag;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(fragments); i++) {
+        gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, fragments[i], sizes[i],
+                                              GNRC_NETTYPE_SIXLOWPAN);
+
+        TEST_ASSERT_NOT_NULL(pkt);
+        /* the source sends its fragments back to back */
+        arrival[1] = (i + 1) * TEST_FRAME_AIRTIME;
+        for (unsigned h = 1; h <= TEST_LINE_HOPS; h++) {
+            uint32_t start;
+            sixlowpan_frag_t *frag;
+
+            gnrc_netif_hdr_set_src_addr(&_test_netif_hdr.hdr, addrs[h - 1],
+                                        sizeof(addrs[h - 1]));
+            start = xtimer_now_usec();
+            rbuf_add(&_test_netif_hdr.hdr, pkt, offsets[i], TEST_PAGE);
+            _recv_forwarded(addrs[h + 1], &pkt);
+            TEST_ASSERT_NOT_NULL(pkt);
+            frag = pkt->data;
+            TEST_ASSERT_EQUAL_INT(tags[h], byteorder_ntohs(frag->tag));
+            /* the next hop receives the fragment when this hop finished
+             * processing it and sending the previous one */
+            start = xtimer_now_usec() - start;
+            if (arrival[h + 1] < arrival[h] + start) {
+                arrival[h + 1] = arrival[h] + start;
+            }
+            arrival[h + 1] += TEST_FRAME_AIRTIME;
+        }
+        TEST_ASSERT_EQUAL_INT(sizes[i], pkt->size);
+        gnrc_pktbuf_release(pkt);
+    }
+    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    _check_pktbuf(NULL);
+    vrb_latency = arrival[TEST_LINE_HOPS + 1];
+    /* with reassembly each hop sends all fragments after receiving the last */
+    reass_latency = (TEST_LINE_HOPS + 1) * ARRAY_SIZE(fragments) *
+                    TEST_FRAME_AIRTIME;
+    printf("\n%u hops, %u fragments: %" PRIu32 " us forwarding, %" PRIu32
+           " us reassembling\n", TEST_LINE_HOPS,
+           (unsigned)ARRAY_SIZE(fragments), vrb_latency, reass_latency);
+    TEST_ASSERT(vrb_latency < reass_latency);
+}
+
 static void run_unittests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -559,6 +856,13 @@ static void run_unittests(void)
         new_TestFixture(test_rbuf_rm),
         new_TestFixture(test_rbuf_gc__manually),
         new_TestFixture(test_rbuf_gc__timed),
+        new_TestFixture(test_vrb_add__success),
+        new_TestFixture(test_vrb_gc__manually),
+        new_TestFixture(test_rbuf_add__vrb_forward_first_fragment),
+        new_TestFixture(test_rbuf_add__vrb_forward_subsequent_fragment),
+        new_TestFixture(test_rbuf_add__vrb_forward_duplicate),
+        new_TestFixture(test_rbuf_add__vrb_forward_complete),
+        new_TestFixture(test_rbuf_add__vrb_line_latency),
     };
 
     EMB_UNIT_TESTCALLER(sixlo_frag_tests, _set_up, NULL, fixtures);
@@ -571,8 +875,9 @@ int main(void)
 {
     /* no auto-init, so xtimer needs to be initialized manually*/
     xtimer_init();
-    /* netreg requires queue, but queue size one should be enough for us */
-    msg_init_queue(&_msg_queue, 1U);
+    /* netreg requires queue, forwarded fragments are also sent to this
+     * thread so leave some room for the GC timer message */
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
     run_unittests();
     return 0;
 }
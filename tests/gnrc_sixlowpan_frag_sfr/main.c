@@ -0,0 +1,355 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the goodput of RFC 4944 fragmentation and selective
+ *              fragment recovery over a lossy link
+ *
+ * Two IEEE 802.15.4 interfaces are connected by a simulated link that drops
+ * every frame with a fixed probability. Datagrams of the minimum IPv6 MTU are
+ * sent from one to the other until they are delivered, retrying the whole
+ * datagram on timeout like an upper layer would.
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "msg.h"
+#include "mutex.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/ieee802154.h"
+#include "net/ipv6.h"
+#include "net/ipv6/addr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define TEST_MAX_FRAG_SIZE      (102U)
+#define TEST_FIFO_SIZE          (8U)
+#define TEST_LOSS_PERCENT       (8U)
+#define TEST_DATAGRAMS          (4U)
+#define TEST_ATTEMPTS           (20U)
+#define TEST_DATAGRAM_TIMEOUT   (300U * US_PER_MS)
+#define TEST_SEED               (0x5eedU)
+/* time on air of a byte at 250 kbit/s */
+#define TEST_BYTE_AIRTIME_US    (32U)
+/* synchronization header, PHY header and FCS */
+#define TEST_PHY_OVERHEAD       (8U)
+#define TEST_PAYLOAD_SIZE       (IPV6_MIN_MTU - sizeof(ipv6_hdr_t))
+#define TEST_MSG_QUEUE_SIZE     (8U)
+
+typedef struct node _node_t;
+
+struct node {
+    netdev_test_t dev;
+    _node_t *peer;
+    mutex_t lock;
+    uint8_t frames[TEST_FIFO_SIZE][IEEE802154_FRAME_LEN_MAX];
+    uint8_t lens[TEST_FIFO_SIZE];
+    uint8_t head;
+    uint8_t count;
+    uint8_t eui64[IEEE802154_LONG_ADDRESS_LEN];
+    gnrc_netif_t *netif;
+    char stack[THREAD_STACKSIZE_DEFAULT];
+};
+
+static _node_t _nodes[2] = {
+    { .eui64 = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 } },
+    { .eui64 = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02 } },
+};
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+static uint8_t _payload[TEST_PAYLOAD_SIZE];
+static uint32_t _rand_state;
+static uint32_t _airtime_us;
+static unsigned _frames_sent, _frames_lost;
+
+static unsigned _rand_percent(void)
+{
+    /* deterministic LCG, so both modes see comparable loss patterns */
+    _rand_state = (_rand_state * 1103515245U) + 12345U;
+    return (_rand_state >> 16) % 100U;
+}
+
+static int _netdev_send(netdev_t *netdev, const iolist_t *iolist)
+{
+    _node_t *node = container_of((netdev_test_t *)netdev, _node_t, dev);
+    _node_t *peer = node->peer;
+    size_t len = iolist_size(iolist);
+    bool lost;
+
+    if (len > IEEE802154_FRAME_LEN_MAX) {
+        return -EMSGSIZE;
+    }
+    _airtime_us += (len + TEST_PHY_OVERHEAD) * TEST_BYTE_AIRTIME_US;
+    _frames_sent++;
+    lost = (_rand_percent() < TEST_LOSS_PERCENT);
+    mutex_lock(&peer->lock);
+    if (lost || (peer->count >= TEST_FIFO_SIZE)) {
+        _frames_lost++;
+        mutex_unlock(&peer->lock);
+        return len;
+    }
+    uint8_t *frame = peer->frames[(peer->head + peer->count) % TEST_FIFO_SIZE];
+
+    peer->lens[(peer->head + peer->count) % TEST_FIFO_SIZE] = len;
+    for (const iolist_t *iol = iolist; iol != NULL; iol = iol->iol_next) {
+        memcpy(frame, iol->iol_base, iol->iol_len);
+        frame += iol->iol_len;
+    }
+    peer->count++;
+    mutex_unlock(&peer->lock);
+    ((netdev_t *)&peer->dev)->event_callback((netdev_t *)&peer->dev,
+                                             NETDEV_EVENT_ISR);
+    return len;
+}
+
+static int _netdev_recv(netdev_t *netdev, char *buf, int len, void *info)
+{
+    _node_t *node = container_of((netdev_test_t *)netdev, _node_t, dev);
+    int res;
+
+    mutex_lock(&node->lock);
+    if (node->count == 0) {
+        mutex_unlock(&node->lock);
+        return 0;
+    }
+    res = node->lens[node->head];
+    if (buf == NULL) {
+        if (len > 0) {
+            /* drop frame */
+            node->head = (node->head + 1) % TEST_FIFO_SIZE;
+            node->count--;
+        }
+        mutex_unlock(&node->lock);
+        return res;
+    }
+    if (res > len) {
+        res = -ENOBUFS;
+    }
+    else {
+        memcpy(buf, node->frames[node->head], res);
+        if (info != NULL) {
+            netdev_ieee802154_rx_info_t *rx_info = info;
+
+            rx_info->rssi = 0;
+            rx_info->lqi = 0xff;
+        }
+    }
+    node->head = (node->head + 1) % TEST_FIFO_SIZE;
+    node->count--;
+    mutex_unlock(&node->lock);
+    return res;
+}
+
+static void _netdev_isr(netdev_t *netdev)
+{
+    netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+}
+
+static int _get_device_type(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = TEST_MAX_FRAG_SIZE;
+    return sizeof(uint16_t);
+}
+
+static int _get_src_len(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = IEEE802154_LONG_ADDRESS_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _get_addr_long(netdev_t *netdev, void *value, size_t max_len)
+{
+    _node_t *node = container_of((netdev_test_t *)netdev, _node_t, dev);
+
+    assert(max_len >= sizeof(node->eui64));
+    memcpy(value, node->eui64, sizeof(node->eui64));
+    return sizeof(node->eui64);
+}
+
+static int _get_proto(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(gnrc_nettype_t));
+    (void)netdev;
+
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static void _init_node(_node_t *node, _node_t *peer, const char *name)
+{
+    netdev_test_t *dev = &node->dev;
+
+    node->peer = peer;
+    mutex_init(&node->lock);
+    netdev_test_setup(dev, NULL);
+    netdev_test_set_send_cb(dev, _netdev_send);
+    netdev_test_set_recv_cb(dev, _netdev_recv);
+    netdev_test_set_isr_cb(dev, _netdev_isr);
+    netdev_test_set_get_cb(dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(dev, NETOPT_MAX_PACKET_SIZE, _get_max_packet_size);
+    netdev_test_set_get_cb(dev, NETOPT_SRC_LEN, _get_src_len);
+    netdev_test_set_get_cb(dev, NETOPT_ADDRESS_LONG, _get_addr_long);
+    netdev_test_set_get_cb(dev, NETOPT_PROTO, _get_proto);
+    node->netif = gnrc_netif_ieee802154_create(node->stack, sizeof(node->stack),
+                                               GNRC_NETIF_PRIO, (char *)name,
+                                               (netdev_t *)dev);
+}
+
+static int _send_datagram(uint8_t seq)
+{
+    ipv6_addr_t src = { .u8 = { 0xfd, 0x01, [15] = 0x01 } };
+    ipv6_addr_t dst = { .u8 = { 0xfd, 0x01, [15] = 0x02 } };
+    gnrc_pktsnip_t *payload, *ipv6, *netif;
+    ipv6_hdr_t *hdr;
+
+    memset(_payload, seq, sizeof(_payload));
+    payload = gnrc_pktbuf_add(NULL, _payload, sizeof(_payload),
+                              GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return -1;
+    }
+    ipv6 = gnrc_ipv6_hdr_build(payload, &src, &dst);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return -1;
+    }
+    hdr = ipv6->data;
+    hdr->len = byteorder_htons(sizeof(_payload));
+    hdr->nh = PROTNUM_IPV6_NONXT;
+    hdr->hl = 64;
+    netif = gnrc_netif_hdr_build(NULL, 0, _nodes[1].eui64,
+                                 sizeof(_nodes[1].eui64));
+    if (netif == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return -1;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _nodes[0].netif->pid;
+    LL_PREPEND(ipv6, netif);
+    if (gnrc_netapi_dispatch_send(GNRC_NETTYPE_SIXLOWPAN,
+                                  GNRC_NETREG_DEMUX_CTX_ALL, netif) == 0) {
+        gnrc_pktbuf_release(netif);
+        return -1;
+    }
+    return 0;
+}
+
+static bool _delivered(uint8_t seq)
+{
+    msg_t msg;
+
+    while (xtimer_msg_receive_timeout(&msg, TEST_DATAGRAM_TIMEOUT) >= 0) {
+        gnrc_pktsnip_t *pkt = msg.content.ptr;
+        bool res = false;
+
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_RCV) {
+            continue;
+        }
+        /* the reassembled datagram is in one snip */
+        if ((pkt->size == IPV6_MIN_MTU) &&
+            (((uint8_t *)pkt->data)[sizeof(ipv6_hdr_t)] == seq)) {
+            res = true;
+        }
+        gnrc_pktbuf_release(pkt);
+        if (res) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static unsigned _run(const char *mode, netopt_enable_t sfr)
+{
+    unsigned delivered = 0, attempts = 0;
+    uint32_t goodput;
+
+    gnrc_netapi_set(_nodes[0].netif->pid, NETOPT_6LO_SFR, 0, &sfr,
+                    sizeof(sfr));
+    _rand_state = TEST_SEED;
+    _airtime_us = 0;
+    _frames_sent = 0;
+    _frames_lost = 0;
+    for (unsigned i = 0; i < TEST_DATAGRAMS; i++) {
+        for (unsigned j = 0; j < TEST_ATTEMPTS; j++) {
+            attempts++;
+            if (_send_datagram(i) < 0) {
+                puts("error: unable to send datagram");
+                continue;
+            }
+            if (_delivered(i)) {
+                delivered++;
+                break;
+            }
+        }
+    }
+    /* let trailing acknowledgments settle */
+    xtimer_usleep(TEST_DATAGRAM_TIMEOUT);
+    goodput = (uint32_t)(((uint64_t)delivered * IPV6_MIN_MTU * 8U * 1000U) /
+                         (_airtime_us ? _airtime_us : 1));
+    printf("%s: %u/%u datagrams in %u attempts, %u/%u frames lost, "
+           "airtime %" PRIu32 " us, goodput %" PRIu32 " kbit/s\n",
+           mode, delivered, TEST_DATAGRAMS, attempts, _frames_lost,
+           _frames_sent, _airtime_us, goodput);
+    return (delivered == TEST_DATAGRAMS) ? goodput : 0;
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t dump = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                          thread_getpid());
+    unsigned classic, sfr;
+
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    _init_node(&_nodes[0], &_nodes[1], "node_a");
+    _init_node(&_nodes[1], &_nodes[0], "node_b");
+    xtimer_usleep(500); /* wait for threads to start */
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &dump);
+
+    classic = _run("classic", NETOPT_DISABLE);
+    sfr = _run("sfr", NETOPT_ENABLE);
+    if ((classic > 0) && (sfr > classic)) {
+        puts("SUCCESS");
+    }
+    else {
+        puts("FAILURE");
+    }
+    return 0;
+}
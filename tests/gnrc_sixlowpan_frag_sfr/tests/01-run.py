@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"classic: (\d+)/(\d+) datagrams in \d+ attempts, "
+                 r"\d+/\d+ frames lost, airtime \d+ us, "
+                 r"goodput (\d+) kbit/s")
+    assert child.match.group(1) == child.match.group(2)
+    classic = int(child.match.group(3))
+    child.expect(r"sfr: (\d+)/(\d+) datagrams in \d+ attempts, "
+                 r"\d+/\d+ frames lost, airtime \d+ us, "
+                 r"goodput (\d+) kbit/s")
+    assert child.match.group(1) == child.match.group(2)
+    sfr = int(child.match.group(3))
+    assert sfr > classic
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
@@ -46,15 +46,24 @@ int main(void)
     puts("Configured network interfaces:");
     _gnrc_netif_config(0, NULL);
 
-    int res = sock_dns_query(TEST_NAME, addr, AF_UNSPEC);
-    if (res > 0) {
-        char addrstr[INET6_ADDRSTRLEN];
-        inet_ntop(res == 4 ? AF_INET : AF_INET6, addr, addrstr, sizeof(addrstr));
-        printf("%s resolves to %s\n", TEST_NAME, addrstr);
-    }
-    else {
-        printf("error resolving %s\n", TEST_NAME);
+    /* the second query is answered from the DNS cache */
+    for (unsigned i = 0; i < 2; i++) {
+        uint32_t start = xtimer_now_usec();
+        int res = sock_dns_query(TEST_NAME, addr, AF_UNSPEC);
+        uint32_t duration = xtimer_now_usec() - start;
+
+        if (res > 0) {
+            char addrstr[INET6_ADDRSTRLEN];
+            inet_ntop(res == 4 ? AF_INET : AF_INET6, addr, addrstr, sizeof(addrstr));
+            printf("%s resolves to %s (%" PRIu32 " us)\n", TEST_NAME, addrstr,
+                   duration);
+        }
+        else {
+            printf("error resolving %s\n", TEST_NAME);
+            return 0;
+        }
     }
+    sock_dns_cache_print();
 
     return 0;
 }
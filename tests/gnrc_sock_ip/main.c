@@ -244,6 +244,28 @@ static void test_sock_ip_recv__socketed(void)
     assert(_check_net());
 }
 
+static void test_sock_ip_recv_buf(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_ip_ep_t local = { .family = AF_INET6 };
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_ip_create(&_sock, &local, NULL, _TEST_PROTO,
+                               SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PROTO, "ABCD",
+                          sizeof("ABCD"), _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_ip_recv_buf(&_sock, &data, &ctx,
+                                              SOCK_NO_TIMEOUT, NULL));
+    assert(data != NULL);
+    assert(ctx != NULL);
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    assert(0 == sock_ip_recv_buf(&_sock, &data, &ctx, 0, NULL));
+    assert(data == NULL);
+    assert(ctx == NULL);
+    assert(_check_net());
+}
+
 static void test_sock_ip_recv__socketed_with_remote(void)
 {
     static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
@@ -464,6 +486,27 @@ static void test_sock_ip_send__socketed(void)
     assert(_check_net());
 }
 
+static void test_sock_ip_sendv(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_ip_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                        .family = AF_INET6,
+                                        .netif = _TEST_NETIF };
+    static const sock_ip_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                         .family = AF_INET6 };
+    iolist_t tail = { NULL, "CD", sizeof("CD") };
+    iolist_t head = { &tail, "AB", sizeof("AB") - 1 };
+
+    assert(0 == sock_ip_create(&_sock, &local, &remote, _TEST_PROTO,
+                               SOCK_FLAGS_REUSE_EP));
+    assert(sizeof("ABCD") == sock_ip_sendv(&_sock, &head, _TEST_PROTO, NULL));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PROTO, "ABCD",
+                         sizeof("ABCD"), _TEST_NETIF));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 static void test_sock_ip_send__socketed_other_remote(void)
 {
     static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
@@ -610,6 +653,7 @@ int main(void)
     CALL(test_sock_ip_recv__EPROTO());
     CALL(test_sock_ip_recv__ETIMEDOUT());
     CALL(test_sock_ip_recv__socketed());
+    CALL(test_sock_ip_recv_buf());
     CALL(test_sock_ip_recv__socketed_with_remote());
     CALL(test_sock_ip_recv__unsocketed());
     CALL(test_sock_ip_recv__unsocketed_with_remote());
@@ -625,6 +669,7 @@ int main(void)
     CALL(test_sock_ip_send__socketed_no_netif());
     CALL(test_sock_ip_send__socketed_no_local());
     CALL(test_sock_ip_send__socketed());
+    CALL(test_sock_ip_sendv());
     CALL(test_sock_ip_send__socketed_other_remote());
     CALL(test_sock_ip_send__unsocketed_no_local_no_netif());
     CALL(test_sock_ip_send__unsocketed_no_netif());
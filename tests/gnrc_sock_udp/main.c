@@ -133,6 +133,23 @@ static void test_sock_udp_create__only_local_port0(void)
     assert(-ENOTCONN == sock_udp_get_remote(&_sock, &ep));
 }
 
+static void test_sock_udp_create__only_local_port0_unique(void)
+{
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = 0U };
+    sock_udp_ep_t ep, ep2;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, 0));
+    assert(0 == sock_udp_create(&_sock2, &local, NULL, 0));
+    assert(0 == sock_udp_get_local(&_sock, &ep));
+    assert(0 == sock_udp_get_local(&_sock2, &ep2));
+    assert(0U != ep.port);
+    assert(0U != ep2.port);
+    assert(ep.port != ep2.port);
+    sock_udp_close(&_sock2);
+    memset(&_sock2, 0, sizeof(_sock2));
+}
+
 static void test_sock_udp_create__only_local_reuse_ep(void)
 {
     static const sock_udp_ep_t local = { .family = AF_INET6,
@@ -287,6 +304,32 @@ static void test_sock_udp_recv__socketed(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_buf(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result;
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx,
+                                               SOCK_NO_TIMEOUT, &result));
+    assert(data != NULL);
+    assert(ctx != NULL);
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    assert(AF_INET6 == result.family);
+    assert(_TEST_PORT_REMOTE == result.port);
+    assert(0 == sock_udp_recv_buf(&_sock, &data, &ctx, 0, NULL));
+    assert(data == NULL);
+    assert(ctx == NULL);
+    assert(_check_net());
+}
+
 static void test_sock_udp_recv__socketed_with_remote(void)
 {
     static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
@@ -557,6 +600,30 @@ static void test_sock_udp_send__socketed(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_sendv(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    iolist_t tail = { NULL, "CD", sizeof("CD") };
+    iolist_t empty = { &tail, NULL, 0 };
+    iolist_t head = { &empty, "AB", sizeof("AB") - 1 };
+
+    assert(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    assert(sizeof("ABCD") == sock_udp_sendv(&_sock, &head, NULL));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 static void test_sock_udp_send__socketed_other_remote(void)
 {
     static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
@@ -706,6 +773,7 @@ int main(void)
     CALL(test_sock_udp_create__no_endpoints());
     CALL(test_sock_udp_create__only_local());
     CALL(test_sock_udp_create__only_local_port0());
+    CALL(test_sock_udp_create__only_local_port0_unique());
     CALL(test_sock_udp_create__only_local_reuse_ep());
     CALL(test_sock_udp_create__only_remote());
     CALL(test_sock_udp_create__full());
@@ -718,6 +786,7 @@ int main(void)
     CALL(test_sock_udp_recv__EPROTO());
     CALL(test_sock_udp_recv__ETIMEDOUT());
     CALL(test_sock_udp_recv__socketed());
+    CALL(test_sock_udp_recv_buf());
     CALL(test_sock_udp_recv__socketed_with_remote());
     CALL(test_sock_udp_recv__socketed_with_port0());
     CALL(test_sock_udp_recv__unsocketed());
@@ -734,6 +803,7 @@ int main(void)
     CALL(test_sock_udp_send__socketed_no_netif());
     CALL(test_sock_udp_send__socketed_no_local());
     CALL(test_sock_udp_send__socketed());
+    CALL(test_sock_udp_sendv());
     CALL(test_sock_udp_send__socketed_other_remote());
     CALL(test_sock_udp_send__unsocketed_no_local_no_netif());
     CALL(test_sock_udp_send__unsocketed_no_netif());
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the SAUL sampler
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+
+#include "lptimer.h"
+#include "msg.h"
+#include "thread.h"
+#include "saul_sampler.h"
+
+#define PERIOD_FAST     (100U)
+#define PERIOD_SLOW     (300U)
+#define RUNTIME         (1000U)
+
+/* dummy sensors counting their reads */
+static unsigned reads[3];
+
+static int _read(const void *dev, phydat_t *res)
+{
+    unsigned *ctr = (unsigned *)dev;
+
+    res->val[0] = ++(*ctr);
+    res->unit = UNIT_NONE;
+    res->scale = 0;
+    return 1;
+}
+
+static const saul_driver_t _driver = {
+    .read = _read,
+    .write = saul_notsup,
+    .type = SAUL_SENSE_ANY,
+};
+
+static saul_reg_t devs[] = {
+    { .dev = &reads[0], .name = "a", .driver = &_driver },
+    { .dev = &reads[1], .name = "b", .driver = &_driver },
+    { .dev = &reads[2], .name = "c", .driver = &_driver },
+};
+
+static saul_sampler_sub_t subs[4];
+static msg_t queue[8];
+
+int main(void)
+{
+    saul_sample_t samples[SAUL_SAMPLER_BUFSIZE];
+    unsigned notified = 0;
+
+    puts("Test application for the SAUL sampler");
+    msg_init_queue(queue, 8);
+
+    for (unsigned i = 0; i < 3; i++) {
+        saul_reg_add(&devs[i]);
+    }
+
+    /* a and b share a period, a has a second, slower subscriber */
+    saul_sampler_subscribe(&subs[0], &devs[0], PERIOD_FAST, thread_getpid());
+    saul_sampler_subscribe(&subs[1], &devs[1], PERIOD_FAST, KERNEL_PID_UNDEF);
+    saul_sampler_subscribe(&subs[2], &devs[0], PERIOD_SLOW, KERNEL_PID_UNDEF);
+    saul_sampler_subscribe(&subs[3], &devs[2], PERIOD_SLOW, KERNEL_PID_UNDEF);
+
+    /* a subscribed sub is rejected, also for another device */
+    printf("resubscribe: %s\n",
+           ((saul_sampler_subscribe(&subs[2], &devs[0], PERIOD_SLOW,
+                                    KERNEL_PID_UNDEF) == -EALREADY) &&
+            (saul_sampler_subscribe(&subs[2], &devs[1], PERIOD_SLOW,
+                                    KERNEL_PID_UNDEF) == -EALREADY))
+           ? "OK" : "FAILED");
+
+    uint32_t start = lptimer_now_msec();
+    uint32_t elapsed = 0;
+    msg_t msg;
+    while (elapsed < RUNTIME) {
+        if ((lptimer_msg_receive_timeout(&msg, RUNTIME - elapsed) >= 0) &&
+            (msg.type == SAUL_SAMPLER_MSG_TYPE)) {
+            notified++;
+        }
+        elapsed = lptimer_now_msec() - start;
+    }
+
+    /* right after a sample, a has no read of its own */
+    msg_receive(&msg);
+    phydat_t res;
+    unsigned before = reads[0];
+    saul_sampler_read(&devs[0], &res, PERIOD_FAST);
+    printf("cached read: %s\n",
+           ((reads[0] == before) && (res.val[0] == (int)before)) ? "OK" : "FAILED");
+
+    printf("fast: %s\n", ((reads[0] >= 10) && (reads[0] <= 13) &&
+                          (reads[1] >= 10) && (reads[1] <= 13)) ? "OK" : "FAILED");
+    printf("slow: %s\n", ((reads[2] >= 4) && (reads[2] <= 5)) ? "OK" : "FAILED");
+    printf("notified: %s\n", (notified >= 9) ? "OK" : "FAILED");
+
+    int n = saul_sampler_window(&devs[1], samples, SAUL_SAMPLER_BUFSIZE,
+                                UINT32_MAX);
+    int ordered = (n == SAUL_SAMPLER_BUFSIZE);
+    for (int i = 1; i < n; i++) {
+        uint32_t diff = samples[i].time - samples[i - 1].time;
+        if ((samples[i].data.val[0] != samples[i - 1].data.val[0] + 1) ||
+            (diff < PERIOD_FAST - SAUL_SAMPLER_GROUP_MS) ||
+            (diff > PERIOD_FAST + SAUL_SAMPLER_GROUP_MS)) {
+            ordered = 0;
+        }
+    }
+    printf("window: %s\n", ordered ? "OK" : "FAILED");
+
+    saul_sample_t a, b;
+    saul_sampler_latest(&devs[0], &a);
+    saul_sampler_latest(&devs[1], &b);
+    printf("grouped: %s\n", (a.time == b.time) ? "OK" : "FAILED");
+
+    for (unsigned i = 0; i < 4; i++) {
+        saul_sampler_unsubscribe(&subs[i]);
+    }
+    printf("unsubscribed: %s\n",
+           (saul_sampler_latest(&devs[0], &a) == -ENODEV) ? "OK" : "FAILED");
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Test application for the SAUL sampler")
+    for check in ("resubscribe", "cached read", "fast", "slow", "notified", "window",
+                  "grouped", "unsubscribed"):
+        child.expect_exact("{}: OK".format(check))
+    child.expect_exact("Done.")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Short test application for fixed point decimation and
+ *              block statistics
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "dsp/int_stats/int_stats.h"
+
+#define CHANNELS        (2U)
+#define SCANS           (12U)
+#define DECIMATION      (4U)
+
+/* two channels interleaved like a DMA scan buffer: a noisy constant level
+ * and a square wave with a period of eight scans */
+static const uint16_t buf[SCANS * CHANNELS] = {
+    1000,    0,  1002,    0,   998,    0,  1000,    0,
+    1001, 2000,  1003, 2000,   999, 2000,  1001, 2000,
+    1000,    0,  1000,    0,  1000,    0,  1000,    0,
+};
+
+int main(void)
+{
+    int_decim_t decim[CHANNELS];
+    int_stats_t stats[CHANNELS];
+
+    puts("Test application for decimation and block statistics");
+
+    for (unsigned ch = 0; ch < CHANNELS; ch++) {
+        int_decim_init(&decim[ch], DECIMATION);
+        int_stats_reset(&stats[ch]);
+    }
+
+    /* process the buffer in two halves, as on DMA half and full transfer
+     * events; the halves do not end on a block boundary */
+    for (unsigned half = 0; half < 2; half++) {
+        const uint16_t *start = &buf[half * (SCANS / 2) * CHANNELS];
+        for (unsigned ch = 0; ch < CHANNELS; ch++) {
+            int_decim_process(&decim[ch], &stats[ch], start + ch,
+                              SCANS / 2, CHANNELS);
+        }
+    }
+
+    for (unsigned ch = 0; ch < CHANNELS; ch++) {
+        printf("ch%u: count %" PRIu32 " min %u mean %u max %u rms %u\n", ch,
+               stats[ch].count, stats[ch].min, int_stats_mean(&stats[ch]),
+               stats[ch].max, int_stats_rms(&stats[ch]));
+    }
+
+    int_stats_reset(&stats[0]);
+    printf("empty: count %" PRIu32 " mean %u rms %u\n", stats[0].count,
+           int_stats_mean(&stats[0]), int_stats_rms(&stats[0]));
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Test application for decimation and block statistics")
+    child.expect_exact("ch0: count 3 min 1000 mean 1000 max 1001 rms 1000")
+    child.expect_exact("ch1: count 3 min 0 mean 667 max 2000 rms 1154")
+    child.expect_exact("empty: count 0 mean 0 rms 0")
+    child.expect_exact("Done.")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -91,7 +91,7 @@ int main(void)
     while(!done) {};
 
     puts("main: setting 100ms timeout...");
-    xtimer_t t;
+    xtimer_t t = { 0 };
     uint32_t before = xtimer_now_usec();
     xtimer_set_timeout_flag(&t, TIMEOUT);
     thread_flags_wait_any(THREAD_FLAG_TIMEOUT);
@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+#include <stdint.h>
+
+#include "embUnit.h"
+#include "kernel_defines.h"
+#include "periph/async_queue.h"
+
+#include "tests-async_queue.h"
+
+#define TEST_DONE_NUMOF (8U)
+
+typedef struct {
+    async_queue_node_t node;
+    unsigned id;
+} _desc_t;
+
+static async_queue_t _queue;
+/* descriptors are left in progress by the fake bus */
+static bool _hold;
+static unsigned _begin_numof;
+static unsigned _end_numof;
+static unsigned _start_numof;
+static unsigned _done[TEST_DONE_NUMOF];
+static unsigned _done_numof;
+static _desc_t *_resubmit;
+
+static void _begin(async_queue_t *q, async_queue_node_t *first)
+{
+    (void)first;
+    TEST_ASSERT(q == &_queue);
+    TEST_ASSERT(async_queue_busy(q));
+    _begin_numof++;
+}
+
+static int _start(async_queue_t *q, async_queue_node_t *node)
+{
+    (void)q;
+    (void)node;
+    _start_numof++;
+    return _hold ? 0 : 1;
+}
+
+static void _done_cb(async_queue_t *q, async_queue_node_t *node);
+
+static void _end(async_queue_t *q)
+{
+    TEST_ASSERT(!async_queue_busy(q));
+    _end_numof++;
+}
+
+static const async_queue_ops_t _ops = {
+    .begin = _begin,
+    .start = _start,
+    .done = _done_cb,
+    .end = _end,
+};
+
+static void _done_cb(async_queue_t *q, async_queue_node_t *node)
+{
+    if (_done_numof < TEST_DONE_NUMOF) {
+        _done[_done_numof++] = container_of(node, _desc_t, node)->id;
+    }
+    if (_resubmit) {
+        _desc_t *next = _resubmit;
+
+        _resubmit = NULL;
+        TEST_ASSERT_EQUAL_INT(0, async_queue_submit(q, &_ops, &next->node,
+                                                    &next->node));
+    }
+}
+
+static int _submit(_desc_t *desc, unsigned numof)
+{
+    for (unsigned i = 0; i < (numof - 1); i++) {
+        desc[i].node.next = &desc[i + 1].node;
+    }
+    return async_queue_submit(&_queue, &_ops, &desc->node,
+                              &desc[numof - 1].node);
+}
+
+/* completes the descriptor in progress like an interrupt of the bus */
+static bool _complete(void)
+{
+    if (!async_queue_busy(&_queue)) {
+        return false;
+    }
+    async_queue_isr_done(&_queue, &_ops);
+    return true;
+}
+
+static void _init(_desc_t *desc, unsigned numof, unsigned id)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        desc[i].node.next = NULL;
+        desc[i].id = id + i;
+    }
+}
+
+static void _assert_order(unsigned numof)
+{
+    TEST_ASSERT_EQUAL_INT(numof, _done_numof);
+    for (unsigned i = 0; i < numof; i++) {
+        TEST_ASSERT_EQUAL_INT(i, _done[i]);
+    }
+}
+
+static void setup(void)
+{
+    _hold = false;
+    while (_complete()) {}
+    _begin_numof = 0;
+    _end_numof = 0;
+    _start_numof = 0;
+    _done_numof = 0;
+    _resubmit = NULL;
+}
+
+static void test_async_queue_submit__sync(void)
+{
+    _desc_t desc[3];
+
+    _init(desc, 3, 0);
+    TEST_ASSERT_EQUAL_INT(0, _submit(desc, 3));
+    /* descriptors completed by start() are done before submit returns */
+    _assert_order(3);
+    TEST_ASSERT_EQUAL_INT(3, _start_numof);
+    TEST_ASSERT_EQUAL_INT(1, _begin_numof);
+    TEST_ASSERT_EQUAL_INT(1, _end_numof);
+    TEST_ASSERT(!async_queue_busy(&_queue));
+}
+
+static void test_async_queue_submit__order(void)
+{
+    _desc_t desc[3];
+
+    _hold = true;
+    _init(desc, 3, 0);
+    for (unsigned i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _submit(&desc[i], 1));
+    }
+    TEST_ASSERT(async_queue_busy(&_queue));
+    for (unsigned i = 0; i < 3; i++) {
+        /* only the head is started */
+        TEST_ASSERT(_queue.head == &desc[i].node);
+        TEST_ASSERT_EQUAL_INT(i + 1, _start_numof);
+        TEST_ASSERT_EQUAL_INT(i, _done_numof);
+        TEST_ASSERT(_complete());
+    }
+    _assert_order(3);
+    TEST_ASSERT_EQUAL_INT(1, _begin_numof);
+    TEST_ASSERT_EQUAL_INT(1, _end_numof);
+    TEST_ASSERT(!_complete());
+}
+
+static void test_async_queue_submit__interleaved(void)
+{
+    _desc_t first[2], second;
+
+    _hold = true;
+    _init(first, 2, 0);
+    _init(&second, 1, 2);
+    TEST_ASSERT_EQUAL_INT(0, _submit(first, 2));
+    TEST_ASSERT_EQUAL_INT(0, _submit(&second, 1));
+    /* a request is not split by later submissions */
+    while (_complete()) {}
+    _assert_order(3);
+}
+
+static void test_async_queue_submit__from_cb(void)
+{
+    _desc_t first, second, third;
+
+    _hold = true;
+    _init(&first, 1, 0);
+    _init(&second, 1, 1);
+    _init(&third, 1, 2);
+    TEST_ASSERT_EQUAL_INT(0, _submit(&first, 1));
+    TEST_ASSERT_EQUAL_INT(0, _submit(&second, 1));
+    _resubmit = &third;
+    while (_complete()) {}
+    _assert_order(3);
+    TEST_ASSERT_EQUAL_INT(1, _begin_numof);
+    TEST_ASSERT_EQUAL_INT(1, _end_numof);
+}
+
+static void test_async_queue_submit__from_last_cb(void)
+{
+    _desc_t first, second;
+
+    /* the queue runs empty while the callback submits */
+    _init(&first, 1, 0);
+    _init(&second, 1, 1);
+    _resubmit = &second;
+    TEST_ASSERT_EQUAL_INT(0, _submit(&first, 1));
+    _assert_order(2);
+    TEST_ASSERT_EQUAL_INT(1, _begin_numof);
+    TEST_ASSERT_EQUAL_INT(1, _end_numof);
+    TEST_ASSERT(!async_queue_busy(&_queue));
+}
+
+static void test_async_queue_submit__reuse(void)
+{
+    _desc_t desc;
+
+    /* a completed descriptor may be submitted again, each run acquires and
+     * releases the bus */
+    _init(&desc, 1, 0);
+    TEST_ASSERT_EQUAL_INT(0, _submit(&desc, 1));
+    TEST_ASSERT_EQUAL_INT(0, _submit(&desc, 1));
+    TEST_ASSERT_EQUAL_INT(2, _done_numof);
+    TEST_ASSERT_EQUAL_INT(2, _begin_numof);
+    TEST_ASSERT_EQUAL_INT(2, _end_numof);
+}
+
+Test *tests_async_queue_all(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_async_queue_submit__sync),
+        new_TestFixture(test_async_queue_submit__order),
+        new_TestFixture(test_async_queue_submit__interleaved),
+        new_TestFixture(test_async_queue_submit__from_cb),
+        new_TestFixture(test_async_queue_submit__from_last_cb),
+        new_TestFixture(test_async_queue_submit__reuse),
+    };
+
+    EMB_UNIT_TESTCALLER(async_queue_tests, setup, NULL, fixtures);
+    return (Test *)&async_queue_tests;
+}
+
+void tests_async_queue(void)
+{
+    TESTS_RUN(tests_async_queue_all());
+}
+/** @} */
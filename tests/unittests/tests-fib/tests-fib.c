@@ -27,6 +27,16 @@ static fib_table_t test_fib_table = { .data.entries = _entries,
                                       .mtx_access = MUTEX_INIT,
                                       .notify_rp_pos = 0 };
 
+#ifndef TEST_FIB_LPM_ROUTES
+#define TEST_FIB_LPM_ROUTES     (256)
+#endif
+static fib_entry_t _lpm_entries[TEST_FIB_LPM_ROUTES + 1];
+static fib_table_t test_fib_lpm_table = { .data.entries = _lpm_entries,
+                                          .table_type = FIB_TABLE_TYPE_SH,
+                                          .size = TEST_FIB_LPM_ROUTES + 1,
+                                          .mtx_access = MUTEX_INIT,
+                                          .notify_rp_pos = 0 };
+
 /*
 * @brief helper to fill FIB with unique entries
 */
@@ -976,6 +986,96 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit(&test_fib_table);
 }
 
+/*
+* @brief helper to construct the i-th route and a destination within it,
+* even routes are /40, odd ones /48 below 2001:db8::/32
+*/
+static uint32_t _lpm_addr(unsigned i, uint8_t *addr, bool host)
+{
+    memset(addr, 0, 16);
+    addr[0] = 0x20;
+    addr[1] = 0x01;
+    addr[2] = 0x0d;
+    addr[3] = 0xb8;
+    addr[4] = (uint8_t)i;
+    addr[5] = (i & 1) ? (uint8_t)(i >> 8) + 1 : 0;
+    if (host) {
+        addr[5] = (i & 1) ? addr[5] : 0x42;
+        addr[15] = 0x01;
+    }
+    return (i & 1) ? 48 : 40;
+}
+
+/*
+* @brief longest prefix match with hundreds of routes and a default route
+* It is expected to find each route by a destination within it, the
+* default route for all others
+*/
+static void test_fib_21_lpm_many_routes(void)
+{
+    uint8_t addr_dst[16];
+    uint8_t addr_nxt[16];
+    uint8_t addr_lookup[16];
+    size_t add_buf_size = sizeof(addr_nxt);
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+
+    fib_init(&test_fib_lpm_table);
+
+    for (size_t i = 0; i < sizeof(addr_nxt); i++) {
+        addr_nxt[i] = i + 1;
+    }
+
+    /* the default route, ::/0 */
+    memset(addr_dst, 0, sizeof(addr_dst));
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_lpm_table, 42,
+                          addr_dst, sizeof(addr_dst), 0x0,
+                          addr_nxt, sizeof(addr_nxt), 0xffff,
+                          (uint32_t)FIB_LIFETIME_NO_EXPIRE));
+
+    for (unsigned i = 0; i < TEST_FIB_LPM_ROUTES; i++) {
+        uint32_t prefix_len = _lpm_addr(i, addr_dst, false);
+        addr_nxt[15] = (uint8_t)(i & 0x03);
+        TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_lpm_table, 42,
+                              addr_dst, sizeof(addr_dst),
+                              (prefix_len << FIB_FLAG_NET_PREFIX_SHIFT),
+                              addr_nxt, sizeof(addr_nxt), i,
+                              (uint32_t)FIB_LIFETIME_NO_EXPIRE));
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_FIB_LPM_ROUTES + 1,
+                          fib_get_num_used_entries(&test_fib_lpm_table));
+
+    for (unsigned i = 0; i < TEST_FIB_LPM_ROUTES; i++) {
+        _lpm_addr(i, addr_lookup, true);
+        add_buf_size = sizeof(addr_nxt);
+        int ret = fib_get_next_hop(&test_fib_lpm_table, &iface_id,
+                                   addr_nxt, &add_buf_size, &next_hop_flags,
+                                   addr_lookup, sizeof(addr_lookup), 0);
+        TEST_ASSERT_EQUAL_INT(0, ret);
+        TEST_ASSERT_EQUAL_INT(i, next_hop_flags);
+    }
+
+    /* outside of 2001:db8::/32 only the default route matches */
+    addr_lookup[3] = 0xb9;
+    add_buf_size = sizeof(addr_nxt);
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_lpm_table, &iface_id,
+                          addr_nxt, &add_buf_size, &next_hop_flags,
+                          addr_lookup, sizeof(addr_lookup), 0));
+    TEST_ASSERT_EQUAL_INT(0xffff, next_hop_flags);
+
+    /* removing a /48 falls back to the default route, not to a neighbour */
+    _lpm_addr(1, addr_dst, false);
+    fib_remove_entry(&test_fib_lpm_table, addr_dst, sizeof(addr_dst));
+    _lpm_addr(1, addr_lookup, true);
+    add_buf_size = sizeof(addr_nxt);
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_lpm_table, &iface_id,
+                          addr_nxt, &add_buf_size, &next_hop_flags,
+                          addr_lookup, sizeof(addr_lookup), 0));
+    TEST_ASSERT_EQUAL_INT(0xffff, next_hop_flags);
+
+    fib_deinit(&test_fib_lpm_table);
+}
+
 Test *tests_fib_tests(void)
 {
     fib_init(&test_fib_table);
@@ -1000,6 +1100,7 @@ Test *tests_fib_tests(void)
                         new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
                         new_TestFixture(test_fib_19_default_gateway),
                         new_TestFixture(test_fib_20_replace_prefix),
+                        new_TestFixture(test_fib_21_lpm_many_routes),
     };
 
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
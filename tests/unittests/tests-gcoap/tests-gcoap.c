@@ -13,7 +13,9 @@
  */
 #include <errno.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -49,6 +51,54 @@ static gcoap_listener_t listener_second = {
 
 static const char *resource_list_str = "</act/switch>,</sensor/temp>,</test/info/all>,</second/part>";
 
+/* gcoap's own resources, /.well-known/core comes first */
+extern const coap_resource_t _default_resources[];
+
+/* resource lookup of gcoap, and its return values */
+#define GCOAP_RESOURCE_FOUND            (0)
+#define GCOAP_RESOURCE_WRONG_METHOD     (-1)
+#define GCOAP_RESOURCE_NO_PATH          (-2)
+extern int _find_resource(coap_pkt_t *pdu,
+                          const coap_resource_t **resource_ptr,
+                          gcoap_listener_t **listener_ptr);
+
+/*
+ * Resources registered after the resource list tests. /act/switch is also
+ * provided by the first listener, for GET and POST only.
+ */
+static const coap_resource_t resources_methods[] = {
+    { .path = "/act/switch", .methods = (COAP_GET | COAP_PUT) },
+};
+
+/* paths that are prefixes of each other */
+static const coap_resource_t resources_prefix[] = {
+    { .path = "/a", .methods = (COAP_GET) },
+    { .path = "/act", .methods = (COAP_GET) },
+    { .path = "/act/switch/on", .methods = (COAP_GET) },
+};
+
+static gcoap_listener_t listener_methods = {
+    .resources     = &resources_methods[0],
+    .resources_len = (sizeof(resources_methods) / sizeof(resources_methods[0])),
+    .next          = NULL
+};
+
+static gcoap_listener_t listener_prefix = {
+    .resources     = &resources_prefix[0],
+    .resources_len = (sizeof(resources_prefix) / sizeof(resources_prefix[0])),
+    .next          = NULL
+};
+
+/* more resources than the index can hold, paths are filled in by the test */
+static char overflow_paths[GCOAP_RESOURCE_INDEX_SIZE][8];
+static coap_resource_t resources_overflow[GCOAP_RESOURCE_INDEX_SIZE];
+
+static gcoap_listener_t listener_overflow = {
+    .resources     = &resources_overflow[0],
+    .resources_len = GCOAP_RESOURCE_INDEX_SIZE,
+    .next          = NULL
+};
+
 /*
  * Client GET request success case. Test request generation.
  * Request /time resource from libcoap example
@@ -363,6 +413,207 @@ static void test_gcoap__server_get_resource_list(void)
     res[size] = '\0';
     TEST_ASSERT_EQUAL_INT(strlen(resource_list_str), size);
     TEST_ASSERT_EQUAL_STRING(resource_list_str, (char *)res);
+
+    /* only complete resources are written */
+    size = gcoap_get_resource_list(res, 40, COAP_FORMAT_LINK);
+    res[size] = '\0';
+    TEST_ASSERT_EQUAL_STRING("</act/switch>,</sensor/temp>", (char *)res);
+}
+
+/*
+ * Helper for server_well_known_core_* tests below.
+ * Request for /.well-known/core, optionally with Block2 option for the
+ * second 16 byte block.
+ */
+static int _read_well_known_core_req(coap_pkt_t *pdu, uint8_t *buf,
+                                     bool block2)
+{
+    uint8_t pdu_data[] = {
+        0x52, 0x01, 0x20, 0xb6, 0x35, 0x61, 0xbb, 0x2e,
+        0x77, 0x65, 0x6c, 0x6c, 0x2d, 0x6b, 0x6e, 0x6f,
+        0x77, 0x6e, 0x04, 0x63, 0x6f, 0x72, 0x65, 0xc1,
+        0x10
+    };
+    size_t len = (block2) ? sizeof(pdu_data) : sizeof(pdu_data) - 2;
+
+    memcpy(buf, pdu_data, len);
+
+    return coap_parse(pdu, buf, len);
+}
+
+/*
+ * Test /.well-known/core without Block2 option. The resource list fits into
+ * the PDU buffer, so it is sent in a single response.
+ * Uses the listeners registered by test_gcoap__server_get_resource_list.
+ */
+static void test_gcoap__server_well_known_core(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    coap_block1_t block2;
+
+    TEST_ASSERT_EQUAL_INT(0, _read_well_known_core_req(&pdu, buf, false));
+
+    ssize_t res = _default_resources[0].handler(&pdu, buf, sizeof(buf), NULL);
+
+    TEST_ASSERT(res > 0);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pdu, buf, res));
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTENT, coap_get_code_raw(&pdu));
+    TEST_ASSERT(!coap_get_block2(&pdu, &block2));
+    TEST_ASSERT_EQUAL_INT(strlen(resource_list_str), pdu.payload_len);
+    TEST_ASSERT(memcmp(resource_list_str, pdu.payload, pdu.payload_len) == 0);
+}
+
+/*
+ * Test /.well-known/core with Block2 option. Only the requested block is
+ * sent.
+ * Uses the listeners registered by test_gcoap__server_get_resource_list.
+ */
+static void test_gcoap__server_well_known_core_block(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    coap_block1_t block2;
+
+    TEST_ASSERT_EQUAL_INT(0, _read_well_known_core_req(&pdu, buf, true));
+
+    ssize_t res = _default_resources[0].handler(&pdu, buf, sizeof(buf), NULL);
+
+    TEST_ASSERT(res > 0);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pdu, buf, res));
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTENT, coap_get_code_raw(&pdu));
+    TEST_ASSERT(coap_get_block2(&pdu, &block2));
+    TEST_ASSERT_EQUAL_INT(1, block2.blknum);
+    TEST_ASSERT_EQUAL_INT(0, block2.szx);
+    TEST_ASSERT_EQUAL_INT(1, block2.more);
+    TEST_ASSERT_EQUAL_INT(16, pdu.payload_len);
+    TEST_ASSERT(memcmp(&resource_list_str[16], pdu.payload, 16) == 0);
+}
+
+/*
+ * Helper for server_find_* tests below.
+ * Builds a request for path with the given method and looks its resource up.
+ */
+static int _find(unsigned method, const char *path,
+                 const coap_resource_t **resource, gcoap_listener_t **listener)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+
+    gcoap_req_init(&pdu, &buf[0], sizeof(buf), method, path);
+    ssize_t len = gcoap_finish(&pdu, 0, COAP_FORMAT_NONE);
+    if ((len < 0) || (coap_parse(&pdu, &buf[0], len) < 0)) {
+        return 1;
+    }
+
+    return _find_resource(&pdu, resource, listener);
+}
+
+/*
+ * Equal paths of several listeners: the first listener with a matching
+ * method wins, no listener matching gives WRONG_METHOD.
+ */
+static void _check_equal_paths(void)
+{
+    const coap_resource_t *resource = NULL;
+    gcoap_listener_t *owner = NULL;
+
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_FOUND,
+                          _find(COAP_METHOD_GET, "/act/switch", &resource, &owner));
+    TEST_ASSERT(resource == &resources[0]);
+    TEST_ASSERT(owner == &listener);
+
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_FOUND,
+                          _find(COAP_METHOD_POST, "/act/switch", &resource, &owner));
+    TEST_ASSERT(resource == &resources[0]);
+
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_FOUND,
+                          _find(COAP_METHOD_PUT, "/act/switch", &resource, &owner));
+    TEST_ASSERT(resource == &resources_methods[0]);
+    TEST_ASSERT(owner == &listener_methods);
+
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_WRONG_METHOD,
+                          _find(COAP_METHOD_DELETE, "/act/switch", &resource, &owner));
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_WRONG_METHOD,
+                          _find(COAP_METHOD_POST, "/sensor/temp", &resource, &owner));
+}
+
+/*
+ * Paths that are prefixes of each other, and paths sorting before the first
+ * and after the last resource.
+ */
+static void _check_prefixes(void)
+{
+    const coap_resource_t *resource = NULL;
+    gcoap_listener_t *owner = NULL;
+
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_FOUND,
+                          _find(COAP_METHOD_GET, "/a", &resource, &owner));
+    TEST_ASSERT(resource == &resources_prefix[0]);
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_FOUND,
+                          _find(COAP_METHOD_GET, "/act", &resource, &owner));
+    TEST_ASSERT(resource == &resources_prefix[1]);
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_FOUND,
+                          _find(COAP_METHOD_GET, "/act/switch/on", &resource, &owner));
+    TEST_ASSERT(resource == &resources_prefix[2]);
+    TEST_ASSERT(owner == &listener_prefix);
+
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_NO_PATH,
+                          _find(COAP_METHOD_GET, "/ac", &resource, &owner));
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_NO_PATH,
+                          _find(COAP_METHOD_GET, "/act/swit", &resource, &owner));
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_NO_PATH,
+                          _find(COAP_METHOD_GET, "/act/switch/o", &resource, &owner));
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_NO_PATH,
+                          _find(COAP_METHOD_GET, "/act/switch/on/x", &resource, &owner));
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_NO_PATH,
+                          _find(COAP_METHOD_GET, "/", &resource, &owner));
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_NO_PATH,
+                          _find(COAP_METHOD_GET, "/zzz", &resource, &owner));
+}
+
+/*
+ * Test lookups in the resource index.
+ * Must run after the resource list tests, as it registers more listeners.
+ */
+static void test_gcoap__server_find_index(void)
+{
+    gcoap_register_listener(&listener_methods);
+    gcoap_register_listener(&listener_prefix);
+
+    _check_equal_paths();
+    _check_prefixes();
+}
+
+/*
+ * Test lookups after the index overflowed, gcoap then searches the listeners
+ * in order and must give the same results.
+ * Must run last, the index stays unused afterwards.
+ */
+static void test_gcoap__server_find_overflow(void)
+{
+    const coap_resource_t *resource = NULL;
+    gcoap_listener_t *owner = NULL;
+
+    for (unsigned i = 0; i < GCOAP_RESOURCE_INDEX_SIZE; i++) {
+        snprintf(overflow_paths[i], sizeof(overflow_paths[i]), "/z/%03u", i);
+        resources_overflow[i].path = overflow_paths[i];
+        resources_overflow[i].methods = COAP_GET;
+    }
+    gcoap_register_listener(&listener_overflow);
+
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_FOUND,
+                          _find(COAP_METHOD_GET, overflow_paths[0], &resource, &owner));
+    TEST_ASSERT(resource == &resources_overflow[0]);
+    TEST_ASSERT(owner == &listener_overflow);
+    TEST_ASSERT_EQUAL_INT(GCOAP_RESOURCE_FOUND,
+                          _find(COAP_METHOD_GET,
+                                overflow_paths[GCOAP_RESOURCE_INDEX_SIZE - 1],
+                                &resource, &owner));
+    TEST_ASSERT(resource == &resources_overflow[GCOAP_RESOURCE_INDEX_SIZE - 1]);
+
+    _check_equal_paths();
+    _check_prefixes();
 }
 
 Test *tests_gcoap_tests(void)
@@ -377,7 +628,11 @@ Test *tests_gcoap_tests(void)
         new_TestFixture(test_gcoap__server_get_resp),
         new_TestFixture(test_gcoap__server_con_req),
         new_TestFixture(test_gcoap__server_con_resp),
-        new_TestFixture(test_gcoap__server_get_resource_list)
+        new_TestFixture(test_gcoap__server_get_resource_list),
+        new_TestFixture(test_gcoap__server_well_known_core),
+        new_TestFixture(test_gcoap__server_well_known_core_block),
+        new_TestFixture(test_gcoap__server_find_index),
+        new_TestFixture(test_gcoap__server_find_overflow),
     };
 
     EMB_UNIT_TESTCALLER(gcoap_tests, NULL, NULL, fixtures);
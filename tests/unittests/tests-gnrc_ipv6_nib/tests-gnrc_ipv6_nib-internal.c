@@ -13,6 +13,7 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <errno.h>
 #include <inttypes.h>
 
 #include "net/ipv6/addr.h"
@@ -1948,6 +1949,142 @@ static void test_nib_abr_iter__three_elem_middle_removed(void)
 }
 #endif
 
+/*
+ * Creates GNRC_IPV6_NIB_NUMOF entries with different addresses. There are
+ * fewer hash buckets than entries (see Makefile.include), so some share a
+ * bucket.
+ * Expected result: every entry is found by its address, both on its interface
+ * and with unspecified interface, but not on another interface. An address
+ * that was not added is not found.
+ */
+static void test_nib_hash__onl_get_collisions(void)
+{
+    _nib_onl_entry_t *nodes[GNRC_IPV6_NIB_NUMOF];
+    ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                  { .u64 = TEST_UINT64 } } };
+
+    for (int i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL((nodes[i] = _nib_onl_alloc(&addr, IFACE)));
+        nodes[i]->mode |= _NC;
+        addr.u64[1].u64++;
+    }
+    addr.u64[1].u64 = TEST_UINT64;
+    for (int i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        TEST_ASSERT(nodes[i] == _nib_onl_get(&addr, IFACE));
+        TEST_ASSERT(nodes[i] == _nib_onl_get(&addr, 0));
+        TEST_ASSERT_NULL(_nib_onl_get(&addr, IFACE + 1));
+        addr.u64[1].u64++;
+    }
+    TEST_ASSERT_NULL(_nib_onl_get(&addr, IFACE));
+}
+
+/*
+ * Creates GNRC_IPV6_NIB_NUMOF entries with different addresses, removes every
+ * second one and adds them again.
+ * Expected result: removed entries are not found, the others are still found
+ * within their shared buckets, re-added entries are found again.
+ */
+static void test_nib_hash__onl_remove(void)
+{
+    _nib_onl_entry_t *nodes[GNRC_IPV6_NIB_NUMOF];
+    ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                  { .u64 = TEST_UINT64 } } };
+
+    for (int i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL((nodes[i] = _nib_onl_alloc(&addr, IFACE)));
+        nodes[i]->mode |= _NC;
+        addr.u64[1].u64++;
+    }
+    for (int i = 0; i < GNRC_IPV6_NIB_NUMOF; i += 2) {
+        nodes[i]->mode = _EMPTY;
+        TEST_ASSERT(_nib_onl_clear(nodes[i]));
+    }
+    addr.u64[1].u64 = TEST_UINT64;
+    for (int i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        if (i & 1) {
+            TEST_ASSERT(nodes[i] == _nib_onl_get(&addr, IFACE));
+        }
+        else {
+            TEST_ASSERT_NULL(_nib_onl_get(&addr, IFACE));
+        }
+        addr.u64[1].u64++;
+    }
+    addr.u64[1].u64 = TEST_UINT64;
+    for (int i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        if (!(i & 1)) {
+            TEST_ASSERT_NOT_NULL((nodes[i] = _nib_onl_alloc(&addr, IFACE)));
+            nodes[i]->mode |= _NC;
+        }
+        addr.u64[1].u64++;
+    }
+    addr.u64[1].u64 = TEST_UINT64;
+    for (int i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        TEST_ASSERT(nodes[i] == _nib_onl_get(&addr, IFACE));
+        addr.u64[1].u64++;
+    }
+}
+
+/*
+ * Creates an on-link entry without address and sets its address afterwards
+ * through an off-link entry using it as next hop.
+ * Expected result: the entry is found by its new address
+ */
+static void test_nib_hash__onl_addr_set_later(void)
+{
+    _nib_onl_entry_t *node;
+    static const ipv6_addr_t next_hop = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                                 { .u64 = TEST_UINT64 } } };
+    static const ipv6_addr_t pfx = { .u64 = { { .u8 = GLOBAL_PREFIX } } };
+    _nib_offl_entry_t *dst;
+
+    TEST_ASSERT_NOT_NULL((dst = _nib_offl_alloc(NULL, IFACE, &pfx,
+                                                GLOBAL_PREFIX_LEN)));
+    TEST_ASSERT_NOT_NULL((node = dst->next_hop));
+    TEST_ASSERT(dst == _nib_offl_alloc(&next_hop, IFACE, &pfx,
+                                       GLOBAL_PREFIX_LEN));
+    TEST_ASSERT(node == _nib_onl_get(&next_hop, IFACE));
+}
+
+/*
+ * Creates routes to nested prefixes of lengths 32, 48 and 64 with different
+ * next hops. The rest of the off-link entries are filled with unrelated
+ * routes, so some share a hash bucket with the nested ones.
+ * Expected result: the route to an address within all prefixes goes via the
+ * longest one. Removing it, the next shorter one is used. Without any of them
+ * there is no route.
+ */
+static void test_nib_hash__offl_longest_match(void)
+{
+    static const uint8_t lens[] = { 32, 48, 64 };
+    _nib_offl_entry_t *dsts[ARRAY_SIZE(lens)];
+    ipv6_addr_t next_hop = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                      { .u64 = TEST_UINT64 } } };
+    static const ipv6_addr_t pfx = { .u64 = { { .u8 = GLOBAL_PREFIX } } };
+    static const ipv6_addr_t dst = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                              { .u64 = TEST_UINT64 } } };
+    ipv6_addr_t other = { .u8 = { 0x20, 0x01, 0x0d, 0xb9 } };
+    gnrc_ipv6_nib_ft_t fte;
+
+    for (unsigned i = 0; i < (GNRC_IPV6_NIB_OFFL_NUMOF - ARRAY_SIZE(lens));
+         i++) {
+        other.u8[4] = (uint8_t)i;
+        TEST_ASSERT_NOT_NULL(_nib_ft_add(&next_hop, IFACE, &other, 48));
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+        next_hop.u8[15] = lens[i];
+        TEST_ASSERT_NOT_NULL((dsts[i] = _nib_ft_add(&next_hop, IFACE, &pfx,
+                                                    lens[i])));
+    }
+    for (int i = ARRAY_SIZE(lens) - 1; i >= 0; i--) {
+        TEST_ASSERT_EQUAL_INT(0, _nib_get_route(&dst, NULL, &fte));
+        TEST_ASSERT_EQUAL_INT(lens[i], fte.dst_len);
+        next_hop.u8[15] = lens[i];
+        TEST_ASSERT(ipv6_addr_equal(&next_hop, &fte.next_hop));
+        _nib_ft_remove(dsts[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH, _nib_get_route(&dst, NULL, &fte));
+}
+
 static void test_retrans_exp_backoff(void)
 {
     TEST_ASSERT_EQUAL_INT(0,
@@ -2099,6 +2236,10 @@ Test *tests_gnrc_ipv6_nib_internal_tests(void)
         new_TestFixture(test_nib_abr_iter__three_elem),
         new_TestFixture(test_nib_abr_iter__three_elem_middle_removed),
 #endif
+        new_TestFixture(test_nib_hash__onl_get_collisions),
+        new_TestFixture(test_nib_hash__onl_remove),
+        new_TestFixture(test_nib_hash__onl_addr_set_later),
+        new_TestFixture(test_nib_hash__offl_longest_match),
         new_TestFixture(test_retrans_exp_backoff),
     };
 
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "periph/i2c_async.h"
+#include "i2c_async_native.h"
+
+#include "tests-i2c_async.h"
+
+#define TEST_BUS        I2C_DEV(0)
+#define TEST_ADDR_A     (0x1d)
+#define TEST_ADDR_B     (0x76)
+#define TEST_ADDR_NONE  (0x42)
+#define TEST_DONE_NUMOF (8U)
+
+static uint8_t _regs_a[16];
+static uint8_t _regs_b[8];
+static i2c_async_xfer_t _done[TEST_DONE_NUMOF];
+static unsigned _done_numof;
+
+static void _cb(i2c_async_xfer_t *xfer, void *arg)
+{
+    (void)arg;
+    if (_done_numof < TEST_DONE_NUMOF) {
+        _done[_done_numof++] = *xfer;
+    }
+}
+
+static void _init(i2c_async_xfer_t *xfer, uint16_t addr, uint16_t reg,
+                  bool read, void *data, size_t len, void *arg)
+{
+    memset(xfer, 0, sizeof(*xfer));
+    xfer->addr = addr;
+    xfer->reg = reg;
+    xfer->read = read;
+    xfer->data = data;
+    xfer->len = len;
+    xfer->cb = _cb;
+    xfer->arg = arg;
+}
+
+static void setup(void)
+{
+    i2c_async_native_clear();
+    for (unsigned i = 0; i < sizeof(_regs_a); i++) {
+        _regs_a[i] = i;
+    }
+    for (unsigned i = 0; i < sizeof(_regs_b); i++) {
+        _regs_b[i] = 0x80 + i;
+    }
+    i2c_async_native_add(TEST_BUS, TEST_ADDR_A, _regs_a, sizeof(_regs_a));
+    i2c_async_native_add(TEST_BUS, TEST_ADDR_B, _regs_b, sizeof(_regs_b));
+    _done_numof = 0;
+}
+
+static void test_i2c_async_submit__batch(void)
+{
+    uint8_t a[6], b[3];
+    i2c_async_xfer_t xfer[2];
+
+    /* registers of two devices in one batch */
+    _init(&xfer[0], TEST_ADDR_A, 0x08, true, a, sizeof(a), (void *)0);
+    _init(&xfer[1], TEST_ADDR_B, 0x04, true, b, sizeof(b), (void *)1);
+    TEST_ASSERT_EQUAL_INT(0, i2c_async_submit(TEST_BUS, xfer, 2));
+    TEST_ASSERT_EQUAL_INT(2, _done_numof);
+    TEST_ASSERT(_done[0].arg == (void *)0);
+    TEST_ASSERT(_done[1].arg == (void *)1);
+    TEST_ASSERT_EQUAL_INT(0, _done[0].res);
+    TEST_ASSERT_EQUAL_INT(0, _done[1].res);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_regs_a[0x08], a, sizeof(a)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_regs_b[0x04], b, sizeof(b)));
+    TEST_ASSERT(!i2c_async_busy(TEST_BUS));
+}
+
+static void test_i2c_async_submit__write(void)
+{
+    uint8_t val[2] = { 0xa5, 0x5a };
+    uint8_t raw = 0x33;
+    i2c_async_xfer_t xfer[2];
+
+    _init(&xfer[0], TEST_ADDR_A, 0x02, false, val, sizeof(val), NULL);
+    _init(&xfer[1], TEST_ADDR_B, 0, false, &raw, 1, NULL);
+    xfer[1].flags = I2C_ASYNC_NOREG;
+    TEST_ASSERT_EQUAL_INT(0, i2c_async_submit(TEST_BUS, xfer, 2));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_regs_a[0x02], val, sizeof(val)));
+    TEST_ASSERT_EQUAL_INT(0x33, _regs_b[0]);
+}
+
+static void test_i2c_async_submit__errors(void)
+{
+    uint8_t buf[4];
+    i2c_async_xfer_t xfer[3];
+
+    _init(&xfer[0], TEST_ADDR_NONE, 0x00, true, buf, 1, NULL);
+    _init(&xfer[1], TEST_ADDR_B, 0x06, true, buf, 4, NULL);
+    _init(&xfer[2], TEST_ADDR_A, 0x00, true, buf, 4, NULL);
+    TEST_ASSERT_EQUAL_INT(0, i2c_async_submit(TEST_BUS, xfer, 3));
+    /* failing transactions do not stop the batch */
+    TEST_ASSERT_EQUAL_INT(3, _done_numof);
+    TEST_ASSERT_EQUAL_INT(-ENXIO, _done[0].res);
+    TEST_ASSERT_EQUAL_INT(-EIO, _done[1].res);
+    TEST_ASSERT_EQUAL_INT(0, _done[2].res);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_regs_a, buf, 4));
+}
+
+static void test_i2c_async_transfer(void)
+{
+    uint8_t buf[4];
+    i2c_async_xfer_t xfer[3];
+
+    _init(&xfer[0], TEST_ADDR_A, 0x00, true, buf, 2, NULL);
+    _init(&xfer[1], TEST_ADDR_NONE, 0x00, true, buf, 1, NULL);
+    _init(&xfer[2], TEST_ADDR_B, 0x07, true, buf, 4, NULL);
+    /* the first failed transaction is reported */
+    TEST_ASSERT_EQUAL_INT(-ENXIO, i2c_async_transfer(TEST_BUS, xfer, 3));
+    TEST_ASSERT_EQUAL_INT(2, _done_numof);
+    TEST_ASSERT_EQUAL_INT(-EIO, xfer[2].res);
+
+    _init(&xfer[0], TEST_ADDR_B, 0x00, true, buf, 4, NULL);
+    TEST_ASSERT_EQUAL_INT(0, i2c_async_transfer(TEST_BUS, xfer, 1));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_regs_b, buf, 4));
+    TEST_ASSERT(!i2c_async_busy(TEST_BUS));
+}
+
+Test *tests_i2c_async_all(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_i2c_async_submit__batch),
+        new_TestFixture(test_i2c_async_submit__write),
+        new_TestFixture(test_i2c_async_submit__errors),
+        new_TestFixture(test_i2c_async_transfer),
+    };
+
+    EMB_UNIT_TESTCALLER(i2c_async_tests, setup, NULL, fixtures);
+    return (Test *)&i2c_async_tests;
+}
+
+void tests_i2c_async(void)
+{
+    TESTS_RUN(tests_i2c_async_all());
+}
+/** @} */
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the periph_i2c_async module
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+#ifndef TESTS_I2C_ASYNC_H
+#define TESTS_I2C_ASYNC_H
+
+#include "embUnit/embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  @brief   The entry point of this test suite.
+ */
+void tests_i2c_async(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_I2C_ASYNC_H */
+/** @} */
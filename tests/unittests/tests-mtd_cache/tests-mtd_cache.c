@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "mtd.h"
+#include "mtd_cache.h"
+
+#include "tests-mtd_cache.h"
+
+#define SECTOR_COUNT    (4U)
+#define PAGE_PER_SECTOR (4U)
+#define PAGE_SIZE       (64U)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+
+/* RAM-based mtd counting the accesses */
+static uint8_t _memory[SECTOR_COUNT * SECTOR_SIZE];
+static unsigned _reads, _writes;
+static uint32_t _last_write_addr, _last_write_size;
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(_memory)) {
+        return -EOVERFLOW;
+    }
+    _reads++;
+    memcpy(buff, _memory + addr, size);
+    return size;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                  uint32_t size)
+{
+    (void)dev;
+
+    if ((addr + size > sizeof(_memory)) ||
+        (((addr % PAGE_SIZE) + size) > PAGE_SIZE)) {
+        return -EOVERFLOW;
+    }
+    _writes++;
+    _last_write_addr = addr;
+    _last_write_size = size;
+    memcpy(_memory + addr, buff, size);
+    return size;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if ((addr % SECTOR_SIZE) || (size % SECTOR_SIZE) ||
+        (addr + size > sizeof(_memory))) {
+        return -EOVERFLOW;
+    }
+    memset(_memory + addr, 0xff, size);
+    return 0;
+}
+
+static const mtd_desc_t _driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+};
+
+static mtd_dev_t _dev = {
+    .driver = &_driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static uint8_t _cache_buf[MTD_CACHE_PAGES * PAGE_SIZE];
+static mtd_cache_t _cache;
+static mtd_dev_t *dev = &_cache.base;
+
+static void setup(void)
+{
+    memset(_memory, 0xff, sizeof(_memory));
+    mtd_cache_setup(&_cache, &_dev, _cache_buf);
+    mtd_init(dev);
+    _reads = 0;
+    _writes = 0;
+}
+
+static void test_mtd_cache_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(SECTOR_COUNT, dev->sector_count);
+    TEST_ASSERT_EQUAL_INT(PAGE_PER_SECTOR, dev->pages_per_sector);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, dev->page_size);
+}
+
+static void test_mtd_cache_read_hit(void)
+{
+    uint8_t buf[8];
+
+    memset(_memory + PAGE_SIZE, 0x5a, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_read(dev, buf, PAGE_SIZE + 4, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_read(dev, buf, PAGE_SIZE + 16, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1, _reads);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.misses);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.hits);
+    TEST_ASSERT_EQUAL_INT(0x5a, buf[0]);
+}
+
+static void test_mtd_cache_read_pages(void)
+{
+    uint8_t buf[3 * PAGE_SIZE];
+
+    _memory[2 * PAGE_SIZE] = 0x42;
+    /* whole pages are read at once and not cached */
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_read(dev, buf, 0, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1, _reads);
+    TEST_ASSERT_EQUAL_INT(3, _cache.stats.misses);
+    TEST_ASSERT_EQUAL_INT(0x42, buf[2 * PAGE_SIZE]);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_read(dev, buf, 0, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(2, _reads);
+}
+
+static void test_mtd_cache_write_coalesce(void)
+{
+    const char data[] = "0123456789abcde";
+    uint8_t buf[sizeof(data)];
+
+    /* 16 bytes, including the terminating zero */
+    for (unsigned i = 0; i < sizeof(data); i += 4) {
+        TEST_ASSERT_EQUAL_INT(4, mtd_write(dev, &data[i], PAGE_SIZE + 8 + i, 4));
+    }
+    TEST_ASSERT_EQUAL_INT(0, _writes);
+
+    /* the cached data is read back before it was written */
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_read(dev, buf, PAGE_SIZE + 8, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, buf, sizeof(buf)));
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_flush(dev));
+    TEST_ASSERT_EQUAL_INT(1, _writes);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE + 8, _last_write_addr);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), _last_write_size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, _memory + PAGE_SIZE + 8, sizeof(data)));
+
+    /* nothing left to write */
+    TEST_ASSERT_EQUAL_INT(0, mtd_flush(dev));
+    TEST_ASSERT_EQUAL_INT(1, _writes);
+}
+
+static void test_mtd_cache_write_page(void)
+{
+    uint8_t page[PAGE_SIZE];
+
+    memset(page, 0x11, sizeof(page));
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, mtd_write(dev, page, 0, PAGE_SIZE));
+    /* a completely written page is not read first */
+    TEST_ASSERT_EQUAL_INT(0, _reads);
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_write(dev, page, PAGE_SIZE / 2, PAGE_SIZE));
+}
+
+static void test_mtd_cache_evict(void)
+{
+    uint8_t byte = 0;
+
+    /* the dirty page is used first, so it is the least recently used one */
+    TEST_ASSERT_EQUAL_INT(1, mtd_write(dev, &byte, 3, 1));
+    for (unsigned i = 1; i < MTD_CACHE_PAGES; i++) {
+        TEST_ASSERT_EQUAL_INT(1, mtd_read(dev, &byte, i * PAGE_SIZE, 1));
+    }
+    TEST_ASSERT_EQUAL_INT(0, _writes);
+    TEST_ASSERT_EQUAL_INT(1, mtd_read(dev, &byte, MTD_CACHE_PAGES * PAGE_SIZE, 1));
+    TEST_ASSERT_EQUAL_INT(1, _writes);
+    TEST_ASSERT_EQUAL_INT(3, _last_write_addr);
+    TEST_ASSERT_EQUAL_INT(0, _memory[3]);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.writebacks);
+
+    /* page 1 is evicted next, page 0 is read again */
+    TEST_ASSERT_EQUAL_INT(1, mtd_read(dev, &byte, 3, 1));
+    TEST_ASSERT_EQUAL_INT(0, byte);
+    TEST_ASSERT_EQUAL_INT(MTD_CACHE_PAGES + 2, _reads);
+}
+
+static void test_mtd_cache_erase(void)
+{
+    uint8_t byte = 0;
+
+    TEST_ASSERT_EQUAL_INT(1, mtd_write(dev, &byte, SECTOR_SIZE + 1, 1));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_erase(dev, SECTOR_SIZE, PAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(dev, SECTOR_SIZE, SECTOR_SIZE));
+    /* erased pages are dropped without writing them back */
+    TEST_ASSERT_EQUAL_INT(0, mtd_flush(dev));
+    TEST_ASSERT_EQUAL_INT(0, _writes);
+    TEST_ASSERT_EQUAL_INT(1, mtd_read(dev, &byte, SECTOR_SIZE + 1, 1));
+    TEST_ASSERT_EQUAL_INT(0xff, byte);
+}
+
+static void test_mtd_cache_power_down(void)
+{
+    uint8_t byte = 0;
+
+    TEST_ASSERT_EQUAL_INT(1, mtd_write(dev, &byte, 0, 1));
+    /* the cached device does not support power control */
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, mtd_power(dev, MTD_POWER_DOWN));
+    TEST_ASSERT_EQUAL_INT(1, _writes);
+}
+
+Test *tests_mtd_cache_all(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_cache_init),
+        new_TestFixture(test_mtd_cache_read_hit),
+        new_TestFixture(test_mtd_cache_read_pages),
+        new_TestFixture(test_mtd_cache_write_coalesce),
+        new_TestFixture(test_mtd_cache_write_page),
+        new_TestFixture(test_mtd_cache_evict),
+        new_TestFixture(test_mtd_cache_erase),
+        new_TestFixture(test_mtd_cache_power_down),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_cache_tests, setup, NULL, fixtures);
+    return (Test *)&mtd_cache_tests;
+}
+
+void tests_mtd_cache(void)
+{
+    TESTS_RUN(tests_mtd_cache_all());
+}
+/** @} */
@@ -541,6 +541,147 @@ static void test_nanocoap__server_option_count_overflow(void)
     TEST_ASSERT(res < 0);
 }
 
+/*
+ * Helper for block2 tests. Builds a GET request for the given Block2 option
+ * value in buf and parses it into pkt. A negative blkopt omits the option.
+ */
+static void _build_block2_req(coap_pkt_t *pkt, uint8_t *buf, int32_t blkopt)
+{
+    size_t len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, NULL, 0,
+                                COAP_METHOD_GET, 0xABCD);
+    coap_pkt_init(pkt, buf, _BUF_SIZE, len);
+    coap_opt_add_string(pkt, COAP_OPT_URI_PATH, "/large", '/');
+    if (blkopt >= 0) {
+        coap_opt_add_uint(pkt, COAP_OPT_BLOCK2, (uint32_t)blkopt);
+    }
+    len = coap_opt_finish(pkt, COAP_OPT_FINISH_NONE);
+
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(pkt, buf, len));
+}
+
+/*
+ * Helper for block2 tests. Writes the response for the block requested in
+ * req, with a payload of payload_len bytes, and parses it into resp.
+ */
+static void _build_block2_resp(coap_pkt_t *req, coap_pkt_t *resp,
+                               uint8_t *buf, size_t payload_len)
+{
+    uint8_t payload[256];
+    coap_block_slicer_t slicer;
+
+    for (unsigned i = 0; i < sizeof(payload); i++) {
+        payload[i] = i;
+    }
+
+    coap_block2_init(req, &slicer);
+    size_t len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, NULL, 0,
+                                COAP_CODE_CONTENT, 0xABCD);
+    coap_pkt_init(resp, buf, _BUF_SIZE, len);
+    coap_opt_add_uint(resp, COAP_OPT_CONTENT_FORMAT, COAP_FORMAT_LINK);
+    coap_opt_add_block2(resp, &slicer, true);
+    len = coap_opt_finish(resp, COAP_OPT_FINISH_PAYLOAD);
+    TEST_ASSERT_EQUAL_INT((uintptr_t)(buf + len), (uintptr_t)resp->payload);
+
+    len += coap_blockwise_put_bytes(&slicer, resp->payload, payload,
+                                    payload_len);
+    coap_block2_finish(&slicer);
+
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(resp, buf, len));
+}
+
+/*
+ * Serves the middle block of a payload spanning three blocks.
+ */
+static void test_nanocoap__block2_more(void)
+{
+    uint8_t req_buf[_BUF_SIZE];
+    uint8_t resp_buf[_BUF_SIZE];
+    coap_pkt_t req, resp;
+    coap_block1_t block2;
+
+    /* block 1 with 32 bytes */
+    _build_block2_req(&req, req_buf, (1 << 4) | 1);
+    _build_block2_resp(&req, &resp, resp_buf, 80);
+
+    TEST_ASSERT(coap_get_block2(&resp, &block2));
+    TEST_ASSERT_EQUAL_INT(1, block2.blknum);
+    TEST_ASSERT_EQUAL_INT(1, block2.szx);
+    TEST_ASSERT_EQUAL_INT(1, block2.more);
+    TEST_ASSERT_EQUAL_INT(32, resp.payload_len);
+    TEST_ASSERT_EQUAL_INT(32, resp.payload[0]);
+    TEST_ASSERT_EQUAL_INT(63, resp.payload[31]);
+}
+
+/*
+ * Serves the first and only block with the smallest block size. The Block2
+ * option then has the value 0, and must keep its length when the more flag
+ * is cleared.
+ */
+static void test_nanocoap__block2_last(void)
+{
+    uint8_t req_buf[_BUF_SIZE];
+    uint8_t resp_buf[_BUF_SIZE];
+    coap_pkt_t req, resp;
+    coap_block1_t block2;
+
+    _build_block2_req(&req, req_buf, 0);
+    _build_block2_resp(&req, &resp, resp_buf, 10);
+
+    TEST_ASSERT(coap_get_block2(&resp, &block2));
+    TEST_ASSERT_EQUAL_INT(0, block2.blknum);
+    TEST_ASSERT_EQUAL_INT(0, block2.szx);
+    TEST_ASSERT_EQUAL_INT(0, block2.more);
+    TEST_ASSERT_EQUAL_INT(COAP_FORMAT_LINK, coap_get_content_type(&resp));
+    TEST_ASSERT_EQUAL_INT(10, resp.payload_len);
+    TEST_ASSERT_EQUAL_INT(0, resp.payload[0]);
+    TEST_ASSERT_EQUAL_INT(9, resp.payload[9]);
+}
+
+/*
+ * Serves the first block with the maximum block size, if the request has no
+ * Block2 option.
+ */
+static void test_nanocoap__block2_no_option(void)
+{
+    uint8_t req_buf[_BUF_SIZE];
+    uint8_t resp_buf[_BUF_SIZE];
+    coap_pkt_t req, resp;
+    coap_block1_t block2;
+
+    _build_block2_req(&req, req_buf, -1);
+    _build_block2_resp(&req, &resp, resp_buf, 200);
+
+    TEST_ASSERT(coap_get_block2(&resp, &block2));
+    TEST_ASSERT_EQUAL_INT(0, block2.blknum);
+    TEST_ASSERT_EQUAL_INT(NANOCOAP_BLOCK_SIZE_EXP_MAX - 4, block2.szx);
+    TEST_ASSERT_EQUAL_INT(1, block2.more);
+    TEST_ASSERT_EQUAL_INT(coap_szx2size(block2.szx), resp.payload_len);
+}
+
+/*
+ * Acknowledges a received Block1 block.
+ */
+static void test_nanocoap__block1_control(void)
+{
+    uint8_t buf[_BUF_SIZE];
+    coap_pkt_t pkt;
+    coap_block1_t block1 = { .blknum = 3, .szx = 2, .more = 1 };
+
+    size_t len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, NULL, 0,
+                                COAP_CODE_CONTINUE, 0xABCD);
+    coap_pkt_init(&pkt, buf, sizeof(buf), len);
+    coap_opt_add_block1_control(&pkt, &block1);
+    len = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, len));
+    memset(&block1, 0, sizeof(block1));
+    TEST_ASSERT(coap_get_block1(&pkt, &block1));
+    TEST_ASSERT_EQUAL_INT(3, block1.blknum);
+    TEST_ASSERT_EQUAL_INT(2, block1.szx);
+    TEST_ASSERT_EQUAL_INT(1, block1.more);
+    TEST_ASSERT_EQUAL_INT(3 * 64, block1.offset);
+}
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -561,6 +702,10 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__server_reply_simple_con),
         new_TestFixture(test_nanocoap__server_option_count_overflow_check),
         new_TestFixture(test_nanocoap__server_option_count_overflow),
+        new_TestFixture(test_nanocoap__block2_more),
+        new_TestFixture(test_nanocoap__block2_last),
+        new_TestFixture(test_nanocoap__block2_no_option),
+        new_TestFixture(test_nanocoap__block1_control),
     };
 
     EMB_UNIT_TESTCALLER(nanocoap_tests, NULL, NULL, fixtures);
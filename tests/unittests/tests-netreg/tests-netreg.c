@@ -14,6 +14,7 @@
 #include <errno.h>
 
 #include "embUnit.h"
+#include "kernel_defines.h"
 
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/nettype.h"
@@ -139,6 +140,55 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_lookup__same_ctx_other_type(void)
+{
+    gnrc_netreg_entry_t *res = NULL;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entries[1]));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16)));
+    TEST_ASSERT(&entries[0] == res);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF, TEST_UINT16)));
+    TEST_ASSERT(&entries[1] == res);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &entries[0]);
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT(&entries[1] == gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF, TEST_UINT16));
+}
+
+void test_netreg_lookup__many_ctx(void)
+{
+    static gnrc_netreg_entry_t many[GNRC_NETREG_BUCKETS * 2];
+
+    for (unsigned i = 0; i < ARRAY_SIZE(many); i++) {
+        gnrc_netreg_entry_init_pid(&many[i], TEST_UINT16 + i, TEST_UINT8);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &many[i]));
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(many); i++) {
+        TEST_ASSERT(&many[i] == gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16 + i));
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(&many[i]));
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(many); i += 2) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &many[i]);
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(many); i++) {
+        if (i & 1) {
+            TEST_ASSERT(&many[i] == gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16 + i));
+        }
+        else {
+            TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16 + i));
+        }
+    }
+}
+
+void test_netreg_unregister__not_registered(void)
+{
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &entries[0]);
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16));
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +205,9 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_lookup__same_ctx_other_type),
+        new_TestFixture(test_netreg_lookup__many_ctx),
+        new_TestFixture(test_netreg_unregister__not_registered),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+#include <string.h>
+
+#include "embUnit.h"
+#include "simcom_sock_buf.h"
+
+#include "tests-simcom_sock_buf.h"
+
+#define TEST_ROUNDS         (20000U)
+#define TEST_CHUNK_MAX      (200U)
+#define TEST_QUEUE_LEN      (SIMCOM_SOCK_BUF_SIZE / (SIMCOM_SOCK_BUF_HDR_LEN + 1))
+
+typedef struct {
+    uint16_t len;
+    uint8_t seed;
+} chunk_t;
+
+static simcom_sock_t _sock;
+static chunk_t _queue[TEST_QUEUE_LEN];
+static unsigned _queue_head, _queue_len;
+static uint32_t _rnd_state;
+
+static void set_up(void)
+{
+    memset(&_sock, 0, sizeof(_sock));
+    _queue_head = 0;
+    _queue_len = 0;
+    _rnd_state = 0x2545f491;
+}
+
+/* xorshift32, the sequence is the same on every run */
+static uint32_t _rnd(void)
+{
+    _rnd_state ^= _rnd_state << 13;
+    _rnd_state ^= _rnd_state >> 17;
+    _rnd_state ^= _rnd_state << 5;
+    return _rnd_state;
+}
+
+/* pos is set to the position of the chunk, or -1 if it did not fit */
+static void _push(uint16_t len, uint8_t seed, int *pos_out)
+{
+    int pos = simcom_sock_buf_reserve(&_sock, len);
+
+    *pos_out = pos;
+    if (pos < 0) {
+        return;
+    }
+    TEST_ASSERT(pos + SIMCOM_SOCK_BUF_HDR_LEN + len <= SIMCOM_SOCK_BUF_SIZE);
+    for (unsigned i = 0; i < len; i++) {
+        _sock.buf[pos + SIMCOM_SOCK_BUF_HDR_LEN + i] = seed + i;
+    }
+    simcom_sock_buf_commit(&_sock, pos, len);
+    TEST_ASSERT(_queue_len < TEST_QUEUE_LEN);
+    chunk_t *chunk = &_queue[(_queue_head + _queue_len) % TEST_QUEUE_LEN];
+    chunk->len = len;
+    chunk->seed = seed;
+    _queue_len++;
+}
+
+static void _pop(void)
+{
+    uint8_t *data;
+    size_t len = simcom_sock_buf_peek(&_sock, &data);
+
+    if (_queue_len == 0) {
+        TEST_ASSERT_EQUAL_INT(0, len);
+        return;
+    }
+    chunk_t *chunk = &_queue[_queue_head];
+    TEST_ASSERT_EQUAL_INT(chunk->len, len);
+    for (unsigned i = 0; i < len; i++) {
+        TEST_ASSERT_EQUAL_INT((uint8_t)(chunk->seed + i), data[i]);
+    }
+    simcom_sock_buf_release(&_sock);
+    _queue_head = (_queue_head + 1) % TEST_QUEUE_LEN;
+    _queue_len--;
+}
+
+static void test_simcom_sock_buf__empty(void)
+{
+    uint8_t *data;
+    int pos;
+
+    TEST_ASSERT_EQUAL_INT(0, simcom_sock_buf_peek(&_sock, &data));
+    /* release of an empty buffer does nothing */
+    simcom_sock_buf_release(&_sock);
+    TEST_ASSERT_EQUAL_INT(0, _sock.used);
+    TEST_ASSERT_EQUAL_INT(-1, simcom_sock_buf_reserve(&_sock,
+                                  SIMCOM_SOCK_BUF_SIZE - SIMCOM_SOCK_BUF_HDR_LEN + 1));
+    /* a chunk filling the whole buffer */
+    _push(SIMCOM_SOCK_BUF_SIZE - SIMCOM_SOCK_BUF_HDR_LEN, 1, &pos);
+    TEST_ASSERT_EQUAL_INT(0, pos);
+    TEST_ASSERT_EQUAL_INT(SIMCOM_SOCK_BUF_SIZE, _sock.used);
+    TEST_ASSERT_EQUAL_INT(-1, simcom_sock_buf_reserve(&_sock, 0));
+    _pop();
+    TEST_ASSERT_EQUAL_INT(0, _sock.used);
+}
+
+static void test_simcom_sock_buf__wrap(void)
+{
+    const uint16_t len = SIMCOM_SOCK_BUF_SIZE / 3;
+    int pos;
+
+    _push(len, 1, &pos);
+    TEST_ASSERT_EQUAL_INT(0, pos);
+    _push(len, 2, &pos);
+    TEST_ASSERT_EQUAL_INT(SIMCOM_SOCK_BUF_HDR_LEN + len, pos);
+    _pop();
+    /* does not fit at the end, but in front of the remaining chunk */
+    _push(len, 3, &pos);
+    TEST_ASSERT_EQUAL_INT(0, pos);
+    /* the unused end is counted until the read position passes it */
+    TEST_ASSERT_EQUAL_INT(SIMCOM_SOCK_BUF_SIZE, _sock.used);
+    TEST_ASSERT_EQUAL_INT(-1, simcom_sock_buf_reserve(&_sock, 1));
+    _pop();
+    _pop();
+    TEST_ASSERT_EQUAL_INT(0, _sock.used);
+}
+
+static void test_simcom_sock_buf__random(void)
+{
+    unsigned pushed = 0, rejected = 0, wrapped = 0;
+
+    for (unsigned round = 0; round < TEST_ROUNDS; round++) {
+        uint32_t rnd = _rnd();
+        /* pushes a bit more often than pops, so the buffer runs full */
+        if ((rnd % 8) < 5) {
+            uint16_t len = 1 + ((rnd >> 8) % TEST_CHUNK_MAX);
+            uint16_t head = _sock.head;
+            int pos;
+            _push(len, rnd >> 24, &pos);
+            if (pos < 0) {
+                /* an empty buffer takes any chunk */
+                TEST_ASSERT(_queue_len > 0);
+                rejected++;
+            }
+            else {
+                pushed++;
+                if ((_queue_len > 1) && ((unsigned)pos != head)) {
+                    wrapped++;
+                }
+            }
+        }
+        else {
+            _pop();
+        }
+        TEST_ASSERT(_sock.used <= SIMCOM_SOCK_BUF_SIZE);
+        TEST_ASSERT_EQUAL_INT(_queue_len == 0, _sock.used == 0);
+    }
+    while (_queue_len > 0) {
+        _pop();
+    }
+    TEST_ASSERT_EQUAL_INT(0, _sock.used);
+
+    /* all paths were taken */
+    TEST_ASSERT(pushed > 0);
+    TEST_ASSERT(rejected > 0);
+    TEST_ASSERT(wrapped > 0);
+}
+
+Test *tests_simcom_sock_buf_all(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_simcom_sock_buf__empty),
+        new_TestFixture(test_simcom_sock_buf__wrap),
+        new_TestFixture(test_simcom_sock_buf__random),
+    };
+
+    EMB_UNIT_TESTCALLER(simcom_sock_buf_tests, set_up, NULL, fixtures);
+    return (Test *)&simcom_sock_buf_tests;
+}
+
+void tests_simcom_sock_buf(void)
+{
+    TESTS_RUN(tests_simcom_sock_buf_all());
+}
+/** @} */
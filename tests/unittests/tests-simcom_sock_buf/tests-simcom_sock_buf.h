@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the receive buffer of the SIMCOM socks
+ *
+ * @author      Unwired Devices LLC <info@unwds.com>
+ */
+#ifndef TESTS_SIMCOM_SOCK_BUF_H
+#define TESTS_SIMCOM_SOCK_BUF_H
+
+#include "embUnit/embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  @brief   The entry point of this test suite.
+ */
+void tests_simcom_sock_buf(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_SIMCOM_SOCK_BUF_H */
+/** @} */
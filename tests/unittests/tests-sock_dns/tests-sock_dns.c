@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "kernel_defines.h"
+#include "net/af.h"
+#include "net/sock/dns.h"
+
+#include "tests-sock_dns.h"
+
+/* offset of the first record after the query in the replies below */
+#define TEST_ANSWER_POS     (29U)
+
+/* reply to an AAAA query for example.org, the answer name points to the
+ * query name */
+static const uint8_t _reply_aaaa[] = {
+    0x00, 0x00, 0x81, 0x80, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+    /* query: example.org AAAA IN */
+    0x07, 'e', 'x', 'a', 'm', 'p', 'l', 'e', 0x03, 'o', 'r', 'g', 0x00,
+    0x00, 0x1c, 0x00, 0x01,
+    /* answer: AAAA IN, TTL 300, 2001:db8::1 */
+    0xc0, 0x0c, 0x00, 0x1c, 0x00, 0x01, 0x00, 0x00, 0x01, 0x2c, 0x00, 0x10,
+    0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+};
+
+/* reply to an A query for example.org with a CNAME in front of the address */
+static const uint8_t _reply_cname[] = {
+    0x00, 0x00, 0x81, 0x80, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+    /* query: example.org A IN */
+    0x07, 'e', 'x', 'a', 'm', 'p', 'l', 'e', 0x03, 'o', 'r', 'g', 0x00,
+    0x00, 0x01, 0x00, 0x01,
+    /* answer: CNAME IN, TTL 300, www.example.org */
+    0xc0, 0x0c, 0x00, 0x05, 0x00, 0x01, 0x00, 0x00, 0x01, 0x2c, 0x00, 0x06,
+    0x03, 'w', 'w', 'w', 0xc0, 0x0c,
+    /* answer: www.example.org A IN, TTL 60, 192.0.2.1 */
+    0xc0, 0x29, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x04,
+    0xc0, 0x00, 0x02, 0x01,
+};
+
+/* NXDOMAIN reply to an AAAA query for example.org with an SOA record of org,
+ * TTL 3600, MINIMUM 60 */
+static const uint8_t _reply_nxdomain[] = {
+    0x00, 0x00, 0x81, 0x83, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    /* query: example.org AAAA IN */
+    0x07, 'e', 'x', 'a', 'm', 'p', 'l', 'e', 0x03, 'o', 'r', 'g', 0x00,
+    0x00, 0x1c, 0x00, 0x01,
+    /* authority: org SOA IN, TTL 3600 */
+    0xc0, 0x14, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x0e, 0x10, 0x00, 0x16,
+    0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x0e, 0x10, 0x00, 0x00, 0x07, 0x08,
+    0x00, 0x01, 0x51, 0x80, 0x00, 0x00, 0x00, 0x3c,
+};
+
+static const uint8_t _addr4[] = { 192, 0, 2, 1 };
+static const uint8_t _addr6[] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+                                  0, 0, 0, 0, 0, 0, 0, 1 };
+
+static uint8_t _buf[128];
+
+static int _parse(const uint8_t *reply, size_t len, void *addr, int family,
+                  uint32_t *ttl)
+{
+    memcpy(_buf, reply, len);
+    return sock_dns_parse_reply(_buf, len, addr, family, ttl);
+}
+
+static void test_sock_dns_parse_reply__aaaa(void)
+{
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr6),
+                          _parse(_reply_aaaa, sizeof(_reply_aaaa), addr,
+                                 AF_INET6, &ttl));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_addr6, addr, sizeof(_addr6)));
+    TEST_ASSERT_EQUAL_INT(300, ttl);
+}
+
+static void test_sock_dns_parse_reply__cname(void)
+{
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr4),
+                          _parse(_reply_cname, sizeof(_reply_cname), addr,
+                                 AF_INET, &ttl));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_addr4, addr, sizeof(_addr4)));
+    TEST_ASSERT_EQUAL_INT(60, ttl);
+}
+
+static void test_sock_dns_parse_reply__other_family(void)
+{
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    /* no SOA record, so the negative answer is not cacheable */
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH,
+                          _parse(_reply_aaaa, sizeof(_reply_aaaa), addr,
+                                 AF_INET, &ttl));
+    TEST_ASSERT_EQUAL_INT(0, ttl);
+}
+
+static void test_sock_dns_parse_reply__nxdomain(void)
+{
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH,
+                          _parse(_reply_nxdomain, sizeof(_reply_nxdomain),
+                                 addr, AF_INET6, &ttl));
+    TEST_ASSERT_EQUAL_INT(60, ttl);
+}
+
+static void test_sock_dns_parse_reply__truncated(void)
+{
+    const struct {
+        const uint8_t *reply;
+        size_t len;
+        int family;
+    } replies[] = {
+        { _reply_aaaa, sizeof(_reply_aaaa), AF_INET6 },
+        { _reply_cname, sizeof(_reply_cname), AF_INET },
+    };
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(replies); i++) {
+        for (size_t len = 0; len < replies[i].len; len++) {
+            TEST_ASSERT_EQUAL_INT(-EBADMSG,
+                                  _parse(replies[i].reply, len, addr,
+                                         replies[i].family, &ttl));
+        }
+    }
+    /* a truncated authority section only makes the answer not cacheable */
+    for (size_t len = TEST_ANSWER_POS; len < sizeof(_reply_nxdomain);
+         len++) {
+        TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH,
+                              _parse(_reply_nxdomain, len, addr, AF_INET6,
+                                     &ttl));
+        TEST_ASSERT_EQUAL_INT(0, ttl);
+    }
+}
+
+static void test_sock_dns_parse_reply__error_rcode(void)
+{
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    memcpy(_buf, _reply_aaaa, sizeof(_reply_aaaa));
+    _buf[3] = 0x82;     /* SERVFAIL */
+    TEST_ASSERT_EQUAL_INT(-EBADMSG,
+                          sock_dns_parse_reply(_buf, sizeof(_reply_aaaa), addr,
+                                               AF_INET6, &ttl));
+}
+
+static void test_sock_dns_parse_reply__wrong_addrlen(void)
+{
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    memcpy(_buf, _reply_aaaa, sizeof(_reply_aaaa));
+    _buf[TEST_ANSWER_POS + 11] = sizeof(_addr4);
+    TEST_ASSERT_EQUAL_INT(-EBADMSG,
+                          sock_dns_parse_reply(_buf, sizeof(_reply_aaaa), addr,
+                                               AF_INET6, &ttl));
+}
+
+static void test_sock_dns_parse_reply__rdlength_overflow(void)
+{
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    memcpy(_buf, _reply_cname, sizeof(_reply_cname));
+    /* RDLENGTH of the CNAME */
+    _buf[TEST_ANSWER_POS + 10] = 0xff;
+    _buf[TEST_ANSWER_POS + 11] = 0xff;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG,
+                          sock_dns_parse_reply(_buf, sizeof(_reply_cname), addr,
+                                               AF_INET, &ttl));
+}
+
+static void test_sock_dns_parse_reply__reserved_label(void)
+{
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    memcpy(_buf, _reply_aaaa, sizeof(_reply_aaaa));
+    _buf[sizeof(sock_dns_hdr_t)] |= 0x40;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG,
+                          sock_dns_parse_reply(_buf, sizeof(_reply_aaaa), addr,
+                                               AF_INET6, &ttl));
+}
+
+static void test_sock_dns_parse_reply__compression_loop(void)
+{
+    uint8_t addr[16];
+    uint32_t ttl;
+
+    memcpy(_buf, _reply_aaaa, sizeof(_reply_aaaa));
+    /* answer name points to itself */
+    _buf[TEST_ANSWER_POS + 1] = TEST_ANSWER_POS;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG,
+                          sock_dns_parse_reply(_buf, sizeof(_reply_aaaa), addr,
+                                               AF_INET6, &ttl));
+    /* answer name points forward */
+    _buf[TEST_ANSWER_POS + 1] = TEST_ANSWER_POS + 2;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG,
+                          sock_dns_parse_reply(_buf, sizeof(_reply_aaaa), addr,
+                                               AF_INET6, &ttl));
+    /* query name points to itself */
+    memcpy(_buf, _reply_aaaa, sizeof(_reply_aaaa));
+    _buf[sizeof(sock_dns_hdr_t)] = 0xc0;
+    _buf[sizeof(sock_dns_hdr_t) + 1] = sizeof(sock_dns_hdr_t);
+    TEST_ASSERT_EQUAL_INT(-EBADMSG,
+                          sock_dns_parse_reply(_buf, sizeof(_reply_aaaa), addr,
+                                               AF_INET6, &ttl));
+}
+
+Test *tests_sock_dns_all(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sock_dns_parse_reply__aaaa),
+        new_TestFixture(test_sock_dns_parse_reply__cname),
+        new_TestFixture(test_sock_dns_parse_reply__other_family),
+        new_TestFixture(test_sock_dns_parse_reply__nxdomain),
+        new_TestFixture(test_sock_dns_parse_reply__truncated),
+        new_TestFixture(test_sock_dns_parse_reply__error_rcode),
+        new_TestFixture(test_sock_dns_parse_reply__wrong_addrlen),
+        new_TestFixture(test_sock_dns_parse_reply__rdlength_overflow),
+        new_TestFixture(test_sock_dns_parse_reply__reserved_label),
+        new_TestFixture(test_sock_dns_parse_reply__compression_loop),
+    };
+
+    EMB_UNIT_TESTCALLER(sock_dns_tests, NULL, NULL, fixtures);
+    return (Test *)&sock_dns_tests;
+}
+
+void tests_sock_dns(void)
+{
+    TESTS_RUN(tests_sock_dns_all());
+}
+/** @} */
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/af.h"
+#include "net/sock/dns.h"
+
+#include "tests-sock_dns_cache.h"
+
+#define TEST_NAME       "broker.example.org"
+#define TEST_TTL        (300U)
+
+static const uint8_t _addr4[] = { 192, 0, 2, 1 };
+static const uint8_t _addr6[] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+                                  0, 0, 0, 0, 0, 0, 0, 1 };
+
+static void setup(void)
+{
+    sock_dns_cache_flush(NULL);
+}
+
+static void test_sock_dns_cache_get__miss(void)
+{
+    uint8_t addr[16];
+
+    TEST_ASSERT_EQUAL_INT(0, sock_dns_cache_get(TEST_NAME, addr, AF_INET6));
+}
+
+static void test_sock_dns_cache_get__hit(void)
+{
+    uint8_t addr[16];
+
+    sock_dns_cache_add(TEST_NAME, _addr6, sizeof(_addr6), AF_INET6, TEST_TTL);
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr6),
+                          sock_dns_cache_get(TEST_NAME, addr, AF_INET6));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_addr6, addr, sizeof(_addr6)));
+}
+
+static void test_sock_dns_cache_get__case_insensitive(void)
+{
+    uint8_t addr[16];
+
+    sock_dns_cache_add(TEST_NAME, _addr4, sizeof(_addr4), AF_INET, TEST_TTL);
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr4),
+                          sock_dns_cache_get("Broker.Example.ORG", addr, AF_INET));
+}
+
+static void test_sock_dns_cache_get__other_family(void)
+{
+    uint8_t addr[16];
+
+    sock_dns_cache_add(TEST_NAME, _addr4, sizeof(_addr4), AF_INET, TEST_TTL);
+    TEST_ASSERT_EQUAL_INT(0, sock_dns_cache_get(TEST_NAME, addr, AF_INET6));
+    TEST_ASSERT_EQUAL_INT(0, sock_dns_cache_get(TEST_NAME, addr, AF_UNSPEC));
+}
+
+static void test_sock_dns_cache_get__negative(void)
+{
+    uint8_t addr[16];
+
+    sock_dns_cache_add(TEST_NAME, NULL, 0, AF_INET6, TEST_TTL);
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH,
+                          sock_dns_cache_get(TEST_NAME, addr, AF_INET6));
+}
+
+static void test_sock_dns_cache_add__ttl_zero(void)
+{
+    uint8_t addr[16];
+
+    sock_dns_cache_add(TEST_NAME, _addr6, sizeof(_addr6), AF_INET6, 0);
+    TEST_ASSERT_EQUAL_INT(0, sock_dns_cache_get(TEST_NAME, addr, AF_INET6));
+}
+
+static void test_sock_dns_cache_add__update(void)
+{
+    uint8_t addr[16];
+
+    sock_dns_cache_add(TEST_NAME, NULL, 0, AF_UNSPEC, TEST_TTL);
+    sock_dns_cache_add(TEST_NAME, _addr4, sizeof(_addr4), AF_UNSPEC, TEST_TTL);
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr4),
+                          sock_dns_cache_get(TEST_NAME, addr, AF_UNSPEC));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_addr4, addr, sizeof(_addr4)));
+}
+
+static void test_sock_dns_cache_add__lru(void)
+{
+    char name[16];
+    uint8_t addr[16];
+
+    for (unsigned i = 0; i < SOCK_DNS_CACHE_SIZE; i++) {
+        snprintf(name, sizeof(name), "host%u", i);
+        sock_dns_cache_add(name, _addr4, sizeof(_addr4), AF_INET, TEST_TTL);
+    }
+    /* host0 is used again, so host1 is the least recently used entry */
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr4),
+                          sock_dns_cache_get("host0", addr, AF_INET));
+    sock_dns_cache_add(TEST_NAME, _addr4, sizeof(_addr4), AF_INET, TEST_TTL);
+
+    TEST_ASSERT_EQUAL_INT(0, sock_dns_cache_get("host1", addr, AF_INET));
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr4),
+                          sock_dns_cache_get("host0", addr, AF_INET));
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr4),
+                          sock_dns_cache_get(TEST_NAME, addr, AF_INET));
+}
+
+static void test_sock_dns_cache_flush__name(void)
+{
+    uint8_t addr[16];
+
+    sock_dns_cache_add(TEST_NAME, _addr4, sizeof(_addr4), AF_INET, TEST_TTL);
+    sock_dns_cache_add(TEST_NAME, _addr6, sizeof(_addr6), AF_INET6, TEST_TTL);
+    sock_dns_cache_add("other", _addr4, sizeof(_addr4), AF_INET, TEST_TTL);
+    sock_dns_cache_flush(TEST_NAME);
+    TEST_ASSERT_EQUAL_INT(0, sock_dns_cache_get(TEST_NAME, addr, AF_INET));
+    TEST_ASSERT_EQUAL_INT(0, sock_dns_cache_get(TEST_NAME, addr, AF_INET6));
+    TEST_ASSERT_EQUAL_INT(sizeof(_addr4),
+                          sock_dns_cache_get("other", addr, AF_INET));
+}
+
+Test *tests_sock_dns_cache_all(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sock_dns_cache_get__miss),
+        new_TestFixture(test_sock_dns_cache_get__hit),
+        new_TestFixture(test_sock_dns_cache_get__case_insensitive),
+        new_TestFixture(test_sock_dns_cache_get__other_family),
+        new_TestFixture(test_sock_dns_cache_get__negative),
+        new_TestFixture(test_sock_dns_cache_add__ttl_zero),
+        new_TestFixture(test_sock_dns_cache_add__update),
+        new_TestFixture(test_sock_dns_cache_add__lru),
+        new_TestFixture(test_sock_dns_cache_flush__name),
+    };
+
+    EMB_UNIT_TESTCALLER(sock_dns_cache_tests, setup, NULL, fixtures);
+    return (Test *)&sock_dns_cache_tests;
+}
+
+void tests_sock_dns_cache(void)
+{
+    TESTS_RUN(tests_sock_dns_cache_all());
+}
+/** @} */
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @author  Unwired Devices LLC <info@unwds.com>
+ */
+#include <string.h>
+
+#include "embUnit.h"
+#include "periph/spi_async.h"
+#include "spi_async_native.h"
+
+#include "tests-spi_async.h"
+
+#define TEST_BUS        SPI_DEV(0)
+#define TEST_CS         ((spi_cs_t)1)
+#define TEST_DONE_NUMOF (8U)
+
+static spi_async_xfer_t _done[TEST_DONE_NUMOF];
+static unsigned _done_numof;
+
+static void _cb(spi_async_xfer_t *xfer, void *arg)
+{
+    (void)arg;
+    if (_done_numof < TEST_DONE_NUMOF) {
+        _done[_done_numof++] = *xfer;
+    }
+}
+
+static void _init(spi_async_xfer_t *xfer, bool cont, const void *out,
+                  void *in, size_t len, void *arg)
+{
+    memset(xfer, 0, sizeof(*xfer));
+    xfer->cs = TEST_CS;
+    xfer->mode = SPI_MODE_0;
+    xfer->clk = SPI_CLK_1MHZ;
+    xfer->cont = cont;
+    xfer->out = out;
+    xfer->in = in;
+    xfer->len = len;
+    xfer->cb = _cb;
+    xfer->arg = arg;
+}
+
+static void setup(void)
+{
+    spi_async_native_hold(TEST_BUS, false);
+    while (spi_async_native_complete(TEST_BUS)) {}
+    _done_numof = 0;
+}
+
+static void test_spi_async_submit__sync(void)
+{
+    static const uint8_t out[] = { 0x01, 0x02, 0x03, 0x04 };
+    uint8_t in[sizeof(out)] = { 0 };
+    uint8_t cmd = 0x80;
+    spi_async_xfer_t xfer[2];
+
+    _init(&xfer[0], true, &cmd, NULL, 1, (void *)0);
+    _init(&xfer[1], false, out, in, sizeof(out), (void *)1);
+    TEST_ASSERT_EQUAL_INT(0, spi_async_submit(TEST_BUS, xfer, 2));
+    TEST_ASSERT_EQUAL_INT(2, _done_numof);
+    TEST_ASSERT(_done[0].arg == (void *)0);
+    TEST_ASSERT(_done[1].arg == (void *)1);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, in, sizeof(out)));
+    TEST_ASSERT(!spi_async_busy(TEST_BUS));
+    TEST_ASSERT(!spi_async_native_selected(TEST_BUS));
+}
+
+static void test_spi_async_submit__cs(void)
+{
+    uint8_t buf[2] = { 0 };
+    spi_async_xfer_t xfer[3];
+
+    spi_async_native_hold(TEST_BUS, true);
+    _init(&xfer[0], true, &buf[0], NULL, 1, NULL);
+    _init(&xfer[1], false, &buf[1], NULL, 1, NULL);
+    _init(&xfer[2], false, &buf[0], NULL, 1, NULL);
+    TEST_ASSERT_EQUAL_INT(0, spi_async_submit(TEST_BUS, xfer, 3));
+    TEST_ASSERT(spi_async_native_selected(TEST_BUS));
+    TEST_ASSERT(spi_async_native_complete(TEST_BUS));
+    /* the device stays selected for the second descriptor */
+    TEST_ASSERT(spi_async_native_selected(TEST_BUS));
+    TEST_ASSERT(spi_async_native_pending(TEST_BUS) == &xfer[1]);
+    TEST_ASSERT(spi_async_native_complete(TEST_BUS));
+    /* the third descriptor selects it again */
+    TEST_ASSERT(spi_async_native_pending(TEST_BUS) == &xfer[2]);
+    TEST_ASSERT(spi_async_native_selected(TEST_BUS));
+    TEST_ASSERT(spi_async_native_complete(TEST_BUS));
+    TEST_ASSERT(!spi_async_native_selected(TEST_BUS));
+    TEST_ASSERT_EQUAL_INT(3, _done_numof);
+}
+
+static void test_spi_async_transfer(void)
+{
+    static const uint8_t out[] = { 0xde, 0xad, 0xbe, 0xef };
+    uint8_t in[sizeof(out)] = { 0xff, 0xff, 0xff, 0xff };
+    uint8_t zero[sizeof(out)] = { 0 };
+    spi_async_xfer_t xfer[2];
+
+    _init(&xfer[0], true, out, NULL, sizeof(out), NULL);
+    _init(&xfer[1], false, NULL, in, sizeof(in), NULL);
+    spi_async_transfer(TEST_BUS, xfer, 2);
+    TEST_ASSERT_EQUAL_INT(1, _done_numof);
+    /* nothing sent, so the loopback receives zeros */
+    TEST_ASSERT_EQUAL_INT(0, memcmp(zero, in, sizeof(in)));
+    TEST_ASSERT(!spi_async_busy(TEST_BUS));
+}
+
+Test *tests_spi_async_all(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_spi_async_submit__sync),
+        new_TestFixture(test_spi_async_submit__cs),
+        new_TestFixture(test_spi_async_transfer),
+    };
+
+    EMB_UNIT_TESTCALLER(spi_async_tests, setup, NULL, fixtures);
+    return (Test *)&spi_async_tests;
+}
+
+void tests_spi_async(void)
+{
+    TESTS_RUN(tests_spi_async_all());
+}
+/** @} */
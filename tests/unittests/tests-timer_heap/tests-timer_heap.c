@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2019 Unwired Devices LLC <info@unwds.com>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "kernel_defines.h"
+#include "timer_heap.h"
+#include "tests-timer_heap.h"
+
+#define ENTRIES     (64U)
+
+typedef struct {
+    timer_heap_node_t node;
+    uint32_t target;
+} entry_t;
+
+static entry_t entries[ENTRIES];
+
+static int _before(const timer_heap_node_t *a, const timer_heap_node_t *b)
+{
+    return container_of(a, entry_t, node)->target
+           < container_of(b, entry_t, node)->target;
+}
+
+static timer_heap_t heap = TIMER_HEAP_INIT(_before);
+
+static void set_up(void)
+{
+    memset(entries, 0, sizeof(entries));
+    heap.root = NULL;
+}
+
+static uint32_t _pop_target(void)
+{
+    timer_heap_node_t *node = timer_heap_pop(&heap);
+
+    TEST_ASSERT_NOT_NULL(node);
+    TEST_ASSERT_NULL(node->heap);
+    return container_of(node, entry_t, node)->target;
+}
+
+static void test_timer_heap_empty(void)
+{
+    TEST_ASSERT_NULL(timer_heap_peek(&heap));
+    TEST_ASSERT_NULL(timer_heap_pop(&heap));
+}
+
+static void test_timer_heap_pop_sorted(void)
+{
+    /* insert a permutation of 0..ENTRIES-1 */
+    for (unsigned i = 0; i < ENTRIES; i++) {
+        entries[i].target = (i * 37) % ENTRIES;
+        timer_heap_insert(&heap, &entries[i].node);
+        TEST_ASSERT(entries[i].node.heap == &heap);
+    }
+
+    for (unsigned i = 0; i < ENTRIES; i++) {
+        TEST_ASSERT_EQUAL_INT(i, _pop_target());
+    }
+    TEST_ASSERT_NULL(timer_heap_peek(&heap));
+}
+
+static void test_timer_heap_remove(void)
+{
+    for (unsigned i = 0; i < ENTRIES; i++) {
+        entries[i].target = (i * 37) % ENTRIES;
+        timer_heap_insert(&heap, &entries[i].node);
+    }
+    /* force some tree structure below the root */
+    timer_heap_insert(&heap, timer_heap_pop(&heap));
+
+    /* remove every odd target, including inner nodes and the root */
+    for (unsigned i = 0; i < ENTRIES; i++) {
+        if (entries[i].target & 1) {
+            timer_heap_remove(&entries[i].node);
+            TEST_ASSERT_NULL(entries[i].node.heap);
+        }
+    }
+    timer_heap_remove(timer_heap_peek(&heap));
+
+    for (unsigned i = 2; i < ENTRIES; i += 2) {
+        TEST_ASSERT_EQUAL_INT(i, _pop_target());
+    }
+    TEST_ASSERT_NULL(timer_heap_peek(&heap));
+}
+
+Test *tests_timer_heap_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_timer_heap_empty),
+        new_TestFixture(test_timer_heap_pop_sorted),
+        new_TestFixture(test_timer_heap_remove),
+    };
+
+    EMB_UNIT_TESTCALLER(timer_heap_tests, set_up, NULL, fixtures);
+
+    return (Test *)&timer_heap_tests;
+}
+
+void tests_timer_heap(void)
+{
+    TESTS_RUN(tests_timer_heap_tests());
+}
+/** @} */
@@ -34,7 +34,7 @@ int main(void)
 
     for (unsigned int n = 0; n < NUMOF; n++) {
         printf("Setting %u timers, removing timer %u/%u\n", NUMOF, n, NUMOF);
-        xtimer_t timers[NUMOF];
+        xtimer_t timers[NUMOF] = { 0 };
         msg_t msg[NUMOF];
         for (unsigned int i = 0; i < NUMOF; i++) {
             msg[i].type = i;
@@ -31,8 +31,8 @@ int main(void)
     printf("It should print three times \"now=<value>\", with values"
            " approximately 100ms (100000us) apart.\n");
 
-    xtimer_t xtimer;
-    xtimer_t xtimer2;
+    xtimer_t xtimer = { 0 };
+    xtimer_t xtimer2 = { 0 };
 
     kernel_pid_t me = thread_getpid();
 
@@ -35,15 +35,78 @@
 
 #define UMDK_ADC_PUBLISH_PERIOD_MIN 1
 
+/**
+ * @brief   Version of the NVRAM configuration, a stored configuration of
+ *          another version is reset to the defaults
+ *
+ * Older firmware stored the board's adc_config there, whose first byte is a
+ * pin number, so the versions start above 15.
+ */
+#define UMDK_ADC_CONFIG_VERSION 0x21
+
 #define UMDK_ADC_STACK_SIZE 1024
 
 #define UMDK_ADC_ADC_RESOLUTION ADC_RES_12BIT
 #define UMDK_ADC_CONVERT_TO_MILLIVOLTS 1
 
+/**
+ * @brief   Sample the lines continuously and report min/mean/max/RMS per
+ *          period instead of a single sample
+ *
+ * Off by default: this changes the uplink format, and the running scan
+ * keeps the CPU out of its low power modes.
+ */
+#ifndef UMDK_ADC_CONTINUOUS
+#define UMDK_ADC_CONTINUOUS 0
+#endif
+
+/**
+ * @brief   Scans per DMA buffer half, the thread wakes up once per half
+ */
+#ifndef UMDK_ADC_SCANS
+#define UMDK_ADC_SCANS 32
+#endif
+
+/**
+ * @brief   Number of samples averaged before the statistics
+ */
+#ifndef UMDK_ADC_DECIMATION
+#define UMDK_ADC_DECIMATION 4
+#endif
+
+#if defined(CPU_FAM_STM32L0)
+/**
+ * @brief   log2 of the hardware oversampling ratio, scans run back to back
+ */
+#ifndef UMDK_ADC_OVERSAMPLING
+#define UMDK_ADC_OVERSAMPLING 6
+#endif
+#else
+#ifndef UMDK_ADC_OVERSAMPLING
+#define UMDK_ADC_OVERSAMPLING 0
+#endif
+
+/**
+ * @brief   Timer triggering the scans (TIM9 on unwd-range-l1), shared with
+ *          umdk-usonic
+ */
+#ifndef UMDK_ADC_TIMER
+#define UMDK_ADC_TIMER 1
+#endif
+
+/**
+ * @brief   Scan period in microseconds
+ */
+#ifndef UMDK_ADC_SCAN_PERIOD_US
+#define UMDK_ADC_SCAN_PERIOD_US 2000
+#endif
+#endif
+
 typedef enum {
     UMDK_ADC_DATA = 0,
 	UMDK_ADC_CMD_COMMAND = 1,
 	UMDK_ADC_CMD_POLL = 2,
+    UMDK_ADC_STATS = 3,
     UMDK_ADC_FAIL = 0xFF,
 } umdk_adc_cmd_t;
 
@@ -58,6 +58,11 @@ extern "C" {
 #include "thread.h"
 #include "lptimer.h"
 
+#if UMDK_ADC_CONTINUOUS
+#include "periph/timer.h"
+#include "dsp/int_stats/int_stats.h"
+#endif
+
 static uwnds_cb_t *callback;
 
 static kernel_pid_t timer_pid;
@@ -68,13 +73,33 @@ static lptimer_t timer;
 static bool is_polled = false;
 
 static struct {
+	uint8_t version;
 	uint8_t publish_period_sec;
 	uint32_t adc_lines_enabled;
 } umdk_adc_config;
 
+#if UMDK_ADC_CONTINUOUS
+/* messages to the ADC thread, the publish timer uses type 0 */
+#define MSG_SCAN_HALF       (1)
+#define MSG_SCAN_FULL       (2)
+#define MSG_SCAN_RESTART    (3)
+#define MSG_SCAN_PRINT      (4)
+
+static uint16_t scan_buf[2 * UMDK_ADC_SCANS * ADC_NUMOF];
+
+static struct {
+    uint8_t numof;                  /* lines in a scan */
+    uint8_t lines[ADC_NUMOF];       /* line of each sample in a scan */
+    int_decim_t decim[ADC_NUMOF];
+    int_stats_t stats[ADC_NUMOF];
+} scan;
+#endif
+
 static void reset_config(void) {
+	umdk_adc_config.version = UMDK_ADC_CONFIG_VERSION;
 	umdk_adc_config.publish_period_sec = UMDK_ADC_PUBLISH_PERIOD_MIN;
 
+	umdk_adc_config.adc_lines_enabled = 0;
 	for (unsigned i = 0; i < ADC_NUMOF; i++) {
 		umdk_adc_config.adc_lines_enabled |= (1 << i);
 	}
@@ -83,7 +108,12 @@ static void reset_config(void) {
 static void init_config(void) {
 	reset_config();
 
-	if (!unwds_read_nvram_config(_UMDK_MID_, (uint8_t *) &adc_config, sizeof(adc_config))) {
+	if (!unwds_read_nvram_config(_UMDK_MID_, (uint8_t *) &umdk_adc_config, sizeof(umdk_adc_config))) {
+        reset_config();
+    }
+
+    /* stored by a firmware with another config layout */
+    if (umdk_adc_config.version != UMDK_ADC_CONFIG_VERSION) {
         reset_config();
     }
         
@@ -91,7 +121,7 @@ static void init_config(void) {
 }
 
 static inline void save_config(void) {
-	unwds_write_nvram_config(_UMDK_MID_, (uint8_t *) &adc_config, sizeof(adc_config));
+	unwds_write_nvram_config(_UMDK_MID_, (uint8_t *) &umdk_adc_config, sizeof(umdk_adc_config));
 }
 
 static void init_adc(void)
@@ -106,6 +136,163 @@ static void init_adc(void)
     }
 }
 
+static uint32_t full_scale(void)
+{
+    switch (UMDK_ADC_ADC_RESOLUTION) {
+        case ADC_RES_12BIT:
+            return 4095;
+        case ADC_RES_10BIT:
+            return 1023;
+        case ADC_RES_8BIT:
+            return 255;
+        case ADC_RES_6BIT:
+            return 63;
+        default:
+            return 0;
+    }
+}
+
+#if UMDK_ADC_CONTINUOUS
+static void scan_cb(adc_dma_event_t event)
+{
+    msg_t msg = {};
+
+    if (event == ADC_DMA_CALLBACK_HALF) {
+        msg.type = MSG_SCAN_HALF;
+    } else if (event == ADC_DMA_CALLBACK_COMPLETED) {
+        msg.type = MSG_SCAN_FULL;
+    } else {
+        return;
+    }
+    /* a half is dropped if the thread is behind */
+    msg_send_int(&msg, timer_pid);
+}
+
+static void scan_start(bool reset)
+{
+    uint32_t mask = 0;
+
+    scan.numof = 0;
+    for (unsigned i = 0; i < ADC_NUMOF; i++) {
+        /* Vdd and temperature are sampled once per period */
+        if ((i == ADC_VREF_INDEX) || (i == ADC_TEMPERATURE_INDEX) ||
+            !(umdk_adc_config.adc_lines_enabled & (1 << i))) {
+            continue;
+        }
+        mask |= (1UL << i);
+        scan.lines[scan.numof++] = i;
+    }
+
+    for (unsigned i = 0; i < scan.numof; i++) {
+        int_decim_init(&scan.decim[i], UMDK_ADC_DECIMATION);
+        if (reset) {
+            int_stats_reset(&scan.stats[i]);
+        }
+    }
+
+    if (!scan.numof) {
+        return;
+    }
+
+#ifdef UMDK_ADC_TIMER
+    timer_init_periodic(UMDK_ADC_TIMER, UMDK_ADC_SCAN_PERIOD_US, NULL, NULL, true);
+#endif
+    if (adc_scan_start(mask, UMDK_ADC_ADC_RESOLUTION, UMDK_ADC_OVERSAMPLING,
+#ifdef UMDK_ADC_TIMER
+                       true,
+#else
+                       false,
+#endif
+                       scan_buf, 2 * UMDK_ADC_SCANS * scan.numof, scan_cb) < 0) {
+        puts("[umdk-" _UMDK_NAME_ "] Failed to start ADC sampling");
+        scan.numof = 0;
+        return;
+    }
+#ifdef UMDK_ADC_TIMER
+    timer_start(UMDK_ADC_TIMER);
+#endif
+}
+
+static void scan_stop(void)
+{
+    if (!scan.numof) {
+        return;
+    }
+#ifdef UMDK_ADC_TIMER
+    timer_stop(UMDK_ADC_TIMER);
+#endif
+    adc_sampling_stop();
+}
+
+static void scan_process(const uint16_t *samples)
+{
+    for (unsigned i = 0; i < scan.numof; i++) {
+        int_decim_process(&scan.decim[i], &scan.stats[i], samples + i,
+                          UMDK_ADC_SCANS, scan.numof);
+    }
+}
+
+static void prepare_result(module_data_t *buf)
+{
+    /* the ADC is locked while scanning */
+    scan_stop();
+
+    adc_init(ADC_LINE(ADC_VREF_INDEX));
+    uint32_t vdd = adc_sample(ADC_LINE(ADC_VREF_INDEX), UMDK_ADC_ADC_RESOLUTION);
+    adc_init(ADC_LINE(ADC_TEMPERATURE_INDEX));
+    int16_t temp = adc_sample(ADC_LINE(ADC_TEMPERATURE_INDEX), UMDK_ADC_ADC_RESOLUTION);
+
+    printf("[umdk-" _UMDK_NAME_ "] Vdd: %lu mV, temperature: %d C\n",
+           (unsigned long)vdd, temp);
+
+    uint8_t *pos = NULL;
+    if (buf) {
+        buf->data[0] = _UMDK_MID_;
+        buf->data[1] = UMDK_ADC_STATS;
+        buf->data[2] = vdd >> 8;
+        buf->data[3] = vdd & 0xFF;
+        buf->data[4] = (uint16_t)temp >> 8;
+        buf->data[5] = (uint16_t)temp & 0xFF;
+        pos = &buf->data[6];
+    }
+
+    for (unsigned i = 0; i < scan.numof; i++) {
+        int_stats_t *stats = &scan.stats[i];
+        uint16_t values[4] = {
+            stats->min, int_stats_mean(stats), stats->max, int_stats_rms(stats),
+        };
+
+        if (!stats->count) {
+            values[0] = 0;
+        }
+        if (UMDK_ADC_CONVERT_TO_MILLIVOLTS) {
+            for (unsigned k = 0; k < 4; k++) {
+                values[k] = (values[k] * vdd) / full_scale();
+            }
+        }
+
+        printf("[umdk-" _UMDK_NAME_ "] Line #%d: min %u, mean %u, max %u, RMS %u%s (%lu samples)\n",
+               scan.lines[i] + 1, values[0], values[1], values[2], values[3],
+               UMDK_ADC_CONVERT_TO_MILLIVOLTS ? " mV" : "",
+               (unsigned long)stats->count);
+
+        if (pos) {
+            *pos++ = scan.lines[i] + 1;
+            for (unsigned k = 0; k < 4; k++) {
+                *pos++ = values[k] >> 8;
+                *pos++ = values[k] & 0xFF;
+            }
+        }
+    }
+
+    if (buf) {
+        buf->length = pos - buf->data;
+    }
+
+    /* a new period starts with each report */
+    scan_start(buf != NULL);
+}
+#else
 static void prepare_result(module_data_t *buf)
 {
     unsigned i;
@@ -128,30 +315,14 @@ static void prepare_result(module_data_t *buf)
 	
 	if (UMDK_ADC_CONVERT_TO_MILLIVOLTS) {
 		/* Calculate Vdd */
-		uint32_t full_scale = 0;
-		
-		switch (UMDK_ADC_ADC_RESOLUTION) {
-			case ADC_RES_12BIT:
-				full_scale = 4095;
-				break;
-			case ADC_RES_10BIT:
-				full_scale = 1023;
-				break;
-			case ADC_RES_8BIT:
-				full_scale = 255;
-				break;
-			case ADC_RES_6BIT:
-				full_scale = 63;
-				break;
-			default:
-				puts("[umdk-" _UMDK_NAME_ "] Unsupported ADC resolution, aborting.");
-				return;
-				break; 
+		if (!full_scale()) {
+			puts("[umdk-" _UMDK_NAME_ "] Unsupported ADC resolution, aborting.");
+			return;
 		}
 		
 		for (i = 0; i < ADC_NUMOF; i++) {
 			if ((i != ADC_VREF_INDEX) && (i != ADC_TEMPERATURE_INDEX) && (samples[i] != 0xFFFF)) {
-				samples[i] = (uint32_t)(samples[i] * samples[ADC_VREF_INDEX]) / full_scale;
+				samples[i] = (uint32_t)(samples[i] * samples[ADC_VREF_INDEX]) / full_scale();
 			}
 		}
 	}
@@ -182,6 +353,7 @@ static void prepare_result(module_data_t *buf)
         buf->length = sizeof(samples) + 2;
     }
 }
+#endif /* UMDK_ADC_CONTINUOUS */
 
 static void *timer_thread(void *arg)
 {
@@ -193,9 +365,34 @@ static void *timer_thread(void *arg)
 
     puts("[umdk-" _UMDK_NAME_ "] Periodic publisher thread started");
 
+#if UMDK_ADC_CONTINUOUS
+    scan_start(true);
+#endif
+
     while (1) {
         msg_receive(&msg);
 
+#if UMDK_ADC_CONTINUOUS
+        switch (msg.type) {
+            case MSG_SCAN_HALF:
+                scan_process(scan_buf);
+                continue;
+            case MSG_SCAN_FULL:
+                scan_process(&scan_buf[UMDK_ADC_SCANS * scan.numof]);
+                continue;
+            case MSG_SCAN_RESTART:
+                scan_stop();
+                init_adc();
+                scan_start(true);
+                continue;
+            case MSG_SCAN_PRINT:
+                prepare_result(NULL);
+                continue;
+            default:
+                break;
+        }
+#endif
+
         module_data_t data = {};
         data.as_ack = is_polled;
         is_polled = false;
@@ -212,6 +409,17 @@ static void *timer_thread(void *arg)
     return NULL;
 }
 
+/* the scan is only controlled by the ADC thread */
+static void update_lines(void)
+{
+#if UMDK_ADC_CONTINUOUS
+    msg_t msg = { .type = MSG_SCAN_RESTART };
+    msg_send(&msg, timer_pid);
+#else
+    init_adc();
+#endif
+}
+
 static void set_period (int period) {
     umdk_adc_config.publish_period_sec = period;
     save_config();
@@ -239,7 +447,12 @@ int umdk_adc_shell_cmd(int argc, char **argv) {
     char *cmd = argv[1];
 	
     if (strcmp(cmd, "get") == 0) {
+#if UMDK_ADC_CONTINUOUS
+        msg_t msg = { .type = MSG_SCAN_PRINT };
+        msg_send(&msg, timer_pid);
+#else
         prepare_result(NULL);
+#endif
     }
     
     if (strcmp(cmd, "send") == 0) {
@@ -255,6 +468,7 @@ int umdk_adc_shell_cmd(int argc, char **argv) {
     if (strcmp(cmd, "reset") == 0) {
         reset_config();
         save_config();
+        update_lines();
     }
     
     if (strcmp(cmd, "cfg") == 0) {
@@ -279,6 +493,7 @@ int umdk_adc_shell_cmd(int argc, char **argv) {
             }
         }
         save_config();
+        update_lines();
     }
     
     return 1;
@@ -352,7 +567,7 @@ bool umdk_adc_cmd(module_data_t *cmd, module_data_t *reply)
                 save_config();
 
                 /* Re-initialize ADC lines */
-                init_adc();
+                update_lines();
             }
 
             reply_ok(reply);
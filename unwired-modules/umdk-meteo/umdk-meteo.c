@@ -128,6 +128,60 @@ static bool init_sensor(void) {
 	return (active_sensors != 0);
 }
 
+/* reads the register mapped sensors, returns the ones read successfully */
+static uint8_t read_registers(int *lps331_temp, int *lps331_pres, int *lm75_temp) {
+    uint8_t done = 0;
+
+#ifdef MODULE_PERIPH_I2C_ASYNC
+    /* both sensors are read as one batch on the shared bus, the LM75 is read
+     * along to replace a failed LPS331 temperature */
+    i2c_async_xfer_t xfer[2];
+    i2c_async_xfer_t *lps331_xfer = NULL;
+    i2c_async_xfer_t *lm75_xfer = NULL;
+    uint8_t lps331_raw[LPS331AP_RAW_LEN];
+    uint8_t lm75_raw[2];
+    unsigned numof = 0;
+
+    if (active_sensors & UMDK_METEO_LPS331) {
+        lps331_xfer = &xfer[numof++];
+        lps331ap_async_read(&dev_lps331, lps331_xfer, lps331_raw);
+    }
+    if (active_sensors & UMDK_METEO_LM75) {
+        lm75_xfer = &xfer[numof++];
+        lm75_async_read(&dev_lm75, lm75_xfer, lm75_raw);
+    }
+    if (numof == 0) {
+        return 0;
+    }
+
+    i2c_async_transfer(dev_lm75.params.i2c, xfer, numof);
+
+    if (lps331_xfer && (lps331_xfer->res == 0)) {
+        *lps331_temp = lps331ap_raw_temp(lps331_raw);
+        *lps331_pres = lps331ap_raw_pres(lps331_raw);
+        done |= UMDK_METEO_LPS331;
+    }
+    if (lm75_xfer && (lm75_xfer->res == 0)) {
+        *lm75_temp = lm75_raw_temperature(lm75_raw);
+        done |= UMDK_METEO_LM75;
+    }
+#else
+    if (active_sensors & UMDK_METEO_LPS331) {
+        *lps331_temp = lps331ap_read_temp(&dev_lps331);
+        *lps331_pres = lps331ap_read_pres(&dev_lps331);
+        done |= UMDK_METEO_LPS331;
+    }
+    /* LM75 is used only if there is no other temperature sensor */
+    if ((active_sensors & UMDK_METEO_LM75) &&
+        !(active_sensors & (UMDK_METEO_LPS331 | UMDK_METEO_SHT21))) {
+        *lm75_temp = lm75_get_ambient_temperature(&dev_lm75);
+        done |= UMDK_METEO_LM75;
+    }
+#endif
+
+    return done;
+}
+
 static void prepare_result(module_data_t *data) {
     int16_t measurements[3] = { SHRT_MAX };
     
@@ -137,27 +191,24 @@ static void prepare_result(module_data_t *data) {
         measurements[2] = bmx280_read_pressure(&dev_bmx280)/100; /* Pa -> mbar */
     } else {
         /* if there's BME280, no need in additional sensors */
-        
-        if ((!(active_sensors & UMDK_METEO_LPS331)) && !(active_sensors & UMDK_METEO_SHT21)) {
-            if (active_sensors & UMDK_METEO_LM75) {
-                measurements[0] = lm75_get_ambient_temperature(&dev_lm75)/100; /* degrees C * 1000 -> degrees C * 10 */
-            }
-        }
-        
-        if (active_sensors & UMDK_METEO_LPS331) {
-            if (! (active_sensors & UMDK_METEO_SHT21)) {
-                /* SHT21 has better temperature sensor */
-                measurements[0] = (lps331ap_read_temp(&dev_lps331) + 50) / 100;
-            }
-            measurements[2] = lps331ap_read_pres(&dev_lps331);
-        }
+        int lps331_temp = 0, lps331_pres = 0, lm75_temp = 0;
+        uint8_t read = read_registers(&lps331_temp, &lps331_pres, &lm75_temp);
         
         if (active_sensors & UMDK_METEO_SHT21) {
+            /* SHT21 has better temperature sensor */
             sht21_measure_t measure = { 0 };
             sht21_measure(&dev_sht21, &measure);
             
             measurements[0] = (measure.temperature + 50) / 100;
             measurements[1] = (measure.humidity + 50) / 100;
+        } else if (read & UMDK_METEO_LPS331) {
+            measurements[0] = (lps331_temp + 50) / 100;
+        } else if (read & UMDK_METEO_LM75) {
+            measurements[0] = lm75_temp/100; /* degrees C * 1000 -> degrees C * 10 */
+        }
+        
+        if (read & UMDK_METEO_LPS331) {
+            measurements[2] = lps331_pres;
         }
     }
     